@@ -13,6 +13,7 @@
 
 #include <memory>
 
+#include "absl/types/optional.h"
 #include "api/audio/audio_frame.h"
 #include "rtc_base/ref_count.h"
 
@@ -48,6 +49,29 @@ class AudioMixer : public rtc::RefCountInterface {
     // with this sample rate or higher will not cause quality loss.
     virtual int PreferredSampleRate() const = 0;
 
+    // An estimate of how loud the audio of the source currently is, which is
+    // known without getting any audio from it, e.g. from the audio level RTP
+    // header extension of the received packets.
+    struct LevelHint {
+      // The level in -dBov, from 0 (loudest) to 127 (silence), as in the
+      // audio level RTP header extension (RFC 6464).
+      int level_dbov = 127;
+      bool voice_activity = false;
+    };
+
+    // Returns the current level hint of the source, or nullopt if the source
+    // has none. A mixer may use the hints to select the sources to mix before
+    // getting audio from any of them.
+    virtual absl::optional<LevelHint> GetLevelHint() const {
+      return absl::nullopt;
+    }
+
+    // Called instead of GetAudioFrameWithInfo() when a mixer won't use the
+    // audio of the source in this round. Must advance the source by 10 ms,
+    // like GetAudioFrameWithInfo(), but doesn't need to produce any audio.
+    // Only called for sources that have a level hint.
+    virtual void SkipAudioFrame() {}
+
     virtual ~Source() {}
   };
 
@@ -36,6 +36,12 @@ struct PacketOptions {
   bool is_retransmit = false;
   bool included_in_feedback = false;
   bool included_in_allocation = false;
+  // If set, the packet may be held back by the network layer and sent
+  // together with the following packets, until one with
+  // `last_packet_in_batch` set is seen.
+  bool batchable = false;
+  // Whether this is the last packet of a batch of `batchable` packets.
+  bool last_packet_in_batch = false;
 };
 
 class Transport {
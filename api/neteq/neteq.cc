@@ -10,6 +10,7 @@
 
 #include "api/neteq/neteq.h"
 
+#include "api/audio/audio_frame.h"
 #include "rtc_base/strings/string_builder.h"
 
 namespace webrtc {
@@ -34,4 +35,10 @@ std::string NetEq::Config::ToString() const {
   return ss.str();
 }
 
+int NetEq::SkipAudio() {
+  AudioFrame audio_frame;
+  bool muted;
+  return GetAudio(&audio_frame, &muted);
+}
+
 }  // namespace webrtc
@@ -215,6 +215,17 @@ class NetEq {
       int* current_sample_rate_hz = nullptr,
       absl::optional<Operation> action_override = absl::nullopt) = 0;
 
+  // Advances NetEq by 10 ms, like GetAudio(), but without decoding the audio.
+  // The packets that are due for playout are taken from the packet buffer as
+  // usual, but are replaced by silence of the same duration instead of being
+  // decoded. This keeps the timing, the delay estimation, the statistics and
+  // the sync buffer of NetEq up to date at a fraction of the cost, for a
+  // stream whose audio isn't used for the moment, e.g. since it isn't
+  // selected by a mixer. The decoder doesn't see the skipped packets, so the
+  // first audio that is decoded afterwards may contain a short glitch.
+  // Returns kOK on success, or kFail in case of an error.
+  virtual int SkipAudio();
+
   // Replaces the current set of decoders with the given one.
   virtual void SetCodecs(const std::map<int, SdpAudioFormat>& codecs) = 0;
 
@@ -120,6 +120,7 @@
 #include "api/transport/sctp_transport_factory_interface.h"
 #include "api/turn_customizer.h"
 #include "api/video/video_bitrate_allocator_factory.h"
+#include "api/video/video_decode_scheduler.h"
 #include "call/rtp_transport_controller_send_factory_interface.h"
 #include "media/base/media_config.h"
 #include "media/base/media_engine.h"
@@ -1442,6 +1443,9 @@ struct RTC_EXPORT PeerConnectionFactoryDependencies final {
   std::unique_ptr<RtpTransportControllerSendFactoryInterface>
       transport_controller_send_factory;
   std::unique_ptr<Metronome> metronome;
+  // If set, the decoding of all received video streams is scheduled on it,
+  // e.g. on a pool created by CreateVideoDecodeThreadPool().
+  std::unique_ptr<VideoDecodeScheduler> video_decode_scheduler;
 };
 
 // PeerConnectionFactoryInterface is the factory interface used for creating
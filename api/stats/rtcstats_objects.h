@@ -662,6 +662,10 @@ class RTC_EXPORT RTCTransportStats final : public RTCStats {
   RTCStatsMember<std::string> ice_role;
   RTCStatsMember<std::string> ice_local_username_fragment;
   RTCStatsMember<std::string> ice_state;
+  // Number of received packets whose buffer needed a new heap allocation, and
+  // number that reused a pooled buffer. Only defined for the RTP component.
+  RTCNonStandardStatsMember<uint64_t> receive_buffer_allocations;
+  RTCNonStandardStatsMember<uint64_t> receive_buffer_reuses;
 };
 
 }  // namespace webrtc
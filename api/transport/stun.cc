@@ -24,6 +24,7 @@
 #include "rtc_base/helpers.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/message_digest.h"
+#include "rtc_base/openssl_digest.h"
 
 using rtc::ByteBufferReader;
 using rtc::ByteBufferWriter;
@@ -699,6 +700,159 @@ bool StunMessage::EqualAttributes(
 
 // StunAttribute
 
+StunMessageView::StunMessageView() = default;
+
+StunMessageView::~StunMessageView() = default;
+
+bool StunMessageView::Parse(const char* data, size_t size) {
+  data_ = data;
+  size_ = size;
+  attrs_.clear();
+
+  if (size < kStunHeaderSize) {
+    return false;
+  }
+  type_ = rtc::GetBE16(data);
+  if (type_ & 0x8000) {
+    // RTP and RTCP set the MSB of first byte, since first two bits are version,
+    // and version is always 2 (10). If set, this is not a STUN packet.
+    return false;
+  }
+  if (rtc::GetBE16(data + 2) != size - kStunHeaderSize) {
+    return false;
+  }
+  // If the magic cookie is invalid, the peer implements RFC3489 instead of
+  // RFC5389.
+  legacy_ = rtc::GetBE32(data + kStunTransactionIdOffset -
+                         kStunMagicCookieLength) != kStunMagicCookie;
+
+  size_t pos = kStunHeaderSize;
+  while (pos < size) {
+    if (size - pos < kStunAttributeHeaderSize) {
+      return false;
+    }
+    uint16_t attr_type = rtc::GetBE16(data + pos);
+    uint16_t attr_length = rtc::GetBE16(data + pos + 2);
+    pos += kStunAttributeHeaderSize;
+    // Attribute values are padded to a multiple of 4 bytes.
+    size_t padded_length = (attr_length + 3) & ~size_t{3};
+    if (size - pos < padded_length) {
+      return false;
+    }
+    attrs_.push_back({attr_type, attr_length, static_cast<uint32_t>(pos)});
+    pos += padded_length;
+  }
+  return true;
+}
+
+absl::string_view StunMessageView::transaction_id() const {
+  if (legacy_) {
+    return absl::string_view(
+        data_ + kStunTransactionIdOffset - kStunMagicCookieLength,
+        kStunLegacyTransactionIdLength);
+  }
+  return absl::string_view(data_ + kStunTransactionIdOffset,
+                           kStunTransactionIdLength);
+}
+
+absl::optional<absl::string_view> StunMessageView::GetByteString(
+    int type) const {
+  const Attribute* attr = FindAttribute(type);
+  if (!attr) {
+    return absl::nullopt;
+  }
+  return absl::string_view(data_ + attr->offset, attr->length);
+}
+
+absl::optional<uint32_t> StunMessageView::GetUInt32(int type) const {
+  const Attribute* attr = FindAttribute(type);
+  if (!attr || attr->length != StunUInt32Attribute::SIZE) {
+    return absl::nullopt;
+  }
+  return rtc::GetBE32(data_ + attr->offset);
+}
+
+absl::optional<uint64_t> StunMessageView::GetUInt64(int type) const {
+  const Attribute* attr = FindAttribute(type);
+  if (!attr || attr->length != StunUInt64Attribute::SIZE) {
+    return absl::nullopt;
+  }
+  return rtc::GetBE64(data_ + attr->offset);
+}
+
+bool StunMessageView::ValidateFingerprint() const {
+  // The FINGERPRINT attribute must be the last one, and Parse() checked that
+  // it ends the message.
+  if (size_ % 4 != 0 || legacy_ || attrs_.empty()) {
+    return false;
+  }
+  const Attribute& attr = attrs_.back();
+  if (attr.type != STUN_ATTR_FINGERPRINT ||
+      attr.length != StunUInt32Attribute::SIZE) {
+    return false;
+  }
+  uint32_t fingerprint = rtc::GetBE32(data_ + attr.offset);
+  return ((fingerprint ^ STUN_FINGERPRINT_XOR_VALUE) ==
+          rtc::ComputeCrc32(data_, attr.offset - kStunAttributeHeaderSize));
+}
+
+StunMessage::IntegrityStatus StunMessageView::ValidateMessageIntegrity(
+    rtc::OpenSSLHmac& hmac) const {
+  if (const Attribute* attr = FindAttribute(STUN_ATTR_MESSAGE_INTEGRITY)) {
+    return ValidateMessageIntegrityOfType(*attr, kStunMessageIntegritySize,
+                                          hmac)
+               ? StunMessage::IntegrityStatus::kIntegrityOk
+               : StunMessage::IntegrityStatus::kIntegrityBad;
+  }
+  if (const Attribute* attr =
+          FindAttribute(STUN_ATTR_GOOG_MESSAGE_INTEGRITY_32)) {
+    return ValidateMessageIntegrityOfType(*attr, kStunMessageIntegrity32Size,
+                                          hmac)
+               ? StunMessage::IntegrityStatus::kIntegrityOk
+               : StunMessage::IntegrityStatus::kIntegrityBad;
+  }
+  return StunMessage::IntegrityStatus::kNoIntegrity;
+}
+
+const StunMessageView::Attribute* StunMessageView::FindAttribute(
+    int type) const {
+  for (const Attribute& attr : attrs_) {
+    if (attr.type == type) {
+      return &attr;
+    }
+  }
+  return nullptr;
+}
+
+// Follows StunMessage::ValidateMessageIntegrityOfType(), but hashes the
+// message in place instead of copying it to patch the length.
+bool StunMessageView::ValidateMessageIntegrityOfType(
+    const Attribute& attr,
+    size_t mi_attr_size,
+    rtc::OpenSSLHmac& hmac) const {
+  if (size_ % 4 != 0 || attr.length != mi_attr_size) {
+    return false;
+  }
+
+  // The HMAC covers the message up to the MESSAGE-INTEGRITY attribute, with
+  // the length in the header adjusted to end after that attribute.
+  size_t mi_pos = attr.offset - kStunAttributeHeaderSize;
+  char adjusted_length[2];
+  rtc::SetBE16(adjusted_length,
+               static_cast<uint16_t>(attr.offset + mi_attr_size -
+                                     kStunHeaderSize));
+  hmac.Update(data_, 2);
+  hmac.Update(adjusted_length, sizeof(adjusted_length));
+  hmac.Update(data_ + 4, mi_pos - 4);
+  char computed[kStunMessageIntegritySize];
+  if (hmac.Finish(computed, sizeof(computed)) != sizeof(computed)) {
+    return false;
+  }
+
+  // Comparing the calculated HMAC with the one present in the message.
+  return memcmp(data_ + attr.offset, computed, mi_attr_size) == 0;
+}
+
 StunAttribute::StunAttribute(uint16_t type, uint16_t length)
     : type_(type), length_(length) {}
 
@@ -22,12 +22,18 @@
 #include <string>
 #include <vector>
 
+#include "absl/container/inlined_vector.h"
 #include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 #include "api/array_view.h"
 #include "rtc_base/byte_buffer.h"
 #include "rtc_base/ip_address.h"
 #include "rtc_base/socket_address.h"
 
+namespace rtc {
+class OpenSSLHmac;
+}  // namespace rtc
+
 namespace cricket {
 
 // These are the types of STUN messages defined in RFC 5389.
@@ -334,6 +340,68 @@ class StunMessage {
   std::string password_;
 };
 
+// A read-only view of a STUN message in a buffer owned by someone else.
+// Unlike StunMessage::Read(), Parse() neither copies the message nor creates
+// attribute objects; it only checks the framing of the message and records
+// where each attribute is, so it does not allocate for typical messages.
+// Attribute values are not validated. Use it where many messages need to be
+// checked, such as for connectivity checks, and parse into a StunMessage only
+// the messages that are accepted.
+//
+// The buffer must outlive the view and must not change while the view is used.
+class StunMessageView {
+ public:
+  StunMessageView();
+  ~StunMessageView();
+
+  // Parses the STUN message in `data`. Returns false if the message framing
+  // is invalid, in which case the view must not be used.
+  bool Parse(const char* data, size_t size);
+
+  int type() const { return type_; }
+  size_t length() const { return size_ - kStunHeaderSize; }
+  // The transaction id is 16 bytes for RFC 3489 messages, and 12 otherwise.
+  absl::string_view transaction_id() const;
+  bool IsLegacy() const { return legacy_; }
+  size_t num_attributes() const { return attrs_.size(); }
+
+  // Gets the value of the first attribute of type `type`, or nullopt if there
+  // is no such attribute or it has the wrong size.
+  absl::optional<absl::string_view> GetByteString(int type) const;
+  absl::optional<uint32_t> GetUInt32(int type) const;
+  absl::optional<uint64_t> GetUInt64(int type) const;
+
+  // Like StunMessage::ValidateFingerprint(), on the parsed message.
+  bool ValidateFingerprint() const;
+
+  // Like StunMessage::ValidateMessageIntegrity(), but with an HMAC that is
+  // keyed with the password. Reusing it for the messages of a session avoids
+  // hashing the password for every message.
+  StunMessage::IntegrityStatus ValidateMessageIntegrity(
+      rtc::OpenSSLHmac& hmac) const;
+
+ private:
+  struct Attribute {
+    uint16_t type;
+    uint16_t length;
+    // Offset of the value from the start of the message.
+    uint32_t offset;
+  };
+  // Enough for the attributes of a connectivity check.
+  static constexpr size_t kInlineAttributes = 12;
+
+  const Attribute* FindAttribute(int type) const;
+  bool ValidateMessageIntegrityOfType(const Attribute& attr,
+                                      size_t mi_attr_size,
+                                      rtc::OpenSSLHmac& hmac) const;
+
+  const char* data_ = nullptr;
+  size_t size_ = 0;
+  uint16_t type_ = STUN_INVALID_MESSAGE_TYPE;
+  bool legacy_ = false;
+  absl::InlinedVector<Attribute, kInlineAttributes> attrs_;
+};
+
 // Base class for all STUN/TURN attributes.
 class StunAttribute {
  public:
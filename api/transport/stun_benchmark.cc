@@ -0,0 +1,89 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+
+#include "api/transport/stun.h"
+#include "benchmark/benchmark.h"
+#include "rtc_base/byte_buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/message_digest.h"
+#include "rtc_base/openssl_digest.h"
+
+namespace cricket {
+namespace {
+
+constexpr char kUsername[] = "remoteufrag:localufrag";
+constexpr char kPassword[] = "localpasswordlocalpassword";
+
+// A connectivity check as sent by an ICE agent in the controlling role.
+std::string CreateBindingRequest() {
+  IceMessage request(STUN_BINDING_REQUEST);
+  request.AddAttribute(
+      std::make_unique<StunByteStringAttribute>(STUN_ATTR_USERNAME, kUsername));
+  request.AddAttribute(std::make_unique<StunUInt32Attribute>(
+      STUN_ATTR_GOOG_NETWORK_INFO, 0x00010005));
+  request.AddAttribute(
+      std::make_unique<StunUInt64Attribute>(STUN_ATTR_ICE_CONTROLLING, 42));
+  request.AddAttribute(
+      StunAttribute::CreateByteString(STUN_ATTR_USE_CANDIDATE));
+  request.AddAttribute(
+      std::make_unique<StunUInt32Attribute>(STUN_ATTR_PRIORITY, 0x6e0001ff));
+  RTC_CHECK(request.AddMessageIntegrity(kPassword));
+  RTC_CHECK(request.AddFingerprint());
+  rtc::ByteBufferWriter buf;
+  RTC_CHECK(request.Write(&buf));
+  return std::string(buf.Data(), buf.Length());
+}
+
+// Validates a binding request with a StunMessage only: checks the fingerprint,
+// parses the message and checks its integrity, hashing the password for every
+// message.
+void BM_ValidateBindingRequestWithStunMessage(benchmark::State& state) {
+  const std::string packet = CreateBindingRequest();
+  for (auto _ : state) {
+    RTC_CHECK(StunMessage::ValidateFingerprint(packet.data(), packet.size()));
+    IceMessage request;
+    rtc::ByteBufferReader buf(packet.data(), packet.size());
+    RTC_CHECK(request.Read(&buf));
+    RTC_CHECK(request.ValidateMessageIntegrity(kPassword) ==
+              StunMessage::IntegrityStatus::kIntegrityOk);
+    benchmark::DoNotOptimize(request.GetByteString(STUN_ATTR_USERNAME));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_ValidateBindingRequestWithStunMessage);
+
+// Validates the same binding request with a StunMessageView, reusing the HMAC
+// keyed with the password, as Port::GetStunMessage() and TurnServer check the
+// integrity.
+void BM_ValidateBindingRequestWithStunMessageView(benchmark::State& state) {
+  const std::string packet = CreateBindingRequest();
+  rtc::OpenSSLHmac hmac(rtc::DIGEST_SHA_1, kPassword);
+  for (auto _ : state) {
+    StunMessageView request;
+    RTC_CHECK(request.Parse(packet.data(), packet.size()));
+    RTC_CHECK(request.ValidateFingerprint());
+    RTC_CHECK(request.ValidateMessageIntegrity(hmac) ==
+              StunMessage::IntegrityStatus::kIntegrityOk);
+    benchmark::DoNotOptimize(request.GetByteString(STUN_ATTR_USERNAME));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_ValidateBindingRequestWithStunMessageView);
+
+}  // namespace
+}  // namespace cricket
@@ -16,9 +16,12 @@
 #include <string>
 #include <utility>
 
+#include "api/array_view.h"
 #include "rtc_base/arraysize.h"
 #include "rtc_base/byte_buffer.h"
 #include "rtc_base/byte_order.h"
+#include "rtc_base/message_digest.h"
+#include "rtc_base/openssl_digest.h"
 #include "rtc_base/socket_address.h"
 #include "test/gtest.h"
 
@@ -1855,4 +1858,156 @@ TEST_F(StunTest, SizeRestrictionOnAttributes) {
   ASSERT_FALSE(msg.Write(&out));
 }
 
+TEST_F(StunTest, StunMessageViewReadsRfc5769RequestMessage) {
+  StunMessageView view;
+  ASSERT_TRUE(view.Parse(reinterpret_cast<const char*>(kRfc5769SampleRequest),
+                         sizeof(kRfc5769SampleRequest)));
+  EXPECT_EQ(STUN_BINDING_REQUEST, view.type());
+  EXPECT_EQ(sizeof(kRfc5769SampleRequest) - kStunHeaderSize, view.length());
+  EXPECT_FALSE(view.IsLegacy());
+  EXPECT_EQ(absl::string_view(
+                reinterpret_cast<const char*>(kRfc5769SampleMsgTransactionId),
+                kStunTransactionIdLength),
+            view.transaction_id());
+  EXPECT_EQ(6u, view.num_attributes());
+
+  EXPECT_EQ(kRfc5769SampleMsgClientSoftware,
+            view.GetByteString(STUN_ATTR_SOFTWARE));
+  EXPECT_EQ(kRfc5769SampleMsgUsername, view.GetByteString(STUN_ATTR_USERNAME));
+  EXPECT_EQ(0x6e0001ffu, view.GetUInt32(STUN_ATTR_PRIORITY));
+  EXPECT_EQ(0x932ff9b151263b36u, view.GetUInt64(STUN_ATTR_ICE_CONTROLLED));
+  EXPECT_EQ(0xe57a3bcfu, view.GetUInt32(STUN_ATTR_FINGERPRINT));
+  // Missing attributes, and attributes of the wrong size.
+  EXPECT_FALSE(view.GetByteString(STUN_ATTR_ICE_CONTROLLING));
+  EXPECT_FALSE(view.GetUInt32(STUN_ATTR_ICE_CONTROLLED));
+  EXPECT_FALSE(view.GetUInt64(STUN_ATTR_PRIORITY));
+}
+
+TEST_F(StunTest, StunMessageViewReadsLegacyMessage) {
+  unsigned char rfc3489_packet[sizeof(kStunMessageWithIPv4MappedAddress)];
+  memcpy(rfc3489_packet, kStunMessageWithIPv4MappedAddress,
+         sizeof(kStunMessageWithIPv4MappedAddress));
+  // Overwrite the magic cookie here.
+  memcpy(&rfc3489_packet[4], "ABCD", 4);
+
+  StunMessageView view;
+  ASSERT_TRUE(view.Parse(reinterpret_cast<const char*>(rfc3489_packet),
+                         sizeof(rfc3489_packet)));
+  EXPECT_TRUE(view.IsLegacy());
+  EXPECT_EQ(STUN_BINDING_RESPONSE, view.type());
+  EXPECT_EQ(absl::string_view(reinterpret_cast<const char*>(&rfc3489_packet[4]),
+                              kStunLegacyTransactionIdLength),
+            view.transaction_id());
+}
+
+TEST_F(StunTest, StunMessageViewRejectsInvalidMessages) {
+  StunMessageView view;
+  EXPECT_FALSE(
+      view.Parse(reinterpret_cast<const char*>(kStunMessageWithZeroLength),
+                 sizeof(kStunMessageWithZeroLength)));
+  EXPECT_FALSE(
+      view.Parse(reinterpret_cast<const char*>(kStunMessageWithExcessLength),
+                 sizeof(kStunMessageWithExcessLength)));
+  EXPECT_FALSE(
+      view.Parse(reinterpret_cast<const char*>(kStunMessageWithSmallLength),
+                 sizeof(kStunMessageWithSmallLength)));
+  EXPECT_FALSE(view.Parse(reinterpret_cast<const char*>(kRtcpPacket),
+                          sizeof(kRtcpPacket)));
+  // Truncated header.
+  EXPECT_FALSE(view.Parse(reinterpret_cast<const char*>(kRfc5769SampleRequest),
+                          kStunHeaderSize - 1));
+
+  // Again, but with the length matching what is claimed in the header. The
+  // attribute doesn't fit.
+  EXPECT_FALSE(view.Parse(
+      reinterpret_cast<const char*>(kStunMessageWithSmallLength),
+      kStunHeaderSize + rtc::GetBE16(&kStunMessageWithSmallLength[2])));
+}
+
+TEST_F(StunTest, StunMessageViewValidatesMessageIntegrity) {
+  rtc::OpenSSLHmac hmac(rtc::DIGEST_SHA_1, kRfc5769SampleMsgPassword);
+  rtc::OpenSSLHmac bad_hmac(rtc::DIGEST_SHA_1, "InvalidPassword");
+  StunMessageView view;
+
+  // Try the messages from RFC 5769, reusing the HMACs.
+  const rtc::ArrayView<const uint8_t> samples[] = {
+      kRfc5769SampleRequest, kRfc5769SampleResponse,
+      kRfc5769SampleResponseIPv6, kSampleRequestMI32};
+  for (rtc::ArrayView<const uint8_t> sample : samples) {
+    ASSERT_TRUE(view.Parse(reinterpret_cast<const char*>(sample.data()),
+                           sample.size()));
+    EXPECT_EQ(StunMessage::IntegrityStatus::kIntegrityOk,
+              view.ValidateMessageIntegrity(hmac));
+    EXPECT_EQ(StunMessage::IntegrityStatus::kIntegrityBad,
+              view.ValidateMessageIntegrity(bad_hmac));
+  }
+
+  // We first need to compute the key for the long-term authentication HMAC.
+  std::string key;
+  ComputeStunCredentialHash(kRfc5769SampleMsgWithAuthUsername,
+                            kRfc5769SampleMsgWithAuthRealm,
+                            kRfc5769SampleMsgWithAuthPassword, &key);
+  rtc::OpenSSLHmac long_term_hmac(rtc::DIGEST_SHA_1, key);
+  ASSERT_TRUE(view.Parse(
+      reinterpret_cast<const char*>(kRfc5769SampleRequestLongTermAuth),
+      sizeof(kRfc5769SampleRequestLongTermAuth)));
+  EXPECT_EQ(StunMessage::IntegrityStatus::kIntegrityOk,
+            view.ValidateMessageIntegrity(long_term_hmac));
+
+  ASSERT_TRUE(
+      view.Parse(reinterpret_cast<const char*>(kRfc5769SampleRequestWithoutMI),
+                 sizeof(kRfc5769SampleRequestWithoutMI)));
+  EXPECT_EQ(StunMessage::IntegrityStatus::kNoIntegrity,
+            view.ValidateMessageIntegrity(hmac));
+
+  // Test that munging a single bit anywhere in the message causes the
+  // message-integrity check to fail, unless it is after the M-I attribute.
+  // Munging a length may also make the message fail to parse.
+  char buf[sizeof(kRfc5769SampleRequest)];
+  memcpy(buf, kRfc5769SampleRequest, sizeof(kRfc5769SampleRequest));
+  for (size_t i = 0; i < sizeof(buf); ++i) {
+    buf[i] ^= 0x01;
+    if (i > 0)
+      buf[i - 1] ^= 0x01;
+    bool parsed = view.Parse(buf, sizeof(buf));
+    if (i < sizeof(buf) - 8) {
+      EXPECT_FALSE(parsed && view.ValidateMessageIntegrity(hmac) ==
+                                 StunMessage::IntegrityStatus::kIntegrityOk);
+    } else if (parsed) {
+      EXPECT_EQ(StunMessage::IntegrityStatus::kIntegrityOk,
+                view.ValidateMessageIntegrity(hmac));
+    }
+  }
+}
+
+TEST_F(StunTest, StunMessageViewValidatesFingerprint) {
+  StunMessageView view;
+  ASSERT_TRUE(view.Parse(reinterpret_cast<const char*>(kRfc5769SampleResponse),
+                         sizeof(kRfc5769SampleResponse)));
+  EXPECT_TRUE(view.ValidateFingerprint());
+  ASSERT_TRUE(
+      view.Parse(reinterpret_cast<const char*>(kRfc5769SampleResponseIPv6),
+                 sizeof(kRfc5769SampleResponseIPv6)));
+  EXPECT_TRUE(view.ValidateFingerprint());
+  ASSERT_TRUE(
+      view.Parse(reinterpret_cast<const char*>(kRfc5769SampleRequestWithoutMI),
+                 sizeof(kRfc5769SampleRequestWithoutMI)));
+  EXPECT_FALSE(view.ValidateFingerprint());
+
+  // Test that munging a single bit anywhere in the message causes the
+  // fingerprint check to fail.
+  char buf[sizeof(kRfc5769SampleRequest)];
+  memcpy(buf, kRfc5769SampleRequest, sizeof(kRfc5769SampleRequest));
+  for (size_t i = 0; i < sizeof(buf); ++i) {
+    buf[i] ^= 0x01;
+    if (i > 0)
+      buf[i - 1] ^= 0x01;
+    EXPECT_FALSE(view.Parse(buf, sizeof(buf)) && view.ValidateFingerprint());
+  }
+  // Put them all back to normal and the check should pass again.
+  buf[sizeof(buf) - 1] ^= 0x01;
+  ASSERT_TRUE(view.Parse(buf, sizeof(buf)));
+  EXPECT_TRUE(view.ValidateFingerprint());
+}
+
 }  // namespace cricket
@@ -0,0 +1,62 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_VIDEO_VIDEO_DECODE_SCHEDULER_H_
+#define API_VIDEO_VIDEO_DECODE_SCHEDULER_H_
+
+#include <memory>
+
+#include "absl/strings/string_view.h"
+#include "api/task_queue/task_queue_base.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace webrtc {
+
+// Decides where and when video receive streams decode. Each receive stream
+// decodes on its own decode queue, created by CreateDecodeQueue(). Like any
+// task queue, a decode queue runs its tasks one at a time in the order they
+// were posted, but the scheduler is free to run the decode queues of many
+// receive streams on a shared set of threads.
+//
+// The decoders of a receive stream are therefore only guaranteed sequence
+// affinity: they are called on one decode queue at a time, but each task may
+// run on a different thread. Decoders that check that they are always called
+// on the same thread, such as hardware decoders bound to the thread that
+// created them, must not be used with a scheduler that shares its threads.
+//
+// Without a scheduler, each receive stream creates a task queue, and thereby
+// a thread, of its own.
+//
+// VideoDecodeScheduler implementations must be thread-safe, and must outlive
+// the decode queues they create.
+class RTC_EXPORT VideoDecodeScheduler {
+ public:
+  // Hint of which receive streams to decode first when the decode queues have
+  // more work than the scheduler has threads for, e.g. kHigh for the active
+  // speaker. The priorities are strict: a queue only runs when no queue of a
+  // higher priority has tasks ready. If the higher priority streams alone
+  // overload the scheduler, the lower priority streams may therefore starve
+  // indefinitely.
+  enum class Priority { kLow, kNormal, kHigh };
+
+  virtual ~VideoDecodeScheduler() = default;
+
+  // Creates a decode queue with normal priority. `name` is for debugging.
+  virtual std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateDecodeQueue(
+      absl::string_view name) = 0;
+
+  // Sets the priority of `decode_queue`, which must have been created by this
+  // scheduler and not yet deleted. May be called from any thread.
+  virtual void SetPriority(TaskQueueBase* decode_queue, Priority priority) = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // API_VIDEO_VIDEO_DECODE_SCHEDULER_H_
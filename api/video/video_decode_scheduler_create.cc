@@ -0,0 +1,22 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/video/video_decode_scheduler_create.h"
+
+#include "video/decode_thread_pool.h"
+
+namespace webrtc {
+
+std::unique_ptr<VideoDecodeScheduler> CreateVideoDecodeThreadPool(
+    int num_threads) {
+  return std::make_unique<DecodeThreadPool>(num_threads);
+}
+
+}  // namespace webrtc
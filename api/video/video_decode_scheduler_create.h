@@ -0,0 +1,29 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef API_VIDEO_VIDEO_DECODE_SCHEDULER_CREATE_H_
+#define API_VIDEO_VIDEO_DECODE_SCHEDULER_CREATE_H_
+
+#include <memory>
+
+#include "api/video/video_decode_scheduler.h"
+
+namespace webrtc {
+
+// Creates a scheduler that runs all decode queues on `num_threads` threads,
+// e.g. one per core for a server that receives many video streams. Higher
+// priority queues run first, and queues of the same priority take turns.
+// The decoders used with it must not need to be called on a single thread.
+std::unique_ptr<VideoDecodeScheduler> CreateVideoDecodeThreadPool(
+    int num_threads);
+
+}  // namespace webrtc
+
+#endif  // API_VIDEO_VIDEO_DECODE_SCHEDULER_CREATE_H_
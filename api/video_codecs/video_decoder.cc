@@ -62,4 +62,14 @@ void VideoDecoder::Settings::set_number_of_cores(int value) {
   number_of_cores_ = value;
 }
 
+void VideoDecoder::Settings::set_tile_threads(absl::optional<int> value) {
+  RTC_DCHECK(!value || *value > 0);
+  tile_threads_ = value;
+}
+
+void VideoDecoder::Settings::set_frame_threads(int value) {
+  RTC_DCHECK_GT(value, 0);
+  frame_threads_ = value;
+}
+
 }  // namespace webrtc
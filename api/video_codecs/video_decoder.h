@@ -81,6 +81,20 @@ class RTC_EXPORT VideoDecoder {
     int number_of_cores() const { return number_of_cores_; }
     void set_number_of_cores(int value);
 
+    // Maximum number of threads the decoder may use to decode parts of a frame,
+    // e.g. tiles or rows, in parallel. Capped at `number_of_cores`. If value
+    // isn't present the decoder picks the number of threads itself, typically
+    // from the resolution.
+    absl::optional<int> tile_threads() const { return tile_threads_; }
+    void set_tile_threads(absl::optional<int> value);
+
+    // Maximum number of frames the decoder may decode in parallel. Each frame
+    // beyond the first adds a frame of decode delay, so values above 1 trade
+    // latency for throughput. Decoders that can't decode frames in parallel
+    // ignore this value. Must be positive.
+    int frame_threads() const { return frame_threads_; }
+    void set_frame_threads(int value);
+
     // Codec of encoded images user of the VideoDecoder interface will `Decode`.
     VideoCodecType codec_type() const { return codec_type_; }
     void set_codec_type(VideoCodecType value) { codec_type_ = value; }
@@ -89,6 +103,8 @@ class RTC_EXPORT VideoDecoder {
     absl::optional<int> buffer_pool_size_;
     RenderResolution max_resolution_;
     int number_of_cores_ = 1;
+    absl::optional<int> tile_threads_;
+    int frame_threads_ = 1;
     VideoCodecType codec_type_ = kVideoCodecGeneric;
   };
 
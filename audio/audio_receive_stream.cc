@@ -426,6 +426,15 @@ int AudioReceiveStreamImpl::PreferredSampleRate() const {
   return channel_receive_->PreferredSampleRate();
 }
 
+absl::optional<AudioMixer::Source::LevelHint>
+AudioReceiveStreamImpl::GetLevelHint() const {
+  return channel_receive_->GetLevelHint();
+}
+
+void AudioReceiveStreamImpl::SkipAudioFrame() {
+  channel_receive_->SkipAudioFrame();
+}
+
 uint32_t AudioReceiveStreamImpl::id() const {
   RTC_DCHECK_RUN_ON(&worker_thread_checker_);
   return remote_ssrc();
@@ -113,6 +113,8 @@ class AudioReceiveStreamImpl final : public webrtc::AudioReceiveStreamInterface,
                                        AudioFrame* audio_frame) override;
   int Ssrc() const override;
   int PreferredSampleRate() const override;
+  absl::optional<LevelHint> GetLevelHint() const override;
+  void SkipAudioFrame() override;
 
   // Syncable
   uint32_t id() const override;
@@ -163,6 +163,9 @@ class ChannelReceive : public ChannelReceiveInterface,
 
   int PreferredSampleRate() const override;
 
+  absl::optional<AudioMixer::Source::LevelHint> GetLevelHint() const override;
+  void SkipAudioFrame() override;
+
   void SetSourceTracker(SourceTracker* source_tracker) override;
 
   // Associate to a send channel.
@@ -220,7 +223,7 @@ class ChannelReceive : public ChannelReceiveInterface,
   // checkers cannot be used. E.g. Chromium may transfer "ownership" from one
   // audio thread to another, but access is still sequential.
   rtc::RaceChecker audio_thread_race_checker_;
-  Mutex callback_mutex_;
+  mutable Mutex callback_mutex_;
   Mutex volume_settings_mutex_;
 
   bool playing_ RTC_GUARDED_BY(worker_thread_checker_) = false;
@@ -306,6 +309,12 @@ class ChannelReceive : public ChannelReceiveInterface,
   mutable Mutex rtcp_counter_mutex_;
   RtcpPacketTypeCounter rtcp_packet_type_counter_
       RTC_GUARDED_BY(rtcp_counter_mutex_);
+
+  // The audio level of the most recently received packet, which is set on
+  // the worker thread and read on the audio thread.
+  mutable Mutex level_hint_mutex_;
+  absl::optional<AudioMixer::Source::LevelHint> level_hint_
+      RTC_GUARDED_BY(level_hint_mutex_);
 };
 
 void ChannelReceive::OnReceivedPayloadData(
@@ -506,6 +515,26 @@ int ChannelReceive::PreferredSampleRate() const {
                   acm_receiver_.last_output_sample_rate_hz());
 }
 
+absl::optional<AudioMixer::Source::LevelHint> ChannelReceive::GetLevelHint()
+    const {
+  {
+    // A sink expects all audio, so the audio must not be skipped.
+    MutexLock lock(&callback_mutex_);
+    if (audio_sink_) {
+      return absl::nullopt;
+    }
+  }
+  MutexLock lock(&level_hint_mutex_);
+  return level_hint_;
+}
+
+void ChannelReceive::SkipAudioFrame() {
+  RTC_DCHECK_RUNS_SERIALIZED(&audio_thread_race_checker_);
+  if (acm_receiver_.SkipAudio() == -1) {
+    RTC_DLOG(LS_ERROR) << "ChannelReceive::SkipAudioFrame() failed!";
+  }
+}
+
 void ChannelReceive::SetSourceTracker(SourceTracker* source_tracker) {
   source_tracker_ = source_tracker;
 }
@@ -652,6 +681,12 @@ void ChannelReceive::OnRtpPacket(const RtpPacketReceived& packet) {
   RTPHeader header;
   packet_copy.GetHeader(&header);
 
+  if (header.extension.hasAudioLevel) {
+    MutexLock lock(&level_hint_mutex_);
+    level_hint_ = AudioMixer::Source::LevelHint{
+        header.extension.audioLevel, header.extension.voiceActivity};
+  }
+
   // Interpolates absolute capture timestamp RTP header extension.
   header.extension.absolute_capture_time =
       absolute_capture_time_interpolator_.OnReceivePacket(
@@ -149,6 +149,15 @@ class ChannelReceiveInterface : public RtpPacketSinkInterface {
 
   virtual int PreferredSampleRate() const = 0;
 
+  // Returns the audio level of the most recently received packet, from the
+  // audio level RTP header extension, or nullopt if the packets don't have
+  // it or if the audio is delivered to a sink.
+  virtual absl::optional<AudioMixer::Source::LevelHint> GetLevelHint()
+      const = 0;
+
+  // Advances the receiver by 10 ms without decoding any audio.
+  virtual void SkipAudioFrame() = 0;
+
   // Sets the source tracker to notify about "delivered" packets when output is
   // muted.
   virtual void SetSourceTracker(SourceTracker* source_tracker) = 0;
@@ -61,6 +61,11 @@ class MockChannelReceive : public voe::ChannelReceiveInterface {
               (int sample_rate_hz, AudioFrame*),
               (override));
   MOCK_METHOD(int, PreferredSampleRate, (), (const, override));
+  MOCK_METHOD(absl::optional<AudioMixer::Source::LevelHint>,
+              GetLevelHint,
+              (),
+              (const, override));
+  MOCK_METHOD(void, SkipAudioFrame, (), (override));
   MOCK_METHOD(void, SetSourceTracker, (SourceTracker*), (override));
   MOCK_METHOD(void,
               SetAssociatedSendChannel,
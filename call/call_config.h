@@ -19,6 +19,7 @@
 #include "api/task_queue/task_queue_factory.h"
 #include "api/transport/bitrate_settings.h"
 #include "api/transport/network_control.h"
+#include "api/video/video_decode_scheduler.h"
 #include "call/audio_state.h"
 #include "call/rtp_transport_config.h"
 #include "call/rtp_transport_controller_send_factory_interface.h"
@@ -78,6 +79,10 @@ struct CallConfig {
       rtp_transport_controller_send_factory = nullptr;
 
   Metronome* metronome = nullptr;
+
+  // Runs the decoding of the video receive streams if set. Must outlive the
+  // call.
+  VideoDecodeScheduler* video_decode_scheduler = nullptr;
 };
 
 }  // namespace webrtc
@@ -66,6 +66,7 @@ std::string VideoReceiveStreamInterface::Stats::ToString(
   ss << "render_fps: " << render_frame_rate << ", ";
   ss << "decode_ms: " << decode_ms << ", ";
   ss << "max_decode_ms: " << max_decode_ms << ", ";
+  ss << "decode_queue_delay_ms: " << decode_queue_delay_ms << ", ";
   ss << "first_frame_received_to_decoded_ms: "
      << first_frame_received_to_decoded_ms << ", ";
   ss << "cur_delay_ms: " << current_delay_ms << ", ";
@@ -24,6 +24,7 @@
 #include "api/rtp_parameters.h"
 #include "api/video/recordable_encoded_frame.h"
 #include "api/video/video_content_type.h"
+#include "api/video/video_decode_scheduler.h"
 #include "api/video/video_frame.h"
 #include "api/video/video_sink_interface.h"
 #include "api/video/video_timing.h"
@@ -90,6 +91,11 @@ class VideoReceiveStreamInterface : public MediaReceiveStreamInterface {
     FrameCounts frame_counts;
     int decode_ms = 0;
     int max_decode_ms = 0;
+    // Time from the frame buffer scheduling a frame for decoding until the
+    // decoding of the frame starts, i.e. the time the frame waited for the
+    // decode thread. Last value and sum over all decoded frames.
+    int decode_queue_delay_ms = 0;
+    webrtc::TimeDelta total_decode_queue_delay = webrtc::TimeDelta::Zero();
     int current_delay_ms = 0;
     int target_delay_ms = 0;
     int jitter_buffer_ms = 0;
@@ -287,6 +293,12 @@ class VideoReceiveStreamInterface : public MediaReceiveStreamInterface {
 
   virtual void SetRtcpMode(RtcpMode mode) = 0;
 
+  // Hints the priority of decoding this stream over others, e.g. kHigh for
+  // the active speaker. Only has an effect when the streams decode with a
+  // VideoDecodeScheduler. This is only exposed at the Call level; media
+  // channels and PeerConnection do not set it.
+  virtual void SetDecodePriority(VideoDecodeScheduler::Priority priority) {}
+
  protected:
   virtual ~VideoReceiveStreamInterface() {}
 };
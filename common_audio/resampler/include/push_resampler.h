@@ -16,6 +16,7 @@
 
 namespace webrtc {
 
+class PolyphaseResampler;
 class PushSincResampler;
 
 // Wraps PushSincResampler to provide stereo support.
@@ -24,6 +25,11 @@ template <typename T>
 class PushResampler {
  public:
   PushResampler();
+  // With `use_polyphase_resampler`, conversions that PolyphaseResampler
+  // supports are done by it rather than by one PushSincResampler per channel.
+  // This is faster, in particular for many channels, but the output differs
+  // slightly, as does the delay when downsampling.
+  explicit PushResampler(bool use_polyphase_resampler);
   virtual ~PushResampler();
 
   // Must be called whenever the parameters change. Free to be called at any
@@ -37,6 +43,7 @@ class PushResampler {
   int Resample(const T* src, size_t src_length, T* dst, size_t dst_capacity);
 
  private:
+  const bool use_polyphase_resampler_;
   int src_sample_rate_hz_;
   int dst_sample_rate_hz_;
   size_t num_channels_;
@@ -53,6 +60,8 @@ class PushResampler {
   };
 
   std::vector<ChannelResampler> channel_resamplers_;
+  // Used instead of `channel_resamplers_` when set.
+  std::unique_ptr<PolyphaseResampler> polyphase_resampler_;
 };
 }  // namespace webrtc
 
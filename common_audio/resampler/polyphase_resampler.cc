@@ -0,0 +1,298 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// MSVC++ requires this to be set before any other includes to get M_PI.
+#define _USE_MATH_DEFINES
+
+#include "common_audio/resampler/polyphase_resampler.h"
+
+#include <math.h>
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "common_audio/include/audio_util.h"
+#include "rtc_base/checks.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+namespace webrtc {
+
+struct PolyphaseResampler::Kernel {
+  // The filter runs at `up` times the input rate and every `down`-th sample of
+  // its output is kept.
+  int up;
+  int down;
+  // Length of each phase, in input samples.
+  size_t num_taps;
+  // `up` phases back-to-back, each of `num_taps` samples in the order in which
+  // they are applied to the input.
+  std::unique_ptr<float[], AlignedFreeDeleter> coefficients;
+  // Steps of one 10 ms block, which all blocks repeat since a block always
+  // starts at phase zero.
+  std::vector<Step> steps;
+};
+
+namespace {
+
+// Length of the kernel in samples at the lower of the two rates. The same as
+// for SincResampler, which gives upsampling the same algorithmic delay.
+constexpr size_t kKernelSize = 32;
+
+// Scale of the cutoff frequency relative to the lower Nyquist frequency. Same
+// as for SincResampler, to let the transition band end near that frequency.
+constexpr double kCutoffScale = 0.9;
+
+struct RatePair {
+  int src_sample_rate_hz;
+  int dst_sample_rate_hz;
+  int up;
+  int down;
+  size_t num_taps;
+};
+
+constexpr int Gcd(int a, int b) {
+  return b == 0 ? a : Gcd(b, a % b);
+}
+
+constexpr RatePair MakeRatePair(int src_sample_rate_hz,
+                                int dst_sample_rate_hz) {
+  const int gcd = Gcd(src_sample_rate_hz, dst_sample_rate_hz);
+  const int up = dst_sample_rate_hz / gcd;
+  const int down = src_sample_rate_hz / gcd;
+  // When downsampling, the kernel spans `kKernelSize` output samples, rounded
+  // up to whole SIMD vectors.
+  const size_t num_taps =
+      up >= down ? kKernelSize
+                 : (kKernelSize * down + 8 * up - 1) / (8 * up) * 8;
+  return {src_sample_rate_hz, dst_sample_rate_hz, up, down, num_taps};
+}
+
+constexpr RatePair kRatePairs[] = {
+    MakeRatePair(8000, 16000),  MakeRatePair(8000, 32000),
+    MakeRatePair(8000, 48000),  MakeRatePair(16000, 8000),
+    MakeRatePair(16000, 32000), MakeRatePair(16000, 48000),
+    MakeRatePair(32000, 8000),  MakeRatePair(32000, 16000),
+    MakeRatePair(32000, 48000), MakeRatePair(48000, 8000),
+    MakeRatePair(48000, 16000), MakeRatePair(48000, 32000),
+    MakeRatePair(44100, 48000), MakeRatePair(48000, 44100),
+};
+constexpr size_t kNumRatePairs = sizeof(kRatePairs) / sizeof(kRatePairs[0]);
+
+// A 10 ms block must hold whole periods of the phase sequence, so that all
+// blocks use the same steps, and the phases must be whole SIMD vectors.
+constexpr bool IsValid(const RatePair& pair) {
+  return pair.up != pair.down &&
+         (pair.src_sample_rate_hz / 100) % pair.down == 0 &&
+         (pair.dst_sample_rate_hz / 100) % pair.up == 0 &&
+         pair.num_taps % 8 == 0;
+}
+
+constexpr bool AreValid() {
+  for (const RatePair& pair : kRatePairs) {
+    if (!IsValid(pair)) {
+      return false;
+    }
+  }
+  return true;
+}
+static_assert(AreValid(), "Invalid rate pair");
+
+size_t FindRatePair(int src_sample_rate_hz, int dst_sample_rate_hz) {
+  for (size_t i = 0; i < kNumRatePairs; ++i) {
+    if (kRatePairs[i].src_sample_rate_hz == src_sample_rate_hz &&
+        kRatePairs[i].dst_sample_rate_hz == dst_sample_rate_hz) {
+      return i;
+    }
+  }
+  return kNumRatePairs;
+}
+
+// Computes the filter bank of `pair`: a Blackman windowed sinc at `up` times
+// the input rate, with its cutoff below the lower of the two Nyquist
+// frequencies, split into `up` phases. Each phase is normalized to unity gain
+// at DC.
+void InitializeKernel(const RatePair& pair,
+                      PolyphaseResampler::Kernel* kernel) {
+  kernel->up = pair.up;
+  kernel->down = pair.down;
+  kernel->num_taps = pair.num_taps;
+  kernel->coefficients.reset(static_cast<float*>(
+      AlignedMalloc(sizeof(float) * pair.up * pair.num_taps, 32)));
+
+  const double length = static_cast<double>(pair.num_taps * pair.up);
+  const double center = 0.5 * length;
+  const double cutoff = kCutoffScale * 0.5 / std::max(pair.up, pair.down);
+  std::vector<double> phase(pair.num_taps);
+  for (int p = 0; p < pair.up; ++p) {
+    double sum = 0.0;
+    for (size_t m = 0; m < pair.num_taps; ++m) {
+      // The first tap applies to the oldest input sample.
+      const double j =
+          static_cast<double>((pair.num_taps - 1 - m) * pair.up + p);
+      const double x = j - center;
+      const double window = 0.42 - 0.5 * cos(2.0 * M_PI * j / length) +
+                            0.08 * cos(4.0 * M_PI * j / length);
+      const double sinc =
+          x == 0.0 ? 2.0 * cutoff : sin(2.0 * M_PI * cutoff * x) / (M_PI * x);
+      phase[m] = window * sinc;
+      sum += phase[m];
+    }
+    float* coefficients = &kernel->coefficients[p * pair.num_taps];
+    for (size_t m = 0; m < pair.num_taps; ++m) {
+      coefficients[m] = static_cast<float>(phase[m] / sum);
+    }
+  }
+
+  // Output sample n lies `n * down / up` input samples into the block.
+  const size_t dst_frames = static_cast<size_t>(pair.dst_sample_rate_hz / 100);
+  kernel->steps.resize(dst_frames);
+  for (size_t n = 0; n < dst_frames; ++n) {
+    const size_t position = n * pair.down;
+    kernel->steps[n].input_offset = static_cast<uint32_t>(position / pair.up);
+    kernel->steps[n].kernel_offset =
+        static_cast<uint32_t>(position % pair.up * pair.num_taps);
+  }
+}
+
+const PolyphaseResampler::Kernel& GetKernel(int src_sample_rate_hz,
+                                            int dst_sample_rate_hz) {
+  // The filter banks of all rate pairs take less than 100 kB and are computed
+  // in well below a millisecond, so they are created together on first use and
+  // live for the rest of the process.
+  static const PolyphaseResampler::Kernel* const kKernels = [] {
+    auto* kernels = new PolyphaseResampler::Kernel[kNumRatePairs];
+    for (size_t i = 0; i < kNumRatePairs; ++i) {
+      InitializeKernel(kRatePairs[i], &kernels[i]);
+    }
+    return kernels;
+  }();
+  const size_t index = FindRatePair(src_sample_rate_hz, dst_sample_rate_hz);
+  RTC_CHECK_LT(index, kNumRatePairs)
+      << "Unsupported conversion from " << src_sample_rate_hz << " Hz to "
+      << dst_sample_rate_hz << " Hz";
+  return kKernels[index];
+}
+
+}  // namespace
+
+bool PolyphaseResampler::IsSupported(int src_sample_rate_hz,
+                                     int dst_sample_rate_hz) {
+  return FindRatePair(src_sample_rate_hz, dst_sample_rate_hz) < kNumRatePairs;
+}
+
+PolyphaseResampler::PolyphaseResampler(int src_sample_rate_hz,
+                                       int dst_sample_rate_hz,
+                                       size_t num_channels)
+    : kernel_(GetKernel(src_sample_rate_hz, dst_sample_rate_hz)),
+      src_sample_rate_hz_(src_sample_rate_hz),
+      num_channels_(num_channels),
+      src_frames_(static_cast<size_t>(src_sample_rate_hz / 100)),
+      dst_frames_(static_cast<size_t>(dst_sample_rate_hz / 100)),
+      channel_buffer_size_(kernel_.num_taps - 1 + src_frames_),
+      convolve_proc_(GetConvolveProc()),
+      input_buffer_(static_cast<float*>(
+          AlignedMalloc(sizeof(float) * channel_buffer_size_ * num_channels,
+                        32))) {
+  RTC_DCHECK_GT(num_channels, 0);
+  Reset();
+}
+
+PolyphaseResampler::~PolyphaseResampler() = default;
+
+// If we know the minimum architecture at compile time, avoid CPU detection.
+PolyphaseResampler::ConvolveProc PolyphaseResampler::GetConvolveProc() {
+#if defined(WEBRTC_HAS_NEON)
+  return Convolve_NEON;
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+  return GetCPUInfo(kAVX2) ? Convolve_AVX2 : Convolve_C;
+#else
+  return Convolve_C;
+#endif
+}
+
+size_t PolyphaseResampler::Resample(const float* src,
+                                    size_t src_length,
+                                    float* dst,
+                                    size_t dst_capacity) {
+  RTC_CHECK_EQ(src_length, src_frames_ * num_channels_);
+  RTC_CHECK_GE(dst_capacity, dst_frames_ * num_channels_);
+  LoadInput(src);
+  ProcessChannels(dst);
+  return dst_frames_ * num_channels_;
+}
+
+size_t PolyphaseResampler::Resample(const int16_t* src,
+                                    size_t src_length,
+                                    int16_t* dst,
+                                    size_t dst_capacity) {
+  RTC_CHECK_EQ(src_length, src_frames_ * num_channels_);
+  RTC_CHECK_GE(dst_capacity, dst_frames_ * num_channels_);
+  const size_t dst_length = dst_frames_ * num_channels_;
+  if (!float_output_)
+    float_output_.reset(new float[dst_length]);
+
+  LoadInput(src);
+  ProcessChannels(float_output_.get());
+  FloatS16ToS16(float_output_.get(), dst_length, dst);
+  return dst_length;
+}
+
+void PolyphaseResampler::Reset() {
+  memset(input_buffer_.get(), 0,
+         sizeof(float) * channel_buffer_size_ * num_channels_);
+}
+
+float PolyphaseResampler::AlgorithmicDelaySeconds() const {
+  return 1.f / src_sample_rate_hz_ * kernel_.num_taps / 2;
+}
+
+template <typename T>
+void PolyphaseResampler::LoadInput(const T* src) {
+  const size_t history_size = kernel_.num_taps - 1;
+  for (size_t ch = 0; ch < num_channels_; ++ch) {
+    float* block =
+        input_buffer_.get() + ch * channel_buffer_size_ + history_size;
+    const T* interleaved = src + ch;
+    for (size_t i = 0; i < src_frames_; ++i) {
+      block[i] = static_cast<float>(interleaved[i * num_channels_]);
+    }
+  }
+}
+
+void PolyphaseResampler::ProcessChannels(float* dst) {
+  const size_t history_size = kernel_.num_taps - 1;
+  for (size_t ch = 0; ch < num_channels_; ++ch) {
+    float* input = input_buffer_.get() + ch * channel_buffer_size_;
+    convolve_proc_(input, kernel_.coefficients.get(), kernel_.num_taps,
+                   kernel_.steps.data(), dst_frames_, num_channels_, dst + ch);
+    memmove(input, input + src_frames_, sizeof(float) * history_size);
+  }
+}
+
+void PolyphaseResampler::Convolve_C(const float* input,
+                                    const float* kernels,
+                                    size_t num_taps,
+                                    const Step* steps,
+                                    size_t num_steps,
+                                    size_t output_stride,
+                                    float* output) {
+  for (size_t n = 0; n < num_steps; ++n) {
+    const float* input_ptr = input + steps[n].input_offset;
+    const float* kernel = kernels + steps[n].kernel_offset;
+    float sum = 0.f;
+    for (size_t i = 0; i < num_taps; ++i) {
+      sum += input_ptr[i] * kernel[i];
+    }
+    output[n * output_stride] = sum;
+  }
+}
+
+}  // namespace webrtc
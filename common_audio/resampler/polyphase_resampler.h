@@ -0,0 +1,147 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_AUDIO_RESAMPLER_POLYPHASE_RESAMPLER_H_
+#define COMMON_AUDIO_RESAMPLER_POLYPHASE_RESAMPLER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+
+#include "rtc_base/gtest_prod_util.h"
+#include "rtc_base/memory/aligned_malloc.h"
+#include "rtc_base/system/arch.h"
+
+namespace webrtc {
+
+// Rational polyphase sample-rate converter for interleaved audio in 10 ms
+// blocks. Each supported rate pair has a fixed up/down factor and kernel
+// length, and its filter bank is computed once per process and shared by all
+// instances, so that setting up and running many resamplers is cheap. Only
+// conversions between 8, 16, 32 and 48 kHz, and between 44.1 and 48 kHz, are
+// supported; see IsSupported().
+class PolyphaseResampler {
+ public:
+  // Returns true if there is a kernel for converting from `src_sample_rate_hz`
+  // to `dst_sample_rate_hz`. Equal rates are not supported.
+  static bool IsSupported(int src_sample_rate_hz, int dst_sample_rate_hz);
+
+  // The rate pair must be supported.
+  PolyphaseResampler(int src_sample_rate_hz,
+                     int dst_sample_rate_hz,
+                     size_t num_channels);
+  ~PolyphaseResampler();
+
+  PolyphaseResampler(const PolyphaseResampler&) = delete;
+  PolyphaseResampler& operator=(const PolyphaseResampler&) = delete;
+
+  // Resamples 10 ms of interleaved audio. `src_length` must be the number of
+  // samples in 10 ms of audio across all channels and `dst_capacity` must be
+  // at least as large as the output of 10 ms. Returns the number of samples
+  // written to `dst`, across all channels. The int16_t version rounds and
+  // saturates the output.
+  size_t Resample(const float* src,
+                  size_t src_length,
+                  float* dst,
+                  size_t dst_capacity);
+  size_t Resample(const int16_t* src,
+                  size_t src_length,
+                  int16_t* dst,
+                  size_t dst_capacity);
+
+  // Clears the filter history, as if no audio had been resampled.
+  void Reset();
+
+  // Delay due to the filter kernel, i.e. the time after which an input sample
+  // will appear in the resampled output.
+  float AlgorithmicDelaySeconds() const;
+
+  size_t num_channels() const { return num_channels_; }
+
+  // Position of the input window and of the kernel phase that make up one
+  // output sample of a 10 ms block.
+  struct Step {
+    uint32_t input_offset;
+    uint32_t kernel_offset;
+  };
+
+  // Filter bank of one rate pair.
+  struct Kernel;
+
+ private:
+  FRIEND_TEST_ALL_PREFIXES(PolyphaseResamplerTest, Convolve);
+
+  // Deinterleaves one 10 ms block of `src` behind the history of each channel.
+  template <typename T>
+  void LoadInput(const T* src);
+  // Computes the output of each channel into `dst`, which is interleaved, and
+  // keeps the end of the input as history for the next block.
+  void ProcessChannels(float* dst);
+
+  // Computes `num_steps` output samples from `input`, one for each step, and
+  // writes them `output_stride` samples apart. `kernels` holds the phases of
+  // the filter bank back-to-back, each of `num_taps` samples. On x86 and ARM
+  // the underlying implementation is chosen at run time.
+  static void Convolve_C(const float* input,
+                         const float* kernels,
+                         size_t num_taps,
+                         const Step* steps,
+                         size_t num_steps,
+                         size_t output_stride,
+                         float* output);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  static void Convolve_AVX2(const float* input,
+                            const float* kernels,
+                            size_t num_taps,
+                            const Step* steps,
+                            size_t num_steps,
+                            size_t output_stride,
+                            float* output);
+#elif defined(WEBRTC_HAS_NEON)
+  static void Convolve_NEON(const float* input,
+                            const float* kernels,
+                            size_t num_taps,
+                            const Step* steps,
+                            size_t num_steps,
+                            size_t output_stride,
+                            float* output);
+#endif
+
+  typedef void (*ConvolveProc)(const float*,
+                               const float*,
+                               size_t,
+                               const Step*,
+                               size_t,
+                               size_t,
+                               float*);
+
+  // Selects the fastest Convolve function that the CPU supports.
+  static ConvolveProc GetConvolveProc();
+
+  const Kernel& kernel_;
+  const int src_sample_rate_hz_;
+  const size_t num_channels_;
+  const size_t src_frames_;
+  const size_t dst_frames_;
+  // Samples per channel in `input_buffer_`: the history of the filter followed
+  // by one 10 ms block.
+  const size_t channel_buffer_size_;
+  const ConvolveProc convolve_proc_;
+
+  // Planar input of all channels, each `channel_buffer_size_` samples.
+  std::unique_ptr<float[], AlignedFreeDeleter> input_buffer_;
+  // Interleaved output, used for converting to int16_t.
+  std::unique_ptr<float[]> float_output_;
+};
+
+}  // namespace webrtc
+
+#endif  // COMMON_AUDIO_RESAMPLER_POLYPHASE_RESAMPLER_H_
@@ -0,0 +1,55 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+#include <stddef.h>
+
+#include "common_audio/resampler/polyphase_resampler.h"
+
+namespace webrtc {
+
+void PolyphaseResampler::Convolve_AVX2(const float* input,
+                                       const float* kernels,
+                                       size_t num_taps,
+                                       const Step* steps,
+                                       size_t num_steps,
+                                       size_t output_stride,
+                                       float* output) {
+  for (size_t n = 0; n < num_steps; ++n) {
+    const float* input_ptr = input + steps[n].input_offset;
+    // The phases are 32-byte aligned since `num_taps` is a multiple of 8.
+    const float* kernel = kernels + steps[n].kernel_offset;
+
+    // Two sums to shorten the dependency chain of the additions.
+    __m256 m_sums1 = _mm256_setzero_ps();
+    __m256 m_sums2 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= num_taps; i += 16) {
+      m_sums1 = _mm256_fmadd_ps(_mm256_loadu_ps(input_ptr + i),
+                                _mm256_load_ps(kernel + i), m_sums1);
+      m_sums2 = _mm256_fmadd_ps(_mm256_loadu_ps(input_ptr + i + 8),
+                                _mm256_load_ps(kernel + i + 8), m_sums2);
+    }
+    if (i < num_taps) {
+      m_sums1 = _mm256_fmadd_ps(_mm256_loadu_ps(input_ptr + i),
+                                _mm256_load_ps(kernel + i), m_sums1);
+    }
+    m_sums1 = _mm256_add_ps(m_sums1, m_sums2);
+
+    // Sum components together.
+    __m128 m128_sums = _mm_add_ps(_mm256_extractf128_ps(m_sums1, 0),
+                                  _mm256_extractf128_ps(m_sums1, 1));
+    m128_sums = _mm_add_ps(_mm_movehl_ps(m128_sums, m128_sums), m128_sums);
+    m128_sums = _mm_add_ss(m128_sums, _mm_shuffle_ps(m128_sums, m128_sums, 1));
+    _mm_store_ss(&output[n * output_stride], m128_sums);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,47 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <arm_neon.h>
+
+#include "common_audio/resampler/polyphase_resampler.h"
+
+namespace webrtc {
+
+void PolyphaseResampler::Convolve_NEON(const float* input,
+                                       const float* kernels,
+                                       size_t num_taps,
+                                       const Step* steps,
+                                       size_t num_steps,
+                                       size_t output_stride,
+                                       float* output) {
+  for (size_t n = 0; n < num_steps; ++n) {
+    const float* input_ptr = input + steps[n].input_offset;
+    const float* kernel = kernels + steps[n].kernel_offset;
+
+    // Two sums to shorten the dependency chain of the additions. `num_taps` is
+    // a multiple of 8.
+    float32x4_t m_sums1 = vmovq_n_f32(0);
+    float32x4_t m_sums2 = vmovq_n_f32(0);
+    for (size_t i = 0; i < num_taps; i += 8) {
+      m_sums1 =
+          vmlaq_f32(m_sums1, vld1q_f32(input_ptr + i), vld1q_f32(kernel + i));
+      m_sums2 = vmlaq_f32(m_sums2, vld1q_f32(input_ptr + i + 4),
+                          vld1q_f32(kernel + i + 4));
+    }
+    m_sums1 = vaddq_f32(m_sums1, m_sums2);
+
+    // Sum components together.
+    float32x2_t m_half =
+        vadd_f32(vget_high_f32(m_sums1), vget_low_f32(m_sums1));
+    output[n * output_stride] = vget_lane_f32(vpadd_f32(m_half, m_half), 0);
+  }
+}
+
+}  // namespace webrtc
@@ -16,6 +16,7 @@
 #include <memory>
 
 #include "common_audio/include/audio_util.h"
+#include "common_audio/resampler/polyphase_resampler.h"
 #include "common_audio/resampler/push_sinc_resampler.h"
 #include "rtc_base/checks.h"
 
@@ -59,7 +60,14 @@ void CheckExpectedBufferSizes(size_t src_length,
 
 template <typename T>
 PushResampler<T>::PushResampler()
-    : src_sample_rate_hz_(0), dst_sample_rate_hz_(0), num_channels_(0) {}
+    : PushResampler(/*use_polyphase_resampler=*/false) {}
+
+template <typename T>
+PushResampler<T>::PushResampler(bool use_polyphase_resampler)
+    : use_polyphase_resampler_(use_polyphase_resampler),
+      src_sample_rate_hz_(0),
+      dst_sample_rate_hz_(0),
+      num_channels_(0) {}
 
 template <typename T>
 PushResampler<T>::~PushResampler() {}
@@ -85,11 +93,20 @@ int PushResampler<T>::InitializeIfNeeded(int src_sample_rate_hz,
   dst_sample_rate_hz_ = dst_sample_rate_hz;
   num_channels_ = num_channels;
 
+  channel_resamplers_.clear();
+  polyphase_resampler_.reset();
+  if (use_polyphase_resampler_ &&
+      PolyphaseResampler::IsSupported(src_sample_rate_hz, dst_sample_rate_hz)) {
+    polyphase_resampler_ = std::make_unique<PolyphaseResampler>(
+        src_sample_rate_hz, dst_sample_rate_hz, num_channels);
+    channel_data_array_.clear();
+    return 0;
+  }
+
   const size_t src_size_10ms_mono =
       static_cast<size_t>(src_sample_rate_hz / 100);
   const size_t dst_size_10ms_mono =
       static_cast<size_t>(dst_sample_rate_hz / 100);
-  channel_resamplers_.clear();
   for (size_t i = 0; i < num_channels; ++i) {
     channel_resamplers_.push_back(ChannelResampler());
     auto channel_resampler = channel_resamplers_.rbegin();
@@ -119,6 +136,11 @@ int PushResampler<T>::Resample(const T* src,
     return static_cast<int>(src_length);
   }
 
+  if (polyphase_resampler_) {
+    return static_cast<int>(
+        polyphase_resampler_->Resample(src, src_length, dst, dst_capacity));
+  }
+
   const size_t src_length_mono = src_length / num_channels_;
   const size_t dst_capacity_mono = dst_capacity / num_channels_;
 
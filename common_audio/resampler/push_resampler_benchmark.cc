@@ -0,0 +1,74 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "common_audio/resampler/include/push_resampler.h"
+#include "rtc_base/random.h"
+
+namespace webrtc {
+namespace {
+
+// Measures the resampling of 10 ms of audio. The arguments are the source
+// rate, the destination rate and the number of channels.
+template <typename T>
+void Resample(benchmark::State& state, bool use_polyphase_resampler) {
+  const int src_sample_rate_hz = static_cast<int>(state.range(0));
+  const int dst_sample_rate_hz = static_cast<int>(state.range(1));
+  const size_t num_channels = static_cast<size_t>(state.range(2));
+  PushResampler<T> resampler(use_polyphase_resampler);
+  resampler.InitializeIfNeeded(src_sample_rate_hz, dst_sample_rate_hz,
+                               num_channels);
+
+  Random random(42);
+  std::vector<T> src(num_channels * src_sample_rate_hz / 100);
+  for (T& sample : src) {
+    sample = static_cast<T>(random.Rand(-10000, 10000));
+  }
+  std::vector<T> dst(num_channels * dst_sample_rate_hz / 100);
+  for (auto _ : state) {
+    resampler.Resample(src.data(), src.size(), dst.data(), dst.size());
+    benchmark::DoNotOptimize(dst.data());
+  }
+  state.SetItemsProcessed(state.iterations() * src.size());
+}
+
+void RatePairs(benchmark::internal::Benchmark* benchmark) {
+  for (int num_channels : {1, 2}) {
+    benchmark->Args({16000, 48000, num_channels});
+    benchmark->Args({48000, 16000, num_channels});
+    benchmark->Args({32000, 48000, num_channels});
+    benchmark->Args({48000, 32000, num_channels});
+    benchmark->Args({44100, 48000, num_channels});
+    benchmark->Args({48000, 44100, num_channels});
+    benchmark->Args({48000, 8000, num_channels});
+  }
+}
+
+void BM_PushResamplerInt16(benchmark::State& state,
+                           bool use_polyphase_resampler) {
+  Resample<int16_t>(state, use_polyphase_resampler);
+}
+
+void BM_PushResamplerFloat(benchmark::State& state,
+                           bool use_polyphase_resampler) {
+  Resample<float>(state, use_polyphase_resampler);
+}
+
+BENCHMARK_CAPTURE(BM_PushResamplerInt16, Sinc, false)->Apply(RatePairs);
+BENCHMARK_CAPTURE(BM_PushResamplerInt16, Polyphase, true)->Apply(RatePairs);
+BENCHMARK_CAPTURE(BM_PushResamplerFloat, Sinc, false)->Apply(RatePairs);
+BENCHMARK_CAPTURE(BM_PushResamplerFloat, Polyphase, true)->Apply(RatePairs);
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,95 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+
+// Returns the sum of the twelve 32-bit elements of `v` and `w`.
+static inline int32_t HorizontalSum(__m256i v, __m128i w) {
+  __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(v),
+                              _mm256_extracti128_si256(v, 1));
+  sum = _mm_add_epi32(sum, w);
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(sum);
+}
+
+// Calculates the sum of (vector1[i] * vector2[i]) >> right_shifts, like the C
+// version. As the sums wrap around in the same way, they are bit-exact.
+static inline int32_t DotProductWithShiftAVX2(const int16_t* vector1,
+                                              const int16_t* vector2,
+                                              size_t length,
+                                              int right_shifts) {
+  __m256i sum = _mm256_setzero_si256();
+  // The sum of the eight elements that don't fill a full register.
+  __m128i tail_sum = _mm_setzero_si128();
+  size_t i = 0;
+  if (right_shifts == 0) {
+    // Without shifts, the products can be added pairwise.
+    for (; i + 16 <= length; i += 16) {
+      const __m256i a = _mm256_loadu_si256((const __m256i*)&vector1[i]);
+      const __m256i b = _mm256_loadu_si256((const __m256i*)&vector2[i]);
+      sum = _mm256_add_epi32(sum, _mm256_madd_epi16(a, b));
+    }
+    if (i + 8 <= length) {
+      const __m128i a = _mm_loadu_si128((const __m128i*)&vector1[i]);
+      const __m128i b = _mm_loadu_si128((const __m128i*)&vector2[i]);
+      tail_sum = _mm_madd_epi16(a, b);
+      i += 8;
+    }
+  } else {
+    // Every 32-bit product is shifted before it is added, so they are formed
+    // from their low and high halves.
+    const __m128i shift = _mm_cvtsi32_si128(right_shifts);
+    for (; i + 16 <= length; i += 16) {
+      const __m256i a = _mm256_loadu_si256((const __m256i*)&vector1[i]);
+      const __m256i b = _mm256_loadu_si256((const __m256i*)&vector2[i]);
+      const __m256i low = _mm256_mullo_epi16(a, b);
+      const __m256i high = _mm256_mulhi_epi16(a, b);
+      sum = _mm256_add_epi32(
+          sum, _mm256_sra_epi32(_mm256_unpacklo_epi16(low, high), shift));
+      sum = _mm256_add_epi32(
+          sum, _mm256_sra_epi32(_mm256_unpackhi_epi16(low, high), shift));
+    }
+    if (i + 8 <= length) {
+      const __m128i a = _mm_loadu_si128((const __m128i*)&vector1[i]);
+      const __m128i b = _mm_loadu_si128((const __m128i*)&vector2[i]);
+      const __m128i low = _mm_mullo_epi16(a, b);
+      const __m128i high = _mm_mulhi_epi16(a, b);
+      tail_sum =
+          _mm_add_epi32(_mm_sra_epi32(_mm_unpacklo_epi16(low, high), shift),
+                        _mm_sra_epi32(_mm_unpackhi_epi16(low, high), shift));
+      i += 8;
+    }
+  }
+  int32_t result = HorizontalSum(sum, tail_sum);
+  for (; i < length; i++) {
+    result += (vector1[i] * vector2[i]) >> right_shifts;
+  }
+  return result;
+}
+
+// AVX2 version of WebRtcSpl_CrossCorrelation() for x86 platforms.
+void WebRtcSpl_CrossCorrelationAVX2(int32_t* cross_correlation,
+                                    const int16_t* seq1,
+                                    const int16_t* seq2,
+                                    size_t dim_seq,
+                                    size_t dim_cross_correlation,
+                                    int right_shifts,
+                                    int step_seq2) {
+  size_t i = 0;
+
+  for (i = 0; i < dim_cross_correlation; i++) {
+    *cross_correlation++ =
+        DotProductWithShiftAVX2(seq1, seq2, dim_seq, right_shifts);
+    seq2 += step_seq2;
+  }
+}
@@ -0,0 +1,74 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <smmintrin.h>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+
+// Returns the sum of the four 32-bit elements of `v`.
+static inline int32_t HorizontalSum(__m128i v) {
+  v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+  v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+  return _mm_cvtsi128_si32(v);
+}
+
+// Calculates the sum of (vector1[i] * vector2[i]) >> right_shifts, like the C
+// version. As the sums wrap around in the same way, they are bit-exact.
+static inline int32_t DotProductWithShiftSSE41(const int16_t* vector1,
+                                               const int16_t* vector2,
+                                               size_t length,
+                                               int right_shifts) {
+  __m128i sum = _mm_setzero_si128();
+  size_t i = 0;
+  if (right_shifts == 0) {
+    // Without shifts, the products can be added pairwise.
+    for (; i + 8 <= length; i += 8) {
+      const __m128i a = _mm_loadu_si128((const __m128i*)&vector1[i]);
+      const __m128i b = _mm_loadu_si128((const __m128i*)&vector2[i]);
+      sum = _mm_add_epi32(sum, _mm_madd_epi16(a, b));
+    }
+  } else {
+    // Every 32-bit product is shifted before it is added, so they are formed
+    // from their low and high halves.
+    const __m128i shift = _mm_cvtsi32_si128(right_shifts);
+    for (; i + 8 <= length; i += 8) {
+      const __m128i a = _mm_loadu_si128((const __m128i*)&vector1[i]);
+      const __m128i b = _mm_loadu_si128((const __m128i*)&vector2[i]);
+      const __m128i low = _mm_mullo_epi16(a, b);
+      const __m128i high = _mm_mulhi_epi16(a, b);
+      sum = _mm_add_epi32(
+          sum, _mm_sra_epi32(_mm_unpacklo_epi16(low, high), shift));
+      sum = _mm_add_epi32(
+          sum, _mm_sra_epi32(_mm_unpackhi_epi16(low, high), shift));
+    }
+  }
+  int32_t result = HorizontalSum(sum);
+  for (; i < length; i++) {
+    result += (vector1[i] * vector2[i]) >> right_shifts;
+  }
+  return result;
+}
+
+// SSE4.1 version of WebRtcSpl_CrossCorrelation() for x86 platforms.
+void WebRtcSpl_CrossCorrelationSSE41(int32_t* cross_correlation,
+                                     const int16_t* seq1,
+                                     const int16_t* seq2,
+                                     size_t dim_seq,
+                                     size_t dim_cross_correlation,
+                                     int right_shifts,
+                                     int step_seq2) {
+  size_t i = 0;
+
+  for (i = 0; i < dim_cross_correlation; i++) {
+    *cross_correlation++ =
+        DotProductWithShiftSSE41(seq1, seq2, dim_seq, right_shifts);
+    seq2 += step_seq2;
+  }
+}
@@ -0,0 +1,93 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <smmintrin.h>
+#include <stddef.h>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+
+// SSE4.1 version of WebRtcSpl_DownsampleFast() for x86 platforms. Every output
+// sample is the dot product of the reversed coefficients and the eight input
+// samples that end at the output position, and four output samples are
+// calculated at a time. Filters with more than eight coefficients use the C
+// version.
+int WebRtcSpl_DownsampleFastSSE41(const int16_t* data_in,
+                                  size_t data_in_length,
+                                  int16_t* data_out,
+                                  size_t data_out_length,
+                                  const int16_t* __restrict coefficients,
+                                  size_t coefficients_length,
+                                  int factor,
+                                  size_t delay) {
+  size_t i = 0;
+  size_t j = 0;
+  size_t endpos = delay + factor * (data_out_length - 1) + 1;
+  int16_t reversed_coefficients[8] = {0};
+  __m128i coefficients_vector;
+
+  // Return error if any of the running conditions doesn't meet.
+  if (data_out_length == 0 || coefficients_length == 0 ||
+      data_in_length < endpos) {
+    return -1;
+  }
+  if (coefficients_length > 8) {
+    return WebRtcSpl_DownsampleFastC(data_in, data_in_length, data_out,
+                                     data_out_length, coefficients,
+                                     coefficients_length, factor, delay);
+  }
+
+  // The coefficients are zero-padded at the front, so that coefficient j is
+  // multiplied with input sample i - j.
+  for (j = 0; j < coefficients_length; j++) {
+    reversed_coefficients[7 - j] = coefficients[j];
+  }
+  coefficients_vector = _mm_loadu_si128((const __m128i*)reversed_coefficients);
+
+  // The C version reads no further back than `delay - coefficients_length + 1`
+  // (which may be negative), so the first outputs, whose eight input samples
+  // would start before that, are calculated one by one.
+  for (i = delay; i < endpos && i < delay + 8 - coefficients_length;
+       i += factor) {
+    int32_t out_s32 = 2048;  // Round value, 0.5 in Q12.
+    for (j = 0; j < coefficients_length; j++) {
+      out_s32 += coefficients[j] * data_in[(ptrdiff_t)i - (ptrdiff_t)j];
+    }
+    *data_out++ = WebRtcSpl_SatW32ToW16(out_s32 >> 12);
+  }
+
+  for (; i + 3 * factor < endpos; i += 4 * factor) {
+    const int16_t* in = &data_in[(ptrdiff_t)i - 7];
+    __m128i out0 = _mm_madd_epi16(
+        _mm_loadu_si128((const __m128i*)in), coefficients_vector);
+    __m128i out1 = _mm_madd_epi16(
+        _mm_loadu_si128((const __m128i*)&in[factor]), coefficients_vector);
+    __m128i out2 = _mm_madd_epi16(
+        _mm_loadu_si128((const __m128i*)&in[2 * factor]), coefficients_vector);
+    __m128i out3 = _mm_madd_epi16(
+        _mm_loadu_si128((const __m128i*)&in[3 * factor]), coefficients_vector);
+    // Sum each output's products, round to Q0, saturate and store.
+    __m128i out = _mm_hadd_epi32(_mm_hadd_epi32(out0, out1),
+                                 _mm_hadd_epi32(out2, out3));
+    out = _mm_srai_epi32(_mm_add_epi32(out, _mm_set1_epi32(2048)), 12);
+    _mm_storel_epi64((__m128i*)data_out, _mm_packs_epi32(out, out));
+    data_out += 4;
+  }
+
+  for (; i < endpos; i += factor) {
+    __m128i out = _mm_madd_epi16(
+        _mm_loadu_si128((const __m128i*)&data_in[(ptrdiff_t)i - 7]),
+        coefficients_vector);
+    out = _mm_hadd_epi32(out, out);
+    out = _mm_hadd_epi32(out, out);
+    *data_out++ = WebRtcSpl_SatW32ToW16((_mm_cvtsi128_si32(out) + 2048) >> 12);
+  }
+
+  return 0;
+}
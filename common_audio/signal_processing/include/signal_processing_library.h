@@ -20,6 +20,7 @@
 #include <string.h>
 
 #include "common_audio/signal_processing/dot_product_with_scale.h"
+#include "rtc_base/system/arch.h"
 
 // Macros specific for the fixed point implementation
 #define WEBRTC_SPL_WORD16_MAX 32767
@@ -139,6 +140,14 @@ int16_t WebRtcSpl_MaxAbsValueW16C(const int16_t* vector, size_t length);
 #if defined(WEBRTC_HAS_NEON)
 int16_t WebRtcSpl_MaxAbsValueW16Neon(const int16_t* vector, size_t length);
 #endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+int16_t WebRtcSpl_MaxAbsValueW16SSE41(const int16_t* vector, size_t length);
+int16_t WebRtcSpl_MaxAbsValueW16AVX2(const int16_t* vector, size_t length);
+// The X86 functions call the AVX2 or SSE4.1 version if the CPU supports it,
+// and the C version otherwise. The SIMD versions are bit-exact with the C
+// versions.
+int16_t WebRtcSpl_MaxAbsValueW16X86(const int16_t* vector, size_t length);
+#endif
 #if defined(MIPS32_LE)
 int16_t WebRtcSpl_MaxAbsValueW16_mips(const int16_t* vector, size_t length);
 #endif
@@ -554,6 +563,29 @@ void WebRtcSpl_CrossCorrelationNeon(int32_t* cross_correlation,
                                     int right_shifts,
                                     int step_seq2);
 #endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void WebRtcSpl_CrossCorrelationSSE41(int32_t* cross_correlation,
+                                     const int16_t* seq1,
+                                     const int16_t* seq2,
+                                     size_t dim_seq,
+                                     size_t dim_cross_correlation,
+                                     int right_shifts,
+                                     int step_seq2);
+void WebRtcSpl_CrossCorrelationAVX2(int32_t* cross_correlation,
+                                    const int16_t* seq1,
+                                    const int16_t* seq2,
+                                    size_t dim_seq,
+                                    size_t dim_cross_correlation,
+                                    int right_shifts,
+                                    int step_seq2);
+void WebRtcSpl_CrossCorrelationX86(int32_t* cross_correlation,
+                                   const int16_t* seq1,
+                                   const int16_t* seq2,
+                                   size_t dim_seq,
+                                   size_t dim_cross_correlation,
+                                   int right_shifts,
+                                   int step_seq2);
+#endif
 #if defined(MIPS32_LE)
 void WebRtcSpl_CrossCorrelation_mips(int32_t* cross_correlation,
                                      const int16_t* seq1,
@@ -705,6 +737,32 @@ int WebRtcSpl_DownsampleFastNeon(const int16_t* data_in,
                                  int factor,
                                  size_t delay);
 #endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+int WebRtcSpl_DownsampleFastSSE41(const int16_t* data_in,
+                                  size_t data_in_length,
+                                  int16_t* data_out,
+                                  size_t data_out_length,
+                                  const int16_t* __restrict coefficients,
+                                  size_t coefficients_length,
+                                  int factor,
+                                  size_t delay);
+int WebRtcSpl_DownsampleFastAVX2(const int16_t* data_in,
+                                 size_t data_in_length,
+                                 int16_t* data_out,
+                                 size_t data_out_length,
+                                 const int16_t* __restrict coefficients,
+                                 size_t coefficients_length,
+                                 int factor,
+                                 size_t delay);
+int WebRtcSpl_DownsampleFastX86(const int16_t* data_in,
+                                size_t data_in_length,
+                                int16_t* data_out,
+                                size_t data_out_length,
+                                const int16_t* __restrict coefficients,
+                                size_t coefficients_length,
+                                int factor,
+                                size_t delay);
+#endif
 #if defined(MIPS32_LE)
 int WebRtcSpl_DownsampleFast_mips(const int16_t* data_in,
                                   size_t data_in_length,
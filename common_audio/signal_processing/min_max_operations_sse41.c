@@ -0,0 +1,49 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <smmintrin.h>
+#include <stdlib.h>
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "rtc_base/checks.h"
+
+// Maximum absolute value of word16 vector. SSE4.1 version for x86 platforms.
+int16_t WebRtcSpl_MaxAbsValueW16SSE41(const int16_t* vector, size_t length) {
+  size_t i = 0;
+  int absolute = 0, maximum = 0;
+  // The absolute value of -32768 is 32768 as an unsigned 16-bit value.
+  __m128i maximum_vector = _mm_setzero_si128();
+
+  RTC_DCHECK_GT(length, 0);
+
+  for (; i + 8 <= length; i += 8) {
+    maximum_vector = _mm_max_epu16(
+        maximum_vector,
+        _mm_abs_epi16(_mm_loadu_si128((const __m128i*)&vector[i])));
+  }
+  // The maximum is 0xFFFF minus the minimum of the inverted values.
+  maximum_vector = _mm_minpos_epu16(
+      _mm_xor_si128(maximum_vector, _mm_set1_epi16(-1)));
+  maximum = 0xFFFF - (_mm_cvtsi128_si32(maximum_vector) & 0xFFFF);
+
+  for (; i < length; i++) {
+    absolute = abs((int)vector[i]);
+    if (absolute > maximum) {
+      maximum = absolute;
+    }
+  }
+
+  // Guard the case for abs(-32768).
+  if (maximum > WEBRTC_SPL_WORD16_MAX) {
+    maximum = WEBRTC_SPL_WORD16_MAX;
+  }
+
+  return (int16_t)maximum;
+}
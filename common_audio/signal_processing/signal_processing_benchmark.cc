@@ -0,0 +1,178 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include <stdint.h>
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "rtc_base/random.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+namespace webrtc {
+namespace {
+
+enum class Implementation { kC, kSSE41, kAVX2 };
+
+std::vector<int16_t> RandomVector(size_t length) {
+  Random random(42);
+  std::vector<int16_t> vector(length);
+  for (int16_t& sample : vector) {
+    sample = random.Rand(-10000, 10000);
+  }
+  return vector;
+}
+
+// Returns false, and skips the benchmark, if the CPU lacks the instructions
+// that `implementation` needs.
+bool IsSupported(benchmark::State& state, Implementation implementation) {
+  if ((implementation == Implementation::kSSE41 && !GetCPUInfo(kSSE4_1)) ||
+      (implementation == Implementation::kAVX2 && !GetCPUInfo(kAVX2))) {
+    state.SkipWithError("Not supported by the CPU");
+    return false;
+  }
+  return true;
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+CrossCorrelation GetCrossCorrelation(Implementation implementation) {
+  switch (implementation) {
+    case Implementation::kSSE41:
+      return WebRtcSpl_CrossCorrelationSSE41;
+    case Implementation::kAVX2:
+      return WebRtcSpl_CrossCorrelationAVX2;
+    default:
+      return WebRtcSpl_CrossCorrelationC;
+  }
+}
+
+DownsampleFast GetDownsampleFast(Implementation implementation) {
+  switch (implementation) {
+    case Implementation::kSSE41:
+      return WebRtcSpl_DownsampleFastSSE41;
+    case Implementation::kAVX2:
+      return WebRtcSpl_DownsampleFastAVX2;
+    default:
+      return WebRtcSpl_DownsampleFastC;
+  }
+}
+
+MaxAbsValueW16 GetMaxAbsValueW16(Implementation implementation) {
+  switch (implementation) {
+    case Implementation::kSSE41:
+      return WebRtcSpl_MaxAbsValueW16SSE41;
+    case Implementation::kAVX2:
+      return WebRtcSpl_MaxAbsValueW16AVX2;
+    default:
+      return WebRtcSpl_MaxAbsValueW16C;
+  }
+}
+#else
+CrossCorrelation GetCrossCorrelation(Implementation implementation) {
+  return WebRtcSpl_CrossCorrelationC;
+}
+
+DownsampleFast GetDownsampleFast(Implementation implementation) {
+  return WebRtcSpl_DownsampleFastC;
+}
+
+MaxAbsValueW16 GetMaxAbsValueW16(Implementation implementation) {
+  return WebRtcSpl_MaxAbsValueW16C;
+}
+#endif
+
+// The correlation that NetEq's TimeStretch and Merge calculate on 4 kHz
+// signals: 50 lags of a sequence of `state.range(0)` samples, with and without
+// scaling.
+void BM_CrossCorrelation(benchmark::State& state,
+                         Implementation implementation,
+                         int right_shifts) {
+  if (!IsSupported(state, implementation)) {
+    return;
+  }
+  const CrossCorrelation cross_correlation =
+      GetCrossCorrelation(implementation);
+  const size_t dim_seq = state.range(0);
+  const size_t kDimCrossCorrelation = 50;
+  const std::vector<int16_t> seq1 = RandomVector(dim_seq);
+  const std::vector<int16_t> seq2 =
+      RandomVector(dim_seq + kDimCrossCorrelation);
+  int32_t result[kDimCrossCorrelation];
+  for (auto _ : state) {
+    cross_correlation(result, seq1.data(), seq2.data(), dim_seq,
+                      kDimCrossCorrelation, right_shifts, 1);
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+BENCHMARK_CAPTURE(BM_CrossCorrelation, C, Implementation::kC, 0)
+    ->Arg(60)
+    ->Arg(240);
+BENCHMARK_CAPTURE(BM_CrossCorrelation, SSE41, Implementation::kSSE41, 0)
+    ->Arg(60)
+    ->Arg(240);
+BENCHMARK_CAPTURE(BM_CrossCorrelation, AVX2, Implementation::kAVX2, 0)
+    ->Arg(60)
+    ->Arg(240);
+BENCHMARK_CAPTURE(BM_CrossCorrelation, C_Shifted, Implementation::kC, 3)
+    ->Arg(60)
+    ->Arg(240);
+BENCHMARK_CAPTURE(BM_CrossCorrelation,
+                  SSE41_Shifted,
+                  Implementation::kSSE41,
+                  3)
+    ->Arg(60)
+    ->Arg(240);
+BENCHMARK_CAPTURE(BM_CrossCorrelation, AVX2_Shifted, Implementation::kAVX2, 3)
+    ->Arg(60)
+    ->Arg(240);
+
+// Downsamples 30 ms of 48 kHz audio to 4 kHz, like
+// DspHelper::DownsampleTo4kHz().
+void BM_DownsampleFast(benchmark::State& state, Implementation implementation) {
+  if (!IsSupported(state, implementation)) {
+    return;
+  }
+  const DownsampleFast downsample_fast = GetDownsampleFast(implementation);
+  const int16_t kCoefficients[7] = {1019, 390, 427, 440, 427, 390, 1019};
+  const size_t kInputLength = 1440;
+  const size_t kOutputLength = 119;
+  const std::vector<int16_t> input = RandomVector(kInputLength);
+  int16_t output[kOutputLength];
+  for (auto _ : state) {
+    downsample_fast(&input[6], kInputLength - 6, output, kOutputLength,
+                    kCoefficients, 7, 12, 4);
+    benchmark::DoNotOptimize(output);
+  }
+}
+
+BENCHMARK_CAPTURE(BM_DownsampleFast, C, Implementation::kC);
+BENCHMARK_CAPTURE(BM_DownsampleFast, SSE41, Implementation::kSSE41);
+BENCHMARK_CAPTURE(BM_DownsampleFast, AVX2, Implementation::kAVX2);
+
+// The maximum of 10 ms of 48 kHz audio.
+void BM_MaxAbsValueW16(benchmark::State& state, Implementation implementation) {
+  if (!IsSupported(state, implementation)) {
+    return;
+  }
+  const MaxAbsValueW16 max_abs_value = GetMaxAbsValueW16(implementation);
+  const std::vector<int16_t> input = RandomVector(480);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(max_abs_value(input.data(), input.size()));
+  }
+}
+
+BENCHMARK_CAPTURE(BM_MaxAbsValueW16, C, Implementation::kC);
+BENCHMARK_CAPTURE(BM_MaxAbsValueW16, SSE41, Implementation::kSSE41);
+BENCHMARK_CAPTURE(BM_MaxAbsValueW16, AVX2, Implementation::kAVX2);
+
+}  // namespace
+}  // namespace webrtc
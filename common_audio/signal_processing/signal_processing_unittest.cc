@@ -9,9 +9,13 @@
  */
 
 #include <algorithm>
+#include <vector>
 
 #include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "rtc_base/random.h"
 #include "rtc_base/strings/string_builder.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
 #include "test/gtest.h"
 
 static const size_t kVector16Size = 9;
@@ -539,12 +543,10 @@ TEST(SplTest, CrossCorrelationTest) {
   const int32_t kExpected[kCrossCorrelationDimension] = {-266947903, -15579555,
                                                          -171282001};
   const int32_t* expected = kExpected;
-#if !defined(MIPS32_LE)
+#if defined(WEBRTC_HAS_NEON)
   const int32_t kExpectedNeon[kCrossCorrelationDimension] = {
       -266947901, -15579553, -171281999};
-  if (WebRtcSpl_CrossCorrelation != WebRtcSpl_CrossCorrelationC) {
-    expected = kExpectedNeon;
-  }
+  expected = kExpectedNeon;
 #endif
   for (size_t i = 0; i < kCrossCorrelationDimension; ++i) {
     EXPECT_EQ(expected[i], vector32[i]);
@@ -666,3 +668,125 @@ TEST(SplTest, Resample48WithSaturationTest) {
     EXPECT_EQ(kRefValue16kHz2, out_vector_w16[i]);
   }
 }
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+static std::vector<int16_t> RandomVector(webrtc::Random& random,
+                                         size_t length,
+                                         int16_t max_abs_value) {
+  std::vector<int16_t> vector(length);
+  for (int16_t& sample : vector) {
+    sample = random.Rand(-max_abs_value, max_abs_value);
+  }
+  return vector;
+}
+
+TEST(SplTest, MaxAbsValueW16X86IsBitExact) {
+  webrtc::Random random(42);
+  for (size_t length = 1; length < 70; ++length) {
+    std::vector<int16_t> vector = RandomVector(random, length, 20000);
+    for (int i = 0; i < 2; ++i) {
+      const int16_t expected = WebRtcSpl_MaxAbsValueW16C(vector.data(), length);
+      if (webrtc::GetCPUInfo(webrtc::kSSE4_1)) {
+        EXPECT_EQ(expected,
+                  WebRtcSpl_MaxAbsValueW16SSE41(vector.data(), length));
+      }
+      if (webrtc::GetCPUInfo(webrtc::kAVX2)) {
+        EXPECT_EQ(expected,
+                  WebRtcSpl_MaxAbsValueW16AVX2(vector.data(), length));
+      }
+      EXPECT_EQ(expected, WebRtcSpl_MaxAbsValueW16(vector.data(), length));
+      // abs(-32768) does not fit in 16 bits.
+      vector[random.Rand<uint32_t>() % length] = WEBRTC_SPL_WORD16_MIN;
+    }
+  }
+}
+
+TEST(SplTest, CrossCorrelationX86IsBitExact) {
+  const size_t kMaxDimension = 250;
+  const size_t kDimCrossCorrelation = 20;
+  webrtc::Random random(42);
+  // `seq2` is shifted in both directions from the middle of `seq2_vector`.
+  const std::vector<int16_t> seq1 = RandomVector(random, kMaxDimension, 2000);
+  const std::vector<int16_t> seq2_vector =
+      RandomVector(random, kMaxDimension + 2 * kDimCrossCorrelation, 2000);
+  const int16_t* seq2 = &seq2_vector[kDimCrossCorrelation];
+  int32_t expected[kDimCrossCorrelation];
+  int32_t actual[kDimCrossCorrelation];
+  for (size_t dim_seq : {1, 7, 8, 9, 15, 16, 17, 24, 31, 60, 128, 250}) {
+    for (int right_shifts : {0, 1, 6}) {
+      for (int step : {-1, 1}) {
+        rtc::StringBuilder ss;
+        ss << "dim_seq " << dim_seq << ", right_shifts " << right_shifts
+           << ", step " << step;
+        SCOPED_TRACE(ss.str());
+        WebRtcSpl_CrossCorrelationC(expected, seq1.data(), seq2, dim_seq,
+                                    kDimCrossCorrelation, right_shifts, step);
+        if (webrtc::GetCPUInfo(webrtc::kSSE4_1)) {
+          WebRtcSpl_CrossCorrelationSSE41(actual, seq1.data(), seq2, dim_seq,
+                                          kDimCrossCorrelation, right_shifts,
+                                          step);
+          EXPECT_TRUE(std::equal(expected, expected + kDimCrossCorrelation,
+                                 actual));
+        }
+        if (webrtc::GetCPUInfo(webrtc::kAVX2)) {
+          WebRtcSpl_CrossCorrelationAVX2(actual, seq1.data(), seq2, dim_seq,
+                                         kDimCrossCorrelation, right_shifts,
+                                         step);
+          EXPECT_TRUE(std::equal(expected, expected + kDimCrossCorrelation,
+                                 actual));
+        }
+      }
+    }
+  }
+}
+
+TEST(SplTest, DownsampleFastX86IsBitExact) {
+  const size_t kMaxOutputLength = 41;
+  webrtc::Random random(42);
+  // The input is preceded by a history of as many samples as the longest
+  // filter, which the filters may read.
+  const size_t kHistory = 9;
+  const std::vector<int16_t> input_vector =
+      RandomVector(random, kHistory + 12 * kMaxOutputLength + 12, 32767);
+  const int16_t* data_in = &input_vector[kHistory];
+  const size_t data_in_length = input_vector.size() - kHistory;
+  int16_t expected[kMaxOutputLength];
+  int16_t actual[kMaxOutputLength];
+  for (size_t coefficients_length = 1; coefficients_length <= 9;
+       ++coefficients_length) {
+    // Large enough coefficients in Q12 to make the output saturate.
+    const std::vector<int16_t> coefficients =
+        RandomVector(random, coefficients_length, 8000);
+    for (int factor : {1, 2, 4, 8, 12}) {
+      for (size_t delay = 0; delay < coefficients_length; ++delay) {
+        for (size_t output_length = 1; output_length <= kMaxOutputLength;
+             output_length += 4) {
+          rtc::StringBuilder ss;
+          ss << "coefficients_length " << coefficients_length << ", factor "
+             << factor << ", delay " << delay << ", output_length "
+             << output_length;
+          SCOPED_TRACE(ss.str());
+          ASSERT_EQ(0, WebRtcSpl_DownsampleFastC(
+                           data_in, data_in_length, expected, output_length,
+                           coefficients.data(), coefficients_length, factor,
+                           delay));
+          if (webrtc::GetCPUInfo(webrtc::kSSE4_1)) {
+            ASSERT_EQ(0, WebRtcSpl_DownsampleFastSSE41(
+                             data_in, data_in_length, actual, output_length,
+                             coefficients.data(), coefficients_length, factor,
+                             delay));
+            EXPECT_TRUE(std::equal(expected, expected + output_length, actual));
+          }
+          if (webrtc::GetCPUInfo(webrtc::kAVX2)) {
+            ASSERT_EQ(0, WebRtcSpl_DownsampleFastAVX2(
+                             data_in, data_in_length, actual, output_length,
+                             coefficients.data(), coefficients_length, factor,
+                             delay));
+            EXPECT_TRUE(std::equal(expected, expected + output_length, actual));
+          }
+        }
+      }
+    }
+  }
+}
+#endif  // defined(WEBRTC_ARCH_X86_FAMILY)
@@ -11,6 +11,7 @@
 // Some code came from common/rtcd.c in the WebM project.
 
 #include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "rtc_base/system/arch.h"
 
 // TODO(bugs.webrtc.org/9553): These function pointers are useless. Refactor
 // things so that we simply have a bunch of regular functions with different
@@ -53,6 +54,21 @@ const ScaleAndAddVectorsWithRound WebRtcSpl_ScaleAndAddVectorsWithRound =
     WebRtcSpl_ScaleAndAddVectorsWithRoundC;
 #endif
 
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+
+// The X86 functions pick the implementation at runtime, see spl_init_x86.cc.
+const MaxAbsValueW16 WebRtcSpl_MaxAbsValueW16 = WebRtcSpl_MaxAbsValueW16X86;
+const MaxAbsValueW32 WebRtcSpl_MaxAbsValueW32 = WebRtcSpl_MaxAbsValueW32C;
+const MaxValueW16 WebRtcSpl_MaxValueW16 = WebRtcSpl_MaxValueW16C;
+const MaxValueW32 WebRtcSpl_MaxValueW32 = WebRtcSpl_MaxValueW32C;
+const MinValueW16 WebRtcSpl_MinValueW16 = WebRtcSpl_MinValueW16C;
+const MinValueW32 WebRtcSpl_MinValueW32 = WebRtcSpl_MinValueW32C;
+const CrossCorrelation WebRtcSpl_CrossCorrelation =
+    WebRtcSpl_CrossCorrelationX86;
+const DownsampleFast WebRtcSpl_DownsampleFast = WebRtcSpl_DownsampleFastX86;
+const ScaleAndAddVectorsWithRound WebRtcSpl_ScaleAndAddVectorsWithRound =
+    WebRtcSpl_ScaleAndAddVectorsWithRoundC;
+
 #else
 
 const MaxAbsValueW16 WebRtcSpl_MaxAbsValueW16 = WebRtcSpl_MaxAbsValueW16C;
@@ -0,0 +1,73 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Runtime selection of the x86 implementations of the functions that
+// spl_init.c points to. The selection is made on the first call, rather than
+// when the function pointers are initialized, as the function pointers must be
+// usable during static initialization.
+
+#include "common_audio/signal_processing/include/signal_processing_library.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+namespace webrtc {
+namespace {
+
+template <typename Function>
+Function SelectImplementation(Function avx2, Function sse41, Function c) {
+  if (GetCPUInfo(kAVX2)) {
+    return avx2;
+  }
+  if (GetCPUInfo(kSSE4_1)) {
+    return sse41;
+  }
+  return c;
+}
+
+}  // namespace
+}  // namespace webrtc
+
+int16_t WebRtcSpl_MaxAbsValueW16X86(const int16_t* vector, size_t length) {
+  static const MaxAbsValueW16 implementation =
+      webrtc::SelectImplementation(WebRtcSpl_MaxAbsValueW16AVX2,
+                                   WebRtcSpl_MaxAbsValueW16SSE41,
+                                   WebRtcSpl_MaxAbsValueW16C);
+  return implementation(vector, length);
+}
+
+void WebRtcSpl_CrossCorrelationX86(int32_t* cross_correlation,
+                                   const int16_t* seq1,
+                                   const int16_t* seq2,
+                                   size_t dim_seq,
+                                   size_t dim_cross_correlation,
+                                   int right_shifts,
+                                   int step_seq2) {
+  static const CrossCorrelation implementation =
+      webrtc::SelectImplementation(WebRtcSpl_CrossCorrelationAVX2,
+                                   WebRtcSpl_CrossCorrelationSSE41,
+                                   WebRtcSpl_CrossCorrelationC);
+  implementation(cross_correlation, seq1, seq2, dim_seq, dim_cross_correlation,
+                 right_shifts, step_seq2);
+}
+
+int WebRtcSpl_DownsampleFastX86(const int16_t* data_in,
+                                size_t data_in_length,
+                                int16_t* data_out,
+                                size_t data_out_length,
+                                const int16_t* __restrict coefficients,
+                                size_t coefficients_length,
+                                int factor,
+                                size_t delay) {
+  static const DownsampleFast implementation =
+      webrtc::SelectImplementation(WebRtcSpl_DownsampleFastAVX2,
+                                   WebRtcSpl_DownsampleFastSSE41,
+                                   WebRtcSpl_DownsampleFastC);
+  return implementation(data_in, data_in_length, data_out, data_out_length,
+                        coefficients, coefficients_length, factor, delay);
+}
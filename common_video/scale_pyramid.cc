@@ -0,0 +1,103 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/scale_pyramid.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/algorithm/container.h"
+#include "api/video/i420_buffer.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+ScalePyramid::ScalePyramid() = default;
+
+ScalePyramid::~ScalePyramid() = default;
+
+void ScalePyramid::SetSource(rtc::scoped_refptr<VideoFrameBuffer> source) {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  source_ = std::move(source);
+  // Resolutions that were not requested for the previous frame are likely no
+  // longer in use, e.g. after a change of the input resolution.
+  levels_.erase(
+      std::remove_if(levels_.begin(), levels_.end(),
+                     [](const std::unique_ptr<Level>& level) {
+                       return !level->requested;
+                     }),
+      levels_.end());
+  for (std::unique_ptr<Level>& level : levels_) {
+    level->requested = false;
+    level->buffer = nullptr;
+  }
+}
+
+void ScalePyramid::ReleaseSource() {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  source_ = nullptr;
+  for (std::unique_ptr<Level>& level : levels_) {
+    level->buffer = nullptr;
+  }
+}
+
+rtc::scoped_refptr<VideoFrameBuffer> ScalePyramid::Scale(int width,
+                                                         int height) {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  RTC_DCHECK(source_);
+  if (width == source_->width() && height == source_->height()) {
+    return source_;
+  }
+  if (source_->type() != VideoFrameBuffer::Type::kI420) {
+    return source_->Scale(width, height);
+  }
+
+  Level& level = GetOrCreateLevel(width, height);
+  level.requested = true;
+  if (level.buffer) {
+    return level.buffer;
+  }
+
+  // Scale from the smallest buffer that is at least as large in both
+  // dimensions.
+  const I420BufferInterface* parent = source_->GetI420();
+  for (const std::unique_ptr<Level>& other : levels_) {
+    if (other->buffer && other->width >= width && other->height >= height &&
+        other->width * other->height < parent->width() * parent->height()) {
+      parent = other->buffer.get();
+    }
+  }
+
+  rtc::scoped_refptr<I420Buffer> buffer =
+      level.pool.CreateI420Buffer(width, height);
+  if (!buffer) {
+    return nullptr;
+  }
+  buffer->ScaleFrom(*parent);
+  level.buffer = buffer;
+  return buffer;
+}
+
+ScalePyramid::Level& ScalePyramid::GetOrCreateLevel(int width, int height) {
+  auto it = absl::c_find_if(levels_, [&](const std::unique_ptr<Level>& level) {
+    return level->width == width && level->height == height;
+  });
+  if (it != levels_.end()) {
+    return **it;
+  }
+  levels_.push_back(std::make_unique<Level>());
+  Level& level = *levels_.back();
+  level.width = width;
+  level.height = height;
+  level.requested = false;
+  return level;
+}
+
+}  // namespace webrtc
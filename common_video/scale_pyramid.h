@@ -0,0 +1,74 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef COMMON_VIDEO_SCALE_PYRAMID_H_
+#define COMMON_VIDEO_SCALE_PYRAMID_H_
+
+#include <memory>
+#include <vector>
+
+#include "api/scoped_refptr.h"
+#include "api/video/video_frame_buffer.h"
+#include "common_video/include/video_frame_buffer_pool.h"
+#include "rtc_base/race_checker.h"
+
+namespace webrtc {
+
+// Scales one frame to several resolutions, e.g. those of simulcast streams.
+// Each resolution is scaled from the nearest larger one that was already
+// produced for the frame, instead of from the full resolution frame, and is
+// cached until the next frame. Request the resolutions from the largest to the
+// smallest to get the most out of this.
+//
+// The memory of the scaled buffers comes from one VideoFrameBufferPool per
+// resolution, and is reused across frames once the scaled buffers are
+// released. Only I420 frames are scaled this way; others are scaled with
+// VideoFrameBuffer::Scale().
+//
+// Not thread safe; calls must be serialized.
+class ScalePyramid {
+ public:
+  ScalePyramid();
+  ~ScalePyramid();
+
+  ScalePyramid(const ScalePyramid&) = delete;
+  ScalePyramid& operator=(const ScalePyramid&) = delete;
+
+  // Sets the frame that the following calls to Scale() scale. Drops the
+  // buffers scaled from the previous frame, and the pools of the resolutions
+  // that were not requested for it.
+  void SetSource(rtc::scoped_refptr<VideoFrameBuffer> source);
+
+  // Drops the source and the buffers scaled from it, but keeps the pools.
+  void ReleaseSource();
+
+  // Returns all of the source scaled to `width` x `height`, or null if
+  // scaling fails.
+  rtc::scoped_refptr<VideoFrameBuffer> Scale(int width, int height);
+
+ private:
+  struct Level {
+    int width;
+    int height;
+    bool requested;
+    VideoFrameBufferPool pool;
+    rtc::scoped_refptr<I420BufferInterface> buffer;
+  };
+
+  Level& GetOrCreateLevel(int width, int height);
+
+  rtc::RaceChecker race_checker_;
+  rtc::scoped_refptr<VideoFrameBuffer> source_;
+  std::vector<std::unique_ptr<Level>> levels_;
+};
+
+}  // namespace webrtc
+
+#endif  // COMMON_VIDEO_SCALE_PYRAMID_H_
@@ -0,0 +1,53 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "api/video/i420_buffer.h"
+#include "benchmark/benchmark.h"
+#include "common_video/scale_pyramid.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kWidth = 1920;
+constexpr int kHeight = 1080;
+
+// Scales a 1080p frame to the lower streams of simulcast with the number of
+// streams given by the first argument, each half the size of the one above.
+// The second argument is whether the streams are scaled with a ScalePyramid,
+// or each from the full resolution frame.
+void BM_ScaleSimulcast(benchmark::State& state) {
+  const int num_streams = static_cast<int>(state.range(0));
+  const bool use_pyramid = state.range(1) != 0;
+  rtc::scoped_refptr<I420Buffer> source = I420Buffer::Create(kWidth, kHeight);
+  I420Buffer::SetBlack(source.get());
+  ScalePyramid pyramid;
+  for (auto _ : state) {
+    pyramid.SetSource(source);
+    // The highest stream has the resolution of the source.
+    for (int i = 1; i < num_streams; ++i) {
+      const int width = kWidth >> i;
+      const int height = kHeight >> i;
+      rtc::scoped_refptr<VideoFrameBuffer> scaled =
+          use_pyramid ? pyramid.Scale(width, height)
+                      : source->Scale(width, height);
+      benchmark::DoNotOptimize(scaled);
+    }
+    pyramid.ReleaseSource();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_ScaleSimulcast)
+    ->ArgsProduct({{3, 4}, {0, 1}})
+    ->ArgNames({"streams", "pyramid"})
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace
+}  // namespace webrtc
@@ -0,0 +1,130 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "common_video/scale_pyramid.h"
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "api/video/i420_buffer.h"
+#include "api/video/nv12_buffer.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+rtc::scoped_refptr<I420Buffer> CreateGradient(int width, int height) {
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width, height);
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      buffer->MutableDataY()[y * buffer->StrideY() + x] =
+          static_cast<uint8_t>(255 * (x + y) / (width + height));
+    }
+  }
+  for (int y = 0; y < buffer->ChromaHeight(); ++y) {
+    for (int x = 0; x < buffer->ChromaWidth(); ++x) {
+      buffer->MutableDataU()[y * buffer->StrideU() + x] =
+          static_cast<uint8_t>(255 * x / buffer->ChromaWidth());
+      buffer->MutableDataV()[y * buffer->StrideV() + x] =
+          static_cast<uint8_t>(255 * y / buffer->ChromaHeight());
+    }
+  }
+  return buffer;
+}
+
+int MaxLumaDifference(const I420BufferInterface& a,
+                      const I420BufferInterface& b) {
+  EXPECT_EQ(a.width(), b.width());
+  EXPECT_EQ(a.height(), b.height());
+  int max_difference = 0;
+  for (int y = 0; y < a.height(); ++y) {
+    for (int x = 0; x < a.width(); ++x) {
+      max_difference =
+          std::max(max_difference, abs(a.DataY()[y * a.StrideY() + x] -
+                                       b.DataY()[y * b.StrideY() + x]));
+    }
+  }
+  return max_difference;
+}
+
+TEST(ScalePyramidTest, ReturnsSourceForItsOwnResolution) {
+  rtc::scoped_refptr<I420Buffer> source = CreateGradient(640, 360);
+  ScalePyramid pyramid;
+  pyramid.SetSource(source);
+  EXPECT_EQ(pyramid.Scale(640, 360), source);
+}
+
+TEST(ScalePyramidTest, ScalesLikeTheSource) {
+  rtc::scoped_refptr<I420Buffer> source = CreateGradient(1280, 720);
+  ScalePyramid pyramid;
+  pyramid.SetSource(source);
+  for (const auto& size : {std::make_pair(640, 360), std::make_pair(320, 180),
+                           std::make_pair(160, 90)}) {
+    rtc::scoped_refptr<VideoFrameBuffer> scaled =
+        pyramid.Scale(size.first, size.second);
+    ASSERT_TRUE(scaled);
+    EXPECT_EQ(scaled->width(), size.first);
+    EXPECT_EQ(scaled->height(), size.second);
+    // Scaling in steps gives the same image as scaling directly, up to
+    // rounding.
+    EXPECT_LE(MaxLumaDifference(*scaled->GetI420(),
+                                *source->Scale(size.first, size.second)
+                                     ->GetI420()),
+              2);
+  }
+}
+
+TEST(ScalePyramidTest, CachesScaledBuffersUntilNextSource) {
+  ScalePyramid pyramid;
+  pyramid.SetSource(CreateGradient(1280, 720));
+  rtc::scoped_refptr<VideoFrameBuffer> scaled = pyramid.Scale(640, 360);
+  EXPECT_EQ(pyramid.Scale(640, 360), scaled);
+
+  pyramid.SetSource(CreateGradient(1280, 720));
+  EXPECT_NE(pyramid.Scale(640, 360), scaled);
+}
+
+TEST(ScalePyramidTest, ReusesMemoryOfReleasedBuffers) {
+  ScalePyramid pyramid;
+  pyramid.SetSource(CreateGradient(1280, 720));
+  const uint8_t* data = pyramid.Scale(640, 360)->GetI420()->DataY();
+  pyramid.ReleaseSource();
+
+  pyramid.SetSource(CreateGradient(1280, 720));
+  EXPECT_EQ(pyramid.Scale(640, 360)->GetI420()->DataY(), data);
+}
+
+TEST(ScalePyramidTest, DoesNotReuseMemoryOfBuffersInUse) {
+  ScalePyramid pyramid;
+  pyramid.SetSource(CreateGradient(1280, 720));
+  rtc::scoped_refptr<VideoFrameBuffer> scaled = pyramid.Scale(640, 360);
+  pyramid.ReleaseSource();
+
+  pyramid.SetSource(CreateGradient(1280, 720));
+  EXPECT_NE(pyramid.Scale(640, 360)->GetI420()->DataY(),
+            scaled->GetI420()->DataY());
+}
+
+TEST(ScalePyramidTest, ScalesOtherBufferTypesDirectly) {
+  rtc::scoped_refptr<NV12Buffer> source = NV12Buffer::Create(1280, 720);
+  source->InitializeData();
+  ScalePyramid pyramid;
+  pyramid.SetSource(source);
+  rtc::scoped_refptr<VideoFrameBuffer> scaled = pyramid.Scale(640, 360);
+  ASSERT_TRUE(scaled);
+  EXPECT_EQ(scaled->type(), VideoFrameBuffer::Type::kNV12);
+  EXPECT_EQ(scaled->width(), 640);
+  EXPECT_EQ(scaled->height(), 360);
+}
+
+}  // namespace
+}  // namespace webrtc
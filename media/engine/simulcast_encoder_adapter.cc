@@ -33,7 +33,9 @@
 #include "rtc_base/checks.h"
 #include "rtc_base/experiments/rate_control_settings.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/time_utils.h"
 #include "system_wrappers/include/field_trial.h"
+#include "system_wrappers/include/metrics.h"
 
 namespace {
 
@@ -42,6 +44,12 @@ const unsigned int kDefaultMaxQp = 56;
 // Max qp for lowest spatial resolution when doing simulcast.
 const unsigned int kLowestResMaxQp = 45;
 
+// Encode times are counted in steps of 0.1 ms, and those below 100 ms are kept
+// in a histogram.
+constexpr webrtc::TimeDelta kEncodeTimeResolution =
+    webrtc::TimeDelta::Micros(100);
+constexpr uint32_t kEncodeTimeHistogramSize = 1000;
+
 absl::optional<unsigned int> GetScreenshareBoostedQpValue() {
   std::string experiment_group =
       webrtc::field_trial::FindFullName("WebRTC-BoostedScreenshareQp");
@@ -178,7 +186,9 @@ SimulcastEncoderAdapter::StreamContext::StreamContext(
       width_(width),
       height_(height),
       is_keyframe_needed_(false),
-      is_paused_(is_paused) {
+      is_paused_(is_paused),
+      is_holding_encoded_images_(false),
+      encode_times_(kEncodeTimeHistogramSize) {
   if (parent_) {
     encoder_context_->encoder().RegisterEncodeCompleteCallback(this);
   }
@@ -192,7 +202,10 @@ SimulcastEncoderAdapter::StreamContext::StreamContext(StreamContext&& rhs)
       width_(rhs.width_),
       height_(rhs.height_),
       is_keyframe_needed_(rhs.is_keyframe_needed_),
-      is_paused_(rhs.is_paused_) {
+      is_paused_(rhs.is_paused_),
+      is_holding_encoded_images_(rhs.is_holding_encoded_images_),
+      held_encoded_images_(std::move(rhs.held_encoded_images_)),
+      encode_times_(std::move(rhs.encode_times_)) {
   if (parent_) {
     encoder_context_->encoder().RegisterEncodeCompleteCallback(this);
   }
@@ -217,12 +230,48 @@ void SimulcastEncoderAdapter::StreamContext::OnKeyframe(Timestamp timestamp) {
   }
 }
 
+void SimulcastEncoderAdapter::StreamContext::OnDeltaFrame(Timestamp timestamp) {
+  if (framerate_controller_) {
+    framerate_controller_->KeepFrame(timestamp.us() * 1000);
+  }
+}
+
 bool SimulcastEncoderAdapter::StreamContext::ShouldDropFrame(
-    Timestamp timestamp) {
+    Timestamp timestamp) const {
   if (!framerate_controller_) {
     return false;
   }
-  return framerate_controller_->ShouldDropFrame(timestamp.us() * 1000);
+  // Decide on a copy, so that the frame is only counted once it is sent.
+  FramerateController framerate_controller = *framerate_controller_;
+  return framerate_controller.ShouldDropFrame(timestamp.us() * 1000);
+}
+
+void SimulcastEncoderAdapter::StreamContext::StartHoldingEncodedImages() {
+  RTC_DCHECK(parent_);
+  is_holding_encoded_images_ = true;
+}
+
+void SimulcastEncoderAdapter::StreamContext::DeliverHeldEncodedImages() {
+  is_holding_encoded_images_ = false;
+  for (const auto& held_image : held_encoded_images_) {
+    parent_->OnEncodedImage(stream_idx_, held_image.first, &held_image.second);
+  }
+  held_encoded_images_.clear();
+}
+
+void SimulcastEncoderAdapter::StreamContext::AddEncodeTime(
+    TimeDelta encode_time) {
+  encode_times_.Add(static_cast<uint32_t>(encode_time / kEncodeTimeResolution));
+}
+
+absl::optional<TimeDelta>
+SimulcastEncoderAdapter::StreamContext::GetEncodeTimePercentile(
+    float fraction) {
+  absl::optional<uint32_t> percentile = encode_times_.GetPercentile(fraction);
+  if (!percentile) {
+    return absl::nullopt;
+  }
+  return kEncodeTimeResolution * static_cast<int64_t>(*percentile);
 }
 
 EncodedImageCallback::Result
@@ -230,6 +279,10 @@ SimulcastEncoderAdapter::StreamContext::OnEncodedImage(
     const EncodedImage& encoded_image,
     const CodecSpecificInfo* codec_specific_info) {
   RTC_CHECK(parent_);  // If null, this method should never be called.
+  if (is_holding_encoded_images_) {
+    held_encoded_images_.emplace_back(encoded_image, *codec_specific_info);
+    return Result(Result::OK, encoded_image.Timestamp());
+  }
   return parent_->OnEncodedImage(stream_idx_, encoded_image,
                                  codec_specific_info);
 }
@@ -255,6 +308,12 @@ SimulcastEncoderAdapter::SimulcastEncoderAdapter(
       total_streams_count_(0),
       bypass_mode_(false),
       encoded_complete_callback_(nullptr),
+      parallel_encoding_enabled_(field_trial::IsEnabled(
+          "WebRTC-SimulcastEncoderAdapter-ParallelEncoding")),
+      scale_pyramid_(
+          field_trial::IsEnabled("WebRTC-SimulcastEncoderAdapter-ScalePyramid")
+              ? std::make_unique<ScalePyramid>()
+              : nullptr),
       experimental_boosted_screenshare_qp_(GetScreenshareBoostedQpValue()),
       boost_base_layer_quality_(RateControlSettings::ParseFromFieldTrials()
                                     .Vp8BoostBaseLayerQuality()),
@@ -280,6 +339,21 @@ void SimulcastEncoderAdapter::SetFecControllerOverride(
 int SimulcastEncoderAdapter::Release() {
   RTC_DCHECK_RUN_ON(&encoder_queue_);
 
+  // In bypass mode, the encode time is that of all streams together.
+  if (!bypass_mode_) {
+    for (auto& layer : stream_contexts_) {
+      absl::optional<TimeDelta> encode_time =
+          layer.GetEncodeTimePercentile(0.95f);
+      if (encode_time && layer.stream_idx() < kMaxSimulcastStreams) {
+        RTC_HISTOGRAMS_COUNTS_1000(
+            layer.stream_idx(),
+            "WebRTC.Video.SimulcastEncoderAdapter.EncodeTime95PercentileMs."
+            "Stream" + std::to_string(layer.stream_idx()),
+            encode_time->ms());
+      }
+    }
+  }
+
   while (!stream_contexts_.empty()) {
     // Move the encoder instances and put it on the `cached_encoder_contexts_`
     // where it may possibly be reused from (ordering does not matter).
@@ -365,6 +439,7 @@ int SimulcastEncoderAdapter::InitEncode(
           /*framerate_controller=*/nullptr, /*stream_idx=*/0, codec_.width,
           codec_.height, /*is_paused=*/active_streams_count == 0);
       bypass_mode_ = true;
+      worker_pool_.reset();
 
       DestroyStoredEncoders();
       inited_.store(1);
@@ -382,6 +457,15 @@ int SimulcastEncoderAdapter::InitEncode(
   std::vector<uint32_t> stream_start_bitrate_kbps =
       GetStreamStartBitratesKbps(codec_);
 
+  InitializeWorkerPool(is_legacy_singlecast ? 1 : active_streams_count,
+                       settings.number_of_cores);
+  // Encoders that run at the same time share the cores.
+  VideoEncoder::Settings stream_settings = settings;
+  if (worker_pool_) {
+    stream_settings.number_of_cores =
+        std::max(1, settings.number_of_cores / active_streams_count);
+  }
+
   for (int stream_idx = 0; stream_idx < total_streams_count_; ++stream_idx) {
     if (!is_legacy_singlecast && !codec_.simulcastStream[stream_idx].active) {
       continue;
@@ -401,7 +485,8 @@ int SimulcastEncoderAdapter::InitEncode(
         /*is_lowest_quality_stream=*/stream_idx == lowest_quality_stream_idx,
         /*is_highest_quality_stream=*/stream_idx == highest_quality_stream_idx);
 
-    int ret = encoder_context->encoder().InitEncode(&stream_codec, settings);
+    int ret =
+        encoder_context->encoder().InitEncode(&stream_codec, stream_settings);
     if (ret < 0) {
       encoder_context.reset();
       Release();
@@ -410,8 +495,10 @@ int SimulcastEncoderAdapter::InitEncode(
 
     // Intercept frame encode complete callback only for upper streams, where
     // we need to set a correct stream index. Set `parent` to nullptr for the
-    // lowest stream to bypass the callback.
-    SimulcastEncoderAdapter* parent = stream_idx > 0 ? this : nullptr;
+    // lowest stream to bypass the callback, unless the encoded images of all
+    // streams are held for in-order delivery.
+    SimulcastEncoderAdapter* parent =
+        stream_idx > 0 || worker_pool_ ? this : nullptr;
 
     bool is_paused = stream_start_bitrate_kbps[stream_idx] == 0;
     stream_contexts_.emplace_back(
@@ -482,21 +569,17 @@ int SimulcastEncoderAdapter::Encode(
     }
   }
 
-  // Temporary thay may hold the result of texture to i420 buffer conversion.
-  rtc::scoped_refptr<VideoFrameBuffer> src_buffer;
-  int src_width = input_image.width();
-  int src_height = input_image.height();
+  // Convert timestamp from RTP 90kHz clock.
+  const Timestamp frame_timestamp =
+      Timestamp::Micros((1000 * input_image.timestamp()) / 90);
 
+  std::vector<LayerFrame> layer_frames;
   for (auto& layer : stream_contexts_) {
     // Don't encode frames in resolutions that we don't intend to send.
     if (layer.is_paused()) {
       continue;
     }
 
-    // Convert timestamp from RTP 90kHz clock.
-    const Timestamp frame_timestamp =
-        Timestamp::Micros((1000 * input_image.timestamp()) / 90);
-
     // If adapter is passed through and only one sw encoder does simulcast,
     // frame types for all streams should be passed to the encoder unchanged.
     // Otherwise a single per-encoder frame type is passed.
@@ -505,7 +588,6 @@ int SimulcastEncoderAdapter::Encode(
     if (is_keyframe_needed) {
       std::fill(stream_frame_types.begin(), stream_frame_types.end(),
                 VideoFrameType::kVideoFrameKey);
-      layer.OnKeyframe(frame_timestamp);
     } else {
       if (layer.ShouldDropFrame(frame_timestamp)) {
         continue;
@@ -513,58 +595,175 @@ int SimulcastEncoderAdapter::Encode(
       std::fill(stream_frame_types.begin(), stream_frame_types.end(),
                 VideoFrameType::kVideoFrameDelta);
     }
+    layer_frames.push_back({&layer, std::move(stream_frame_types)});
+  }
 
-    // If scaling isn't required, because the input resolution
-    // matches the destination or the input image is empty (e.g.
-    // a keyframe request for encoders with internal camera
-    // sources) or the source image has a native handle, pass the image on
-    // directly. Otherwise, we'll scale it to match what the encoder expects
-    // (below).
-    // For texture frames, the underlying encoder is expected to be able to
-    // correctly sample/scale the source texture.
-    // TODO(perkj): ensure that works going forward, and figure out how this
-    // affects webrtc:5683.
-    if ((layer.width() == src_width && layer.height() == src_height) ||
-        (input_image.video_frame_buffer()->type() ==
-             VideoFrameBuffer::Type::kNative &&
-         layer.encoder().GetEncoderInfo().supports_native_handle)) {
-      int ret = layer.encoder().Encode(input_image, &stream_frame_types);
-      if (ret != WEBRTC_VIDEO_CODEC_OK) {
-        return ret;
-      }
-    } else {
-      if (src_buffer == nullptr) {
-        src_buffer = input_image.video_frame_buffer();
-      }
-      rtc::scoped_refptr<VideoFrameBuffer> dst_buffer =
-          src_buffer->Scale(layer.width(), layer.height());
-      if (!dst_buffer) {
-        RTC_LOG(LS_ERROR) << "Failed to scale video frame";
-        return WEBRTC_VIDEO_CODEC_ENCODER_FAILURE;
-      }
+  if (scale_pyramid_) {
+    ScaleWithPyramid(input_image, layer_frames);
+  }
 
-      // UpdateRect is not propagated to lower simulcast layers currently.
-      // TODO(ilnik): Consider scaling UpdateRect together with the buffer.
-      VideoFrame frame(input_image);
-      frame.set_video_frame_buffer(dst_buffer);
-      frame.set_rotation(webrtc::kVideoRotation_0);
-      frame.set_update_rect(
-          VideoFrame::UpdateRect{0, 0, frame.width(), frame.height()});
-      int ret = layer.encoder().Encode(frame, &stream_frame_types);
+  // A stream only counts the frame once it is passed to its encoder, so that
+  // the streams that are not encoded after a failure keep their state.
+  auto on_frame_sent = [&](const LayerFrame& layer_frame) {
+    if (layer_frame.frame_types[0] == VideoFrameType::kVideoFrameKey) {
+      layer_frame.layer->OnKeyframe(frame_timestamp);
+    } else {
+      layer_frame.layer->OnDeltaFrame(frame_timestamp);
+    }
+  };
+
+  // Native buffers are left to the encoders to scale and convert, which they
+  // may not support doing concurrently.
+  int ret = WEBRTC_VIDEO_CODEC_OK;
+  if (worker_pool_ && input_image.video_frame_buffer()->type() !=
+                          VideoFrameBuffer::Type::kNative) {
+    for (const LayerFrame& layer_frame : layer_frames) {
+      on_frame_sent(layer_frame);
+    }
+    ret = EncodeLayersInParallel(input_image, layer_frames);
+  } else {
+    for (const LayerFrame& layer_frame : layer_frames) {
+      on_frame_sent(layer_frame);
+      ret = EncodeLayer(layer_frame, input_image);
       if (ret != WEBRTC_VIDEO_CODEC_OK) {
-        return ret;
+        break;
       }
     }
   }
 
+  if (scale_pyramid_) {
+    scale_pyramid_->ReleaseSource();
+  }
+  return ret;
+}
+
+void SimulcastEncoderAdapter::ScaleWithPyramid(
+    const VideoFrame& input_image,
+    rtc::ArrayView<LayerFrame> layer_frames) {
+  if (input_image.video_frame_buffer()->type() !=
+      VideoFrameBuffer::Type::kI420) {
+    return;
+  }
+  std::vector<LayerFrame*> to_scale;
+  for (LayerFrame& layer_frame : layer_frames) {
+    if (layer_frame.layer->width() != input_image.width() ||
+        layer_frame.layer->height() != input_image.height()) {
+      to_scale.push_back(&layer_frame);
+    }
+  }
+  // With a single stream to scale, there is nothing to share.
+  if (to_scale.size() < 2) {
+    return;
+  }
+  // Scale the largest stream first, so that each stream can be scaled from
+  // the one above it.
+  absl::c_sort(to_scale, [](const LayerFrame* a, const LayerFrame* b) {
+    return a->layer->width() * a->layer->height() >
+           b->layer->width() * b->layer->height();
+  });
+  scale_pyramid_->SetSource(input_image.video_frame_buffer());
+  for (LayerFrame* layer_frame : to_scale) {
+    const int64_t start_time_us = rtc::TimeMicros();
+    layer_frame->scaled_buffer = scale_pyramid_->Scale(
+        layer_frame->layer->width(), layer_frame->layer->height());
+    layer_frame->scale_time =
+        TimeDelta::Micros(rtc::TimeMicros() - start_time_us);
+  }
+}
+
+int SimulcastEncoderAdapter::EncodeLayer(const LayerFrame& layer_frame,
+                                         const VideoFrame& input_image) {
+  StreamContext& layer = *layer_frame.layer;
+  const std::vector<VideoFrameType>& frame_types = layer_frame.frame_types;
+  const int64_t start_time_us = rtc::TimeMicros();
+  int ret;
+  // If scaling isn't required, because the input resolution
+  // matches the destination or the input image is empty (e.g.
+  // a keyframe request for encoders with internal camera
+  // sources) or the source image has a native handle, pass the image on
+  // directly. Otherwise, we'll scale it to match what the encoder expects
+  // (below), unless it has already been scaled.
+  // For texture frames, the underlying encoder is expected to be able to
+  // correctly sample/scale the source texture.
+  // TODO(perkj): ensure that works going forward, and figure out how this
+  // affects webrtc:5683.
+  if ((layer.width() == input_image.width() &&
+       layer.height() == input_image.height()) ||
+      (input_image.video_frame_buffer()->type() ==
+           VideoFrameBuffer::Type::kNative &&
+       layer.encoder().GetEncoderInfo().supports_native_handle)) {
+    ret = layer.encoder().Encode(input_image, &frame_types);
+  } else {
+    rtc::scoped_refptr<VideoFrameBuffer> dst_buffer =
+        layer_frame.scaled_buffer
+            ? layer_frame.scaled_buffer
+            : input_image.video_frame_buffer()->Scale(layer.width(),
+                                                      layer.height());
+    if (!dst_buffer) {
+      RTC_LOG(LS_ERROR) << "Failed to scale video frame";
+      return WEBRTC_VIDEO_CODEC_ENCODER_FAILURE;
+    }
+
+    // UpdateRect is not propagated to lower simulcast layers currently.
+    // TODO(ilnik): Consider scaling UpdateRect together with the buffer.
+    VideoFrame frame(input_image);
+    frame.set_video_frame_buffer(dst_buffer);
+    frame.set_rotation(webrtc::kVideoRotation_0);
+    frame.set_update_rect(
+        VideoFrame::UpdateRect{0, 0, frame.width(), frame.height()});
+    ret = layer.encoder().Encode(frame, &frame_types);
+  }
+  layer.AddEncodeTime(layer_frame.scale_time +
+                      TimeDelta::Micros(rtc::TimeMicros() - start_time_us));
+  return ret;
+}
+
+int SimulcastEncoderAdapter::EncodeLayersInParallel(
+    const VideoFrame& input_image,
+    rtc::ArrayView<const LayerFrame> layer_frames) {
+  RTC_DCHECK(worker_pool_);
+  for (const LayerFrame& layer_frame : layer_frames) {
+    layer_frame.layer->StartHoldingEncodedImages();
+  }
+  std::vector<int> results(layer_frames.size());
+  worker_pool_->ParallelFor(layer_frames.size(), [&](size_t i) {
+    results[i] = EncodeLayer(layer_frames[i], input_image);
+  });
+  for (const LayerFrame& layer_frame : layer_frames) {
+    layer_frame.layer->DeliverHeldEncodedImages();
+  }
+  for (int ret : results) {
+    if (ret != WEBRTC_VIDEO_CODEC_OK) {
+      return ret;
+    }
+  }
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
+void SimulcastEncoderAdapter::InitializeWorkerPool(int num_encoders,
+                                                   int number_of_cores) {
+  // The encoder task queue encodes one of the streams itself.
+  const int num_worker_threads =
+      parallel_encoding_enabled_
+          ? std::min({num_encoders - 1, number_of_cores - 1,
+                      WorkerPool::kMaxNumWorkerThreads})
+          : 0;
+  if (num_worker_threads <= 0) {
+    worker_pool_.reset();
+  } else if (!worker_pool_ ||
+             worker_pool_->num_worker_threads() != num_worker_threads) {
+    worker_pool_ = std::make_unique<WorkerPool>(
+        num_worker_threads, "SimulcastEncodeWorker",
+        rtc::ThreadPriority::kNormal);
+  }
+}
+
 int SimulcastEncoderAdapter::RegisterEncodeCompleteCallback(
     EncodedImageCallback* callback) {
   RTC_DCHECK_RUN_ON(&encoder_queue_);
   encoded_complete_callback_ = callback;
-  if (!stream_contexts_.empty() && stream_contexts_.front().stream_idx() == 0) {
+  if (!stream_contexts_.empty() && stream_contexts_.front().stream_idx() == 0 &&
+      !worker_pool_) {
     // Bypass frame encode complete callback for the lowest layer since there is
     // no need to override frame's spatial index.
     stream_contexts_.front().encoder().RegisterEncodeCompleteCallback(callback);
@@ -676,6 +875,21 @@ void SimulcastEncoderAdapter::OnDroppedFrame(size_t stream_idx) {
   // Not yet implemented.
 }
 
+absl::optional<TimeDelta> SimulcastEncoderAdapter::GetEncodeTimePercentile(
+    int stream_idx,
+    float fraction) {
+  RTC_DCHECK_RUN_ON(&encoder_queue_);
+  if (bypass_mode_) {
+    return absl::nullopt;
+  }
+  for (auto& layer : stream_contexts_) {
+    if (layer.stream_idx() == stream_idx) {
+      return layer.GetEncodeTimePercentile(fraction);
+    }
+  }
+  return absl::nullopt;
+}
+
 bool SimulcastEncoderAdapter::Initialized() const {
   return inited_.load() == 1;
 }
@@ -21,16 +21,23 @@
 #include <vector>
 
 #include "absl/types/optional.h"
+#include "api/array_view.h"
 #include "api/fec_controller_override.h"
+#include "api/scoped_refptr.h"
 #include "api/sequence_checker.h"
+#include "api/units/time_delta.h"
+#include "api/video/video_frame_buffer.h"
 #include "api/video_codecs/sdp_video_format.h"
 #include "api/video_codecs/video_encoder.h"
 #include "api/video_codecs/video_encoder_factory.h"
 #include "common_video/framerate_controller.h"
+#include "common_video/scale_pyramid.h"
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "rtc_base/experiments/encoder_info_settings.h"
+#include "rtc_base/numerics/histogram_percentile_counter.h"
 #include "rtc_base/system/no_unique_address.h"
 #include "rtc_base/system/rtc_export.h"
+#include "rtc_base/worker_pool.h"
 
 namespace webrtc {
 
@@ -38,6 +45,21 @@ namespace webrtc {
 // webrtc::VideoEncoder instances with the given VideoEncoderFactory.
 // The object is created and destroyed on the worker thread, but all public
 // interfaces should be called from the encoder task queue.
+//
+// With the field trial WebRTC-SimulcastEncoderAdapter-ParallelEncoding, the
+// streams of a frame are encoded in parallel on a pool of worker threads, when
+// there is one encoder per stream and more than one core. The encoded images
+// are delivered in stream order on the encoder task queue, after all streams
+// of the frame are encoded. The cores are split evenly between the encoders.
+// Encode() of the encoders is then called on the worker threads for frames
+// that are not native, while their other methods are still called on the
+// encoder task queue. Each encoder is only called by one thread at a time, but
+// not always by the same thread, so the field trial must not be enabled with
+// encoders that need to be called on the thread that created them.
+//
+// With the field trial WebRTC-SimulcastEncoderAdapter-ScalePyramid, each
+// stream of an I420 frame is scaled from the next larger stream instead of
+// from the input frame, when more than one stream needs scaling.
 class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
  public:
   // TODO(bugs.webrtc.org/11000): Remove when downstream usage is gone.
@@ -67,6 +89,13 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
 
   EncoderInfo GetEncoderInfo() const override;
 
+  // Returns the `fraction` percentile, from 0 to 1, of the time taken to scale
+  // and encode a frame of simulcast stream `stream_idx` since InitEncode(), in
+  // steps of 0.1 ms. Returns nullopt if the stream has no encoder of its own,
+  // or if it has not encoded any frames.
+  absl::optional<TimeDelta> GetEncodeTimePercentile(int stream_idx,
+                                                    float fraction);
+
  private:
   class EncoderContext {
    public:
@@ -128,8 +157,21 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
     }
 
     std::unique_ptr<EncoderContext> ReleaseEncoderContext() &&;
+    // Count a frame at `timestamp` as sent to the encoder.
     void OnKeyframe(Timestamp timestamp);
-    bool ShouldDropFrame(Timestamp timestamp);
+    void OnDeltaFrame(Timestamp timestamp);
+    // Returns true if a delta frame at `timestamp` would exceed the max frame
+    // rate of the stream. Does not count the frame as sent.
+    bool ShouldDropFrame(Timestamp timestamp) const;
+
+    // While holding, encoded images are stored instead of being passed on to
+    // the parent. Holding is only supported if the parent is set.
+    void StartHoldingEncodedImages();
+    // Stops holding, and passes on the stored images.
+    void DeliverHeldEncodedImages();
+
+    void AddEncodeTime(TimeDelta encode_time);
+    absl::optional<TimeDelta> GetEncodeTimePercentile(float fraction);
 
    private:
     SimulcastEncoderAdapter* const parent_;
@@ -140,6 +182,20 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
     const uint16_t height_;
     bool is_keyframe_needed_;
     bool is_paused_;
+    bool is_holding_encoded_images_;
+    std::vector<std::pair<EncodedImage, CodecSpecificInfo>>
+        held_encoded_images_;
+    // In steps of `kEncodeTimeResolution`.
+    rtc::HistogramPercentileCounter encode_times_;
+  };
+
+  // A stream to encode, the frame types to encode it with, and the input
+  // frame buffer scaled to its resolution if that was done in advance.
+  struct LayerFrame {
+    StreamContext* layer;
+    std::vector<VideoFrameType> frame_types;
+    rtc::scoped_refptr<VideoFrameBuffer> scaled_buffer;
+    TimeDelta scale_time = TimeDelta::Zero();
   };
 
   bool Initialized() const;
@@ -165,6 +221,22 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
 
   void OnDroppedFrame(size_t stream_idx);
 
+  // Scales `input_image` to the resolutions of `layer_frames` with
+  // `scale_pyramid_`, if that saves work.
+  void ScaleWithPyramid(const VideoFrame& input_image,
+                        rtc::ArrayView<LayerFrame> layer_frames);
+  // Scales `input_image` to the resolution of the stream, if needed and not
+  // done in advance, and encodes it with the stream's encoder.
+  int EncodeLayer(const LayerFrame& layer_frame, const VideoFrame& input_image);
+  // Encodes `layer_frames` on `worker_pool_`, and then delivers their encoded
+  // images in stream order. All streams are encoded even if one fails, in
+  // which case the error of the first failing stream is returned.
+  int EncodeLayersInParallel(const VideoFrame& input_image,
+                             rtc::ArrayView<const LayerFrame> layer_frames);
+
+  // Creates, keeps or destroys `worker_pool_` for `num_encoders` encoders.
+  void InitializeWorkerPool(int num_encoders, int number_of_cores);
+
   void OverrideFromFieldTrial(VideoEncoder::EncoderInfo* info) const;
 
   std::atomic<int> inited_;
@@ -177,6 +249,13 @@ class RTC_EXPORT SimulcastEncoderAdapter : public VideoEncoder {
   std::vector<StreamContext> stream_contexts_;
   EncodedImageCallback* encoded_complete_callback_;
 
+  const bool parallel_encoding_enabled_;
+  // Set if the streams are encoded in parallel, in which case the callbacks of
+  // all encoders are intercepted.
+  std::unique_ptr<WorkerPool> worker_pool_;
+  // Set if streams may be scaled from each other.
+  const std::unique_ptr<ScalePyramid> scale_pyramid_;
+
   // Used for checking the single-threaded access of the encoder interface.
   RTC_NO_UNIQUE_ADDRESS SequenceChecker encoder_queue_;
 
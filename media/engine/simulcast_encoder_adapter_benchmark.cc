@@ -0,0 +1,179 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "api/video/i420_buffer.h"
+#include "api/video/video_bitrate_allocation.h"
+#include "api/video/video_frame.h"
+#include "api/video_codecs/sdp_video_format.h"
+#include "api/video_codecs/video_encoder.h"
+#include "api/video_codecs/video_encoder_factory.h"
+#include "benchmark/benchmark.h"
+#include "media/engine/simulcast_encoder_adapter.h"
+#include "modules/video_coding/include/video_codec_interface.h"
+#include "modules/video_coding/include/video_error_codes.h"
+#include "test/field_trial.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kWidth = 1280;
+constexpr int kHeight = 720;
+constexpr int kNumStreams = 3;
+constexpr int kNumCores = 4;
+// Passes over the luma plane per encoded frame, which puts the encode time of
+// the highest stream in the range of a real-time software encoder.
+constexpr int kNumPasses = 4;
+
+// Encoder whose cost grows with the number of pixels, as for a real encoder,
+// and that delivers an empty image for each frame.
+class BusyEncoder : public VideoEncoder {
+ public:
+  void SetFecControllerOverride(
+      FecControllerOverride* fec_controller_override) override {}
+  int32_t InitEncode(const VideoCodec* codec_settings,
+                     const VideoEncoder::Settings& settings) override {
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+  int32_t RegisterEncodeCompleteCallback(
+      EncodedImageCallback* callback) override {
+    callback_ = callback;
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+  int32_t Release() override { return WEBRTC_VIDEO_CODEC_OK; }
+  int32_t Encode(const VideoFrame& frame,
+                 const std::vector<VideoFrameType>* frame_types) override {
+    rtc::scoped_refptr<I420BufferInterface> buffer =
+        frame.video_frame_buffer()->ToI420();
+    uint32_t sum = 0;
+    for (int pass = 0; pass < kNumPasses; ++pass) {
+      for (int y = 0; y < buffer->height(); ++y) {
+        const uint8_t* row = buffer->DataY() + y * buffer->StrideY();
+        for (int x = 0; x < buffer->width(); ++x) {
+          sum += row[x] ^ static_cast<uint8_t>(pass);
+        }
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+
+    EncodedImage image;
+    image._encodedWidth = buffer->width();
+    image._encodedHeight = buffer->height();
+    image.SetTimestamp(frame.timestamp());
+    CodecSpecificInfo codec_specific_info;
+    codec_specific_info.codecType = kVideoCodecVP8;
+    callback_->OnEncodedImage(image, &codec_specific_info);
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+  void SetRates(const RateControlParameters& parameters) override {}
+  EncoderInfo GetEncoderInfo() const override { return EncoderInfo(); }
+
+ private:
+  EncodedImageCallback* callback_ = nullptr;
+};
+
+class BusyEncoderFactory : public VideoEncoderFactory {
+ public:
+  std::vector<SdpVideoFormat> GetSupportedFormats() const override {
+    return {SdpVideoFormat("VP8")};
+  }
+  std::unique_ptr<VideoEncoder> CreateVideoEncoder(
+      const SdpVideoFormat& format) override {
+    return std::make_unique<BusyEncoder>();
+  }
+};
+
+class NullCallback : public EncodedImageCallback {
+ public:
+  Result OnEncodedImage(const EncodedImage& encoded_image,
+                        const CodecSpecificInfo* codec_specific_info) override {
+    return Result(Result::OK, encoded_image.Timestamp());
+  }
+};
+
+VideoCodec CreateCodec() {
+  VideoCodec codec;
+  codec.codecType = kVideoCodecVP8;
+  codec.width = kWidth;
+  codec.height = kHeight;
+  codec.maxFramerate = 30;
+  codec.startBitrate = 3000;
+  codec.maxBitrate = 3000;
+  codec.qpMax = 56;
+  codec.numberOfSimulcastStreams = kNumStreams;
+  for (int i = 0; i < kNumStreams; ++i) {
+    SimulcastStream& stream = codec.simulcastStream[i];
+    const int scale = 1 << (kNumStreams - 1 - i);
+    stream.width = kWidth / scale;
+    stream.height = kHeight / scale;
+    stream.maxFramerate = 30;
+    stream.numberOfTemporalLayers = 1;
+    stream.minBitrate = 100 * (i + 1);
+    stream.targetBitrate = 500 * (i + 1);
+    stream.maxBitrate = 500 * (i + 1);
+    stream.qpMax = 56;
+    stream.active = true;
+  }
+  return codec;
+}
+
+// Encodes 720p frames in three simulcast streams. The argument is whether the
+// streams are encoded in parallel.
+void BM_EncodeSimulcast(benchmark::State& state) {
+  test::ScopedFieldTrials field_trials(
+      state.range(0) != 0
+          ? "WebRTC-SimulcastEncoderAdapter-ParallelEncoding/Enabled/"
+          : "");
+  BusyEncoderFactory factory;
+  SimulcastEncoderAdapter adapter(&factory, SdpVideoFormat("VP8"));
+  const VideoCodec codec = CreateCodec();
+  const VideoEncoder::Capabilities capabilities(/*loss_notification=*/false);
+  adapter.InitEncode(&codec, VideoEncoder::Settings(capabilities, kNumCores,
+                                                    /*max_payload_size=*/1200));
+  NullCallback callback;
+  adapter.RegisterEncodeCompleteCallback(&callback);
+  VideoBitrateAllocation allocation;
+  for (int i = 0; i < kNumStreams; ++i) {
+    allocation.SetBitrate(i, 0, codec.simulcastStream[i].targetBitrate * 1000);
+  }
+  adapter.SetRates(VideoEncoder::RateControlParameters(allocation, 30.0));
+
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(kWidth, kHeight);
+  I420Buffer::SetBlack(buffer.get());
+  const std::vector<VideoFrameType> frame_types(
+      kNumStreams, VideoFrameType::kVideoFrameDelta);
+  uint32_t rtp_timestamp = 0;
+  for (auto _ : state) {
+    VideoFrame frame = VideoFrame::Builder()
+                           .set_video_frame_buffer(buffer)
+                           .set_timestamp_rtp(rtp_timestamp)
+                           .build();
+    // Frame timestamps at 30 fps keep the frame rate controller from dropping
+    // frames.
+    rtp_timestamp += 3000;
+    adapter.Encode(frame, &frame_types);
+  }
+  adapter.Release();
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_EncodeSimulcast)
+    ->Arg(0)
+    ->Arg(1)
+    ->ArgName("parallel")
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace
+}  // namespace webrtc
@@ -29,6 +29,7 @@
 #include "modules/video_coding/include/video_codec_interface.h"
 #include "modules/video_coding/utility/simulcast_test_fixture_impl.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/event.h"
 #include "test/field_trial.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
@@ -49,6 +50,7 @@ constexpr int kDefaultHeight = 720;
 
 const VideoEncoder::Capabilities kCapabilities(false);
 const VideoEncoder::Settings kSettings(kCapabilities, 1, 1200);
+const VideoEncoder::Settings kMultiCoreSettings(kCapabilities, 4, 1200);
 
 std::unique_ptr<SimulcastTestFixture> CreateSpecificSimulcastTestFixture(
     VideoEncoderFactory* internal_encoder_factory) {
@@ -216,6 +218,7 @@ class MockVideoEncoder : public VideoEncoder {
   int32_t InitEncode(const VideoCodec* codecSettings,
                      const VideoEncoder::Settings& settings) override {
     codec_ = *codecSettings;
+    number_of_cores_ = settings.number_of_cores;
     return init_encode_return_value_;
   }
 
@@ -257,6 +260,7 @@ class MockVideoEncoder : public VideoEncoder {
   virtual ~MockVideoEncoder() { factory_->DestroyVideoEncoder(this); }
 
   const VideoCodec& codec() const { return codec_; }
+  int number_of_cores() const { return number_of_cores_; }
 
   void SendEncodedImage(int width, int height) {
     // Sends a fake image of the given width/height.
@@ -345,6 +349,7 @@ class MockVideoEncoder : public VideoEncoder {
   std::vector<VideoEncoder::ResolutionBitrateLimits> resolution_bitrate_limits;
 
   VideoCodec codec_;
+  int number_of_cores_ = 0;
   EncodedImageCallback* callback_;
 };
 
@@ -1777,5 +1782,247 @@ TEST_F(TestSimulcastEncoderAdapterFake,
             adapter_->InitEncode(&codec_, kSettings));
 }
 
+class EncodedImageRecorder : public EncodedImageCallback {
+ public:
+  Result OnEncodedImage(const EncodedImage& encoded_image,
+                        const CodecSpecificInfo* codec_specific_info) override {
+    simulcast_indices_.push_back(encoded_image.SpatialIndex().value_or(-1));
+    return Result(Result::OK, encoded_image.Timestamp());
+  }
+
+  const std::vector<int>& simulcast_indices() const {
+    return simulcast_indices_;
+  }
+
+ private:
+  std::vector<int> simulcast_indices_;
+};
+
+VideoFrame CreateInputFrame() {
+  rtc::scoped_refptr<I420Buffer> input_buffer =
+      I420Buffer::Create(kDefaultWidth, kDefaultHeight);
+  input_buffer->InitializeData();
+  return VideoFrame::Builder()
+      .set_video_frame_buffer(input_buffer)
+      .set_timestamp_rtp(0)
+      .set_timestamp_us(0)
+      .set_rotation(kVideoRotation_0)
+      .build();
+}
+
+TEST_F(TestSimulcastEncoderAdapterFake,
+       ParallelEncodingDeliversEncodedImagesInStreamOrder) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-SimulcastEncoderAdapter-ParallelEncoding/Enabled/");
+  ReSetUp();
+  SimulcastTestFixtureImpl::DefaultSettings(
+      &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
+      kVideoCodecVP8);
+  EXPECT_EQ(0, adapter_->InitEncode(&codec_, kMultiCoreSettings));
+  rate_allocator_.reset(new SimulcastRateAllocator(codec_));
+  adapter_->SetRates(VideoEncoder::RateControlParameters(
+      rate_allocator_->Allocate(VideoBitrateAllocationParameters(3000000, 30)),
+      30.0));
+  EncodedImageRecorder recorder;
+  adapter_->RegisterEncodeCompleteCallback(&recorder);
+  std::vector<MockVideoEncoder*> encoders = helper_->factory()->encoders();
+  ASSERT_EQ(3u, encoders.size());
+
+  // The lowest stream is encoded last, after the highest stream.
+  rtc::Event highest_stream_encoded;
+  EXPECT_CALL(*encoders[0], Encode(_, _))
+      .WillOnce([&](const VideoFrame& frame,
+                    const std::vector<VideoFrameType>* frame_types) {
+        EXPECT_TRUE(highest_stream_encoded.Wait(5000));
+        encoders[0]->SendEncodedImage(frame.width(), frame.height());
+        return WEBRTC_VIDEO_CODEC_OK;
+      });
+  EXPECT_CALL(*encoders[1], Encode(_, _))
+      .WillOnce([&](const VideoFrame& frame,
+                    const std::vector<VideoFrameType>* frame_types) {
+        encoders[1]->SendEncodedImage(frame.width(), frame.height());
+        return WEBRTC_VIDEO_CODEC_OK;
+      });
+  EXPECT_CALL(*encoders[2], Encode(_, _))
+      .WillOnce([&](const VideoFrame& frame,
+                    const std::vector<VideoFrameType>* frame_types) {
+        encoders[2]->SendEncodedImage(frame.width(), frame.height());
+        highest_stream_encoded.Set();
+        return WEBRTC_VIDEO_CODEC_OK;
+      });
+
+  std::vector<VideoFrameType> frame_types(3, VideoFrameType::kVideoFrameKey);
+  EXPECT_EQ(0, adapter_->Encode(CreateInputFrame(), &frame_types));
+  EXPECT_EQ(recorder.simulcast_indices(), std::vector<int>({0, 1, 2}));
+}
+
+TEST_F(TestSimulcastEncoderAdapterFake,
+       ParallelEncodingRequestsKeyFrameOnAllStreams) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-SimulcastEncoderAdapter-ParallelEncoding/Enabled/");
+  ReSetUp();
+  SimulcastTestFixtureImpl::DefaultSettings(
+      &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
+      kVideoCodecVP8);
+  EXPECT_EQ(0, adapter_->InitEncode(&codec_, kMultiCoreSettings));
+  rate_allocator_.reset(new SimulcastRateAllocator(codec_));
+  adapter_->SetRates(VideoEncoder::RateControlParameters(
+      rate_allocator_->Allocate(VideoBitrateAllocationParameters(3000000, 30)),
+      30.0));
+  adapter_->RegisterEncodeCompleteCallback(this);
+  std::vector<MockVideoEncoder*> encoders = helper_->factory()->encoders();
+  ASSERT_EQ(3u, encoders.size());
+
+  const std::vector<VideoFrameType> kKeyFrameTypes = {
+      VideoFrameType::kVideoFrameKey};
+  for (MockVideoEncoder* encoder : encoders) {
+    EXPECT_CALL(*encoder, Encode(_, ::testing::Pointee(kKeyFrameTypes)))
+        .WillOnce(Return(WEBRTC_VIDEO_CODEC_OK));
+  }
+  std::vector<VideoFrameType> frame_types = {VideoFrameType::kVideoFrameDelta,
+                                             VideoFrameType::kVideoFrameKey,
+                                             VideoFrameType::kVideoFrameDelta};
+  EXPECT_EQ(0, adapter_->Encode(CreateInputFrame(), &frame_types));
+}
+
+TEST_F(TestSimulcastEncoderAdapterFake,
+       ParallelEncodingReturnsErrorAfterEncodingAllStreams) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-SimulcastEncoderAdapter-ParallelEncoding/Enabled/");
+  ReSetUp();
+  SimulcastTestFixtureImpl::DefaultSettings(
+      &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
+      kVideoCodecVP8);
+  EXPECT_EQ(0, adapter_->InitEncode(&codec_, kMultiCoreSettings));
+  rate_allocator_.reset(new SimulcastRateAllocator(codec_));
+  adapter_->SetRates(VideoEncoder::RateControlParameters(
+      rate_allocator_->Allocate(VideoBitrateAllocationParameters(3000000, 30)),
+      30.0));
+  adapter_->RegisterEncodeCompleteCallback(this);
+  std::vector<MockVideoEncoder*> encoders = helper_->factory()->encoders();
+  ASSERT_EQ(3u, encoders.size());
+
+  EXPECT_CALL(*encoders[0], Encode(_, _))
+      .WillOnce(Return(WEBRTC_VIDEO_CODEC_OK));
+  EXPECT_CALL(*encoders[1], Encode(_, _))
+      .WillOnce(Return(WEBRTC_VIDEO_CODEC_FALLBACK_SOFTWARE));
+  EXPECT_CALL(*encoders[2], Encode(_, _))
+      .WillOnce(Return(WEBRTC_VIDEO_CODEC_OK));
+  std::vector<VideoFrameType> frame_types(3, VideoFrameType::kVideoFrameKey);
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_FALLBACK_SOFTWARE,
+            adapter_->Encode(CreateInputFrame(), &frame_types));
+}
+
+TEST_F(TestSimulcastEncoderAdapterFake,
+       ParallelEncodingSplitsCoresBetweenEncoders) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-SimulcastEncoderAdapter-ParallelEncoding/Enabled/");
+  ReSetUp();
+  SimulcastTestFixtureImpl::DefaultSettings(
+      &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
+      kVideoCodecVP8);
+  const VideoEncoder::Settings settings(kCapabilities, 6, 1200);
+  EXPECT_EQ(0, adapter_->InitEncode(&codec_, settings));
+  std::vector<MockVideoEncoder*> encoders = helper_->factory()->encoders();
+  ASSERT_EQ(3u, encoders.size());
+  for (MockVideoEncoder* encoder : encoders) {
+    EXPECT_EQ(2, encoder->number_of_cores());
+  }
+}
+
+TEST_F(TestSimulcastEncoderAdapterFake,
+       StreamsNotEncodedAfterFailureDoNotCountFrame) {
+  SimulcastTestFixtureImpl::DefaultSettings(
+      &codec_, static_cast<const int*>(kTestTemporalLayerProfile),
+      kVideoCodecVP8);
+  for (int i = 0; i < 3; ++i) {
+    codec_.simulcastStream[i].maxFramerate = 15;
+  }
+  EXPECT_EQ(0, adapter_->InitEncode(&codec_, kSettings));
+  rate_allocator_.reset(new SimulcastRateAllocator(codec_));
+  adapter_->SetRates(VideoEncoder::RateControlParameters(
+      rate_allocator_->Allocate(VideoBitrateAllocationParameters(3000000, 30)),
+      30.0));
+  adapter_->RegisterEncodeCompleteCallback(this);
+  std::vector<MockVideoEncoder*> encoders = helper_->factory()->encoders();
+  ASSERT_EQ(3u, encoders.size());
+
+  // Frames at 0 ms, 66.7 ms and 90 ms. At 15 fps, the frame at 90 ms is
+  // dropped by the streams that sent the frame at 66.7 ms.
+  auto rtp_timestamp_is = [](uint32_t timestamp) {
+    return ::testing::Property(&VideoFrame::timestamp, timestamp);
+  };
+  for (MockVideoEncoder* encoder : encoders) {
+    EXPECT_CALL(*encoder, Encode(rtp_timestamp_is(0), _))
+        .WillOnce(Return(WEBRTC_VIDEO_CODEC_OK));
+  }
+  EXPECT_CALL(*encoders[0], Encode(rtp_timestamp_is(6000), _))
+      .WillOnce(Return(WEBRTC_VIDEO_CODEC_ERROR));
+  EXPECT_CALL(*encoders[0], Encode(rtp_timestamp_is(8100), _)).Times(0);
+  for (int i = 1; i < 3; ++i) {
+    EXPECT_CALL(*encoders[i], Encode(rtp_timestamp_is(6000), _)).Times(0);
+    EXPECT_CALL(*encoders[i], Encode(rtp_timestamp_is(8100), _))
+        .WillOnce(Return(WEBRTC_VIDEO_CODEC_OK));
+  }
+
+  VideoFrame input_frame = CreateInputFrame();
+  std::vector<VideoFrameType> frame_types(3, VideoFrameType::kVideoFrameKey);
+  EXPECT_EQ(0, adapter_->Encode(input_frame, &frame_types));
+  std::fill(frame_types.begin(), frame_types.end(),
+            VideoFrameType::kVideoFrameDelta);
+  input_frame.set_timestamp(6000);
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_ERROR,
+            adapter_->Encode(input_frame, &frame_types));
+  input_frame.set_timestamp(8100);
+  EXPECT_EQ(0, adapter_->Encode(input_frame, &frame_types));
+}
+
+TEST_F(TestSimulcastEncoderAdapterFake, ReportsEncodeTimePercentiles) {
+  SetupCodec();
+  adapter_->SetRates(VideoEncoder::RateControlParameters(
+      rate_allocator_->Allocate(VideoBitrateAllocationParameters(3000000, 30)),
+      30.0));
+  SimulcastEncoderAdapter* adapter =
+      static_cast<SimulcastEncoderAdapter*>(adapter_.get());
+  EXPECT_FALSE(adapter->GetEncodeTimePercentile(0, 0.5f));
+
+  std::vector<VideoFrameType> frame_types(3, VideoFrameType::kVideoFrameKey);
+  EXPECT_EQ(0, adapter_->Encode(CreateInputFrame(), &frame_types));
+  for (int stream_idx = 0; stream_idx < 3; ++stream_idx) {
+    absl::optional<TimeDelta> encode_time =
+        adapter->GetEncodeTimePercentile(stream_idx, 0.95f);
+    ASSERT_TRUE(encode_time);
+    EXPECT_GE(*encode_time, TimeDelta::Zero());
+  }
+  EXPECT_FALSE(adapter->GetEncodeTimePercentile(3, 0.5f));
+}
+
+TEST_F(TestSimulcastEncoderAdapterFake,
+       ScalePyramidScalesEachStreamToItsResolution) {
+  test::ScopedFieldTrials field_trials(
+      "WebRTC-SimulcastEncoderAdapter-ScalePyramid/Enabled/");
+  ReSetUp();
+  SetupCodec();
+  adapter_->SetRates(VideoEncoder::RateControlParameters(
+      rate_allocator_->Allocate(VideoBitrateAllocationParameters(3000000, 30)),
+      30.0));
+  std::vector<MockVideoEncoder*> encoders = helper_->factory()->encoders();
+  ASSERT_EQ(3u, encoders.size());
+
+  for (int i = 0; i < 3; ++i) {
+    const int width = codec_.simulcastStream[i].width;
+    const int height = codec_.simulcastStream[i].height;
+    EXPECT_CALL(*encoders[i], Encode(_, _))
+        .WillOnce([=](const VideoFrame& frame,
+                      const std::vector<VideoFrameType>* frame_types) {
+          EXPECT_EQ(frame.width(), width);
+          EXPECT_EQ(frame.height(), height);
+          return WEBRTC_VIDEO_CODEC_OK;
+        });
+  }
+  std::vector<VideoFrameType> frame_types(3, VideoFrameType::kVideoFrameKey);
+  EXPECT_EQ(0, adapter_->Encode(CreateInputFrame(), &frame_types));
+}
+
 }  // namespace test
 }  // namespace webrtc
@@ -210,6 +210,18 @@ int AcmReceiver::GetAudio(int desired_freq_hz,
   return 0;
 }
 
+int AcmReceiver::SkipAudio() {
+  if (neteq_->SkipAudio() != NetEq::kOK) {
+    RTC_LOG(LS_ERROR) << "AcmReceiver::SkipAudio - NetEq Failed.";
+    return -1;
+  }
+  // The resampler hasn't seen the skipped audio, so it is primed again with
+  // `last_audio_buffer_` when resampling is needed next time.
+  MutexLock lock(&mutex_);
+  resampled_last_output_frame_ = false;
+  return 0;
+}
+
 void AcmReceiver::SetCodecs(const std::map<int, SdpAudioFormat>& codecs) {
   neteq_->SetCodecs(codecs);
 }
@@ -81,6 +81,15 @@ class AcmReceiver {
   //
   int GetAudio(int desired_freq_hz, AudioFrame* audio_frame, bool* muted);
 
+  //
+  // Advances NetEq by 10 milliseconds without decoding any audio, see
+  // NetEq::SkipAudio().
+  //
+  // Return value             : 0 if OK.
+  //                           -1 if NetEq returned an error.
+  //
+  int SkipAudio();
+
   // Replace the current set of decoders with the specified set.
   void SetCodecs(const std::map<int, SdpAudioFormat>& codecs);
 
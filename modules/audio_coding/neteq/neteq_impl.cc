@@ -228,6 +228,23 @@ void SetAudioFrameActivityAndType(bool vad_enabled,
     audio_frame->vad_activity_ = AudioFrame::kVadUnknown;
   }
 }
+
+// Writes silence of the duration of `frame` to `decoded`, instead of decoding
+// it. Frames of unknown duration and DTX frames, which the decoder turns into
+// comfort noise, are decoded as usual.
+absl::optional<AudioDecoder::EncodedAudioFrame::DecodeResult> DecodeAsSilence(
+    const AudioDecoder::EncodedAudioFrame& frame,
+    size_t num_channels,
+    rtc::ArrayView<int16_t> decoded) {
+  const size_t num_samples = frame.Duration() * num_channels;
+  if (num_samples == 0 || num_samples > decoded.size() ||
+      frame.IsDtxPacket()) {
+    return frame.Decode(decoded);
+  }
+  std::fill(decoded.begin(), decoded.begin() + num_samples, 0);
+  return AudioDecoder::EncodedAudioFrame::DecodeResult{num_samples,
+                                                       AudioDecoder::kSpeech};
+}
 }  // namespace
 
 int NetEqImpl::GetAudio(AudioFrame* audio_frame,
@@ -236,6 +253,27 @@ int NetEqImpl::GetAudio(AudioFrame* audio_frame,
                         absl::optional<Operation> action_override) {
   TRACE_EVENT0("webrtc", "NetEqImpl::GetAudio");
   MutexLock lock(&mutex_);
+  return GetAudioLocked(audio_frame, muted, current_sample_rate_hz,
+                        action_override);
+}
+
+int NetEqImpl::SkipAudio() {
+  TRACE_EVENT0("webrtc", "NetEqImpl::SkipAudio");
+  AudioFrame audio_frame;
+  bool muted;
+  MutexLock lock(&mutex_);
+  skip_decoding_ = true;
+  int result = GetAudioLocked(&audio_frame, &muted,
+                              /*current_sample_rate_hz=*/nullptr,
+                              /*action_override=*/absl::nullopt);
+  skip_decoding_ = false;
+  return result;
+}
+
+int NetEqImpl::GetAudioLocked(AudioFrame* audio_frame,
+                              bool* muted,
+                              int* current_sample_rate_hz,
+                              absl::optional<Operation> action_override) {
   if (GetAudioInternal(audio_frame, muted, action_override) != 0) {
     return kFail;
   }
@@ -825,8 +863,12 @@ int NetEqImpl::GetAudioInternal(AudioFrame* audio_frame,
   RTC_DCHECK(vad_.get());
   bool sid_frame_available =
       (operation == Operation::kRfc3389Cng && !packet_list.empty());
-  vad_->Update(decoded_buffer_.get(), static_cast<size_t>(length), speech_type,
-               sid_frame_available, fs_hz_);
+  // The silence written in place of skipped packets says nothing about the
+  // signal, so neither the VAD nor the background noise is updated with it.
+  if (!skip_decoding_) {
+    vad_->Update(decoded_buffer_.get(), static_cast<size_t>(length),
+                 speech_type, sid_frame_available, fs_hz_);
+  }
 
   // This is the criterion that we did decode some data through the speech
   // decoder, and the operation resulted in comfort noise.
@@ -972,10 +1014,11 @@ int NetEqImpl::GetAudioInternal(AudioFrame* audio_frame,
   // Update the background noise parameters if last operation wrote data
   // straight from the decoder to the `sync_buffer_`. That is, none of the
   // operations that modify the signal can be followed by a parameter update.
-  if ((last_mode_ == Mode::kNormal) || (last_mode_ == Mode::kAccelerateFail) ||
-      (last_mode_ == Mode::kPreemptiveExpandFail) ||
-      (last_mode_ == Mode::kRfc3389Cng) ||
-      (last_mode_ == Mode::kCodecInternalCng)) {
+  if (!skip_decoding_ &&
+      ((last_mode_ == Mode::kNormal) || (last_mode_ == Mode::kAccelerateFail) ||
+       (last_mode_ == Mode::kPreemptiveExpandFail) ||
+       (last_mode_ == Mode::kRfc3389Cng) ||
+       (last_mode_ == Mode::kCodecInternalCng))) {
     background_noise_->Update(*sync_buffer_, *vad_.get());
   }
 
@@ -1474,9 +1517,12 @@ int NetEqImpl::DecodeLoop(PacketList* packet_list,
                operation == Operation::kMerge ||
                operation == Operation::kPreemptiveExpand);
 
-    auto opt_result = packet_list->front().frame->Decode(
-        rtc::ArrayView<int16_t>(&decoded_buffer_[*decoded_length],
-                                decoded_buffer_length_ - *decoded_length));
+    const AudioDecoder::EncodedAudioFrame& frame = *packet_list->front().frame;
+    rtc::ArrayView<int16_t> decoded(&decoded_buffer_[*decoded_length],
+                                    decoded_buffer_length_ - *decoded_length);
+    auto opt_result = skip_decoding_
+                          ? DecodeAsSilence(frame, decoder->Channels(), decoded)
+                          : frame.Decode(decoded);
     last_decoded_packet_infos_.push_back(
         std::move(packet_list->front().packet_info));
     packet_list->pop_front();
@@ -138,6 +138,8 @@ class NetEqImpl : public webrtc::NetEq {
       int* current_sample_rate_hz = nullptr,
       absl::optional<Operation> action_override = absl::nullopt) override;
 
+  int SkipAudio() override;
+
   void SetCodecs(const std::map<int, SdpAudioFormat>& codecs) override;
 
   bool RegisterPayloadType(int rtp_payload_type,
@@ -215,6 +217,13 @@ class NetEqImpl : public webrtc::NetEq {
                            rtc::ArrayView<const uint8_t> payload)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
+  // Implements GetAudio(), with `mutex_` held.
+  int GetAudioLocked(AudioFrame* audio_frame,
+                     bool* muted,
+                     int* current_sample_rate_hz,
+                     absl::optional<Operation> action_override)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
   // Delivers 10 ms of audio data. The data is written to `audio_frame`.
   // Returns 0 on success, otherwise an error code.
   int GetAudioInternal(AudioFrame* audio_frame,
@@ -252,7 +261,8 @@ class NetEqImpl : public webrtc::NetEq {
                 AudioDecoder::SpeechType* speech_type)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
-  // Sub-method to Decode(). Performs the actual decoding.
+  // Sub-method to Decode(). Performs the actual decoding, or writes silence
+  // in place of the decoded audio if `skip_decoding_` is set.
   int DecodeLoop(PacketList* packet_list,
                  const Operation& operation,
                  AudioDecoder* decoder,
@@ -382,6 +392,8 @@ class NetEqImpl : public webrtc::NetEq {
   bool new_codec_ RTC_GUARDED_BY(mutex_);
   uint32_t timestamp_ RTC_GUARDED_BY(mutex_);
   bool reset_decoder_ RTC_GUARDED_BY(mutex_);
+  // Set while SkipAudio() runs.
+  bool skip_decoding_ RTC_GUARDED_BY(mutex_) = false;
   absl::optional<uint8_t> current_rtp_payload_type_ RTC_GUARDED_BY(mutex_);
   absl::optional<uint8_t> current_cng_rtp_payload_type_ RTC_GUARDED_BY(mutex_);
   bool first_packet_ RTC_GUARDED_BY(mutex_);
@@ -0,0 +1,138 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/neteq_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace {
+
+// NetEq outputs at most 48 kHz, i.e. 480 samples per channel in 10 ms.
+constexpr size_t kMaxSamplesPerChannel = 480;
+
+}  // namespace
+
+NetEqPool::NetEqPool(const Config& config,
+                     rtc::scoped_refptr<AudioDecoderFactory> decoder_factory,
+                     Clock* clock,
+                     TaskQueueFactory* task_queue_factory)
+    : neteq_config_(config.neteq_config),
+      max_num_channels_(config.max_num_channels),
+      stride_(kMaxSamplesPerChannel * config.max_num_channels),
+      decoder_factory_(std::move(decoder_factory)),
+      clock_(clock) {
+  RTC_DCHECK_GE(config.num_threads, 1);
+  RTC_DCHECK_LE(stride_, AudioFrame::kMaxDataSizeSamples);
+  RTC_DCHECK(config.num_threads == 1 || task_queue_factory != nullptr);
+  for (int i = 0; i < config.num_threads; ++i) {
+    auto worker = std::make_unique<Worker>();
+    if (i > 0) {
+      worker->task_queue = task_queue_factory->CreateTaskQueue(
+          "NetEqPoolWorker", TaskQueueFactory::Priority::HIGH);
+    }
+    workers_.push_back(std::move(worker));
+  }
+}
+
+NetEqPool::~NetEqPool() {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+}
+
+size_t NetEqPool::AddStream() {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  streams_.push_back(
+      neteq_factory_.CreateNetEq(neteq_config_, decoder_factory_, clock_));
+  return streams_.size() - 1;
+}
+
+void NetEqPool::RemoveStream(size_t index) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  RTC_DCHECK_LT(index, streams_.size());
+  streams_[index] = std::move(streams_.back());
+  streams_.pop_back();
+}
+
+int NetEqPool::GetAudioBatch(NetEqAudioBatch* batch) {
+  RTC_DCHECK_RUN_ON(&sequence_checker_);
+  const size_t num_streams = streams_.size();
+  batch->stride = stride_;
+  batch->data.resize(num_streams * stride_);
+  batch->samples_per_channel.resize(num_streams);
+  batch->num_channels.resize(num_streams);
+  batch->sample_rate_hz.resize(num_streams);
+  batch->speech_type.resize(num_streams);
+  batch->vad_activity.resize(num_streams);
+  batch->muted.resize(num_streams);
+
+  // Every worker must have at least one stream to process.
+  const size_t num_shards =
+      std::max<size_t>(std::min(workers_.size(), num_streams), 1);
+  if (num_shards > 1) {
+    pending_shards_.store(num_shards - 1);
+    for (size_t shard = 1; shard < num_shards; ++shard) {
+      workers_[shard]->task_queue->PostTask([this, shard, num_shards, batch] {
+        workers_[shard]->num_failed = RunShard(shard, num_shards, *batch);
+        if (pending_shards_.fetch_sub(1) == 1) {
+          shards_done_.Set();
+        }
+      });
+    }
+  }
+
+  int num_failed = RunShard(0, num_shards, *batch);
+
+  if (num_shards > 1) {
+    shards_done_.Wait(rtc::Event::kForever);
+    for (size_t shard = 1; shard < num_shards; ++shard) {
+      num_failed += workers_[shard]->num_failed;
+    }
+  }
+  return num_failed;
+}
+
+int NetEqPool::RunShard(size_t shard,
+                        size_t num_shards,
+                        NetEqAudioBatch& batch) {
+  const size_t begin = shard * streams_.size() / num_shards;
+  const size_t end = (shard + 1) * streams_.size() / num_shards;
+  AudioFrame& frame = workers_[shard]->frame;
+  int num_failed = 0;
+  for (size_t i = begin; i < end; ++i) {
+    bool muted = false;
+    if (streams_[i]->GetAudio(&frame, &muted) != NetEq::kOK ||
+        frame.num_channels_ > max_num_channels_) {
+      batch.samples_per_channel[i] = 0;
+      batch.num_channels[i] = 0;
+      ++num_failed;
+      continue;
+    }
+    RTC_DCHECK_LE(frame.samples_per_channel_, kMaxSamplesPerChannel);
+    const size_t num_samples = frame.samples_per_channel_ * frame.num_channels_;
+    int16_t* destination = &batch.data[i * stride_];
+    if (muted) {
+      std::fill(destination, destination + num_samples, 0);
+    } else {
+      std::copy(frame.data(), frame.data() + num_samples, destination);
+    }
+    batch.samples_per_channel[i] = frame.samples_per_channel_;
+    batch.num_channels[i] = frame.num_channels_;
+    batch.sample_rate_hz[i] = frame.sample_rate_hz_;
+    batch.speech_type[i] = frame.speech_type_;
+    batch.vad_activity[i] = frame.vad_activity_;
+    batch.muted[i] = muted;
+  }
+  return num_failed;
+}
+
+}  // namespace webrtc
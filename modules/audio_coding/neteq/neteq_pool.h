@@ -0,0 +1,145 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_NETEQ_NETEQ_POOL_H_
+#define MODULES_AUDIO_CODING_NETEQ_NETEQ_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "api/array_view.h"
+#include "api/audio/audio_frame.h"
+#include "api/audio_codecs/audio_decoder_factory.h"
+#include "api/neteq/neteq.h"
+#include "api/scoped_refptr.h"
+#include "api/sequence_checker.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "modules/audio_coding/neteq/default_neteq_factory.h"
+#include "rtc_base/event.h"
+#include "rtc_base/system/no_unique_address.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+// 10 ms of audio from every stream of a `NetEqPool`. The audio of all streams
+// is stored in one contiguous buffer, where each stream has a slot of
+// `stride` samples, and the properties of the streams are stored in arrays
+// indexed by stream.
+struct NetEqAudioBatch {
+  size_t num_streams() const { return samples_per_channel.size(); }
+
+  // Returns the (interleaved) audio of `stream`.
+  rtc::ArrayView<const int16_t> audio(size_t stream) const {
+    return rtc::ArrayView<const int16_t>(
+        &data[stream * stride],
+        samples_per_channel[stream] * num_channels[stream]);
+  }
+
+  size_t stride = 0;
+  std::vector<int16_t> data;
+  // The properties of each stream's audio, as in `AudioFrame`. Streams for
+  // which NetEq failed have no samples.
+  std::vector<size_t> samples_per_channel;
+  std::vector<size_t> num_channels;
+  std::vector<int> sample_rate_hz;
+  std::vector<AudioFrame::SpeechType> speech_type;
+  std::vector<AudioFrame::VADActivity> vad_activity;
+  // Non-zero if the stream is in muted state, in which case its audio is all
+  // zeros. This isn't a std::vector<bool>, as the streams are written to from
+  // several threads.
+  std::vector<uint8_t> muted;
+};
+
+// A pool of NetEq instances, one per incoming audio stream, from which 10 ms
+// of audio is pulled for all streams with a single call to `GetAudioBatch()`.
+// This is intended for servers that mix or forward a large number of streams.
+//
+// The streams can be split across several threads, where each thread
+// processes a contiguous range of streams with a scratch `AudioFrame` of its
+// own, and writes the result into the shared `NetEqAudioBatch`.
+//
+// Streams are identified by their index, in [0, num_streams()). Packets may be
+// inserted into a stream's NetEq from any thread, but the streams must only be
+// added, removed and pulled on the same sequence.
+class NetEqPool {
+ public:
+  struct Config {
+    // The configuration of every stream's NetEq.
+    NetEq::Config neteq_config;
+    // The maximum number of channels of a stream. A stream whose output has
+    // more channels fails in `GetAudioBatch()`.
+    size_t max_num_channels = 2;
+    // The number of threads that `GetAudioBatch()` splits the streams across,
+    // including the calling thread. If larger than one, a task queue factory
+    // must be provided, from which the worker threads are created.
+    int num_threads = 1;
+  };
+
+  NetEqPool(const Config& config,
+            rtc::scoped_refptr<AudioDecoderFactory> decoder_factory,
+            Clock* clock,
+            TaskQueueFactory* task_queue_factory = nullptr);
+  ~NetEqPool();
+
+  NetEqPool(const NetEqPool&) = delete;
+  NetEqPool& operator=(const NetEqPool&) = delete;
+
+  // Adds a stream, and returns its index.
+  size_t AddStream();
+
+  // Removes the stream at `index`. The last stream is moved to `index`.
+  void RemoveStream(size_t index);
+
+  size_t num_streams() const { return streams_.size(); }
+
+  // Returns the NetEq of the stream at `index`, which is used to register
+  // payload types and to insert packets.
+  NetEq* stream(size_t index) { return streams_[index].get(); }
+
+  // Pulls 10 ms of audio from every stream into `batch`, which is resized to
+  // the number of streams. Reusing `batch` avoids reallocating its buffers.
+  // Returns the number of streams for which NetEq failed.
+  int GetAudioBatch(NetEqAudioBatch* batch);
+
+ private:
+  struct Worker {
+    // Not set for the first worker, which runs on the calling thread.
+    std::unique_ptr<TaskQueueBase, TaskQueueDeleter> task_queue;
+    AudioFrame frame;
+    int num_failed = 0;
+  };
+
+  // Pulls audio from the streams in the shard `shard` of `num_shards` into
+  // `batch`, and returns the number of streams for which NetEq failed.
+  int RunShard(size_t shard, size_t num_shards, NetEqAudioBatch& batch);
+
+  RTC_NO_UNIQUE_ADDRESS SequenceChecker sequence_checker_;
+  const NetEq::Config neteq_config_;
+  const size_t max_num_channels_;
+  const size_t stride_;
+  const rtc::scoped_refptr<AudioDecoderFactory> decoder_factory_;
+  Clock* const clock_;
+  const DefaultNetEqFactory neteq_factory_;
+  std::vector<std::unique_ptr<NetEq>> streams_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  // The number of shards that are being processed on the worker threads, and
+  // the event that is signaled when the last of them is done.
+  std::atomic<int> pending_shards_{0};
+  rtc::Event shards_done_;
+};
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_NETEQ_NETEQ_POOL_H_
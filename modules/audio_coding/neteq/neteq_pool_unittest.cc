@@ -0,0 +1,238 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/neteq_pool.h"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "api/audio/audio_frame.h"
+#include "api/audio_codecs/L16/audio_decoder_L16.h"
+#include "api/audio_codecs/audio_decoder_factory_template.h"
+#include "api/neteq/neteq.h"
+#include "api/task_queue/default_task_queue_factory.h"
+#include "modules/audio_coding/codecs/pcm16b/pcm16b.h"
+#include "modules/audio_coding/neteq/default_neteq_factory.h"
+#include "system_wrappers/include/clock.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAreArray;
+
+constexpr int kSampleRateHz = 16000;
+constexpr int kPayloadType = 96;
+constexpr size_t kSamplesPer10Ms = kSampleRateHz / 100;
+
+rtc::scoped_refptr<AudioDecoderFactory> CreateL16DecoderFactory() {
+  return CreateAudioDecoderFactory<AudioDecoderL16>();
+}
+
+// Generates 10 ms L16 packets of a sine wave, which is different for every
+// stream.
+class PacketGenerator {
+ public:
+  PacketGenerator(int stream, size_t num_channels)
+      : frequency_hz_(200 + 100 * stream), num_channels_(num_channels) {
+    header_.payloadType = kPayloadType;
+    header_.ssrc = stream;
+  }
+
+  const RTPHeader& header() const { return header_; }
+
+  // Returns the payload of the next packet, which is sent with `header()`.
+  std::vector<uint8_t> NextPacket() {
+    ++header_.sequenceNumber;
+    header_.timestamp += kSamplesPer10Ms;
+    std::vector<int16_t> samples(kSamplesPer10Ms * num_channels_);
+    for (size_t i = 0; i < kSamplesPer10Ms; ++i) {
+      int16_t value = static_cast<int16_t>(
+          10000 * std::sin(2 * M_PI * frequency_hz_ * (time_ + i) /
+                           kSampleRateHz));
+      for (size_t channel = 0; channel < num_channels_; ++channel) {
+        samples[i * num_channels_ + channel] = value;
+      }
+    }
+    time_ += kSamplesPer10Ms;
+    std::vector<uint8_t> payload(samples.size() * 2);
+    WebRtcPcm16b_Encode(samples.data(), samples.size(), payload.data());
+    return payload;
+  }
+
+ private:
+  const int frequency_hz_;
+  const size_t num_channels_;
+  RTPHeader header_;
+  size_t time_ = 0;
+};
+
+NetEqPool::Config PoolConfig(int num_threads) {
+  NetEqPool::Config config;
+  config.neteq_config.sample_rate_hz = kSampleRateHz;
+  config.num_threads = num_threads;
+  return config;
+}
+
+void AddL16Streams(NetEqPool& pool, int num_streams, size_t num_channels) {
+  for (int i = 0; i < num_streams; ++i) {
+    size_t index = pool.AddStream();
+    ASSERT_TRUE(pool.stream(index)->RegisterPayloadType(
+        kPayloadType, SdpAudioFormat("l16", kSampleRateHz, num_channels)));
+  }
+}
+
+TEST(NetEqPoolTest, OutputMatchesSeparateNetEqs) {
+  constexpr int kNumStreams = 3;
+  SimulatedClock clock(0);
+  NetEqPool pool(PoolConfig(/*num_threads=*/1), CreateL16DecoderFactory(),
+                 &clock);
+  AddL16Streams(pool, kNumStreams, /*num_channels=*/1);
+
+  NetEq::Config config;
+  config.sample_rate_hz = kSampleRateHz;
+  DefaultNetEqFactory factory;
+  std::vector<std::unique_ptr<NetEq>> neteqs;
+  std::vector<PacketGenerator> generators;
+  for (int i = 0; i < kNumStreams; ++i) {
+    neteqs.push_back(
+        factory.CreateNetEq(config, CreateL16DecoderFactory(), &clock));
+    ASSERT_TRUE(neteqs[i]->RegisterPayloadType(
+        kPayloadType, SdpAudioFormat("l16", kSampleRateHz, 1)));
+    generators.emplace_back(i, 1);
+  }
+
+  NetEqAudioBatch batch;
+  AudioFrame frame;
+  for (int time_ms = 0; time_ms < 500; time_ms += 10) {
+    for (int i = 0; i < kNumStreams; ++i) {
+      std::vector<uint8_t> payload = generators[i].NextPacket();
+      ASSERT_EQ(NetEq::kOK,
+                pool.stream(i)->InsertPacket(generators[i].header(), payload));
+      ASSERT_EQ(NetEq::kOK,
+                neteqs[i]->InsertPacket(generators[i].header(), payload));
+    }
+    ASSERT_EQ(0, pool.GetAudioBatch(&batch));
+    ASSERT_EQ(batch.num_streams(), static_cast<size_t>(kNumStreams));
+    for (int i = 0; i < kNumStreams; ++i) {
+      bool muted = false;
+      ASSERT_EQ(NetEq::kOK, neteqs[i]->GetAudio(&frame, &muted));
+      EXPECT_EQ(batch.samples_per_channel[i], frame.samples_per_channel_);
+      EXPECT_EQ(batch.num_channels[i], frame.num_channels_);
+      EXPECT_EQ(batch.sample_rate_hz[i], frame.sample_rate_hz_);
+      EXPECT_EQ(batch.speech_type[i], frame.speech_type_);
+      EXPECT_EQ(batch.vad_activity[i], frame.vad_activity_);
+      EXPECT_EQ(batch.muted[i] != 0, muted);
+      EXPECT_THAT(batch.audio(i),
+                  ElementsAreArray(frame.data(), frame.samples_per_channel_ *
+                                                     frame.num_channels_));
+    }
+    clock.AdvanceTimeMilliseconds(10);
+  }
+}
+
+TEST(NetEqPoolTest, MultipleThreadsMatchSingleThread) {
+  // Not a multiple of the number of threads, so that the shards differ in
+  // size.
+  constexpr int kNumStreams = 7;
+  SimulatedClock clock(0);
+  std::unique_ptr<TaskQueueFactory> task_queue_factory =
+      CreateDefaultTaskQueueFactory();
+  NetEqPool single_threaded(PoolConfig(/*num_threads=*/1),
+                            CreateL16DecoderFactory(), &clock);
+  NetEqPool multi_threaded(PoolConfig(/*num_threads=*/3),
+                           CreateL16DecoderFactory(), &clock,
+                           task_queue_factory.get());
+  AddL16Streams(single_threaded, kNumStreams, /*num_channels=*/1);
+  AddL16Streams(multi_threaded, kNumStreams, /*num_channels=*/1);
+  std::vector<PacketGenerator> generators;
+  for (int i = 0; i < kNumStreams; ++i) {
+    generators.emplace_back(i, 1);
+  }
+
+  NetEqAudioBatch expected;
+  NetEqAudioBatch actual;
+  for (int time_ms = 0; time_ms < 500; time_ms += 10) {
+    for (int i = 0; i < kNumStreams; ++i) {
+      std::vector<uint8_t> payload = generators[i].NextPacket();
+      ASSERT_EQ(NetEq::kOK, single_threaded.stream(i)->InsertPacket(
+                                generators[i].header(), payload));
+      ASSERT_EQ(NetEq::kOK, multi_threaded.stream(i)->InsertPacket(
+                                generators[i].header(), payload));
+    }
+    ASSERT_EQ(0, single_threaded.GetAudioBatch(&expected));
+    ASSERT_EQ(0, multi_threaded.GetAudioBatch(&actual));
+    ASSERT_EQ(actual.num_streams(), static_cast<size_t>(kNumStreams));
+    EXPECT_EQ(actual.samples_per_channel, expected.samples_per_channel);
+    EXPECT_EQ(actual.num_channels, expected.num_channels);
+    EXPECT_EQ(actual.speech_type, expected.speech_type);
+    EXPECT_EQ(actual.muted, expected.muted);
+    for (int i = 0; i < kNumStreams; ++i) {
+      EXPECT_THAT(actual.audio(i), ElementsAreArray(expected.audio(i)));
+    }
+    clock.AdvanceTimeMilliseconds(10);
+  }
+}
+
+TEST(NetEqPoolTest, RemoveStreamMovesLastStream) {
+  SimulatedClock clock(0);
+  NetEqPool pool(PoolConfig(/*num_threads=*/1), CreateL16DecoderFactory(),
+                 &clock);
+  AddL16Streams(pool, 3, /*num_channels=*/1);
+  NetEq* last = pool.stream(2);
+  NetEq* second = pool.stream(1);
+
+  pool.RemoveStream(0);
+  ASSERT_EQ(pool.num_streams(), 2u);
+  EXPECT_EQ(pool.stream(0), last);
+  EXPECT_EQ(pool.stream(1), second);
+
+  pool.RemoveStream(1);
+  ASSERT_EQ(pool.num_streams(), 1u);
+  EXPECT_EQ(pool.stream(0), last);
+
+  NetEqAudioBatch batch;
+  EXPECT_EQ(0, pool.GetAudioBatch(&batch));
+  EXPECT_EQ(batch.num_streams(), 1u);
+}
+
+TEST(NetEqPoolTest, StreamWithTooManyChannelsFails) {
+  SimulatedClock clock(0);
+  NetEqPool::Config config = PoolConfig(/*num_threads=*/1);
+  config.max_num_channels = 1;
+  NetEqPool pool(config, CreateL16DecoderFactory(), &clock);
+  AddL16Streams(pool, 1, /*num_channels=*/1);
+  AddL16Streams(pool, 1, /*num_channels=*/2);
+  PacketGenerator mono(0, 1);
+  PacketGenerator stereo(1, 2);
+
+  NetEqAudioBatch batch;
+  int num_failed = 0;
+  for (int time_ms = 0; time_ms < 200; time_ms += 10) {
+    ASSERT_EQ(NetEq::kOK,
+              pool.stream(0)->InsertPacket(mono.header(), mono.NextPacket()));
+    ASSERT_EQ(NetEq::kOK, pool.stream(1)->InsertPacket(stereo.header(),
+                                                       stereo.NextPacket()));
+    num_failed += pool.GetAudioBatch(&batch);
+    EXPECT_EQ(batch.num_channels[0], 1u);
+    EXPECT_EQ(batch.samples_per_channel[0], kSamplesPer10Ms);
+    clock.AdvanceTimeMilliseconds(10);
+  }
+  // Once the stereo stream starts decoding, it fails in every call.
+  EXPECT_GT(num_failed, 0);
+  EXPECT_EQ(batch.num_channels[1], 0u);
+  EXPECT_EQ(batch.samples_per_channel[1], 0u);
+  EXPECT_TRUE(batch.audio(1).empty());
+}
+
+}  // namespace
+}  // namespace webrtc
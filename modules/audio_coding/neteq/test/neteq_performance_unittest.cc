@@ -8,6 +8,8 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <string>
+
 #include "modules/audio_coding/neteq/tools/neteq_performance_test.h"
 #include "system_wrappers/include/field_trial.h"
 #include "test/gtest.h"
@@ -47,3 +49,25 @@ TEST(NetEqPerformanceTest, 0_Pl_0_Drift) {
   webrtc::test::PrintResult("neteq_performance", "", "0_pl_0_drift", runtime,
                             "ms", true);
 }
+
+// Runs 1000 Opus streams in a NetEqPool, on one thread and split across four
+// threads, and reports how many streams one core can handle in real time.
+TEST(NetEqPerformanceTest, StreamsPerCore_1000_Opus_Streams) {
+  const int kSimulationTimeMs = 10000;
+  const int kQuickSimulationTimeMs = 500;
+  const int kNumStreams = 1000;
+  const int runtime_ms = webrtc::field_trial::IsEnabled("WebRTC-QuickPerfTest")
+                             ? kQuickSimulationTimeMs
+                             : kSimulationTimeMs;
+  for (int num_threads : {1, 4}) {
+    double streams_per_core =
+        webrtc::test::NetEqPerformanceTest::RunStreamsPerCore(
+            runtime_ms, kNumStreams, num_threads);
+    ASSERT_GT(streams_per_core, 0);
+    webrtc::test::PrintResult(
+        "neteq_performance", "",
+        "streams_per_core_1000_opus_" + std::to_string(num_threads) +
+            "_threads",
+        streams_per_core, "streams", true);
+  }
+}
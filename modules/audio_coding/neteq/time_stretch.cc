@@ -11,6 +11,7 @@
 #include "modules/audio_coding/neteq/time_stretch.h"
 
 #include <algorithm>  // min, max
+#include <iterator>
 #include <memory>
 
 #include "common_audio/signal_processing/include/signal_processing_library.h"
@@ -53,11 +54,17 @@ TimeStretch::ReturnCodes TimeStretch::Process(const int16_t* input,
   // Find maximum absolute value of input signal.
   max_input_value_ = WebRtcSpl_MaxAbsValueW16(signal, signal_len);
 
-  // Downsample to 4 kHz sample rate and calculate auto-correlation.
-  DspHelper::DownsampleTo4kHz(signal, signal_len, kDownsampledLen,
-                              sample_rate_hz_, true /* compensate delay*/,
-                              downsampled_input_);
-  AutoCorrelation();
+  if (max_input_value_ == 0) {
+    // The auto-correlation of silence is all zeros, e.g. when NetEq is
+    // skipping the decoding of a stream.
+    std::fill(std::begin(auto_correlation_), std::end(auto_correlation_), 0);
+  } else {
+    // Downsample to 4 kHz sample rate and calculate auto-correlation.
+    DspHelper::DownsampleTo4kHz(signal, signal_len, kDownsampledLen,
+                                sample_rate_hz_, true /* compensate delay*/,
+                                downsampled_input_);
+    AutoCorrelation();
+  }
 
   // Find the strongest correlation peak.
   static const size_t kNumPeaks = 1;
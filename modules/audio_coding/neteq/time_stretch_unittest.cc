@@ -55,6 +55,22 @@ TEST(TimeStretch, CreateUsingFactory) {
   delete preemptive_expand;
 }
 
+TEST(TimeStretch, AccelerateSilence) {
+  const int kSampleRate = 8000;
+  const size_t kBlockSize = 30 * kSampleRate / 1000;
+  BackgroundNoise bgn(kNumChannels);
+  Accelerate accelerate(kSampleRate, kNumChannels, bgn);
+  const int16_t silence[kBlockSize] = {0};
+  AudioMultiVector output(kNumChannels);
+  size_t length_change = 0;
+  EXPECT_EQ(TimeStretch::kSuccessLowEnergy,
+            accelerate.Process(silence, kBlockSize, /*fast_mode=*/false,
+                               &output, &length_change));
+  // Silence is removed in one shortest pitch period, 2.5 ms.
+  EXPECT_EQ(length_change, 20u);
+  EXPECT_EQ(output.Size(), kBlockSize - length_change);
+}
+
 class TimeStretchTest : public ::testing::Test {
  protected:
   TimeStretchTest()
@@ -88,7 +88,7 @@ int FakeDecodeFromFile::DecodeInternal(const uint8_t* encoded,
   uint32_t timestamp_to_decode =
       ByteReader<uint32_t>::ReadLittleEndian(encoded);
 
-  if (next_timestamp_from_input_ &&
+  if (input_ && next_timestamp_from_input_ &&
       timestamp_to_decode != *next_timestamp_from_input_) {
     // A gap in the timestamp sequence is detected. Skip the same number of
     // samples from the file.
@@ -110,7 +110,11 @@ int FakeDecodeFromFile::DecodeInternal(const uint8_t* encoded,
   }
 
   cng_mode_ = false;
-  RTC_CHECK(input_->Read(static_cast<size_t>(samples_to_decode), decoded));
+  if (input_) {
+    RTC_CHECK(input_->Read(static_cast<size_t>(samples_to_decode), decoded));
+  } else {
+    std::fill_n(decoded, samples_to_decode, 0);
+  }
 
   if (stereo_) {
     InputAudioFile::DuplicateInterleaved(decoded, samples_to_decode, 2,
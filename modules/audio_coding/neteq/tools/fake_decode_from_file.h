@@ -25,7 +25,9 @@ namespace test {
 // encoding represents, and how many samples the decoder should produce for that
 // encoding. A helper method PrepareEncoded is provided to prepare such
 // encodings. If packets are missing, as determined from the timestamps, the
-// file reading will skip forward to match the loss.
+// file reading will skip forward to match the loss. If no input file is given,
+// the decoder produces silence. Note that NetEq's decisions depend on the
+// decoded audio, so they can differ from those for the real audio.
 class FakeDecodeFromFile : public AudioDecoder {
  public:
   FakeDecodeFromFile(std::unique_ptr<InputAudioFile> input,
@@ -0,0 +1,186 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/flags/parse.h"
+#include "absl/types/optional.h"
+#include "api/audio_codecs/builtin_audio_decoder_factory.h"
+#include "modules/audio_coding/neteq/tools/neteq_batch_simulation.h"
+#include "modules/audio_coding/neteq/tools/neteq_event_log_input.h"
+#include "modules/audio_coding/neteq/tools/neteq_packet_source_input.h"
+#include "modules/audio_coding/neteq/tools/neteq_test_factory.h"
+#include "modules/audio_coding/neteq/tools/rtp_file_source.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/field_trial.h"
+
+using TestConfig = webrtc::test::NetEqTestFactory::Config;
+
+ABSL_FLAG(std::string,
+          force_fieldtrials,
+          "",
+          "Field trials control experimental feature code which can be forced. "
+          "E.g. running with --force_fieldtrials=WebRTC-FooFeature/Enable/"
+          " will assign the group Enable to field trial WebRTC-FooFeature.");
+ABSL_FLAG(std::string,
+          input_list,
+          "",
+          "A text file with the names of the input files, one per line, in "
+          "addition to the ones on the command line");
+ABSL_FLAG(std::string,
+          output,
+          "",
+          "The file that the statistics of all simulations are written to");
+ABSL_FLAG(int, num_threads, 1, "The number of simulations to run at a time");
+ABSL_FLAG(bool,
+          fake_decode,
+          false,
+          "Replaces the audio payloads by fake encodings, so that no real "
+          "decoding takes place. NetEq's decisions depend on the audio, so "
+          "the statistics can differ from those with real decoding, most of "
+          "all without --replacement_audio_file");
+ABSL_FLAG(std::string,
+          replacement_audio_file,
+          "",
+          "A PCM file that the fake decoder produces audio from; silence is "
+          "produced if none is given");
+ABSL_FLAG(int,
+          max_nr_packets_in_buffer,
+          TestConfig::default_max_nr_packets_in_buffer(),
+          "Maximum allowed number of packets in the buffer");
+ABSL_FLAG(bool,
+          enable_fast_accelerate,
+          false,
+          "Enables jitter buffer fast accelerate");
+
+namespace webrtc {
+namespace test {
+namespace {
+
+std::unique_ptr<NetEqInput> CreateInput(const std::string& file_name) {
+  if (RtpFileSource::ValidRtpDump(file_name) ||
+      RtpFileSource::ValidPcap(file_name)) {
+    const NetEqPacketSourceInput::RtpHeaderExtensionMap rtp_ext_map = {
+        {TestConfig::default_audio_level(), kRtpExtensionAudioLevel},
+        {TestConfig::default_abs_send_time(), kRtpExtensionAbsoluteSendTime},
+        {TestConfig::default_transport_seq_no(),
+         kRtpExtensionTransportSequenceNumber},
+        {TestConfig::default_video_content_type(),
+         kRtpExtensionVideoContentType},
+        {TestConfig::default_video_timing(), kRtpExtensionVideoTiming}};
+    return std::make_unique<NetEqRtpDumpInput>(file_name, rtp_ext_map,
+                                               absl::nullopt);
+  }
+  return std::unique_ptr<NetEqInput>(
+      NetEqEventLogInput::CreateFromFile(file_name, absl::nullopt));
+}
+
+std::vector<std::string> ReadInputList(const std::string& file_name) {
+  std::vector<std::string> file_names;
+  std::ifstream file(file_name);
+  RTC_CHECK(file) << "Cannot open " << file_name;
+  std::string line;
+  while (std::getline(file, line)) {
+    if (!line.empty()) {
+      file_names.push_back(line);
+    }
+  }
+  return file_names;
+}
+
+int RunBatch(const std::vector<std::string>& file_names) {
+  NetEqBatchSimulation::Config config;
+  config.fake_decode = absl::GetFlag(FLAGS_fake_decode);
+  if (!config.fake_decode) {
+    config.decoder_factory = CreateBuiltinAudioDecoderFactory();
+  }
+  config.replacement_audio_file = absl::GetFlag(FLAGS_replacement_audio_file);
+  config.max_packets_in_buffer = absl::GetFlag(FLAGS_max_nr_packets_in_buffer);
+  config.enable_fast_accelerate = absl::GetFlag(FLAGS_enable_fast_accelerate);
+  config.num_threads = absl::GetFlag(FLAGS_num_threads);
+  RTC_CHECK_GE(config.num_threads, 1);
+
+  std::vector<NetEqBatchSimulation::Job> jobs;
+  for (const std::string& file_name : file_names) {
+    jobs.push_back({file_name, [file_name] { return CreateInput(file_name); }});
+  }
+
+  const int64_t start_time_us = rtc::TimeMicros();
+  const std::vector<NetEqSimulationSummary> summaries =
+      NetEqBatchSimulation(config).Run(jobs);
+  const double wall_time_ms =
+      (rtc::TimeMicros() - start_time_us) / static_cast<double>(1000);
+
+  int64_t simulation_time_ms = 0;
+  int num_errors = 0;
+  for (const NetEqSimulationSummary& summary : summaries) {
+    if (!summary.error.empty()) {
+      std::cerr << summary.name << ": " << summary.error << std::endl;
+      ++num_errors;
+      continue;
+    }
+    simulation_time_ms += summary.simulation_time_ms;
+  }
+  const double times_real_time =
+      simulation_time_ms / std::max(wall_time_ms, 1.0);
+  const size_t num_threads =
+      std::min(static_cast<size_t>(config.num_threads), jobs.size());
+  std::cout << "Simulated " << summaries.size() - num_errors << " of "
+            << summaries.size() << " inputs, " << simulation_time_ms / 1000.0
+            << " s of audio in " << wall_time_ms / 1000.0 << " s ("
+            << times_real_time << " times real time, "
+            << times_real_time / num_threads << " per thread)"
+            << std::endl;
+
+  const std::string output = absl::GetFlag(FLAGS_output);
+  if (!output.empty() && !WriteNetEqSimulationSummaries(output, summaries)) {
+    std::cerr << "Error: Cannot write " << output << std::endl;
+    return 1;
+  }
+  return num_errors == 0 ? 0 : 1;
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace webrtc
+
+int main(int argc, char* argv[]) {
+  std::vector<char*> args = absl::ParseCommandLine(argc, argv);
+  std::vector<std::string> file_names(args.begin() + 1, args.end());
+  if (!absl::GetFlag(FLAGS_input_list).empty()) {
+    std::vector<std::string> listed_file_names =
+        webrtc::test::ReadInputList(absl::GetFlag(FLAGS_input_list));
+    file_names.insert(file_names.end(), listed_file_names.begin(),
+                      listed_file_names.end());
+  }
+  if (file_names.empty()) {
+    std::cout << "Tool for simulating NetEq on many RTP dump files or RTC "
+                 "event logs, and collecting the statistics.\n"
+                 "Example usage:\n"
+                 "./neteq_batch_rtpplay --num_threads=8 --fake_decode "
+                 "--output=stats.bin input1.rtp input2.rtc ...\n";
+    return 0;
+  }
+
+  // Make force_fieldtrials persistent string during entire program live as
+  // absl::GetFlag creates temporary string and c_str() will point to
+  // deallocated string.
+  const std::string force_fieldtrials = absl::GetFlag(FLAGS_force_fieldtrials);
+  webrtc::field_trial::InitFieldTrialsFromString(force_fieldtrials.c_str());
+
+  return webrtc::test::RunBatch(file_names);
+}
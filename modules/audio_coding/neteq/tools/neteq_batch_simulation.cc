@@ -0,0 +1,534 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/tools/neteq_batch_simulation.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/match.h"
+#include "api/make_ref_counted.h"
+#include "modules/audio_coding/neteq/tools/audio_sink.h"
+#include "modules/audio_coding/neteq/tools/fake_decode_from_file.h"
+#include "modules/audio_coding/neteq/tools/input_audio_file.h"
+#include "modules/audio_coding/neteq/tools/neteq_delay_analyzer.h"
+#include "modules/audio_coding/neteq/tools/neteq_replacement_input.h"
+#include "rtc_base/byte_buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/system/file_wrapper.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+// The summary file starts with a magic word and a version, followed by the
+// number of rows and columns. Each column consists of its name, its type, the
+// size of its data and then the data, with one value per row. Integers and
+// sizes are stored as varints (signed integers zigzag encoded), doubles as
+// their IEEE 754 representation, and strings as their size followed by their
+// characters.
+constexpr char kSummaryMagic[] = "NEQS";
+constexpr uint32_t kSummaryVersion = 1;
+
+enum class ColumnType : uint8_t { kInteger = 0, kDouble = 1, kString = 2 };
+
+// Calls `visitor(name, value)` for every statistic of `summary`, which decides
+// the names and order of the columns.
+template <typename Summary, typename Visitor>
+void VisitColumns(Summary& summary, Visitor& visitor) {
+  auto& lifetime = summary.lifetime_stats;
+  auto& average = summary.average_stats;
+  visitor("name", summary.name);
+  visitor("error", summary.error);
+  visitor("simulation_time_ms", summary.simulation_time_ms);
+  visitor("wall_time_ms", summary.wall_time_ms);
+  visitor("total_samples_received", lifetime.total_samples_received);
+  visitor("concealed_samples", lifetime.concealed_samples);
+  visitor("concealment_events", lifetime.concealment_events);
+  visitor("jitter_buffer_delay_ms", lifetime.jitter_buffer_delay_ms);
+  visitor("jitter_buffer_emitted_count", lifetime.jitter_buffer_emitted_count);
+  visitor("jitter_buffer_target_delay_ms",
+          lifetime.jitter_buffer_target_delay_ms);
+  visitor("jitter_buffer_minimum_delay_ms",
+          lifetime.jitter_buffer_minimum_delay_ms);
+  visitor("inserted_samples_for_deceleration",
+          lifetime.inserted_samples_for_deceleration);
+  visitor("removed_samples_for_acceleration",
+          lifetime.removed_samples_for_acceleration);
+  visitor("silent_concealed_samples", lifetime.silent_concealed_samples);
+  visitor("fec_packets_received", lifetime.fec_packets_received);
+  visitor("fec_packets_discarded", lifetime.fec_packets_discarded);
+  visitor("packets_discarded", lifetime.packets_discarded);
+  visitor("delayed_packet_outage_samples",
+          lifetime.delayed_packet_outage_samples);
+  visitor("relative_packet_arrival_delay_ms",
+          lifetime.relative_packet_arrival_delay_ms);
+  visitor("jitter_buffer_packets_received",
+          lifetime.jitter_buffer_packets_received);
+  visitor("interruption_count", lifetime.interruption_count);
+  visitor("total_interruption_duration_ms",
+          lifetime.total_interruption_duration_ms);
+  visitor("generated_noise_samples", lifetime.generated_noise_samples);
+  visitor("current_buffer_size_ms", average.current_buffer_size_ms);
+  visitor("preferred_buffer_size_ms", average.preferred_buffer_size_ms);
+  visitor("jitter_peaks_found", average.jitter_peaks_found);
+  visitor("packet_loss_rate", average.packet_loss_rate);
+  visitor("expand_rate", average.expand_rate);
+  visitor("speech_expand_rate", average.speech_expand_rate);
+  visitor("preemptive_rate", average.preemptive_rate);
+  visitor("accelerate_rate", average.accelerate_rate);
+  visitor("secondary_decoded_rate", average.secondary_decoded_rate);
+  visitor("secondary_discarded_rate", average.secondary_discarded_rate);
+  visitor("clockdrift_ppm", average.clockdrift_ppm);
+  visitor("added_zero_samples", average.added_zero_samples);
+  visitor("mean_waiting_time_ms", average.mean_waiting_time_ms);
+  visitor("median_waiting_time_ms", average.median_waiting_time_ms);
+  visitor("min_waiting_time_ms", average.min_waiting_time_ms);
+  visitor("max_waiting_time_ms", average.max_waiting_time_ms);
+  visitor("arrival_delay_mean_ms", summary.arrival_delay.mean_ms);
+  visitor("arrival_delay_p95_ms", summary.arrival_delay.p95_ms);
+  visitor("arrival_delay_max_ms", summary.arrival_delay.max_ms);
+  visitor("playout_delay_mean_ms", summary.playout_delay.mean_ms);
+  visitor("playout_delay_p95_ms", summary.playout_delay.p95_ms);
+  visitor("playout_delay_max_ms", summary.playout_delay.max_ms);
+  visitor("target_delay_mean_ms", summary.target_delay.mean_ms);
+  visitor("target_delay_p95_ms", summary.target_delay.p95_ms);
+  visitor("target_delay_max_ms", summary.target_delay.max_ms);
+}
+
+uint64_t ZigZagEncode(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^ (value < 0 ? ~uint64_t{0} : 0);
+}
+
+int64_t ZigZagDecode(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+uint64_t DoubleToBits(double value) {
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  return bits;
+}
+
+double BitsToDouble(uint64_t bits) {
+  double value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+struct Column {
+  std::string name;
+  ColumnType type;
+  std::unique_ptr<rtc::ByteBufferWriter> data =
+      std::make_unique<rtc::ByteBufferWriter>();
+};
+
+// Appends the statistics of a summary to their columns.
+class ColumnAppender {
+ public:
+  explicit ColumnAppender(std::vector<Column>& columns) : columns_(columns) {}
+
+  void operator()(const char* name, const std::string& value) {
+    rtc::ByteBufferWriter& data = NextColumn(name, ColumnType::kString);
+    data.WriteUVarint(value.size());
+    data.WriteString(value);
+  }
+  void operator()(const char* name, double value) {
+    NextColumn(name, ColumnType::kDouble).WriteUInt64(DoubleToBits(value));
+  }
+  void operator()(const char* name, int64_t value) {
+    NextColumn(name, ColumnType::kInteger).WriteUVarint(ZigZagEncode(value));
+  }
+  void operator()(const char* name, uint64_t value) {
+    (*this)(name, static_cast<int64_t>(value));
+  }
+  void operator()(const char* name, int32_t value) {
+    (*this)(name, static_cast<int64_t>(value));
+  }
+
+ private:
+  // Returns the data of the next column, which is created for the first row.
+  rtc::ByteBufferWriter& NextColumn(const char* name, ColumnType type) {
+    if (index_ == columns_.size()) {
+      columns_.push_back({name, type});
+    }
+    RTC_DCHECK_EQ(columns_[index_].name, name);
+    return *columns_[index_++].data;
+  }
+
+  std::vector<Column>& columns_;
+  size_t index_ = 0;
+};
+
+// The columns of a summary file, indexed by name, from which the statistics of
+// one row are read at a time.
+class ColumnReader {
+ public:
+  struct ReadColumn {
+    ColumnType type;
+    std::unique_ptr<rtc::ByteBufferReader> data;
+  };
+
+  explicit ColumnReader(std::map<std::string, ReadColumn> columns)
+      : columns_(std::move(columns)) {}
+
+  bool ok() const { return ok_; }
+
+  void operator()(const char* name, std::string& value) {
+    rtc::ByteBufferReader* data = FindColumn(name, ColumnType::kString);
+    uint64_t size;
+    if (data &&
+        !(data->ReadUVarint(&size) && data->ReadString(&value, size))) {
+      ok_ = false;
+    }
+  }
+  void operator()(const char* name, double& value) {
+    rtc::ByteBufferReader* data = FindColumn(name, ColumnType::kDouble);
+    uint64_t bits;
+    if (data) {
+      ok_ &= data->ReadUInt64(&bits);
+      value = BitsToDouble(bits);
+    }
+  }
+  template <typename T>
+  void operator()(const char* name, T& value) {
+    static_assert(std::is_integral<T>::value, "");
+    rtc::ByteBufferReader* data = FindColumn(name, ColumnType::kInteger);
+    uint64_t encoded;
+    if (data) {
+      ok_ &= data->ReadUVarint(&encoded);
+      value = static_cast<T>(ZigZagDecode(encoded));
+    }
+  }
+
+ private:
+  // Returns null if the file doesn't have the column, or if it has a different
+  // type, in which case the statistic keeps its default value.
+  rtc::ByteBufferReader* FindColumn(const char* name, ColumnType type) {
+    auto it = columns_.find(name);
+    if (!ok_ || it == columns_.end() || it->second.type != type) {
+      return nullptr;
+    }
+    return it->second.data.get();
+  }
+
+  std::map<std::string, ReadColumn> columns_;
+  bool ok_ = true;
+};
+
+NetEqSimulationSummary::Delays SummarizeDelays(
+    const NetEqDelayAnalyzer::Delays& graph) {
+  NetEqSimulationSummary::Delays delays;
+  if (graph.empty()) {
+    return delays;
+  }
+  std::vector<double> values;
+  values.reserve(graph.size());
+  double sum = 0.0;
+  for (const auto& point : graph) {
+    values.push_back(point.second);
+    sum += point.second;
+  }
+  delays.mean_ms = sum / values.size();
+  auto p95 = values.begin() + (values.size() - 1) * 95 / 100;
+  std::nth_element(values.begin(), p95, values.end());
+  delays.p95_ms = *p95;
+  delays.max_ms = *std::max_element(p95, values.end());
+  return delays;
+}
+
+// Creates `FakeDecodeFromFile` decoders for the "replacement" codec, which the
+// packets are replaced with in fake decode mode.
+class ReplacementDecoderFactory : public AudioDecoderFactory {
+ public:
+  explicit ReplacementDecoderFactory(absl::string_view audio_file)
+      : audio_file_(audio_file) {}
+
+  std::vector<AudioCodecSpec> GetSupportedDecoders() override { return {}; }
+
+  bool IsSupportedDecoder(const SdpAudioFormat& format) override {
+    return format.name == "replacement";
+  }
+
+  std::unique_ptr<AudioDecoder> MakeAudioDecoder(
+      const SdpAudioFormat& format,
+      absl::optional<AudioCodecPairId> codec_pair_id) override {
+    if (!IsSupportedDecoder(format)) {
+      return nullptr;
+    }
+    std::unique_ptr<InputAudioFile> input;
+    if (!audio_file_.empty()) {
+      input = std::make_unique<InputAudioFile>(audio_file_);
+    }
+    return std::make_unique<FakeDecodeFromFile>(
+        std::move(input), format.clockrate_hz, format.num_channels > 1);
+  }
+
+ private:
+  const std::string audio_file_;
+};
+
+// Runs the simulation of `job`, and fills in the statistics of `summary`, or
+// its error.
+void Simulate(const NetEqBatchSimulation::Config& config,
+              const NetEqBatchSimulation::Job& job,
+              NetEqSimulationSummary& summary) {
+  std::unique_ptr<NetEqInput> input = job.create_input();
+  if (!input || input->ended()) {
+    summary.error = "Cannot create input";
+    return;
+  }
+
+  // Discard the packets before the first one with a known payload type, which
+  // decides the initial sample rate.
+  absl::optional<int> sample_rate_hz;
+  while (absl::optional<RTPHeader> header = input->NextHeader()) {
+    auto it = config.codecs.find(header->payloadType);
+    if (it != config.codecs.end()) {
+      sample_rate_hz = it->second.clockrate_hz;
+      break;
+    }
+    input->PopPacket();
+  }
+  if (!sample_rate_hz) {
+    summary.error = "No packets with known payload types";
+    return;
+  }
+
+  NetEqTest::DecoderMap codecs = config.codecs;
+  rtc::scoped_refptr<AudioDecoderFactory> decoder_factory =
+      config.decoder_factory;
+  if (config.fake_decode) {
+    // Only comfort noise is kept; everything else is replaced with fake
+    // encodings of a payload type that isn't used by the input.
+    codecs.clear();
+    std::set<uint8_t> cn_types;
+    for (const auto& codec : config.codecs) {
+      if (absl::EqualsIgnoreCase(codec.second.name, "cn")) {
+        codecs.insert(codec);
+        cn_types.insert(codec.first);
+      }
+    }
+    int replacement_payload_type = 127;
+    while (config.codecs.count(replacement_payload_type) > 0) {
+      --replacement_payload_type;
+    }
+    if (replacement_payload_type < 0) {
+      summary.error = "No payload type available for fake decoding";
+      return;
+    }
+    codecs.insert({replacement_payload_type,
+                   SdpAudioFormat("replacement", *sample_rate_hz, 1)});
+    input = std::make_unique<NetEqReplacementInput>(
+        std::move(input), replacement_payload_type, cn_types,
+        /*forbidden_types=*/std::set<uint8_t>());
+    decoder_factory = rtc::make_ref_counted<ReplacementDecoderFactory>(
+        config.replacement_audio_file);
+  }
+
+  NetEqStatsGetter stats_getter(std::make_unique<NetEqDelayAnalyzer>());
+  NetEqTest::Callbacks callbacks;
+  callbacks.post_insert_packet = stats_getter.delay_analyzer();
+  callbacks.get_audio_callback = &stats_getter;
+  NetEq::Config neteq_config;
+  neteq_config.sample_rate_hz = *sample_rate_hz;
+  neteq_config.max_packets_in_buffer = config.max_packets_in_buffer;
+  neteq_config.enable_fast_accelerate = config.enable_fast_accelerate;
+  NetEqTest test(neteq_config, decoder_factory, codecs, /*text_log=*/nullptr,
+                 /*neteq_factory=*/nullptr, std::move(input),
+                 std::make_unique<VoidAudioSink>(), callbacks);
+  summary.simulation_time_ms = test.Run();
+
+  summary.lifetime_stats = test.LifetimeStats();
+  summary.average_stats = stats_getter.AverageStats();
+  NetEqDelayAnalyzer::Delays arrival_delay_ms;
+  NetEqDelayAnalyzer::Delays corrected_arrival_delay_ms;
+  NetEqDelayAnalyzer::Delays playout_delay_ms;
+  NetEqDelayAnalyzer::Delays target_delay_ms;
+  stats_getter.delay_analyzer()->CreateGraphs(
+      &arrival_delay_ms, &corrected_arrival_delay_ms, &playout_delay_ms,
+      &target_delay_ms);
+  summary.arrival_delay = SummarizeDelays(corrected_arrival_delay_ms);
+  summary.playout_delay = SummarizeDelays(playout_delay_ms);
+  summary.target_delay = SummarizeDelays(target_delay_ms);
+}
+
+}  // namespace
+
+bool WriteNetEqSimulationSummaries(
+    absl::string_view file_name,
+    rtc::ArrayView<const NetEqSimulationSummary> summaries) {
+  std::vector<Column> columns;
+  if (summaries.empty()) {
+    // Write the columns of an empty table.
+    const NetEqSimulationSummary summary;
+    ColumnAppender appender(columns);
+    VisitColumns(summary, appender);
+    for (Column& column : columns) {
+      column.data = std::make_unique<rtc::ByteBufferWriter>();
+    }
+  }
+  for (const NetEqSimulationSummary& summary : summaries) {
+    ColumnAppender appender(columns);
+    VisitColumns(summary, appender);
+  }
+
+  rtc::ByteBufferWriter header;
+  header.WriteBytes(kSummaryMagic, 4);
+  header.WriteUInt32(kSummaryVersion);
+  header.WriteUVarint(summaries.size());
+  header.WriteUVarint(columns.size());
+  for (const Column& column : columns) {
+    header.WriteUVarint(column.name.size());
+    header.WriteString(column.name);
+    header.WriteUInt8(static_cast<uint8_t>(column.type));
+    header.WriteUVarint(column.data->Length());
+  }
+
+  FileWrapper file = FileWrapper::OpenWriteOnly(file_name);
+  if (!file.is_open() || !file.Write(header.Data(), header.Length())) {
+    return false;
+  }
+  for (const Column& column : columns) {
+    if (!file.Write(column.data->Data(), column.data->Length())) {
+      return false;
+    }
+  }
+  return file.Close();
+}
+
+absl::optional<std::vector<NetEqSimulationSummary>>
+ReadNetEqSimulationSummaries(absl::string_view file_name) {
+  FileWrapper file = FileWrapper::OpenReadOnly(file_name);
+  const long file_size = file.is_open() ? file.FileSize() : -1;
+  if (file_size < 0) {
+    return absl::nullopt;
+  }
+  std::string contents(file_size, '\0');
+  if (file.Read(&contents[0], contents.size()) != contents.size()) {
+    return absl::nullopt;
+  }
+
+  rtc::ByteBufferReader reader(contents.data(), contents.size());
+  std::string magic;
+  uint32_t version;
+  uint64_t num_rows;
+  uint64_t num_columns;
+  if (!reader.ReadString(&magic, 4) || magic != kSummaryMagic ||
+      !reader.ReadUInt32(&version) || version != kSummaryVersion ||
+      !reader.ReadUVarint(&num_rows) || !reader.ReadUVarint(&num_columns)) {
+    return absl::nullopt;
+  }
+  // The names, types and sizes of the columns precede their data.
+  std::vector<std::pair<std::string, ColumnReader::ReadColumn>> columns;
+  std::vector<uint64_t> column_sizes;
+  for (uint64_t i = 0; i < num_columns; ++i) {
+    uint64_t name_size;
+    std::string name;
+    uint8_t type;
+    uint64_t size;
+    if (!reader.ReadUVarint(&name_size) ||
+        !reader.ReadString(&name, name_size) || !reader.ReadUInt8(&type) ||
+        !reader.ReadUVarint(&size)) {
+      return absl::nullopt;
+    }
+    columns.emplace_back(std::move(name),
+                         ColumnReader::ReadColumn{
+                             static_cast<ColumnType>(type), nullptr});
+    column_sizes.push_back(size);
+  }
+  // Every value takes at least one byte, which bounds the number of rows by
+  // the size of the file.
+  if (columns.empty() && num_rows > 0) {
+    return absl::nullopt;
+  }
+  std::map<std::string, ColumnReader::ReadColumn> columns_by_name;
+  for (size_t i = 0; i < columns.size(); ++i) {
+    if (column_sizes[i] > reader.Length() || column_sizes[i] < num_rows) {
+      return absl::nullopt;
+    }
+    columns[i].second.data = std::make_unique<rtc::ByteBufferReader>(
+        reader.Data(), column_sizes[i]);
+    reader.Consume(column_sizes[i]);
+    columns_by_name.insert(std::move(columns[i]));
+  }
+
+  ColumnReader column_reader(std::move(columns_by_name));
+  std::vector<NetEqSimulationSummary> summaries;
+  for (uint64_t i = 0; i < num_rows; ++i) {
+    NetEqSimulationSummary summary;
+    VisitColumns(summary, column_reader);
+    if (!column_reader.ok()) {
+      return absl::nullopt;
+    }
+    summaries.push_back(std::move(summary));
+  }
+  return summaries;
+}
+
+NetEqBatchSimulation::Config::Config() = default;
+NetEqBatchSimulation::Config::Config(const Config& other) = default;
+NetEqBatchSimulation::Config::~Config() = default;
+
+NetEqBatchSimulation::NetEqBatchSimulation(const Config& config)
+    : config_(config) {
+  RTC_DCHECK(config_.fake_decode || config_.decoder_factory);
+  RTC_DCHECK_GE(config_.num_threads, 1);
+}
+
+NetEqBatchSimulation::~NetEqBatchSimulation() = default;
+
+std::vector<NetEqSimulationSummary> NetEqBatchSimulation::Run(
+    rtc::ArrayView<const Job> jobs) const {
+  std::vector<NetEqSimulationSummary> summaries(jobs.size());
+  // Every thread takes the next job until none is left, so that long and
+  // short simulations are balanced between the threads.
+  std::atomic<size_t> next_job(0);
+  auto run_jobs = [&] {
+    for (size_t i = next_job++; i < jobs.size(); i = next_job++) {
+      summaries[i] = RunOne(jobs[i]);
+    }
+  };
+  const size_t num_threads =
+      std::min(static_cast<size_t>(config_.num_threads), jobs.size());
+  std::vector<rtc::PlatformThread> threads;
+  for (size_t i = 1; i < num_threads; ++i) {
+    threads.push_back(
+        rtc::PlatformThread::SpawnJoinable(run_jobs, "NetEqBatchSimulation"));
+  }
+  run_jobs();
+  for (rtc::PlatformThread& thread : threads) {
+    thread.Finalize();
+  }
+  return summaries;
+}
+
+NetEqSimulationSummary NetEqBatchSimulation::RunOne(const Job& job) const {
+  const int64_t start_time_us = rtc::TimeMicros();
+  NetEqSimulationSummary summary;
+  summary.name = job.name;
+  Simulate(config_, job, summary);
+  summary.wall_time_ms = (rtc::TimeMicros() - start_time_us) / 1000.0;
+  return summary;
+}
+
+}  // namespace test
+}  // namespace webrtc
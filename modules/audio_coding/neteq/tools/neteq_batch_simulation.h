@@ -0,0 +1,133 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_CODING_NETEQ_TOOLS_NETEQ_BATCH_SIMULATION_H_
+#define MODULES_AUDIO_CODING_NETEQ_TOOLS_NETEQ_BATCH_SIMULATION_H_
+
+#include <stdint.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "api/audio_codecs/audio_decoder_factory.h"
+#include "api/neteq/neteq.h"
+#include "api/scoped_refptr.h"
+#include "modules/audio_coding/neteq/tools/neteq_input.h"
+#include "modules/audio_coding/neteq/tools/neteq_stats_getter.h"
+#include "modules/audio_coding/neteq/tools/neteq_test.h"
+
+namespace webrtc {
+namespace test {
+
+// The outcome of the NetEq simulation of one input.
+struct NetEqSimulationSummary {
+  // Summary of a delay graph from `NetEqDelayAnalyzer`.
+  struct Delays {
+    double mean_ms = 0.0;
+    double p95_ms = 0.0;
+    double max_ms = 0.0;
+  };
+
+  // The name of the input, e.g. its file name.
+  std::string name;
+  // Empty if the simulation succeeded.
+  std::string error;
+  // The duration of the produced audio.
+  int64_t simulation_time_ms = 0;
+  // The time it took to set up and run the simulation.
+  double wall_time_ms = 0.0;
+  // The lifetime statistics at the end of the simulation.
+  NetEqLifetimeStatistics lifetime_stats;
+  // The network statistics, averaged over the simulation.
+  NetEqStatsGetter::Stats average_stats;
+  // The packet arrival delay, corrected for clock drift.
+  Delays arrival_delay;
+  Delays playout_delay;
+  Delays target_delay;
+};
+
+// Writes `summaries` to `file_name` in a compact columnar format: the values
+// of each statistic are stored together, so that a single statistic can be
+// read for all simulations without parsing the others. Returns false if the
+// file could not be written.
+bool WriteNetEqSimulationSummaries(
+    absl::string_view file_name,
+    rtc::ArrayView<const NetEqSimulationSummary> summaries);
+
+// Reads a file written by `WriteNetEqSimulationSummaries()`. Unknown columns
+// are skipped, and statistics that are missing from the file are left at
+// their default values. Returns nullopt if the file could not be parsed.
+absl::optional<std::vector<NetEqSimulationSummary>>
+ReadNetEqSimulationSummaries(absl::string_view file_name);
+
+// Runs the NetEq simulations of many inputs, e.g. RTC event logs, on a number
+// of threads. Each simulation runs as fast as possible on one thread, and only
+// its statistics are kept.
+class NetEqBatchSimulation {
+ public:
+  struct Config {
+    Config();
+    Config(const Config& other);
+    ~Config();
+
+    // The mapping from RTP payload type to codec.
+    NetEqTest::DecoderMap codecs = NetEqTest::StandardDecoderMap();
+    // The factory that decodes the packets. Not used if `fake_decode` is set.
+    rtc::scoped_refptr<AudioDecoderFactory> decoder_factory;
+    // If set, the packets are not decoded. Instead, they are replaced by fake
+    // encodings (see `NetEqReplacementInput`), which `FakeDecodeFromFile`
+    // decodes into audio from `replacement_audio_file`, or into silence if no
+    // file is given. All packets except comfort noise are treated as audio.
+    // NetEq's decisions depend on the decoded audio: whether accelerate and
+    // preemptive expand succeed, and how concealment and merging sound. The
+    // decisions, and thereby all statistics, can therefore differ from those
+    // of real decoding, most of all with silence.
+    bool fake_decode = false;
+    std::string replacement_audio_file;
+    int max_packets_in_buffer = 200;
+    bool enable_fast_accelerate = false;
+    // The number of threads that the simulations run on, including the
+    // calling thread.
+    int num_threads = 1;
+  };
+
+  // Creates the input of a simulation, or returns null on failure. Called on
+  // the thread that runs the simulation.
+  using InputFactory = std::function<std::unique_ptr<NetEqInput>()>;
+
+  struct Job {
+    std::string name;
+    InputFactory create_input;
+  };
+
+  explicit NetEqBatchSimulation(const Config& config);
+  ~NetEqBatchSimulation();
+
+  // Runs the simulations of `jobs`, and returns their summaries in the same
+  // order. Blocks until all simulations are done.
+  std::vector<NetEqSimulationSummary> Run(
+      rtc::ArrayView<const Job> jobs) const;
+
+  // Runs the simulation of `job` on the calling thread.
+  NetEqSimulationSummary RunOne(const Job& job) const;
+
+ private:
+  const Config config_;
+};
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_CODING_NETEQ_TOOLS_NETEQ_BATCH_SIMULATION_H_
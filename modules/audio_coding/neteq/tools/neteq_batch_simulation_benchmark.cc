@@ -0,0 +1,172 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/audio_codecs/builtin_audio_decoder_factory.h"
+#include "benchmark/benchmark.h"
+#include "modules/audio_coding/codecs/pcm16b/audio_encoder_pcm16b.h"
+#include "modules/audio_coding/neteq/tools/encode_neteq_input.h"
+#include "modules/audio_coding/neteq/tools/neteq_batch_simulation.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/random.h"
+#include "rtc_base/numerics/safe_conversions.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+constexpr int kSampleRateHz = 16000;
+// The payload type of 16 kHz L16 in `NetEqTest::StandardDecoderMap()`.
+constexpr int kPayloadType = 94;
+constexpr int64_t kDurationMs = 60000;
+constexpr int64_t kOutputPeriodMs = 10;
+// The network delay of each packet is uniform in [0, kMaxJitterMs], so that
+// packets arrive reordered and NetEq has to adapt its buffer level.
+constexpr int kMaxJitterMs = 80;
+
+class NoiseGenerator : public EncodeNetEqInput::Generator {
+ public:
+  rtc::ArrayView<const int16_t> Generate(size_t num_samples) override {
+    samples_.resize(num_samples);
+    for (int16_t& sample : samples_) {
+      sample = rtc::saturated_cast<int16_t>(random_.Gaussian(0, 3000));
+    }
+    return samples_;
+  }
+
+ private:
+  Random random_{42};
+  std::vector<int16_t> samples_;
+};
+
+using Packets = std::vector<std::unique_ptr<NetEqInput::PacketData>>;
+
+// Encodes noise, and delays the packets by a random network delay. The packets
+// are encoded up front, so that encoding isn't part of the measured time.
+Packets CreatePackets() {
+  AudioEncoderPcm16B::Config encoder_config;
+  encoder_config.sample_rate_hz = kSampleRateHz;
+  encoder_config.payload_type = kPayloadType;
+  EncodeNetEqInput input(std::make_unique<NoiseGenerator>(),
+                         std::make_unique<AudioEncoderPcm16B>(encoder_config),
+                         kDurationMs);
+  Random random(17);
+  Packets packets;
+  while (*input.NextPacketTime() < kDurationMs) {
+    std::unique_ptr<NetEqInput::PacketData> packet = input.PopPacket();
+    packet->time_ms += random.Rand(0, kMaxJitterMs);
+    packets.push_back(std::move(packet));
+  }
+  std::stable_sort(packets.begin(), packets.end(),
+                   [](const auto& a, const auto& b) {
+                     return a->time_ms < b->time_ms;
+                   });
+  return packets;
+}
+
+// Replays pre-encoded packets, and asks for audio every 10 ms until the last
+// packet has arrived.
+class PacketReplayInput : public NetEqInput {
+ public:
+  explicit PacketReplayInput(const Packets& packets) : packets_(packets) {
+    RTC_DCHECK(!packets_.empty());
+  }
+
+  absl::optional<int64_t> NextPacketTime() const override {
+    if (next_packet_ == packets_.size()) {
+      return absl::nullopt;
+    }
+    return packets_[next_packet_]->time_ms;
+  }
+
+  absl::optional<int64_t> NextOutputEventTime() const override {
+    if (ended()) {
+      return absl::nullopt;
+    }
+    return next_output_event_ms_;
+  }
+
+  std::unique_ptr<PacketData> PopPacket() override {
+    if (next_packet_ == packets_.size()) {
+      return nullptr;
+    }
+    const PacketData& packet = *packets_[next_packet_++];
+    auto copy = std::make_unique<PacketData>();
+    copy->header = packet.header;
+    copy->payload.SetData(packet.payload);
+    copy->time_ms = packet.time_ms;
+    return copy;
+  }
+
+  void AdvanceOutputEvent() override {
+    next_output_event_ms_ += kOutputPeriodMs;
+  }
+
+  bool ended() const override {
+    return next_output_event_ms_ > packets_.back()->time_ms;
+  }
+
+  absl::optional<RTPHeader> NextHeader() const override {
+    if (next_packet_ == packets_.size()) {
+      return absl::nullopt;
+    }
+    return packets_[next_packet_]->header;
+  }
+
+ private:
+  const Packets& packets_;
+  size_t next_packet_ = 0;
+  int64_t next_output_event_ms_ = 0;
+};
+
+// Simulates one minute of a call on one thread, with or without real
+// decoding. As decoding L16 is almost free, both measure the cost of NetEq
+// itself, which is what fake decoding reduces the cost of any codec to.
+void BM_SimulateCall(benchmark::State& state) {
+  const bool fake_decode = state.range(0) != 0;
+  const Packets packets = CreatePackets();
+  NetEqBatchSimulation::Config config;
+  config.fake_decode = fake_decode;
+  if (!fake_decode) {
+    config.decoder_factory = CreateBuiltinAudioDecoderFactory();
+  }
+  const NetEqBatchSimulation simulation(config);
+  const NetEqBatchSimulation::Job job = {"call", [&packets] {
+    return std::make_unique<PacketReplayInput>(packets);
+  }};
+
+  int64_t simulation_time_ms = 0;
+  double wall_time_ms = 0.0;
+  for (auto _ : state) {
+    NetEqSimulationSummary summary = simulation.RunOne(job);
+    RTC_CHECK(summary.error.empty()) << summary.error;
+    simulation_time_ms += summary.simulation_time_ms;
+    wall_time_ms += summary.wall_time_ms;
+  }
+  state.counters["times_real_time"] =
+      simulation_time_ms / std::max(wall_time_ms, 1e-3);
+}
+
+BENCHMARK(BM_SimulateCall)
+    ->Arg(0)
+    ->Arg(1)
+    ->ArgName("fake_decode")
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
+}  // namespace test
+}  // namespace webrtc
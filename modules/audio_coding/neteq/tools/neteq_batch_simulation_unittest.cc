@@ -0,0 +1,200 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_coding/neteq/tools/neteq_batch_simulation.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/audio_codecs/builtin_audio_decoder_factory.h"
+#include "modules/audio_coding/codecs/pcm16b/audio_encoder_pcm16b.h"
+#include "modules/audio_coding/neteq/tools/encode_neteq_input.h"
+#include "rtc_base/byte_buffer.h"
+#include "rtc_base/strings/string_builder.h"
+#include "rtc_base/system/file_wrapper.h"
+#include "test/gtest.h"
+#include "test/testsupport/file_utils.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+constexpr int kSampleRateHz = 16000;
+// The payload type of 16 kHz L16 in `NetEqTest::StandardDecoderMap()`.
+constexpr int kPayloadType = 94;
+
+class SilenceGenerator : public EncodeNetEqInput::Generator {
+ public:
+  rtc::ArrayView<const int16_t> Generate(size_t num_samples) override {
+    samples_.resize(num_samples, 0);
+    return samples_;
+  }
+
+ private:
+  std::vector<int16_t> samples_;
+};
+
+NetEqBatchSimulation::Job CreateJob(absl::string_view name,
+                                    int64_t duration_ms) {
+  return {std::string(name), [duration_ms] {
+            AudioEncoderPcm16B::Config encoder_config;
+            encoder_config.sample_rate_hz = kSampleRateHz;
+            encoder_config.payload_type = kPayloadType;
+            return std::make_unique<EncodeNetEqInput>(
+                std::make_unique<SilenceGenerator>(),
+                std::make_unique<AudioEncoderPcm16B>(encoder_config),
+                duration_ms);
+          }};
+}
+
+NetEqBatchSimulation::Config CreateConfig(bool fake_decode) {
+  NetEqBatchSimulation::Config config;
+  config.fake_decode = fake_decode;
+  if (!fake_decode) {
+    config.decoder_factory = CreateBuiltinAudioDecoderFactory();
+  }
+  return config;
+}
+
+void ExpectEqualStats(const NetEqSimulationSummary& a,
+                      const NetEqSimulationSummary& b) {
+  EXPECT_EQ(a.simulation_time_ms, b.simulation_time_ms);
+  EXPECT_EQ(a.lifetime_stats.total_samples_received,
+            b.lifetime_stats.total_samples_received);
+  EXPECT_EQ(a.lifetime_stats.concealed_samples,
+            b.lifetime_stats.concealed_samples);
+  EXPECT_EQ(a.lifetime_stats.jitter_buffer_delay_ms,
+            b.lifetime_stats.jitter_buffer_delay_ms);
+  EXPECT_EQ(a.lifetime_stats.jitter_buffer_packets_received,
+            b.lifetime_stats.jitter_buffer_packets_received);
+  EXPECT_EQ(a.average_stats.expand_rate, b.average_stats.expand_rate);
+  EXPECT_EQ(a.playout_delay.mean_ms, b.playout_delay.mean_ms);
+  EXPECT_EQ(a.target_delay.max_ms, b.target_delay.max_ms);
+}
+
+}  // namespace
+
+TEST(NetEqBatchSimulationTest, RunsSimulation) {
+  NetEqBatchSimulation simulation(CreateConfig(/*fake_decode=*/false));
+  NetEqSimulationSummary summary =
+      simulation.RunOne(CreateJob("input", /*duration_ms=*/2000));
+  EXPECT_EQ(summary.name, "input");
+  EXPECT_EQ(summary.error, "");
+  EXPECT_GE(summary.simulation_time_ms, 2000);
+  EXPECT_EQ(summary.lifetime_stats.total_samples_received,
+            static_cast<uint64_t>(summary.simulation_time_ms *
+                                  kSampleRateHz / 1000));
+  // At least 2 s of 20 ms packets.
+  EXPECT_GE(summary.lifetime_stats.jitter_buffer_packets_received, 100u);
+  EXPECT_GT(summary.playout_delay.mean_ms, 0.0);
+  EXPECT_GE(summary.playout_delay.max_ms, summary.playout_delay.p95_ms);
+  EXPECT_GE(summary.playout_delay.p95_ms, 0.0);
+  EXPECT_GT(summary.wall_time_ms, 0.0);
+}
+
+TEST(NetEqBatchSimulationTest, FakeDecodeKeepsNetEqDecisions) {
+  // As the input is silence, decoding it for real gives the same audio as the
+  // fake decoder, so that all statistics should be the same.
+  NetEqSimulationSummary decoded =
+      NetEqBatchSimulation(CreateConfig(/*fake_decode=*/false))
+          .RunOne(CreateJob("input", /*duration_ms=*/2000));
+  NetEqSimulationSummary fake_decoded =
+      NetEqBatchSimulation(CreateConfig(/*fake_decode=*/true))
+          .RunOne(CreateJob("input", /*duration_ms=*/2000));
+  EXPECT_EQ(fake_decoded.error, "");
+  ExpectEqualStats(decoded, fake_decoded);
+}
+
+TEST(NetEqBatchSimulationTest, RunsJobsInParallel) {
+  std::vector<NetEqBatchSimulation::Job> jobs;
+  for (int i = 0; i < 7; ++i) {
+    rtc::StringBuilder name;
+    name << "input" << i;
+    jobs.push_back(CreateJob(name.str(), /*duration_ms=*/500 + 100 * i));
+  }
+  jobs.push_back({"broken", [] { return nullptr; }});
+
+  NetEqBatchSimulation::Config config = CreateConfig(/*fake_decode=*/true);
+  NetEqBatchSimulation single_threaded(config);
+  config.num_threads = 3;
+  NetEqBatchSimulation multi_threaded(config);
+  std::vector<NetEqSimulationSummary> expected = single_threaded.Run(jobs);
+  std::vector<NetEqSimulationSummary> summaries = multi_threaded.Run(jobs);
+
+  ASSERT_EQ(summaries.size(), jobs.size());
+  for (size_t i = 0; i < jobs.size(); ++i) {
+    EXPECT_EQ(summaries[i].name, jobs[i].name);
+    ExpectEqualStats(summaries[i], expected[i]);
+  }
+  EXPECT_GE(summaries[3].simulation_time_ms, 800);
+  EXPECT_EQ(summaries.back().error, "Cannot create input");
+}
+
+TEST(NetEqBatchSimulationTest, WritesAndReadsSummaries) {
+  std::vector<NetEqBatchSimulation::Job> jobs = {
+      CreateJob("first", /*duration_ms=*/300),
+      CreateJob("second", /*duration_ms=*/600)};
+  std::vector<NetEqSimulationSummary> summaries =
+      NetEqBatchSimulation(CreateConfig(/*fake_decode=*/true)).Run(jobs);
+  summaries[1].error = "Some error";
+  summaries[1].lifetime_stats.interruption_count = -1;
+
+  const std::string file_name =
+      TempFilename(OutputPath(), "neteq_batch_simulation");
+  ASSERT_TRUE(WriteNetEqSimulationSummaries(file_name, summaries));
+  absl::optional<std::vector<NetEqSimulationSummary>> read_summaries =
+      ReadNetEqSimulationSummaries(file_name);
+  ASSERT_TRUE(read_summaries);
+  ASSERT_EQ(read_summaries->size(), 2u);
+  for (size_t i = 0; i < summaries.size(); ++i) {
+    const NetEqSimulationSummary& read = (*read_summaries)[i];
+    EXPECT_EQ(read.name, summaries[i].name);
+    EXPECT_EQ(read.error, summaries[i].error);
+    EXPECT_EQ(read.wall_time_ms, summaries[i].wall_time_ms);
+    EXPECT_EQ(read.lifetime_stats.interruption_count,
+              summaries[i].lifetime_stats.interruption_count);
+    EXPECT_EQ(read.arrival_delay.p95_ms, summaries[i].arrival_delay.p95_ms);
+    ExpectEqualStats(read, summaries[i]);
+  }
+
+  ASSERT_TRUE(WriteNetEqSimulationSummaries(file_name, {}));
+  read_summaries = ReadNetEqSimulationSummaries(file_name);
+  ASSERT_TRUE(read_summaries);
+  EXPECT_TRUE(read_summaries->empty());
+  RemoveFile(file_name);
+
+  EXPECT_FALSE(ReadNetEqSimulationSummaries(file_name));
+}
+
+TEST(NetEqBatchSimulationTest, RejectsRowCountLargerThanFile) {
+  rtc::ByteBufferWriter header;
+  header.WriteBytes("NEQS", 4);
+  header.WriteUInt32(1);
+  // A number of rows that can't be allocated, followed by one column.
+  header.WriteUVarint(uint64_t{1} << 60);
+  header.WriteUVarint(1);
+  header.WriteUVarint(4);
+  header.WriteString("name");
+  header.WriteUInt8(/*kString=*/2);
+  header.WriteUVarint(1);
+  header.WriteUVarint(0);
+
+  const std::string file_name =
+      TempFilename(OutputPath(), "neteq_batch_simulation");
+  FileWrapper file = FileWrapper::OpenWriteOnly(file_name);
+  ASSERT_TRUE(file.Write(header.Data(), header.Length()));
+  ASSERT_TRUE(file.Close());
+  EXPECT_FALSE(ReadNetEqSimulationSummaries(file_name));
+  RemoveFile(file_name);
+}
+
+}  // namespace test
+}  // namespace webrtc
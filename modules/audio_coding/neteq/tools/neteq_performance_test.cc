@@ -10,14 +10,23 @@
 
 #include "modules/audio_coding/neteq/tools/neteq_performance_test.h"
 
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include "api/audio/audio_frame.h"
 #include "api/audio_codecs/builtin_audio_decoder_factory.h"
+#include "api/audio_codecs/opus/audio_encoder_opus.h"
 #include "api/neteq/neteq.h"
+#include "api/task_queue/default_task_queue_factory.h"
 #include "modules/audio_coding/codecs/pcm16b/pcm16b.h"
 #include "modules/audio_coding/neteq/default_neteq_factory.h"
+#include "modules/audio_coding/neteq/neteq_pool.h"
 #include "modules/audio_coding/neteq/tools/audio_loop.h"
 #include "modules/audio_coding/neteq/tools/rtp_generator.h"
+#include "rtc_base/buffer.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/cpu_time.h"
 #include "system_wrappers/include/clock.h"
 #include "test/testsupport/file_utils.h"
 
@@ -124,5 +133,79 @@ int64_t NetEqPerformanceTest::Run(int runtime_ms,
   return end_time_ms - start_time_ms;
 }
 
+double NetEqPerformanceTest::RunStreamsPerCore(int runtime_ms,
+                                               int num_streams,
+                                               int num_threads) {
+  const std::string kInputFileName =
+      webrtc::test::ResourcePath("audio_coding/speech_mono_32_48kHz", "pcm");
+  const int kSampRateHz = 48000;
+  const int kPayloadType = 111;
+  const size_t kInputBlockSizeSamples = 10 * kSampRateHz / 1000;  // 10 ms.
+
+  // Encode a ten second loop of 20 ms packets once, which is then sent on all
+  // streams, so that encoding doesn't count towards the CPU time.
+  AudioEncoderOpusConfig encoder_config;
+  std::unique_ptr<AudioEncoder> encoder =
+      AudioEncoderOpus::MakeAudioEncoder(encoder_config, kPayloadType);
+  AudioLoop audio_loop;
+  const size_t kMaxLoopLengthSamples = kSampRateHz * 10;
+  if (!audio_loop.Init(kInputFileName, kMaxLoopLengthSamples,
+                       kInputBlockSizeSamples))
+    return -1;
+  std::vector<rtc::Buffer> payloads;
+  uint32_t encoder_timestamp = 0;
+  for (size_t i = 0; i < kMaxLoopLengthSamples / kInputBlockSizeSamples; ++i) {
+    rtc::Buffer encoded;
+    encoder->Encode(encoder_timestamp, audio_loop.GetNextBlock(), &encoded);
+    encoder_timestamp += kInputBlockSizeSamples;
+    if (!encoded.empty()) {
+      payloads.push_back(std::move(encoded));
+    }
+  }
+  if (payloads.empty())
+    return -1;
+  const int kPacketSizeMs = encoder_config.frame_size_ms;
+  const uint32_t kPacketSizeSamples = kPacketSizeMs * kSampRateHz / 1000;
+
+  NetEqPool::Config config;
+  config.neteq_config.sample_rate_hz = kSampRateHz;
+  config.num_threads = num_threads;
+  std::unique_ptr<TaskQueueFactory> task_queue_factory =
+      CreateDefaultTaskQueueFactory();
+  NetEqPool pool(config, CreateBuiltinAudioDecoderFactory(),
+                 Clock::GetRealTimeClock(), task_queue_factory.get());
+  for (int i = 0; i < num_streams; ++i) {
+    size_t stream = pool.AddStream();
+    if (!pool.stream(stream)->RegisterPayloadType(
+            kPayloadType, SdpAudioFormat("opus", kSampRateHz, 2)))
+      return -1;
+  }
+
+  RTPHeader rtp_header;
+  rtp_header.payloadType = kPayloadType;
+  NetEqAudioBatch batch;
+  const int64_t start_time_ns = rtc::GetProcessCpuTimeNanos();
+  for (int time_now_ms = 0; time_now_ms < runtime_ms; time_now_ms += 10) {
+    if (time_now_ms % kPacketSizeMs == 0) {
+      const int packet_index = time_now_ms / kPacketSizeMs;
+      const rtc::Buffer& payload = payloads[packet_index % payloads.size()];
+      rtp_header.sequenceNumber = packet_index;
+      rtp_header.timestamp = packet_index * kPacketSizeSamples;
+      for (int i = 0; i < num_streams; ++i) {
+        rtp_header.ssrc = i;
+        if (pool.stream(i)->InsertPacket(rtp_header, payload) != NetEq::kOK)
+          return -1;
+      }
+    }
+    if (pool.GetAudioBatch(&batch) != 0)
+      return -1;
+  }
+  const int64_t cpu_time_ns = rtc::GetProcessCpuTimeNanos() - start_time_ns;
+  if (cpu_time_ns <= 0)
+    return -1;
+  return static_cast<double>(num_streams) * runtime_ms * 1000000 /
+         cpu_time_ns;
+}
+
 }  // namespace test
 }  // namespace webrtc
@@ -24,6 +24,14 @@ class NetEqPerformanceTest {
   //   `drift_factor`: clock drift in [0, 1].
   // Returns the runtime in ms.
   static int64_t Run(int runtime_ms, int lossrate, double drift_factor);
+
+  // Runs `num_streams` Opus streams in a `NetEqPool` that uses `num_threads`
+  // threads, for `runtime_ms` of audio, without packet losses or clock drift.
+  // Returns the number of streams that one core can process in real time,
+  // based on the CPU time used by the process, or a negative value on error.
+  static double RunStreamsPerCore(int runtime_ms,
+                                  int num_streams,
+                                  int num_threads);
 };
 
 }  // namespace test
@@ -0,0 +1,175 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <cmath>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/audio/audio_frame.h"
+#include "api/audio/audio_mixer.h"
+#include "api/audio_codecs/audio_encoder.h"
+#include "api/audio_codecs/builtin_audio_decoder_factory.h"
+#include "api/audio_codecs/opus/audio_encoder_opus.h"
+#include "api/neteq/neteq.h"
+#include "benchmark/benchmark.h"
+#include "modules/audio_coding/neteq/default_neteq_factory.h"
+#include "modules/audio_mixer/audio_mixer_impl.h"
+#include "modules/audio_mixer/default_output_rate_calculator.h"
+#include "rtc_base/buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/random.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kSampleRateHz = 48000;
+constexpr int kPayloadType = 111;
+constexpr int kPacketSizeMs = 20;
+constexpr int kNumPackets = 50;
+// The number of sources that are talking, out of all sources.
+constexpr int kNumSpeakers = 3;
+
+// Encodes one second of a synthetic speech-like signal into 20 ms Opus
+// packets, which are sent in a loop by all sources.
+std::vector<rtc::Buffer> EncodePackets() {
+  AudioEncoderOpusConfig config;
+  config.frame_size_ms = kPacketSizeMs;
+  std::unique_ptr<AudioEncoder> encoder =
+      AudioEncoderOpus::MakeAudioEncoder(config, kPayloadType);
+  RTC_CHECK(encoder);
+  Random random(42);
+  constexpr size_t kSamplesPer10Ms = kSampleRateHz / 100;
+  std::vector<int16_t> audio(kSamplesPer10Ms);
+  std::vector<rtc::Buffer> packets;
+  uint32_t timestamp = 0;
+  while (packets.size() < kNumPackets) {
+    for (size_t i = 0; i < kSamplesPer10Ms; ++i) {
+      const double t = static_cast<double>(timestamp + i) / kSampleRateHz;
+      audio[i] = static_cast<int16_t>(
+          4000 * std::sin(2 * M_PI * 220 * t) +
+          2000 * std::sin(2 * M_PI * 1330 * t) + random.Gaussian(0, 500));
+    }
+    rtc::Buffer encoded;
+    encoder->Encode(timestamp, audio, &encoded);
+    timestamp += kSamplesPer10Ms;
+    if (!encoded.empty()) {
+      packets.push_back(std::move(encoded));
+    }
+  }
+  return packets;
+}
+
+// A mixer source that receives Opus packets into a NetEq, like the audio
+// receive streams of a conferencing server. Its level hint is set as if the
+// packets carried the audio level RTP header extension.
+class NetEqSource : public AudioMixer::Source {
+ public:
+  NetEqSource(int ssrc,
+              const AudioMixer::Source::LevelHint& level_hint,
+              Clock* clock)
+      : ssrc_(ssrc), level_hint_(level_hint) {
+    NetEq::Config config;
+    config.sample_rate_hz = kSampleRateHz;
+    neteq_ = DefaultNetEqFactory().CreateNetEq(
+        config, CreateBuiltinAudioDecoderFactory(), clock);
+    RTC_CHECK(neteq_->RegisterPayloadType(
+        kPayloadType, SdpAudioFormat("opus", kSampleRateHz, 2)));
+  }
+
+  void InsertPacket(const rtc::Buffer& payload) {
+    RTPHeader header;
+    header.payloadType = kPayloadType;
+    header.ssrc = ssrc_;
+    header.sequenceNumber = sequence_number_++;
+    header.timestamp = timestamp_;
+    timestamp_ += kPacketSizeMs * kSampleRateHz / 1000;
+    RTC_CHECK_EQ(neteq_->InsertPacket(header, payload), NetEq::kOK);
+  }
+
+  AudioFrameInfo GetAudioFrameWithInfo(int sample_rate_hz,
+                                       AudioFrame* audio_frame) override {
+    RTC_DCHECK_EQ(sample_rate_hz, kSampleRateHz);
+    bool muted = false;
+    if (neteq_->GetAudio(audio_frame, &muted) != NetEq::kOK) {
+      return AudioFrameInfo::kError;
+    }
+    return muted ? AudioFrameInfo::kMuted : AudioFrameInfo::kNormal;
+  }
+  int Ssrc() const override { return ssrc_; }
+  int PreferredSampleRate() const override { return kSampleRateHz; }
+  absl::optional<LevelHint> GetLevelHint() const override {
+    return level_hint_;
+  }
+  void SkipAudioFrame() override {
+    RTC_CHECK_EQ(neteq_->SkipAudio(), NetEq::kOK);
+  }
+
+ private:
+  const int ssrc_;
+  const LevelHint level_hint_;
+  std::unique_ptr<NetEq> neteq_;
+  uint16_t sequence_number_ = 0;
+  uint32_t timestamp_ = 0;
+};
+
+// Mixes the given number of Opus sources, of which three are talking, with
+// the default limit of three mixed sources. Every iteration is one 10 ms
+// tick: a packet is inserted into every source every other tick, and one
+// mixed frame is produced. The second argument enables the level hints, so
+// that only the talking sources are decoded.
+void BM_MixNetEqSources(benchmark::State& state) {
+  const int num_sources = state.range(0);
+  const bool use_level_hints = state.range(1) != 0;
+  static const std::vector<rtc::Buffer>* const packets =
+      new std::vector<rtc::Buffer>(EncodePackets());
+
+  SimulatedClock clock(0);
+  rtc::scoped_refptr<AudioMixerImpl> mixer = AudioMixerImpl::Create(
+      std::make_unique<DefaultOutputRateCalculator>(), /*use_limiter=*/true,
+      AudioMixerImpl::kDefaultNumberOfMixedAudioSources, use_level_hints);
+  std::vector<std::unique_ptr<NetEqSource>> sources;
+  for (int i = 0; i < num_sources; ++i) {
+    AudioMixer::Source::LevelHint level_hint;
+    level_hint.voice_activity = i < kNumSpeakers;
+    level_hint.level_dbov = i < kNumSpeakers ? 20 : 80;
+    sources.push_back(std::make_unique<NetEqSource>(i, level_hint, &clock));
+    mixer->AddSource(sources.back().get());
+  }
+
+  AudioFrame mixed_frame;
+  int tick = 0;
+  for (auto _ : state) {
+    if (tick % (kPacketSizeMs / 10) == 0) {
+      const rtc::Buffer& packet =
+          (*packets)[(tick / (kPacketSizeMs / 10)) % packets->size()];
+      for (auto& source : sources) {
+        source->InsertPacket(packet);
+      }
+    }
+    mixer->Mix(/*number_of_channels=*/1, &mixed_frame);
+    clock.AdvanceTimeMilliseconds(10);
+    ++tick;
+  }
+
+  for (auto& source : sources) {
+    mixer->RemoveSource(source.get());
+  }
+}
+
+BENCHMARK(BM_MixNetEqSources)
+    ->ArgNames({"sources", "level_hints"})
+    ->ArgsProduct({{50, 200, 500}, {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace
+}  // namespace webrtc
@@ -30,6 +30,8 @@ struct AudioMixerImpl::SourceStatus {
   Source* audio_source = nullptr;
   bool is_mixed = false;
   float gain = 0.0f;
+  // Set if the source is skipped in the current round.
+  bool skip = false;
 
   // A frame that will be passed to audio_source->GetAudioFrameWithInfo.
   AudioFrame audio_frame;
@@ -86,6 +88,20 @@ bool ShouldMixBefore(const SourceFrame& a, const SourceFrame& b) {
   return a.energy > b.energy;
 }
 
+struct SourceLevelHint {
+  AudioMixerImpl::SourceStatus* source_status = nullptr;
+  AudioMixer::Source::LevelHint level_hint;
+};
+
+// Returns true if `a` is preferred over `b`, based on their level hints, in
+// the same order as ShouldMixBefore().
+bool ShouldKeepBefore(const SourceLevelHint& a, const SourceLevelHint& b) {
+  if (a.level_hint.voice_activity != b.level_hint.voice_activity) {
+    return a.level_hint.voice_activity;
+  }
+  return a.level_hint.level_dbov < b.level_hint.level_dbov;
+}
+
 void RampAndUpdateGain(
     rtc::ArrayView<const SourceFrame> mixed_sources_and_frames) {
   for (const auto& source_frame : mixed_sources_and_frames) {
@@ -115,19 +131,23 @@ struct AudioMixerImpl::HelperContainers {
     audio_source_mixing_data_list.resize(size);
     ramp_list.resize(size);
     preferred_rates.resize(size);
+    level_hints.resize(size);
   }
 
   std::vector<AudioFrame*> audio_to_mix;
   std::vector<SourceFrame> audio_source_mixing_data_list;
   std::vector<SourceFrame> ramp_list;
   std::vector<int> preferred_rates;
+  std::vector<SourceLevelHint> level_hints;
 };
 
 AudioMixerImpl::AudioMixerImpl(
     std::unique_ptr<OutputRateCalculator> output_rate_calculator,
     bool use_limiter,
-    int max_sources_to_mix)
+    int max_sources_to_mix,
+    bool use_level_hints)
     : max_sources_to_mix_(max_sources_to_mix),
+      use_level_hints_(use_level_hints),
       output_rate_calculator_(std::move(output_rate_calculator)),
       audio_source_list_(),
       helper_containers_(std::make_unique<HelperContainers>()),
@@ -149,9 +169,11 @@ rtc::scoped_refptr<AudioMixerImpl> AudioMixerImpl::Create(
 rtc::scoped_refptr<AudioMixerImpl> AudioMixerImpl::Create(
     std::unique_ptr<OutputRateCalculator> output_rate_calculator,
     bool use_limiter,
-    int max_sources_to_mix) {
+    int max_sources_to_mix,
+    bool use_level_hints) {
   return rtc::make_ref_counted<AudioMixerImpl>(
-      std::move(output_rate_calculator), use_limiter, max_sources_to_mix);
+      std::move(output_rate_calculator), use_limiter, max_sources_to_mix,
+      use_level_hints);
 }
 
 void AudioMixerImpl::Mix(size_t number_of_channels,
@@ -197,9 +219,17 @@ void AudioMixerImpl::RemoveSource(Source* audio_source) {
 
 rtc::ArrayView<AudioFrame* const> AudioMixerImpl::GetAudioFromSources(
     int output_frequency) {
+  if (use_level_hints_) {
+    SelectSourcesToSkip();
+  }
+
   // Get audio from the audio sources and put it in the SourceFrame vector.
   int audio_source_mixing_data_count = 0;
   for (auto& source_and_status : audio_source_list_) {
+    if (source_and_status->skip) {
+      source_and_status->audio_source->SkipAudioFrame();
+      continue;
+    }
     const auto audio_frame_info =
         source_and_status->audio_source->GetAudioFrameWithInfo(
             output_frequency, &source_and_status->audio_frame);
@@ -249,6 +279,33 @@ rtc::ArrayView<AudioFrame* const> AudioMixerImpl::GetAudioFromSources(
       helper_containers_->audio_to_mix.data(), audio_to_mix_count);
 }
 
+void AudioMixerImpl::SelectSourcesToSkip() {
+  rtc::ArrayView<SourceLevelHint> level_hints(helper_containers_->level_hints);
+  size_t num_level_hints = 0;
+  for (auto& source_and_status : audio_source_list_) {
+    source_and_status->skip = false;
+    absl::optional<Source::LevelHint> level_hint =
+        source_and_status->audio_source->GetLevelHint();
+    if (level_hint.has_value()) {
+      level_hints[num_level_hints++] = {source_and_status.get(), *level_hint};
+    }
+  }
+
+  const size_t max_sources_to_keep = max_sources_to_mix_;
+  if (num_level_hints <= max_sources_to_keep) {
+    return;
+  }
+  level_hints = level_hints.subview(0, num_level_hints);
+  std::nth_element(level_hints.begin(),
+                   level_hints.begin() + max_sources_to_keep,
+                   level_hints.end(), ShouldKeepBefore);
+  for (const SourceLevelHint& p : level_hints.subview(max_sources_to_keep)) {
+    // A source that was mixed in the last round must be ramped out before it
+    // can be skipped.
+    p.source_status->skip = !p.source_status->is_mixed;
+  }
+}
+
 bool AudioMixerImpl::GetAudioSourceMixabilityStatusForTest(
     AudioMixerImpl::Source* audio_source) const {
   MutexLock lock(&mutex_);
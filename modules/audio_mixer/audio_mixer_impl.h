@@ -40,10 +40,15 @@ class AudioMixerImpl : public AudioMixer {
   static rtc::scoped_refptr<AudioMixerImpl> Create(
       int max_sources_to_mix = kDefaultNumberOfMixedAudioSources);
 
+  // If `use_level_hints` is true, the sources are ranked by their level
+  // hints before getting any audio from them, and the sources that won't be
+  // mixed are skipped instead of being asked for audio. See
+  // AudioMixer::Source::GetLevelHint().
   static rtc::scoped_refptr<AudioMixerImpl> Create(
       std::unique_ptr<OutputRateCalculator> output_rate_calculator,
       bool use_limiter,
-      int max_sources_to_mix = kDefaultNumberOfMixedAudioSources);
+      int max_sources_to_mix = kDefaultNumberOfMixedAudioSources,
+      bool use_level_hints = false);
 
   ~AudioMixerImpl() override;
 
@@ -66,7 +71,8 @@ class AudioMixerImpl : public AudioMixer {
  protected:
   AudioMixerImpl(std::unique_ptr<OutputRateCalculator> output_rate_calculator,
                  bool use_limiter,
-                 int max_sources_to_mix);
+                 int max_sources_to_mix,
+                 bool use_level_hints = false);
 
  private:
   struct HelperContainers;
@@ -77,12 +83,19 @@ class AudioMixerImpl : public AudioMixer {
   rtc::ArrayView<AudioFrame* const> GetAudioFromSources(int output_frequency)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
 
+  // Selects the sources to skip in this round, based on their level hints.
+  // The `max_sources_to_mix_` loudest sources with level hints are kept, as
+  // well as the sources that were mixed in the last round, so that they can
+  // be ramped out.
+  void SelectSourcesToSkip() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
   // The critical section lock guards audio source insertion and
   // removal, which can be done from any thread. The race checker
   // checks that mixing is done sequentially.
   mutable Mutex mutex_;
 
   const int max_sources_to_mix_;
+  const bool use_level_hints_;
 
   std::unique_ptr<OutputRateCalculator> output_rate_calculator_;
 
@@ -87,6 +87,8 @@ class MockMixerAudioSource : public ::testing::NiceMock<AudioMixer::Source> {
 
   MOCK_METHOD(int, PreferredSampleRate, (), (const, override));
   MOCK_METHOD(int, Ssrc, (), (const, override));
+  MOCK_METHOD(absl::optional<LevelHint>, GetLevelHint, (), (const, override));
+  MOCK_METHOD(void, SkipAudioFrame, (), (override));
 
   AudioFrame* fake_frame() { return &fake_frame_; }
   AudioFrameInfo fake_info() { return fake_audio_frame_info_; }
@@ -745,6 +747,118 @@ TEST(AudioMixer, MixerShouldIncludeRtpPacketInfoFromMixedSourcesOnly) {
               UnorderedElementsAre(kPacketInfo0, kPacketInfo1));
 }
 
+rtc::scoped_refptr<AudioMixerImpl> CreateMixerWithLevelHints(
+    int max_sources_to_mix) {
+  return AudioMixerImpl::Create(std::make_unique<DefaultOutputRateCalculator>(),
+                                /*use_limiter=*/true, max_sources_to_mix,
+                                /*use_level_hints=*/true);
+}
+
+TEST(AudioMixer, LevelHintsSkipQuietSources) {
+  constexpr int kAudioSources = 5;
+  const auto mixer = CreateMixerWithLevelHints(/*max_sources_to_mix=*/2);
+
+  MockMixerAudioSource sources[kAudioSources];
+  for (int i = 0; i < kAudioSources; ++i) {
+    ResetFrame(sources[i].fake_frame());
+    // Source 2 and 4 are the loudest sources, and are the only ones with
+    // voice activity.
+    AudioMixer::Source::LevelHint level_hint;
+    level_hint.level_dbov = 20 + 10 * (kAudioSources - i);
+    level_hint.voice_activity = i == 2 || i == 4;
+    ON_CALL(sources[i], GetLevelHint()).WillByDefault(Return(level_hint));
+    mixer->AddSource(&sources[i]);
+  }
+
+  for (int i = 0; i < kAudioSources; ++i) {
+    const bool keep = i == 2 || i == 4;
+    EXPECT_CALL(sources[i], GetAudioFrameWithInfo(_, _)).Times(keep ? 1 : 0);
+    EXPECT_CALL(sources[i], SkipAudioFrame()).Times(keep ? 0 : 1);
+  }
+  mixer->Mix(1, &frame_for_mixing);
+
+  for (int i = 0; i < kAudioSources; ++i) {
+    EXPECT_EQ(i == 2 || i == 4,
+              mixer->GetAudioSourceMixabilityStatusForTest(&sources[i]))
+        << "Mixed status of AudioSource #" << i << " wrong.";
+  }
+}
+
+TEST(AudioMixer, SourcesWithoutLevelHintAreNotSkipped) {
+  constexpr int kAudioSources = 4;
+  const auto mixer = CreateMixerWithLevelHints(/*max_sources_to_mix=*/1);
+
+  MockMixerAudioSource sources[kAudioSources];
+  for (int i = 0; i < kAudioSources; ++i) {
+    ResetFrame(sources[i].fake_frame());
+    mixer->AddSource(&sources[i]);
+    EXPECT_CALL(sources[i], GetAudioFrameWithInfo(_, _)).Times(1);
+    EXPECT_CALL(sources[i], SkipAudioFrame()).Times(0);
+  }
+  mixer->Mix(1, &frame_for_mixing);
+}
+
+TEST(AudioMixer, LevelHintsAreIgnoredByDefault) {
+  constexpr int kAudioSources = 4;
+  const auto mixer = AudioMixerImpl::Create(/*max_sources_to_mix=*/1);
+
+  MockMixerAudioSource sources[kAudioSources];
+  for (int i = 0; i < kAudioSources; ++i) {
+    ResetFrame(sources[i].fake_frame());
+    ON_CALL(sources[i], GetLevelHint())
+        .WillByDefault(Return(AudioMixer::Source::LevelHint()));
+    mixer->AddSource(&sources[i]);
+    EXPECT_CALL(sources[i], GetAudioFrameWithInfo(_, _)).Times(1);
+    EXPECT_CALL(sources[i], SkipAudioFrame()).Times(0);
+  }
+  mixer->Mix(1, &frame_for_mixing);
+}
+
+TEST(AudioMixer, MixedSourceIsNotSkippedUntilRampedOut) {
+  const auto mixer = CreateMixerWithLevelHints(/*max_sources_to_mix=*/1);
+  AudioMixer::Source::LevelHint loud;
+  loud.level_dbov = 10;
+  loud.voice_activity = true;
+  AudioMixer::Source::LevelHint quiet;
+  quiet.level_dbov = 100;
+
+  MockMixerAudioSource first;
+  MockMixerAudioSource second;
+  ResetFrame(first.fake_frame());
+  ResetFrame(second.fake_frame());
+  EXPECT_CALL(first, GetLevelHint()).WillRepeatedly(Return(loud));
+  EXPECT_CALL(second, GetLevelHint()).WillRepeatedly(Return(quiet));
+  mixer->AddSource(&first);
+  mixer->AddSource(&second);
+
+  EXPECT_CALL(first, GetAudioFrameWithInfo(_, _)).Times(1);
+  EXPECT_CALL(second, SkipAudioFrame()).Times(1);
+  mixer->Mix(1, &frame_for_mixing);
+  EXPECT_TRUE(mixer->GetAudioSourceMixabilityStatusForTest(&first));
+  EXPECT_FALSE(mixer->GetAudioSourceMixabilityStatusForTest(&second));
+  ::testing::Mock::VerifyAndClearExpectations(&first);
+  ::testing::Mock::VerifyAndClearExpectations(&second);
+
+  // The sources swap places. The first source is still asked for audio, so
+  // that it can be ramped out.
+  ON_CALL(first, GetLevelHint()).WillByDefault(Return(quiet));
+  ON_CALL(second, GetLevelHint()).WillByDefault(Return(loud));
+  first.fake_frame()->vad_activity_ = AudioFrame::kVadPassive;
+  EXPECT_CALL(first, GetAudioFrameWithInfo(_, _)).Times(1);
+  EXPECT_CALL(second, GetAudioFrameWithInfo(_, _)).Times(1);
+  mixer->Mix(1, &frame_for_mixing);
+  EXPECT_FALSE(mixer->GetAudioSourceMixabilityStatusForTest(&first));
+  EXPECT_TRUE(mixer->GetAudioSourceMixabilityStatusForTest(&second));
+  ::testing::Mock::VerifyAndClearExpectations(&first);
+  ::testing::Mock::VerifyAndClearExpectations(&second);
+
+  // Now the first source is skipped.
+  EXPECT_CALL(first, SkipAudioFrame()).Times(1);
+  EXPECT_CALL(first, GetAudioFrameWithInfo(_, _)).Times(0);
+  EXPECT_CALL(second, GetAudioFrameWithInfo(_, _)).Times(1);
+  mixer->Mix(1, &frame_for_mixing);
+}
+
 class HighOutputRateCalculator : public OutputRateCalculator {
  public:
   static const int kDefaultFrequency = 76000;
@@ -479,7 +479,7 @@ AdaptiveFirFilter::AdaptiveFirFilter(size_t max_size_partitions,
                                      Aec3Optimization optimization,
                                      ApmDataDumper* data_dumper)
     : data_dumper_(data_dumper),
-      fft_(),
+      fft_(optimization),
       optimization_(optimization),
       num_render_channels_(num_render_channels),
       max_size_partitions_(max_size_partitions),
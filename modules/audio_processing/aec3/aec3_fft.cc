@@ -81,7 +81,10 @@ bool IsSse2Available() {
 
 }  // namespace
 
-Aec3Fft::Aec3Fft() : ooura_fft_(IsSse2Available()) {}
+Aec3Fft::Aec3Fft() : Aec3Fft(Aec3Optimization::kNone) {}
+
+Aec3Fft::Aec3Fft(Aec3Optimization optimization)
+    : optimization_(optimization), ooura_fft_(IsSse2Available()) {}
 
 // TODO(peah): Change x to be std::array once the rest of the code allows this.
 void Aec3Fft::ZeroPaddedFft(rtc::ArrayView<const float> x,
@@ -18,6 +18,7 @@
 #include "modules/audio_processing/aec3/aec3_common.h"
 #include "modules/audio_processing/aec3/fft_data.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/system/arch.h"
 
 namespace webrtc {
 
@@ -27,21 +28,37 @@ class Aec3Fft {
  public:
   enum class Window { kRectangular, kHanning, kSqrtHanning };
 
+  // Uses the Ooura FFT.
   Aec3Fft();
+  // Uses an AVX2 FFT when `optimization` is `Aec3Optimization::kAvx2` and the
+  // Ooura FFT otherwise.
+  explicit Aec3Fft(Aec3Optimization optimization);
 
   Aec3Fft(const Aec3Fft&) = delete;
   Aec3Fft& operator=(const Aec3Fft&) = delete;
 
-  // Computes the FFT. Note that both the input and output are modified.
+  // Computes the FFT. Note that both the input and output may be modified.
   void Fft(std::array<float, kFftLength>* x, FftData* X) const {
     RTC_DCHECK(x);
     RTC_DCHECK(X);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    if (optimization_ == Aec3Optimization::kAvx2) {
+      FftAvx2(*x, X);
+      return;
+    }
+#endif
     ooura_fft_.Fft(x->data());
     X->CopyFromPackedArray(*x);
   }
   // Computes the inverse Fft.
   void Ifft(const FftData& X, std::array<float, kFftLength>* x) const {
     RTC_DCHECK(x);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    if (optimization_ == Aec3Optimization::kAvx2) {
+      IfftAvx2(X, x);
+      return;
+    }
+#endif
     X.CopyToPackedArray(x);
     ooura_fft_.InverseFft(x->data());
   }
@@ -67,6 +84,10 @@ class Aec3Fft {
                  FftData* X) const;
 
  private:
+  void FftAvx2(const std::array<float, kFftLength>& x, FftData* X) const;
+  void IfftAvx2(const FftData& X, std::array<float, kFftLength>* x) const;
+
+  const Aec3Optimization optimization_;
   const OouraFft ooura_fft_;
 };
 
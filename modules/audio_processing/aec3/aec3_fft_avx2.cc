@@ -0,0 +1,326 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include "modules/audio_processing/aec3/aec3_fft.h"
+
+namespace webrtc {
+
+// The 128 point real-valued FFT is computed as a 64 point complex-valued FFT of
+// the even and odd samples, followed by a split into the even and odd spectra.
+// The 64 point FFT is computed as an 8x8 decomposition, where the eight point
+// transforms are done in parallel over the eight lanes of the AVX2 registers.
+// The transforms use the same sign conventions and scaling as the Ooura FFT,
+// i.e., a positive exponent in the forward transform and an inverse transform
+// that is scaled by kFftLengthBy2.
+
+namespace {
+
+// cos(2 * pi * m * k / 64), at index 8 * k + m.
+alignas(32) constexpr float kTwiddlesRe[64] = {
+    1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 0.9951847266722f,
+    0.98078528040323f, 0.95694033573221f, 0.92387953251129f, 0.88192126434836f,
+    0.83146961230255f, 0.77301045336274f, 1.0f, 0.98078528040323f,
+    0.92387953251129f, 0.83146961230255f, 0.70710678118655f, 0.5555702330196f,
+    0.38268343236509f, 0.19509032201613f, 1.0f, 0.95694033573221f,
+    0.83146961230255f, 0.63439328416365f, 0.38268343236509f, 0.09801714032956f,
+    -0.19509032201613f, -0.471396736826f, 1.0f, 0.92387953251129f,
+    0.70710678118655f, 0.38268343236509f, 0.0f, -0.38268343236509f,
+    -0.70710678118655f, -0.92387953251129f, 1.0f, 0.88192126434836f,
+    0.5555702330196f, 0.09801714032956f, -0.38268343236509f, -0.77301045336274f,
+    -0.98078528040323f, -0.95694033573221f, 1.0f, 0.83146961230255f,
+    0.38268343236509f, -0.19509032201613f, -0.70710678118655f,
+    -0.98078528040323f, -0.92387953251129f, -0.5555702330196f, 1.0f,
+    0.77301045336274f, 0.19509032201613f, -0.471396736826f, -0.92387953251129f,
+    -0.95694033573221f, -0.5555702330196f, 0.09801714032956f};
+
+// sin(2 * pi * m * k / 64), at index 8 * k + m.
+alignas(32) constexpr float kTwiddlesIm[64] = {
+    0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.09801714032956f,
+    0.19509032201613f, 0.29028467725446f, 0.38268343236509f, 0.471396736826f,
+    0.5555702330196f, 0.63439328416365f, 0.0f, 0.19509032201613f,
+    0.38268343236509f, 0.5555702330196f, 0.70710678118655f, 0.83146961230255f,
+    0.92387953251129f, 0.98078528040323f, 0.0f, 0.29028467725446f,
+    0.5555702330196f, 0.77301045336274f, 0.92387953251129f, 0.9951847266722f,
+    0.98078528040323f, 0.88192126434836f, 0.0f, 0.38268343236509f,
+    0.70710678118655f, 0.92387953251129f, 1.0f, 0.92387953251129f,
+    0.70710678118655f, 0.38268343236509f, 0.0f, 0.471396736826f,
+    0.83146961230255f, 0.9951847266722f, 0.92387953251129f, 0.63439328416365f,
+    0.19509032201613f, -0.29028467725446f, 0.0f, 0.5555702330196f,
+    0.92387953251129f, 0.98078528040323f, 0.70710678118655f, 0.19509032201613f,
+    -0.38268343236509f, -0.83146961230255f, 0.0f, 0.63439328416365f,
+    0.98078528040323f, 0.88192126434836f, 0.38268343236509f, -0.29028467725446f,
+    -0.83146961230255f, -0.9951847266722f};
+
+// cos(2 * pi * k / 128).
+alignas(32) constexpr float kRealTwiddlesRe[64] = {
+    1.0f, 0.99879545620517f, 0.9951847266722f, 0.98917650996478f,
+    0.98078528040323f, 0.97003125319454f, 0.95694033573221f, 0.94154406518302f,
+    0.92387953251129f, 0.90398929312344f, 0.88192126434836f, 0.85772861000027f,
+    0.83146961230255f, 0.80320753148064f, 0.77301045336274f, 0.74095112535496f,
+    0.70710678118655f, 0.67155895484702f, 0.63439328416365f, 0.59569930449243f,
+    0.5555702330196f, 0.51410274419322f, 0.471396736826f, 0.42755509343028f,
+    0.38268343236509f, 0.33688985339222f, 0.29028467725446f, 0.24298017990326f,
+    0.19509032201613f, 0.14673047445536f, 0.09801714032956f, 0.04906767432742f,
+    0.0f, -0.04906767432742f, -0.09801714032956f, -0.14673047445536f,
+    -0.19509032201613f, -0.24298017990326f, -0.29028467725446f,
+    -0.33688985339222f, -0.38268343236509f, -0.42755509343028f,
+    -0.471396736826f, -0.51410274419322f, -0.5555702330196f, -0.59569930449243f,
+    -0.63439328416365f, -0.67155895484702f, -0.70710678118655f,
+    -0.74095112535496f, -0.77301045336274f, -0.80320753148064f,
+    -0.83146961230255f, -0.85772861000027f, -0.88192126434835f,
+    -0.90398929312344f, -0.92387953251129f, -0.94154406518302f,
+    -0.95694033573221f, -0.97003125319454f, -0.98078528040323f,
+    -0.98917650996478f, -0.9951847266722f, -0.99879545620517f};
+
+// sin(2 * pi * k / 128).
+alignas(32) constexpr float kRealTwiddlesIm[64] = {
+    0.0f, 0.04906767432742f, 0.09801714032956f, 0.14673047445536f,
+    0.19509032201613f, 0.24298017990326f, 0.29028467725446f, 0.33688985339222f,
+    0.38268343236509f, 0.42755509343028f, 0.471396736826f, 0.51410274419322f,
+    0.5555702330196f, 0.59569930449243f, 0.63439328416365f, 0.67155895484702f,
+    0.70710678118655f, 0.74095112535496f, 0.77301045336274f, 0.80320753148064f,
+    0.83146961230255f, 0.85772861000027f, 0.88192126434835f, 0.90398929312344f,
+    0.92387953251129f, 0.94154406518302f, 0.95694033573221f, 0.97003125319454f,
+    0.98078528040323f, 0.98917650996478f, 0.9951847266722f, 0.99879545620517f,
+    1.0f, 0.99879545620517f, 0.9951847266722f, 0.98917650996478f,
+    0.98078528040323f, 0.97003125319454f, 0.95694033573221f, 0.94154406518302f,
+    0.92387953251129f, 0.90398929312344f, 0.88192126434836f, 0.85772861000027f,
+    0.83146961230255f, 0.80320753148064f, 0.77301045336274f, 0.74095112535496f,
+    0.70710678118655f, 0.67155895484702f, 0.63439328416365f, 0.59569930449243f,
+    0.5555702330196f, 0.51410274419322f, 0.471396736826f, 0.42755509343028f,
+    0.38268343236509f, 0.33688985339222f, 0.29028467725446f, 0.24298017990326f,
+    0.19509032201613f, 0.14673047445536f, 0.09801714032956f, 0.04906767432742f};
+
+// Complex-valued vectors of eight elements.
+struct ComplexVector {
+  __m256 re;
+  __m256 im;
+};
+
+ComplexVector Add(const ComplexVector& a, const ComplexVector& b) {
+  return {_mm256_add_ps(a.re, b.re), _mm256_add_ps(a.im, b.im)};
+}
+
+ComplexVector Sub(const ComplexVector& a, const ComplexVector& b) {
+  return {_mm256_sub_ps(a.re, b.re), _mm256_sub_ps(a.im, b.im)};
+}
+
+// Computes a * (w_re + i * w_im).
+ComplexVector Mul(const ComplexVector& a, __m256 w_re, __m256 w_im) {
+  return {_mm256_fmsub_ps(a.re, w_re, _mm256_mul_ps(a.im, w_im)),
+          _mm256_fmadd_ps(a.re, w_im, _mm256_mul_ps(a.im, w_re))};
+}
+
+// Computes a * i for the forward transform and a * -i for the inverse.
+template <bool kInverse>
+ComplexVector MulByI(const ComplexVector& a) {
+  const __m256 zero = _mm256_setzero_ps();
+  return kInverse ? ComplexVector{a.im, _mm256_sub_ps(zero, a.re)}
+                  : ComplexVector{_mm256_sub_ps(zero, a.im), a.re};
+}
+
+// Computes eight point DFTs over the vectors in `a`, in place and
+// independently for each lane.
+template <bool kInverse>
+void Dft8(ComplexVector* a) {
+  const __m256 kSqrtHalf = _mm256_set1_ps(0.70710678118655f);
+  ComplexVector b[4];
+  ComplexVector c[4];
+  for (int j = 0; j < 4; ++j) {
+    b[j] = Add(a[j], a[j + 4]);
+    c[j] = Sub(a[j], a[j + 4]);
+  }
+
+  // Multiplies c[j] by the twiddle factors exp(+-2 * pi * i * j / 8).
+  ComplexVector c1_i = MulByI<kInverse>(c[1]);
+  c[1] = {_mm256_mul_ps(_mm256_add_ps(c[1].re, c1_i.re), kSqrtHalf),
+          _mm256_mul_ps(_mm256_add_ps(c[1].im, c1_i.im), kSqrtHalf)};
+  c[2] = MulByI<kInverse>(c[2]);
+  ComplexVector c3_i = MulByI<kInverse>(c[3]);
+  c[3] = {_mm256_mul_ps(_mm256_sub_ps(c3_i.re, c[3].re), kSqrtHalf),
+          _mm256_mul_ps(_mm256_sub_ps(c3_i.im, c[3].im), kSqrtHalf)};
+
+  // Four point DFTs of the even and odd outputs.
+  for (int j = 0; j < 2; ++j) {
+    const ComplexVector* d = j == 0 ? b : c;
+    const ComplexVector e0 = Add(d[0], d[2]);
+    const ComplexVector e1 = Sub(d[0], d[2]);
+    const ComplexVector e2 = Add(d[1], d[3]);
+    const ComplexVector e3 = MulByI<kInverse>(Sub(d[1], d[3]));
+    a[j] = Add(e0, e2);
+    a[j + 2] = Add(e1, e3);
+    a[j + 4] = Sub(e0, e2);
+    a[j + 6] = Sub(e1, e3);
+  }
+}
+
+void Transpose8x8(__m256* r) {
+  const __m256 t0 = _mm256_unpacklo_ps(r[0], r[1]);
+  const __m256 t1 = _mm256_unpackhi_ps(r[0], r[1]);
+  const __m256 t2 = _mm256_unpacklo_ps(r[2], r[3]);
+  const __m256 t3 = _mm256_unpackhi_ps(r[2], r[3]);
+  const __m256 t4 = _mm256_unpacklo_ps(r[4], r[5]);
+  const __m256 t5 = _mm256_unpackhi_ps(r[4], r[5]);
+  const __m256 t6 = _mm256_unpacklo_ps(r[6], r[7]);
+  const __m256 t7 = _mm256_unpackhi_ps(r[6], r[7]);
+  const __m256 s0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+  const __m256 s1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+  const __m256 s2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+  const __m256 s3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+  const __m256 s4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0));
+  const __m256 s5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+  const __m256 s6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0));
+  const __m256 s7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+  r[0] = _mm256_permute2f128_ps(s0, s4, 0x20);
+  r[1] = _mm256_permute2f128_ps(s1, s5, 0x20);
+  r[2] = _mm256_permute2f128_ps(s2, s6, 0x20);
+  r[3] = _mm256_permute2f128_ps(s3, s7, 0x20);
+  r[4] = _mm256_permute2f128_ps(s0, s4, 0x31);
+  r[5] = _mm256_permute2f128_ps(s1, s5, 0x31);
+  r[6] = _mm256_permute2f128_ps(s2, s6, 0x31);
+  r[7] = _mm256_permute2f128_ps(s3, s7, 0x31);
+}
+
+// Computes the 64 point complex-valued DFT of the data in `a`, in place. Both
+// the input and output are in natural order, with element 8 * j + k in lane k
+// of `a[j]`.
+template <bool kInverse>
+void Fft64(ComplexVector* a) {
+  // Transforms over the columns.
+  Dft8<kInverse>(a);
+
+  // Twiddle factors.
+  for (int k = 0; k < 8; ++k) {
+    const __m256 w_re = _mm256_load_ps(&kTwiddlesRe[8 * k]);
+    const __m256 w_im = _mm256_load_ps(&kTwiddlesIm[8 * k]);
+    a[k] = Mul(a[k], w_re,
+               kInverse ? _mm256_sub_ps(_mm256_setzero_ps(), w_im) : w_im);
+  }
+
+  // Transforms over the rows.
+  __m256 re[8];
+  __m256 im[8];
+  for (int k = 0; k < 8; ++k) {
+    re[k] = a[k].re;
+    im[k] = a[k].im;
+  }
+  Transpose8x8(re);
+  Transpose8x8(im);
+  for (int k = 0; k < 8; ++k) {
+    a[k] = {re[k], im[k]};
+  }
+  Dft8<kInverse>(a);
+}
+
+// Reverses the order of the elements in `v`.
+__m256 Reverse(__m256 v) {
+  return _mm256_permutevar8x32_ps(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+}  // namespace
+
+void Aec3Fft::FftAvx2(const std::array<float, kFftLength>& x,
+                      FftData* X) const {
+  // Forms the complex-valued signal z[n] = x[2n] + i * x[2n + 1].
+  ComplexVector z[8];
+  for (int k = 0; k < 8; ++k) {
+    const __m256 x0 = _mm256_loadu_ps(&x[16 * k]);
+    const __m256 x1 = _mm256_loadu_ps(&x[16 * k + 8]);
+    const __m256 even = _mm256_shuffle_ps(x0, x1, _MM_SHUFFLE(2, 0, 2, 0));
+    const __m256 odd = _mm256_shuffle_ps(x0, x1, _MM_SHUFFLE(3, 1, 3, 1));
+    z[k].re = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(even),
+                                                     _MM_SHUFFLE(3, 1, 2, 0)));
+    z[k].im = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(odd),
+                                                     _MM_SHUFFLE(3, 1, 2, 0)));
+  }
+
+  Fft64</*kInverse=*/false>(z);
+
+  // Stores Z, with Z[64] = Z[0], to allow reading Z[64 - k] for all k.
+  alignas(32) float z_re[kFftLengthBy2 + 8];
+  alignas(32) float z_im[kFftLengthBy2 + 8];
+  for (int k = 0; k < 8; ++k) {
+    _mm256_store_ps(&z_re[8 * k], z[k].re);
+    _mm256_store_ps(&z_im[8 * k], z[k].im);
+  }
+  z_re[kFftLengthBy2] = z_re[0];
+  z_im[kFftLengthBy2] = z_im[0];
+
+  // Splits Z into the spectra of the even and odd samples, E and O, and forms
+  // X[k] = E[k] + exp(2 * pi * i * k / 128) * O[k], where
+  // 2 * E[k] = Z[k] + conj(Z[64 - k]) and
+  // 2 * i * O[k] = Z[k] - conj(Z[64 - k]).
+  const __m256 kHalf = _mm256_set1_ps(0.5f);
+  for (size_t k = 0; k < kFftLengthBy2; k += 8) {
+    const __m256 zr = _mm256_load_ps(&z_re[k]);
+    const __m256 zi = _mm256_load_ps(&z_im[k]);
+    const size_t k_rev = kFftLengthBy2 - 7 - k;
+    const __m256 zr_rev = Reverse(_mm256_loadu_ps(&z_re[k_rev]));
+    const __m256 zi_rev = Reverse(_mm256_loadu_ps(&z_im[k_rev]));
+    const __m256 e_re = _mm256_add_ps(zr, zr_rev);
+    const __m256 e_im = _mm256_sub_ps(zi, zi_rev);
+    const __m256 o_re = _mm256_add_ps(zi, zi_rev);
+    const __m256 o_im = _mm256_sub_ps(zr_rev, zr);
+    const __m256 w_re = _mm256_load_ps(&kRealTwiddlesRe[k]);
+    const __m256 w_im = _mm256_load_ps(&kRealTwiddlesIm[k]);
+    const __m256 wo_re = _mm256_fmsub_ps(w_re, o_re, _mm256_mul_ps(w_im, o_im));
+    const __m256 wo_im = _mm256_fmadd_ps(w_re, o_im, _mm256_mul_ps(w_im, o_re));
+    _mm256_storeu_ps(&X->re[k],
+                     _mm256_mul_ps(_mm256_add_ps(e_re, wo_re), kHalf));
+    _mm256_storeu_ps(&X->im[k],
+                     _mm256_mul_ps(_mm256_add_ps(e_im, wo_im), kHalf));
+  }
+  X->re[kFftLengthBy2] = z_re[0] - z_im[0];
+  X->im[0] = X->im[kFftLengthBy2] = 0.f;
+}
+
+void Aec3Fft::IfftAvx2(const FftData& X,
+                       std::array<float, kFftLength>* x) const {
+  // Forms Z[k] = E[k] + i * O[k], where 2 * E[k] = X[k] + conj(X[64 - k]) and
+  // 2 * O[k] = (X[k] - conj(X[64 - k])) * exp(-2 * pi * i * k / 128). The
+  // imaginary parts of X[0] and X[64] are treated as zero.
+  const __m256 kHalf = _mm256_set1_ps(0.5f);
+  ComplexVector z[8];
+  for (size_t k = 0; k < kFftLengthBy2; k += 8) {
+    const __m256 xr = _mm256_loadu_ps(&X.re[k]);
+    __m256 xi = _mm256_loadu_ps(&X.im[k]);
+    const size_t k_rev = kFftLengthBy2 - 7 - k;
+    const __m256 xr_rev = Reverse(_mm256_loadu_ps(&X.re[k_rev]));
+    __m256 xi_rev = Reverse(_mm256_loadu_ps(&X.im[k_rev]));
+    if (k == 0) {
+      xi = _mm256_blend_ps(xi, _mm256_setzero_ps(), 0x01);
+      xi_rev = _mm256_blend_ps(xi_rev, _mm256_setzero_ps(), 0x01);
+    }
+    const __m256 e_re = _mm256_add_ps(xr, xr_rev);
+    const __m256 e_im = _mm256_sub_ps(xi, xi_rev);
+    const __m256 d_re = _mm256_sub_ps(xr, xr_rev);
+    const __m256 d_im = _mm256_add_ps(xi, xi_rev);
+    const __m256 w_re = _mm256_load_ps(&kRealTwiddlesRe[k]);
+    const __m256 w_im = _mm256_load_ps(&kRealTwiddlesIm[k]);
+    const __m256 o_re = _mm256_fmadd_ps(d_re, w_re, _mm256_mul_ps(d_im, w_im));
+    const __m256 o_im = _mm256_fmsub_ps(d_im, w_re, _mm256_mul_ps(d_re, w_im));
+    z[k / 8].re = _mm256_mul_ps(_mm256_sub_ps(e_re, o_im), kHalf);
+    z[k / 8].im = _mm256_mul_ps(_mm256_add_ps(e_im, o_re), kHalf);
+  }
+
+  Fft64</*kInverse=*/true>(z);
+
+  // Interleaves the real and imaginary parts into the even and odd samples.
+  for (int k = 0; k < 8; ++k) {
+    const __m256 lo = _mm256_unpacklo_ps(z[k].re, z[k].im);
+    const __m256 hi = _mm256_unpackhi_ps(z[k].re, z[k].im);
+    _mm256_storeu_ps(&(*x)[16 * k], _mm256_permute2f128_ps(lo, hi, 0x20));
+    _mm256_storeu_ps(&(*x)[16 * k + 8], _mm256_permute2f128_ps(lo, hi, 0x31));
+  }
+}
+
+}  // namespace webrtc
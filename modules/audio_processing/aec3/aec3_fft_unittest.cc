@@ -11,7 +11,11 @@
 #include "modules/audio_processing/aec3/aec3_fft.h"
 
 #include <algorithm>
+#include <cmath>
 
+#include "rtc_base/random.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -210,4 +214,66 @@ TEST(Aec3Fft, PaddedFft) {
   }
 }
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Verifies that the AVX2 Fft and Ifft produce the same output as the Ooura
+// FFT, up to rounding errors.
+TEST(Aec3Fft, Avx2Optimizations) {
+  if (GetCPUInfo(kAVX2) != 0) {
+    Aec3Fft fft;
+    Aec3Fft fft_avx2(Aec3Optimization::kAvx2);
+    Random random(42);
+    FftData X;
+    FftData X_avx2;
+    std::array<float, kFftLength> x;
+    std::array<float, kFftLength> x_avx2;
+    for (int k = 0; k < 100; ++k) {
+      for (float& x_k : x) {
+        x_k = random.Gaussian(0.f, 1000.f);
+      }
+      x_avx2 = x;
+      fft.Fft(&x, &X);
+      fft_avx2.Fft(&x_avx2, &X_avx2);
+      for (size_t j = 0; j < kFftLengthBy2Plus1; ++j) {
+        EXPECT_NEAR(X.re[j], X_avx2.re[j], 0.1f);
+        EXPECT_NEAR(X.im[j], X_avx2.im[j], 0.1f);
+      }
+      EXPECT_EQ(0.f, X_avx2.im[0]);
+      EXPECT_EQ(0.f, X_avx2.im[kFftLengthBy2]);
+
+      // The imaginary parts of the DC and Nyquist bins must be ignored.
+      X.im[0] = X.im[kFftLengthBy2] = X_avx2.im[0] = X_avx2.im[kFftLengthBy2] =
+          random.Gaussian(0.f, 1000.f);
+      fft.Ifft(X, &x);
+      fft_avx2.Ifft(X_avx2, &x_avx2);
+      for (size_t j = 0; j < kFftLength; ++j) {
+        EXPECT_NEAR(x[j], x_avx2[j], 1.f);
+      }
+    }
+  }
+}
+
+// Verifies that the AVX2 Ifft inverts the AVX2 Fft.
+TEST(Aec3Fft, Avx2FftAndIfft) {
+  if (GetCPUInfo(kAVX2) != 0) {
+    Aec3Fft fft(Aec3Optimization::kAvx2);
+    FftData X;
+    std::array<float, kFftLength> x;
+    std::array<float, kFftLength> x_ref;
+
+    int v = 0;
+    for (int k = 0; k < 20; ++k) {
+      for (size_t j = 0; j < x.size(); ++j) {
+        x[j] = v++;
+        x_ref[j] = x[j] * 64.f;
+      }
+      fft.Fft(&x, &X);
+      fft.Ifft(X, &x);
+      for (size_t j = 0; j < x.size(); ++j) {
+        EXPECT_NEAR(x_ref[j], x[j], 0.001f * std::max(1.f, fabsf(x_ref[j])));
+      }
+    }
+  }
+}
+#endif
+
 }  // namespace webrtc
@@ -0,0 +1,144 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <array>
+
+#include "benchmark/benchmark.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "modules/audio_processing/aec3/aec3_fft.h"
+#include "modules/audio_processing/aec3/fft_data.h"
+#include "modules/audio_processing/aec3/suppressor_kernels.h"
+#include "rtc_base/random.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+
+namespace webrtc {
+namespace {
+
+using Spectrum = std::array<float, kFftLengthBy2Plus1>;
+
+// Returns false, and skips the benchmark, if the CPU lacks support for
+// `optimization`.
+bool IsSupported(benchmark::State& state, Aec3Optimization optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (optimization != Aec3Optimization::kAvx2 || GetCPUInfo(kAVX2) != 0) {
+    return true;
+  }
+#else
+  if (optimization == Aec3Optimization::kNone) {
+    return true;
+  }
+#endif
+  state.SkipWithError("Not supported by the CPU");
+  return false;
+}
+
+void FillRandom(Random* random, float min, float max, rtc::ArrayView<float> x) {
+  for (float& x_k : x) {
+    x_k = min + (max - min) * random->Rand<float>();
+  }
+}
+
+// Measures one forward and one inverse 128 point FFT, which is what one block
+// of the echo canceller computes per filter partition that is constrained.
+void BM_Aec3Fft(benchmark::State& state, Aec3Optimization optimization) {
+  if (!IsSupported(state, optimization)) {
+    return;
+  }
+  const Aec3Fft fft(optimization);
+  Random random(42);
+  std::array<float, kFftLength> x;
+  FillRandom(&random, -1000.f, 1000.f, x);
+  FftData X;
+  for (auto _ : state) {
+    fft.Fft(&x, &X);
+    fft.Ifft(X, &x);
+    benchmark::DoNotOptimize(x[0]);
+  }
+}
+
+BENCHMARK_CAPTURE(BM_Aec3Fft, Ooura, Aec3Optimization::kNone);
+BENCHMARK_CAPTURE(BM_Aec3Fft, Avx2, Aec3Optimization::kAvx2);
+
+// Measures the per-block and per-channel band computations of the suppression
+// gain and the residual echo estimate.
+void BM_SuppressorKernels(benchmark::State& state,
+                          Aec3Optimization optimization) {
+  if (!IsSupported(state, optimization)) {
+    return;
+  }
+  Random random(42);
+  Spectrum enr_transparent;
+  Spectrum enr_suppress;
+  Spectrum emr_transparent;
+  Spectrum nearend;
+  Spectrum echo;
+  Spectrum masker;
+  Spectrum S2_linear;
+  Spectrum erle;
+  FillRandom(&random, 0.3f, 0.4f, enr_transparent);
+  FillRandom(&random, 0.4f, 1.1f, enr_suppress);
+  FillRandom(&random, 0.3f, 0.4f, emr_transparent);
+  FillRandom(&random, 0.f, 1e6f, nearend);
+  FillRandom(&random, 0.f, 1e6f, echo);
+  FillRandom(&random, 0.f, 1e4f, masker);
+  FillRandom(&random, 0.f, 1e6f, S2_linear);
+  FillRandom(&random, 1.f, 4.f, erle);
+  Spectrum gain;
+  Spectrum min_gain;
+  Spectrum R2;
+  for (auto _ : state) {
+    ComputeLinearResidualEcho(optimization, S2_linear, erle, R2);
+    ComputeMinGain(optimization, 1000.f, R2, min_gain);
+    ComputeGainToNoAudibleEcho(optimization, enr_transparent, enr_suppress,
+                               emr_transparent, nearend, R2, masker, gain);
+    benchmark::DoNotOptimize(gain[0]);
+    benchmark::DoNotOptimize(min_gain[0]);
+  }
+}
+
+BENCHMARK_CAPTURE(BM_SuppressorKernels, Scalar, Aec3Optimization::kNone);
+BENCHMARK_CAPTURE(BM_SuppressorKernels, Avx2, Aec3Optimization::kAvx2);
+
+// Measures the per-channel update of the three ERLE estimates.
+void BM_UpdateErleBands(benchmark::State& state,
+                        Aec3Optimization optimization) {
+  if (!IsSupported(state, optimization)) {
+    return;
+  }
+  Random random(42);
+  Spectrum new_erle;
+  Spectrum max_erle;
+  std::array<bool, kFftLengthBy2Plus1> is_erle_updated;
+  std::array<bool, kFftLengthBy2Plus1> low_render_energy;
+  FillRandom(&random, 1.f, 8.f, new_erle);
+  max_erle.fill(4.f);
+  for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
+    is_erle_updated[k] = random.Rand<float>() < 0.9f;
+    low_render_energy[k] = random.Rand<float>() < 0.2f;
+  }
+  std::array<Spectrum, 3> erle;
+  for (Spectrum& erle_j : erle) {
+    erle_j.fill(1.f);
+  }
+  for (auto _ : state) {
+    for (Spectrum& erle_j : erle) {
+      UpdateErleBands(optimization, new_erle, is_erle_updated,
+                      low_render_energy, /*min_erle=*/1.f, max_erle, erle_j);
+    }
+    benchmark::DoNotOptimize(erle[0][0]);
+  }
+}
+
+BENCHMARK_CAPTURE(BM_UpdateErleBands, Scalar, Aec3Optimization::kNone);
+BENCHMARK_CAPTURE(BM_UpdateErleBands, Avx2, Aec3Optimization::kAvx2);
+
+}  // namespace
+}  // namespace webrtc
@@ -144,9 +144,9 @@ class EchoRemoverImpl final : public EchoRemover {
 
   static std::atomic<int> instance_count_;
   const EchoCanceller3Config config_;
-  const Aec3Fft fft_;
   std::unique_ptr<ApmDataDumper> data_dumper_;
   const Aec3Optimization optimization_;
+  const Aec3Fft fft_;
   const int sample_rate_hz_;
   const size_t num_render_channels_;
   const size_t num_capture_channels_;
@@ -187,9 +187,9 @@ EchoRemoverImpl::EchoRemoverImpl(const EchoCanceller3Config& config,
                                  size_t num_render_channels,
                                  size_t num_capture_channels)
     : config_(config),
-      fft_(),
       data_dumper_(new ApmDataDumper(instance_count_.fetch_add(1) + 1)),
       optimization_(DetectOptimization()),
+      fft_(optimization_),
       sample_rate_hz_(sample_rate_hz),
       num_render_channels_(num_render_channels),
       num_capture_channels_(num_capture_channels),
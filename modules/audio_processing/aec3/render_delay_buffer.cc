@@ -151,7 +151,7 @@ RenderDelayBufferImpl::RenderDelayBufferImpl(const EchoCanceller3Config& config,
                                          config.delay.num_filters)),
       render_mixer_(num_render_channels, config.delay.render_alignment_mixing),
       render_decimator_(down_sampling_factor_),
-      fft_(),
+      fft_(optimization_),
       render_ds_(sub_block_size_, 0.f),
       buffer_headroom_(config.filter.refined.length_blocks) {
   RTC_DCHECK_EQ(blocks_.buffer.size(), ffts_.buffer.size());
@@ -17,6 +17,7 @@
 
 #include "api/array_view.h"
 #include "modules/audio_processing/aec3/reverb_model.h"
+#include "modules/audio_processing/aec3/suppressor_kernels.h"
 #include "rtc_base/checks.h"
 #include "system_wrappers/include/field_trial.h"
 
@@ -76,6 +77,7 @@ void GetRenderIndexesToAnalyze(
 // Estimates the residual echo power based on the echo return loss enhancement
 // (ERLE) and the linear power estimate.
 void LinearEstimate(
+    Aec3Optimization optimization,
     rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> S2_linear,
     rtc::ArrayView<const std::array<float, kFftLengthBy2Plus1>> erle,
     rtc::ArrayView<std::array<float, kFftLengthBy2Plus1>> R2) {
@@ -84,10 +86,7 @@ void LinearEstimate(
 
   const size_t num_capture_channels = R2.size();
   for (size_t ch = 0; ch < num_capture_channels; ++ch) {
-    for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
-      RTC_DCHECK_LT(0.f, erle[ch][k]);
-      R2[ch][k] = S2_linear[ch][k] / erle[ch][k];
-    }
+    ComputeLinearResidualEcho(optimization, S2_linear[ch], erle[ch], R2[ch]);
   }
 }
 
@@ -157,6 +156,7 @@ void EchoGeneratingPower(size_t num_render_channels,
 ResidualEchoEstimator::ResidualEchoEstimator(const EchoCanceller3Config& config,
                                              size_t num_render_channels)
     : config_(config),
+      optimization_(DetectOptimization()),
       num_render_channels_(num_render_channels),
       early_reflections_transparent_mode_gain_(GetTransparentModeGain()),
       late_reflections_transparent_mode_gain_(GetTransparentModeGain()),
@@ -199,8 +199,10 @@ void ResidualEchoEstimator::Estimate(
     } else {
       const bool onset_compensated =
           erle_onset_compensation_in_dominant_nearend_ || !dominant_nearend;
-      LinearEstimate(S2_linear, aec_state.Erle(onset_compensated), R2);
-      LinearEstimate(S2_linear, aec_state.ErleUnbounded(), R2_unbounded);
+      LinearEstimate(optimization_, S2_linear,
+                     aec_state.Erle(onset_compensated), R2);
+      LinearEstimate(optimization_, S2_linear, aec_state.ErleUnbounded(),
+                     R2_unbounded);
     }
 
     UpdateReverb(ReverbType::kLinear, aec_state, render_buffer,
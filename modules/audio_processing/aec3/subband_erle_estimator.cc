@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <functional>
 
+#include "modules/audio_processing/aec3/suppressor_kernels.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/numerics/safe_minmax.h"
 #include "system_wrappers/include/field_trial.h"
@@ -25,6 +26,8 @@ constexpr float kX2BandEnergyThreshold = 44015068.0f;
 constexpr int kBlocksToHoldErle = 100;
 constexpr int kBlocksForOnsetDetection = kBlocksToHoldErle + 150;
 constexpr int kPointsToAccumulate = 6;
+// Upper limit of the virtually unbounded ERLE.
+constexpr float kUnboundedErleMax = 100000.0f;
 
 std::array<float, kFftLengthBy2Plus1> SetMaxErleBands(float max_erle_l,
                                                       float max_erle_h) {
@@ -45,6 +48,9 @@ SubbandErleEstimator::SubbandErleEstimator(const EchoCanceller3Config& config,
     : use_onset_detection_(config.erle.onset_detection),
       min_erle_(config.erle.min),
       max_erle_(SetMaxErleBands(config.erle.max_l, config.erle.max_h)),
+      max_erle_unbounded_(
+          SetMaxErleBands(kUnboundedErleMax, kUnboundedErleMax)),
+      optimization_(DetectOptimization()),
       use_min_erle_during_onsets_(EnableMinErleDuringOnsets()),
       accum_spectra_(num_capture_channels),
       erle_(num_capture_channels),
@@ -121,6 +127,7 @@ void SubbandErleEstimator::UpdateBands(
 
     std::array<float, kFftLengthBy2> new_erle;
     std::array<bool, kFftLengthBy2> is_erle_updated;
+    new_erle.fill(0.f);
     is_erle_updated.fill(false);
 
     for (size_t k = 1; k < kFftLengthBy2; ++k) {
@@ -149,33 +156,27 @@ void SubbandErleEstimator::UpdateBands(
       }
     }
 
-    auto update_erle_band = [](float& erle, float new_erle,
-                               bool low_render_energy, float min_erle,
-                               float max_erle) {
-      float alpha = 0.05f;
-      if (new_erle < erle) {
-        alpha = low_render_energy ? 0.f : 0.1f;
-      }
-      erle =
-          rtc::SafeClamp(erle + alpha * (new_erle - erle), min_erle, max_erle);
-    };
-
-    for (size_t k = 1; k < kFftLengthBy2; ++k) {
-      if (is_erle_updated[k]) {
-        const bool low_render_energy = accum_spectra_.low_render_energy[ch][k];
-        update_erle_band(erle_[ch][k], new_erle[k], low_render_energy,
-                         min_erle_, max_erle_[k]);
-        if (use_onset_detection_) {
-          update_erle_band(erle_onset_compensated_[ch][k], new_erle[k],
-                           low_render_energy, min_erle_, max_erle_[k]);
-        }
-
-        // Virtually unbounded ERLE.
-        constexpr float kUnboundedErleMax = 100000.0f;
-        update_erle_band(erle_unbounded_[ch][k], new_erle[k], low_render_energy,
-                         min_erle_, kUnboundedErleMax);
-      }
+    // The ERLE is updated in bands 1 to kFftLengthBy2 - 1.
+    constexpr size_t kNumBands = kFftLengthBy2 - 1;
+    const rtc::ArrayView<const float> new_erle_bands(&new_erle[1], kNumBands);
+    const rtc::ArrayView<const bool> is_erle_updated_bands(&is_erle_updated[1],
+                                                           kNumBands);
+    const rtc::ArrayView<const bool> low_render_energy_bands(
+        &accum_spectra_.low_render_energy[ch][1], kNumBands);
+    const auto update_erle_bands =
+        [&](const std::array<float, kFftLengthBy2Plus1>& max_erle,
+            std::array<float, kFftLengthBy2Plus1>* erle) {
+          UpdateErleBands(optimization_, new_erle_bands, is_erle_updated_bands,
+                          low_render_energy_bands, min_erle_,
+                          rtc::ArrayView<const float>(&max_erle[1], kNumBands),
+                          rtc::ArrayView<float>(&(*erle)[1], kNumBands));
+        };
+
+    update_erle_bands(max_erle_, &erle_[ch]);
+    if (use_onset_detection_) {
+      update_erle_bands(max_erle_, &erle_onset_compensated_[ch]);
     }
+    update_erle_bands(max_erle_unbounded_, &erle_unbounded_[ch]);
   }
 }
 
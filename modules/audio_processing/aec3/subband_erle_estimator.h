@@ -88,6 +88,8 @@ class SubbandErleEstimator {
   const bool use_onset_detection_;
   const float min_erle_;
   const std::array<float, kFftLengthBy2Plus1> max_erle_;
+  const std::array<float, kFftLengthBy2Plus1> max_erle_unbounded_;
+  const Aec3Optimization optimization_;
   const bool use_min_erle_during_onsets_;
   AccumulatedSpectra accum_spectra_;
   // ERLE without special handling of render onsets.
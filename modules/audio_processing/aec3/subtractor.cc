@@ -67,7 +67,7 @@ Subtractor::Subtractor(const EchoCanceller3Config& config,
                        size_t num_capture_channels,
                        ApmDataDumper* data_dumper,
                        Aec3Optimization optimization)
-    : fft_(),
+    : fft_(optimization),
       data_dumper_(data_dumper),
       optimization_(optimization),
       config_(config),
@@ -66,7 +66,7 @@ SuppressionFilter::SuppressionFilter(Aec3Optimization optimization,
     : optimization_(optimization),
       sample_rate_hz_(sample_rate_hz),
       num_capture_channels_(num_capture_channels),
-      fft_(),
+      fft_(optimization_),
       e_output_old_(NumBandsForRate(sample_rate_hz_),
                     std::vector<std::array<float, kFftLengthBy2>>(
                         num_capture_channels_)) {
@@ -19,6 +19,7 @@
 #include "modules/audio_processing/aec3/dominant_nearend_detector.h"
 #include "modules/audio_processing/aec3/moving_average.h"
 #include "modules/audio_processing/aec3/subband_nearend_detector.h"
+#include "modules/audio_processing/aec3/suppressor_kernels.h"
 #include "modules/audio_processing/aec3/vector_math.h"
 #include "modules/audio_processing/logging/apm_data_dumper.h"
 #include "rtc_base/checks.h"
@@ -197,17 +198,9 @@ void SuppressionGain::GainToNoAudibleEcho(
     std::array<float, kFftLengthBy2Plus1>* gain) const {
   const auto& p = dominant_nearend_detector_->IsNearendState() ? nearend_params_
                                                                : normal_params_;
-  for (size_t k = 0; k < gain->size(); ++k) {
-    float enr = echo[k] / (nearend[k] + 1.f);  // Echo-to-nearend ratio.
-    float emr = echo[k] / (masker[k] + 1.f);   // Echo-to-masker (noise) ratio.
-    float g = 1.0f;
-    if (enr > p.enr_transparent_[k] && emr > p.emr_transparent_[k]) {
-      g = (p.enr_suppress_[k] - enr) /
-          (p.enr_suppress_[k] - p.enr_transparent_[k]);
-      g = std::max(g, p.emr_transparent_[k] / emr);
-    }
-    (*gain)[k] = g;
-  }
+  ComputeGainToNoAudibleEcho(optimization_, p.enr_transparent_,
+                             p.enr_suppress_, p.emr_transparent_, nearend,
+                             echo, masker, *gain);
 }
 
 // Compute the minimum gain as the attenuating gain to put the signal just
@@ -224,12 +217,8 @@ void SuppressionGain::GetMinGain(
         low_noise_render ? config_.echo_audibility.low_render_limit
                          : config_.echo_audibility.normal_render_limit;
 
-    for (size_t k = 0; k < min_gain.size(); ++k) {
-      min_gain[k] = weighted_residual_echo[k] > 0.f
-                        ? min_echo_power / weighted_residual_echo[k]
-                        : 1.f;
-      min_gain[k] = std::min(min_gain[k], 1.f);
-    }
+    ComputeMinGain(optimization_, min_echo_power, weighted_residual_echo,
+                   min_gain);
 
     if (!initial_state_ ||
         config_.suppressor.lf_smoothing_during_initial_phase) {
@@ -0,0 +1,163 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/suppressor_kernels.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/numerics/safe_minmax.h"
+
+namespace webrtc {
+namespace aec3 {
+
+void GainToNoAudibleEcho(rtc::ArrayView<const float> enr_transparent,
+                         rtc::ArrayView<const float> enr_suppress,
+                         rtc::ArrayView<const float> emr_transparent,
+                         rtc::ArrayView<const float> nearend,
+                         rtc::ArrayView<const float> echo,
+                         rtc::ArrayView<const float> masker,
+                         rtc::ArrayView<float> gain) {
+  for (size_t k = 0; k < gain.size(); ++k) {
+    float enr = echo[k] / (nearend[k] + 1.f);  // Echo-to-nearend ratio.
+    float emr = echo[k] / (masker[k] + 1.f);   // Echo-to-masker (noise) ratio.
+    float g = 1.0f;
+    if (enr > enr_transparent[k] && emr > emr_transparent[k]) {
+      g = (enr_suppress[k] - enr) / (enr_suppress[k] - enr_transparent[k]);
+      g = std::max(g, emr_transparent[k] / emr);
+    }
+    gain[k] = g;
+  }
+}
+
+void MinGain(float min_echo_power,
+             rtc::ArrayView<const float> echo,
+             rtc::ArrayView<float> min_gain) {
+  for (size_t k = 0; k < min_gain.size(); ++k) {
+    min_gain[k] = echo[k] > 0.f ? min_echo_power / echo[k] : 1.f;
+    min_gain[k] = std::min(min_gain[k], 1.f);
+  }
+}
+
+void LinearResidualEcho(rtc::ArrayView<const float> S2_linear,
+                        rtc::ArrayView<const float> erle,
+                        rtc::ArrayView<float> R2) {
+  for (size_t k = 0; k < R2.size(); ++k) {
+    RTC_DCHECK_LT(0.f, erle[k]);
+    R2[k] = S2_linear[k] / erle[k];
+  }
+}
+
+void UpdateErle(rtc::ArrayView<const float> new_erle,
+                rtc::ArrayView<const bool> is_erle_updated,
+                rtc::ArrayView<const bool> low_render_energy,
+                float min_erle,
+                rtc::ArrayView<const float> max_erle,
+                rtc::ArrayView<float> erle) {
+  for (size_t k = 0; k < erle.size(); ++k) {
+    if (is_erle_updated[k]) {
+      float alpha = 0.05f;
+      if (new_erle[k] < erle[k]) {
+        alpha = low_render_energy[k] ? 0.f : 0.1f;
+      }
+      erle[k] = rtc::SafeClamp(erle[k] + alpha * (new_erle[k] - erle[k]),
+                               min_erle, max_erle[k]);
+    }
+  }
+}
+
+}  // namespace aec3
+
+void ComputeGainToNoAudibleEcho(Aec3Optimization optimization,
+                                rtc::ArrayView<const float> enr_transparent,
+                                rtc::ArrayView<const float> enr_suppress,
+                                rtc::ArrayView<const float> emr_transparent,
+                                rtc::ArrayView<const float> nearend,
+                                rtc::ArrayView<const float> echo,
+                                rtc::ArrayView<const float> masker,
+                                rtc::ArrayView<float> gain) {
+  RTC_DCHECK_EQ(gain.size(), enr_transparent.size());
+  RTC_DCHECK_EQ(gain.size(), enr_suppress.size());
+  RTC_DCHECK_EQ(gain.size(), emr_transparent.size());
+  RTC_DCHECK_EQ(gain.size(), nearend.size());
+  RTC_DCHECK_EQ(gain.size(), echo.size());
+  RTC_DCHECK_EQ(gain.size(), masker.size());
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    case Aec3Optimization::kAvx2:
+      aec3::GainToNoAudibleEcho_Avx2(enr_transparent, enr_suppress,
+                                     emr_transparent, nearend, echo, masker,
+                                     gain);
+      break;
+#endif
+    default:
+      aec3::GainToNoAudibleEcho(enr_transparent, enr_suppress, emr_transparent,
+                                nearend, echo, masker, gain);
+  }
+}
+
+void ComputeMinGain(Aec3Optimization optimization,
+                    float min_echo_power,
+                    rtc::ArrayView<const float> echo,
+                    rtc::ArrayView<float> min_gain) {
+  RTC_DCHECK_EQ(min_gain.size(), echo.size());
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    case Aec3Optimization::kAvx2:
+      aec3::MinGain_Avx2(min_echo_power, echo, min_gain);
+      break;
+#endif
+    default:
+      aec3::MinGain(min_echo_power, echo, min_gain);
+  }
+}
+
+void ComputeLinearResidualEcho(Aec3Optimization optimization,
+                               rtc::ArrayView<const float> S2_linear,
+                               rtc::ArrayView<const float> erle,
+                               rtc::ArrayView<float> R2) {
+  RTC_DCHECK_EQ(R2.size(), S2_linear.size());
+  RTC_DCHECK_EQ(R2.size(), erle.size());
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    case Aec3Optimization::kAvx2:
+      aec3::LinearResidualEcho_Avx2(S2_linear, erle, R2);
+      break;
+#endif
+    default:
+      aec3::LinearResidualEcho(S2_linear, erle, R2);
+  }
+}
+
+void UpdateErleBands(Aec3Optimization optimization,
+                     rtc::ArrayView<const float> new_erle,
+                     rtc::ArrayView<const bool> is_erle_updated,
+                     rtc::ArrayView<const bool> low_render_energy,
+                     float min_erle,
+                     rtc::ArrayView<const float> max_erle,
+                     rtc::ArrayView<float> erle) {
+  RTC_DCHECK_EQ(erle.size(), new_erle.size());
+  RTC_DCHECK_EQ(erle.size(), is_erle_updated.size());
+  RTC_DCHECK_EQ(erle.size(), low_render_energy.size());
+  RTC_DCHECK_EQ(erle.size(), max_erle.size());
+  switch (optimization) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    case Aec3Optimization::kAvx2:
+      aec3::UpdateErle_Avx2(new_erle, is_erle_updated, low_render_energy,
+                            min_erle, max_erle, erle);
+      break;
+#endif
+    default:
+      aec3::UpdateErle(new_erle, is_erle_updated, low_render_energy, min_erle,
+                       max_erle, erle);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,112 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_AUDIO_PROCESSING_AEC3_SUPPRESSOR_KERNELS_H_
+#define MODULES_AUDIO_PROCESSING_AEC3_SUPPRESSOR_KERNELS_H_
+
+#include "api/array_view.h"
+#include "modules/audio_processing/aec3/aec3_common.h"
+#include "rtc_base/system/arch.h"
+
+namespace webrtc {
+namespace aec3 {
+
+// Computes the gain that reduces the echo to a non audible level, given the
+// echo-to-nearend ratio limits for transparency and for suppression and the
+// echo-to-masker ratio limit for transparency of each band.
+void GainToNoAudibleEcho(rtc::ArrayView<const float> enr_transparent,
+                         rtc::ArrayView<const float> enr_suppress,
+                         rtc::ArrayView<const float> emr_transparent,
+                         rtc::ArrayView<const float> nearend,
+                         rtc::ArrayView<const float> echo,
+                         rtc::ArrayView<const float> masker,
+                         rtc::ArrayView<float> gain);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void GainToNoAudibleEcho_Avx2(rtc::ArrayView<const float> enr_transparent,
+                              rtc::ArrayView<const float> enr_suppress,
+                              rtc::ArrayView<const float> emr_transparent,
+                              rtc::ArrayView<const float> nearend,
+                              rtc::ArrayView<const float> echo,
+                              rtc::ArrayView<const float> masker,
+                              rtc::ArrayView<float> gain);
+#endif
+
+// Computes the gain that attenuates the echo down to `min_echo_power`, limited
+// to at most one.
+void MinGain(float min_echo_power,
+             rtc::ArrayView<const float> echo,
+             rtc::ArrayView<float> min_gain);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void MinGain_Avx2(float min_echo_power,
+                  rtc::ArrayView<const float> echo,
+                  rtc::ArrayView<float> min_gain);
+#endif
+
+// Computes the residual echo power from the linear echo estimate and the ERLE.
+void LinearResidualEcho(rtc::ArrayView<const float> S2_linear,
+                        rtc::ArrayView<const float> erle,
+                        rtc::ArrayView<float> R2);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void LinearResidualEcho_Avx2(rtc::ArrayView<const float> S2_linear,
+                             rtc::ArrayView<const float> erle,
+                             rtc::ArrayView<float> R2);
+#endif
+
+// Smooths `erle` towards `new_erle` in the bands where `is_erle_updated` is
+// set, with slower decreases in bands with low render energy, and limits the
+// result to [`min_erle`, `max_erle`].
+void UpdateErle(rtc::ArrayView<const float> new_erle,
+                rtc::ArrayView<const bool> is_erle_updated,
+                rtc::ArrayView<const bool> low_render_energy,
+                float min_erle,
+                rtc::ArrayView<const float> max_erle,
+                rtc::ArrayView<float> erle);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void UpdateErle_Avx2(rtc::ArrayView<const float> new_erle,
+                     rtc::ArrayView<const bool> is_erle_updated,
+                     rtc::ArrayView<const bool> low_render_energy,
+                     float min_erle,
+                     rtc::ArrayView<const float> max_erle,
+                     rtc::ArrayView<float> erle);
+#endif
+
+}  // namespace aec3
+
+// Dispatchers to the implementations above.
+void ComputeGainToNoAudibleEcho(Aec3Optimization optimization,
+                                rtc::ArrayView<const float> enr_transparent,
+                                rtc::ArrayView<const float> enr_suppress,
+                                rtc::ArrayView<const float> emr_transparent,
+                                rtc::ArrayView<const float> nearend,
+                                rtc::ArrayView<const float> echo,
+                                rtc::ArrayView<const float> masker,
+                                rtc::ArrayView<float> gain);
+
+void ComputeMinGain(Aec3Optimization optimization,
+                    float min_echo_power,
+                    rtc::ArrayView<const float> echo,
+                    rtc::ArrayView<float> min_gain);
+
+void ComputeLinearResidualEcho(Aec3Optimization optimization,
+                               rtc::ArrayView<const float> S2_linear,
+                               rtc::ArrayView<const float> erle,
+                               rtc::ArrayView<float> R2);
+
+void UpdateErleBands(Aec3Optimization optimization,
+                     rtc::ArrayView<const float> new_erle,
+                     rtc::ArrayView<const bool> is_erle_updated,
+                     rtc::ArrayView<const bool> low_render_energy,
+                     float min_erle,
+                     rtc::ArrayView<const float> max_erle,
+                     rtc::ArrayView<float> erle);
+
+}  // namespace webrtc
+
+#endif  // MODULES_AUDIO_PROCESSING_AEC3_SUPPRESSOR_KERNELS_H_
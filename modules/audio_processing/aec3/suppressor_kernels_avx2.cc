@@ -0,0 +1,153 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include <algorithm>
+
+#include "modules/audio_processing/aec3/suppressor_kernels.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace aec3 {
+
+namespace {
+
+// Returns a mask with the lanes set for which the eight booleans starting at
+// `b` are true.
+__m256 LoadBoolMask(const bool* b) {
+  const __m128i bytes = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(b));
+  const __m256i words = _mm256_cvtepu8_epi32(bytes);
+  return _mm256_castsi256_ps(
+      _mm256_cmpgt_epi32(words, _mm256_setzero_si256()));
+}
+
+}  // namespace
+
+void GainToNoAudibleEcho_Avx2(rtc::ArrayView<const float> enr_transparent,
+                              rtc::ArrayView<const float> enr_suppress,
+                              rtc::ArrayView<const float> emr_transparent,
+                              rtc::ArrayView<const float> nearend,
+                              rtc::ArrayView<const float> echo,
+                              rtc::ArrayView<const float> masker,
+                              rtc::ArrayView<float> gain) {
+  const size_t num_bands = gain.size();
+  const size_t vector_limit = num_bands - num_bands % 8;
+  const __m256 one = _mm256_set1_ps(1.f);
+  size_t k = 0;
+  for (; k < vector_limit; k += 8) {
+    const __m256 echo_k = _mm256_loadu_ps(&echo[k]);
+    const __m256 enr = _mm256_div_ps(
+        echo_k, _mm256_add_ps(_mm256_loadu_ps(&nearend[k]), one));
+    const __m256 emr = _mm256_div_ps(
+        echo_k, _mm256_add_ps(_mm256_loadu_ps(&masker[k]), one));
+    const __m256 enr_transparent_k = _mm256_loadu_ps(&enr_transparent[k]);
+    const __m256 enr_suppress_k = _mm256_loadu_ps(&enr_suppress[k]);
+    const __m256 emr_transparent_k = _mm256_loadu_ps(&emr_transparent[k]);
+    __m256 g = _mm256_div_ps(_mm256_sub_ps(enr_suppress_k, enr),
+                             _mm256_sub_ps(enr_suppress_k, enr_transparent_k));
+    g = _mm256_max_ps(_mm256_div_ps(emr_transparent_k, emr), g);
+    const __m256 suppress =
+        _mm256_and_ps(_mm256_cmp_ps(enr, enr_transparent_k, _CMP_GT_OQ),
+                      _mm256_cmp_ps(emr, emr_transparent_k, _CMP_GT_OQ));
+    _mm256_storeu_ps(&gain[k], _mm256_blendv_ps(one, g, suppress));
+  }
+  for (; k < num_bands; ++k) {
+    const float enr = echo[k] / (nearend[k] + 1.f);
+    const float emr = echo[k] / (masker[k] + 1.f);
+    float g = 1.0f;
+    if (enr > enr_transparent[k] && emr > emr_transparent[k]) {
+      g = (enr_suppress[k] - enr) / (enr_suppress[k] - enr_transparent[k]);
+      g = std::max(g, emr_transparent[k] / emr);
+    }
+    gain[k] = g;
+  }
+}
+
+void MinGain_Avx2(float min_echo_power,
+                  rtc::ArrayView<const float> echo,
+                  rtc::ArrayView<float> min_gain) {
+  const size_t num_bands = min_gain.size();
+  const size_t vector_limit = num_bands - num_bands % 8;
+  const __m256 one = _mm256_set1_ps(1.f);
+  const __m256 min_echo_power_v = _mm256_set1_ps(min_echo_power);
+  size_t k = 0;
+  for (; k < vector_limit; k += 8) {
+    const __m256 echo_k = _mm256_loadu_ps(&echo[k]);
+    const __m256 g = _mm256_div_ps(min_echo_power_v, echo_k);
+    const __m256 positive =
+        _mm256_cmp_ps(echo_k, _mm256_setzero_ps(), _CMP_GT_OQ);
+    _mm256_storeu_ps(&min_gain[k],
+                     _mm256_min_ps(_mm256_blendv_ps(one, g, positive), one));
+  }
+  for (; k < num_bands; ++k) {
+    min_gain[k] = echo[k] > 0.f ? min_echo_power / echo[k] : 1.f;
+    min_gain[k] = std::min(min_gain[k], 1.f);
+  }
+}
+
+void LinearResidualEcho_Avx2(rtc::ArrayView<const float> S2_linear,
+                             rtc::ArrayView<const float> erle,
+                             rtc::ArrayView<float> R2) {
+  const size_t num_bands = R2.size();
+  const size_t vector_limit = num_bands - num_bands % 8;
+  size_t k = 0;
+  for (; k < vector_limit; k += 8) {
+    _mm256_storeu_ps(&R2[k], _mm256_div_ps(_mm256_loadu_ps(&S2_linear[k]),
+                                           _mm256_loadu_ps(&erle[k])));
+  }
+  for (; k < num_bands; ++k) {
+    RTC_DCHECK_LT(0.f, erle[k]);
+    R2[k] = S2_linear[k] / erle[k];
+  }
+}
+
+void UpdateErle_Avx2(rtc::ArrayView<const float> new_erle,
+                     rtc::ArrayView<const bool> is_erle_updated,
+                     rtc::ArrayView<const bool> low_render_energy,
+                     float min_erle,
+                     rtc::ArrayView<const float> max_erle,
+                     rtc::ArrayView<float> erle) {
+  const size_t num_bands = erle.size();
+  const size_t vector_limit = num_bands - num_bands % 8;
+  const __m256 min_erle_v = _mm256_set1_ps(min_erle);
+  const __m256 alpha_increase = _mm256_set1_ps(0.05f);
+  const __m256 alpha_decrease = _mm256_set1_ps(0.1f);
+  size_t k = 0;
+  for (; k < vector_limit; k += 8) {
+    const __m256 updated = LoadBoolMask(&is_erle_updated[k]);
+    const __m256 low_render = LoadBoolMask(&low_render_energy[k]);
+    const __m256 erle_k = _mm256_loadu_ps(&erle[k]);
+    const __m256 new_erle_k = _mm256_loadu_ps(&new_erle[k]);
+    const __m256 decrease = _mm256_cmp_ps(new_erle_k, erle_k, _CMP_LT_OQ);
+    const __m256 alpha = _mm256_blendv_ps(
+        alpha_increase, _mm256_andnot_ps(low_render, alpha_decrease),
+        decrease);
+    __m256 smoothed =
+        _mm256_fmadd_ps(alpha, _mm256_sub_ps(new_erle_k, erle_k), erle_k);
+    smoothed = _mm256_min_ps(_mm256_max_ps(smoothed, min_erle_v),
+                             _mm256_loadu_ps(&max_erle[k]));
+    _mm256_storeu_ps(&erle[k], _mm256_blendv_ps(erle_k, smoothed, updated));
+  }
+  for (; k < num_bands; ++k) {
+    if (is_erle_updated[k]) {
+      float alpha = 0.05f;
+      if (new_erle[k] < erle[k]) {
+        alpha = low_render_energy[k] ? 0.f : 0.1f;
+      }
+      erle[k] = std::min(
+          std::max(erle[k] + alpha * (new_erle[k] - erle[k]), min_erle),
+          max_erle[k]);
+    }
+  }
+}
+
+}  // namespace aec3
+}  // namespace webrtc
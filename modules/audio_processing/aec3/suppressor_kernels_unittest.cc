@@ -0,0 +1,155 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/aec3/suppressor_kernels.h"
+
+#include <array>
+#include <cmath>
+
+#include "rtc_base/random.h"
+#include "rtc_base/system/arch.h"
+#include "system_wrappers/include/cpu_features_wrapper.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace aec3 {
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+namespace {
+
+constexpr int kNumRuns = 100;
+
+// Fills `x` with powers in [0, 10^(2 * `max_exponent`)), with a fraction of
+// zeros.
+void FillPowers(Random* random, float max_exponent, rtc::ArrayView<float> x) {
+  for (float& x_k : x) {
+    const float amplitude =
+        random->Rand<float>() < 0.1f
+            ? 0.f
+            : powf(10.f, max_exponent * random->Rand<float>());
+    x_k = amplitude * amplitude;
+  }
+}
+
+}  // namespace
+
+// Verifies that the AVX2 gain computation is bitexact to the reference.
+TEST(SuppressorKernels, GainToNoAudibleEchoAvx2Optimization) {
+  if (GetCPUInfo(kAVX2) != 0) {
+    Random random(42);
+    std::array<float, kFftLengthBy2Plus1> enr_transparent;
+    std::array<float, kFftLengthBy2Plus1> enr_suppress;
+    std::array<float, kFftLengthBy2Plus1> emr_transparent;
+    std::array<float, kFftLengthBy2Plus1> nearend;
+    std::array<float, kFftLengthBy2Plus1> echo;
+    std::array<float, kFftLengthBy2Plus1> masker;
+    std::array<float, kFftLengthBy2Plus1> gain;
+    std::array<float, kFftLengthBy2Plus1> gain_avx2;
+    for (int run = 0; run < kNumRuns; ++run) {
+      for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
+        enr_transparent[k] = 0.1f + random.Rand<float>();
+        enr_suppress[k] = enr_transparent[k] + 0.1f + random.Rand<float>();
+        emr_transparent[k] = 0.1f + 10.f * random.Rand<float>();
+      }
+      FillPowers(&random, 4.f, nearend);
+      FillPowers(&random, 4.f, echo);
+      FillPowers(&random, 3.f, masker);
+
+      GainToNoAudibleEcho(enr_transparent, enr_suppress, emr_transparent,
+                          nearend, echo, masker, gain);
+      GainToNoAudibleEcho_Avx2(enr_transparent, enr_suppress, emr_transparent,
+                               nearend, echo, masker, gain_avx2);
+      EXPECT_EQ(gain, gain_avx2);
+    }
+  }
+}
+
+// Verifies that the AVX2 minimum gain computation is bitexact to the
+// reference.
+TEST(SuppressorKernels, MinGainAvx2Optimization) {
+  if (GetCPUInfo(kAVX2) != 0) {
+    Random random(42);
+    std::array<float, kFftLengthBy2Plus1> echo;
+    std::array<float, kFftLengthBy2Plus1> min_gain;
+    std::array<float, kFftLengthBy2Plus1> min_gain_avx2;
+    for (int run = 0; run < kNumRuns; ++run) {
+      FillPowers(&random, 4.f, echo);
+      const float min_echo_power = 10000.f * random.Rand<float>();
+      MinGain(min_echo_power, echo, min_gain);
+      MinGain_Avx2(min_echo_power, echo, min_gain_avx2);
+      EXPECT_EQ(min_gain, min_gain_avx2);
+    }
+  }
+}
+
+// Verifies that the AVX2 linear residual echo computation is bitexact to the
+// reference.
+TEST(SuppressorKernels, LinearResidualEchoAvx2Optimization) {
+  if (GetCPUInfo(kAVX2) != 0) {
+    Random random(42);
+    std::array<float, kFftLengthBy2Plus1> S2_linear;
+    std::array<float, kFftLengthBy2Plus1> erle;
+    std::array<float, kFftLengthBy2Plus1> R2;
+    std::array<float, kFftLengthBy2Plus1> R2_avx2;
+    for (int run = 0; run < kNumRuns; ++run) {
+      FillPowers(&random, 4.f, S2_linear);
+      for (float& erle_k : erle) {
+        erle_k = 1.f + 10.f * random.Rand<float>();
+      }
+      LinearResidualEcho(S2_linear, erle, R2);
+      LinearResidualEcho_Avx2(S2_linear, erle, R2_avx2);
+      EXPECT_EQ(R2, R2_avx2);
+    }
+  }
+}
+
+// Verifies that the AVX2 ERLE update matches the reference, up to the
+// rounding of the fused multiply-add, for band counts that are not multiples of
+// the vector length.
+TEST(SuppressorKernels, UpdateErleAvx2Optimization) {
+  if (GetCPUInfo(kAVX2) != 0) {
+    constexpr float kMinErle = 1.f;
+    Random random(42);
+    std::array<float, kFftLengthBy2Plus1> new_erle;
+    std::array<bool, kFftLengthBy2Plus1> is_erle_updated;
+    std::array<bool, kFftLengthBy2Plus1> low_render_energy;
+    std::array<float, kFftLengthBy2Plus1> max_erle;
+    std::array<float, kFftLengthBy2Plus1> erle;
+    std::array<float, kFftLengthBy2Plus1> erle_avx2;
+    erle.fill(kMinErle);
+    erle_avx2.fill(kMinErle);
+    for (int run = 0; run < kNumRuns; ++run) {
+      for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
+        new_erle[k] = 10.f * random.Rand<float>();
+        is_erle_updated[k] = random.Rand<float>() < 0.8f;
+        low_render_energy[k] = random.Rand<float>() < 0.3f;
+        max_erle[k] = k < kFftLengthBy2 / 2 ? 4.f : 1.5f;
+      }
+      const size_t num_bands = kFftLengthBy2Plus1 - run % 3;
+      UpdateErle(rtc::MakeArrayView(new_erle.data(), num_bands),
+                 rtc::MakeArrayView(is_erle_updated.data(), num_bands),
+                 rtc::MakeArrayView(low_render_energy.data(), num_bands),
+                 kMinErle, rtc::MakeArrayView(max_erle.data(), num_bands),
+                 rtc::MakeArrayView(erle.data(), num_bands));
+      UpdateErle_Avx2(rtc::MakeArrayView(new_erle.data(), num_bands),
+                      rtc::MakeArrayView(is_erle_updated.data(), num_bands),
+                      rtc::MakeArrayView(low_render_energy.data(), num_bands),
+                      kMinErle, rtc::MakeArrayView(max_erle.data(), num_bands),
+                      rtc::MakeArrayView(erle_avx2.data(), num_bands));
+      for (size_t k = 0; k < kFftLengthBy2Plus1; ++k) {
+        EXPECT_NEAR(erle[k], erle_avx2[k], 1e-5f);
+      }
+    }
+  }
+}
+#endif
+
+}  // namespace aec3
+}  // namespace webrtc
@@ -10,6 +10,8 @@
 
 #include "modules/audio_processing/agc2/rnn_vad/rnn.h"
 
+#include <algorithm>
+
 #include "rtc_base/checks.h"
 #include "third_party/rnnoise/src/rnn_vad_weights.h"
 
@@ -38,20 +40,26 @@ static_assert(kOutputLayerOutputSize <= kFullyConnectedLayerMaxUnits, "");
 }  // namespace
 
 RnnVad::RnnVad(const AvailableCpuFeatures& cpu_features)
+    : RnnVad(cpu_features, LayerPrecision::kFloat32) {}
+
+RnnVad::RnnVad(const AvailableCpuFeatures& cpu_features,
+               LayerPrecision precision)
     : input_(kInputLayerInputSize,
              kInputLayerOutputSize,
              kInputDenseBias,
              kInputDenseWeights,
              ActivationFunction::kTansigApproximated,
              cpu_features,
-             /*layer_name=*/"FC1"),
+             /*layer_name=*/"FC1",
+             precision),
       hidden_(kInputLayerOutputSize,
               kHiddenLayerOutputSize,
               kHiddenGruBias,
               kHiddenGruWeights,
               kHiddenGruRecurrentWeights,
               cpu_features,
-              /*layer_name=*/"GRU1"),
+              /*layer_name=*/"GRU1",
+              precision),
       output_(kHiddenLayerOutputSize,
               kOutputLayerOutputSize,
               kOutputDenseBias,
@@ -59,7 +67,8 @@ RnnVad::RnnVad(const AvailableCpuFeatures& cpu_features)
               ActivationFunction::kSigmoidApproximated,
               // The output layer is just 24x1. The unoptimized code is faster.
               NoAvailableCpuFeatures(),
-              /*layer_name=*/"FC2") {
+              /*layer_name=*/"FC2",
+              precision) {
   // Input-output chaining size checks.
   RTC_DCHECK_EQ(input_.size(), hidden_.input_size())
       << "The input and the hidden layers sizes do not match.";
@@ -87,5 +96,94 @@ float RnnVad::ComputeVadProbability(
   return output_.data()[0];
 }
 
+BatchRnnVad::BatchRnnVad(int num_streams,
+                         const AvailableCpuFeatures& cpu_features,
+                         LayerPrecision precision)
+    : num_streams_(num_streams),
+      input_(kInputLayerInputSize,
+             kInputLayerOutputSize,
+             kInputDenseBias,
+             kInputDenseWeights,
+             ActivationFunction::kTansigApproximated,
+             cpu_features,
+             /*layer_name=*/"FC1",
+             precision),
+      hidden_(kInputLayerOutputSize,
+              kHiddenLayerOutputSize,
+              kHiddenGruBias,
+              kHiddenGruWeights,
+              kHiddenGruRecurrentWeights,
+              cpu_features,
+              /*layer_name=*/"GRU1",
+              precision),
+      output_(kHiddenLayerOutputSize,
+              kOutputLayerOutputSize,
+              kOutputDenseBias,
+              kOutputDenseWeights,
+              ActivationFunction::kSigmoidApproximated,
+              // The output layer is just 24x1. The unoptimized code is faster.
+              NoAvailableCpuFeatures(),
+              /*layer_name=*/"FC2",
+              precision),
+      input_layer_outputs_(num_streams * kInputLayerOutputSize),
+      hidden_states_(num_streams * kHiddenLayerOutputSize) {
+  RTC_DCHECK_GT(num_streams_, 0);
+  RTC_DCHECK_EQ(output_.size(), 1);
+  Reset();
+}
+
+BatchRnnVad::~BatchRnnVad() = default;
+
+void BatchRnnVad::Reset() {
+  std::fill(hidden_states_.begin(), hidden_states_.end(), 0.f);
+}
+
+void BatchRnnVad::Reset(int stream_index) {
+  RTC_DCHECK_GE(stream_index, 0);
+  RTC_DCHECK_LT(stream_index, num_streams_);
+  std::fill_n(hidden_states_.begin() + stream_index * kHiddenLayerOutputSize,
+              kHiddenLayerOutputSize, 0.f);
+}
+
+void BatchRnnVad::ComputeVadProbabilities(
+    rtc::ArrayView<const float> feature_vectors,
+    rtc::ArrayView<const bool> is_silence,
+    rtc::ArrayView<float> vad_probabilities) {
+  RTC_DCHECK_EQ(feature_vectors.size(), num_streams_ * kFeatureVectorSize);
+  RTC_DCHECK_EQ(is_silence.size(), num_streams_);
+  RTC_DCHECK_EQ(vad_probabilities.size(), num_streams_);
+  rtc::ArrayView<float> input_layer_outputs(input_layer_outputs_);
+  rtc::ArrayView<float> hidden_states(hidden_states_);
+  for (int s = 0; s < num_streams_; ++s) {
+    if (is_silence[s]) {
+      continue;
+    }
+    input_.ComputeOutput(
+        feature_vectors.subview(s * kFeatureVectorSize, kFeatureVectorSize),
+        input_layer_outputs.subview(s * kInputLayerOutputSize,
+                                    kInputLayerOutputSize));
+  }
+  for (int s = 0; s < num_streams_; ++s) {
+    if (is_silence[s]) {
+      Reset(s);
+      continue;
+    }
+    hidden_.ComputeOutput(
+        input_layer_outputs.subview(s * kInputLayerOutputSize,
+                                    kInputLayerOutputSize),
+        hidden_states.subview(s * kHiddenLayerOutputSize,
+                              kHiddenLayerOutputSize));
+  }
+  for (int s = 0; s < num_streams_; ++s) {
+    if (is_silence[s]) {
+      vad_probabilities[s] = 0.f;
+      continue;
+    }
+    output_.ComputeOutput(hidden_states.subview(s * kHiddenLayerOutputSize,
+                                                kHiddenLayerOutputSize),
+                          vad_probabilities.subview(s, 1));
+  }
+}
+
 }  // namespace rnn_vad
 }  // namespace webrtc
@@ -31,6 +31,7 @@ namespace rnn_vad {
 class RnnVad {
  public:
   explicit RnnVad(const AvailableCpuFeatures& cpu_features);
+  RnnVad(const AvailableCpuFeatures& cpu_features, LayerPrecision precision);
   RnnVad(const RnnVad&) = delete;
   RnnVad& operator=(const RnnVad&) = delete;
   ~RnnVad();
@@ -47,6 +48,44 @@ class RnnVad {
   FullyConnectedLayer output_;
 };
 
+// Same network as `RnnVad`, evaluated for many independent streams in one call.
+// The weights are shared and each layer is evaluated for all the streams before
+// moving to the next one, so that the weights stay in cache. Each stream only
+// owns the hidden layer state.
+class BatchRnnVad {
+ public:
+  BatchRnnVad(int num_streams,
+              const AvailableCpuFeatures& cpu_features,
+              LayerPrecision precision);
+  BatchRnnVad(const BatchRnnVad&) = delete;
+  BatchRnnVad& operator=(const BatchRnnVad&) = delete;
+  ~BatchRnnVad();
+
+  int num_streams() const { return num_streams_; }
+
+  // Resets the state of all the streams.
+  void Reset();
+  // Resets the state of the stream with index `stream_index`.
+  void Reset(int stream_index);
+  // Observes one feature vector per stream, stored one after the other in
+  // `feature_vectors`, and the silence flags in `is_silence`, updates the RNN
+  // and writes the current voice probability for each stream into
+  // `vad_probabilities`. Produces the same output as one `RnnVad` per stream.
+  void ComputeVadProbabilities(rtc::ArrayView<const float> feature_vectors,
+                               rtc::ArrayView<const bool> is_silence,
+                               rtc::ArrayView<float> vad_probabilities);
+
+ private:
+  const int num_streams_;
+  FullyConnectedLayer input_;
+  GatedRecurrentLayer hidden_;
+  FullyConnectedLayer output_;
+  // Input layer outputs and hidden layer states, one after the other for all
+  // the streams.
+  std::vector<float> input_layer_outputs_;
+  std::vector<float> hidden_states_;
+};
+
 }  // namespace rnn_vad
 }  // namespace webrtc
 
@@ -51,6 +51,24 @@ std::vector<float> PreprocessWeights(rtc::ArrayView<const int8_t> weights,
   return w;
 }
 
+// Re-arranges the layout of `weights` as done by `PreprocessWeights()`, but
+// keeps the int8 values and zero-pads each row to a multiple of
+// `kQuantizedBlockSize`.
+std::vector<int8_t> PreprocessQuantizedWeights(
+    rtc::ArrayView<const int8_t> weights,
+    int output_size) {
+  const int input_size = rtc::CheckedDivExact(
+      rtc::dchecked_cast<int>(weights.size()), output_size);
+  const int padded_input_size = GetQuantizedVectorSize(input_size);
+  std::vector<int8_t> w(output_size * padded_input_size, 0);
+  for (int o = 0; o < output_size; ++o) {
+    for (int i = 0; i < input_size; ++i) {
+      w[o * padded_input_size + i] = weights[i * output_size + o];
+    }
+  }
+  return w;
+}
+
 rtc::FunctionView<float(float)> GetActivationFunction(
     ActivationFunction activation_function) {
   switch (activation_function) {
@@ -70,11 +88,21 @@ FullyConnectedLayer::FullyConnectedLayer(
     const rtc::ArrayView<const int8_t> weights,
     ActivationFunction activation_function,
     const AvailableCpuFeatures& cpu_features,
-    absl::string_view layer_name)
+    absl::string_view layer_name,
+    LayerPrecision precision)
     : input_size_(input_size),
       output_size_(output_size),
+      precision_(precision),
       bias_(GetScaledParams(bias)),
-      weights_(PreprocessWeights(weights, output_size)),
+      weights_(precision == LayerPrecision::kFloat32
+                   ? PreprocessWeights(weights, output_size)
+                   : std::vector<float>()),
+      quantized_weights_(precision == LayerPrecision::kInt8
+                             ? PreprocessQuantizedWeights(weights, output_size)
+                             : std::vector<int8_t>()),
+      quantized_input_(precision == LayerPrecision::kInt8
+                           ? GetQuantizedVectorSize(input_size)
+                           : 0),
       vector_math_(cpu_features),
       activation_function_(GetActivationFunction(activation_function)) {
   RTC_DCHECK_LE(output_size_, kFullyConnectedLayerMaxUnits)
@@ -82,7 +110,7 @@ FullyConnectedLayer::FullyConnectedLayer(
   RTC_DCHECK_EQ(output_size_, bias_.size())
       << "Mismatching output size and bias terms array size (" << layer_name
       << ").";
-  RTC_DCHECK_EQ(input_size_ * output_size_, weights_.size())
+  RTC_DCHECK_EQ(input_size_ * output_size_, weights.size())
       << "Mismatching input-output size and weight coefficients array size ("
       << layer_name << ").";
 }
@@ -90,10 +118,30 @@ FullyConnectedLayer::FullyConnectedLayer(
 FullyConnectedLayer::~FullyConnectedLayer() = default;
 
 void FullyConnectedLayer::ComputeOutput(rtc::ArrayView<const float> input) {
+  ComputeOutput(input, {output_.data(), static_cast<size_t>(output_size_)});
+}
+
+void FullyConnectedLayer::ComputeOutput(rtc::ArrayView<const float> input,
+                                        rtc::ArrayView<float> output) {
   RTC_DCHECK_EQ(input.size(), input_size_);
+  RTC_DCHECK_EQ(output.size(), output_size_);
+  if (precision_ == LayerPrecision::kInt8) {
+    const float scaling =
+        ::rnnoise::kWeightsScale *
+        vector_math_.QuantizeToInt16(input, quantized_input_);
+    std::array<int32_t, kFullyConnectedLayerMaxUnits> dot_products;
+    vector_math_.QuantizedMatrixVectorProduct(
+        quantized_input_, quantized_weights_,
+        {dot_products.data(), static_cast<size_t>(output_size_)});
+    for (int o = 0; o < output_size_; ++o) {
+      output[o] = activation_function_(
+          bias_[o] + scaling * static_cast<float>(dot_products[o]));
+    }
+    return;
+  }
   rtc::ArrayView<const float> weights(weights_);
   for (int o = 0; o < output_size_; ++o) {
-    output_[o] = activation_function_(
+    output[o] = activation_function_(
         bias_[o] + vector_math_.DotProduct(
                        input, weights.subview(o * input_size_, input_size_)));
   }
@@ -40,7 +40,8 @@ class FullyConnectedLayer {
                       rtc::ArrayView<const int8_t> weights,
                       ActivationFunction activation_function,
                       const AvailableCpuFeatures& cpu_features,
-                      absl::string_view layer_name);
+                      absl::string_view layer_name,
+                      LayerPrecision precision = LayerPrecision::kFloat32);
   FullyConnectedLayer(const FullyConnectedLayer&) = delete;
   FullyConnectedLayer& operator=(const FullyConnectedLayer&) = delete;
   ~FullyConnectedLayer();
@@ -54,12 +55,22 @@ class FullyConnectedLayer {
 
   // Computes the fully-connected layer output.
   void ComputeOutput(rtc::ArrayView<const float> input);
+  // Computes the fully-connected layer output into `output` instead of the
+  // owned output buffer. Allows to share the layer across independent streams.
+  void ComputeOutput(rtc::ArrayView<const float> input,
+                     rtc::ArrayView<float> output);
 
  private:
   const int input_size_;
   const int output_size_;
+  const LayerPrecision precision_;
   const std::vector<float> bias_;
+  // Only used with `LayerPrecision::kFloat32`.
   const std::vector<float> weights_;
+  // Only used with `LayerPrecision::kInt8`. Each row holds the weights for one
+  // output unit and it is zero-padded to a multiple of `kQuantizedBlockSize`.
+  const std::vector<int8_t> quantized_weights_;
+  std::vector<int16_t> quantized_input_;
   const VectorMath vector_math_;
   rtc::FunctionView<float(float)> activation_function_;
   // Over-allocated array with size equal to `output_size_`.
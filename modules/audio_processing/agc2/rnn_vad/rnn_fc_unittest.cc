@@ -61,6 +61,43 @@ TEST_P(RnnFcParametrization, CheckFullyConnectedLayerOutput) {
   ExpectNearAbsolute(kFullyConnectedExpectedOutput, fc, 1e-5f);
 }
 
+// Checks that the output of a fully connected layer with int8 arithmetic is
+// within tolerance when compared to the float layer.
+TEST_P(RnnFcParametrization, CheckQuantizedFullyConnectedLayerOutput) {
+  FullyConnectedLayer fc(kInputLayerInputSize, kInputLayerOutputSize,
+                         kInputDenseBias, kInputDenseWeights,
+                         ActivationFunction::kTansigApproximated,
+                         NoAvailableCpuFeatures(),
+                         /*layer_name=*/"FC");
+  FullyConnectedLayer quantized_fc(kInputLayerInputSize, kInputLayerOutputSize,
+                                   kInputDenseBias, kInputDenseWeights,
+                                   ActivationFunction::kTansigApproximated,
+                                   /*cpu_features=*/GetParam(),
+                                   /*layer_name=*/"FC", LayerPrecision::kInt8);
+  fc.ComputeOutput(kFullyConnectedInputVector);
+  quantized_fc.ComputeOutput(kFullyConnectedInputVector);
+  ExpectNearAbsolute(fc, quantized_fc, 2e-3f);
+}
+
+// Checks that a fully connected layer with int8 arithmetic and a zero input
+// only applies the bias.
+TEST_P(RnnFcParametrization, CheckQuantizedFullyConnectedLayerZeroInput) {
+  FullyConnectedLayer fc(kInputLayerInputSize, kInputLayerOutputSize,
+                         kInputDenseBias, kInputDenseWeights,
+                         ActivationFunction::kTansigApproximated,
+                         NoAvailableCpuFeatures(),
+                         /*layer_name=*/"FC");
+  FullyConnectedLayer quantized_fc(kInputLayerInputSize, kInputLayerOutputSize,
+                                   kInputDenseBias, kInputDenseWeights,
+                                   ActivationFunction::kTansigApproximated,
+                                   /*cpu_features=*/GetParam(),
+                                   /*layer_name=*/"FC", LayerPrecision::kInt8);
+  constexpr std::array<float, kInputLayerInputSize> kZeros{};
+  fc.ComputeOutput(kZeros);
+  quantized_fc.ComputeOutput(kZeros);
+  ExpectEqualFloatArray(fc, quantized_fc);
+}
+
 TEST_P(RnnFcParametrization, DISABLED_BenchmarkFullyConnectedLayer) {
   const AvailableCpuFeatures cpu_features = GetParam();
   FullyConnectedLayer fc(kInputLayerInputSize, kInputLayerOutputSize,
@@ -10,6 +10,8 @@
 
 #include "modules/audio_processing/agc2/rnn_vad/rnn_gru.h"
 
+#include <algorithm>
+
 #include "rtc_base/checks.h"
 #include "rtc_base/numerics/safe_conversions.h"
 #include "third_party/rnnoise/src/rnn_activations.h"
@@ -20,6 +22,8 @@ namespace rnn_vad {
 namespace {
 
 constexpr int kNumGruGates = 3;  // Update, reset, output.
+constexpr int kGruLayerMaxQuantizedUnits =
+    GetQuantizedVectorSize(kGruLayerMaxUnits);
 
 std::vector<float> PreprocessGruTensor(rtc::ArrayView<const int8_t> tensor_src,
                                        int output_size) {
@@ -43,6 +47,29 @@ std::vector<float> PreprocessGruTensor(rtc::ArrayView<const int8_t> tensor_src,
   return tensor_dst;
 }
 
+// Re-arranges the layout of `tensor_src` as done by `PreprocessGruTensor()`,
+// but keeps the int8 values and zero-pads each row to a multiple of
+// `kQuantizedBlockSize`.
+std::vector<int8_t> PreprocessQuantizedGruTensor(
+    rtc::ArrayView<const int8_t> tensor_src,
+    int output_size) {
+  const int n = rtc::CheckedDivExact(rtc::dchecked_cast<int>(tensor_src.size()),
+                                     output_size * kNumGruGates);
+  const int padded_n = GetQuantizedVectorSize(n);
+  const int stride_src = kNumGruGates * output_size;
+  const int stride_dst = padded_n * output_size;
+  std::vector<int8_t> tensor_dst(kNumGruGates * stride_dst, 0);
+  for (int g = 0; g < kNumGruGates; ++g) {
+    for (int o = 0; o < output_size; ++o) {
+      for (int i = 0; i < n; ++i) {
+        tensor_dst[g * stride_dst + o * padded_n + i] =
+            tensor_src[i * stride_src + g * output_size + o];
+      }
+    }
+  }
+  return tensor_dst;
+}
+
 // Computes the output for the update or the reset gate.
 // Operation: `g = sigmoid(W^T∙i + R^T∙s + b)` where
 // - `g`: output gate vector
@@ -119,6 +146,84 @@ void ComputeStateGate(int input_size,
   }
 }
 
+// Same as `ComputeUpdateResetGate()`, but with int16 quantized and zero-padded
+// `input` and `state` vectors, int8 weights and the scaling factors that map
+// the dot products back to floats.
+void ComputeQuantizedUpdateResetGate(
+    int output_size,
+    const VectorMath& vector_math,
+    rtc::ArrayView<const int16_t> input,
+    float input_scaling,
+    rtc::ArrayView<const int16_t> state,
+    float state_scaling,
+    rtc::ArrayView<const float> bias,
+    rtc::ArrayView<const int8_t> weights,
+    rtc::ArrayView<const int8_t> recurrent_weights,
+    rtc::ArrayView<float> gate) {
+  RTC_DCHECK_EQ(bias.size(), output_size);
+  RTC_DCHECK_GE(gate.size(), output_size);  // `gate` is over-allocated.
+  std::array<int32_t, kGruLayerMaxUnits> input_dot_products;
+  std::array<int32_t, kGruLayerMaxUnits> state_dot_products;
+  vector_math.QuantizedMatrixVectorProduct(
+      input, weights,
+      {input_dot_products.data(), static_cast<size_t>(output_size)});
+  vector_math.QuantizedMatrixVectorProduct(
+      state, recurrent_weights,
+      {state_dot_products.data(), static_cast<size_t>(output_size)});
+  for (int o = 0; o < output_size; ++o) {
+    const float x = bias[o] +
+                    input_scaling * static_cast<float>(input_dot_products[o]) +
+                    state_scaling * static_cast<float>(state_dot_products[o]);
+    gate[o] = ::rnnoise::SigmoidApproximated(x);
+  }
+}
+
+// Same as `ComputeStateGate()`, but with an int16 quantized and zero-padded
+// `input` vector, int8 weights and the scaling factor that maps the input dot
+// products back to floats.
+void ComputeQuantizedStateGate(int output_size,
+                               const VectorMath& vector_math,
+                               rtc::ArrayView<const int16_t> input,
+                               float input_scaling,
+                               rtc::ArrayView<const float> update,
+                               rtc::ArrayView<const float> reset,
+                               rtc::ArrayView<const float> bias,
+                               rtc::ArrayView<const int8_t> weights,
+                               rtc::ArrayView<const int8_t> recurrent_weights,
+                               rtc::ArrayView<float> state) {
+  RTC_DCHECK_GE(update.size(), output_size);  // `update` is over-allocated.
+  RTC_DCHECK_GE(reset.size(), output_size);   // `reset` is over-allocated.
+  RTC_DCHECK_EQ(bias.size(), output_size);
+  RTC_DCHECK_EQ(state.size(), output_size);
+  std::array<float, kGruLayerMaxUnits> reset_x_state;
+  for (int o = 0; o < output_size; ++o) {
+    reset_x_state[o] = state[o] * reset[o];
+  }
+  std::array<int16_t, kGruLayerMaxQuantizedUnits> quantized_reset_x_state;
+  rtc::ArrayView<int16_t> quantized_reset_x_state_view(
+      quantized_reset_x_state.data(), GetQuantizedVectorSize(output_size));
+  const float reset_x_state_scaling =
+      ::rnnoise::kWeightsScale *
+      vector_math.QuantizeToInt16(
+          {reset_x_state.data(), static_cast<size_t>(output_size)},
+          quantized_reset_x_state_view);
+  std::array<int32_t, kGruLayerMaxUnits> input_dot_products;
+  std::array<int32_t, kGruLayerMaxUnits> reset_x_state_dot_products;
+  vector_math.QuantizedMatrixVectorProduct(
+      input, weights,
+      {input_dot_products.data(), static_cast<size_t>(output_size)});
+  vector_math.QuantizedMatrixVectorProduct(
+      quantized_reset_x_state_view, recurrent_weights,
+      {reset_x_state_dot_products.data(), static_cast<size_t>(output_size)});
+  for (int o = 0; o < output_size; ++o) {
+    const float x =
+        bias[o] + input_scaling * static_cast<float>(input_dot_products[o]) +
+        reset_x_state_scaling *
+            static_cast<float>(reset_x_state_dot_products[o]);
+    state[o] = update[o] * state[o] + (1.f - update[o]) * std::max(0.f, x);
+  }
+}
+
 }  // namespace
 
 GatedRecurrentLayer::GatedRecurrentLayer(
@@ -128,23 +233,41 @@ GatedRecurrentLayer::GatedRecurrentLayer(
     const rtc::ArrayView<const int8_t> weights,
     const rtc::ArrayView<const int8_t> recurrent_weights,
     const AvailableCpuFeatures& cpu_features,
-    absl::string_view layer_name)
+    absl::string_view layer_name,
+    LayerPrecision precision)
     : input_size_(input_size),
       output_size_(output_size),
+      precision_(precision),
       bias_(PreprocessGruTensor(bias, output_size)),
-      weights_(PreprocessGruTensor(weights, output_size)),
-      recurrent_weights_(PreprocessGruTensor(recurrent_weights, output_size)),
+      weights_(precision == LayerPrecision::kFloat32
+                   ? PreprocessGruTensor(weights, output_size)
+                   : std::vector<float>()),
+      recurrent_weights_(precision == LayerPrecision::kFloat32
+                             ? PreprocessGruTensor(recurrent_weights,
+                                                   output_size)
+                             : std::vector<float>()),
+      quantized_weights_(precision == LayerPrecision::kInt8
+                             ? PreprocessQuantizedGruTensor(weights,
+                                                            output_size)
+                             : std::vector<int8_t>()),
+      quantized_recurrent_weights_(
+          precision == LayerPrecision::kInt8
+              ? PreprocessQuantizedGruTensor(recurrent_weights, output_size)
+              : std::vector<int8_t>()),
+      quantized_input_(precision == LayerPrecision::kInt8
+                           ? GetQuantizedVectorSize(input_size)
+                           : 0),
       vector_math_(cpu_features) {
   RTC_DCHECK_LE(output_size_, kGruLayerMaxUnits)
       << "Insufficient GRU layer over-allocation (" << layer_name << ").";
   RTC_DCHECK_EQ(kNumGruGates * output_size_, bias_.size())
       << "Mismatching output size and bias terms array size (" << layer_name
       << ").";
-  RTC_DCHECK_EQ(kNumGruGates * input_size_ * output_size_, weights_.size())
+  RTC_DCHECK_EQ(kNumGruGates * input_size_ * output_size_, weights.size())
       << "Mismatching input-output size and weight coefficients array size ("
       << layer_name << ").";
   RTC_DCHECK_EQ(kNumGruGates * output_size_ * output_size_,
-                recurrent_weights_.size())
+                recurrent_weights.size())
       << "Mismatching input-output size and recurrent weight coefficients array"
          " size ("
       << layer_name << ").";
@@ -158,19 +281,72 @@ void GatedRecurrentLayer::Reset() {
 }
 
 void GatedRecurrentLayer::ComputeOutput(rtc::ArrayView<const float> input) {
+  ComputeOutput(input, {state_.data(), static_cast<size_t>(output_size_)});
+}
+
+void GatedRecurrentLayer::ComputeOutput(rtc::ArrayView<const float> input,
+                                        rtc::ArrayView<float> state) {
   RTC_DCHECK_EQ(input.size(), input_size_);
+  RTC_DCHECK_EQ(state.size(), output_size_);
 
   // The tensors below are organized as a sequence of flattened tensors for the
   // `update`, `reset` and `state` gates.
   rtc::ArrayView<const float> bias(bias_);
+
+  if (precision_ == LayerPrecision::kInt8) {
+    rtc::ArrayView<const int8_t> weights(quantized_weights_);
+    rtc::ArrayView<const int8_t> recurrent_weights(
+        quantized_recurrent_weights_);
+    const int padded_output_size = GetQuantizedVectorSize(output_size_);
+    // Strides to access to the flattened tensors for a specific gate.
+    const int stride_weights = quantized_input_.size() * output_size_;
+    const int stride_recurrent_weights = padded_output_size * output_size_;
+
+    // Quantize the input and the state once for all the gates.
+    const float input_scaling =
+        ::rnnoise::kWeightsScale *
+        vector_math_.QuantizeToInt16(input, quantized_input_);
+    std::array<int16_t, kGruLayerMaxQuantizedUnits> quantized_state;
+    rtc::ArrayView<int16_t> quantized_state_view(quantized_state.data(),
+                                                 padded_output_size);
+    const float state_scaling =
+        ::rnnoise::kWeightsScale *
+        vector_math_.QuantizeToInt16(state, quantized_state_view);
+
+    // Update gate.
+    std::array<float, kGruLayerMaxUnits> update;
+    ComputeQuantizedUpdateResetGate(
+        output_size_, vector_math_, quantized_input_, input_scaling,
+        quantized_state_view, state_scaling, bias.subview(0, output_size_),
+        weights.subview(0, stride_weights),
+        recurrent_weights.subview(0, stride_recurrent_weights), update);
+    // Reset gate.
+    std::array<float, kGruLayerMaxUnits> reset;
+    ComputeQuantizedUpdateResetGate(
+        output_size_, vector_math_, quantized_input_, input_scaling,
+        quantized_state_view, state_scaling,
+        bias.subview(output_size_, output_size_),
+        weights.subview(stride_weights, stride_weights),
+        recurrent_weights.subview(stride_recurrent_weights,
+                                  stride_recurrent_weights),
+        reset);
+    // State gate.
+    ComputeQuantizedStateGate(
+        output_size_, vector_math_, quantized_input_, input_scaling, update,
+        reset, bias.subview(2 * output_size_, output_size_),
+        weights.subview(2 * stride_weights, stride_weights),
+        recurrent_weights.subview(2 * stride_recurrent_weights,
+                                  stride_recurrent_weights),
+        state);
+    return;
+  }
+
   rtc::ArrayView<const float> weights(weights_);
   rtc::ArrayView<const float> recurrent_weights(recurrent_weights_);
   // Strides to access to the flattened tensors for a specific gate.
   const int stride_weights = input_size_ * output_size_;
   const int stride_recurrent_weights = output_size_ * output_size_;
 
-  rtc::ArrayView<float> state(state_.data(), output_size_);
-
   // Update gate.
   std::array<float, kGruLayerMaxUnits> update;
   ComputeUpdateResetGate(
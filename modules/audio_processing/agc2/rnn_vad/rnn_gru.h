@@ -36,7 +36,8 @@ class GatedRecurrentLayer {
                       rtc::ArrayView<const int8_t> weights,
                       rtc::ArrayView<const int8_t> recurrent_weights,
                       const AvailableCpuFeatures& cpu_features,
-                      absl::string_view layer_name);
+                      absl::string_view layer_name,
+                      LayerPrecision precision = LayerPrecision::kFloat32);
   GatedRecurrentLayer(const GatedRecurrentLayer&) = delete;
   GatedRecurrentLayer& operator=(const GatedRecurrentLayer&) = delete;
   ~GatedRecurrentLayer();
@@ -52,13 +53,24 @@ class GatedRecurrentLayer {
   void Reset();
   // Computes the recurrent layer output and updates the status.
   void ComputeOutput(rtc::ArrayView<const float> input);
+  // Computes the recurrent layer output and updates `state` instead of the
+  // owned state. Allows to share the layer across independent streams.
+  void ComputeOutput(rtc::ArrayView<const float> input,
+                     rtc::ArrayView<float> state);
 
  private:
   const int input_size_;
   const int output_size_;
+  const LayerPrecision precision_;
   const std::vector<float> bias_;
+  // Only used with `LayerPrecision::kFloat32`.
   const std::vector<float> weights_;
   const std::vector<float> recurrent_weights_;
+  // Only used with `LayerPrecision::kInt8`. The rows are zero-padded to a
+  // multiple of `kQuantizedBlockSize`.
+  const std::vector<int8_t> quantized_weights_;
+  const std::vector<int8_t> quantized_recurrent_weights_;
+  std::vector<int16_t> quantized_input_;
   const VectorMath vector_math_;
   // Over-allocated array with size equal to `output_size_`.
   std::array<float, kGruLayerMaxUnits> state_;
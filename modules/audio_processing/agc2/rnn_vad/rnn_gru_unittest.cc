@@ -117,6 +117,28 @@ TEST_P(RnnGruParametrization, CheckGatedRecurrentLayer) {
   TestGatedRecurrentLayer(gru, kGruInputSequence, kGruExpectedOutputSequence);
 }
 
+// Checks that the output of a GRU layer with int8 arithmetic is within
+// tolerance when compared to the float layer.
+TEST_P(RnnGruParametrization, CheckQuantizedGatedRecurrentLayer) {
+  GatedRecurrentLayer gru(kGruInputSize, kGruOutputSize, kGruBias, kGruWeights,
+                          kGruRecurrentWeights, NoAvailableCpuFeatures(),
+                          /*layer_name=*/"GRU");
+  GatedRecurrentLayer quantized_gru(kGruInputSize, kGruOutputSize, kGruBias,
+                                    kGruWeights, kGruRecurrentWeights,
+                                    /*cpu_features=*/GetParam(),
+                                    /*layer_name=*/"GRU",
+                                    LayerPrecision::kInt8);
+  rtc::ArrayView<const float> input_sequence(kGruInputSequence);
+  const int input_sequence_length = kGruInputSequence.size() / kGruInputSize;
+  for (int i = 0; i < input_sequence_length; ++i) {
+    SCOPED_TRACE(i);
+    const auto input = input_sequence.subview(i * kGruInputSize, kGruInputSize);
+    gru.ComputeOutput(input);
+    quantized_gru.ComputeOutput(input);
+    ExpectNearAbsolute(gru, quantized_gru, 1e-3f);
+  }
+}
+
 TEST_P(RnnGruParametrization, DISABLED_BenchmarkGatedRecurrentLayer) {
   // Prefetch test data.
   std::unique_ptr<FileReader> reader = CreateGruInputReader();
@@ -10,6 +10,10 @@
 
 #include "modules/audio_processing/agc2/rnn_vad/rnn.h"
 
+#include <array>
+#include <memory>
+#include <vector>
+
 #include "api/array_view.h"
 #include "modules/audio_processing/agc2/cpu_features.h"
 #include "modules/audio_processing/agc2/rnn_vad/common.h"
@@ -65,6 +69,76 @@ TEST(RnnVadTest, CheckRnnVadSilence) {
   EXPECT_EQ(pre, post);
 }
 
+// Checks that the batch RNN produces the same output as one RNN per stream
+// when some of the streams are silent.
+TEST(RnnVadTest, BatchRnnVadMatchesRnnVad) {
+  for (LayerPrecision precision :
+       {LayerPrecision::kFloat32, LayerPrecision::kInt8}) {
+    SCOPED_TRACE(precision == LayerPrecision::kInt8 ? "int8" : "float32");
+    constexpr int kNumStreams = 5;
+    constexpr int kNumFrames = 20;
+    const AvailableCpuFeatures cpu_features = GetAvailableCpuFeatures();
+    BatchRnnVad batch_rnn_vad(kNumStreams, cpu_features, precision);
+    std::vector<std::unique_ptr<RnnVad>> rnn_vads;
+    for (int s = 0; s < kNumStreams; ++s) {
+      rnn_vads.push_back(std::make_unique<RnnVad>(cpu_features, precision));
+    }
+    std::vector<float> feature_vectors(kNumStreams * kFeatureVectorSize);
+    std::array<bool, kNumStreams> is_silence;
+    std::array<float, kNumStreams> vad_probabilities;
+    for (int i = 0; i < kNumFrames; ++i) {
+      SCOPED_TRACE(i);
+      for (int s = 0; s < kNumStreams; ++s) {
+        // Make the streams different by scaling and by the silence pattern.
+        for (int k = 0; k < kFeatureVectorSize; ++k) {
+          feature_vectors[s * kFeatureVectorSize + k] =
+              kFeatures[k] * (1.f + 0.1f * s) * (1.f - 0.02f * i);
+        }
+        is_silence[s] = (i + s) % 7 == 0;
+      }
+      batch_rnn_vad.ComputeVadProbabilities(feature_vectors, is_silence,
+                                            vad_probabilities);
+      for (int s = 0; s < kNumStreams; ++s) {
+        const float expected = rnn_vads[s]->ComputeVadProbability(
+            rtc::ArrayView<const float, kFeatureVectorSize>(
+                &feature_vectors[s * kFeatureVectorSize], kFeatureVectorSize),
+            is_silence[s]);
+        EXPECT_EQ(vad_probabilities[s], expected);
+      }
+    }
+  }
+}
+
+// Checks that resetting one stream of the batch RNN does not affect the others.
+TEST(RnnVadTest, BatchRnnVadResetsSingleStream) {
+  constexpr int kNumStreams = 2;
+  BatchRnnVad batch_rnn_vad(kNumStreams, GetAvailableCpuFeatures(),
+                            LayerPrecision::kInt8);
+  RnnVad rnn_vad(GetAvailableCpuFeatures(), LayerPrecision::kInt8);
+  std::vector<float> feature_vectors;
+  for (int s = 0; s < kNumStreams; ++s) {
+    feature_vectors.insert(feature_vectors.end(), kFeatures.begin(),
+                           kFeatures.end());
+  }
+  constexpr std::array<bool, kNumStreams> kNotSilence = {false, false};
+  std::array<float, kNumStreams> vad_probabilities;
+  for (int i = 0; i < 10; ++i) {
+    batch_rnn_vad.ComputeVadProbabilities(feature_vectors, kNotSilence,
+                                          vad_probabilities);
+  }
+  batch_rnn_vad.Reset(/*stream_index=*/0);
+  batch_rnn_vad.ComputeVadProbabilities(feature_vectors, kNotSilence,
+                                        vad_probabilities);
+  // The first stream behaves as a reset RNN, the second one as a warmed up
+  // RNN.
+  EXPECT_EQ(vad_probabilities[0],
+            rnn_vad.ComputeVadProbability(kFeatures, /*is_silence=*/false));
+  rnn_vad.Reset();
+  WarmUpRnnVad(rnn_vad);
+  EXPECT_EQ(vad_probabilities[1],
+            rnn_vad.ComputeVadProbability(kFeatures, /*is_silence=*/false));
+}
+
 }  // namespace
 }  // namespace rnn_vad
 }  // namespace webrtc
@@ -108,6 +108,46 @@ TEST_P(RnnVadProbabilityParametrization, RnnVadProbabilityWithinTolerance) {
   }
 }
 
+// Checks that the VAD probability computed with int8 arithmetic for a test
+// input sequence sampled at 48 kHz is within tolerance when compared to the
+// float arithmetic and to the expected output.
+TEST_P(RnnVadProbabilityParametrization,
+       QuantizedRnnVadProbabilityWithinTolerance) {
+  PushSincResampler decimator(kFrameSize10ms48kHz, kFrameSize10ms24kHz);
+  const AvailableCpuFeatures cpu_features = GetParam();
+  FeaturesExtractor features_extractor(cpu_features);
+  RnnVad rnn_vad(cpu_features, LayerPrecision::kFloat32);
+  RnnVad quantized_rnn_vad(cpu_features, LayerPrecision::kInt8);
+
+  std::unique_ptr<FileReader> samples_reader = CreatePcmSamplesReader();
+  std::unique_ptr<FileReader> expected_vad_prob_reader = CreateVadProbsReader();
+  const int num_frames = samples_reader->size() / kFrameSize10ms48kHz;
+  std::vector<float> samples_48k(kFrameSize10ms48kHz);
+  std::vector<float> samples_24k(kFrameSize10ms24kHz);
+  std::vector<float> feature_vector(kFeatureVectorSize);
+  std::vector<float> expected_vad_prob(num_frames);
+  ASSERT_TRUE(expected_vad_prob_reader->ReadChunk(expected_vad_prob));
+
+  float cumulative_error = 0.f;
+  for (int i = 0; i < num_frames; ++i) {
+    ASSERT_TRUE(samples_reader->ReadChunk(samples_48k));
+    decimator.Resample(samples_48k.data(), samples_48k.size(),
+                       samples_24k.data(), samples_24k.size());
+    bool is_silence = features_extractor.CheckSilenceComputeFeatures(
+        {samples_24k.data(), kFrameSize10ms24kHz},
+        {feature_vector.data(), kFeatureVectorSize});
+    const float vad_prob = rnn_vad.ComputeVadProbability(
+        {feature_vector.data(), kFeatureVectorSize}, is_silence);
+    const float quantized_vad_prob = quantized_rnn_vad.ComputeVadProbability(
+        {feature_vector.data(), kFeatureVectorSize}, is_silence);
+    EXPECT_NEAR(quantized_vad_prob, vad_prob, 1e-2f);
+    EXPECT_NEAR(quantized_vad_prob, expected_vad_prob[i], 1e-2f);
+    cumulative_error += std::abs(quantized_vad_prob - vad_prob);
+  }
+  // Check average error.
+  EXPECT_LT(cumulative_error / num_frames, 1e-3f);
+}
+
 // Performance test for the RNN VAD (pre-fetching and downsampling are
 // excluded). Keep disabled and only enable locally to measure performance as
 // follows:
@@ -21,6 +21,11 @@
 #include <emmintrin.h>
 #endif
 
+#include <stdint.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <numeric>
 
 #include "api/array_view.h"
@@ -32,6 +37,22 @@
 namespace webrtc {
 namespace rnn_vad {
 
+// Arithmetic used to evaluate the RNN layers. With `kInt8`, the layers keep
+// their weights in the original int8 quantized form and the layer inputs are
+// quantized to int16 on the fly, so that dot products are computed with integer
+// arithmetic.
+enum class LayerPrecision { kFloat32, kInt8 };
+
+// Size of the blocks into which the quantized vectors are zero-padded, so that
+// the dot products never need to process incomplete SIMD blocks.
+constexpr int kQuantizedBlockSize = 16;
+
+// Returns `size` rounded up to a multiple of `kQuantizedBlockSize`.
+constexpr int GetQuantizedVectorSize(int size) {
+  return ((size + kQuantizedBlockSize - 1) / kQuantizedBlockSize) *
+         kQuantizedBlockSize;
+}
+
 // Provides optimizations for mathematical operations having vectors as
 // operand(s).
 class VectorMath {
@@ -101,9 +122,216 @@ class VectorMath {
     return std::inner_product(x.begin(), x.end(), y.begin(), 0.f);
   }
 
+  // Quantizes `x` into `y` by mapping the largest absolute value in `x` onto
+  // the maximum int16 value and returns the scaling factor that maps the values
+  // in `y` back to floats. The values are rounded to the nearest integer and
+  // the elements of `y` beyond the size of `x` are zeroed.
+  float QuantizeToInt16(rtc::ArrayView<const float> x,
+                        rtc::ArrayView<int16_t> y) const {
+    RTC_DCHECK_GE(y.size(), x.size());
+    std::fill(y.begin() + x.size(), y.end(), 0);
+    const int size = rtc::dchecked_cast<int>(x.size());
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    if (cpu_features_.avx2) {
+      return QuantizeToInt16Avx2(x, y);
+    } else if (cpu_features_.sse2) {
+      constexpr int kBlockSizeLog2 = 3;
+      constexpr int kBlockSize = 1 << kBlockSizeLog2;
+      const int incomplete_block_index = (size >> kBlockSizeLog2)
+                                         << kBlockSizeLog2;
+      // Find the largest absolute value.
+      const __m128 sign_mask = _mm_set1_ps(-0.f);
+      __m128 max_abs_block = _mm_setzero_ps();
+      for (int i = 0; i < incomplete_block_index; i += kBlockSize) {
+        max_abs_block = _mm_max_ps(
+            max_abs_block, _mm_andnot_ps(sign_mask, _mm_loadu_ps(&x[i])));
+        max_abs_block = _mm_max_ps(
+            max_abs_block, _mm_andnot_ps(sign_mask, _mm_loadu_ps(&x[i + 4])));
+      }
+      max_abs_block = _mm_max_ps(max_abs_block,
+                                 _mm_movehl_ps(max_abs_block, max_abs_block));
+      max_abs_block = _mm_max_ps(
+          max_abs_block, _mm_shuffle_ps(max_abs_block, max_abs_block, 1));
+      float max_abs = _mm_cvtss_f32(max_abs_block);
+      for (int i = incomplete_block_index; i < size; ++i) {
+        max_abs = std::max(max_abs, std::fabs(x[i]));
+      }
+      if (max_abs == 0.f) {
+        std::fill(y.begin(), y.begin() + size, 0);
+        return 0.f;
+      }
+      // Scale, round and saturate.
+      const float scaling = kMaxInt16 / max_abs;
+      const __m128 scaling_block = _mm_set1_ps(scaling);
+      for (int i = 0; i < incomplete_block_index; i += kBlockSize) {
+        const __m128i low =
+            _mm_cvtps_epi32(_mm_mul_ps(_mm_loadu_ps(&x[i]), scaling_block));
+        const __m128i high = _mm_cvtps_epi32(
+            _mm_mul_ps(_mm_loadu_ps(&x[i + 4]), scaling_block));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(&y[i]),
+                         _mm_packs_epi32(low, high));
+      }
+      for (int i = incomplete_block_index; i < size; ++i) {
+        y[i] = QuantizeValue(x[i], scaling);
+      }
+      return max_abs / kMaxInt16;
+    }
+#elif defined(WEBRTC_HAS_NEON)
+    if (cpu_features_.neon) {
+      constexpr int kBlockSizeLog2 = 3;
+      constexpr int kBlockSize = 1 << kBlockSizeLog2;
+      const int incomplete_block_index = (size >> kBlockSizeLog2)
+                                         << kBlockSizeLog2;
+      // Find the largest absolute value.
+      float32x4_t max_abs_block = vdupq_n_f32(0.f);
+      for (int i = 0; i < incomplete_block_index; i += kBlockSize) {
+        max_abs_block = vmaxq_f32(max_abs_block, vabsq_f32(vld1q_f32(&x[i])));
+        max_abs_block =
+            vmaxq_f32(max_abs_block, vabsq_f32(vld1q_f32(&x[i + 4])));
+      }
+      float32x2_t tmp =
+          vpmax_f32(vget_low_f32(max_abs_block), vget_high_f32(max_abs_block));
+      float max_abs = vget_lane_f32(vpmax_f32(tmp, tmp), 0);
+      for (int i = incomplete_block_index; i < size; ++i) {
+        max_abs = std::max(max_abs, std::fabs(x[i]));
+      }
+      if (max_abs == 0.f) {
+        std::fill(y.begin(), y.begin() + size, 0);
+        return 0.f;
+      }
+      // Scale, round and saturate. The rounding offset is used since ARMv7
+      // lacks a round-to-nearest conversion.
+      const float scaling = kMaxInt16 / max_abs;
+      const float32x4_t offset = vdupq_n_f32(kRoundingOffset);
+      for (int i = 0; i < incomplete_block_index; i += kBlockSize) {
+        const float32x4_t low = vsubq_f32(
+            vaddq_f32(vmulq_n_f32(vld1q_f32(&x[i]), scaling), offset), offset);
+        const float32x4_t high = vsubq_f32(
+            vaddq_f32(vmulq_n_f32(vld1q_f32(&x[i + 4]), scaling), offset),
+            offset);
+        vst1q_s16(&y[i], vcombine_s16(vqmovn_s32(vcvtq_s32_f32(low)),
+                                      vqmovn_s32(vcvtq_s32_f32(high))));
+      }
+      for (int i = incomplete_block_index; i < size; ++i) {
+        y[i] = QuantizeValue(x[i], scaling);
+      }
+      return max_abs / kMaxInt16;
+    }
+#endif
+    float max_abs = 0.f;
+    for (float x_i : x) {
+      max_abs = std::max(max_abs, std::fabs(x_i));
+    }
+    if (max_abs == 0.f) {
+      std::fill(y.begin(), y.begin() + size, 0);
+      return 0.f;
+    }
+    const float scaling = kMaxInt16 / max_abs;
+    for (int i = 0; i < size; ++i) {
+      y[i] = QuantizeValue(x[i], scaling);
+    }
+    return max_abs / kMaxInt16;
+  }
+
+  // Computes the dot product between two equally sized vectors with int16 and
+  // int8 elements. Vectors with a size multiple of `kQuantizedBlockSize` are
+  // processed without scalar tail. The result cannot overflow for vectors with
+  // up to 512 elements.
+  int32_t QuantizedDotProduct(rtc::ArrayView<const int16_t> x,
+                              rtc::ArrayView<const int8_t> y) const {
+    RTC_DCHECK_EQ(x.size(), y.size());
+    int incomplete_block_index = 0;
+    int32_t dot_product = 0;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    if (cpu_features_.avx2) {
+      return QuantizedDotProductAvx2(x, y);
+    } else if (cpu_features_.sse2) {
+      __m128i accumulator = _mm_setzero_si128();
+      constexpr int kBlockSizeLog2 = 3;
+      constexpr int kBlockSize = 1 << kBlockSizeLog2;
+      incomplete_block_index = (x.size() >> kBlockSizeLog2) << kBlockSizeLog2;
+      for (int i = 0; i < incomplete_block_index; i += kBlockSize) {
+        RTC_DCHECK_LE(i + kBlockSize, x.size());
+        const __m128i x_i =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(&x[i]));
+        // Sign-extend the int8 values to int16.
+        __m128i y_i = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(&y[i]));
+        y_i = _mm_srai_epi16(_mm_unpacklo_epi8(y_i, y_i), 8);
+        accumulator = _mm_add_epi32(accumulator, _mm_madd_epi16(x_i, y_i));
+      }
+      // Reduce `accumulator` by addition.
+      accumulator = _mm_add_epi32(
+          accumulator, _mm_shuffle_epi32(accumulator, _MM_SHUFFLE(1, 0, 3, 2)));
+      accumulator = _mm_add_epi32(
+          accumulator, _mm_shuffle_epi32(accumulator, _MM_SHUFFLE(2, 3, 0, 1)));
+      dot_product = _mm_cvtsi128_si32(accumulator);
+    }
+#elif defined(WEBRTC_HAS_NEON)
+    if (cpu_features_.neon) {
+      int32x4_t accumulator = vdupq_n_s32(0);
+      constexpr int kBlockSizeLog2 = 3;
+      constexpr int kBlockSize = 1 << kBlockSizeLog2;
+      incomplete_block_index = (x.size() >> kBlockSizeLog2) << kBlockSizeLog2;
+      for (int i = 0; i < incomplete_block_index; i += kBlockSize) {
+        RTC_DCHECK_LE(i + kBlockSize, x.size());
+        const int16x8_t x_i = vld1q_s16(&x[i]);
+        const int16x8_t y_i = vmovl_s8(vld1_s8(&y[i]));
+        accumulator =
+            vmlal_s16(accumulator, vget_low_s16(x_i), vget_low_s16(y_i));
+        accumulator =
+            vmlal_s16(accumulator, vget_high_s16(x_i), vget_high_s16(y_i));
+      }
+      // Reduce `accumulator` by addition.
+      int32x2_t tmp =
+          vadd_s32(vget_low_s32(accumulator), vget_high_s32(accumulator));
+      dot_product = vget_lane_s32(vpadd_s32(tmp, tmp), 0);
+    }
+#endif
+    // Add the result for the last block if incomplete.
+    for (int i = incomplete_block_index; i < rtc::dchecked_cast<int>(x.size());
+         ++i) {
+      dot_product += static_cast<int32_t>(x[i]) * static_cast<int32_t>(y[i]);
+    }
+    return dot_product;
+  }
+
+  // Computes `y = M∙x`, where `M` is an int8 matrix with `y.size()` rows and
+  // `x.size()` columns stored row by row in `matrix`.
+  void QuantizedMatrixVectorProduct(rtc::ArrayView<const int16_t> x,
+                                    rtc::ArrayView<const int8_t> matrix,
+                                    rtc::ArrayView<int32_t> y) const {
+    RTC_DCHECK_EQ(matrix.size(), x.size() * y.size());
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+    if (cpu_features_.avx2) {
+      QuantizedMatrixVectorProductAvx2(x, matrix, y);
+      return;
+    }
+#endif
+    for (size_t r = 0; r < y.size(); ++r) {
+      y[r] = QuantizedDotProduct(x, matrix.subview(r * x.size(), x.size()));
+    }
+  }
+
  private:
+  static constexpr float kMaxInt16 = std::numeric_limits<int16_t>::max();
+  // Adding and subtracting 1.5 * 2^23 rounds to the nearest integer (ties to
+  // even) for magnitudes below 2^22, as the SIMD conversions do.
+  static constexpr float kRoundingOffset = 12582912.f;
+
+  static int16_t QuantizeValue(float x, float scaling) {
+    return static_cast<int16_t>((x * scaling + kRoundingOffset) -
+                                kRoundingOffset);
+  }
+
+  float QuantizeToInt16Avx2(rtc::ArrayView<const float> x,
+                            rtc::ArrayView<int16_t> y) const;
   float DotProductAvx2(rtc::ArrayView<const float> x,
                        rtc::ArrayView<const float> y) const;
+  int32_t QuantizedDotProductAvx2(rtc::ArrayView<const int16_t> x,
+                                  rtc::ArrayView<const int8_t> y) const;
+  void QuantizedMatrixVectorProductAvx2(rtc::ArrayView<const int16_t> x,
+                                        rtc::ArrayView<const int8_t> matrix,
+                                        rtc::ArrayView<int32_t> y) const;
 
   const AvailableCpuFeatures cpu_features_;
 };
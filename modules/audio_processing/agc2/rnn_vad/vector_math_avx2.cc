@@ -12,6 +12,9 @@
 
 #include <immintrin.h>
 
+#include <algorithm>
+#include <cmath>
+
 #include "api/array_view.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/numerics/safe_conversions.h"
@@ -51,5 +54,133 @@ float VectorMath::DotProductAvx2(rtc::ArrayView<const float> x,
   return dot_product;
 }
 
+float VectorMath::QuantizeToInt16Avx2(rtc::ArrayView<const float> x,
+                                      rtc::ArrayView<int16_t> y) const {
+  RTC_DCHECK(cpu_features_.avx2);
+  RTC_DCHECK_GE(y.size(), x.size());
+  const int size = rtc::dchecked_cast<int>(x.size());
+  constexpr int kBlockSizeLog2 = 3;
+  constexpr int kBlockSize = 1 << kBlockSizeLog2;
+  const int incomplete_block_index = (size >> kBlockSizeLog2)
+                                     << kBlockSizeLog2;
+  // Find the largest absolute value.
+  const __m256 sign_mask = _mm256_set1_ps(-0.f);
+  __m256 max_abs_block = _mm256_setzero_ps();
+  for (int i = 0; i < incomplete_block_index; i += kBlockSize) {
+    max_abs_block = _mm256_max_ps(
+        max_abs_block, _mm256_andnot_ps(sign_mask, _mm256_loadu_ps(&x[i])));
+  }
+  __m128 max_abs_half = _mm_max_ps(_mm256_extractf128_ps(max_abs_block, 1),
+                                   _mm256_castps256_ps128(max_abs_block));
+  max_abs_half =
+      _mm_max_ps(max_abs_half, _mm_movehl_ps(max_abs_half, max_abs_half));
+  max_abs_half =
+      _mm_max_ps(max_abs_half, _mm_shuffle_ps(max_abs_half, max_abs_half, 1));
+  float max_abs = _mm_cvtss_f32(max_abs_half);
+  for (int i = incomplete_block_index; i < size; ++i) {
+    max_abs = std::max(max_abs, std::fabs(x[i]));
+  }
+  if (max_abs == 0.f) {
+    std::fill(y.begin(), y.begin() + size, 0);
+    return 0.f;
+  }
+  // Scale, round and saturate.
+  const float scaling = kMaxInt16 / max_abs;
+  const __m256 scaling_block = _mm256_set1_ps(scaling);
+  for (int i = 0; i < incomplete_block_index; i += kBlockSize) {
+    const __m256i y_i = _mm256_cvtps_epi32(
+        _mm256_mul_ps(_mm256_loadu_ps(&x[i]), scaling_block));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&y[i]),
+                     _mm_packs_epi32(_mm256_castsi256_si128(y_i),
+                                     _mm256_extracti128_si256(y_i, 1)));
+  }
+  for (int i = incomplete_block_index; i < size; ++i) {
+    y[i] = QuantizeValue(x[i], scaling);
+  }
+  return max_abs / kMaxInt16;
+}
+
+int32_t VectorMath::QuantizedDotProductAvx2(
+    rtc::ArrayView<const int16_t> x,
+    rtc::ArrayView<const int8_t> y) const {
+  RTC_DCHECK(cpu_features_.avx2);
+  RTC_DCHECK_EQ(x.size(), y.size());
+  __m256i accumulator = _mm256_setzero_si256();
+  constexpr int kBlockSizeLog2 = 4;
+  constexpr int kBlockSize = 1 << kBlockSizeLog2;
+  const int incomplete_block_index = (x.size() >> kBlockSizeLog2)
+                                     << kBlockSizeLog2;
+  for (int i = 0; i < incomplete_block_index; i += kBlockSize) {
+    RTC_DCHECK_LE(i + kBlockSize, x.size());
+    const __m256i x_i =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&x[i]));
+    const __m256i y_i = _mm256_cvtepi8_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(&y[i])));
+    accumulator = _mm256_add_epi32(accumulator, _mm256_madd_epi16(x_i, y_i));
+  }
+  // Reduce `accumulator` by addition.
+  __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(accumulator),
+                              _mm256_extracti128_si256(accumulator, 1));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+  sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+  int32_t dot_product = _mm_cvtsi128_si32(sum);
+  // Add the result for the last block if incomplete.
+  for (int i = incomplete_block_index; i < rtc::dchecked_cast<int>(x.size());
+       ++i) {
+    dot_product += static_cast<int32_t>(x[i]) * static_cast<int32_t>(y[i]);
+  }
+  return dot_product;
+}
+
+void VectorMath::QuantizedMatrixVectorProductAvx2(
+    rtc::ArrayView<const int16_t> x,
+    rtc::ArrayView<const int8_t> matrix,
+    rtc::ArrayView<int32_t> y) const {
+  RTC_DCHECK(cpu_features_.avx2);
+  RTC_DCHECK_EQ(matrix.size(), x.size() * y.size());
+  const int num_columns = rtc::dchecked_cast<int>(x.size());
+  const int num_rows = rtc::dchecked_cast<int>(y.size());
+  constexpr int kBlockSize = 16;
+  constexpr int kNumRowsPerBlock = 8;
+  int r = 0;
+  // Process 8 rows at a time, so that the horizontal reduction of the
+  // accumulators is shared. Only possible if no row has an incomplete block.
+  if (num_columns % kBlockSize == 0) {
+    for (; r + kNumRowsPerBlock <= num_rows; r += kNumRowsPerBlock) {
+      __m256i accumulators[kNumRowsPerBlock];
+      for (__m256i& accumulator : accumulators) {
+        accumulator = _mm256_setzero_si256();
+      }
+      for (int i = 0; i < num_columns; i += kBlockSize) {
+        const __m256i x_i =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&x[i]));
+        for (int k = 0; k < kNumRowsPerBlock; ++k) {
+          const __m256i m_i = _mm256_cvtepi8_epi16(_mm_loadu_si128(
+              reinterpret_cast<const __m128i*>(&matrix[(r + k) * num_columns +
+                                                       i])));
+          accumulators[k] =
+              _mm256_add_epi32(accumulators[k], _mm256_madd_epi16(x_i, m_i));
+        }
+      }
+      // Reduce the accumulators so that the k-th element of `sums` holds the
+      // sum of the elements of `accumulators[k]`.
+      const __m256i sums_0123 = _mm256_hadd_epi32(
+          _mm256_hadd_epi32(accumulators[0], accumulators[1]),
+          _mm256_hadd_epi32(accumulators[2], accumulators[3]));
+      const __m256i sums_4567 = _mm256_hadd_epi32(
+          _mm256_hadd_epi32(accumulators[4], accumulators[5]),
+          _mm256_hadd_epi32(accumulators[6], accumulators[7]));
+      const __m256i sums = _mm256_add_epi32(
+          _mm256_permute2x128_si256(sums_0123, sums_4567, 0x20),
+          _mm256_permute2x128_si256(sums_0123, sums_4567, 0x31));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(&y[r]), sums);
+    }
+  }
+  for (; r < num_rows; ++r) {
+    y[r] = QuantizedDotProductAvx2(
+        x, matrix.subview(r * num_columns, num_columns));
+  }
+}
+
 }  // namespace rnn_vad
 }  // namespace webrtc
@@ -10,6 +10,7 @@
 
 #include "modules/audio_processing/agc2/rnn_vad/vector_math.h"
 
+#include <array>
 #include <vector>
 
 #include "modules/audio_processing/agc2/cpu_features.h"
@@ -41,6 +42,88 @@ TEST_P(VectorMathParametrization, TestDotProduct) {
       kEnergyOfXSubspan);
 }
 
+TEST_P(VectorMathParametrization, TestQuantizedDotProduct) {
+  // Sizes covering complete and incomplete SSE2/NEON and AVX2 blocks.
+  constexpr int kSizes[] = {1, 7, 8, 15, 16, 17, 42, 48};
+  constexpr int kMaxSize = 48;
+  std::array<int16_t, kMaxSize> x;
+  std::array<int8_t, kMaxSize> y;
+  for (int i = 0; i < kMaxSize; ++i) {
+    // Include the extreme values to check that there is no overflow.
+    x[i] = i % 3 == 0 ? -32768 : static_cast<int16_t>(32767 - 1234 * i);
+    y[i] = i % 2 == 0 ? -128 : static_cast<int8_t>(127 - 11 * i);
+  }
+  VectorMath vector_math(/*cpu_features=*/GetParam());
+  for (int size : kSizes) {
+    SCOPED_TRACE(size);
+    int32_t expected = 0;
+    for (int i = 0; i < size; ++i) {
+      expected += static_cast<int32_t>(x[i]) * static_cast<int32_t>(y[i]);
+    }
+    rtc::ArrayView<const int16_t> x_view(x.data(), size);
+    rtc::ArrayView<const int8_t> y_view(y.data(), size);
+    EXPECT_EQ(vector_math.QuantizedDotProduct(x_view, y_view), expected);
+  }
+}
+
+TEST_P(VectorMathParametrization, TestQuantizedMatrixVectorProduct) {
+  // Matrix sizes with and without complete blocks of rows and columns.
+  constexpr int kNumRows[] = {1, 8, 13, 24};
+  constexpr int kNumColumns[] = {5, 16, 48};
+  VectorMath vector_math(/*cpu_features=*/GetParam());
+  for (int num_rows : kNumRows) {
+    for (int num_columns : kNumColumns) {
+      SCOPED_TRACE(num_rows);
+      SCOPED_TRACE(num_columns);
+      std::vector<int16_t> x(num_columns);
+      for (int i = 0; i < num_columns; ++i) {
+        x[i] = static_cast<int16_t>(32767 - 2731 * i);
+      }
+      std::vector<int8_t> matrix(num_rows * num_columns);
+      for (size_t i = 0; i < matrix.size(); ++i) {
+        matrix[i] = static_cast<int8_t>(127 - 37 * i);
+      }
+      std::vector<int32_t> y(num_rows);
+      vector_math.QuantizedMatrixVectorProduct(x, matrix, y);
+      for (int r = 0; r < num_rows; ++r) {
+        int32_t expected = 0;
+        for (int c = 0; c < num_columns; ++c) {
+          expected += static_cast<int32_t>(x[c]) *
+                      static_cast<int32_t>(matrix[r * num_columns + c]);
+        }
+        EXPECT_EQ(y[r], expected) << "Row " << r;
+      }
+    }
+  }
+}
+
+TEST_P(VectorMathParametrization, TestQuantizeToInt16) {
+  VectorMath vector_math(/*cpu_features=*/GetParam());
+  std::array<int16_t, GetQuantizedVectorSize(kSizeOfX)> y;
+  y.fill(1);
+  const float scaling = vector_math.QuantizeToInt16(kX, y);
+  for (int i = 0; i < kSizeOfX; ++i) {
+    EXPECT_NEAR(scaling * y[i], kX[i], scaling / 2.f);
+  }
+  // The largest absolute value is mapped onto the largest int16 value.
+  EXPECT_EQ(y[4], -32767);
+  // The padding is zeroed.
+  for (size_t i = kSizeOfX; i < y.size(); ++i) {
+    EXPECT_EQ(y[i], 0);
+  }
+}
+
+TEST_P(VectorMathParametrization, TestQuantizeToInt16ZeroInput) {
+  VectorMath vector_math(/*cpu_features=*/GetParam());
+  constexpr std::array<float, kSizeOfX> kZeros{};
+  std::array<int16_t, GetQuantizedVectorSize(kSizeOfX)> y;
+  y.fill(1);
+  EXPECT_EQ(vector_math.QuantizeToInt16(kZeros, y), 0.f);
+  for (int16_t y_i : y) {
+    EXPECT_EQ(y_i, 0);
+  }
+}
+
 // Finds the relevant CPU features combinations to test.
 std::vector<AvailableCpuFeatures> GetCpuFeaturesToTest() {
   std::vector<AvailableCpuFeatures> v;
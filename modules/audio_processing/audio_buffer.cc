@@ -359,11 +359,19 @@ void AudioBuffer::CopyTo(const StreamConfig& stream_config,
 }
 
 void AudioBuffer::SplitIntoFrequencyBands() {
-  splitting_filter_->Analysis(data_.get(), split_data_.get());
+  SplitIntoFrequencyBands(/*worker_pool=*/nullptr);
+}
+
+void AudioBuffer::SplitIntoFrequencyBands(WorkerPool* worker_pool) {
+  splitting_filter_->Analysis(data_.get(), split_data_.get(), worker_pool);
 }
 
 void AudioBuffer::MergeFrequencyBands() {
-  splitting_filter_->Synthesis(split_data_.get(), data_.get());
+  MergeFrequencyBands(/*worker_pool=*/nullptr);
+}
+
+void AudioBuffer::MergeFrequencyBands(WorkerPool* worker_pool) {
+  splitting_filter_->Synthesis(split_data_.get(), data_.get(), worker_pool);
 }
 
 void AudioBuffer::ExportSplitChannelData(
@@ -24,6 +24,7 @@ namespace webrtc {
 
 class PushSincResampler;
 class SplittingFilter;
+class WorkerPool;
 
 enum Band { kBand0To8kHz = 0, kBand8To16kHz = 1, kBand16To24kHz = 2 };
 
@@ -113,11 +114,14 @@ class AudioBuffer {
   void CopyTo(const StreamConfig& stream_config, float* const* stacked_data);
   void CopyTo(AudioBuffer* buffer) const;
 
-  // Splits the buffer data into frequency bands.
+  // Splits the buffer data into frequency bands. The channels are split in
+  // parallel if `worker_pool` is not null.
   void SplitIntoFrequencyBands();
+  void SplitIntoFrequencyBands(WorkerPool* worker_pool);
 
   // Recombines the frequency bands into a full-band signal.
   void MergeFrequencyBands();
+  void MergeFrequencyBands(WorkerPool* worker_pool);
 
   // Copies the split bands data into the integer two-dimensional array.
   void ExportSplitChannelData(size_t channel,
@@ -31,6 +31,7 @@
 #include "modules/audio_processing/optionally_built_submodule_creators.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/numerics/safe_minmax.h"
 #include "rtc_base/time_utils.h"
 #include "rtc_base/trace_event.h"
 #include "system_wrappers/include/denormal_disabler.h"
@@ -59,6 +60,12 @@ bool EnforceSplitBandHpf() {
   return field_trial::IsEnabled("WebRTC-FullBandHpfKillSwitch");
 }
 
+// Checks whether the noise suppressor should use the faster, but not bit-exact,
+// SIMD approximation of e^x.
+bool UseVectorizedNsExpApproximation() {
+  return field_trial::IsEnabled("WebRTC-NsVectorizedExpApproximation");
+}
+
 // Checks whether AEC3 should be allowed to decide what the default
 // configuration should be based on the render and capture channel configuration
 // at hand.
@@ -404,6 +411,7 @@ void AudioProcessingImpl::InitializeLocked() {
   InitializePostProcessor();
   InitializePreProcessor();
   InitializeCaptureLevelsAdjuster();
+  InitializeWorkerPool();
 
   if (aec_dump_) {
     aec_dump_->WriteInitMessage(formats_.api_format, rtc::TimeUTCMillis());
@@ -579,6 +587,8 @@ void AudioProcessingImpl::ApplyConfig(const AudioProcessing::Config& config) {
     InitializeCaptureLevelsAdjuster();
   }
 
+  InitializeWorkerPool();
+
   // Reinitialization must happen after all submodule configuration to avoid
   // additional reinitializations on the next capture / render processing call.
   if (pipeline_config_changed) {
@@ -1167,7 +1177,7 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
   if (submodule_states_.CaptureMultiBandSubModulesActive() &&
       SampleRateSupportsMultiBand(
           capture_nonlocked_.capture_processing_format.sample_rate_hz())) {
-    capture_buffer->SplitIntoFrequencyBands();
+    capture_buffer->SplitIntoFrequencyBands(capture_.worker_pool.get());
   }
 
   const bool multi_channel_capture = config_.pipeline.multi_channel_capture &&
@@ -1195,7 +1205,8 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
   if ((!config_.noise_suppression.analyze_linear_aec_output_when_available ||
        !linear_aec_buffer || submodules_.echo_control_mobile) &&
       submodules_.noise_suppressor) {
-    submodules_.noise_suppressor->Analyze(*capture_buffer);
+    submodules_.noise_suppressor->Analyze(*capture_buffer,
+                                          capture_.worker_pool.get());
   }
 
   if (submodules_.echo_control_mobile) {
@@ -1206,7 +1217,8 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
     }
 
     if (submodules_.noise_suppressor) {
-      submodules_.noise_suppressor->Process(capture_buffer);
+      submodules_.noise_suppressor->Process(capture_buffer,
+                                            capture_.worker_pool.get());
     }
 
     RETURN_ON_ERR(submodules_.echo_control_mobile->ProcessCaptureAudio(
@@ -1225,11 +1237,13 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
 
     if (config_.noise_suppression.analyze_linear_aec_output_when_available &&
         linear_aec_buffer && submodules_.noise_suppressor) {
-      submodules_.noise_suppressor->Analyze(*linear_aec_buffer);
+      submodules_.noise_suppressor->Analyze(*linear_aec_buffer,
+                                            capture_.worker_pool.get());
     }
 
     if (submodules_.noise_suppressor) {
-      submodules_.noise_suppressor->Process(capture_buffer);
+      submodules_.noise_suppressor->Process(capture_buffer,
+                                            capture_.worker_pool.get());
     }
   }
 
@@ -1252,7 +1266,7 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
   if (submodule_states_.CaptureMultiBandProcessingPresent() &&
       SampleRateSupportsMultiBand(
           capture_nonlocked_.capture_processing_format.sample_rate_hz())) {
-    capture_buffer->MergeFrequencyBands();
+    capture_buffer->MergeFrequencyBands(capture_.worker_pool.get());
   }
 
   if (capture_.capture_output_used) {
@@ -1972,6 +1986,7 @@ void AudioProcessingImpl::InitializeNoiseSuppressor() {
 
     NsConfig cfg;
     cfg.target_level = map_level(config_.noise_suppression.level);
+    cfg.vectorized_exp_approximation = UseVectorizedNsExpApproximation();
     submodules_.noise_suppressor = std::make_unique<NoiseSuppressor>(
         cfg, proc_sample_rate_hz(), num_proc_channels());
   }
@@ -2016,6 +2031,21 @@ void AudioProcessingImpl::InitializeAnalyzer() {
   }
 }
 
+void AudioProcessingImpl::InitializeWorkerPool() {
+  const int num_worker_threads =
+      rtc::SafeClamp(config_.pipeline.num_worker_threads, 0,
+                     WorkerPool::kMaxNumWorkerThreads);
+  if (num_worker_threads == 0) {
+    capture_.worker_pool.reset();
+  } else if (!capture_.worker_pool ||
+             capture_.worker_pool->num_worker_threads() != num_worker_threads) {
+    // Not realtime, so that the workers cannot starve the audio device
+    // thread.
+    capture_.worker_pool = std::make_unique<WorkerPool>(
+        num_worker_threads, "ApmWorker", rtc::ThreadPriority::kHigh);
+  }
+}
+
 void AudioProcessingImpl::InitializePostProcessor() {
   if (submodules_.capture_post_processor) {
     submodules_.capture_post_processor->Initialize(
@@ -46,6 +46,7 @@
 #include "rtc_base/swap_queue.h"
 #include "rtc_base/synchronization/mutex.h"
 #include "rtc_base/thread_annotations.h"
+#include "rtc_base/worker_pool.h"
 
 namespace webrtc {
 
@@ -290,6 +291,7 @@ class AudioProcessingImpl : public AudioProcessing {
       RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
   void InitializePostProcessor() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
   void InitializeAnalyzer() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
+  void InitializeWorkerPool() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_capture_);
 
   // Initializations of render-only submodules, requiring the render lock
   // already acquired.
@@ -473,6 +475,8 @@ class AudioProcessingImpl : public AudioProcessing {
     int prev_playout_volume;
     AudioProcessingStats stats;
     int cached_stream_analog_level_ = 0;
+    // Runs the per-channel capture processing in parallel, if set.
+    std::unique_ptr<WorkerPool> worker_pool;
   } capture_ RTC_GUARDED_BY(mutex_capture_);
 
   struct ApmCaptureNonLockedState {
@@ -12,6 +12,7 @@
 
 #include <array>
 #include <memory>
+#include <vector>
 
 #include "api/make_ref_counted.h"
 #include "api/scoped_refptr.h"
@@ -667,6 +668,74 @@ TEST(AudioProcessingImplTest, RenderPreProcessorBeforeEchoDetector) {
             test_echo_detector->last_render_audio_first_sample());
 }
 
+TEST(AudioProcessingImplTest, WorkerThreadsDoNotAffectOutput) {
+  constexpr int kNumChannels = 8;
+  for (int sample_rate_hz : {32000, 48000}) {
+    SCOPED_TRACE(sample_rate_hz);
+    AudioProcessing::Config apm_config;
+    apm_config.pipeline.multi_channel_capture = true;
+    apm_config.echo_canceller.enabled = true;
+    apm_config.noise_suppression.enabled = true;
+    apm_config.gain_controller1.enabled = false;
+    apm_config.gain_controller2.enabled = true;
+    rtc::scoped_refptr<AudioProcessing> apm_reference =
+        AudioProcessingBuilderForTesting().Create();
+    apm_reference->ApplyConfig(apm_config);
+    apm_config.pipeline.num_worker_threads = 3;
+    rtc::scoped_refptr<AudioProcessing> apm =
+        AudioProcessingBuilderForTesting().Create();
+    apm->ApplyConfig(apm_config);
+
+    const size_t num_frames = sample_rate_hz / 100;
+    std::vector<std::vector<float>> render(kNumChannels,
+                                           std::vector<float>(num_frames));
+    std::vector<std::vector<float>> capture(kNumChannels,
+                                            std::vector<float>(num_frames));
+    std::vector<std::vector<float>> capture_reference = capture;
+    std::vector<float*> render_pointers(kNumChannels);
+    std::vector<float*> capture_pointers(kNumChannels);
+    std::vector<float*> capture_reference_pointers(kNumChannels);
+    for (int ch = 0; ch < kNumChannels; ++ch) {
+      render_pointers[ch] = render[ch].data();
+      capture_pointers[ch] = capture[ch].data();
+      capture_reference_pointers[ch] = capture_reference[ch].data();
+    }
+    StreamConfig stream_config(sample_rate_hz, kNumChannels);
+    Random random_generator(2341U);
+    constexpr int kNumFramesToProcess = 40;
+    for (int i = 0; i < kNumFramesToProcess; ++i) {
+      if (i == kNumFramesToProcess / 2) {
+        // Changing the number of threads must not disrupt the processing.
+        apm_config.pipeline.num_worker_threads = 1;
+        apm->ApplyConfig(apm_config);
+      }
+      for (int ch = 0; ch < kNumChannels; ++ch) {
+        RandomizeSampleVector(&random_generator, render[ch]);
+        RandomizeSampleVector(&random_generator, capture[ch]);
+        capture_reference[ch] = capture[ch];
+      }
+      ASSERT_EQ(apm->ProcessReverseStream(render_pointers.data(), stream_config,
+                                          stream_config,
+                                          render_pointers.data()),
+                kNoErr);
+      ASSERT_EQ(apm_reference->ProcessReverseStream(
+                    render_pointers.data(), stream_config, stream_config,
+                    render_pointers.data()),
+                kNoErr);
+      ASSERT_EQ(apm->ProcessStream(capture_pointers.data(), stream_config,
+                                   stream_config, capture_pointers.data()),
+                kNoErr);
+      ASSERT_EQ(apm_reference->ProcessStream(
+                    capture_reference_pointers.data(), stream_config,
+                    stream_config, capture_reference_pointers.data()),
+                kNoErr);
+      for (int ch = 0; ch < kNumChannels; ++ch) {
+        ASSERT_EQ(capture[ch], capture_reference[ch]);
+      }
+    }
+  }
+}
+
 // Disabling build-optional submodules and trying to enable them via the APM
 // config should be bit-exact with running APM with said submodules disabled.
 // This mainly tests that SetCreateOptionalSubmodulesForTesting has an effect.
@@ -12,6 +12,7 @@
 #include <algorithm>
 #include <atomic>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "api/array_view.h"
@@ -43,22 +44,26 @@ enum class SettingsType {
   kDefaultApmMobile,
   kAllSubmodulesTurnedOff,
   kDefaultApmDesktopWithoutDelayAgnostic,
-  kDefaultApmDesktopWithoutExtendedFilter
+  kDefaultApmDesktopWithoutExtendedFilter,
+  kDefaultApmDesktopMultiChannel
 };
 
+// The number of capture channels of the multichannel settings, e.g. a
+// microphone array.
+constexpr int kNumMultiChannelCaptureChannels = 8;
+
 // Variables related to the audio data and formats.
 struct AudioFrameData {
-  explicit AudioFrameData(size_t max_frame_size) {
+  AudioFrameData(size_t max_frame_size, size_t max_num_channels) {
     // Set up the two-dimensional arrays needed for the APM API calls.
-    input_framechannels.resize(2 * max_frame_size);
-    input_frame.resize(2);
-    input_frame[0] = &input_framechannels[0];
-    input_frame[1] = &input_framechannels[max_frame_size];
-
-    output_frame_channels.resize(2 * max_frame_size);
-    output_frame.resize(2);
-    output_frame[0] = &output_frame_channels[0];
-    output_frame[1] = &output_frame_channels[max_frame_size];
+    input_framechannels.resize(max_num_channels * max_frame_size);
+    input_frame.resize(max_num_channels);
+    output_frame_channels.resize(max_num_channels * max_frame_size);
+    output_frame.resize(max_num_channels);
+    for (size_t ch = 0; ch < max_num_channels; ++ch) {
+      input_frame[ch] = &input_framechannels[ch * max_frame_size];
+      output_frame[ch] = &output_frame_channels[ch * max_frame_size];
+    }
   }
 
   std::vector<float> output_frame_channels;
@@ -71,9 +76,12 @@ struct AudioFrameData {
 
 // The configuration for the test.
 struct SimulationConfig {
-  SimulationConfig(int sample_rate_hz, SettingsType simulation_settings)
+  SimulationConfig(int sample_rate_hz,
+                   SettingsType simulation_settings,
+                   int num_worker_threads = 0)
       : sample_rate_hz(sample_rate_hz),
-        simulation_settings(simulation_settings) {}
+        simulation_settings(simulation_settings),
+        num_worker_threads(num_worker_threads) {}
 
   static std::vector<SimulationConfig> GenerateSimulationConfigs() {
     std::vector<SimulationConfig> simulation_configs;
@@ -90,6 +98,17 @@ struct SimulationConfig {
         simulation_configs.push_back(SimulationConfig(sample_rate, settings));
       }
     }
+
+    // Compare the capture processing of a microphone array on the capture
+    // thread only to that with the channels spread over worker threads.
+    const int multi_channel_sample_rates[] = {16000, 48000};
+    for (auto sample_rate : multi_channel_sample_rates) {
+      for (int num_worker_threads : {0, 3}) {
+        simulation_configs.push_back(SimulationConfig(
+            sample_rate, SettingsType::kDefaultApmDesktopMultiChannel,
+            num_worker_threads));
+      }
+    }
 #endif
 
     const SettingsType mobile_settings[] = {SettingsType::kDefaultApmMobile};
@@ -123,12 +142,19 @@ struct SimulationConfig {
       case SettingsType::kDefaultApmDesktopWithoutExtendedFilter:
         description = "DefaultApmDesktopWithoutExtendedFilter";
         break;
+      case SettingsType::kDefaultApmDesktopMultiChannel:
+        description = "DefaultApmDesktopMultiChannel";
+        break;
+    }
+    if (num_worker_threads > 0) {
+      description += "_" + std::to_string(num_worker_threads) + "WorkerThreads";
     }
     return description;
   }
 
   int sample_rate_hz = 16000;
   SettingsType simulation_settings = SettingsType::kDefaultApmDesktop;
+  int num_worker_threads = 0;
 };
 
 // Handler for the frame counters.
@@ -199,7 +225,7 @@ class TimedThreadApiProcessor {
         test_(test_framework),
         simulation_config_(simulation_config),
         apm_(apm),
-        frame_data_(kMaxFrameSize),
+        frame_data_(kMaxFrameSize, num_channels),
         clock_(webrtc::Clock::GetRealTimeClock()),
         num_durations_to_store_(num_durations_to_store),
         input_level_(input_level),
@@ -222,6 +248,14 @@ class TimedThreadApiProcessor {
         "apm_timing", sample_rate_name, processor_name, GetDurationAverage(),
         GetDurationStandardDeviation(), "us", false);
 
+    // The tail of the per-frame processing time is what determines whether
+    // the processing fits within the duration of a frame.
+    for (int percentile : {50, 90, 99}) {
+      webrtc::test::PrintResult(
+          "apm_timing", sample_rate_name + "_p" + std::to_string(percentile),
+          processor_name, GetDurationPercentile(percentile), "us", false);
+    }
+
     if (kPrintAllDurations) {
       webrtc::test::PrintResultList("apm_call_durations", sample_rate_name,
                                     processor_name, api_call_durations_, "us",
@@ -266,6 +300,19 @@ class TimedThreadApiProcessor {
     return (denominator > 0 ? average_duration / denominator : -1);
   }
 
+  double GetDurationPercentile(int percentile) const {
+    if (api_call_durations_.size() <= kNumInitializationFrames) {
+      return -1;
+    }
+    std::vector<double> durations(
+        api_call_durations_.begin() + kNumInitializationFrames,
+        api_call_durations_.end());
+    const size_t index = (durations.size() - 1) * percentile / 100;
+    std::nth_element(durations.begin(), durations.begin() + index,
+                     durations.end());
+    return durations[index];
+  }
+
   int ProcessCapture() {
     // Set the stream delay.
     apm_->set_stream_delay_ms(30);
@@ -354,7 +401,7 @@ class TimedThreadApiProcessor {
     // Prepare the float audio output data and metadata.
     frame_data_.output_stream_config.set_sample_rate_hz(
         simulation_config_->sample_rate_hz);
-    frame_data_.output_stream_config.set_num_channels(1);
+    frame_data_.output_stream_config.set_num_channels(num_channels_);
   }
 
   bool ReadyToProcess() {
@@ -468,6 +515,15 @@ class CallSimulator : public ::testing::TestWithParam<SimulationConfig> {
       apm->ApplyConfig(apm_config);
     };
 
+    // Lambda function for setting the default APM runtime settings for desktop
+    // with multichannel capture.
+    auto set_default_multi_channel_apm_runtime_settings =
+        [](AudioProcessing* apm) {
+          AudioProcessing::Config apm_config = apm->GetConfig();
+          apm_config.pipeline.multi_channel_capture = true;
+          apm->ApplyConfig(apm_config);
+        };
+
     int num_capture_channels = 1;
     switch (simulation_config_.simulation_settings) {
       case SettingsType::kDefaultApmMobile: {
@@ -500,8 +556,21 @@ class CallSimulator : public ::testing::TestWithParam<SimulationConfig> {
         set_default_desktop_apm_runtime_settings(apm_.get());
         break;
       }
+      case SettingsType::kDefaultApmDesktopMultiChannel: {
+        apm_ = AudioProcessingBuilderForTesting().Create();
+        ASSERT_TRUE(!!apm_);
+        set_default_desktop_apm_runtime_settings(apm_.get());
+        set_default_multi_channel_apm_runtime_settings(apm_.get());
+        num_capture_channels = kNumMultiChannelCaptureChannels;
+        break;
+      }
     }
 
+    AudioProcessing::Config apm_config = apm_->GetConfig();
+    apm_config.pipeline.num_worker_threads =
+        simulation_config_.num_worker_threads;
+    apm_->ApplyConfig(apm_config);
+
     render_thread_state_.reset(new TimedThreadApiProcessor(
         ProcessorType::kRender, &rand_gen_, &frame_counters_,
         &capture_call_checker_, this, &simulation_config_, apm_.get(),
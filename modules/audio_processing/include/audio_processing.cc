@@ -125,6 +125,7 @@ std::string AudioProcessing::Config::ToString() const {
           << pipeline.maximum_internal_processing_rate
           << ", multi_channel_render: " << pipeline.multi_channel_render
           << ", multi_channel_capture: " << pipeline.multi_channel_capture
+          << ", num_worker_threads: " << pipeline.num_worker_threads
           << " }, pre_amplifier: { enabled: " << pre_amplifier.enabled
           << ", fixed_gain_factor: " << pre_amplifier.fixed_gain_factor
           << " },capture_level_adjustment: { enabled: "
@@ -169,6 +169,12 @@ class RTC_EXPORT AudioProcessing : public rtc::RefCountInterface {
       // Allow multi-channel processing of capture audio when AEC3 is active
       // or a custom AEC is injected..
       bool multi_channel_capture = false;
+      // Number of threads, in addition to the capture thread, that the
+      // independent per-channel parts of the capture processing are spread
+      // over, e.g. for devices with many microphones. The output does not
+      // depend on this setting. At most 8 threads are used, and they run with
+      // high, not realtime, priority.
+      int num_worker_threads = 0;
     } pipeline;
 
     // Enabled the pre-amplifier. It amplifies the capture signal
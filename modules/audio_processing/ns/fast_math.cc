@@ -10,6 +10,9 @@
 
 #include "modules/audio_processing/ns/fast_math.h"
 
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
 #include <math.h>
 #include <stdint.h>
 
@@ -43,6 +46,13 @@ float SqrtFastApproximation(float f) {
   return sqrtf(f);
 }
 
+void SqrtFastApproximation(rtc::ArrayView<const float> x,
+                           rtc::ArrayView<float> y) {
+  for (size_t k = 0; k < x.size(); ++k) {
+    y[k] = SqrtFastApproximation(x[k]);
+  }
+}
+
 float Pow2Approximation(float p) {
   // TODO(peah): Add fast approximate implementation.
   return powf(2.f, p);
@@ -81,4 +91,186 @@ void ExpApproximationSignFlip(rtc::ArrayView<const float> x,
   }
 }
 
+void SqrtFastApproximation(const AvailableCpuFeatures& cpu_features,
+                           rtc::ArrayView<const float> x,
+                           rtc::ArrayView<float> y) {
+  RTC_DCHECK_EQ(x.size(), y.size());
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (cpu_features.avx2) {
+    ns::SqrtFastApproximation_Avx2(x, y);
+    return;
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  if (cpu_features.neon) {
+    ns::SqrtFastApproximation_Neon(x, y);
+    return;
+  }
+#endif
+  SqrtFastApproximation(x, y);
+}
+
+void LogApproximation(const AvailableCpuFeatures& cpu_features,
+                      rtc::ArrayView<const float> x,
+                      rtc::ArrayView<float> y) {
+  RTC_DCHECK_EQ(x.size(), y.size());
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (cpu_features.avx2) {
+    ns::LogApproximation_Avx2(x, y);
+    return;
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  if (cpu_features.neon) {
+    ns::LogApproximation_Neon(x, y);
+    return;
+  }
+#endif
+  LogApproximation(x, y);
+}
+
+void ExpApproximation(const AvailableCpuFeatures& cpu_features,
+                      rtc::ArrayView<const float> x,
+                      rtc::ArrayView<float> y) {
+  RTC_DCHECK_EQ(x.size(), y.size());
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (cpu_features.avx2) {
+    ns::ExpApproximation_Avx2(x, y);
+    return;
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  if (cpu_features.neon) {
+    ns::ExpApproximation_Neon(x, y);
+    return;
+  }
+#endif
+  ExpApproximation(x, y);
+}
+
+void ExpApproximationSignFlip(const AvailableCpuFeatures& cpu_features,
+                              rtc::ArrayView<const float> x,
+                              rtc::ArrayView<float> y) {
+  RTC_DCHECK_EQ(x.size(), y.size());
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (cpu_features.avx2) {
+    ns::ExpApproximationSignFlip_Avx2(x, y);
+    return;
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  if (cpu_features.neon) {
+    ns::ExpApproximationSignFlip_Neon(x, y);
+    return;
+  }
+#endif
+  ExpApproximationSignFlip(x, y);
+}
+
+#if defined(WEBRTC_HAS_NEON)
+namespace ns {
+
+namespace {
+
+// Vector version of FastLog2f().
+float32x4_t FastLog2Neon(float32x4_t x) {
+  float32x4_t out = vcvtq_f32_u32(vreinterpretq_u32_f32(x));
+  out = vmulq_f32(out, vdupq_n_f32(1.1920929e-7f));
+  return vsubq_f32(out, vdupq_n_f32(126.942695f));
+}
+
+// Computes 2^p by splitting p into an integer part, which is applied directly
+// to the exponent, and a fractional part in [-0.5, 0.5], for which a
+// polynomial approximation is used.
+float32x4_t Pow2Neon(float32x4_t p) {
+  p = vminq_f32(vmaxq_f32(p, vdupq_n_f32(-126.f)), vdupq_n_f32(127.f));
+  // Round to nearest, using that the truncation towards zero by
+  // vcvtq_s32_f32() needs to be adjusted for negative values.
+  const float32x4_t p_plus_half = vaddq_f32(p, vdupq_n_f32(0.5f));
+  int32x4_t integer_part = vcvtq_s32_f32(p_plus_half);
+  const uint32x4_t too_large =
+      vcgtq_f32(vcvtq_f32_s32(integer_part), p_plus_half);
+  integer_part = vsubq_s32(integer_part,
+                           vandq_s32(vreinterpretq_s32_u32(too_large),
+                                     vdupq_n_s32(1)));
+  const float32x4_t f = vsubq_f32(p, vcvtq_f32_s32(integer_part));
+
+  float32x4_t poly = vdupq_n_f32(1.535336188319500e-4f);
+  poly = vmlaq_f32(vdupq_n_f32(1.339887440266574e-3f), poly, f);
+  poly = vmlaq_f32(vdupq_n_f32(9.618437357674640e-3f), poly, f);
+  poly = vmlaq_f32(vdupq_n_f32(5.550332471162809e-2f), poly, f);
+  poly = vmlaq_f32(vdupq_n_f32(2.402264791363012e-1f), poly, f);
+  poly = vmlaq_f32(vdupq_n_f32(6.931472028550421e-1f), poly, f);
+  poly = vmlaq_f32(vdupq_n_f32(1.f), poly, f);
+
+  const int32x4_t exponent =
+      vshlq_n_s32(vaddq_s32(integer_part, vdupq_n_s32(127)), 23);
+  return vmulq_f32(poly, vreinterpretq_f32_s32(exponent));
+}
+
+// Computes e^x as 10^(x * log10(e)), as ExpApproximation() does.
+template <bool kSignFlip>
+void ExpApproximationNeon(rtc::ArrayView<const float> x,
+                          rtc::ArrayView<float> y) {
+  constexpr float kLog10Ofe = 0.4342944819f;
+  const float32x4_t log2_of_10 = FastLog2Neon(vdupq_n_f32(10.f));
+  const size_t num_blocks = x.size() >> 2;
+  for (size_t k = 0; k < num_blocks * 4; k += 4) {
+    float32x4_t x_k = vld1q_f32(&x[k]);
+    if (kSignFlip) {
+      x_k = vnegq_f32(x_k);
+    }
+    const float32x4_t p =
+        vmulq_f32(vmulq_f32(x_k, vdupq_n_f32(kLog10Ofe)), log2_of_10);
+    vst1q_f32(&y[k], Pow2Neon(p));
+  }
+  for (size_t k = num_blocks * 4; k < x.size(); ++k) {
+    y[k] = ExpApproximation(kSignFlip ? -x[k] : x[k]);
+  }
+}
+
+}  // namespace
+
+void SqrtFastApproximation_Neon(rtc::ArrayView<const float> x,
+                                rtc::ArrayView<float> y) {
+#if defined(WEBRTC_ARCH_ARM64)
+  const size_t num_blocks = x.size() >> 2;
+  for (size_t k = 0; k < num_blocks * 4; k += 4) {
+    vst1q_f32(&y[k], vsqrtq_f32(vld1q_f32(&x[k])));
+  }
+  for (size_t k = num_blocks * 4; k < x.size(); ++k) {
+    y[k] = SqrtFastApproximation(x[k]);
+  }
+#else
+  // ARMv7 NEON has no square root instruction.
+  SqrtFastApproximation(x, y);
+#endif
+}
+
+void LogApproximation_Neon(rtc::ArrayView<const float> x,
+                           rtc::ArrayView<float> y) {
+  constexpr float kLogOf2 = 0.69314718056f;
+  const size_t num_blocks = x.size() >> 2;
+  for (size_t k = 0; k < num_blocks * 4; k += 4) {
+    const float32x4_t log2_x = FastLog2Neon(vld1q_f32(&x[k]));
+    vst1q_f32(&y[k], vmulq_f32(log2_x, vdupq_n_f32(kLogOf2)));
+  }
+  for (size_t k = num_blocks * 4; k < x.size(); ++k) {
+    y[k] = LogApproximation(x[k]);
+  }
+}
+
+void ExpApproximation_Neon(rtc::ArrayView<const float> x,
+                           rtc::ArrayView<float> y) {
+  ExpApproximationNeon</*kSignFlip=*/false>(x, y);
+}
+
+void ExpApproximationSignFlip_Neon(rtc::ArrayView<const float> x,
+                                   rtc::ArrayView<float> y) {
+  ExpApproximationNeon</*kSignFlip=*/true>(x, y);
+}
+
+}  // namespace ns
+#endif
+
 }  // namespace webrtc
@@ -12,11 +12,15 @@
 #define MODULES_AUDIO_PROCESSING_NS_FAST_MATH_H_
 
 #include "api/array_view.h"
+#include "modules/audio_processing/agc2/cpu_features.h"
+#include "rtc_base/system/arch.h"
 
 namespace webrtc {
 
 // Sqrt approximation.
 float SqrtFastApproximation(float f);
+void SqrtFastApproximation(rtc::ArrayView<const float> x,
+                           rtc::ArrayView<float> y);
 
 // Log base conversion log(x) = log2(x)/log2(e).
 float LogApproximation(float x);
@@ -33,6 +37,53 @@ float ExpApproximation(float x);
 void ExpApproximation(rtc::ArrayView<const float> x, rtc::ArrayView<float> y);
 void ExpApproximationSignFlip(rtc::ArrayView<const float> x,
                               rtc::ArrayView<float> y);
+
+// Versions of the vector approximations above that use the SIMD
+// implementations below when `cpu_features` allows it. The square root and
+// logarithm match the scalar versions up to floating point rounding, while the
+// exponential uses a polynomial approximation which deviates from the scalar
+// version by a few ulps and saturates outside of [2^-126, 2^127]. The noise
+// suppressor therefore only uses the SIMD exponential when
+// `NsConfig::vectorized_exp_approximation` is set.
+void SqrtFastApproximation(const AvailableCpuFeatures& cpu_features,
+                           rtc::ArrayView<const float> x,
+                           rtc::ArrayView<float> y);
+void LogApproximation(const AvailableCpuFeatures& cpu_features,
+                      rtc::ArrayView<const float> x,
+                      rtc::ArrayView<float> y);
+void ExpApproximation(const AvailableCpuFeatures& cpu_features,
+                      rtc::ArrayView<const float> x,
+                      rtc::ArrayView<float> y);
+void ExpApproximationSignFlip(const AvailableCpuFeatures& cpu_features,
+                              rtc::ArrayView<const float> x,
+                              rtc::ArrayView<float> y);
+
+namespace ns {
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void SqrtFastApproximation_Avx2(rtc::ArrayView<const float> x,
+                                rtc::ArrayView<float> y);
+void LogApproximation_Avx2(rtc::ArrayView<const float> x,
+                           rtc::ArrayView<float> y);
+void ExpApproximation_Avx2(rtc::ArrayView<const float> x,
+                           rtc::ArrayView<float> y);
+void ExpApproximationSignFlip_Avx2(rtc::ArrayView<const float> x,
+                                   rtc::ArrayView<float> y);
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+void SqrtFastApproximation_Neon(rtc::ArrayView<const float> x,
+                                rtc::ArrayView<float> y);
+void LogApproximation_Neon(rtc::ArrayView<const float> x,
+                           rtc::ArrayView<float> y);
+void ExpApproximation_Neon(rtc::ArrayView<const float> x,
+                           rtc::ArrayView<float> y);
+void ExpApproximationSignFlip_Neon(rtc::ArrayView<const float> x,
+                                   rtc::ArrayView<float> y);
+#endif
+
+}  // namespace ns
+
 }  // namespace webrtc
 
 #endif  // MODULES_AUDIO_PROCESSING_NS_FAST_MATH_H_
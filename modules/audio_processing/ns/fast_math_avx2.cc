@@ -0,0 +1,121 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include <algorithm>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/ns/fast_math.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace ns {
+
+namespace {
+
+// Vector version of FastLog2f(). The float bit patterns are interpreted as
+// signed integers, which is equivalent as the input is positive.
+__m256 FastLog2Avx2(__m256 x) {
+  __m256 out = _mm256_cvtepi32_ps(_mm256_castps_si256(x));
+  out = _mm256_mul_ps(out, _mm256_set1_ps(1.1920929e-7f));
+  return _mm256_sub_ps(out, _mm256_set1_ps(126.942695f));
+}
+
+// Computes 2^p by splitting p into an integer part, which is applied directly
+// to the exponent, and a fractional part in [-0.5, 0.5], for which a
+// polynomial approximation is used.
+__m256 Pow2Avx2(__m256 p) {
+  p = _mm256_min_ps(_mm256_max_ps(p, _mm256_set1_ps(-126.f)),
+                    _mm256_set1_ps(127.f));
+  const __m256 integer_part =
+      _mm256_floor_ps(_mm256_add_ps(p, _mm256_set1_ps(0.5f)));
+  const __m256 f = _mm256_sub_ps(p, integer_part);
+
+  __m256 poly = _mm256_set1_ps(1.535336188319500e-4f);
+  poly = _mm256_fmadd_ps(poly, f, _mm256_set1_ps(1.339887440266574e-3f));
+  poly = _mm256_fmadd_ps(poly, f, _mm256_set1_ps(9.618437357674640e-3f));
+  poly = _mm256_fmadd_ps(poly, f, _mm256_set1_ps(5.550332471162809e-2f));
+  poly = _mm256_fmadd_ps(poly, f, _mm256_set1_ps(2.402264791363012e-1f));
+  poly = _mm256_fmadd_ps(poly, f, _mm256_set1_ps(6.931472028550421e-1f));
+  poly = _mm256_fmadd_ps(poly, f, _mm256_set1_ps(1.f));
+
+  const __m256i exponent = _mm256_slli_epi32(
+      _mm256_add_epi32(_mm256_cvtps_epi32(integer_part),
+                       _mm256_set1_epi32(127)),
+      23);
+  return _mm256_mul_ps(poly, _mm256_castsi256_ps(exponent));
+}
+
+// Computes e^x as 10^(x * log10(e)), as ExpApproximation() does.
+template <bool kSignFlip>
+__m256 ExpApproximationAvx2(__m256 x) {
+  constexpr float kLog10Ofe = 0.4342944819f;
+  if (kSignFlip) {
+    x = _mm256_xor_ps(x, _mm256_set1_ps(-0.f));
+  }
+  const __m256 log2_of_10 = FastLog2Avx2(_mm256_set1_ps(10.f));
+  return Pow2Avx2(
+      _mm256_mul_ps(_mm256_mul_ps(x, _mm256_set1_ps(kLog10Ofe)), log2_of_10));
+}
+
+// Applies `operation` to `x` in blocks of 8 values. The remaining values are
+// processed as one block, padded with `padding`.
+template <typename Operation>
+void ApplyBlockwise(rtc::ArrayView<const float> x,
+                    rtc::ArrayView<float> y,
+                    float padding,
+                    Operation operation) {
+  RTC_DCHECK_EQ(x.size(), y.size());
+  const size_t num_full_blocks = x.size() >> 3;
+  for (size_t k = 0; k < num_full_blocks * 8; k += 8) {
+    _mm256_storeu_ps(&y[k], operation(_mm256_loadu_ps(&x[k])));
+  }
+  const size_t num_remaining = x.size() - num_full_blocks * 8;
+  if (num_remaining > 0) {
+    alignas(32) float block[8];
+    std::fill(block, block + 8, padding);
+    std::copy(x.end() - num_remaining, x.end(), block);
+    _mm256_store_ps(block, operation(_mm256_load_ps(block)));
+    std::copy(block, block + num_remaining, y.end() - num_remaining);
+  }
+}
+
+}  // namespace
+
+void SqrtFastApproximation_Avx2(rtc::ArrayView<const float> x,
+                                rtc::ArrayView<float> y) {
+  ApplyBlockwise(x, y, /*padding=*/0.f, [](__m256 x_k) {
+    return _mm256_sqrt_ps(x_k);
+  });
+}
+
+void LogApproximation_Avx2(rtc::ArrayView<const float> x,
+                           rtc::ArrayView<float> y) {
+  constexpr float kLogOf2 = 0.69314718056f;
+  ApplyBlockwise(x, y, /*padding=*/1.f, [](__m256 x_k) {
+    return _mm256_mul_ps(FastLog2Avx2(x_k), _mm256_set1_ps(kLogOf2));
+  });
+}
+
+void ExpApproximation_Avx2(rtc::ArrayView<const float> x,
+                           rtc::ArrayView<float> y) {
+  ApplyBlockwise(x, y, /*padding=*/0.f,
+                 ExpApproximationAvx2</*kSignFlip=*/false>);
+}
+
+void ExpApproximationSignFlip_Avx2(rtc::ArrayView<const float> x,
+                                   rtc::ArrayView<float> y) {
+  ApplyBlockwise(x, y, /*padding=*/0.f,
+                 ExpApproximationAvx2</*kSignFlip=*/true>);
+}
+
+}  // namespace ns
+}  // namespace webrtc
@@ -0,0 +1,166 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/ns/fast_math.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "modules/audio_processing/agc2/cpu_features.h"
+#include "rtc_base/random.h"
+#include "rtc_base/system/arch.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+// Sizes covering both full SIMD blocks and remaining elements.
+constexpr size_t kSizes[] = {1, 7, 8, 15, 128, 129};
+
+std::vector<float> RandomVector(Random* random,
+                                size_t size,
+                                float min_value,
+                                float max_value) {
+  std::vector<float> x(size);
+  for (float& x_k : x) {
+    x_k = min_value + (max_value - min_value) * random->Rand<float>();
+  }
+  return x;
+}
+
+void ExpectNearRelative(const std::vector<float>& reference,
+                        const std::vector<float>& y,
+                        float relative_tolerance) {
+  ASSERT_EQ(reference.size(), y.size());
+  for (size_t k = 0; k < y.size(); ++k) {
+    EXPECT_NEAR(reference[k], y[k],
+                std::max(relative_tolerance * fabsf(reference[k]), 1e-6f))
+        << "Element " << k;
+  }
+}
+
+// Verifies that `exp_approximation` saturates instead of producing zeros or
+// infinities.
+template <typename ExpApproximation>
+void VerifyExpApproximationSaturates(ExpApproximation exp_approximation) {
+  const std::vector<float> x = {-1000.f, -100.f, 100.f, 1000.f,
+                                -1000.f, -100.f, 100.f, 1000.f};
+  std::vector<float> y(x.size());
+  exp_approximation(x, y);
+  for (float y_k : y) {
+    EXPECT_TRUE(isfinite(y_k));
+    EXPECT_GT(y_k, 0.f);
+  }
+}
+
+}  // namespace
+
+// Verifies that the vector approximations produce the same results as the
+// scalar ones for all available CPU features.
+TEST(NsFastMath, VectorVersionsMatchScalarVersions) {
+  const AvailableCpuFeatures cpu_features = GetAvailableCpuFeatures();
+  SCOPED_TRACE(cpu_features.ToString());
+  Random random(42U);
+  for (size_t size : kSizes) {
+    SCOPED_TRACE(size);
+    const std::vector<float> x = RandomVector(&random, size, 1.f, 1e6f);
+    const std::vector<float> exponent =
+        RandomVector(&random, size, -30.f, 30.f);
+    std::vector<float> reference(size);
+    std::vector<float> y(size);
+
+    SqrtFastApproximation(x, reference);
+    SqrtFastApproximation(cpu_features, x, y);
+    ExpectNearRelative(reference, y, 1e-7f);
+
+    LogApproximation(x, reference);
+    LogApproximation(cpu_features, x, y);
+    ExpectNearRelative(reference, y, 1e-6f);
+
+    ExpApproximation(exponent, reference);
+    ExpApproximation(cpu_features, exponent, y);
+    ExpectNearRelative(reference, y, 1e-5f);
+
+    ExpApproximationSignFlip(exponent, reference);
+    ExpApproximationSignFlip(cpu_features, exponent, y);
+    ExpectNearRelative(reference, y, 1e-5f);
+  }
+}
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Verifies that the AVX2 versions match the scalar versions.
+TEST(NsFastMath, Avx2Optimizations) {
+  if (!GetAvailableCpuFeatures().avx2) {
+    return;
+  }
+  Random random(42U);
+  for (size_t size : kSizes) {
+    SCOPED_TRACE(size);
+    const std::vector<float> x = RandomVector(&random, size, 1e-3f, 1e9f);
+    const std::vector<float> exponent =
+        RandomVector(&random, size, -80.f, 80.f);
+    std::vector<float> reference(size);
+    std::vector<float> y(size);
+
+    SqrtFastApproximation(x, reference);
+    ns::SqrtFastApproximation_Avx2(x, y);
+    ExpectNearRelative(reference, y, 1e-7f);
+
+    LogApproximation(x, reference);
+    ns::LogApproximation_Avx2(x, y);
+    ExpectNearRelative(reference, y, 1e-6f);
+
+    ExpApproximation(exponent, reference);
+    ns::ExpApproximation_Avx2(exponent, y);
+    ExpectNearRelative(reference, y, 1e-5f);
+
+    ExpApproximationSignFlip(exponent, reference);
+    ns::ExpApproximationSignFlip_Avx2(exponent, y);
+    ExpectNearRelative(reference, y, 1e-5f);
+  }
+  VerifyExpApproximationSaturates(ns::ExpApproximation_Avx2);
+}
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+// Verifies that the NEON versions match the scalar versions.
+TEST(NsFastMath, NeonOptimizations) {
+  Random random(42U);
+  for (size_t size : kSizes) {
+    SCOPED_TRACE(size);
+    const std::vector<float> x = RandomVector(&random, size, 1e-3f, 1e9f);
+    const std::vector<float> exponent =
+        RandomVector(&random, size, -80.f, 80.f);
+    std::vector<float> reference(size);
+    std::vector<float> y(size);
+
+    SqrtFastApproximation(x, reference);
+    ns::SqrtFastApproximation_Neon(x, y);
+    ExpectNearRelative(reference, y, 1e-7f);
+
+    LogApproximation(x, reference);
+    ns::LogApproximation_Neon(x, y);
+    ExpectNearRelative(reference, y, 1e-6f);
+
+    ExpApproximation(exponent, reference);
+    ns::ExpApproximation_Neon(exponent, y);
+    ExpectNearRelative(reference, y, 1e-5f);
+
+    ExpApproximationSignFlip(exponent, reference);
+    ns::ExpApproximationSignFlip_Neon(exponent, y);
+    ExpectNearRelative(reference, y, 1e-5f);
+  }
+  VerifyExpApproximationSaturates(ns::ExpApproximation_Neon);
+}
+#endif
+
+}  // namespace webrtc
@@ -43,8 +43,11 @@ constexpr std::array<float, 129> log_table = {
 
 }  // namespace
 
-NoiseEstimator::NoiseEstimator(const SuppressionParams& suppression_params)
-    : suppression_params_(suppression_params) {
+NoiseEstimator::NoiseEstimator(const SuppressionParams& suppression_params,
+                               const AvailableCpuFeatures& cpu_features,
+                               bool vectorized_exp_approximation)
+    : suppression_params_(suppression_params),
+      quantile_noise_estimator_(cpu_features, vectorized_exp_approximation) {
   noise_spectrum_.fill(0.f);
   prev_noise_spectrum_.fill(0.f);
   conservative_noise_spectrum_.fill(0.f);
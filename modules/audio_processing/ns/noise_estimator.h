@@ -14,6 +14,7 @@
 #include <array>
 
 #include "api/array_view.h"
+#include "modules/audio_processing/agc2/cpu_features.h"
 #include "modules/audio_processing/ns/ns_common.h"
 #include "modules/audio_processing/ns/quantile_noise_estimator.h"
 #include "modules/audio_processing/ns/suppression_params.h"
@@ -24,7 +25,9 @@ namespace webrtc {
 // signal.
 class NoiseEstimator {
  public:
-  explicit NoiseEstimator(const SuppressionParams& suppression_params);
+  NoiseEstimator(const SuppressionParams& suppression_params,
+                 const AvailableCpuFeatures& cpu_features,
+                 bool vectorized_exp_approximation);
 
   // Prepare the estimator for analysis of a new frame.
   void PrepareAnalysis();
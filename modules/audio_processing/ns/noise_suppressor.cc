@@ -145,6 +145,7 @@ float ComputeEnergyOfExtendedFrame(
 
 // Computes the magnitude spectrum based on an FFT output.
 void ComputeMagnitudeSpectrum(
+    const AvailableCpuFeatures& cpu_features,
     rtc::ArrayView<const float, kFftSize> real,
     rtc::ArrayView<const float, kFftSize> imag,
     rtc::ArrayView<float, kFftSizeBy2Plus1> signal_spectrum) {
@@ -152,9 +153,15 @@ void ComputeMagnitudeSpectrum(
   signal_spectrum[kFftSizeBy2Plus1 - 1] =
       fabsf(real[kFftSizeBy2Plus1 - 1]) + 1.f;
 
+  std::array<float, kFftSizeBy2Plus1 - 2> power_spectrum;
   for (size_t i = 1; i < kFftSizeBy2Plus1 - 1; ++i) {
-    signal_spectrum[i] =
-        SqrtFastApproximation(real[i] * real[i] + imag[i] * imag[i]) + 1.f;
+    power_spectrum[i - 1] = real[i] * real[i] + imag[i] * imag[i];
+  }
+  rtc::ArrayView<float> magnitude_spectrum =
+      signal_spectrum.subview(1, power_spectrum.size());
+  SqrtFastApproximation(cpu_features, power_spectrum, magnitude_spectrum);
+  for (float& magnitude : magnitude_spectrum) {
+    magnitude += 1.f;
   }
 }
 
@@ -239,9 +246,14 @@ float ComputeUpperBandsGain(
 
 NoiseSuppressor::ChannelState::ChannelState(
     const SuppressionParams& suppression_params,
-    size_t num_bands)
-    : wiener_filter(suppression_params),
-      noise_estimator(suppression_params),
+    size_t num_bands,
+    const AvailableCpuFeatures& cpu_features,
+    bool vectorized_exp_approximation)
+    : speech_probability_estimator(cpu_features, vectorized_exp_approximation),
+      wiener_filter(suppression_params, cpu_features),
+      noise_estimator(suppression_params,
+                      cpu_features,
+                      vectorized_exp_approximation),
       process_delay_memory(num_bands > 1 ? num_bands - 1 : 0) {
   analyze_analysis_memory.fill(0.f);
   prev_analysis_signal_spectrum.fill(1.f);
@@ -255,17 +267,28 @@ NoiseSuppressor::ChannelState::ChannelState(
 NoiseSuppressor::NoiseSuppressor(const NsConfig& config,
                                  size_t sample_rate_hz,
                                  size_t num_channels)
+    : NoiseSuppressor(config,
+                      sample_rate_hz,
+                      num_channels,
+                      GetAvailableCpuFeatures()) {}
+
+NoiseSuppressor::NoiseSuppressor(const NsConfig& config,
+                                 size_t sample_rate_hz,
+                                 size_t num_channels,
+                                 const AvailableCpuFeatures& cpu_features)
     : num_bands_(NumBandsForRate(sample_rate_hz)),
       num_channels_(num_channels),
       suppression_params_(config.target_level),
+      cpu_features_(cpu_features),
       filter_bank_states_heap_(NumChannelsOnHeap(num_channels_)),
       upper_band_gains_heap_(NumChannelsOnHeap(num_channels_)),
       energies_before_filtering_heap_(NumChannelsOnHeap(num_channels_)),
       gain_adjustments_heap_(NumChannelsOnHeap(num_channels_)),
       channels_(num_channels_) {
   for (size_t ch = 0; ch < num_channels_; ++ch) {
-    channels_[ch] =
-        std::make_unique<ChannelState>(suppression_params_, num_bands_);
+    channels_[ch] = std::make_unique<ChannelState>(
+        suppression_params_, num_bands_, cpu_features_,
+        config.vectorized_exp_approximation);
   }
 }
 
@@ -286,6 +309,11 @@ void NoiseSuppressor::AggregateWienerFilters(
 }
 
 void NoiseSuppressor::Analyze(const AudioBuffer& audio) {
+  Analyze(audio, /*worker_pool=*/nullptr);
+}
+
+void NoiseSuppressor::Analyze(const AudioBuffer& audio,
+                              WorkerPool* worker_pool) {
   // Prepare the noise estimator for the analysis stage.
   for (size_t ch = 0; ch < num_channels_; ++ch) {
     channels_[ch]->noise_estimator.PrepareAnalysis();
@@ -322,64 +350,71 @@ void NoiseSuppressor::Analyze(const AudioBuffer& audio) {
   }
 
   // Analyze all channels.
-  for (size_t ch = 0; ch < num_channels_; ++ch) {
-    std::unique_ptr<ChannelState>& ch_p = channels_[ch];
-    rtc::ArrayView<const float, kNsFrameSize> y_band0(
-        &audio.split_bands_const(ch)[0][0], kNsFrameSize);
+  ParallelFor(worker_pool, num_channels_,
+              [&](size_t ch) { AnalyzeChannel(audio, ch); });
+}
 
-    // Form an extended frame and apply analysis filter bank windowing.
-    std::array<float, kFftSize> extended_frame;
-    FormExtendedFrame(y_band0, ch_p->analyze_analysis_memory, extended_frame);
-    ApplyFilterBankWindow(extended_frame);
+void NoiseSuppressor::AnalyzeChannel(const AudioBuffer& audio, size_t ch) {
+  std::unique_ptr<ChannelState>& ch_p = channels_[ch];
+  rtc::ArrayView<const float, kNsFrameSize> y_band0(
+      &audio.split_bands_const(ch)[0][0], kNsFrameSize);
 
-    // Compute the magnitude spectrum.
-    std::array<float, kFftSize> real;
-    std::array<float, kFftSize> imag;
-    fft_.Fft(extended_frame, real, imag);
+  // Form an extended frame and apply analysis filter bank windowing.
+  std::array<float, kFftSize> extended_frame;
+  FormExtendedFrame(y_band0, ch_p->analyze_analysis_memory, extended_frame);
+  ApplyFilterBankWindow(extended_frame);
 
-    std::array<float, kFftSizeBy2Plus1> signal_spectrum;
-    ComputeMagnitudeSpectrum(real, imag, signal_spectrum);
+  // Compute the magnitude spectrum.
+  std::array<float, kFftSize> real;
+  std::array<float, kFftSize> imag;
+  ch_p->fft.Fft(extended_frame, real, imag);
 
-    // Compute energies.
-    float signal_energy = 0.f;
-    for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
-      signal_energy += real[i] * real[i] + imag[i] * imag[i];
-    }
-    signal_energy /= kFftSizeBy2Plus1;
+  std::array<float, kFftSizeBy2Plus1> signal_spectrum;
+  ComputeMagnitudeSpectrum(cpu_features_, real, imag, signal_spectrum);
 
-    float signal_spectral_sum = 0.f;
-    for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
-      signal_spectral_sum += signal_spectrum[i];
-    }
+  // Compute energies.
+  float signal_energy = 0.f;
+  for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
+    signal_energy += real[i] * real[i] + imag[i] * imag[i];
+  }
+  signal_energy /= kFftSizeBy2Plus1;
 
-    // Estimate the noise spectra and the probability estimates of speech
-    // presence.
-    ch_p->noise_estimator.PreUpdate(num_analyzed_frames_, signal_spectrum,
-                                    signal_spectral_sum);
-
-    std::array<float, kFftSizeBy2Plus1> post_snr;
-    std::array<float, kFftSizeBy2Plus1> prior_snr;
-    ComputeSnr(ch_p->wiener_filter.get_filter(),
-               ch_p->prev_analysis_signal_spectrum, signal_spectrum,
-               ch_p->noise_estimator.get_prev_noise_spectrum(),
-               ch_p->noise_estimator.get_noise_spectrum(), prior_snr, post_snr);
-
-    ch_p->speech_probability_estimator.Update(
-        num_analyzed_frames_, prior_snr, post_snr,
-        ch_p->noise_estimator.get_conservative_noise_spectrum(),
-        signal_spectrum, signal_spectral_sum, signal_energy);
-
-    ch_p->noise_estimator.PostUpdate(
-        ch_p->speech_probability_estimator.get_probability(), signal_spectrum);
-
-    // Store the magnitude spectrum to make it avalilable for the process
-    // method.
-    std::copy(signal_spectrum.begin(), signal_spectrum.end(),
-              ch_p->prev_analysis_signal_spectrum.begin());
+  float signal_spectral_sum = 0.f;
+  for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
+    signal_spectral_sum += signal_spectrum[i];
   }
+
+  // Estimate the noise spectra and the probability estimates of speech
+  // presence.
+  ch_p->noise_estimator.PreUpdate(num_analyzed_frames_, signal_spectrum,
+                                  signal_spectral_sum);
+
+  std::array<float, kFftSizeBy2Plus1> post_snr;
+  std::array<float, kFftSizeBy2Plus1> prior_snr;
+  ComputeSnr(ch_p->wiener_filter.get_filter(),
+             ch_p->prev_analysis_signal_spectrum, signal_spectrum,
+             ch_p->noise_estimator.get_prev_noise_spectrum(),
+             ch_p->noise_estimator.get_noise_spectrum(), prior_snr, post_snr);
+
+  ch_p->speech_probability_estimator.Update(
+      num_analyzed_frames_, prior_snr, post_snr,
+      ch_p->noise_estimator.get_conservative_noise_spectrum(),
+      signal_spectrum, signal_spectral_sum, signal_energy);
+
+  ch_p->noise_estimator.PostUpdate(
+      ch_p->speech_probability_estimator.get_probability(), signal_spectrum);
+
+  // Store the magnitude spectrum to make it avalilable for the process
+  // method.
+  std::copy(signal_spectrum.begin(), signal_spectrum.end(),
+            ch_p->prev_analysis_signal_spectrum.begin());
 }
 
 void NoiseSuppressor::Process(AudioBuffer* audio) {
+  Process(audio, /*worker_pool=*/nullptr);
+}
+
+void NoiseSuppressor::Process(AudioBuffer* audio, WorkerPool* worker_pool) {
   // Select the space for storing data during the processing.
   std::array<FilterBankState, kMaxNumChannelsOnStack> filter_bank_states_stack;
   rtc::ArrayView<FilterBankState> filter_bank_states(
@@ -407,7 +442,7 @@ void NoiseSuppressor::Process(AudioBuffer* audio) {
   }
 
   // Compute the suppression filters for all channels.
-  for (size_t ch = 0; ch < num_channels_; ++ch) {
+  ParallelFor(worker_pool, num_channels_, [&](size_t ch) {
     // Form an extended frame and apply analysis filter bank windowing.
     rtc::ArrayView<float, kNsFrameSize> y_band0(&audio->split_bands(ch)[0][0],
                                                 kNsFrameSize);
@@ -421,11 +456,12 @@ void NoiseSuppressor::Process(AudioBuffer* audio) {
         ComputeEnergyOfExtendedFrame(filter_bank_states[ch].extended_frame);
 
     // Perform filter bank analysis and compute the magnitude spectrum.
-    fft_.Fft(filter_bank_states[ch].extended_frame, filter_bank_states[ch].real,
-             filter_bank_states[ch].imag);
+    channels_[ch]->fft.Fft(filter_bank_states[ch].extended_frame,
+                           filter_bank_states[ch].real,
+                           filter_bank_states[ch].imag);
 
     std::array<float, kFftSizeBy2Plus1> signal_spectrum;
-    ComputeMagnitudeSpectrum(filter_bank_states[ch].real,
+    ComputeMagnitudeSpectrum(cpu_features_, filter_bank_states[ch].real,
                              filter_bank_states[ch].imag, signal_spectrum);
 
     // Compute the frequency domain gain filter for noise attenuation.
@@ -446,7 +482,7 @@ void NoiseSuppressor::Process(AudioBuffer* audio) {
           channels_[ch]->speech_probability_estimator.get_probability(),
           channels_[ch]->prev_analysis_signal_spectrum, signal_spectrum);
     }
-  }
+  });
 
   // Only do the below processing if the output of the audio processing module
   // is used.
@@ -463,21 +499,18 @@ void NoiseSuppressor::Process(AudioBuffer* audio) {
     AggregateWienerFilters(filter_data);
   }
 
-  for (size_t ch = 0; ch < num_channels_; ++ch) {
+  ParallelFor(worker_pool, num_channels_, [&](size_t ch) {
     // Apply the filter to the lower band.
     for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
       filter_bank_states[ch].real[i] *= filter[i];
       filter_bank_states[ch].imag[i] *= filter[i];
     }
-  }
 
-  // Perform filter bank synthesis
-  for (size_t ch = 0; ch < num_channels_; ++ch) {
-    fft_.Ifft(filter_bank_states[ch].real, filter_bank_states[ch].imag,
-              filter_bank_states[ch].extended_frame);
-  }
+    // Perform filter bank synthesis
+    channels_[ch]->fft.Ifft(filter_bank_states[ch].real,
+                            filter_bank_states[ch].imag,
+                            filter_bank_states[ch].extended_frame);
 
-  for (size_t ch = 0; ch < num_channels_; ++ch) {
     const float energy_after_filtering =
         ComputeEnergyOfExtendedFrame(filter_bank_states[ch].extended_frame);
 
@@ -491,57 +524,54 @@ void NoiseSuppressor::Process(AudioBuffer* audio) {
             num_analyzed_frames_,
             channels_[ch]->speech_probability_estimator.get_prior_probability(),
             energies_before_filtering[ch], energy_after_filtering);
-  }
+  });
 
-  // Select and apply adjustment of the noise attenuation filter based on the
-  // effect of the attenuation.
+  // Select the adjustment of the noise attenuation filter based on the effect
+  // of the attenuation.
   float gain_adjustment = gain_adjustments[0];
   for (size_t ch = 1; ch < num_channels_; ++ch) {
     gain_adjustment = std::min(gain_adjustment, gain_adjustments[ch]);
   }
-  for (size_t ch = 0; ch < num_channels_; ++ch) {
+
+  // Select the noise attenuating gain to apply to the upper band.
+  float upper_band_gain = 1.f;
+  if (num_bands_ > 1) {
+    upper_band_gain = upper_band_gains[0];
+    for (size_t ch = 1; ch < num_channels_; ++ch) {
+      upper_band_gain = std::min(upper_band_gain, upper_band_gains[ch]);
+    }
+  }
+
+  ParallelFor(worker_pool, num_channels_, [&](size_t ch) {
+    // Apply the adjustment of the noise attenuation filter.
     for (size_t i = 0; i < kFftSize; ++i) {
       filter_bank_states[ch].extended_frame[i] =
           gain_adjustment * filter_bank_states[ch].extended_frame[i];
     }
-  }
 
-  // Use overlap-and-add to form the output frame of the lowest band.
-  for (size_t ch = 0; ch < num_channels_; ++ch) {
+    // Use overlap-and-add to form the output frame of the lowest band.
     rtc::ArrayView<float, kNsFrameSize> y_band0(&audio->split_bands(ch)[0][0],
                                                 kNsFrameSize);
     OverlapAndAdd(filter_bank_states[ch].extended_frame,
                   channels_[ch]->process_synthesis_memory, y_band0);
-  }
-
-  if (num_bands_ > 1) {
-    // Select the noise attenuating gain to apply to the upper band.
-    float upper_band_gain = upper_band_gains[0];
-    for (size_t ch = 1; ch < num_channels_; ++ch) {
-      upper_band_gain = std::min(upper_band_gain, upper_band_gains[ch]);
-    }
 
     // Process the upper bands.
-    for (size_t ch = 0; ch < num_channels_; ++ch) {
-      for (size_t b = 1; b < num_bands_; ++b) {
-        // Delay the upper bands to match the delay of the filterbank applied to
-        // the lowest band.
-        rtc::ArrayView<float, kNsFrameSize> y_band(
-            &audio->split_bands(ch)[b][0], kNsFrameSize);
-        std::array<float, kNsFrameSize> delayed_frame;
-        DelaySignal(y_band, channels_[ch]->process_delay_memory[b - 1],
-                    delayed_frame);
-
-        // Apply the time-domain noise-attenuating gain.
-        for (size_t j = 0; j < kNsFrameSize; j++) {
-          y_band[j] = upper_band_gain * delayed_frame[j];
-        }
+    for (size_t b = 1; b < num_bands_; ++b) {
+      // Delay the upper bands to match the delay of the filterbank applied to
+      // the lowest band.
+      rtc::ArrayView<float, kNsFrameSize> y_band(&audio->split_bands(ch)[b][0],
+                                                 kNsFrameSize);
+      std::array<float, kNsFrameSize> delayed_frame;
+      DelaySignal(y_band, channels_[ch]->process_delay_memory[b - 1],
+                  delayed_frame);
+
+      // Apply the time-domain noise-attenuating gain.
+      for (size_t j = 0; j < kNsFrameSize; j++) {
+        y_band[j] = upper_band_gain * delayed_frame[j];
       }
     }
-  }
 
-  // Limit the output the allowed range.
-  for (size_t ch = 0; ch < num_channels_; ++ch) {
+    // Limit the output the allowed range.
     for (size_t b = 0; b < num_bands_; ++b) {
       rtc::ArrayView<float, kNsFrameSize> y_band(&audio->split_bands(ch)[b][0],
                                                  kNsFrameSize);
@@ -549,7 +579,7 @@ void NoiseSuppressor::Process(AudioBuffer* audio) {
         y_band[j] = std::min(std::max(y_band[j], -32768.f), 32767.f);
       }
     }
-  }
+  });
 }
 
 }  // namespace webrtc
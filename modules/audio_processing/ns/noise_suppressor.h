@@ -15,6 +15,7 @@
 #include <vector>
 
 #include "api/array_view.h"
+#include "modules/audio_processing/agc2/cpu_features.h"
 #include "modules/audio_processing/audio_buffer.h"
 #include "modules/audio_processing/ns/noise_estimator.h"
 #include "modules/audio_processing/ns/ns_common.h"
@@ -22,6 +23,7 @@
 #include "modules/audio_processing/ns/ns_fft.h"
 #include "modules/audio_processing/ns/speech_probability_estimator.h"
 #include "modules/audio_processing/ns/wiener_filter.h"
+#include "rtc_base/worker_pool.h"
 
 namespace webrtc {
 
@@ -31,6 +33,10 @@ class NoiseSuppressor {
   NoiseSuppressor(const NsConfig& config,
                   size_t sample_rate_hz,
                   size_t num_channels);
+  NoiseSuppressor(const NsConfig& config,
+                  size_t sample_rate_hz,
+                  size_t num_channels,
+                  const AvailableCpuFeatures& cpu_features);
   NoiseSuppressor(const NoiseSuppressor&) = delete;
   NoiseSuppressor& operator=(const NoiseSuppressor&) = delete;
 
@@ -41,6 +47,11 @@ class NoiseSuppressor {
   // Applies noise suppression.
   void Process(AudioBuffer* audio);
 
+  // Versions of the above that process the channels in parallel on
+  // `worker_pool`, if not null. The output is the same as without it.
+  void Analyze(const AudioBuffer& audio, WorkerPool* worker_pool);
+  void Process(AudioBuffer* audio, WorkerPool* worker_pool);
+
   // Specifies whether the capture output will be used. The purpose of this is
   // to allow the noise suppressor to deactivate some of the processing when the
   // resulting output is anyway not used, for instance when the endpoint is
@@ -53,13 +64,20 @@ class NoiseSuppressor {
   const size_t num_bands_;
   const size_t num_channels_;
   const SuppressionParams suppression_params_;
+  const AvailableCpuFeatures cpu_features_;
   int32_t num_analyzed_frames_ = -1;
-  NrFft fft_;
   bool capture_output_used_ = true;
 
   struct ChannelState {
-    ChannelState(const SuppressionParams& suppression_params, size_t num_bands);
-
+    ChannelState(const SuppressionParams& suppression_params,
+                 size_t num_bands,
+                 const AvailableCpuFeatures& cpu_features,
+                 bool vectorized_exp_approximation);
+
+    // The FFT is stored per channel, as it uses its state as scratch memory,
+    // which prevents it from being shared between channels that are processed
+    // in parallel.
+    NrFft fft;
     SpeechProbabilityEstimator speech_probability_estimator;
     WienerFilter wiener_filter;
     NoiseEstimator noise_estimator;
@@ -85,6 +103,9 @@ class NoiseSuppressor {
   // Aggregates the Wiener filters into a single filter to use.
   void AggregateWienerFilters(
       rtc::ArrayView<float, kFftSizeBy2Plus1> filter) const;
+
+  // Performs the analysis of one channel.
+  void AnalyzeChannel(const AudioBuffer& audio, size_t ch);
 };
 
 }  // namespace webrtc
@@ -0,0 +1,219 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "modules/audio_processing/agc2/cpu_features.h"
+#include "modules/audio_processing/audio_buffer.h"
+#include "modules/audio_processing/ns/fast_math.h"
+#include "modules/audio_processing/ns/noise_suppressor.h"
+#include "modules/audio_processing/ns/ns_config.h"
+#include "modules/audio_processing/ns/signal_model_estimator.h"
+#include "modules/audio_processing/ns/suppression_params.h"
+#include "modules/audio_processing/ns/wiener_filter.h"
+#include "rtc_base/random.h"
+#include "rtc_base/worker_pool.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kSampleRateHz = 48000;
+constexpr size_t kNumBands = 3;
+constexpr size_t kNumFrames = 100;
+
+enum class Implementation { kScalar, kSimd };
+
+AvailableCpuFeatures GetCpuFeatures(Implementation implementation) {
+  return implementation == Implementation::kSimd ? GetAvailableCpuFeatures()
+                                                 : NoAvailableCpuFeatures();
+}
+
+// Returns false, and skips the benchmark, if the CPU lacks SIMD support.
+bool IsSupported(benchmark::State& state, Implementation implementation) {
+  const AvailableCpuFeatures cpu_features = GetAvailableCpuFeatures();
+  if (implementation == Implementation::kSimd && !cpu_features.avx2 &&
+      !cpu_features.neon) {
+    state.SkipWithError("Not supported by the CPU");
+    return false;
+  }
+  return true;
+}
+
+void FillRandomSpectrum(Random* random, rtc::ArrayView<float> spectrum) {
+  for (float& s : spectrum) {
+    s = 1.f + 1000.f * random->Rand<float>();
+  }
+}
+
+// Measures the full noise suppression of 48 kHz audio with `state.range(0)`
+// channels, in frames per second and channels per second.
+void BM_NoiseSuppressor(benchmark::State& state,
+                        Implementation implementation,
+                        bool vectorized_exp_approximation,
+                        int num_worker_threads) {
+  if (!IsSupported(state, implementation)) {
+    return;
+  }
+  const size_t num_channels = state.range(0);
+  AudioBuffer audio(kSampleRateHz, num_channels, kSampleRateHz, num_channels,
+                    kSampleRateHz, num_channels);
+  audio.SplitIntoFrequencyBands();
+  NsConfig config;
+  config.vectorized_exp_approximation = vectorized_exp_approximation;
+  NoiseSuppressor ns(config, kSampleRateHz, num_channels,
+                     GetCpuFeatures(implementation));
+  std::unique_ptr<WorkerPool> worker_pool;
+  if (num_worker_threads > 0) {
+    worker_pool = std::make_unique<WorkerPool>(num_worker_threads);
+  }
+
+  // Pre-generate noisy input, so that the random generation is not measured.
+  Random random(42);
+  std::vector<std::vector<float>> input(kNumFrames);
+  for (std::vector<float>& frame : input) {
+    frame.resize(num_channels * kNumBands * 160);
+    for (float& sample : frame) {
+      sample = random.Gaussian(0.f, 1000.f);
+    }
+  }
+
+  size_t frame_index = 0;
+  for (auto _ : state) {
+    const std::vector<float>& frame = input[frame_index];
+    frame_index = (frame_index + 1) % kNumFrames;
+    for (size_t ch = 0; ch < num_channels; ++ch) {
+      for (size_t b = 0; b < kNumBands; ++b) {
+        const float* samples = &frame[(ch * kNumBands + b) * 160];
+        std::copy(samples, samples + 160, audio.split_bands(ch)[b]);
+      }
+    }
+    ns.Analyze(audio, worker_pool.get());
+    ns.Process(&audio, worker_pool.get());
+    benchmark::DoNotOptimize(audio.split_bands(0)[0][0]);
+  }
+  state.SetItemsProcessed(state.iterations() * num_channels);
+  state.counters["channels"] = num_channels;
+}
+
+BENCHMARK_CAPTURE(BM_NoiseSuppressor,
+                  Scalar,
+                  Implementation::kScalar,
+                  /*vectorized_exp_approximation=*/false,
+                  0)
+    ->RangeMultiplier(2)
+    ->Range(1, 8);
+BENCHMARK_CAPTURE(BM_NoiseSuppressor,
+                  Simd,
+                  Implementation::kSimd,
+                  /*vectorized_exp_approximation=*/false,
+                  0)
+    ->RangeMultiplier(2)
+    ->Range(1, 8);
+BENCHMARK_CAPTURE(BM_NoiseSuppressor,
+                  SimdExp,
+                  Implementation::kSimd,
+                  /*vectorized_exp_approximation=*/true,
+                  0)
+    ->RangeMultiplier(2)
+    ->Range(1, 8);
+BENCHMARK_CAPTURE(BM_NoiseSuppressor,
+                  SimdThreads3,
+                  Implementation::kSimd,
+                  /*vectorized_exp_approximation=*/false,
+                  3)
+    ->RangeMultiplier(2)
+    ->Range(1, 8)
+    ->UseRealTime();
+
+// Measures the per-channel Wiener filter update.
+void BM_WienerFilterUpdate(benchmark::State& state,
+                           Implementation implementation) {
+  if (!IsSupported(state, implementation)) {
+    return;
+  }
+  const SuppressionParams params(NsConfig::SuppressionLevel::k12dB);
+  WienerFilter filter(params, GetCpuFeatures(implementation));
+  Random random(42);
+  std::array<float, kFftSizeBy2Plus1> noise_spectrum;
+  std::array<float, kFftSizeBy2Plus1> prev_noise_spectrum;
+  std::array<float, kFftSizeBy2Plus1> signal_spectrum;
+  FillRandomSpectrum(&random, noise_spectrum);
+  FillRandomSpectrum(&random, prev_noise_spectrum);
+  FillRandomSpectrum(&random, signal_spectrum);
+  for (auto _ : state) {
+    // Past the startup phase, as in steady state processing.
+    filter.Update(kShortStartupPhaseBlocks, noise_spectrum,
+                  prev_noise_spectrum, noise_spectrum, signal_spectrum);
+    benchmark::DoNotOptimize(filter.get_filter()[0]);
+  }
+}
+
+BENCHMARK_CAPTURE(BM_WienerFilterUpdate, Scalar, Implementation::kScalar);
+BENCHMARK_CAPTURE(BM_WienerFilterUpdate, Simd, Implementation::kSimd);
+
+// Measures the per-channel signal model update.
+void BM_SignalModelEstimatorUpdate(benchmark::State& state,
+                                   Implementation implementation) {
+  if (!IsSupported(state, implementation)) {
+    return;
+  }
+  SignalModelEstimator estimator(GetCpuFeatures(implementation));
+  Random random(42);
+  std::array<float, kFftSizeBy2Plus1> prior_snr;
+  std::array<float, kFftSizeBy2Plus1> post_snr;
+  std::array<float, kFftSizeBy2Plus1> noise_spectrum;
+  std::array<float, kFftSizeBy2Plus1> signal_spectrum;
+  FillRandomSpectrum(&random, prior_snr);
+  FillRandomSpectrum(&random, post_snr);
+  FillRandomSpectrum(&random, noise_spectrum);
+  FillRandomSpectrum(&random, signal_spectrum);
+  float signal_spectral_sum = 0.f;
+  for (float s : signal_spectrum) {
+    signal_spectral_sum += s;
+  }
+  for (auto _ : state) {
+    estimator.Update(prior_snr, post_snr, noise_spectrum, signal_spectrum,
+                     signal_spectral_sum, /*signal_energy=*/1e6f);
+    benchmark::DoNotOptimize(estimator.get_model().lrt);
+  }
+}
+
+BENCHMARK_CAPTURE(BM_SignalModelEstimatorUpdate,
+                  Scalar,
+                  Implementation::kScalar);
+BENCHMARK_CAPTURE(BM_SignalModelEstimatorUpdate, Simd, Implementation::kSimd);
+
+// Measures the approximations on one spectrum.
+void BM_FastMath(benchmark::State& state, Implementation implementation) {
+  if (!IsSupported(state, implementation)) {
+    return;
+  }
+  const AvailableCpuFeatures cpu_features = GetCpuFeatures(implementation);
+  Random random(42);
+  std::array<float, kFftSizeBy2Plus1> x;
+  std::array<float, kFftSizeBy2Plus1> y;
+  FillRandomSpectrum(&random, x);
+  for (auto _ : state) {
+    SqrtFastApproximation(cpu_features, x, y);
+    LogApproximation(cpu_features, y, y);
+    ExpApproximation(cpu_features, y, y);
+    benchmark::DoNotOptimize(y[0]);
+  }
+}
+
+BENCHMARK_CAPTURE(BM_FastMath, Scalar, Implementation::kScalar);
+BENCHMARK_CAPTURE(BM_FastMath, Simd, Implementation::kSimd);
+
+}  // namespace
+}  // namespace webrtc
@@ -10,13 +10,18 @@
 
 #include "modules/audio_processing/ns/noise_suppressor.h"
 
+#include <math.h>
+
 #include <deque>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "modules/audio_processing/agc2/cpu_features.h"
+#include "rtc_base/random.h"
 #include "rtc_base/strings/string_builder.h"
+#include "rtc_base/worker_pool.h"
 #include "test/gmock.h"
 #include "test/gtest.h"
 
@@ -61,6 +66,57 @@ void VerifyIdenticalChannels(size_t num_channels,
   }
 }
 
+// Fills the channels with different mixes of noise and a tone whose level
+// varies over time, to alternate between noise-like and speech-like frames.
+void PopulateInputFrameWithNoisyTones(size_t num_bands,
+                                      size_t frame_index,
+                                      Random* random,
+                                      AudioBuffer* audio) {
+  constexpr float kPi = 3.14159265f;
+  const float tone_level = (frame_index / 50) % 2 == 0 ? 0.f : 3000.f;
+  for (size_t ch = 0; ch < audio->num_channels(); ++ch) {
+    for (size_t b = 0; b < num_bands; ++b) {
+      for (size_t i = 0; i < 160; ++i) {
+        const size_t n = frame_index * 160 + i;
+        audio->split_bands(ch)[b][i] =
+            tone_level * sinf(2.f * kPi * (ch + 1) * 0.01f * n) +
+            random->Gaussian(0.f, 300.f);
+      }
+    }
+  }
+}
+
+// Returns the output of processing `num_frames` frames of noisy tones with the
+// noise suppressor.
+std::vector<float> ProcessNoisyTones(const NsConfig& config,
+                                     int sample_rate_hz,
+                                     size_t num_channels,
+                                     size_t num_frames,
+                                     const AvailableCpuFeatures& cpu_features,
+                                     WorkerPool* worker_pool) {
+  const size_t num_bands = sample_rate_hz / 16000;
+  AudioBuffer audio(sample_rate_hz, num_channels, sample_rate_hz, num_channels,
+                    sample_rate_hz, num_channels);
+  NoiseSuppressor ns(config, sample_rate_hz, num_channels, cpu_features);
+  Random random(42U);
+  std::vector<float> output;
+  for (size_t frame_index = 0; frame_index < num_frames; ++frame_index) {
+    if (sample_rate_hz > 16000) {
+      audio.SplitIntoFrequencyBands();
+    }
+    PopulateInputFrameWithNoisyTones(num_bands, frame_index, &random, &audio);
+    ns.Analyze(audio, worker_pool);
+    ns.Process(&audio, worker_pool);
+    for (size_t ch = 0; ch < num_channels; ++ch) {
+      for (size_t b = 0; b < num_bands; ++b) {
+        output.insert(output.end(), audio.split_bands_const(ch)[b],
+                      audio.split_bands_const(ch)[b] + 160);
+      }
+    }
+  }
+  return output;
+}
+
 }  // namespace
 
 // Verifies that the same noise reduction effect is applied to all channels.
@@ -99,4 +155,56 @@ TEST(NoiseSuppressor, IdenticalChannelEffects) {
   }
 }
 
+// Verifies that processing the channels in parallel does not affect the
+// output.
+TEST(NoiseSuppressor, WorkerPoolDoesNotAffectOutput) {
+  WorkerPool worker_pool(3);
+  for (auto rate : {16000, 48000}) {
+    for (size_t num_channels : {1, 2, 5, 8}) {
+      SCOPED_TRACE(ProduceDebugText(rate, num_channels,
+                                    NsConfig::SuppressionLevel::k12dB));
+      const std::vector<float> reference =
+          ProcessNoisyTones(NsConfig(), rate, num_channels, 300,
+                            GetAvailableCpuFeatures(), /*worker_pool=*/nullptr);
+      const std::vector<float> output =
+          ProcessNoisyTones(NsConfig(), rate, num_channels, 300,
+                            GetAvailableCpuFeatures(), &worker_pool);
+      ASSERT_EQ(reference.size(), output.size());
+      for (size_t k = 0; k < output.size(); ++k) {
+        ASSERT_EQ(reference[k], output[k]) << "Sample " << k;
+      }
+    }
+  }
+}
+
+// Verifies that the output with the SIMD optimizations, including the
+// vectorized exponential, only deviates marginally from the output of the
+// scalar code.
+TEST(NoiseSuppressor, CpuFeaturesDoNotSignificantlyAffectOutput) {
+  NsConfig vectorized_config;
+  vectorized_config.vectorized_exp_approximation = true;
+  for (auto rate : {16000, 48000}) {
+    for (size_t num_channels : {1, 2}) {
+      SCOPED_TRACE(ProduceDebugText(rate, num_channels,
+                                    NsConfig::SuppressionLevel::k12dB));
+      const std::vector<float> reference =
+          ProcessNoisyTones(NsConfig(), rate, num_channels, 1000,
+                            NoAvailableCpuFeatures(), /*worker_pool=*/nullptr);
+      const std::vector<float> output =
+          ProcessNoisyTones(vectorized_config, rate, num_channels, 1000,
+                            GetAvailableCpuFeatures(), /*worker_pool=*/nullptr);
+      ASSERT_EQ(reference.size(), output.size());
+      float reference_energy = 0.f;
+      float error_energy = 0.f;
+      for (size_t k = 0; k < output.size(); ++k) {
+        reference_energy += reference[k] * reference[k];
+        error_energy += (output[k] - reference[k]) * (output[k] - reference[k]);
+      }
+      ASSERT_GT(reference_energy, 0.f);
+      // Require the error to be at least 60 dB below the output.
+      EXPECT_LT(error_energy, 1e-6f * reference_energy);
+    }
+  }
+}
+
 }  // namespace webrtc
@@ -17,6 +17,10 @@ namespace webrtc {
 struct NsConfig {
   enum class SuppressionLevel { k6dB, k12dB, k18dB, k21dB };
   SuppressionLevel target_level = SuppressionLevel::k12dB;
+  // Computes e^x with a SIMD polynomial approximation when the CPU supports
+  // it. This is faster than the default approximation, but not bit-exact with
+  // it.
+  bool vectorized_exp_approximation = false;
 };
 
 }  // namespace webrtc
@@ -16,7 +16,11 @@
 
 namespace webrtc {
 
-QuantileNoiseEstimator::QuantileNoiseEstimator() {
+QuantileNoiseEstimator::QuantileNoiseEstimator(
+    const AvailableCpuFeatures& cpu_features,
+    bool vectorized_exp_approximation)
+    : cpu_features_(cpu_features),
+      vectorized_exp_approximation_(vectorized_exp_approximation) {
   quantile_.fill(0.f);
   density_.fill(0.3f);
   log_quantile_.fill(8.f);
@@ -31,7 +35,7 @@ void QuantileNoiseEstimator::Estimate(
     rtc::ArrayView<const float, kFftSizeBy2Plus1> signal_spectrum,
     rtc::ArrayView<float, kFftSizeBy2Plus1> noise_spectrum) {
   std::array<float, kFftSizeBy2Plus1> log_spectrum;
-  LogApproximation(signal_spectrum, log_spectrum);
+  LogApproximation(cpu_features_, signal_spectrum, log_spectrum);
 
   int quantile_index_to_return = -1;
   // Loop over simultaneous estimates.
@@ -76,10 +80,13 @@ void QuantileNoiseEstimator::Estimate(
   }
 
   if (quantile_index_to_return >= 0) {
-    ExpApproximation(
-        rtc::ArrayView<const float>(&log_quantile_[quantile_index_to_return],
-                                    kFftSizeBy2Plus1),
-        quantile_);
+    rtc::ArrayView<const float> log_quantile(
+        &log_quantile_[quantile_index_to_return], kFftSizeBy2Plus1);
+    if (vectorized_exp_approximation_) {
+      ExpApproximation(cpu_features_, log_quantile, quantile_);
+    } else {
+      ExpApproximation(log_quantile, quantile_);
+    }
   }
 
   std::copy(quantile_.begin(), quantile_.end(), noise_spectrum.begin());
@@ -15,6 +15,7 @@
 #include <array>
 
 #include "api/array_view.h"
+#include "modules/audio_processing/agc2/cpu_features.h"
 #include "modules/audio_processing/ns/ns_common.h"
 
 namespace webrtc {
@@ -24,7 +25,8 @@ constexpr int kSimult = 3;
 // For quantile noise estimation.
 class QuantileNoiseEstimator {
  public:
-  QuantileNoiseEstimator();
+  QuantileNoiseEstimator(const AvailableCpuFeatures& cpu_features,
+                         bool vectorized_exp_approximation);
   QuantileNoiseEstimator(const QuantileNoiseEstimator&) = delete;
   QuantileNoiseEstimator& operator=(const QuantileNoiseEstimator&) = delete;
 
@@ -33,6 +35,8 @@ class QuantileNoiseEstimator {
                 rtc::ArrayView<float, kFftSizeBy2Plus1> noise_spectrum);
 
  private:
+  const AvailableCpuFeatures cpu_features_;
+  const bool vectorized_exp_approximation_;
   std::array<float, kSimult * kFftSizeBy2Plus1> density_;
   std::array<float, kSimult * kFftSizeBy2Plus1> log_quantile_;
   std::array<float, kFftSizeBy2Plus1> quantile_;
@@ -10,7 +10,12 @@
 
 #include "modules/audio_processing/ns/signal_model_estimator.h"
 
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
+
 #include "modules/audio_processing/ns/fast_math.h"
+#include "rtc_base/checks.h"
 
 namespace webrtc {
 
@@ -61,6 +66,7 @@ float ComputeSpectralDiff(
 
 // Updates the spectral flatness based on the input spectrum.
 void UpdateSpectralFlatness(
+    const AvailableCpuFeatures& cpu_features,
     rtc::ArrayView<const float, kFftSizeBy2Plus1> signal_spectrum,
     float signal_spectral_sum,
     float* spectral_flatness) {
@@ -77,8 +83,11 @@ void UpdateSpectralFlatness(
     }
   }
 
-  for (size_t i = 1; i < kFftSizeBy2Plus1; ++i) {
-    avg_spect_flatness_num += LogApproximation(signal_spectrum[i]);
+  std::array<float, kFftSizeBy2Plus1 - 1> log_signal_spectrum;
+  LogApproximation(cpu_features, signal_spectrum.subview(1),
+                   log_signal_spectrum);
+  for (float log_signal : log_signal_spectrum) {
+    avg_spect_flatness_num += log_signal;
   }
 
   float avg_spect_flatness_denom = signal_spectral_sum - signal_spectrum[0];
@@ -93,7 +102,10 @@ void UpdateSpectralFlatness(
   *spectral_flatness += kAveraging * (spectral_tmp - *spectral_flatness);
 }
 
-// Updates the log LRT measures.
+}  // namespace
+
+namespace ns {
+
 void UpdateSpectralLrt(rtc::ArrayView<const float, kFftSizeBy2Plus1> prior_snr,
                        rtc::ArrayView<const float, kFftSizeBy2Plus1> post_snr,
                        rtc::ArrayView<float, kFftSizeBy2Plus1> avg_log_lrt,
@@ -115,10 +127,58 @@ void UpdateSpectralLrt(rtc::ArrayView<const float, kFftSizeBy2Plus1> prior_snr,
   *lrt = log_lrt_time_avg_k_sum * kOneByFftSizeBy2Plus1;
 }
 
-}  // namespace
+#if defined(WEBRTC_HAS_NEON)
+void UpdateSpectralLrt_Neon(
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> prior_snr,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> post_snr,
+    rtc::ArrayView<float, kFftSizeBy2Plus1> avg_log_lrt,
+    float* lrt) {
+#if defined(WEBRTC_ARCH_ARM64)
+  RTC_DCHECK(lrt);
+  std::array<float, kFftSizeBy2Plus1> tmp1;
+  for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
+    tmp1[i] = 1.f + 2.f * prior_snr[i];
+  }
+  std::array<float, kFftSizeBy2Plus1> log_tmp1;
+  LogApproximation_Neon(tmp1, log_tmp1);
+
+  const float32x4_t half = vdupq_n_f32(.5f);
+  float32x4_t sum = vdupq_n_f32(0.f);
+  for (size_t i = 0; i < kFftSizeBy2Plus1 - 1; i += 4) {
+    const float32x4_t tmp1_i = vld1q_f32(&tmp1[i]);
+    const float32x4_t tmp2 =
+        vdivq_f32(vmulq_f32(vdupq_n_f32(2.f), vld1q_f32(&prior_snr[i])),
+                  vaddq_f32(tmp1_i, vdupq_n_f32(0.0001f)));
+    const float32x4_t bessel_tmp =
+        vmulq_f32(vaddq_f32(vld1q_f32(&post_snr[i]), vdupq_n_f32(1.f)), tmp2);
+    float32x4_t avg_log_lrt_i = vld1q_f32(&avg_log_lrt[i]);
+    const float32x4_t update = vsubq_f32(
+        vsubq_f32(bessel_tmp, vld1q_f32(&log_tmp1[i])), avg_log_lrt_i);
+    avg_log_lrt_i = vaddq_f32(avg_log_lrt_i, vmulq_f32(half, update));
+    vst1q_f32(&avg_log_lrt[i], avg_log_lrt_i);
+    sum = vaddq_f32(sum, avg_log_lrt_i);
+  }
+
+  // Compute the last bin, which does not fill a full SIMD block.
+  constexpr size_t kLast = kFftSizeBy2Plus1 - 1;
+  float tmp2 = 2.f * prior_snr[kLast] / (tmp1[kLast] + 0.0001f);
+  float bessel_tmp = (post_snr[kLast] + 1.f) * tmp2;
+  avg_log_lrt[kLast] +=
+      .5f * (bessel_tmp - log_tmp1[kLast] - avg_log_lrt[kLast]);
+
+  *lrt = (vaddvq_f32(sum) + avg_log_lrt[kLast]) * kOneByFftSizeBy2Plus1;
+#else
+  // ARMv7 NEON has no division instruction.
+  UpdateSpectralLrt(prior_snr, post_snr, avg_log_lrt, lrt);
+#endif
+}
+#endif
+
+}  // namespace ns
 
-SignalModelEstimator::SignalModelEstimator()
-    : prior_model_estimator_(kLtrFeatureThr) {}
+SignalModelEstimator::SignalModelEstimator(
+    const AvailableCpuFeatures& cpu_features)
+    : cpu_features_(cpu_features), prior_model_estimator_(kLtrFeatureThr) {}
 
 void SignalModelEstimator::AdjustNormalization(int32_t num_analyzed_frames,
                                                float signal_energy) {
@@ -136,7 +196,7 @@ void SignalModelEstimator::Update(
     float signal_spectral_sum,
     float signal_energy) {
   // Compute spectral flatness on input spectrum.
-  UpdateSpectralFlatness(signal_spectrum, signal_spectral_sum,
+  UpdateSpectralFlatness(cpu_features_, signal_spectrum, signal_spectral_sum,
                          &features_.spectral_flatness);
 
   // Compute difference of input spectrum with learned/estimated noise spectrum.
@@ -169,7 +229,22 @@ void SignalModelEstimator::Update(
   }
 
   // Compute the LRT.
-  UpdateSpectralLrt(prior_snr, post_snr, features_.avg_log_lrt, &features_.lrt);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (cpu_features_.avx2) {
+    ns::UpdateSpectralLrt_Avx2(prior_snr, post_snr, features_.avg_log_lrt,
+                               &features_.lrt);
+    return;
+  }
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  if (cpu_features_.neon) {
+    ns::UpdateSpectralLrt_Neon(prior_snr, post_snr, features_.avg_log_lrt,
+                               &features_.lrt);
+    return;
+  }
+#endif
+  ns::UpdateSpectralLrt(prior_snr, post_snr, features_.avg_log_lrt,
+                        &features_.lrt);
 }
 
 }  // namespace webrtc
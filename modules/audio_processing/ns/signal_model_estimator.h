@@ -14,17 +14,43 @@
 #include <array>
 
 #include "api/array_view.h"
+#include "modules/audio_processing/agc2/cpu_features.h"
 #include "modules/audio_processing/ns/histograms.h"
 #include "modules/audio_processing/ns/ns_common.h"
 #include "modules/audio_processing/ns/prior_signal_model.h"
 #include "modules/audio_processing/ns/prior_signal_model_estimator.h"
 #include "modules/audio_processing/ns/signal_model.h"
+#include "rtc_base/system/arch.h"
 
 namespace webrtc {
+namespace ns {
+
+// Updates the time-averaged log likelihood ratio measures in `avg_log_lrt`,
+// and returns their mean in `lrt`.
+void UpdateSpectralLrt(rtc::ArrayView<const float, kFftSizeBy2Plus1> prior_snr,
+                       rtc::ArrayView<const float, kFftSizeBy2Plus1> post_snr,
+                       rtc::ArrayView<float, kFftSizeBy2Plus1> avg_log_lrt,
+                       float* lrt);
+#if defined(WEBRTC_HAS_NEON)
+void UpdateSpectralLrt_Neon(
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> prior_snr,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> post_snr,
+    rtc::ArrayView<float, kFftSizeBy2Plus1> avg_log_lrt,
+    float* lrt);
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void UpdateSpectralLrt_Avx2(
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> prior_snr,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> post_snr,
+    rtc::ArrayView<float, kFftSizeBy2Plus1> avg_log_lrt,
+    float* lrt);
+#endif
+
+}  // namespace ns
 
 class SignalModelEstimator {
  public:
-  SignalModelEstimator();
+  explicit SignalModelEstimator(const AvailableCpuFeatures& cpu_features);
   SignalModelEstimator(const SignalModelEstimator&) = delete;
   SignalModelEstimator& operator=(const SignalModelEstimator&) = delete;
 
@@ -45,6 +71,7 @@ class SignalModelEstimator {
   const SignalModel& get_model() { return features_; }
 
  private:
+  const AvailableCpuFeatures cpu_features_;
   float diff_normalization_ = 0.f;
   float signal_energy_sum_ = 0.f;
   Histograms histograms_;
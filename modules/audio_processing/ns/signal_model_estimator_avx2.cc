@@ -0,0 +1,75 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include <array>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/ns/fast_math.h"
+#include "modules/audio_processing/ns/signal_model_estimator.h"
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+namespace ns {
+
+void UpdateSpectralLrt_Avx2(
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> prior_snr,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> post_snr,
+    rtc::ArrayView<float, kFftSizeBy2Plus1> avg_log_lrt,
+    float* lrt) {
+  RTC_DCHECK(lrt);
+  std::array<float, kFftSizeBy2Plus1> tmp1;
+  for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
+    tmp1[i] = 1.f + 2.f * prior_snr[i];
+  }
+  std::array<float, kFftSizeBy2Plus1> log_tmp1;
+  LogApproximation_Avx2(tmp1, log_tmp1);
+
+  const __m256 half = _mm256_set1_ps(.5f);
+  __m256 sum = _mm256_setzero_ps();
+  for (size_t i = 0; i < kFftSizeBy2Plus1 - 1; i += 8) {
+    const __m256 tmp1_i = _mm256_loadu_ps(&tmp1[i]);
+    const __m256 tmp2 = _mm256_div_ps(
+        _mm256_mul_ps(_mm256_set1_ps(2.f), _mm256_loadu_ps(&prior_snr[i])),
+        _mm256_add_ps(tmp1_i, _mm256_set1_ps(0.0001f)));
+    const __m256 bessel_tmp = _mm256_mul_ps(
+        _mm256_add_ps(_mm256_loadu_ps(&post_snr[i]), _mm256_set1_ps(1.f)),
+        tmp2);
+    __m256 avg_log_lrt_i = _mm256_loadu_ps(&avg_log_lrt[i]);
+    const __m256 update = _mm256_sub_ps(
+        _mm256_sub_ps(bessel_tmp, _mm256_loadu_ps(&log_tmp1[i])),
+        avg_log_lrt_i);
+    avg_log_lrt_i = _mm256_add_ps(avg_log_lrt_i, _mm256_mul_ps(half, update));
+    _mm256_storeu_ps(&avg_log_lrt[i], avg_log_lrt_i);
+    sum = _mm256_add_ps(sum, avg_log_lrt_i);
+  }
+
+  // Compute the last bin, which does not fill a full SIMD block.
+  constexpr size_t kLast = kFftSizeBy2Plus1 - 1;
+  float tmp2 = 2.f * prior_snr[kLast] / (tmp1[kLast] + 0.0001f);
+  float bessel_tmp = (post_snr[kLast] + 1.f) * tmp2;
+  avg_log_lrt[kLast] +=
+      .5f * (bessel_tmp - log_tmp1[kLast] - avg_log_lrt[kLast]);
+
+  // Reduce `sum` by addition.
+  __m128 high = _mm256_extractf128_ps(sum, 1);
+  __m128 low = _mm256_extractf128_ps(sum, 0);
+  low = _mm_add_ps(high, low);
+  high = _mm_movehl_ps(high, low);
+  low = _mm_add_ps(high, low);
+  high = _mm_shuffle_ps(low, low, 1);
+  low = _mm_add_ss(high, low);
+  constexpr float kOneByFftSizeBy2Plus1 = 1.f / kFftSizeBy2Plus1;
+  *lrt = (_mm_cvtss_f32(low) + avg_log_lrt[kLast]) * kOneByFftSizeBy2Plus1;
+}
+
+}  // namespace ns
+}  // namespace webrtc
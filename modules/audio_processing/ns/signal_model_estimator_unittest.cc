@@ -0,0 +1,118 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/ns/signal_model_estimator.h"
+
+#include <math.h>
+
+#include <array>
+
+#include "modules/audio_processing/agc2/cpu_features.h"
+#include "rtc_base/random.h"
+#include "rtc_base/system/arch.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+void RandomizeSpectrum(Random* random,
+                       float max_value,
+                       rtc::ArrayView<float, kFftSizeBy2Plus1> spectrum) {
+  for (float& s : spectrum) {
+    s = max_value * random->Rand<float>();
+  }
+}
+
+// Runs the LRT update for a number of frames of random SNRs and verifies that
+// `update_lrt` produces the same measures as the scalar version.
+template <typename UpdateLrt>
+void VerifySpectralLrtUpdate(UpdateLrt update_lrt) {
+  Random random(42U);
+  std::array<float, kFftSizeBy2Plus1> avg_log_lrt_reference;
+  std::array<float, kFftSizeBy2Plus1> avg_log_lrt;
+  avg_log_lrt_reference.fill(kLtrFeatureThr);
+  avg_log_lrt.fill(kLtrFeatureThr);
+  std::array<float, kFftSizeBy2Plus1> prior_snr;
+  std::array<float, kFftSizeBy2Plus1> post_snr;
+  for (int frame = 0; frame < 100; ++frame) {
+    RandomizeSpectrum(&random, 100.f, prior_snr);
+    RandomizeSpectrum(&random, 100.f, post_snr);
+    float lrt_reference;
+    float lrt;
+    ns::UpdateSpectralLrt(prior_snr, post_snr, avg_log_lrt_reference,
+                          &lrt_reference);
+    update_lrt(prior_snr, post_snr, avg_log_lrt, &lrt);
+    for (size_t k = 0; k < kFftSizeBy2Plus1; ++k) {
+      ASSERT_NEAR(avg_log_lrt_reference[k], avg_log_lrt[k],
+                  1e-5f * fabsf(avg_log_lrt_reference[k]) + 1e-6f);
+    }
+    ASSERT_NEAR(lrt_reference, lrt, 1e-5f * fabsf(lrt_reference));
+  }
+}
+
+}  // namespace
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Verifies that the AVX2 LRT update matches the scalar one.
+TEST(SignalModelEstimator, Avx2Optimizations) {
+  if (!GetAvailableCpuFeatures().avx2) {
+    return;
+  }
+  VerifySpectralLrtUpdate(ns::UpdateSpectralLrt_Avx2);
+}
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+// Verifies that the NEON LRT update matches the scalar one.
+TEST(SignalModelEstimator, NeonOptimizations) {
+  VerifySpectralLrtUpdate(ns::UpdateSpectralLrt_Neon);
+}
+#endif
+
+// Verifies that the signal model estimated with the available CPU features
+// matches the one estimated without them.
+TEST(SignalModelEstimator, CpuFeaturesDoNotAffectModel) {
+  SignalModelEstimator estimator_reference(NoAvailableCpuFeatures());
+  SignalModelEstimator estimator(GetAvailableCpuFeatures());
+  Random random(42U);
+  std::array<float, kFftSizeBy2Plus1> prior_snr;
+  std::array<float, kFftSizeBy2Plus1> post_snr;
+  std::array<float, kFftSizeBy2Plus1> noise_spectrum;
+  std::array<float, kFftSizeBy2Plus1> signal_spectrum;
+  for (int frame = 0; frame < 100; ++frame) {
+    RandomizeSpectrum(&random, 100.f, prior_snr);
+    RandomizeSpectrum(&random, 100.f, post_snr);
+    RandomizeSpectrum(&random, 1000.f, noise_spectrum);
+    RandomizeSpectrum(&random, 1000.f, signal_spectrum);
+    for (float& s : signal_spectrum) {
+      s += 1.f;
+    }
+    float signal_spectral_sum = 0.f;
+    float signal_energy = 0.f;
+    for (float s : signal_spectrum) {
+      signal_spectral_sum += s;
+      signal_energy += s * s;
+    }
+    estimator_reference.Update(prior_snr, post_snr, noise_spectrum,
+                               signal_spectrum, signal_spectral_sum,
+                               signal_energy);
+    estimator.Update(prior_snr, post_snr, noise_spectrum, signal_spectrum,
+                     signal_spectral_sum, signal_energy);
+    const SignalModel& model_reference = estimator_reference.get_model();
+    const SignalModel& model = estimator.get_model();
+    ASSERT_NEAR(model_reference.lrt, model.lrt,
+                1e-5f * fabsf(model_reference.lrt));
+    ASSERT_NEAR(model_reference.spectral_flatness, model.spectral_flatness,
+                1e-5f * fabsf(model_reference.spectral_flatness));
+    ASSERT_EQ(model_reference.spectral_diff, model.spectral_diff);
+  }
+}
+
+}  // namespace webrtc
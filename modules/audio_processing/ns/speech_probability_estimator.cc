@@ -18,7 +18,12 @@
 
 namespace webrtc {
 
-SpeechProbabilityEstimator::SpeechProbabilityEstimator() {
+SpeechProbabilityEstimator::SpeechProbabilityEstimator(
+    const AvailableCpuFeatures& cpu_features,
+    bool vectorized_exp_approximation)
+    : cpu_features_(cpu_features),
+      vectorized_exp_approximation_(vectorized_exp_approximation),
+      signal_model_estimator_(cpu_features) {
   speech_probability_.fill(0.f);
 }
 
@@ -94,7 +99,11 @@ void SpeechProbabilityEstimator::Update(
       (1.f - prior_speech_prob_) / (prior_speech_prob_ + 0.0001f);
 
   std::array<float, kFftSizeBy2Plus1> inv_lrt;
-  ExpApproximationSignFlip(model.avg_log_lrt, inv_lrt);
+  if (vectorized_exp_approximation_) {
+    ExpApproximationSignFlip(cpu_features_, model.avg_log_lrt, inv_lrt);
+  } else {
+    ExpApproximationSignFlip(model.avg_log_lrt, inv_lrt);
+  }
   for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
     speech_probability_[i] = 1.f / (1.f + gain_prior * inv_lrt[i]);
   }
@@ -14,6 +14,7 @@
 #include <array>
 
 #include "api/array_view.h"
+#include "modules/audio_processing/agc2/cpu_features.h"
 #include "modules/audio_processing/ns/ns_common.h"
 #include "modules/audio_processing/ns/signal_model_estimator.h"
 
@@ -22,7 +23,8 @@ namespace webrtc {
 // Class for estimating the probability of speech.
 class SpeechProbabilityEstimator {
  public:
-  SpeechProbabilityEstimator();
+  SpeechProbabilityEstimator(const AvailableCpuFeatures& cpu_features,
+                             bool vectorized_exp_approximation);
   SpeechProbabilityEstimator(const SpeechProbabilityEstimator&) = delete;
   SpeechProbabilityEstimator& operator=(const SpeechProbabilityEstimator&) =
       delete;
@@ -41,6 +43,8 @@ class SpeechProbabilityEstimator {
   rtc::ArrayView<const float> get_probability() { return speech_probability_; }
 
  private:
+  const AvailableCpuFeatures cpu_features_;
+  const bool vectorized_exp_approximation_;
   SignalModelEstimator signal_model_estimator_;
   float prior_speech_prob_ = .5f;
   std::array<float, kFftSizeBy2Plus1> speech_probability_;
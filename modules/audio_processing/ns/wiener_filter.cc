@@ -10,6 +10,9 @@
 
 #include "modules/audio_processing/ns/wiener_filter.h"
 
+#if defined(WEBRTC_HAS_NEON)
+#include <arm_neon.h>
+#endif
 #include <math.h>
 #include <stdlib.h>
 #include <string.h>
@@ -19,24 +22,20 @@
 #include "rtc_base/checks.h"
 
 namespace webrtc {
+namespace ns {
 
-WienerFilter::WienerFilter(const SuppressionParams& suppression_params)
-    : suppression_params_(suppression_params) {
-  filter_.fill(1.f);
-  initial_spectral_estimate_.fill(0.f);
-  spectrum_prev_process_.fill(0.f);
-}
-
-void WienerFilter::Update(
-    int32_t num_analyzed_frames,
-    rtc::ArrayView<const float, kFftSizeBy2Plus1> noise_spectrum,
+void UpdateWienerFilter(
+    float over_subtraction_factor,
+    float minimum_attenuating_gain,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> spectrum_prev_process,
     rtc::ArrayView<const float, kFftSizeBy2Plus1> prev_noise_spectrum,
-    rtc::ArrayView<const float, kFftSizeBy2Plus1> parametric_noise_spectrum,
-    rtc::ArrayView<const float, kFftSizeBy2Plus1> signal_spectrum) {
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> noise_spectrum,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> signal_spectrum,
+    rtc::ArrayView<float, kFftSizeBy2Plus1> filter) {
   for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
     // Previous estimate based on previous frame with gain filter.
-    float prev_tsa = spectrum_prev_process_[i] /
-                     (prev_noise_spectrum[i] + 0.0001f) * filter_[i];
+    float prev_tsa = spectrum_prev_process[i] /
+                     (prev_noise_spectrum[i] + 0.0001f) * filter[i];
 
     // Current estimate.
     float current_tsa;
@@ -49,11 +48,116 @@ void WienerFilter::Update(
     // Directed decision estimate is sum of two terms: current estimate and
     // previous estimate.
     float snr_prior = 0.98f * prev_tsa + (1.f - 0.98f) * current_tsa;
-    filter_[i] =
-        snr_prior / (suppression_params_.over_subtraction_factor + snr_prior);
-    filter_[i] = std::max(std::min(filter_[i], 1.f),
-                          suppression_params_.minimum_attenuating_gain);
+    filter[i] = snr_prior / (over_subtraction_factor + snr_prior);
+    filter[i] = std::max(std::min(filter[i], 1.f), minimum_attenuating_gain);
+  }
+}
+
+#if defined(WEBRTC_HAS_NEON)
+void UpdateWienerFilter_Neon(
+    float over_subtraction_factor,
+    float minimum_attenuating_gain,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> spectrum_prev_process,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> prev_noise_spectrum,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> noise_spectrum,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> signal_spectrum,
+    rtc::ArrayView<float, kFftSizeBy2Plus1> filter) {
+#if defined(WEBRTC_ARCH_ARM64)
+  const float32x4_t regularization = vdupq_n_f32(0.0001f);
+  const float32x4_t one = vdupq_n_f32(1.f);
+  const float32x4_t min_gain = vdupq_n_f32(minimum_attenuating_gain);
+  for (size_t i = 0; i < kFftSizeBy2Plus1 - 1; i += 4) {
+    const float32x4_t filter_i = vld1q_f32(&filter[i]);
+    const float32x4_t noise_i = vld1q_f32(&noise_spectrum[i]);
+    const float32x4_t signal_i = vld1q_f32(&signal_spectrum[i]);
+    const float32x4_t prev_tsa = vmulq_f32(
+        vdivq_f32(vld1q_f32(&spectrum_prev_process[i]),
+                  vaddq_f32(vld1q_f32(&prev_noise_spectrum[i]),
+                            regularization)),
+        filter_i);
+    const uint32x4_t signal_above_noise = vcgtq_f32(signal_i, noise_i);
+    const float32x4_t current_tsa = vreinterpretq_f32_u32(vandq_u32(
+        vreinterpretq_u32_f32(vsubq_f32(
+            vdivq_f32(signal_i, vaddq_f32(noise_i, regularization)), one)),
+        signal_above_noise));
+    const float32x4_t snr_prior =
+        vaddq_f32(vmulq_f32(vdupq_n_f32(0.98f), prev_tsa),
+                  vmulq_f32(vdupq_n_f32(1.f - 0.98f), current_tsa));
+    float32x4_t gain = vdivq_f32(
+        snr_prior,
+        vaddq_f32(vdupq_n_f32(over_subtraction_factor), snr_prior));
+    gain = vmaxq_f32(vminq_f32(gain, one), min_gain);
+    vst1q_f32(&filter[i], gain);
+  }
+
+  // Compute the last bin, which does not fill a full SIMD block.
+  constexpr size_t kLast = kFftSizeBy2Plus1 - 1;
+  float prev_tsa = spectrum_prev_process[kLast] /
+                   (prev_noise_spectrum[kLast] + 0.0001f) * filter[kLast];
+  float current_tsa = 0.f;
+  if (signal_spectrum[kLast] > noise_spectrum[kLast]) {
+    current_tsa =
+        signal_spectrum[kLast] / (noise_spectrum[kLast] + 0.0001f) - 1.f;
+  }
+  float snr_prior = 0.98f * prev_tsa + (1.f - 0.98f) * current_tsa;
+  filter[kLast] = snr_prior / (over_subtraction_factor + snr_prior);
+  filter[kLast] =
+      std::max(std::min(filter[kLast], 1.f), minimum_attenuating_gain);
+#else
+  // ARMv7 NEON has no division instruction.
+  UpdateWienerFilter(over_subtraction_factor, minimum_attenuating_gain,
+                     spectrum_prev_process, prev_noise_spectrum,
+                     noise_spectrum, signal_spectrum, filter);
+#endif
+}
+#endif
+
+}  // namespace ns
+
+WienerFilter::WienerFilter(const SuppressionParams& suppression_params,
+                           const AvailableCpuFeatures& cpu_features)
+    : suppression_params_(suppression_params), cpu_features_(cpu_features) {
+  filter_.fill(1.f);
+  initial_spectral_estimate_.fill(0.f);
+  spectrum_prev_process_.fill(0.f);
+}
+
+void WienerFilter::Update(
+    int32_t num_analyzed_frames,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> noise_spectrum,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> prev_noise_spectrum,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> parametric_noise_spectrum,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> signal_spectrum) {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (cpu_features_.avx2) {
+    ns::UpdateWienerFilter_Avx2(suppression_params_.over_subtraction_factor,
+                                suppression_params_.minimum_attenuating_gain,
+                                spectrum_prev_process_, prev_noise_spectrum,
+                                noise_spectrum, signal_spectrum, filter_);
+  } else {
+    ns::UpdateWienerFilter(suppression_params_.over_subtraction_factor,
+                           suppression_params_.minimum_attenuating_gain,
+                           spectrum_prev_process_, prev_noise_spectrum,
+                           noise_spectrum, signal_spectrum, filter_);
+  }
+#elif defined(WEBRTC_HAS_NEON)
+  if (cpu_features_.neon) {
+    ns::UpdateWienerFilter_Neon(suppression_params_.over_subtraction_factor,
+                                suppression_params_.minimum_attenuating_gain,
+                                spectrum_prev_process_, prev_noise_spectrum,
+                                noise_spectrum, signal_spectrum, filter_);
+  } else {
+    ns::UpdateWienerFilter(suppression_params_.over_subtraction_factor,
+                           suppression_params_.minimum_attenuating_gain,
+                           spectrum_prev_process_, prev_noise_spectrum,
+                           noise_spectrum, signal_spectrum, filter_);
   }
+#else
+  ns::UpdateWienerFilter(suppression_params_.over_subtraction_factor,
+                         suppression_params_.minimum_attenuating_gain,
+                         spectrum_prev_process_, prev_noise_spectrum,
+                         noise_spectrum, signal_spectrum, filter_);
+#endif
 
   if (num_analyzed_frames < kShortStartupPhaseBlocks) {
     for (size_t i = 0; i < kFftSizeBy2Plus1; ++i) {
@@ -14,15 +14,52 @@
 #include <array>
 
 #include "api/array_view.h"
+#include "modules/audio_processing/agc2/cpu_features.h"
 #include "modules/audio_processing/ns/ns_common.h"
 #include "modules/audio_processing/ns/suppression_params.h"
+#include "rtc_base/system/arch.h"
 
 namespace webrtc {
+namespace ns {
+
+// Updates the Wiener filter gains in `filter` based on the directed decision
+// estimate of the prior SNR.
+void UpdateWienerFilter(
+    float over_subtraction_factor,
+    float minimum_attenuating_gain,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> spectrum_prev_process,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> prev_noise_spectrum,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> noise_spectrum,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> signal_spectrum,
+    rtc::ArrayView<float, kFftSizeBy2Plus1> filter);
+#if defined(WEBRTC_HAS_NEON)
+void UpdateWienerFilter_Neon(
+    float over_subtraction_factor,
+    float minimum_attenuating_gain,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> spectrum_prev_process,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> prev_noise_spectrum,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> noise_spectrum,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> signal_spectrum,
+    rtc::ArrayView<float, kFftSizeBy2Plus1> filter);
+#endif
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void UpdateWienerFilter_Avx2(
+    float over_subtraction_factor,
+    float minimum_attenuating_gain,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> spectrum_prev_process,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> prev_noise_spectrum,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> noise_spectrum,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> signal_spectrum,
+    rtc::ArrayView<float, kFftSizeBy2Plus1> filter);
+#endif
+
+}  // namespace ns
 
 // Estimates a Wiener-filter based frequency domain noise reduction filter.
 class WienerFilter {
  public:
-  explicit WienerFilter(const SuppressionParams& suppression_params);
+  WienerFilter(const SuppressionParams& suppression_params,
+               const AvailableCpuFeatures& cpu_features);
   WienerFilter(const WienerFilter&) = delete;
   WienerFilter& operator=(const WienerFilter&) = delete;
 
@@ -47,6 +84,7 @@ class WienerFilter {
 
  private:
   const SuppressionParams& suppression_params_;
+  const AvailableCpuFeatures cpu_features_;
   std::array<float, kFftSizeBy2Plus1> spectrum_prev_process_;
   std::array<float, kFftSizeBy2Plus1> initial_spectral_estimate_;
   std::array<float, kFftSizeBy2Plus1> filter_;
@@ -0,0 +1,74 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+
+#include <algorithm>
+
+#include "api/array_view.h"
+#include "modules/audio_processing/ns/wiener_filter.h"
+
+namespace webrtc {
+namespace ns {
+
+void UpdateWienerFilter_Avx2(
+    float over_subtraction_factor,
+    float minimum_attenuating_gain,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> spectrum_prev_process,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> prev_noise_spectrum,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> noise_spectrum,
+    rtc::ArrayView<const float, kFftSizeBy2Plus1> signal_spectrum,
+    rtc::ArrayView<float, kFftSizeBy2Plus1> filter) {
+  const __m256 regularization = _mm256_set1_ps(0.0001f);
+  const __m256 one = _mm256_set1_ps(1.f);
+  const __m256 min_gain = _mm256_set1_ps(minimum_attenuating_gain);
+  for (size_t i = 0; i < kFftSizeBy2Plus1 - 1; i += 8) {
+    const __m256 filter_i = _mm256_loadu_ps(&filter[i]);
+    const __m256 noise_i = _mm256_loadu_ps(&noise_spectrum[i]);
+    const __m256 signal_i = _mm256_loadu_ps(&signal_spectrum[i]);
+    const __m256 prev_tsa = _mm256_mul_ps(
+        _mm256_div_ps(_mm256_loadu_ps(&spectrum_prev_process[i]),
+                      _mm256_add_ps(_mm256_loadu_ps(&prev_noise_spectrum[i]),
+                                    regularization)),
+        filter_i);
+    const __m256 signal_above_noise =
+        _mm256_cmp_ps(signal_i, noise_i, _CMP_GT_OQ);
+    const __m256 current_tsa = _mm256_and_ps(
+        _mm256_sub_ps(
+            _mm256_div_ps(signal_i, _mm256_add_ps(noise_i, regularization)),
+            one),
+        signal_above_noise);
+    const __m256 snr_prior =
+        _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(0.98f), prev_tsa),
+                      _mm256_mul_ps(_mm256_set1_ps(1.f - 0.98f), current_tsa));
+    __m256 gain = _mm256_div_ps(
+        snr_prior,
+        _mm256_add_ps(_mm256_set1_ps(over_subtraction_factor), snr_prior));
+    gain = _mm256_max_ps(_mm256_min_ps(gain, one), min_gain);
+    _mm256_storeu_ps(&filter[i], gain);
+  }
+
+  // Compute the last bin, which does not fill a full SIMD block.
+  constexpr size_t kLast = kFftSizeBy2Plus1 - 1;
+  float prev_tsa = spectrum_prev_process[kLast] /
+                   (prev_noise_spectrum[kLast] + 0.0001f) * filter[kLast];
+  float current_tsa = 0.f;
+  if (signal_spectrum[kLast] > noise_spectrum[kLast]) {
+    current_tsa =
+        signal_spectrum[kLast] / (noise_spectrum[kLast] + 0.0001f) - 1.f;
+  }
+  float snr_prior = 0.98f * prev_tsa + (1.f - 0.98f) * current_tsa;
+  filter[kLast] = snr_prior / (over_subtraction_factor + snr_prior);
+  filter[kLast] =
+      std::max(std::min(filter[kLast], 1.f), minimum_attenuating_gain);
+}
+
+}  // namespace ns
+}  // namespace webrtc
@@ -0,0 +1,119 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/audio_processing/ns/wiener_filter.h"
+
+#include <array>
+
+#include "modules/audio_processing/agc2/cpu_features.h"
+#include "modules/audio_processing/ns/ns_config.h"
+#include "modules/audio_processing/ns/suppression_params.h"
+#include "rtc_base/random.h"
+#include "rtc_base/system/arch.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+void RandomizeSpectrum(Random* random,
+                       rtc::ArrayView<float, kFftSizeBy2Plus1> spectrum) {
+  for (float& s : spectrum) {
+    s = 1.f + 10000.f * random->Rand<float>();
+  }
+}
+
+// Runs the filter update for a number of frames of random spectra and verifies
+// that `update_filter` produces the same filter as the scalar version.
+template <typename UpdateFilter>
+void VerifyFilterUpdate(UpdateFilter update_filter) {
+  Random random(42U);
+  for (auto level :
+       {NsConfig::SuppressionLevel::k6dB, NsConfig::SuppressionLevel::k21dB}) {
+    const SuppressionParams params(level);
+    std::array<float, kFftSizeBy2Plus1> filter_reference;
+    std::array<float, kFftSizeBy2Plus1> filter;
+    filter_reference.fill(1.f);
+    filter.fill(1.f);
+    std::array<float, kFftSizeBy2Plus1> prev_signal_spectrum;
+    std::array<float, kFftSizeBy2Plus1> prev_noise_spectrum;
+    std::array<float, kFftSizeBy2Plus1> noise_spectrum;
+    std::array<float, kFftSizeBy2Plus1> signal_spectrum;
+    RandomizeSpectrum(&random, prev_signal_spectrum);
+    RandomizeSpectrum(&random, noise_spectrum);
+    for (int frame = 0; frame < 100; ++frame) {
+      prev_noise_spectrum = noise_spectrum;
+      RandomizeSpectrum(&random, noise_spectrum);
+      RandomizeSpectrum(&random, signal_spectrum);
+      ns::UpdateWienerFilter(params.over_subtraction_factor,
+                             params.minimum_attenuating_gain,
+                             prev_signal_spectrum, prev_noise_spectrum,
+                             noise_spectrum, signal_spectrum, filter_reference);
+      update_filter(params.over_subtraction_factor,
+                    params.minimum_attenuating_gain, prev_signal_spectrum,
+                    prev_noise_spectrum, noise_spectrum, signal_spectrum,
+                    filter);
+      for (size_t k = 0; k < kFftSizeBy2Plus1; ++k) {
+        ASSERT_NEAR(filter_reference[k], filter[k], 1e-6f);
+      }
+      prev_signal_spectrum = signal_spectrum;
+    }
+  }
+}
+
+}  // namespace
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Verifies that the AVX2 filter update matches the scalar one.
+TEST(WienerFilter, Avx2Optimizations) {
+  if (!GetAvailableCpuFeatures().avx2) {
+    return;
+  }
+  VerifyFilterUpdate(ns::UpdateWienerFilter_Avx2);
+}
+#endif
+
+#if defined(WEBRTC_HAS_NEON)
+// Verifies that the NEON filter update matches the scalar one.
+TEST(WienerFilter, NeonOptimizations) {
+  VerifyFilterUpdate(ns::UpdateWienerFilter_Neon);
+}
+#endif
+
+// Verifies that the filter produced with the available CPU features matches
+// the one produced without them.
+TEST(WienerFilter, CpuFeaturesDoNotAffectFilter) {
+  const SuppressionParams params(NsConfig::SuppressionLevel::k12dB);
+  WienerFilter filter_reference(params, NoAvailableCpuFeatures());
+  WienerFilter filter(params, GetAvailableCpuFeatures());
+  Random random(42U);
+  std::array<float, kFftSizeBy2Plus1> noise_spectrum;
+  std::array<float, kFftSizeBy2Plus1> prev_noise_spectrum;
+  std::array<float, kFftSizeBy2Plus1> parametric_noise_spectrum;
+  std::array<float, kFftSizeBy2Plus1> signal_spectrum;
+  RandomizeSpectrum(&random, noise_spectrum);
+  for (int32_t num_analyzed_frames = 0; num_analyzed_frames < 100;
+       ++num_analyzed_frames) {
+    prev_noise_spectrum = noise_spectrum;
+    RandomizeSpectrum(&random, noise_spectrum);
+    RandomizeSpectrum(&random, parametric_noise_spectrum);
+    RandomizeSpectrum(&random, signal_spectrum);
+    filter_reference.Update(num_analyzed_frames, noise_spectrum,
+                            prev_noise_spectrum, parametric_noise_spectrum,
+                            signal_spectrum);
+    filter.Update(num_analyzed_frames, noise_spectrum, prev_noise_spectrum,
+                  parametric_noise_spectrum, signal_spectrum);
+    for (size_t k = 0; k < kFftSizeBy2Plus1; ++k) {
+      ASSERT_NEAR(filter_reference.get_filter()[k], filter.get_filter()[k],
+                  1e-6f);
+    }
+  }
+}
+
+}  // namespace webrtc
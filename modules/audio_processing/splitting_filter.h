@@ -20,6 +20,8 @@
 
 namespace webrtc {
 
+class WorkerPool;
+
 struct TwoBandsStates {
   TwoBandsStates() {
     memset(analysis_state1, 0, sizeof(analysis_state1));
@@ -41,7 +43,7 @@ struct TwoBandsStates {
 // For each block, Analysis() is called to split into bands and then Synthesis()
 // to merge these bands again. The input and output signals are contained in
 // ChannelBuffers and for the different bands an array of ChannelBuffers is
-// used.
+// used. If a `WorkerPool` is given, the channels are filtered in parallel.
 class SplittingFilter {
  public:
   SplittingFilter(size_t num_channels, size_t num_bands, size_t num_frames);
@@ -49,17 +51,27 @@ class SplittingFilter {
 
   void Analysis(const ChannelBuffer<float>* data, ChannelBuffer<float>* bands);
   void Synthesis(const ChannelBuffer<float>* bands, ChannelBuffer<float>* data);
+  void Analysis(const ChannelBuffer<float>* data,
+                ChannelBuffer<float>* bands,
+                WorkerPool* worker_pool);
+  void Synthesis(const ChannelBuffer<float>* bands,
+                 ChannelBuffer<float>* data,
+                 WorkerPool* worker_pool);
 
  private:
   // Two-band analysis and synthesis work for 640 samples or less.
   void TwoBandsAnalysis(const ChannelBuffer<float>* data,
-                        ChannelBuffer<float>* bands);
+                        ChannelBuffer<float>* bands,
+                        size_t channel);
   void TwoBandsSynthesis(const ChannelBuffer<float>* bands,
-                         ChannelBuffer<float>* data);
+                         ChannelBuffer<float>* data,
+                         size_t channel);
   void ThreeBandsAnalysis(const ChannelBuffer<float>* data,
-                          ChannelBuffer<float>* bands);
+                          ChannelBuffer<float>* bands,
+                          size_t channel);
   void ThreeBandsSynthesis(const ChannelBuffer<float>* bands,
-                           ChannelBuffer<float>* data);
+                           ChannelBuffer<float>* data,
+                           size_t channel);
   void InitBuffers();
 
   const size_t num_bands_;
@@ -16,6 +16,8 @@
 #include <cmath>
 
 #include "common_audio/channel_buffer.h"
+#include "rtc_base/random.h"
+#include "rtc_base/worker_pool.h"
 #include "test/gtest.h"
 
 namespace webrtc {
@@ -100,4 +102,49 @@ TEST(SplittingFilterTest, SplitsIntoThreeBandsAndReconstructs) {
   }
 }
 
+// Checks that filtering the channels in parallel gives the same result as
+// filtering them one by one.
+TEST(SplittingFilterTest, WorkerPoolDoesNotAffectOutput) {
+  constexpr size_t kChannels = 5;
+  constexpr size_t kChunks = 10;
+  WorkerPool worker_pool(2);
+  for (size_t num_frames : {size_t{320}, kSamplesPer48kHzChannel}) {
+    const size_t num_bands = num_frames == kSamplesPer48kHzChannel ? 3 : 2;
+    SplittingFilter splitting_filter(kChannels, num_bands, num_frames);
+    SplittingFilter parallel_splitting_filter(kChannels, num_bands,
+                                              num_frames);
+    ChannelBuffer<float> in_data(num_frames, kChannels, num_bands);
+    ChannelBuffer<float> bands(num_frames, kChannels, num_bands);
+    ChannelBuffer<float> parallel_bands(num_frames, kChannels, num_bands);
+    ChannelBuffer<float> out_data(num_frames, kChannels, num_bands);
+    ChannelBuffer<float> parallel_out_data(num_frames, kChannels, num_bands);
+    Random random(42);
+    for (size_t i = 0; i < kChunks; ++i) {
+      for (size_t ch = 0; ch < kChannels; ++ch) {
+        for (size_t k = 0; k < num_frames; ++k) {
+          in_data.channels()[ch][k] = random.Rand(-8192, 8192);
+        }
+      }
+      splitting_filter.Analysis(&in_data, &bands);
+      parallel_splitting_filter.Analysis(&in_data, &parallel_bands,
+                                         &worker_pool);
+      splitting_filter.Synthesis(&bands, &out_data);
+      parallel_splitting_filter.Synthesis(&parallel_bands, &parallel_out_data,
+                                          &worker_pool);
+      for (size_t ch = 0; ch < kChannels; ++ch) {
+        for (size_t b = 0; b < num_bands; ++b) {
+          for (size_t k = 0; k < num_frames / num_bands; ++k) {
+            ASSERT_EQ(bands.channels(b)[ch][k],
+                      parallel_bands.channels(b)[ch][k]);
+          }
+        }
+        for (size_t k = 0; k < num_frames; ++k) {
+          ASSERT_EQ(out_data.channels()[ch][k],
+                    parallel_out_data.channels()[ch][k]);
+        }
+      }
+    }
+  }
+}
+
 }  // namespace webrtc
@@ -0,0 +1,133 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "api/units/data_rate.h"
+#include "api/units/time_delta.h"
+#include "benchmark/benchmark.h"
+#include "modules/pacing/pacing_controller.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/async_udp_socket.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/physical_socket_server.h"
+#include "system_wrappers/include/clock.h"
+#include "test/explicit_key_value_config.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kPayloadSize = 1150;
+constexpr uint32_t kSsrc = 12345;
+
+// Forwards paced packets to a UDP socket, either one SendTo() per packet or,
+// like RtpSenderEgress with `enable_send_packet_batching`, holding them back
+// until OnBatchComplete() and sending them as one batch.
+class SocketPacketSender : public PacingController::PacketSender {
+ public:
+  SocketPacketSender(rtc::AsyncPacketSocket* socket,
+                     const rtc::SocketAddress& destination,
+                     bool batching)
+      : socket_(socket), destination_(destination), batching_(batching) {}
+
+  void SendPacket(std::unique_ptr<RtpPacketToSend> packet,
+                  const PacedPacketInfo& cluster_info) override {
+    if (batching_) {
+      pending_.push_back(std::move(packet));
+      return;
+    }
+    socket_->SendTo(packet->data(), packet->size(), destination_,
+                    rtc::PacketOptions());
+    ++packets_sent_;
+  }
+
+  std::vector<std::unique_ptr<RtpPacketToSend>> FetchFec() override {
+    return {};
+  }
+
+  std::vector<std::unique_ptr<RtpPacketToSend>> GeneratePadding(
+      DataSize size) override {
+    return {};
+  }
+
+  void OnBatchComplete() override {
+    rtc::PacketOptions options;
+    options.batchable = true;
+    for (size_t i = 0; i < pending_.size(); ++i) {
+      options.last_packet_in_batch = i + 1 == pending_.size();
+      socket_->SendTo(pending_[i]->data(), pending_[i]->size(), destination_,
+                      options);
+    }
+    packets_sent_ += pending_.size();
+    pending_.clear();
+  }
+
+  size_t packets_sent() const { return packets_sent_; }
+
+ private:
+  rtc::AsyncPacketSocket* const socket_;
+  const rtc::SocketAddress destination_;
+  const bool batching_;
+  std::vector<std::unique_ptr<RtpPacketToSend>> pending_;
+  size_t packets_sent_ = 0;
+};
+
+// Measures packets/s from the pacer down to the socket for a burst of
+// `state.range(0)` equally sized video packets released in one
+// ProcessPackets() call, without (range(1) == 0) and with (range(1) == 1)
+// send batching. Equal sizes let the batched path use UDP GSO where the
+// kernel supports it.
+void BM_PacerToSocket(benchmark::State& state) {
+  const int burst_size = static_cast<int>(state.range(0));
+  const bool batching = state.range(1) != 0;
+
+  rtc::PhysicalSocketServer pss;
+  std::unique_ptr<rtc::AsyncUDPSocket> sender(rtc::AsyncUDPSocket::Create(
+      &pss, rtc::SocketAddress("127.0.0.1", 0)));
+  std::unique_ptr<rtc::AsyncUDPSocket> receiver(rtc::AsyncUDPSocket::Create(
+      &pss, rtc::SocketAddress("127.0.0.1", 0)));
+  RTC_CHECK(sender && receiver);
+  SocketPacketSender packet_sender(sender.get(), receiver->GetLocalAddress(),
+                                   batching);
+
+  SimulatedClock clock(Timestamp::Seconds(1000));
+  test::ExplicitKeyValueConfig field_trials("");
+  PacingController pacer(&clock, &packet_sender, field_trials);
+  pacer.SetPacingRates(DataRate::BitsPerSec(1'000'000'000), DataRate::Zero());
+  pacer.SetSendBurstInterval(TimeDelta::Millis(5));
+
+  uint16_t sequence_number = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    for (int i = 0; i < burst_size; ++i) {
+      auto packet = std::make_unique<RtpPacketToSend>(/*extensions=*/nullptr);
+      packet->SetSsrc(kSsrc);
+      packet->SetSequenceNumber(sequence_number++);
+      packet->set_packet_type(RtpPacketMediaType::kVideo);
+      packet->set_capture_time(clock.CurrentTime());
+      packet->AllocatePayload(kPayloadSize);
+      pacer.EnqueuePacket(std::move(packet));
+    }
+    clock.AdvanceTime(TimeDelta::Millis(5));
+    state.ResumeTiming();
+
+    pacer.ProcessPackets();
+  }
+  state.SetItemsProcessed(packet_sender.packets_sent());
+}
+
+BENCHMARK(BM_PacerToSocket)
+    ->ArgNames({"burst", "batching"})
+    ->ArgsProduct({{1, 10, 32}, {0, 1}});
+
+}  // namespace
+}  // namespace webrtc
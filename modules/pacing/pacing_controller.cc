@@ -393,6 +393,7 @@ void PacingController::ProcessPackets() {
           EnqueuePacket(std::move(packet));
         }
       }
+      packet_sender_->OnBatchComplete();
     }
     OnPacketSent(RtpPacketMediaType::kPadding, keepalive_data_sent, now);
   }
@@ -511,6 +512,10 @@ void PacingController::ProcessPackets() {
     }
   }
 
+  if (packets_sent > 0) {
+    packet_sender_->OnBatchComplete();
+  }
+
   if (iteration >= kMaxIterations) {
     // Circuit break activated. Log warning, adjust send time and return.
     // TODO(sprang): Consider completely clearing state.
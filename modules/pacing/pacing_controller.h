@@ -51,6 +51,10 @@ class PacingController {
     virtual std::vector<std::unique_ptr<RtpPacketToSend>> FetchFec() = 0;
     virtual std::vector<std::unique_ptr<RtpPacketToSend>> GeneratePadding(
         DataSize size) = 0;
+    // Called after a burst of packets has been sent by a single
+    // ProcessPackets() call, so that packets held back for batching can be
+    // sent on to the network.
+    virtual void OnBatchComplete() {}
   };
 
   // Interface for class hanlding storage of and prioritization of packets
@@ -147,6 +147,7 @@ class MockPacketSender : public PacingController::PacketSender {
               GeneratePadding,
               (DataSize target_size),
               (override));
+  MOCK_METHOD(void, OnBatchComplete, (), (override));
 };
 
 class PacingControllerPadding : public PacingController::PacketSender {
@@ -2061,5 +2062,29 @@ TEST_F(PacingControllerTest, RespectsQueueTimeLimit) {
   EXPECT_EQ(pacer.pacing_rate(), kNominalPacingRate);
 }
 
+TEST_F(PacingControllerTest, CallsOnBatchCompleteAfterSendingPackets) {
+  ::testing::StrictMock<MockPacketSender> callback;
+  PacingController pacer(&clock_, &callback, trials_);
+  pacer.SetPacingRates(kTargetRate, DataRate::Zero());
+  pacer.EnqueuePacket(video_.BuildNextPacket());
+
+  ::testing::InSequence seq;
+  EXPECT_CALL(callback, SendPacket);
+  EXPECT_CALL(callback, FetchFec).WillOnce([]() {
+    return std::vector<std::unique_ptr<RtpPacketToSend>>();
+  });
+  EXPECT_CALL(callback, OnBatchComplete);
+  pacer.ProcessPackets();
+}
+
+TEST_F(PacingControllerTest, DoesNotCallOnBatchCompleteWithoutPackets) {
+  ::testing::StrictMock<MockPacketSender> callback;
+  PacingController pacer(&clock_, &callback, trials_);
+  pacer.SetPacingRates(kTargetRate, DataRate::Zero());
+
+  EXPECT_CALL(callback, OnBatchComplete).Times(0);
+  pacer.ProcessPackets();
+}
+
 }  // namespace
 }  // namespace webrtc
@@ -108,6 +108,14 @@ void PacketRouter::RemoveSendRtpModule(RtpRtcpInterface* rtp_module) {
     last_send_module_ = nullptr;
   }
   rtp_module->OnPacketSendingThreadSwitched();
+  auto it = std::find(modules_used_in_current_batch_.begin(),
+                      modules_used_in_current_batch_.end(), rtp_module);
+  if (it != modules_used_in_current_batch_.end()) {
+    // The pacer will not tell the module that the current batch is complete,
+    // so send the packets it holds back now.
+    modules_used_in_current_batch_.erase(it);
+    rtp_module->OnBatchComplete();
+  }
 }
 
 void PacketRouter::AddReceiveRtpModule(RtcpFeedbackSenderInterface* rtcp_sender,
@@ -172,6 +180,12 @@ void PacketRouter::SendPacket(std::unique_ptr<RtpPacketToSend> packet,
     ++transport_seq_;
   }
 
+  if (std::find(modules_used_in_current_batch_.begin(),
+                modules_used_in_current_batch_.end(),
+                rtp_module) == modules_used_in_current_batch_.end()) {
+    modules_used_in_current_batch_.push_back(rtp_module);
+  }
+
   if (rtp_module->SupportsRtxPayloadPadding()) {
     // This is now the last module to send media, and has the desired
     // properties needed for payload based padding. Cache it for later use.
@@ -191,6 +205,14 @@ std::vector<std::unique_ptr<RtpPacketToSend>> PacketRouter::FetchFec() {
   return fec_packets;
 }
 
+void PacketRouter::OnBatchComplete() {
+  MutexLock lock(&modules_mutex_);
+  for (RtpRtcpInterface* rtp_module : modules_used_in_current_batch_) {
+    rtp_module->OnBatchComplete();
+  }
+  modules_used_in_current_batch_.clear();
+}
+
 std::vector<std::unique_ptr<RtpPacketToSend>> PacketRouter::GeneratePadding(
     DataSize size) {
   TRACE_EVENT1(TRACE_DISABLED_BY_DEFAULT("webrtc"),
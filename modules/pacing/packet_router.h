@@ -58,6 +58,7 @@ class PacketRouter : public PacingController::PacketSender {
   std::vector<std::unique_ptr<RtpPacketToSend>> FetchFec() override;
   std::vector<std::unique_ptr<RtpPacketToSend>> GeneratePadding(
       DataSize size) override;
+  void OnBatchComplete() override;
 
   uint16_t CurrentTransportSequenceNumber() const;
 
@@ -109,6 +110,9 @@ class PacketRouter : public PacingController::PacketSender {
   // process thread is gone.
   std::vector<std::unique_ptr<RtpPacketToSend>> pending_fec_packets_
       RTC_GUARDED_BY(modules_mutex_);
+  // Modules that have sent packets since the last OnBatchComplete().
+  std::vector<RtpRtcpInterface*> modules_used_in_current_batch_
+      RTC_GUARDED_BY(modules_mutex_);
 };
 }  // namespace webrtc
 #endif  // MODULES_PACING_PACKET_ROUTER_H_
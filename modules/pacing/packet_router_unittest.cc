@@ -436,6 +436,67 @@ TEST_F(PacketRouterTest, DoesNotIncrementTransportSequenceNumberOnSendFailure) {
   packet_router_.RemoveSendRtpModule(&rtp);
 }
 
+TEST_F(PacketRouterTest, ForwardsBatchCompleteToModulesThatSentPackets) {
+  NiceMock<MockRtpRtcpInterface> rtp_1;
+  NiceMock<MockRtpRtcpInterface> rtp_2;
+  NiceMock<MockRtpRtcpInterface> rtp_3;
+  constexpr uint32_t kSsrc1 = 1234;
+  constexpr uint32_t kSsrc2 = 2345;
+  constexpr uint32_t kSsrc3 = 3456;
+  ON_CALL(rtp_1, SSRC).WillByDefault(Return(kSsrc1));
+  ON_CALL(rtp_2, SSRC).WillByDefault(Return(kSsrc2));
+  ON_CALL(rtp_3, SSRC).WillByDefault(Return(kSsrc3));
+  ON_CALL(rtp_1, TrySendPacket).WillByDefault(Return(true));
+  ON_CALL(rtp_2, TrySendPacket).WillByDefault(Return(true));
+  ON_CALL(rtp_3, TrySendPacket).WillByDefault(Return(false));
+  packet_router_.AddSendRtpModule(&rtp_1, false);
+  packet_router_.AddSendRtpModule(&rtp_2, false);
+  packet_router_.AddSendRtpModule(&rtp_3, false);
+
+  packet_router_.SendPacket(BuildRtpPacket(kSsrc1), PacedPacketInfo());
+  packet_router_.SendPacket(BuildRtpPacket(kSsrc1), PacedPacketInfo());
+  packet_router_.SendPacket(BuildRtpPacket(kSsrc2), PacedPacketInfo());
+  // Rejected packets don't make a module part of the batch.
+  packet_router_.SendPacket(BuildRtpPacket(kSsrc3), PacedPacketInfo());
+
+  EXPECT_CALL(rtp_1, OnBatchComplete).Times(1);
+  EXPECT_CALL(rtp_2, OnBatchComplete).Times(1);
+  EXPECT_CALL(rtp_3, OnBatchComplete).Times(0);
+  packet_router_.OnBatchComplete();
+
+  // The batch is reset afterwards.
+  EXPECT_CALL(rtp_1, OnBatchComplete).Times(0);
+  EXPECT_CALL(rtp_2, OnBatchComplete).Times(0);
+  packet_router_.OnBatchComplete();
+
+  packet_router_.RemoveSendRtpModule(&rtp_1);
+  packet_router_.RemoveSendRtpModule(&rtp_2);
+  packet_router_.RemoveSendRtpModule(&rtp_3);
+}
+
+TEST_F(PacketRouterTest, CompletesBatchOfModuleRemovedDuringBatch) {
+  NiceMock<MockRtpRtcpInterface> rtp_1;
+  NiceMock<MockRtpRtcpInterface> rtp_2;
+  constexpr uint32_t kSsrc1 = 1234;
+  constexpr uint32_t kSsrc2 = 2345;
+  ON_CALL(rtp_1, SSRC).WillByDefault(Return(kSsrc1));
+  ON_CALL(rtp_2, SSRC).WillByDefault(Return(kSsrc2));
+  ON_CALL(rtp_1, TrySendPacket).WillByDefault(Return(true));
+  packet_router_.AddSendRtpModule(&rtp_1, false);
+  packet_router_.AddSendRtpModule(&rtp_2, false);
+
+  packet_router_.SendPacket(BuildRtpPacket(kSsrc1), PacedPacketInfo());
+
+  // Only a module that sent packets in the current batch is told.
+  EXPECT_CALL(rtp_2, OnBatchComplete).Times(0);
+  packet_router_.RemoveSendRtpModule(&rtp_2);
+  EXPECT_CALL(rtp_1, OnBatchComplete).Times(1);
+  packet_router_.RemoveSendRtpModule(&rtp_1);
+
+  // The removed module is no longer part of the batch.
+  packet_router_.OnBatchComplete();
+}
+
 #if RTC_DCHECK_IS_ON && GTEST_HAS_DEATH_TEST && !defined(WEBRTC_ANDROID)
 using PacketRouterDeathTest = PacketRouterTest;
 TEST_F(PacketRouterDeathTest, DoubleRegistrationOfSendModuleDisallowed) {
@@ -15,6 +15,7 @@
 #include <memory>
 #include <utility>
 
+#include "absl/algorithm/container.h"
 #include "modules/include/module_common_types_public.h"
 #include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
 #include "rtc_base/checks.h"
@@ -38,33 +39,15 @@ RtpPacketHistory::StoredPacket& RtpPacketHistory::StoredPacket::operator=(
     RtpPacketHistory::StoredPacket&&) = default;
 RtpPacketHistory::StoredPacket::~StoredPacket() = default;
 
-void RtpPacketHistory::StoredPacket::IncrementTimesRetransmitted(
-    PacketPrioritySet* priority_set) {
-  // Check if this StoredPacket is in the priority set. If so, we need to remove
-  // it before updating `times_retransmitted_` since that is used in sorting,
-  // and then add it back.
-  const bool in_priority_set = priority_set && priority_set->erase(this) > 0;
-  ++times_retransmitted_;
-  if (in_priority_set) {
-    auto it = priority_set->insert(this);
-    RTC_DCHECK(it.second)
-        << "ERROR: Priority set already contains matching packet! In set: "
-           "insert order = "
-        << (*it.first)->insert_order_
-        << ", times retransmitted = " << (*it.first)->times_retransmitted_
-        << ". Trying to add: insert order = " << insert_order_
-        << ", times retransmitted = " << times_retransmitted_;
-  }
-}
-
-bool RtpPacketHistory::MoreUseful::operator()(StoredPacket* lhs,
-                                              StoredPacket* rhs) const {
+bool RtpPacketHistory::MoreUseful::operator()(
+    const PaddingCandidate& lhs,
+    const PaddingCandidate& rhs) const {
   // Prefer to send packets we haven't already sent as padding.
-  if (lhs->times_retransmitted() != rhs->times_retransmitted()) {
-    return lhs->times_retransmitted() < rhs->times_retransmitted();
+  if (lhs.times_retransmitted != rhs.times_retransmitted) {
+    return lhs.times_retransmitted < rhs.times_retransmitted;
   }
   // All else being equal, prefer newer packets.
-  return lhs->insert_order() > rhs->insert_order();
+  return lhs.insert_order > rhs.insert_order;
 }
 
 RtpPacketHistory::RtpPacketHistory(Clock* clock, bool enable_padding_prio)
@@ -73,7 +56,13 @@ RtpPacketHistory::RtpPacketHistory(Clock* clock, bool enable_padding_prio)
       number_to_store_(0),
       mode_(StorageMode::kDisabled),
       rtt_(TimeDelta::MinusInfinity()),
-      packets_inserted_(0) {}
+      ring_start_(0),
+      num_slots_(0),
+      packets_inserted_(0) {
+  if (enable_padding_prio_) {
+    padding_priority_.reserve(kMaxPaddingHistory);
+  }
+}
 
 RtpPacketHistory::~RtpPacketHistory() {}
 
@@ -87,6 +76,9 @@ void RtpPacketHistory::SetStorePacketsStatus(StorageMode mode,
   Reset();
   mode_ = mode;
   number_to_store_ = std::min(kMaxCapacity, number_to_store);
+  if (mode_ != StorageMode::kDisabled) {
+    EnsureRingCapacity(number_to_store_);
+  }
 }
 
 RtpPacketHistory::StorageMode RtpPacketHistory::GetStorageMode() const {
@@ -120,37 +112,41 @@ void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
   // Store packet.
   const uint16_t rtp_seq_no = packet->SequenceNumber();
   int packet_index = GetPacketIndex(rtp_seq_no);
-  if (packet_index >= 0 &&
-      static_cast<size_t>(packet_index) < packet_history_.size() &&
-      packet_history_[packet_index].packet_ != nullptr) {
+  if (packet_index >= 0 && static_cast<size_t>(packet_index) < num_slots_ &&
+      Slot(packet_index).packet_ != nullptr) {
     RTC_LOG(LS_WARNING) << "Duplicate packet inserted: " << rtp_seq_no;
     // Remove previous packet to avoid inconsistent state.
     RemovePacket(packet_index);
     packet_index = GetPacketIndex(rtp_seq_no);
   }
 
-  // Packet to be inserted ahead of first packet, expand front.
-  for (; packet_index < 0; ++packet_index) {
-    packet_history_.emplace_front();
-  }
-  // Packet to be inserted behind last packet, expand back.
-  while (static_cast<int>(packet_history_.size()) <= packet_index) {
-    packet_history_.emplace_back();
+  if (packet_index < 0) {
+    // Packet to be inserted ahead of first packet, expand front.
+    const size_t num_new_slots = -packet_index;
+    EnsureRingCapacity(num_slots_ + num_new_slots);
+    ring_start_ = (ring_start_ - num_new_slots) & (ring_.size() - 1);
+    num_slots_ += num_new_slots;
+    packet_index = 0;
+  } else if (static_cast<size_t>(packet_index) >= num_slots_) {
+    // Packet to be inserted behind last packet, expand back.
+    EnsureRingCapacity(packet_index + 1);
+    num_slots_ = packet_index + 1;
   }
 
   RTC_DCHECK_GE(packet_index, 0);
-  RTC_DCHECK_LT(packet_index, packet_history_.size());
-  RTC_DCHECK(packet_history_[packet_index].packet_ == nullptr);
+  RTC_DCHECK_LT(packet_index, num_slots_);
+  RTC_DCHECK(Slot(packet_index).packet_ == nullptr);
 
-  packet_history_[packet_index] =
-      StoredPacket(std::move(packet), send_time, packets_inserted_++);
+  const uint64_t insert_order = packets_inserted_++;
+  Slot(packet_index) = StoredPacket(std::move(packet), send_time, insert_order);
 
   if (enable_padding_prio_) {
     if (padding_priority_.size() >= kMaxPaddingHistory - 1) {
-      padding_priority_.erase(std::prev(padding_priority_.end()));
+      padding_priority_.pop_back();
     }
-    auto prio_it = padding_priority_.insert(&packet_history_[packet_index]);
-    RTC_DCHECK(prio_it.second) << "Failed to insert packet into prio set.";
+    InsertPaddingCandidate(PaddingCandidate{rtp_seq_no,
+                                            /*times_retransmitted=*/0,
+                                            insert_order});
   }
 }
 
@@ -211,8 +207,7 @@ void RtpPacketHistory::MarkPacketAsSent(uint16_t sequence_number) {
   // transmission count.
   packet->set_send_time(clock_->CurrentTime());
   packet->pending_transmission_ = false;
-  packet->IncrementTimesRetransmitted(enable_padding_prio_ ? &padding_priority_
-                                                           : nullptr);
+  IncrementTimesRetransmitted(*packet);
 }
 
 bool RtpPacketHistory::GetPacketState(uint16_t sequence_number) const {
@@ -222,11 +217,10 @@ bool RtpPacketHistory::GetPacketState(uint16_t sequence_number) const {
   }
 
   int packet_index = GetPacketIndex(sequence_number);
-  if (packet_index < 0 ||
-      static_cast<size_t>(packet_index) >= packet_history_.size()) {
+  if (packet_index < 0 || static_cast<size_t>(packet_index) >= num_slots_) {
     return false;
   }
-  const StoredPacket& packet = packet_history_[packet_index];
+  const StoredPacket& packet = Slot(packet_index);
   if (packet.packet_ == nullptr) {
     return false;
   }
@@ -268,17 +262,13 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPayloadPaddingPacket(
 
   StoredPacket* best_packet = nullptr;
   if (enable_padding_prio_ && !padding_priority_.empty()) {
-    auto best_packet_it = padding_priority_.begin();
-    best_packet = *best_packet_it;
-  } else if (!enable_padding_prio_ && !packet_history_.empty()) {
-    // Prioritization not available, pick the last packet.
-    for (auto it = packet_history_.rbegin(); it != packet_history_.rend();
-         ++it) {
-      if (it->packet_ != nullptr) {
-        best_packet = &(*it);
-        break;
-      }
-    }
+    best_packet = GetStoredPacket(padding_priority_.front().sequence_number);
+    RTC_DCHECK(best_packet);
+  } else if (!enable_padding_prio_ && num_slots_ > 0) {
+    // Prioritization not available, pick the last packet. The last slot in use
+    // is always populated.
+    best_packet = &Slot(num_slots_ - 1);
+    RTC_DCHECK(best_packet->packet_ != nullptr);
   }
   if (best_packet == nullptr) {
     return nullptr;
@@ -299,8 +289,7 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPayloadPaddingPacket(
   }
 
   best_packet->set_send_time(clock_->CurrentTime());
-  best_packet->IncrementTimesRetransmitted(
-      enable_padding_prio_ ? &padding_priority_ : nullptr);
+  IncrementTimesRetransmitted(*best_packet);
 
   return padding_packet;
 }
@@ -310,8 +299,8 @@ void RtpPacketHistory::CullAcknowledgedPackets(
   MutexLock lock(&lock_);
   for (uint16_t sequence_number : sequence_numbers) {
     int packet_index = GetPacketIndex(sequence_number);
-    if (packet_index < 0 ||
-        static_cast<size_t>(packet_index) >= packet_history_.size()) {
+    if (packet_index < 0 || static_cast<size_t>(packet_index) >= num_slots_ ||
+        Slot(packet_index).packet_ == nullptr) {
       continue;
     }
     RemovePacket(packet_index);
@@ -324,7 +313,11 @@ void RtpPacketHistory::Clear() {
 }
 
 void RtpPacketHistory::Reset() {
-  packet_history_.clear();
+  for (size_t i = 0; i < num_slots_; ++i) {
+    Slot(i).packet_ = nullptr;
+  }
+  ring_start_ = 0;
+  num_slots_ = 0;
   padding_priority_.clear();
 }
 
@@ -334,15 +327,15 @@ void RtpPacketHistory::CullOldPackets() {
       rtt_.IsFinite()
           ? std::max(kMinPacketDurationRtt * rtt_, kMinPacketDuration)
           : kMinPacketDuration;
-  while (!packet_history_.empty()) {
-    if (packet_history_.size() >= kMaxCapacity) {
+  while (num_slots_ > 0) {
+    if (num_slots_ >= kMaxCapacity) {
       // We have reached the absolute max capacity, remove one packet
       // unconditionally.
       RemovePacket(0);
       continue;
     }
 
-    const StoredPacket& stored_packet = packet_history_.front();
+    const StoredPacket& stored_packet = Slot(0);
     if (stored_packet.pending_transmission_) {
       // Don't remove packets in the pacer queue, pending tranmission.
       return;
@@ -353,7 +346,7 @@ void RtpPacketHistory::CullOldPackets() {
       return;
     }
 
-    if (packet_history_.size() >= number_to_store_ ||
+    if (num_slots_ >= number_to_store_ ||
         stored_packet.send_time() +
                 (packet_duration * kPacketCullingDelayFactor) <=
             now) {
@@ -369,19 +362,24 @@ void RtpPacketHistory::CullOldPackets() {
 
 std::unique_ptr<RtpPacketToSend> RtpPacketHistory::RemovePacket(
     int packet_index) {
+  StoredPacket& stored_packet = Slot(packet_index);
   // Move the packet out from the StoredPacket container.
   std::unique_ptr<RtpPacketToSend> rtp_packet =
-      std::move(packet_history_[packet_index].packet_);
+      std::move(stored_packet.packet_);
 
-  // Erase from padding priority set, if eligible.
+  // Erase from padding priority list, if eligible.
   if (enable_padding_prio_) {
-    padding_priority_.erase(&packet_history_[packet_index]);
+    RemovePaddingCandidate(rtp_packet->SequenceNumber());
   }
 
   if (packet_index == 0) {
-    while (!packet_history_.empty() &&
-           packet_history_.front().packet_ == nullptr) {
-      packet_history_.pop_front();
+    while (num_slots_ > 0 && Slot(0).packet_ == nullptr) {
+      ring_start_ = (ring_start_ + 1) & (ring_.size() - 1);
+      --num_slots_;
+    }
+  } else if (static_cast<size_t>(packet_index) == num_slots_ - 1) {
+    while (num_slots_ > 0 && Slot(num_slots_ - 1).packet_ == nullptr) {
+      --num_slots_;
     }
   }
 
@@ -389,12 +387,12 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::RemovePacket(
 }
 
 int RtpPacketHistory::GetPacketIndex(uint16_t sequence_number) const {
-  if (packet_history_.empty()) {
+  if (num_slots_ == 0) {
     return 0;
   }
 
-  RTC_DCHECK(packet_history_.front().packet_ != nullptr);
-  int first_seq = packet_history_.front().packet_->SequenceNumber();
+  RTC_DCHECK(Slot(0).packet_ != nullptr);
+  int first_seq = Slot(0).packet_->SequenceNumber();
   if (first_seq == sequence_number) {
     return 0;
   }
@@ -418,11 +416,68 @@ int RtpPacketHistory::GetPacketIndex(uint16_t sequence_number) const {
 RtpPacketHistory::StoredPacket* RtpPacketHistory::GetStoredPacket(
     uint16_t sequence_number) {
   int index = GetPacketIndex(sequence_number);
-  if (index < 0 || static_cast<size_t>(index) >= packet_history_.size() ||
-      packet_history_[index].packet_ == nullptr) {
+  if (index < 0 || static_cast<size_t>(index) >= num_slots_ ||
+      Slot(index).packet_ == nullptr) {
     return nullptr;
   }
-  return &packet_history_[index];
+  return &Slot(index);
+}
+
+void RtpPacketHistory::IncrementTimesRetransmitted(StoredPacket& packet) {
+  packet.IncrementTimesRetransmitted();
+  if (!enable_padding_prio_) {
+    return;
+  }
+  // `times_retransmitted` is used in sorting, so the entry has to be moved if
+  // the packet is in the list.
+  const uint16_t sequence_number = packet.packet_->SequenceNumber();
+  auto it = absl::c_find_if(padding_priority_,
+                            [&](const PaddingCandidate& candidate) {
+                              return candidate.sequence_number ==
+                                     sequence_number;
+                            });
+  if (it == padding_priority_.end()) {
+    return;
+  }
+  padding_priority_.erase(it);
+  InsertPaddingCandidate(PaddingCandidate{sequence_number,
+                                          packet.times_retransmitted(),
+                                          packet.insert_order()});
+}
+
+void RtpPacketHistory::RemovePaddingCandidate(uint16_t sequence_number) {
+  auto it = absl::c_find_if(padding_priority_,
+                            [&](const PaddingCandidate& candidate) {
+                              return candidate.sequence_number ==
+                                     sequence_number;
+                            });
+  if (it != padding_priority_.end()) {
+    padding_priority_.erase(it);
+  }
+}
+
+void RtpPacketHistory::InsertPaddingCandidate(
+    const PaddingCandidate& candidate) {
+  RTC_DCHECK_LT(padding_priority_.size(), kMaxPaddingHistory);
+  padding_priority_.insert(
+      absl::c_upper_bound(padding_priority_, candidate, MoreUseful()),
+      candidate);
+}
+
+void RtpPacketHistory::EnsureRingCapacity(size_t num_slots) {
+  if (num_slots <= ring_.size()) {
+    return;
+  }
+  size_t new_size = std::max<size_t>(ring_.size(), 16);
+  while (new_size < num_slots) {
+    new_size *= 2;
+  }
+  std::vector<StoredPacket> new_ring(new_size);
+  for (size_t i = 0; i < num_slots_; ++i) {
+    new_ring[i] = std::move(Slot(i));
+  }
+  ring_ = std::move(new_ring);
+  ring_start_ = 0;
 }
 
 }  // namespace webrtc
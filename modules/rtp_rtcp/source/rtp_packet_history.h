@@ -11,10 +11,7 @@
 #ifndef MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 #define MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
 
-#include <deque>
-#include <map>
 #include <memory>
-#include <set>
 #include <utility>
 #include <vector>
 
@@ -115,10 +112,6 @@ class RtpPacketHistory {
   void Clear();
 
  private:
-  struct MoreUseful;
-  class StoredPacket;
-  using PacketPrioritySet = std::set<StoredPacket*, MoreUseful>;
-
   class StoredPacket {
    public:
     StoredPacket() = default;
@@ -131,7 +124,7 @@ class RtpPacketHistory {
 
     uint64_t insert_order() const { return insert_order_; }
     size_t times_retransmitted() const { return times_retransmitted_; }
-    void IncrementTimesRetransmitted(PacketPrioritySet* priority_set);
+    void IncrementTimesRetransmitted() { ++times_retransmitted_; }
 
     // The time of last transmission, including retransmissions.
     Timestamp send_time() const { return send_time_; }
@@ -153,8 +146,17 @@ class RtpPacketHistory {
     // Number of times RE-transmitted, ie excluding the first transmission.
     size_t times_retransmitted_;
   };
+
+  // Entry in the padding priority list. Holds copies of the fields used for
+  // sorting, so that entries stay valid when the ring is reallocated.
+  struct PaddingCandidate {
+    uint16_t sequence_number;
+    size_t times_retransmitted;
+    uint64_t insert_order;
+  };
   struct MoreUseful {
-    bool operator()(StoredPacket* lhs, StoredPacket* rhs) const;
+    bool operator()(const PaddingCandidate& lhs,
+                    const PaddingCandidate& rhs) const;
   };
 
   // Helper method to check if packet has too recently been sent.
@@ -170,6 +172,26 @@ class RtpPacketHistory {
       RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
   StoredPacket* GetStoredPacket(uint16_t sequence_number)
       RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  // Increments the retransmission count of `packet` and moves it accordingly
+  // in `padding_priority_`.
+  void IncrementTimesRetransmitted(StoredPacket& packet)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  void RemovePaddingCandidate(uint16_t sequence_number)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+  void InsertPaddingCandidate(const PaddingCandidate& candidate)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
+  // Accessors for the ring of stored packets. `index` is relative to the
+  // oldest slot, like an index into a deque.
+  StoredPacket& Slot(size_t index) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+    return ring_[(ring_start_ + index) & (ring_.size() - 1)];
+  }
+  const StoredPacket& Slot(size_t index) const
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+    return ring_[(ring_start_ + index) & (ring_.size() - 1)];
+  }
+  // Makes room for at least `num_slots` slots, keeping their order.
+  void EnsureRingCapacity(size_t num_slots) RTC_EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
   Clock* const clock_;
   const bool enable_padding_prio_;
@@ -178,19 +200,27 @@ class RtpPacketHistory {
   StorageMode mode_ RTC_GUARDED_BY(lock_);
   TimeDelta rtt_ RTC_GUARDED_BY(lock_);
 
-  // Queue of stored packets, ordered by sequence number, with older packets in
+  // Ring of stored packets, ordered by sequence number, with older packets in
   // the front and new packets being added to the back. Note that there may be
   // wrap-arounds so the back may have a lower sequence number.
   // Packets may also be removed out-of-order, in which case there will be
   // instances of StoredPacket with `packet_` set to nullptr. The first and last
-  // entry in the queue will however always be populated.
-  std::deque<StoredPacket> packet_history_ RTC_GUARDED_BY(lock_);
+  // slot in use will however always be populated.
+  // The size of `ring_` is a power of two; it is preallocated to hold
+  // `number_to_store_` packets and only grows if the history spans more
+  // sequence numbers than that.
+  std::vector<StoredPacket> ring_ RTC_GUARDED_BY(lock_);
+  // Position in `ring_` of the oldest slot in use.
+  size_t ring_start_ RTC_GUARDED_BY(lock_);
+  // Number of slots in use, including empty slots between stored packets.
+  size_t num_slots_ RTC_GUARDED_BY(lock_);
 
   // Total number of packets with inserted.
   uint64_t packets_inserted_ RTC_GUARDED_BY(lock_);
-  // Objects from `packet_history_` ordered by "most likely to be useful", used
-  // in GetPayloadPaddingPacket().
-  PacketPrioritySet padding_priority_ RTC_GUARDED_BY(lock_);
+  // Up to kMaxPaddingHistory packets, ordered by "most likely to be useful",
+  // used in GetPayloadPaddingPacket(). Small enough that sorted insertion into
+  // a preallocated array beats a node based set.
+  std::vector<PaddingCandidate> padding_priority_ RTC_GUARDED_BY(lock_);
 };
 }  // namespace webrtc
 #endif  // MODULES_RTP_RTCP_SOURCE_RTP_PACKET_HISTORY_H_
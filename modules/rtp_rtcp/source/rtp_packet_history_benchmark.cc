@@ -0,0 +1,142 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "api/units/time_delta.h"
+#include "benchmark/benchmark.h"
+#include "modules/rtp_rtcp/source/rtp_packet_history.h"
+#include "modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "rtc_base/checks.h"
+#include "system_wrappers/include/clock.h"
+
+namespace webrtc {
+namespace {
+
+// Roughly one second of an 8 Mbps stream of 1000 byte packets.
+constexpr size_t kHistorySize = 1000;
+constexpr size_t kPayloadSize = 1000;
+// Every fifth packet is lost and NACKed.
+constexpr size_t kLossInterval = 5;
+// Start close to the wrap-around so that it is exercised.
+constexpr uint16_t kStartSeqNum = 65000;
+
+std::unique_ptr<RtpPacketToSend> CreatePacket(uint16_t seq_num,
+                                              Timestamp capture_time) {
+  auto packet = std::make_unique<RtpPacketToSend>(nullptr);
+  packet->SetSequenceNumber(seq_num);
+  packet->set_capture_time(capture_time);
+  packet->set_allow_retransmission(true);
+  packet->AllocatePayload(kPayloadSize);
+  return packet;
+}
+
+// Fills a history with `kHistorySize` packets sent 1 ms apart, and advances
+// the clock far enough that all of them may be retransmitted.
+void FillHistory(SimulatedClock& clock, RtpPacketHistory& history) {
+  history.SetStorePacketsStatus(RtpPacketHistory::StorageMode::kStoreAndCull,
+                                kHistorySize);
+  history.SetRtt(TimeDelta::Millis(1));
+  for (size_t i = 0; i < kHistorySize; ++i) {
+    history.PutRtpPacket(
+        CreatePacket(static_cast<uint16_t>(kStartSeqNum + i),
+                     clock.CurrentTime()),
+        clock.CurrentTime());
+    clock.AdvanceTimeMilliseconds(1);
+  }
+}
+
+// Retransmits every `kLossInterval`th packet of the history, the way the NACK
+// path of RTPSender does, and marks it as sent again.
+void BM_GetPacketAndMarkAsPending(benchmark::State& state) {
+  SimulatedClock clock(123456);
+  RtpPacketHistory history(&clock, /*enable_padding_prio=*/true);
+  FillHistory(clock, history);
+
+  for (auto _ : state) {
+    // Retransmissions are throttled to one per RTT.
+    clock.AdvanceTimeMilliseconds(2);
+    for (size_t i = 0; i < kHistorySize; i += kLossInterval) {
+      const uint16_t seq_num = static_cast<uint16_t>(kStartSeqNum + i);
+      std::unique_ptr<RtpPacketToSend> packet =
+          history.GetPacketAndMarkAsPending(seq_num);
+      RTC_CHECK(packet);
+      benchmark::DoNotOptimize(packet);
+      history.MarkPacketAsSent(seq_num);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kHistorySize / kLossInterval);
+}
+
+// Looks up the best padding candidate of a history where every
+// `kLossInterval`th packet has been retransmitted, so that the candidates
+// differ in priority.
+void BM_GetPayloadPaddingPacket(benchmark::State& state) {
+  const bool enable_padding_prio = state.range(0) != 0;
+  SimulatedClock clock(123456);
+  RtpPacketHistory history(&clock, enable_padding_prio);
+  FillHistory(clock, history);
+  for (size_t i = 0; i < kHistorySize; i += kLossInterval) {
+    const uint16_t seq_num = static_cast<uint16_t>(kStartSeqNum + i);
+    RTC_CHECK(history.GetPacketAndMarkAsPending(seq_num));
+    history.MarkPacketAsSent(seq_num);
+  }
+
+  for (auto _ : state) {
+    std::unique_ptr<RtpPacketToSend> packet = history.GetPayloadPaddingPacket();
+    RTC_CHECK(packet);
+    benchmark::DoNotOptimize(packet);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Sends packets into a full history, culling the oldest packet and
+// acknowledging every packet that was not lost.
+void BM_PutAndCullPackets(benchmark::State& state) {
+  SimulatedClock clock(123456);
+  RtpPacketHistory history(&clock, /*enable_padding_prio=*/true);
+  FillHistory(clock, history);
+
+  std::vector<std::unique_ptr<RtpPacketToSend>> packets;
+  std::vector<uint16_t> acked_seq_nums;
+  uint16_t seq_num = static_cast<uint16_t>(kStartSeqNum + kHistorySize);
+  for (auto _ : state) {
+    state.PauseTiming();
+    for (size_t i = 0; i < kHistorySize; ++i) {
+      packets.push_back(
+          CreatePacket(static_cast<uint16_t>(seq_num + i), clock.CurrentTime()));
+    }
+    state.ResumeTiming();
+
+    acked_seq_nums.clear();
+    for (size_t i = 0; i < kHistorySize; ++i) {
+      history.PutRtpPacket(std::move(packets[i]), clock.CurrentTime());
+      if (i % kLossInterval != 0) {
+        acked_seq_nums.push_back(static_cast<uint16_t>(seq_num + i));
+      }
+    }
+    history.CullAcknowledgedPackets(acked_seq_nums);
+    packets.clear();
+    seq_num += kHistorySize;
+    clock.AdvanceTimeMilliseconds(1);
+  }
+  state.SetItemsProcessed(state.iterations() * kHistorySize);
+}
+
+BENCHMARK(BM_GetPacketAndMarkAsPending);
+BENCHMARK(BM_GetPayloadPaddingPacket)->Arg(0)->Arg(1);
+BENCHMARK(BM_PutAndCullPackets);
+
+}  // namespace
+}  // namespace webrtc
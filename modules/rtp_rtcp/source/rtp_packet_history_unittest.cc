@@ -675,6 +675,45 @@ TEST_P(RtpPacketHistoryTest, UsesLastPacketAsPaddingWithPrioOff) {
   EXPECT_EQ(hist_.GetPayloadPaddingPacket(), nullptr);
 }
 
+TEST_P(RtpPacketHistoryTest, KeepsPacketsWhileGrowingAndCulling) {
+  // Store more packets than the initial capacity of the history, with a gap of
+  // lost (never stored) packets and a sequence number wrap-around.
+  const size_t kMaxNumPackets = 100;
+  hist_.SetStorePacketsStatus(StorageMode::kStoreAndCull, kMaxNumPackets);
+  for (size_t i = 0; i < kMaxNumPackets; ++i) {
+    if (i >= 40 && i < 50) {
+      continue;
+    }
+    hist_.PutRtpPacket(CreateRtpPacket(To16u(kStartSeqNum + i)),
+                       /*send_time=*/fake_clock_.CurrentTime());
+  }
+  for (size_t i = 0; i < kMaxNumPackets; ++i) {
+    EXPECT_EQ(hist_.GetPacketState(To16u(kStartSeqNum + i)),
+              i < 40 || i >= 50);
+  }
+
+  // Acknowledge all but the last packet. The remaining packet is used for
+  // padding and is still found after the history shrinks.
+  std::vector<uint16_t> acked_sequence_numbers;
+  for (size_t i = 0; i < kMaxNumPackets - 1; ++i) {
+    acked_sequence_numbers.push_back(To16u(kStartSeqNum + i));
+  }
+  hist_.CullAcknowledgedPackets(acked_sequence_numbers);
+  const uint16_t kLastSeqNum = To16u(kStartSeqNum + kMaxNumPackets - 1);
+  EXPECT_FALSE(hist_.GetPacketState(kStartSeqNum));
+  EXPECT_TRUE(hist_.GetPacketState(kLastSeqNum));
+  std::unique_ptr<RtpPacketToSend> padding_packet =
+      hist_.GetPayloadPaddingPacket();
+  ASSERT_TRUE(padding_packet);
+  EXPECT_EQ(padding_packet->SequenceNumber(), kLastSeqNum);
+
+  // New packets are appended after the remaining one.
+  hist_.PutRtpPacket(CreateRtpPacket(To16u(kLastSeqNum + 1)),
+                     /*send_time=*/fake_clock_.CurrentTime());
+  EXPECT_TRUE(hist_.GetPacketState(kLastSeqNum));
+  EXPECT_TRUE(hist_.GetPacketState(To16u(kLastSeqNum + 1)));
+}
+
 INSTANTIATE_TEST_SUITE_P(WithAndWithoutPaddingPrio,
                          RtpPacketHistoryTest,
                          ::testing::Bool());
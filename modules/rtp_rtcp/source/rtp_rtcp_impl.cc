@@ -389,6 +389,10 @@ bool ModuleRtpRtcpImpl::TrySendPacket(RtpPacketToSend* packet,
   return true;
 }
 
+void ModuleRtpRtcpImpl::OnBatchComplete() {
+  // The deprecated egress sends every packet immediately.
+}
+
 void ModuleRtpRtcpImpl::SetFecProtectionParams(const FecProtectionParams&,
                                                const FecProtectionParams&) {
   // Deferred FEC not supported in deprecated RTP module.
@@ -353,6 +353,11 @@ bool ModuleRtpRtcpImpl2::TrySendPacket(RtpPacketToSend* packet,
   return true;
 }
 
+void ModuleRtpRtcpImpl2::OnBatchComplete() {
+  RTC_DCHECK(rtp_sender_);
+  rtp_sender_->packet_sender.OnBatchComplete();
+}
+
 void ModuleRtpRtcpImpl2::SetFecProtectionParams(
     const FecProtectionParams& delta_params,
     const FecProtectionParams& key_params) {
@@ -411,6 +416,7 @@ size_t ModuleRtpRtcpImpl2::ExpectedPerPacketOverhead() const {
 void ModuleRtpRtcpImpl2::OnPacketSendingThreadSwitched() {
   // Ownership of sequencing is being transferred to another thread.
   rtp_sender_->sequencing_checker.Detach();
+  rtp_sender_->packet_sender.OnPacketSendingThreadSwitched();
 }
 
 size_t ModuleRtpRtcpImpl2::MaxRtpPacketSize() const {
@@ -149,6 +149,8 @@ class ModuleRtpRtcpImpl2 final : public RtpRtcpInterface,
   bool TrySendPacket(RtpPacketToSend* packet,
                      const PacedPacketInfo& pacing_info) override;
 
+  void OnBatchComplete() override;
+
   void SetFecProtectionParams(const FecProtectionParams& delta_params,
                               const FecProtectionParams& key_params) override;
 
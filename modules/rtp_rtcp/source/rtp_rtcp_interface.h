@@ -140,6 +140,12 @@ class RtpRtcpInterface : public RtcpFeedbackSenderInterface {
     // overhead.
     bool enable_rtx_padding_prioritization = true;
 
+    // If true, packets sent by the pacer are held back until the pacer calls
+    // OnBatchComplete() and then handed to the transport marked as batchable,
+    // with the last one marked as the end of the batch. This lets the network
+    // layer send the whole burst with fewer system calls.
+    bool enable_send_packet_batching = false;
+
     // Estimate RTT as non-sender as described in
     // https://tools.ietf.org/html/rfc3611#section-4.4 and #section-4.5
     bool non_sender_rtt_measurement = false;
@@ -316,10 +322,15 @@ class RtpRtcpInterface : public RtcpFeedbackSenderInterface {
 
   // Try to send the provided packet. Returns true iff packet matches any of
   // the SSRCs for this module (media/rtx/fec etc) and was forwarded to the
-  // transport.
+  // transport. With `enable_send_packet_batching`, the contents of `packet`
+  // may be moved out.
   virtual bool TrySendPacket(RtpPacketToSend* packet,
                              const PacedPacketInfo& pacing_info) = 0;
 
+  // Called by the pacer when it has finished sending a burst of packets. Any
+  // packets held back for batching are sent to the transport.
+  virtual void OnBatchComplete() = 0;
+
   // Update the FEC protection parameters to use for delta- and key-frames.
   // Only used when deferred FEC is active.
   virtual void SetFecProtectionParams(
@@ -52,6 +52,7 @@ void RtpSenderEgress::NonPacedPacketSender::EnqueuePackets(
     PrepareForSend(packet.get());
     sender_->SendPacket(packet.get(), PacedPacketInfo());
   }
+  sender_->OnBatchComplete();
   auto fec_packets = sender_->FetchFecPackets();
   if (!fec_packets.empty()) {
     EnqueuePackets(std::move(fec_packets));
@@ -93,6 +94,8 @@ RtpSenderEgress::RtpSenderEgress(const RtpRtcpInterface::Configuration& config,
       is_audio_(config.audio),
 #endif
       need_rtp_packet_infos_(config.need_rtp_packet_infos),
+      enable_send_packet_batching_(config.enable_send_packet_batching &&
+                                   !config.audio),
       fec_generator_(config.fec_generator),
       transport_feedback_observer_(config.transport_feedback_callback),
       send_side_delay_observer_(config.send_side_delay_observer),
@@ -268,15 +271,46 @@ void RtpSenderEgress::SendPacket(RtpPacketToSend* packet,
                        packet_ssrc);
   }
 
-  const bool send_success = SendPacketToNetwork(*packet, options, pacing_info);
+  if (enable_send_packet_batching_) {
+    options.batchable = true;
+    packets_to_send_.push_back(
+        {std::make_unique<RtpPacketToSend>(std::move(*packet)), options,
+         pacing_info, now});
+    return;
+  }
+  CompleteSendPacket(*packet, options, pacing_info, now);
+}
+
+void RtpSenderEgress::OnBatchComplete() {
+  RTC_DCHECK_RUN_ON(&pacer_checker_);
+  for (size_t i = 0; i < packets_to_send_.size(); ++i) {
+    PendingPacket& pending = packets_to_send_[i];
+    pending.options.last_packet_in_batch = i + 1 == packets_to_send_.size();
+    CompleteSendPacket(*pending.packet, pending.options, pending.pacing_info,
+                       pending.now);
+  }
+  packets_to_send_.clear();
+}
+
+void RtpSenderEgress::OnPacketSendingThreadSwitched() {
+  pacer_checker_.Detach();
+}
+
+void RtpSenderEgress::CompleteSendPacket(const RtpPacketToSend& packet,
+                                         const PacketOptions& options,
+                                         const PacedPacketInfo& pacing_info,
+                                         Timestamp now) {
+  const bool is_media = packet.packet_type() == RtpPacketMediaType::kAudio ||
+                        packet.packet_type() == RtpPacketMediaType::kVideo;
+  const bool send_success = SendPacketToNetwork(packet, options, pacing_info);
 
   // Put packet in retransmission history or update pending status even if
   // actual sending fails.
-  if (is_media && packet->allow_retransmission()) {
-    packet_history_->PutRtpPacket(std::make_unique<RtpPacketToSend>(*packet),
+  if (is_media && packet.allow_retransmission()) {
+    packet_history_->PutRtpPacket(std::make_unique<RtpPacketToSend>(packet),
                                   now);
-  } else if (packet->retransmitted_sequence_number()) {
-    packet_history_->MarkPacketAsSent(*packet->retransmitted_sequence_number());
+  } else if (packet.retransmitted_sequence_number()) {
+    packet_history_->MarkPacketAsSent(*packet.retransmitted_sequence_number());
   }
 
   if (send_success) {
@@ -288,10 +322,11 @@ void RtpSenderEgress::SendPacket(RtpPacketToSend* packet,
     // TODO(sprang): Add support for FEC protecting all header extensions, add
     // media packet to generator here instead.
 
-    RTC_DCHECK(packet->packet_type().has_value());
-    RtpPacketMediaType packet_type = *packet->packet_type();
-    RtpPacketCounter counter(*packet);
-    size_t size = packet->size();
+    RTC_DCHECK(packet.packet_type().has_value());
+    RtpPacketMediaType packet_type = *packet.packet_type();
+    const uint32_t packet_ssrc = packet.Ssrc();
+    RtpPacketCounter counter(packet);
+    size_t size = packet.size();
     worker_queue_->PostTask(
         SafeTask(task_safety_.flag(), [this, now, packet_ssrc, packet_type,
                                        counter = std::move(counter), size]() {
@@ -23,6 +23,7 @@
 #include "api/task_queue/pending_task_safety_flag.h"
 #include "api/task_queue/task_queue_base.h"
 #include "api/units/data_rate.h"
+#include "api/units/timestamp.h"
 #include "modules/remote_bitrate_estimator/test/bwe_test_logging.h"
 #include "modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "modules/rtp_rtcp/source/packet_sequencer.h"
@@ -61,8 +62,15 @@ class RtpSenderEgress {
                   RtpPacketHistory* packet_history);
   ~RtpSenderEgress();
 
+  // If `Configuration::enable_send_packet_batching` is set, the contents of
+  // `packet` are moved out and held back until OnBatchComplete().
   void SendPacket(RtpPacketToSend* packet, const PacedPacketInfo& pacing_info)
       RTC_LOCKS_EXCLUDED(lock_);
+  // Sends the packets held back since the last call, if
+  // `Configuration::enable_send_packet_batching` is set.
+  void OnBatchComplete();
+  // Called when packets will be sent from another thread.
+  void OnPacketSendingThreadSwitched();
   uint32_t Ssrc() const { return ssrc_; }
   absl::optional<uint32_t> RtxSsrc() const { return rtx_ssrc_; }
   absl::optional<uint32_t> FlexFecSsrc() const { return flexfec_ssrc_; }
@@ -110,6 +118,19 @@ class RtpSenderEgress {
   void UpdateOnSendPacket(int packet_id,
                           int64_t capture_time_ms,
                           uint32_t ssrc);
+  // A packet held back until OnBatchComplete().
+  struct PendingPacket {
+    std::unique_ptr<RtpPacketToSend> packet;
+    PacketOptions options;
+    PacedPacketInfo pacing_info;
+    Timestamp now;
+  };
+
+  // Sends the packet to the network and updates history and statistics.
+  void CompleteSendPacket(const RtpPacketToSend& packet,
+                          const PacketOptions& options,
+                          const PacedPacketInfo& pacing_info,
+                          Timestamp now);
   // Sends packet on to `transport_`, leaving the RTP module.
   bool SendPacketToNetwork(const RtpPacketToSend& packet,
                            const PacketOptions& options,
@@ -142,9 +163,11 @@ class RtpSenderEgress {
   const bool is_audio_;
 #endif
   const bool need_rtp_packet_infos_;
+  const bool enable_send_packet_batching_;
   VideoFecGenerator* const fec_generator_ RTC_GUARDED_BY(pacer_checker_);
   absl::optional<uint16_t> last_sent_seq_ RTC_GUARDED_BY(pacer_checker_);
   absl::optional<uint16_t> last_sent_rtx_seq_ RTC_GUARDED_BY(pacer_checker_);
+  std::vector<PendingPacket> packets_to_send_ RTC_GUARDED_BY(pacer_checker_);
 
   TransportFeedbackObserver* const transport_feedback_observer_;
   SendSideDelayObserver* const send_side_delay_observer_;
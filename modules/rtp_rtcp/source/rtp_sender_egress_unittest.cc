@@ -124,6 +124,7 @@ class TestTransport : public Transport {
                size_t length,
                const PacketOptions& options) override {
     total_data_sent_ += DataSize::Bytes(length);
+    ++num_packets_sent_;
     last_packet_.emplace(rtc::MakeArrayView(packet, length), options,
                          extensions_);
     return true;
@@ -132,9 +133,11 @@ class TestTransport : public Transport {
   bool SendRtcp(const uint8_t*, size_t) override { RTC_CHECK_NOTREACHED(); }
 
   absl::optional<TransmittedPacket> last_packet() { return last_packet_; }
+  int num_packets_sent() const { return num_packets_sent_; }
 
  private:
   DataSize total_data_sent_;
+  int num_packets_sent_ = 0;
   absl::optional<TransmittedPacket> last_packet_;
   RtpHeaderExtensionMap* const extensions_;
 };
@@ -788,6 +791,41 @@ TEST_P(RtpSenderEgressTest, SendPacketSetsPacketOptions) {
   EXPECT_TRUE(transport_.last_packet()->options.is_retransmit);
 }
 
+TEST_P(RtpSenderEgressTest, HoldsBackPacketsUntilBatchCompleteWhenBatching) {
+  RtpRtcpInterface::Configuration config = DefaultConfig();
+  config.enable_send_packet_batching = true;
+  auto sender = std::make_unique<RtpSenderEgress>(config, &packet_history_);
+  packet_history_.SetStorePacketsStatus(
+      RtpPacketHistory::StorageMode::kStoreAndCull, 10);
+
+  std::unique_ptr<RtpPacketToSend> first = BuildRtpPacket();
+  std::unique_ptr<RtpPacketToSend> second = BuildRtpPacket();
+  first->set_allow_retransmission(true);
+  const uint16_t first_sequence_number = first->SequenceNumber();
+  const uint16_t second_sequence_number = second->SequenceNumber();
+  sender->SendPacket(first.get(), PacedPacketInfo());
+  sender->SendPacket(second.get(), PacedPacketInfo());
+  EXPECT_EQ(transport_.num_packets_sent(), 0);
+  EXPECT_FALSE(packet_history_.GetPacketState(first_sequence_number));
+
+  sender->OnBatchComplete();
+  EXPECT_EQ(transport_.num_packets_sent(), 2);
+  EXPECT_EQ(transport_.last_packet()->packet.SequenceNumber(),
+            second_sequence_number);
+  EXPECT_TRUE(transport_.last_packet()->options.batchable);
+  EXPECT_TRUE(transport_.last_packet()->options.last_packet_in_batch);
+  EXPECT_TRUE(packet_history_.GetPacketState(first_sequence_number));
+}
+
+TEST_P(RtpSenderEgressTest, SendsPacketsImmediatelyWithoutBatching) {
+  std::unique_ptr<RtpSenderEgress> sender = CreateRtpSenderEgress();
+  std::unique_ptr<RtpPacketToSend> packet = BuildRtpPacket();
+  sender->SendPacket(packet.get(), PacedPacketInfo());
+  EXPECT_EQ(transport_.num_packets_sent(), 1);
+  EXPECT_FALSE(transport_.last_packet()->options.batchable);
+  EXPECT_FALSE(transport_.last_packet()->options.last_packet_in_batch);
+}
+
 TEST_P(RtpSenderEgressTest, SendPacketUpdatesStats) {
   const size_t kPayloadSize = 1000;
   StrictMock<MockSendSideDelayObserver> send_side_delay_observer;
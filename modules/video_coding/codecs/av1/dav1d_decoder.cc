@@ -84,8 +84,16 @@ bool Dav1dDecoder::Configure(const Settings& settings) {
   Dav1dSettings s;
   dav1d_default_settings(&s);
 
-  s.n_threads = std::max(2, settings.number_of_cores());
-  s.max_frame_delay = 1;   // For low latency decoding.
+  if (settings.tile_threads()) {
+    s.n_threads = std::min(settings.number_of_cores(),
+                           *settings.tile_threads() * settings.frame_threads());
+  } else {
+    s.n_threads = std::max(2, settings.number_of_cores());
+  }
+  // Low latency decoding. With a frame delay, dav1d would return pictures
+  // from later calls to Decode(), and read `encoded_image` after Decode()
+  // returns. The threads for `frame_threads` are used within each frame.
+  s.max_frame_delay = 1;
   s.all_layers = 0;        // Don't output a frame for every spatial layer.
   s.operating_point = 31;  // Decode all operating points.
 
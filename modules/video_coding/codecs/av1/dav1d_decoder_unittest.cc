@@ -0,0 +1,106 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/codecs/av1/dav1d_decoder.h"
+
+#include <stdint.h>
+
+#include <memory>
+#include <vector>
+
+#include "absl/types/optional.h"
+#include "api/video/video_frame.h"
+#include "api/video_codecs/video_codec.h"
+#include "api/video_codecs/video_decoder.h"
+#include "api/video_codecs/video_encoder.h"
+#include "modules/video_coding/codecs/av1/libaom_av1_encoder.h"
+#include "modules/video_coding/codecs/test/encoded_video_frame_producer.h"
+#include "modules/video_coding/include/video_codec_interface.h"
+#include "modules/video_coding/include/video_error_codes.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAreArray;
+
+constexpr int kWidth = 320;
+constexpr int kHeight = 180;
+
+// Records the RTP timestamps of the decoded frames.
+class DecodedTimestampsCallback : public DecodedImageCallback {
+ public:
+  const std::vector<uint32_t>& timestamps() const { return timestamps_; }
+
+ private:
+  int32_t Decoded(VideoFrame& decoded_image) override {
+    timestamps_.push_back(decoded_image.timestamp());
+    return 0;
+  }
+  void Decoded(VideoFrame& decoded_image,
+               absl::optional<int32_t> /*decode_time_ms*/,
+               absl::optional<uint8_t> /*qp*/) override {
+    timestamps_.push_back(decoded_image.timestamp());
+  }
+
+  std::vector<uint32_t> timestamps_;
+};
+
+std::vector<EncodedVideoFrameProducer::EncodedFrame> EncodeFrames(
+    int num_frames) {
+  std::unique_ptr<VideoEncoder> encoder = CreateLibaomAv1Encoder();
+  VideoCodec codec_settings;
+  codec_settings.SetScalabilityMode(ScalabilityMode::kL1T1);
+  codec_settings.width = kWidth;
+  codec_settings.height = kHeight;
+  codec_settings.maxFramerate = 30;
+  codec_settings.maxBitrate = 1000;
+  codec_settings.qpMax = 63;
+  VideoEncoder::Settings encoder_settings(
+      VideoEncoder::Capabilities(/*loss_notification=*/false),
+      /*number_of_cores=*/1, /*max_payload_size=*/1200);
+  EXPECT_EQ(encoder->InitEncode(&codec_settings, encoder_settings),
+            WEBRTC_VIDEO_CODEC_OK);
+  return EncodedVideoFrameProducer(*encoder)
+      .SetResolution({kWidth, kHeight})
+      .SetNumInputFrames(num_frames)
+      .Encode();
+}
+
+TEST(Dav1dDecoderTest, DecodesEachFrameWhenDecodedWithFrameThreads) {
+  std::vector<EncodedVideoFrameProducer::EncodedFrame> encoded_frames =
+      EncodeFrames(/*num_frames=*/8);
+  ASSERT_EQ(encoded_frames.size(), 8u);
+
+  std::unique_ptr<VideoDecoder> decoder = CreateDav1dDecoder();
+  VideoDecoder::Settings settings;
+  settings.set_number_of_cores(4);
+  settings.set_tile_threads(2);
+  settings.set_frame_threads(2);
+  ASSERT_TRUE(decoder->Configure(settings));
+  DecodedTimestampsCallback callback;
+  ASSERT_EQ(decoder->RegisterDecodeCompleteCallback(&callback),
+            WEBRTC_VIDEO_CODEC_OK);
+
+  // Each frame is output from its own call to Decode(), with its own RTP
+  // timestamp.
+  std::vector<uint32_t> expected_timestamps;
+  for (const EncodedVideoFrameProducer::EncodedFrame& frame : encoded_frames) {
+    EXPECT_EQ(decoder->Decode(frame.encoded_image, /*missing_frames=*/false,
+                              /*render_time_ms=*/0),
+              WEBRTC_VIDEO_CODEC_OK);
+    expected_timestamps.push_back(frame.encoded_image.Timestamp());
+    EXPECT_THAT(callback.timestamps(), ElementsAreArray(expected_timestamps));
+  }
+}
+
+}  // namespace
+}  // namespace webrtc
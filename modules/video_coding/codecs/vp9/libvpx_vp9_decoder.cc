@@ -141,7 +141,10 @@ bool LibvpxVp9Decoder::Configure(const Settings& settings) {
   cfg.threads = 1;
 #else
   const RenderResolution& resolution = settings.max_render_resolution();
-  if (!resolution.Valid()) {
+  if (settings.tile_threads()) {
+    cfg.threads =
+        std::min(settings.number_of_cores(), *settings.tile_threads());
+  } else if (!resolution.Valid()) {
     // Postpone configuring number of threads until resolution is known.
     cfg.threads = 1;
   } else {
@@ -191,6 +194,17 @@ bool LibvpxVp9Decoder::Configure(const Settings& settings) {
     return false;
   }
 
+  if (settings.tile_threads() && cfg.threads > 1) {
+    // Tile threads alone leave cores idle for streams with fewer tile columns
+    // than threads, which is common for real-time encoders. Let the threads
+    // decode rows of the same tile as well.
+    status = vpx_codec_control(decoder_, VP9D_SET_ROW_MT, 1);
+    if (status != VPX_CODEC_OK) {
+      RTC_LOG(LS_WARNING) << "Failed to enable VP9D_SET_ROW_MT. "
+                          << vpx_codec_error(decoder_);
+    }
+  }
+
   return true;
 }
 
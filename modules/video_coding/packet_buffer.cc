@@ -18,6 +18,7 @@
 #include <utility>
 #include <vector>
 
+#include "absl/numeric/bits.h"
 #include "absl/types/variant.h"
 #include "api/array_view.h"
 #include "api/rtp_packet_info.h"
@@ -45,10 +46,13 @@ PacketBuffer::Packet::Packet(const RtpPacketReceived& rtp_packet,
 
 PacketBuffer::PacketBuffer(size_t start_buffer_size, size_t max_buffer_size)
     : max_size_(max_buffer_size),
+      size_(start_buffer_size),
       first_seq_num_(0),
       first_packet_received_(false),
       is_cleared_to_first_seq_num_(false),
-      buffer_(start_buffer_size),
+      buffer_(max_buffer_size),
+      occupied_slots_((max_buffer_size + 63) / 64),
+      first_packet_slots_((max_buffer_size + 63) / 64),
       sps_pps_idr_is_h264_keyframe_(false) {
   RTC_DCHECK_LE(start_buffer_size, max_buffer_size);
   // Buffer size must always be a power of 2.
@@ -65,7 +69,7 @@ PacketBuffer::InsertResult PacketBuffer::InsertPacket(
   PacketBuffer::InsertResult result;
 
   uint16_t seq_num = packet->seq_num;
-  size_t index = seq_num % buffer_.size();
+  size_t index = seq_num % size_;
 
   if (!first_packet_received_) {
     first_seq_num_ = seq_num;
@@ -87,9 +91,9 @@ PacketBuffer::InsertResult PacketBuffer::InsertPacket(
     }
 
     // The packet buffer is full, try to expand the buffer.
-    while (ExpandBufferSize() && buffer_[seq_num % buffer_.size()] != nullptr) {
+    while (ExpandBufferSize() && buffer_[seq_num % size_] != nullptr) {
     }
-    index = seq_num % buffer_.size();
+    index = seq_num % size_;
 
     // Packet buffer is still full since we were unable to expand the buffer.
     if (buffer_[index] != nullptr) {
@@ -103,13 +107,11 @@ PacketBuffer::InsertResult PacketBuffer::InsertPacket(
   }
 
   packet->continuous = false;
-  buffer_[index] = std::move(packet);
+  StorePacket(index, std::move(packet));
 
   UpdateMissingPackets(seq_num);
 
-  received_padding_.erase(
-      received_padding_.begin(),
-      received_padding_.lower_bound(seq_num - (buffer_.size() / 4)));
+  received_padding_.EraseOlderThan(seq_num - (size_ / 4));
 
   result.packets = FindFrames(seq_num);
   return result;
@@ -130,11 +132,12 @@ void PacketBuffer::ClearTo(uint16_t seq_num) {
   // iterations to the `size_` of the buffer.
   ++seq_num;
   size_t diff = ForwardDiff<uint16_t>(first_seq_num_, seq_num);
-  size_t iterations = std::min(diff, buffer_.size());
+  size_t iterations = std::min(diff, size_);
   for (size_t i = 0; i < iterations; ++i) {
-    auto& stored = buffer_[first_seq_num_ % buffer_.size()];
+    const size_t index = first_seq_num_ % size_;
+    const auto& stored = buffer_[index];
     if (stored != nullptr && AheadOf<uint16_t>(seq_num, stored->seq_num)) {
-      stored = nullptr;
+      TakePacket(index);
     }
     ++first_seq_num_;
   }
@@ -144,11 +147,8 @@ void PacketBuffer::ClearTo(uint16_t seq_num) {
   first_seq_num_ = seq_num;
 
   is_cleared_to_first_seq_num_ = true;
-  missing_packets_.erase(missing_packets_.begin(),
-                         missing_packets_.lower_bound(seq_num));
-
-  received_padding_.erase(received_padding_.begin(),
-                          received_padding_.lower_bound(seq_num));
+  missing_packets_.EraseOlderThan(seq_num);
+  received_padding_.EraseOlderThan(seq_num);
 }
 
 void PacketBuffer::Clear() {
@@ -158,7 +158,7 @@ void PacketBuffer::Clear() {
 PacketBuffer::InsertResult PacketBuffer::InsertPadding(uint16_t seq_num) {
   PacketBuffer::InsertResult result;
   UpdateMissingPackets(seq_num);
-  received_padding_.insert(seq_num);
+  received_padding_.Insert(seq_num);
   result.packets = FindFrames(static_cast<uint16_t>(seq_num + 1));
   return result;
 }
@@ -168,39 +168,87 @@ void PacketBuffer::ForceSpsPpsIdrIsH264Keyframe() {
 }
 
 void PacketBuffer::ClearInternal() {
-  for (auto& entry : buffer_) {
-    entry = nullptr;
+  // Only visit the slots that hold a packet.
+  for (size_t word = 0; word < occupied_slots_.size(); ++word) {
+    for (uint64_t slots = occupied_slots_[word]; slots != 0;
+         slots &= slots - 1) {
+      buffer_[word * 64 + absl::countr_zero(slots)] = nullptr;
+    }
+    occupied_slots_[word] = 0;
+    first_packet_slots_[word] = 0;
   }
 
   first_packet_received_ = false;
   is_cleared_to_first_seq_num_ = false;
   newest_inserted_seq_num_.reset();
-  missing_packets_.clear();
-  received_padding_.clear();
+  missing_packets_.Clear();
+  received_padding_.Clear();
 }
 
 bool PacketBuffer::ExpandBufferSize() {
-  if (buffer_.size() == max_size_) {
+  if (size_ == max_size_) {
     RTC_LOG(LS_WARNING) << "PacketBuffer is already at max size (" << max_size_
                         << "), failed to increase size.";
     return false;
   }
 
-  size_t new_size = std::min(max_size_, 2 * buffer_.size());
-  std::vector<std::unique_ptr<Packet>> new_buffer(new_size);
-  for (std::unique_ptr<Packet>& entry : buffer_) {
-    if (entry != nullptr) {
-      new_buffer[entry->seq_num % new_size] = std::move(entry);
+  // Doubling the size moves a packet either nowhere or `size_` slots up, into
+  // a slot that was not in use.
+  size_t new_size = std::min(max_size_, 2 * size_);
+  for (size_t index = 0; index < size_; ++index) {
+    if (buffer_[index] == nullptr) {
+      continue;
+    }
+    const size_t new_index = buffer_[index]->seq_num % new_size;
+    if (new_index != index) {
+      StorePacket(new_index, TakePacket(index));
     }
   }
-  buffer_ = std::move(new_buffer);
+  size_ = new_size;
   RTC_LOG(LS_INFO) << "PacketBuffer size expanded to " << new_size;
   return true;
 }
 
+void PacketBuffer::StorePacket(size_t index, std::unique_ptr<Packet> packet) {
+  RTC_DCHECK(buffer_[index] == nullptr);
+  const uint64_t slot_bit = uint64_t{1} << (index % 64);
+  occupied_slots_[index / 64] |= slot_bit;
+  if (packet->is_first_packet_in_frame()) {
+    first_packet_slots_[index / 64] |= slot_bit;
+  }
+  buffer_[index] = std::move(packet);
+}
+
+std::unique_ptr<PacketBuffer::Packet> PacketBuffer::TakePacket(size_t index) {
+  const uint64_t slot_mask = ~(uint64_t{1} << (index % 64));
+  occupied_slots_[index / 64] &= slot_mask;
+  first_packet_slots_[index / 64] &= slot_mask;
+  return std::move(buffer_[index]);
+}
+
+size_t PacketBuffer::DistanceToFrameStart(size_t index) const {
+  // Scan 64 slots at a time, backward from `index` and wrapping around at the
+  // first slot.
+  size_t distance = 0;
+  while (distance < size_) {
+    const size_t word = index / 64;
+    const size_t bit = index % 64;
+    const uint64_t stops =
+        (~occupied_slots_[word] | first_packet_slots_[word]) &
+        (~uint64_t{0} >> (63 - bit));
+    if (stops != 0) {
+      const size_t stop_bit = 63 - absl::countl_zero(stops);
+      return std::min(distance + bit - stop_bit, size_);
+    }
+    distance += bit + 1;
+    index = index > bit ? index - bit - 1 : size_ - 1;
+  }
+  return size_;
+}
+
 bool PacketBuffer::PotentialNewFrame(uint16_t seq_num) const {
-  size_t index = seq_num % buffer_.size();
-  int prev_index = index > 0 ? index - 1 : buffer_.size() - 1;
+  size_t index = seq_num % size_;
+  int prev_index = index > 0 ? index - 1 : size_ - 1;
   const auto& entry = buffer_[index];
   const auto& prev_entry = buffer_[prev_index];
 
@@ -227,8 +275,8 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
   std::vector<std::unique_ptr<PacketBuffer::Packet>> found_frames;
   auto start = seq_num;
 
-  for (size_t i = 0; i < buffer_.size(); ++i) {
-    if (received_padding_.find(seq_num) != received_padding_.end()) {
+  for (size_t i = 0; i < size_; ++i) {
+    if (received_padding_.Contains(seq_num)) {
       seq_num += 1;
       continue;
     }
@@ -237,7 +285,7 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
       break;
     }
 
-    size_t index = seq_num % buffer_.size();
+    size_t index = seq_num % size_;
     buffer_[index]->continuous = true;
 
     // If all packets of the frame is continuous, find the first packet of the
@@ -245,14 +293,8 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
     if (buffer_[index]->is_last_packet_in_frame()) {
       uint16_t start_seq_num = seq_num;
 
-      // Find the start index by searching backward until the packet with
-      // the `frame_begin` flag is set.
-      int start_index = index;
-      size_t tested_packets = 0;
-      int64_t frame_timestamp = buffer_[start_index]->timestamp;
-
       // Identify H.264 keyframes by means of SPS, PPS, and IDR.
-      bool is_h264 = buffer_[start_index]->codec() == kVideoCodecH264;
+      bool is_h264 = buffer_[index]->codec() == kVideoCodecH264;
       bool has_h264_sps = false;
       bool has_h264_pps = false;
       bool has_h264_idr = false;
@@ -260,52 +302,55 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
       int idr_width = -1;
       int idr_height = -1;
       bool full_frame_found = false;
-      while (true) {
+      if (!is_h264) {
+        // Find the start index by searching backward until the packet with
+        // the `frame_begin` flag is set, or until a missing packet.
+        const size_t distance = DistanceToFrameStart(index);
+        if (distance < size_) {
+          start_seq_num = seq_num - distance;
+          full_frame_found = buffer_[start_seq_num % size_] != nullptr;
+        }
+      }
+
+      int start_index = index;
+      size_t tested_packets = 0;
+      int64_t frame_timestamp = buffer_[start_index]->timestamp;
+      while (is_h264) {
         ++tested_packets;
 
-        if (!is_h264) {
-          if (buffer_[start_index] == nullptr ||
-              buffer_[start_index]->is_first_packet_in_frame()) {
-            full_frame_found = buffer_[start_index] != nullptr;
-            break;
-          }
-        }
+        const auto* h264_header = absl::get_if<RTPVideoHeaderH264>(
+            &buffer_[start_index]->video_header.video_type_header);
+        if (!h264_header || h264_header->nalus_length >= kMaxNalusPerPacket)
+          return found_frames;
 
-        if (is_h264) {
-          const auto* h264_header = absl::get_if<RTPVideoHeaderH264>(
-              &buffer_[start_index]->video_header.video_type_header);
-          if (!h264_header || h264_header->nalus_length >= kMaxNalusPerPacket)
-            return found_frames;
-
-          for (size_t j = 0; j < h264_header->nalus_length; ++j) {
-            if (h264_header->nalus[j].type == H264::NaluType::kSps) {
-              has_h264_sps = true;
-            } else if (h264_header->nalus[j].type == H264::NaluType::kPps) {
-              has_h264_pps = true;
-            } else if (h264_header->nalus[j].type == H264::NaluType::kIdr) {
-              has_h264_idr = true;
-            }
+        for (size_t j = 0; j < h264_header->nalus_length; ++j) {
+          if (h264_header->nalus[j].type == H264::NaluType::kSps) {
+            has_h264_sps = true;
+          } else if (h264_header->nalus[j].type == H264::NaluType::kPps) {
+            has_h264_pps = true;
+          } else if (h264_header->nalus[j].type == H264::NaluType::kIdr) {
+            has_h264_idr = true;
           }
-          if ((sps_pps_idr_is_h264_keyframe_ && has_h264_idr && has_h264_sps &&
-               has_h264_pps) ||
-              (!sps_pps_idr_is_h264_keyframe_ && has_h264_idr)) {
-            is_h264_keyframe = true;
-            // Store the resolution of key frame which is the packet with
-            // smallest index and valid resolution; typically its IDR or SPS
-            // packet; there may be packet preceeding this packet, IDR's
-            // resolution will be applied to them.
-            if (buffer_[start_index]->width() > 0 &&
-                buffer_[start_index]->height() > 0) {
-              idr_width = buffer_[start_index]->width();
-              idr_height = buffer_[start_index]->height();
-            }
+        }
+        if ((sps_pps_idr_is_h264_keyframe_ && has_h264_idr && has_h264_sps &&
+             has_h264_pps) ||
+            (!sps_pps_idr_is_h264_keyframe_ && has_h264_idr)) {
+          is_h264_keyframe = true;
+          // Store the resolution of key frame which is the packet with
+          // smallest index and valid resolution; typically its IDR or SPS
+          // packet; there may be packet preceeding this packet, IDR's
+          // resolution will be applied to them.
+          if (buffer_[start_index]->width() > 0 &&
+              buffer_[start_index]->height() > 0) {
+            idr_width = buffer_[start_index]->width();
+            idr_height = buffer_[start_index]->height();
           }
         }
 
-        if (tested_packets == buffer_.size())
+        if (tested_packets == size_)
           break;
 
-        start_index = start_index > 0 ? start_index - 1 : buffer_.size() - 1;
+        start_index = start_index > 0 ? start_index - 1 : size_ - 1;
 
         // In the case of H264 we don't have a frame_begin bit (yes,
         // `frame_begin` might be set to true but that is a lie). So instead
@@ -313,8 +358,8 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
         // the timestamp of that packet is the same as this one. This may cause
         // the PacketBuffer to hand out incomplete frames.
         // See: https://bugs.chromium.org/p/webrtc/issues/detail?id=7106
-        if (is_h264 && (buffer_[start_index] == nullptr ||
-                        buffer_[start_index]->timestamp != frame_timestamp)) {
+        if (buffer_[start_index] == nullptr ||
+            buffer_[start_index]->timestamp != frame_timestamp) {
           break;
         }
 
@@ -336,7 +381,7 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
         // Now that we have decided whether to treat this frame as a key frame
         // or delta frame in the frame buffer, we update the field that
         // determines if the RtpFrameObject is a key frame or delta frame.
-        const size_t first_packet_index = start_seq_num % buffer_.size();
+        const size_t first_packet_index = start_seq_num % size_;
         if (is_h264_keyframe) {
           buffer_[first_packet_index]->video_header.frame_type =
               VideoFrameType::kVideoFrameKey;
@@ -353,8 +398,8 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
 
         // If this is not a keyframe, make sure there are no gaps in the packet
         // sequence numbers up until this point.
-        if (!is_h264_keyframe && missing_packets_.upper_bound(start_seq_num) !=
-                                     missing_packets_.begin()) {
+        if (!is_h264_keyframe &&
+            missing_packets_.ContainsAtOrOlderThan(start_seq_num)) {
           return found_frames;
         }
       }
@@ -365,7 +410,7 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
         uint16_t num_packets = end_seq_num - start_seq_num;
         found_frames.reserve(found_frames.size() + num_packets);
         for (uint16_t i = start_seq_num; i != end_seq_num; ++i) {
-          std::unique_ptr<Packet>& packet = buffer_[i % buffer_.size()];
+          std::unique_ptr<Packet> packet = TakePacket(i % size_);
           RTC_DCHECK(packet);
           RTC_DCHECK_EQ(i, packet->seq_num);
           // Ensure frame boundary flags are properly set.
@@ -374,10 +419,8 @@ std::vector<std::unique_ptr<PacketBuffer::Packet>> PacketBuffer::FindFrames(
           found_frames.push_back(std::move(packet));
         }
 
-        missing_packets_.erase(missing_packets_.begin(),
-                               missing_packets_.upper_bound(seq_num));
-        received_padding_.erase(received_padding_.lower_bound(start),
-                                received_padding_.upper_bound(seq_num));
+        missing_packets_.EraseOlderThan(seq_num + 1);
+        received_padding_.EraseRange(start, seq_num);
       }
     }
     ++seq_num;
@@ -392,8 +435,7 @@ void PacketBuffer::UpdateMissingPackets(uint16_t seq_num) {
   const int kMaxPaddingAge = 1000;
   if (AheadOf(seq_num, *newest_inserted_seq_num_)) {
     uint16_t old_seq_num = seq_num - kMaxPaddingAge;
-    auto erase_to = missing_packets_.lower_bound(old_seq_num);
-    missing_packets_.erase(missing_packets_.begin(), erase_to);
+    missing_packets_.EraseOlderThan(old_seq_num);
 
     // Guard against inserting a large amount of missing packets if there is a
     // jump in the sequence number.
@@ -401,12 +443,13 @@ void PacketBuffer::UpdateMissingPackets(uint16_t seq_num) {
       *newest_inserted_seq_num_ = old_seq_num;
 
     ++*newest_inserted_seq_num_;
-    while (AheadOf(seq_num, *newest_inserted_seq_num_)) {
-      missing_packets_.insert(*newest_inserted_seq_num_);
-      ++*newest_inserted_seq_num_;
+    if (AheadOf(seq_num, *newest_inserted_seq_num_)) {
+      missing_packets_.InsertRange(*newest_inserted_seq_num_,
+                                   static_cast<uint16_t>(seq_num - 1));
     }
+    *newest_inserted_seq_num_ = seq_num;
   } else {
-    missing_packets_.erase(seq_num);
+    missing_packets_.Erase(seq_num);
   }
 }
 
@@ -13,7 +13,6 @@
 
 #include <memory>
 #include <queue>
-#include <set>
 #include <vector>
 
 #include "absl/base/attributes.h"
@@ -22,6 +21,7 @@
 #include "api/video/encoded_image.h"
 #include "modules/rtp_rtcp/source/rtp_packet_received.h"
 #include "modules/rtp_rtcp/source/rtp_video_header.h"
+#include "modules/video_coding/seq_num_bitmap.h"
 #include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/numerics/sequence_number_util.h"
 #include "rtc_base/thread_annotations.h"
@@ -89,6 +89,15 @@ class PacketBuffer {
   // Tries to expand the buffer.
   bool ExpandBufferSize();
 
+  // Moves `packet` into the empty slot at `index`.
+  void StorePacket(size_t index, std::unique_ptr<Packet> packet);
+  // Removes the packet at `index` from the buffer.
+  std::unique_ptr<Packet> TakePacket(size_t index);
+
+  // Returns how many slots before `index` the closest slot is that is either
+  // empty or holds the first packet of a frame, or `size_` if there is none.
+  size_t DistanceToFrameStart(size_t index) const;
+
   // Test if all previous packets has arrived for the given sequence number.
   bool PotentialNewFrame(uint16_t seq_num) const;
 
@@ -98,8 +107,10 @@ class PacketBuffer {
 
   void UpdateMissingPackets(uint16_t seq_num);
 
-  // buffer_.size() and max_size_ must always be a power of two.
+  // size_ and max_size_ must always be a power of two.
   const size_t max_size_;
+  // Number of slots of `buffer_` that are in use.
+  size_t size_;
 
   // The fist sequence number currently in the buffer.
   uint16_t first_seq_num_;
@@ -111,13 +122,19 @@ class PacketBuffer {
   bool is_cleared_to_first_seq_num_;
 
   // Buffer that holds the the inserted packets and information needed to
-  // determine continuity between them.
+  // determine continuity between them. Allocated for `max_size_` slots so that
+  // expanding the buffer only moves packets within it.
   std::vector<std::unique_ptr<Packet>> buffer_;
 
+  // One bit per slot of `buffer_`, set for the slots that hold a packet and
+  // for the slots that hold the first packet of a frame, respectively.
+  std::vector<uint64_t> occupied_slots_;
+  std::vector<uint64_t> first_packet_slots_;
+
   absl::optional<uint16_t> newest_inserted_seq_num_;
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> missing_packets_;
+  SeqNumBitmap missing_packets_;
 
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> received_padding_;
+  SeqNumBitmap received_padding_;
 
   // Indicates if we should require SPS, PPS, and IDR for a particular
   // RTP timestamp to treat the corresponding frame as a keyframe.
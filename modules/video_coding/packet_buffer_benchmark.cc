@@ -0,0 +1,121 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "modules/video_coding/packet_buffer.h"
+#include "rtc_base/random.h"
+
+namespace webrtc {
+namespace video_coding {
+namespace {
+
+// Same sizes as used by RtpVideoStreamReceiver2.
+constexpr size_t kStartSize = 512;
+constexpr size_t kMaxSize = 2048;
+
+constexpr int kNumFrames = 1000;
+constexpr int kPacketsPerFrame = 10;
+// Number of packets that arrive between the loss of a packet and the arrival
+// of its retransmission.
+constexpr int kRetransmissionDelay = 60;
+// Start close to the wrap-around so that it is exercised.
+constexpr uint16_t kStartSeqNum = 65000;
+
+struct TracePacket {
+  uint16_t seq_num;
+  uint32_t timestamp;
+  bool first;
+  bool last;
+};
+
+// Creates the order in which the packets of `kNumFrames` frames arrive when
+// `loss_percent` percent of them are lost. Lost packets arrive
+// `kRetransmissionDelay` packets later if `retransmit` is set, and never
+// otherwise.
+std::vector<TracePacket> CreateTrace(int loss_percent, bool retransmit) {
+  Random random(4711);
+  std::vector<TracePacket> trace;
+  std::vector<std::pair<size_t, TracePacket>> retransmissions;
+  for (int frame = 0; frame < kNumFrames; ++frame) {
+    for (int i = 0; i < kPacketsPerFrame; ++i) {
+      const TracePacket packet = {
+          static_cast<uint16_t>(kStartSeqNum + frame * kPacketsPerFrame + i),
+          static_cast<uint32_t>(frame * 3000), i == 0,
+          i == kPacketsPerFrame - 1};
+      if (static_cast<int>(random.Rand(0, 99)) < loss_percent) {
+        if (retransmit) {
+          retransmissions.emplace_back(trace.size() + kRetransmissionDelay,
+                                       packet);
+        }
+      } else {
+        trace.push_back(packet);
+      }
+      while (!retransmissions.empty() &&
+             retransmissions.front().first <= trace.size()) {
+        trace.push_back(retransmissions.front().second);
+        retransmissions.erase(retransmissions.begin());
+      }
+    }
+  }
+  for (const auto& retransmission : retransmissions) {
+    trace.push_back(retransmission.second);
+  }
+  return trace;
+}
+
+// Replays a trace of generic video packets through InsertPacket. The
+// arguments are the loss rate in percent and whether lost packets are
+// retransmitted. Creating and destroying the packets is not measured.
+void BM_InsertPacket(benchmark::State& state) {
+  const std::vector<TracePacket> trace =
+      CreateTrace(static_cast<int>(state.range(0)), state.range(1) != 0);
+  PacketBuffer packet_buffer(kStartSize, kMaxSize);
+  std::vector<std::unique_ptr<PacketBuffer::Packet>> packets(trace.size());
+  std::vector<std::unique_ptr<PacketBuffer::Packet>> frame_packets;
+  frame_packets.reserve(trace.size());
+  for (auto _ : state) {
+    state.PauseTiming();
+    packet_buffer.Clear();
+    frame_packets.clear();
+    for (size_t i = 0; i < trace.size(); ++i) {
+      packets[i] = std::make_unique<PacketBuffer::Packet>();
+      packets[i]->seq_num = trace[i].seq_num;
+      packets[i]->timestamp = trace[i].timestamp;
+      packets[i]->video_header.codec = kVideoCodecGeneric;
+      packets[i]->video_header.is_first_packet_in_frame = trace[i].first;
+      packets[i]->video_header.is_last_packet_in_frame = trace[i].last;
+    }
+    state.ResumeTiming();
+
+    for (std::unique_ptr<PacketBuffer::Packet>& packet : packets) {
+      PacketBuffer::InsertResult result =
+          packet_buffer.InsertPacket(std::move(packet));
+      for (std::unique_ptr<PacketBuffer::Packet>& frame_packet :
+           result.packets) {
+        frame_packets.push_back(std::move(frame_packet));
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * trace.size());
+}
+
+BENCHMARK(BM_InsertPacket)
+    ->ArgsProduct({{0, 5, 20, 40}, {0, 1}})
+    ->ArgNames({"loss_percent", "retransmit"});
+
+}  // namespace
+}  // namespace video_coding
+}  // namespace webrtc
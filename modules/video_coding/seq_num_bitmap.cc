@@ -0,0 +1,149 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/seq_num_bitmap.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+#include "rtc_base/numerics/sequence_number_util.h"
+
+namespace webrtc {
+namespace video_coding {
+namespace {
+
+constexpr size_t kNumSeqNums = 1 << 16;
+constexpr size_t kNumWords = kNumSeqNums / 64;
+// The largest span of sequence numbers that AheadOf() can order.
+constexpr size_t kMaxSpan = kNumSeqNums / 2;
+
+// Returns a mask of `count` bits, starting at bit `offset`.
+uint64_t Mask(size_t offset, size_t count) {
+  RTC_DCHECK_GT(count, 0);
+  RTC_DCHECK_LE(offset + count, 64);
+  const uint64_t bits =
+      count == 64 ? ~uint64_t{0} : (uint64_t{1} << count) - 1;
+  return bits << offset;
+}
+
+}  // namespace
+
+SeqNumBitmap::SeqNumBitmap()
+    : bits_(new uint64_t[kNumWords]()),
+      oldest_(0),
+      newest_(0),
+      empty_(true) {}
+
+SeqNumBitmap::~SeqNumBitmap() = default;
+
+bool SeqNumBitmap::Contains(uint16_t seq_num) const {
+  return (bits_[seq_num / 64] >> (seq_num % 64)) & 1;
+}
+
+void SeqNumBitmap::Insert(uint16_t seq_num) {
+  InsertRange(seq_num, seq_num);
+}
+
+void SeqNumBitmap::InsertRange(uint16_t first, uint16_t last) {
+  const size_t count = ForwardDiff(first, last) + size_t{1};
+  RTC_DCHECK_LT(count, kMaxSpan);
+  ExtendBounds(first, last);
+  SetBits(first, count, true);
+
+  const size_t span = ForwardDiff(oldest_, newest_) + size_t{1};
+  if (span > kMaxSpan) {
+    EraseOlderThan(static_cast<uint16_t>(newest_ - (kMaxSpan - 1)));
+  }
+}
+
+void SeqNumBitmap::Erase(uint16_t seq_num) {
+  bits_[seq_num / 64] &= ~(uint64_t{1} << (seq_num % 64));
+}
+
+void SeqNumBitmap::EraseRange(uint16_t first, uint16_t last) {
+  SetBits(first, ForwardDiff(first, last) + size_t{1}, false);
+}
+
+void SeqNumBitmap::EraseOlderThan(uint16_t seq_num) {
+  if (empty_ || !AheadOf(seq_num, oldest_)) {
+    return;
+  }
+  if (AheadOf(seq_num, newest_)) {
+    Clear();
+    return;
+  }
+  SetBits(oldest_, ForwardDiff(oldest_, seq_num), false);
+  oldest_ = seq_num;
+}
+
+bool SeqNumBitmap::ContainsAtOrOlderThan(uint16_t seq_num) const {
+  if (empty_ || AheadOf(oldest_, seq_num)) {
+    return false;
+  }
+  const uint16_t last = AheadOf(seq_num, newest_) ? newest_ : seq_num;
+  return AnyBits(oldest_, ForwardDiff(oldest_, last) + size_t{1});
+}
+
+void SeqNumBitmap::Clear() {
+  if (!empty_) {
+    SetBits(oldest_, ForwardDiff(oldest_, newest_) + size_t{1}, false);
+    empty_ = true;
+  }
+}
+
+void SeqNumBitmap::ExtendBounds(uint16_t first, uint16_t last) {
+  if (empty_) {
+    oldest_ = first;
+    newest_ = last;
+    empty_ = false;
+    return;
+  }
+  if (AheadOf(last, newest_)) {
+    newest_ = last;
+  }
+  // Measure from `newest_`, since `first` may be ahead of `oldest_` only
+  // because it lies more than half of the sequence number space before it.
+  if (ForwardDiff(first, newest_) > ForwardDiff(oldest_, newest_)) {
+    oldest_ = first;
+  }
+}
+
+void SeqNumBitmap::SetBits(uint16_t first, size_t count, bool value) {
+  size_t bit = first;
+  while (count > 0) {
+    const size_t offset = bit % 64;
+    const size_t num_bits = std::min(count, 64 - offset);
+    const uint64_t mask = Mask(offset, num_bits);
+    if (value) {
+      bits_[bit / 64] |= mask;
+    } else {
+      bits_[bit / 64] &= ~mask;
+    }
+    bit = (bit + num_bits) % kNumSeqNums;
+    count -= num_bits;
+  }
+}
+
+bool SeqNumBitmap::AnyBits(uint16_t first, size_t count) const {
+  size_t bit = first;
+  while (count > 0) {
+    const size_t offset = bit % 64;
+    const size_t num_bits = std::min(count, 64 - offset);
+    if (bits_[bit / 64] & Mask(offset, num_bits)) {
+      return true;
+    }
+    bit = (bit + num_bits) % kNumSeqNums;
+    count -= num_bits;
+  }
+  return false;
+}
+
+}  // namespace video_coding
+}  // namespace webrtc
@@ -0,0 +1,70 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef MODULES_VIDEO_CODING_SEQ_NUM_BITMAP_H_
+#define MODULES_VIDEO_CODING_SEQ_NUM_BITMAP_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+
+namespace webrtc {
+namespace video_coding {
+
+// Set of RTP sequence numbers with one bit for each sequence number, which
+// makes inserting and erasing ranges cheap and free of allocations. Like an
+// ordered set of sequence numbers, it requires that the sequence numbers span
+// less than half of the sequence number space. Inserting a sequence number
+// that would violate this erases the sequence numbers that are too old.
+class SeqNumBitmap {
+ public:
+  SeqNumBitmap();
+  ~SeqNumBitmap();
+
+  SeqNumBitmap(const SeqNumBitmap&) = delete;
+  SeqNumBitmap& operator=(const SeqNumBitmap&) = delete;
+
+  bool Contains(uint16_t seq_num) const;
+
+  void Insert(uint16_t seq_num);
+  // Inserts the sequence numbers from `first` to `last`, inclusive.
+  void InsertRange(uint16_t first, uint16_t last);
+
+  void Erase(uint16_t seq_num);
+  // Erases the sequence numbers from `first` to `last`, inclusive.
+  void EraseRange(uint16_t first, uint16_t last);
+  // Erases the sequence numbers that are older than `seq_num`.
+  void EraseOlderThan(uint16_t seq_num);
+
+  // Returns true if the set holds `seq_num` or a sequence number older than
+  // `seq_num`.
+  bool ContainsAtOrOlderThan(uint16_t seq_num) const;
+
+  // Takes time proportional to the span of the sequence numbers inserted since
+  // the bitmap was last empty, rather than to the size of the bitmap.
+  void Clear();
+
+ private:
+  void ExtendBounds(uint16_t first, uint16_t last);
+  void SetBits(uint16_t first, size_t count, bool value);
+  bool AnyBits(uint16_t first, size_t count) const;
+
+  const std::unique_ptr<uint64_t[]> bits_;
+  // All set bits lie from `oldest_` to `newest_`, unless `empty_` is set.
+  uint16_t oldest_;
+  uint16_t newest_;
+  bool empty_;
+};
+
+}  // namespace video_coding
+}  // namespace webrtc
+
+#endif  // MODULES_VIDEO_CODING_SEQ_NUM_BITMAP_H_
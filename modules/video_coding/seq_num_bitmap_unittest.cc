@@ -0,0 +1,157 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "modules/video_coding/seq_num_bitmap.h"
+
+#include <set>
+
+#include "rtc_base/numerics/sequence_number_util.h"
+#include "rtc_base/random.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace video_coding {
+namespace {
+
+TEST(SeqNumBitmapTest, InsertAndErase) {
+  SeqNumBitmap bitmap;
+  EXPECT_FALSE(bitmap.Contains(17));
+  bitmap.Insert(17);
+  EXPECT_TRUE(bitmap.Contains(17));
+  EXPECT_FALSE(bitmap.Contains(16));
+  EXPECT_FALSE(bitmap.Contains(18));
+  bitmap.Erase(17);
+  EXPECT_FALSE(bitmap.Contains(17));
+}
+
+TEST(SeqNumBitmapTest, RangesAcrossWrapAround) {
+  SeqNumBitmap bitmap;
+  bitmap.InsertRange(65500, 100);
+  EXPECT_FALSE(bitmap.Contains(65499));
+  EXPECT_TRUE(bitmap.Contains(65500));
+  EXPECT_TRUE(bitmap.Contains(65535));
+  EXPECT_TRUE(bitmap.Contains(0));
+  EXPECT_TRUE(bitmap.Contains(100));
+  EXPECT_FALSE(bitmap.Contains(101));
+
+  bitmap.EraseRange(65530, 10);
+  EXPECT_TRUE(bitmap.Contains(65529));
+  EXPECT_FALSE(bitmap.Contains(65530));
+  EXPECT_FALSE(bitmap.Contains(10));
+  EXPECT_TRUE(bitmap.Contains(11));
+}
+
+TEST(SeqNumBitmapTest, EraseOlderThan) {
+  SeqNumBitmap bitmap;
+  bitmap.InsertRange(65000, 200);
+  bitmap.EraseOlderThan(5);
+  EXPECT_FALSE(bitmap.Contains(65000));
+  EXPECT_FALSE(bitmap.Contains(4));
+  EXPECT_TRUE(bitmap.Contains(5));
+  EXPECT_TRUE(bitmap.Contains(200));
+
+  bitmap.EraseOlderThan(1000);
+  EXPECT_FALSE(bitmap.Contains(200));
+  EXPECT_FALSE(bitmap.ContainsAtOrOlderThan(1000));
+}
+
+TEST(SeqNumBitmapTest, ContainsAtOrOlderThan) {
+  SeqNumBitmap bitmap;
+  EXPECT_FALSE(bitmap.ContainsAtOrOlderThan(0));
+  bitmap.Insert(65530);
+  bitmap.Insert(20);
+  EXPECT_FALSE(bitmap.ContainsAtOrOlderThan(65529));
+  EXPECT_TRUE(bitmap.ContainsAtOrOlderThan(65530));
+  EXPECT_TRUE(bitmap.ContainsAtOrOlderThan(10));
+
+  bitmap.Erase(65530);
+  EXPECT_FALSE(bitmap.ContainsAtOrOlderThan(19));
+  EXPECT_TRUE(bitmap.ContainsAtOrOlderThan(20));
+  EXPECT_TRUE(bitmap.ContainsAtOrOlderThan(30000));
+}
+
+TEST(SeqNumBitmapTest, InsertingTooNewErasesOldest) {
+  SeqNumBitmap bitmap;
+  bitmap.Insert(0);
+  bitmap.Insert(200);
+  bitmap.Insert(32800);
+  EXPECT_FALSE(bitmap.Contains(0));
+  EXPECT_TRUE(bitmap.Contains(200));
+  EXPECT_TRUE(bitmap.Contains(32800));
+  EXPECT_FALSE(bitmap.ContainsAtOrOlderThan(199));
+}
+
+TEST(SeqNumBitmapTest, Clear) {
+  SeqNumBitmap bitmap;
+  bitmap.InsertRange(65000, 300);
+  bitmap.Clear();
+  EXPECT_FALSE(bitmap.Contains(65000));
+  EXPECT_FALSE(bitmap.Contains(300));
+  EXPECT_FALSE(bitmap.ContainsAtOrOlderThan(300));
+
+  bitmap.Insert(40000);
+  EXPECT_TRUE(bitmap.Contains(40000));
+  EXPECT_FALSE(bitmap.ContainsAtOrOlderThan(39999));
+}
+
+// Compares against the ordered set that the bitmap replaces in PacketBuffer,
+// with sequence numbers that move forward the way they do in a stream.
+TEST(SeqNumBitmapTest, MatchesOrderedSet) {
+  Random random(123);
+  SeqNumBitmap bitmap;
+  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> set;
+  uint16_t newest = 65000;
+  for (int i = 0; i < 20000; ++i) {
+    const uint16_t seq_num =
+        static_cast<uint16_t>(newest - 500 + random.Rand(0, 600));
+    switch (random.Rand(0, 4)) {
+      case 0:
+        bitmap.Insert(seq_num);
+        set.insert(seq_num);
+        break;
+      case 1: {
+        const uint16_t last = static_cast<uint16_t>(seq_num + random.Rand(80));
+        bitmap.InsertRange(seq_num, last);
+        for (uint16_t s = seq_num; s != static_cast<uint16_t>(last + 1); ++s) {
+          set.insert(s);
+        }
+        break;
+      }
+      case 2:
+        bitmap.Erase(seq_num);
+        set.erase(seq_num);
+        break;
+      case 3: {
+        const uint16_t last = static_cast<uint16_t>(seq_num + random.Rand(80));
+        bitmap.EraseRange(seq_num, last);
+        set.erase(set.lower_bound(seq_num), set.upper_bound(last));
+        break;
+      }
+      case 4:
+        bitmap.EraseOlderThan(seq_num);
+        set.erase(set.begin(), set.lower_bound(seq_num));
+        break;
+    }
+    if (AheadOf(seq_num, newest)) {
+      newest = seq_num;
+    }
+
+    const uint16_t probe =
+        static_cast<uint16_t>(newest - 700 + random.Rand(0, 800));
+    ASSERT_EQ(bitmap.Contains(probe), set.count(probe) == 1) << i;
+    ASSERT_EQ(bitmap.ContainsAtOrOlderThan(probe),
+              set.upper_bound(probe) != set.begin())
+        << i;
+  }
+}
+
+}  // namespace
+}  // namespace video_coding
+}  // namespace webrtc
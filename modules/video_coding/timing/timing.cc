@@ -190,6 +190,11 @@ void VCMTiming::SetLastDecodeScheduledTimestamp(
   last_decode_scheduled_ = last_decode_scheduled;
 }
 
+Timestamp VCMTiming::LastDecodeScheduledTimestamp() const {
+  MutexLock lock(&mutex_);
+  return last_decode_scheduled_;
+}
+
 Timestamp VCMTiming::RenderTimeInternal(uint32_t frame_timestamp,
                                         Timestamp now) const {
   if (UseLowLatencyRendering()) {
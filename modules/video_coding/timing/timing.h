@@ -117,6 +117,9 @@ class VCMTiming {
 
   // Updates the last time a frame was scheduled for decoding.
   void SetLastDecodeScheduledTimestamp(Timestamp last_decode_scheduled);
+  // Returns the last time a frame was scheduled for decoding, or zero if no
+  // frame has been.
+  Timestamp LastDecodeScheduledTimestamp() const;
 
  protected:
   TimeDelta RequiredDecodeTime() const RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
@@ -98,16 +98,16 @@ int TraditionalReassemblyStreams::UnorderedStream::Add(UnwrappedTSN tsn,
 }
 
 size_t TraditionalReassemblyStreams::UnorderedStream::TryToAssembleMessage(
-    ChunkMap::iterator iter) {
+    StreamChunkMap::iterator iter) {
   // TODO(boivie): This method is O(N) with the number of fragments in a
   // message, which can be inefficient for very large values of N. This could be
   // optimized by e.g. only trying to assemble a message once _any_ beginning
   // and _any_ end has been found.
-  absl::optional<ChunkMap::iterator> start = FindBeginning(chunks_, iter);
+  absl::optional<StreamChunkMap::iterator> start = FindBeginning(chunks_, iter);
   if (!start.has_value()) {
     return 0;
   }
-  absl::optional<ChunkMap::iterator> end = FindEnd(chunks_, iter);
+  absl::optional<StreamChunkMap::iterator> end = FindEnd(chunks_, iter);
   if (!end.has_value()) {
     return 0;
   }
@@ -117,14 +117,14 @@ size_t TraditionalReassemblyStreams::UnorderedStream::TryToAssembleMessage(
   return bytes_assembled;
 }
 
+template <typename Iterator>
 size_t TraditionalReassemblyStreams::StreamBase::AssembleMessage(
-    const ChunkMap::iterator start,
-    const ChunkMap::iterator end) {
+    const Iterator start, const Iterator end) {
   size_t count = std::distance(start, end);
 
   if (count == 1) {
     // Fast path - zero-copy
-    const Data& data = start->second;
+    Data& data = start->second;
     size_t payload_size = start->second.size();
     UnwrappedTSN tsns[1] = {start->first};
     DcSctpMessage message(data.stream_id, data.ppid, std::move(data.payload));
@@ -171,7 +171,7 @@ size_t TraditionalReassemblyStreams::OrderedStream::TryToAssembleMessage() {
     return 0;
   }
 
-  ChunkMap& chunks = chunks_by_ssn_.begin()->second;
+  MessageChunkMap& chunks = chunks_by_ssn_.begin()->second;
 
   if (!chunks.begin()->second.is_beginning || !chunks.rbegin()->second.is_end) {
     return 0;
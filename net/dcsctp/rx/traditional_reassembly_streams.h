@@ -21,6 +21,7 @@
 #include "net/dcsctp/packet/chunk/forward_tsn_common.h"
 #include "net/dcsctp/packet/data.h"
 #include "net/dcsctp/rx/reassembly_streams.h"
+#include "rtc_base/containers/flat_map.h"
 
 namespace dcsctp {
 
@@ -46,7 +47,16 @@ class TraditionalReassemblyStreams : public ReassemblyStreams {
   void RestoreFromState(const DcSctpSocketHandoverState& state) override;
 
  private:
-  using ChunkMap = std::map<UnwrappedTSN, Data>;
+  // The chunks of a single message of an ordered stream, sorted by TSN. As the
+  // chunks of a message have consecutive TSNs and are mostly received in order,
+  // they are stored contiguously and are typically appended at the end, without
+  // allocating a node for every chunk.
+  using MessageChunkMap = webrtc::flat_map<UnwrappedTSN, Data>;
+
+  // All not-yet-assembled chunks of an unordered stream, sorted by TSN. This
+  // can hold the fragments of many messages, received in any order, so it is a
+  // node-based map to keep insertions and erasures logarithmic.
+  using StreamChunkMap = std::map<UnwrappedTSN, Data>;
 
   // Base class for `UnorderedStream` and `OrderedStream`.
   class StreamBase {
@@ -54,7 +64,10 @@ class TraditionalReassemblyStreams : public ReassemblyStreams {
     explicit StreamBase(TraditionalReassemblyStreams* parent)
         : parent_(*parent) {}
 
-    size_t AssembleMessage(ChunkMap::iterator start, ChunkMap::iterator end);
+    // Assembles the chunks in [`start`, `end`), which is an iterator range of
+    // either a `MessageChunkMap` or a `StreamChunkMap`.
+    template <typename Iterator>
+    size_t AssembleMessage(Iterator start, Iterator end);
     TraditionalReassemblyStreams& parent_;
   };
 
@@ -75,9 +88,9 @@ class TraditionalReassemblyStreams : public ReassemblyStreams {
     // those chunks from the stream chunks map.
     //
     // Returns the number of bytes that were assembled.
-    size_t TryToAssembleMessage(ChunkMap::iterator iter);
+    size_t TryToAssembleMessage(StreamChunkMap::iterator iter);
 
-    ChunkMap chunks_;
+    StreamChunkMap chunks_;
   };
 
   // Manages all received data for a specific ordered stream, and assembles
@@ -102,7 +115,7 @@ class TraditionalReassemblyStreams : public ReassemblyStreams {
     size_t TryToAssembleMessage();
     size_t TryToAssembleMessages();
     // This must be an ordered container to be able to iterate in SSN order.
-    std::map<UnwrappedSSN, ChunkMap> chunks_by_ssn_;
+    std::map<UnwrappedSSN, MessageChunkMap> chunks_by_ssn_;
     UnwrappedSSN::Unwrapper ssn_unwrapper_;
     UnwrappedSSN next_ssn_;
   };
@@ -0,0 +1,248 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <new>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
+#include "api/array_view.h"
+#include "api/task_queue/task_queue_base.h"
+#include "benchmark/benchmark.h"
+#include "net/dcsctp/public/dcsctp_message.h"
+#include "net/dcsctp/public/dcsctp_options.h"
+#include "net/dcsctp/public/dcsctp_socket.h"
+#include "net/dcsctp/public/timeout.h"
+#include "net/dcsctp/public/types.h"
+#include "net/dcsctp/socket/dcsctp_socket.h"
+#include "net/dcsctp/timer/fake_timeout.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/random.h"
+
+// The global allocation functions are replaced to count the heap allocations
+// made by the process, which is reported by the benchmarks. This is why this
+// benchmark is built as its own executable rather than as part of the shared
+// benchmarks binary. The nothrow variants of the standard library forward to
+// the ones below.
+namespace {
+std::atomic<int64_t> g_num_allocations{0};
+
+void* CountedAlloc(size_t size, size_t alignment) {
+  g_num_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (size == 0) {
+    size = 1;
+  }
+  void* ptr;
+  if (alignment <= alignof(std::max_align_t)) {
+    ptr = malloc(size);
+  } else {
+    // aligned_alloc() requires the size to be a multiple of the alignment.
+    size = (size + alignment - 1) / alignment * alignment;
+    ptr = aligned_alloc(alignment, size);
+  }
+  RTC_CHECK(ptr != nullptr);
+  return ptr;
+}
+}  // namespace
+
+void* operator new(size_t size) {
+  return CountedAlloc(size, alignof(std::max_align_t));
+}
+void* operator new[](size_t size) {
+  return CountedAlloc(size, alignof(std::max_align_t));
+}
+void* operator new(size_t size, std::align_val_t alignment) {
+  return CountedAlloc(size, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment) {
+  return CountedAlloc(size, static_cast<size_t>(alignment));
+}
+
+void operator delete(void* ptr) noexcept {
+  free(ptr);
+}
+void operator delete[](void* ptr) noexcept {
+  free(ptr);
+}
+void operator delete(void* ptr, size_t size) noexcept {
+  free(ptr);
+}
+void operator delete[](void* ptr, size_t size) noexcept {
+  free(ptr);
+}
+void operator delete(void* ptr, std::align_val_t alignment) noexcept {
+  free(ptr);
+}
+void operator delete[](void* ptr, std::align_val_t alignment) noexcept {
+  free(ptr);
+}
+void operator delete(void* ptr,
+                     size_t size,
+                     std::align_val_t alignment) noexcept {
+  free(ptr);
+}
+void operator delete[](void* ptr,
+                       size_t size,
+                       std::align_val_t alignment) noexcept {
+  free(ptr);
+}
+
+namespace dcsctp {
+namespace {
+
+constexpr int64_t kBytesToTransfer = int64_t{1} << 30;
+constexpr size_t kMessageSize = 64 * 1024;
+constexpr StreamID kStreamId = StreamID(1);
+constexpr PPID kPpid = PPID(53);
+// How much data that is kept in the send buffer of the sender.
+constexpr size_t kBufferedAmount = 1024 * 1024;
+
+// One endpoint of the simulated link. Packets sent by the socket are put in
+// `outgoing_packets` until they are delivered to the peer.
+class Endpoint : public DcSctpSocketCallbacks {
+ public:
+  Endpoint(absl::string_view name, const TimeMs& now)
+      : now_(now),
+        timeout_manager_([this]() { return now_; }),
+        random_(42),
+        socket_(name, *this, /*packet_observer=*/nullptr, DcSctpOptions()) {}
+
+  SendPacketStatus SendPacketWithStatus(
+      rtc::ArrayView<const uint8_t> data) override {
+    outgoing_packets.emplace_back(data.begin(), data.end());
+    return SendPacketStatus::kSuccess;
+  }
+  std::unique_ptr<Timeout> CreateTimeout(
+      webrtc::TaskQueueBase::DelayPrecision precision) override {
+    return timeout_manager_.CreateTimeout(precision);
+  }
+  TimeMs TimeMillis() override { return now_; }
+  uint32_t GetRandomInt(uint32_t low, uint32_t high) override {
+    return random_.Rand(low, high);
+  }
+  void OnMessageReceived(DcSctpMessage message) override {
+    received_bytes += message.payload().size();
+  }
+  void OnError(ErrorKind error, absl::string_view message) override {}
+  void OnAborted(ErrorKind error, absl::string_view message) override {
+    RTC_CHECK_NOTREACHED();
+  }
+  void OnConnected() override {}
+  void OnClosed() override {}
+  void OnConnectionRestarted() override {}
+  void OnStreamsResetFailed(rtc::ArrayView<const StreamID> outgoing_streams,
+                            absl::string_view reason) override {}
+  void OnStreamsResetPerformed(
+      rtc::ArrayView<const StreamID> outgoing_streams) override {}
+  void OnIncomingStreamsReset(
+      rtc::ArrayView<const StreamID> incoming_streams) override {}
+
+  void HandleExpiredTimeouts() {
+    for (;;) {
+      absl::optional<TimeoutID> timeout_id =
+          timeout_manager_.GetNextExpiredTimeout();
+      if (!timeout_id.has_value()) {
+        break;
+      }
+      socket_.HandleTimeout(*timeout_id);
+    }
+  }
+
+  DcSctpSocket& socket() { return socket_; }
+
+  std::deque<std::vector<uint8_t>> outgoing_packets;
+  int64_t received_bytes = 0;
+
+ private:
+  const TimeMs& now_;
+  FakeTimeoutManager timeout_manager_;
+  webrtc::Random random_;
+  DcSctpSocket socket_;
+};
+
+// Delivers all packets sent by `from` to `to`, dropping a packet with the
+// probability `loss_percent` / 100.
+void DeliverPackets(Endpoint& from,
+                    Endpoint& to,
+                    int loss_percent,
+                    webrtc::Random& random) {
+  while (!from.outgoing_packets.empty()) {
+    std::vector<uint8_t> packet = std::move(from.outgoing_packets.front());
+    from.outgoing_packets.pop_front();
+    if (loss_percent == 0 || random.Rand(1, 100) > loss_percent) {
+      to.socket().ReceivePacket(packet);
+    }
+  }
+}
+
+// Transfers 1 GB of ordered and reliable messages from one socket to another,
+// over a link without any bandwidth limitation, which makes the throughput
+// limited only by the CPU. In every millisecond of simulated time, all packets
+// in flight are delivered, and expired timers are triggered. The argument is
+// the packet loss, in percent, which exercises the SACK gap ack blocks and
+// retransmissions.
+void BM_TransferLargeFile(benchmark::State& state) {
+  const int loss_percent = state.range(0);
+  int64_t num_allocations = 0;
+  for (auto _ : state) {
+    TimeMs now = TimeMs(0);
+    webrtc::Random random(42);
+    Endpoint sender("A", now);
+    Endpoint receiver("Z", now);
+
+    sender.socket().Connect();
+    while (sender.socket().state() != SocketState::kConnected) {
+      DeliverPackets(sender, receiver, /*loss_percent=*/0, random);
+      DeliverPackets(receiver, sender, /*loss_percent=*/0, random);
+    }
+
+    int64_t allocations_before = g_num_allocations.load();
+    int64_t sent_bytes = 0;
+    while (receiver.received_bytes < kBytesToTransfer) {
+      while (sent_bytes < kBytesToTransfer &&
+             sender.socket().buffered_amount(kStreamId) < kBufferedAmount) {
+        sender.socket().Send(
+            DcSctpMessage(kStreamId, kPpid,
+                          std::vector<uint8_t>(kMessageSize)),
+            SendOptions());
+        sent_bytes += kMessageSize;
+      }
+      DeliverPackets(sender, receiver, loss_percent, random);
+      DeliverPackets(receiver, sender, loss_percent, random);
+      now = now + DurationMs(1);
+      sender.HandleExpiredTimeouts();
+      receiver.HandleExpiredTimeouts();
+    }
+    num_allocations += g_num_allocations.load() - allocations_before;
+  }
+  state.SetBytesProcessed(state.iterations() * kBytesToTransfer);
+  state.counters["allocations"] =
+      benchmark::Counter(num_allocations, benchmark::Counter::kAvgIterations);
+  state.counters["allocations_per_message"] = benchmark::Counter(
+      static_cast<double>(num_allocations) /
+      (state.iterations() * kBytesToTransfer / kMessageSize));
+}
+
+BENCHMARK(BM_TransferLargeFile)
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+}  // namespace
+}  // namespace dcsctp
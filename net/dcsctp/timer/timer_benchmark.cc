@@ -0,0 +1,197 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include <stdint.h>
+
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/types/optional.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/units/time_delta.h"
+#include "benchmark/benchmark.h"
+#include "net/dcsctp/public/types.h"
+#include "net/dcsctp/timer/task_queue_timeout.h"
+#include "net/dcsctp/timer/timer.h"
+#include "net/dcsctp/timer/timer_wheel_timeout.h"
+#include "rtc_base/checks.h"
+
+namespace dcsctp {
+namespace {
+
+// A task queue with a simulated clock, which counts the delayed tasks posted
+// to it.
+class CountingTaskQueue : public webrtc::TaskQueueBase {
+ public:
+  void Delete() override {}
+  void PostTask(absl::AnyInvocable<void() &&> task) override {
+    PostDelayedTask(std::move(task), webrtc::TimeDelta::Zero());
+  }
+  void PostDelayedTask(absl::AnyInvocable<void() &&> task,
+                       webrtc::TimeDelta delay) override {
+    ++num_posted_tasks_;
+    tasks_.emplace(std::make_pair(*now_ + delay.ms(), num_posted_tasks_),
+                   std::move(task));
+  }
+  void PostDelayedHighPrecisionTask(absl::AnyInvocable<void() &&> task,
+                                    webrtc::TimeDelta delay) override {
+    PostDelayedTask(std::move(task), delay);
+  }
+
+  // Runs all tasks that are due, up until `duration` from now.
+  void AdvanceTime(DurationMs duration) {
+    TimeMs end = now_ + duration;
+    while (!tasks_.empty() && tasks_.begin()->first.first <= *end) {
+      now_ = TimeMs(tasks_.begin()->first.first);
+      absl::AnyInvocable<void() &&> task = std::move(tasks_.begin()->second);
+      tasks_.erase(tasks_.begin());
+      std::move(task)();
+    }
+    now_ = end;
+  }
+
+  TimeMs now() const { return now_; }
+  int64_t num_posted_tasks() const { return num_posted_tasks_; }
+
+ private:
+  TimeMs now_ = TimeMs(0);
+  int64_t num_posted_tasks_ = 0;
+  // Ordered by time, and then by the order they were posted in.
+  std::map<std::pair<int64_t, int64_t>, absl::AnyInvocable<void() &&>> tasks_;
+};
+
+// The timers of a socket, started and stopped like the retransmission queue,
+// data tracker and heartbeat handler do it.
+template <typename TimeoutFactory>
+class SocketTimers {
+ public:
+  // `args` are the arguments to the timeout factory's constructor, excluding
+  // the expiration callback.
+  template <typename... Args>
+  explicit SocketTimers(Args&&... args)
+      : timeout_factory_(std::forward<Args>(args)...,
+                         [this](TimeoutID timeout_id) {
+                           timer_manager_.HandleTimeout(timeout_id);
+                         }),
+        timer_manager_([this](webrtc::TaskQueueBase::DelayPrecision precision) {
+          return timeout_factory_.CreateTimeout(precision);
+        }),
+        t3_rtx_(timer_manager_.CreateTimer(
+            "t3-rtx",
+            []() { return absl::nullopt; },
+            TimerOptions(DurationMs(1000),
+                         TimerBackoffAlgorithm::kExponential))),
+        delayed_ack_timer_(timer_manager_.CreateTimer(
+            "delayed-ack",
+            []() { return absl::nullopt; },
+            TimerOptions(DurationMs(200),
+                         TimerBackoffAlgorithm::kExponential,
+                         /*max_restarts=*/0,
+                         /*max_backoff_duration=*/absl::nullopt,
+                         webrtc::TaskQueueBase::DelayPrecision::kHigh))),
+        heartbeat_timer_(timer_manager_.CreateTimer(
+            "heartbeat-interval",
+            []() { return absl::nullopt; },
+            TimerOptions(DurationMs(30000),
+                         TimerBackoffAlgorithm::kFixed))) {}
+
+  void SendData() {
+    if (!t3_rtx_->is_running()) {
+      t3_rtx_->Start();
+    }
+    OnPacketSent();
+  }
+
+  void ReceiveData() {
+    // Every second DATA chunk is acked immediately.
+    if (delayed_ack_timer_->is_running()) {
+      delayed_ack_timer_->Stop();
+      OnPacketSent();
+    } else {
+      delayed_ack_timer_->Start();
+    }
+  }
+
+  // A SACK acking new data restarts the retransmission timer.
+  void ReceiveSack() { t3_rtx_->Start(); }
+
+ private:
+  void OnPacketSent() { heartbeat_timer_->Start(); }
+
+  TimeoutFactory timeout_factory_;
+  TimerManager timer_manager_;
+  const std::unique_ptr<Timer> t3_rtx_;
+  const std::unique_ptr<Timer> delayed_ack_timer_;
+  const std::unique_ptr<Timer> heartbeat_timer_;
+};
+
+// Simulates one second of data channel traffic per iteration, where every
+// socket sends and receives a DATA packet every millisecond, and receives a
+// SACK every other millisecond. Reports the number of delayed tasks posted to
+// the task queue per second.
+template <typename TimeoutFactory>
+void RunDataChannelTraffic(
+    benchmark::State& state,
+    CountingTaskQueue& task_queue,
+    std::vector<std::unique_ptr<SocketTimers<TimeoutFactory>>>& sockets) {
+  for (auto _ : state) {
+    for (int ms = 0; ms < 1000; ++ms) {
+      for (auto& socket : sockets) {
+        socket->SendData();
+        socket->ReceiveData();
+        if (ms % 2 == 1) {
+          socket->ReceiveSack();
+        }
+      }
+      task_queue.AdvanceTime(DurationMs(1));
+    }
+  }
+  state.counters["posted_tasks_per_second"] = benchmark::Counter(
+      task_queue.num_posted_tasks(), benchmark::Counter::kAvgIterations);
+  state.SetItemsProcessed(state.iterations() * 1000 * sockets.size());
+}
+
+// Every socket has a timeout factory of its own.
+template <typename TimeoutFactory>
+void BM_TimersWithDataChannelTraffic(benchmark::State& state) {
+  CountingTaskQueue task_queue;
+  std::vector<std::unique_ptr<SocketTimers<TimeoutFactory>>> sockets;
+  for (int i = 0; i < state.range(0); ++i) {
+    sockets.push_back(std::make_unique<SocketTimers<TimeoutFactory>>(
+        task_queue, [&task_queue]() { return task_queue.now(); }));
+  }
+  RunDataChannelTraffic(state, task_queue, sockets);
+}
+
+BENCHMARK_TEMPLATE(BM_TimersWithDataChannelTraffic, TaskQueueTimeoutFactory)
+    ->Arg(1)
+    ->Arg(100);
+BENCHMARK_TEMPLATE(BM_TimersWithDataChannelTraffic, TimerWheelTimeoutFactory)
+    ->Arg(1)
+    ->Arg(100);
+
+// All sockets share a timer wheel.
+void BM_TimersWithDataChannelTrafficOnSharedWheel(benchmark::State& state) {
+  CountingTaskQueue task_queue;
+  TimerWheel wheel(task_queue, [&task_queue]() { return task_queue.now(); });
+  std::vector<std::unique_ptr<SocketTimers<TimerWheelTimeoutFactory>>> sockets;
+  for (int i = 0; i < state.range(0); ++i) {
+    sockets.push_back(
+        std::make_unique<SocketTimers<TimerWheelTimeoutFactory>>(wheel));
+  }
+  RunDataChannelTraffic(state, task_queue, sockets);
+}
+
+BENCHMARK(BM_TimersWithDataChannelTrafficOnSharedWheel)->Arg(1)->Arg(100);
+
+}  // namespace
+}  // namespace dcsctp
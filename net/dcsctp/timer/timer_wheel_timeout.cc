@@ -0,0 +1,289 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "net/dcsctp/timer/timer_wheel_timeout.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/numeric/bits.h"
+#include "api/task_queue/pending_task_safety_flag.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/logging.h"
+
+namespace dcsctp {
+
+constexpr DurationMs TimerWheel::kDefaultResolution;
+
+TimerWheel::WheelTimeout::WheelTimeout(
+    TimerWheel& wheel,
+    const std::function<void(TimeoutID)>& on_expired,
+    webrtc::TaskQueueBase::DelayPrecision precision)
+    : wheel_(wheel), on_expired_(on_expired), precision_(precision) {}
+
+TimerWheel::WheelTimeout::~WheelTimeout() {
+  RTC_DCHECK_RUN_ON(&wheel_.thread_checker_);
+  if (is_linked()) {
+    wheel_.Stop(*this);
+  }
+}
+
+void TimerWheel::WheelTimeout::Start(DurationMs duration_ms,
+                                     TimeoutID timeout_id) {
+  RTC_DCHECK_RUN_ON(&wheel_.thread_checker_);
+  RTC_DCHECK(!is_linked());
+  timeout_id_ = timeout_id;
+  wheel_.Start(*this, wheel_.get_time_() + duration_ms);
+}
+
+void TimerWheel::WheelTimeout::Restart(DurationMs duration_ms,
+                                       TimeoutID timeout_id) {
+  RTC_DCHECK_RUN_ON(&wheel_.thread_checker_);
+  RTC_DCHECK(is_linked());
+  timeout_id_ = timeout_id;
+  wheel_.Restart(*this, wheel_.get_time_() + duration_ms);
+}
+
+void TimerWheel::WheelTimeout::Stop() {
+  RTC_DCHECK_RUN_ON(&wheel_.thread_checker_);
+  if (is_linked()) {
+    // Stopping a timeout never affects the posted task. If there is nothing
+    // to do when it runs, it will just post the next one.
+    wheel_.Stop(*this);
+  }
+}
+
+TimerWheel::TimerWheel(webrtc::TaskQueueBase& task_queue,
+                       std::function<TimeMs()> get_time,
+                       DurationMs resolution)
+    : task_queue_(task_queue),
+      get_time_(std::move(get_time)),
+      resolution_(resolution),
+      pending_task_safety_flag_(webrtc::PendingTaskSafetyFlag::Create()) {
+  RTC_DCHECK_GT(*resolution_, 0);
+}
+
+TimerWheel::~TimerWheel() {
+  RTC_DCHECK_RUN_ON(&thread_checker_);
+  RTC_DCHECK_EQ(num_running_, 0);
+  pending_task_safety_flag_->SetNotAlive();
+}
+
+void TimerWheel::Start(WheelTimeout& timeout, TimeMs expiration) {
+  if (num_running_ == 0 && !is_advancing_) {
+    // The wheel is empty, so it can be moved to the current time without
+    // processing any slots.
+    current_tick_ = std::max(current_tick_, TimeToTick(get_time_()));
+  }
+
+  timeout.expiration_tick_ = ExpirationTick(expiration);
+  int64_t event_tick = Insert(timeout);
+  ++num_running_;
+  if (timeout.precision_ == webrtc::TaskQueueBase::DelayPrecision::kHigh) {
+    ++num_running_high_precision_;
+  }
+
+  if (!is_advancing_) {
+    ScheduleTick(event_tick);
+  }
+}
+
+void TimerWheel::Stop(WheelTimeout& timeout) {
+  Unlink(timeout);
+  --num_running_;
+  if (timeout.precision_ == webrtc::TaskQueueBase::DelayPrecision::kHigh) {
+    --num_running_high_precision_;
+  }
+}
+
+void TimerWheel::Restart(WheelTimeout& timeout, TimeMs expiration) {
+  if (is_advancing_) {
+    // The timeout may be in `expiring_`.
+    Stop(timeout);
+    Start(timeout, expiration);
+    return;
+  }
+
+  // Timeouts are typically restarted long before they expire, with the same
+  // duration, which often keeps them in the same slot.
+  timeout.expiration_tick_ = ExpirationTick(expiration);
+  Position position = GetPosition(timeout.expiration_tick_);
+  if (position.level == timeout.level_ && position.slot == timeout.slot_) {
+    return;
+  }
+  Unlink(timeout);
+  Link(timeout, position);
+  ScheduleTick(position.event_tick);
+}
+
+int64_t TimerWheel::ExpirationTick(TimeMs expiration) const {
+  // Round up, so that the timeout never expires early.
+  return std::max(TimeToTick(expiration + resolution_ - DurationMs(1)),
+                  current_tick_ + 1);
+}
+
+TimerWheel::Position TimerWheel::GetPosition(int64_t expiration_tick) const {
+  RTC_DCHECK_GE(expiration_tick, current_tick_);
+  // Timeouts beyond the span of the wheel are put in the furthest slot, and
+  // will be re-inserted when that slot is processed.
+  int64_t tick = std::min(expiration_tick, current_tick_ + kMaxTicks - 1);
+  int64_t delta = tick - current_tick_;
+  int level =
+      delta == 0 ? 0 : (absl::bit_width(static_cast<uint64_t>(delta)) - 1) /
+                           kSlotBits;
+  int shift = kSlotBits * level;
+  int slot = (tick >> shift) & (kSlotsPerLevel - 1);
+  return {level, slot, (tick >> shift) << shift};
+}
+
+int64_t TimerWheel::Insert(WheelTimeout& timeout) {
+  Position position = GetPosition(timeout.expiration_tick_);
+  Link(timeout, position);
+  return position.event_tick;
+}
+
+void TimerWheel::Link(WheelTimeout& timeout, const Position& position) {
+  RTC_DCHECK(!timeout.is_linked());
+  WheelTimeout*& head = slots_[position.level][position.slot];
+  timeout.next_ = head;
+  if (head != nullptr) {
+    head->prev_next_ = &timeout.next_;
+  }
+  head = &timeout;
+  timeout.prev_next_ = &head;
+  timeout.level_ = position.level;
+  timeout.slot_ = position.slot;
+  occupied_[position.level] |= uint64_t{1} << position.slot;
+}
+
+void TimerWheel::Unlink(WheelTimeout& timeout) {
+  RTC_DCHECK(timeout.is_linked());
+  *timeout.prev_next_ = timeout.next_;
+  if (timeout.next_ != nullptr) {
+    timeout.next_->prev_next_ = timeout.prev_next_;
+  }
+  timeout.next_ = nullptr;
+  timeout.prev_next_ = nullptr;
+  // If the timeout was in `expiring_`, its slot has already been emptied and
+  // the bit cleared - or the slot has been filled again, in which case the bit
+  // must be kept.
+  if (slots_[timeout.level_][timeout.slot_] == nullptr) {
+    occupied_[timeout.level_] &= ~(uint64_t{1} << timeout.slot_);
+  }
+}
+
+int64_t TimerWheel::NextEventTick() const {
+  int64_t next_tick = kNoTick;
+  for (int level = 0; level < kLevels; ++level) {
+    if (occupied_[level] == 0) {
+      continue;
+    }
+    // The slot of the current tick has already been processed, so the search
+    // starts at the slot after it, wrapping around to end at the current slot.
+    int shift = kSlotBits * level;
+    int64_t current = current_tick_ >> shift;
+    int start = (current + 1) & (kSlotsPerLevel - 1);
+    int offset = absl::countr_zero(absl::rotr(occupied_[level], start)) + 1;
+    next_tick = std::min(next_tick, (current + offset) << shift);
+  }
+  return next_tick;
+}
+
+void TimerWheel::AdvanceTo(int64_t tick) {
+  is_advancing_ = true;
+  for (int64_t next_tick = NextEventTick(); next_tick <= tick;
+       next_tick = NextEventTick()) {
+    current_tick_ = next_tick;
+
+    // Move the timeouts in the coarser levels' slots that start at this tick
+    // down to the finer levels.
+    for (int level = kLevels - 1; level > 0; --level) {
+      int shift = kSlotBits * level;
+      if ((current_tick_ & ((int64_t{1} << shift) - 1)) != 0) {
+        continue;
+      }
+      int slot = (current_tick_ >> shift) & (kSlotsPerLevel - 1);
+      WheelTimeout* timeout = slots_[level][slot];
+      slots_[level][slot] = nullptr;
+      occupied_[level] &= ~(uint64_t{1} << slot);
+      while (timeout != nullptr) {
+        WheelTimeout* next = timeout->next_;
+        timeout->next_ = nullptr;
+        timeout->prev_next_ = nullptr;
+        Insert(*timeout);
+        timeout = next;
+      }
+    }
+
+    int slot = current_tick_ & (kSlotsPerLevel - 1);
+    RTC_DCHECK(expiring_ == nullptr);
+    expiring_ = slots_[0][slot];
+    slots_[0][slot] = nullptr;
+    occupied_[0] &= ~(uint64_t{1} << slot);
+    if (expiring_ != nullptr) {
+      expiring_->prev_next_ = &expiring_;
+    }
+
+    // The expired timeouts are unlinked one at a time, as `on_expired_` may
+    // stop, restart or delete any timeout, including the ones in `expiring_`.
+    while (expiring_ != nullptr) {
+      WheelTimeout& timeout = *expiring_;
+      Unlink(timeout);
+      if (timeout.expiration_tick_ > current_tick_) {
+        // Was beyond the span of the wheel when inserted.
+        Insert(timeout);
+        continue;
+      }
+      --num_running_;
+      if (timeout.precision_ == webrtc::TaskQueueBase::DelayPrecision::kHigh) {
+        --num_running_high_precision_;
+      }
+      RTC_DLOG(LS_VERBOSE) << "Timout triggered: "
+                           << timeout.timeout_id_.value();
+      timeout.on_expired_(timeout.timeout_id_);
+    }
+  }
+  // There are no events until after `tick`, so the wheel can skip ahead.
+  current_tick_ = std::max(current_tick_, tick);
+  is_advancing_ = false;
+}
+
+void TimerWheel::ScheduleTick(int64_t tick) {
+  if (tick >= posted_tick_) {
+    // The already posted task will run in time.
+    return;
+  }
+
+  if (posted_tick_ != kNoTick) {
+    RTC_DLOG(LS_VERBOSE) << "Next tick is earlier than scheduled - "
+                            "ghosting old delayed task.";
+    pending_task_safety_flag_->SetNotAlive();
+    pending_task_safety_flag_ = webrtc::PendingTaskSafetyFlag::Create();
+  }
+
+  posted_tick_ = tick;
+  int64_t delay_ms = std::max<int64_t>(tick * *resolution_ - *get_time_(), 0);
+  task_queue_.PostDelayedTaskWithPrecision(
+      num_running_high_precision_ > 0
+          ? webrtc::TaskQueueBase::DelayPrecision::kHigh
+          : webrtc::TaskQueueBase::DelayPrecision::kLow,
+      webrtc::SafeTask(pending_task_safety_flag_, [this]() { OnTick(); }),
+      webrtc::TimeDelta::Millis(delay_ms));
+}
+
+void TimerWheel::OnTick() {
+  RTC_DCHECK_RUN_ON(&thread_checker_);
+  RTC_DCHECK(posted_tick_ != kNoTick);
+  posted_tick_ = kNoTick;
+  AdvanceTo(TimeToTick(get_time_()));
+  ScheduleTick(NextEventTick());
+}
+
+}  // namespace dcsctp
@@ -0,0 +1,209 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#ifndef NET_DCSCTP_TIMER_TIMER_WHEEL_TIMEOUT_H_
+#define NET_DCSCTP_TIMER_TIMER_WHEEL_TIMEOUT_H_
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include "api/scoped_refptr.h"
+#include "api/sequence_checker.h"
+#include "api/task_queue/pending_task_safety_flag.h"
+#include "api/task_queue/task_queue_base.h"
+#include "net/dcsctp/public/timeout.h"
+#include "net/dcsctp/public/types.h"
+#include "rtc_base/system/no_unique_address.h"
+
+namespace dcsctp {
+
+// A hierarchical timer wheel that stores the running timeouts created by one
+// or several `TimerWheelTimeoutFactory`, and which has at most one delayed
+// task posted to the `task_queue` at any time. That task fires when the wheel
+// next has to be advanced - either because a timeout expires, or because the
+// timeouts in a slot of a coarser level must be moved down to a finer one.
+//
+// Starting, stopping and restarting a timeout are O(1) and don't interact with
+// the task queue, unless the timeout is due before the already posted task.
+// When a wheel is shared by many sockets, which is typical on a server, the
+// number of delayed tasks posted doesn't scale with the number of sockets, as
+// it would with one `TaskQueueTimeoutFactory` per socket.
+//
+// The wheel advances in ticks of `resolution`. A timeout expires on the first
+// tick at or after its expiration time, so it may trigger up to `resolution`
+// later than requested, but never earlier.
+//
+// This class must outlive all factories using it. It's not thread safe, and
+// must only be used on `task_queue`.
+class TimerWheel {
+ public:
+  static constexpr DurationMs kDefaultResolution = DurationMs(10);
+
+  // The `get_time` function must return the current time, relative to any
+  // epoch.
+  TimerWheel(webrtc::TaskQueueBase& task_queue,
+             std::function<TimeMs()> get_time,
+             DurationMs resolution = kDefaultResolution);
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+  ~TimerWheel();
+
+ private:
+  friend class TimerWheelTimeoutFactory;
+
+  // The wheel has `kLevels` levels of `kSlotsPerLevel` slots each. A slot in
+  // level N spans kSlotsPerLevel^N ticks. Timeouts further away than the wheel
+  // spans are put in the last slot, and re-inserted when it's reached.
+  static constexpr int kSlotBits = 6;
+  static constexpr int kSlotsPerLevel = 1 << kSlotBits;
+  static constexpr int kLevels = 4;
+  static constexpr int64_t kMaxTicks = int64_t{1} << (kSlotBits * kLevels);
+  static constexpr int64_t kNoTick = std::numeric_limits<int64_t>::max();
+
+  class WheelTimeout : public Timeout {
+   public:
+    WheelTimeout(TimerWheel& wheel,
+                 const std::function<void(TimeoutID)>& on_expired,
+                 webrtc::TaskQueueBase::DelayPrecision precision);
+    ~WheelTimeout() override;
+
+    void Start(DurationMs duration_ms, TimeoutID timeout_id) override;
+    void Stop() override;
+    void Restart(DurationMs duration_ms, TimeoutID timeout_id) override;
+
+   private:
+    friend class TimerWheel;
+
+    bool is_linked() const { return prev_next_ != nullptr; }
+
+    TimerWheel& wheel_;
+    // Owned by the factory, which outlives its timeouts.
+    const std::function<void(TimeoutID)>& on_expired_;
+    const webrtc::TaskQueueBase::DelayPrecision precision_;
+    // If the timeout is running, it's linked into a list of timeouts, which is
+    // either a slot in the wheel or the list of timeouts that are about to
+    // expire. `prev_next_` points at the pointer that points at this timeout,
+    // which allows it to be unlinked without knowing the previous timeout.
+    WheelTimeout* next_ = nullptr;
+    WheelTimeout** prev_next_ = nullptr;
+    // The slot that the timeout was last inserted into.
+    uint8_t level_ = 0;
+    uint8_t slot_ = 0;
+    // The tick at which the timeout expires.
+    int64_t expiration_tick_ = 0;
+    // The current timeout ID that will be reported when expired.
+    TimeoutID timeout_id_ = TimeoutID(0);
+  };
+
+  struct Position {
+    int level;
+    int slot;
+    // The tick at which the slot will be processed.
+    int64_t event_tick;
+  };
+
+  void Start(WheelTimeout& timeout, TimeMs expiration);
+  void Stop(WheelTimeout& timeout);
+  void Restart(WheelTimeout& timeout, TimeMs expiration);
+  int64_t ExpirationTick(TimeMs expiration) const;
+  // Returns the slot of the wheel matching `expiration_tick`.
+  Position GetPosition(int64_t expiration_tick) const;
+  // Inserts `timeout` into the slot of the wheel matching its expiration tick,
+  // and returns the tick at which that slot will be processed.
+  int64_t Insert(WheelTimeout& timeout);
+  void Link(WheelTimeout& timeout, const Position& position);
+  void Unlink(WheelTimeout& timeout);
+  // Returns the first tick after `current_tick_` where a slot must be
+  // processed, or `kNoTick` if the wheel is empty.
+  int64_t NextEventTick() const;
+  // Processes all slots up until `tick`, triggering the expired timeouts.
+  void AdvanceTo(int64_t tick);
+  // Ensures that a task is posted to run at `tick`, or earlier.
+  void ScheduleTick(int64_t tick);
+  void OnTick();
+  int64_t TimeToTick(TimeMs time) const { return *time / *resolution_; }
+
+  RTC_NO_UNIQUE_ADDRESS webrtc::SequenceChecker thread_checker_;
+  webrtc::TaskQueueBase& task_queue_;
+  const std::function<TimeMs()> get_time_;
+  const DurationMs resolution_;
+
+  std::array<std::array<WheelTimeout*, kSlotsPerLevel>, kLevels> slots_ = {};
+  // A bit per slot in each level, set if the slot is non-empty.
+  std::array<uint64_t, kLevels> occupied_ = {};
+  // Timeouts that have expired, but for which `on_expired_` hasn't been called
+  // yet.
+  WheelTimeout* expiring_ = nullptr;
+  // The tick up until which all slots have been processed.
+  int64_t current_tick_ = 0;
+  bool is_advancing_ = false;
+  int num_running_ = 0;
+  int num_running_high_precision_ = 0;
+  // The tick for which a delayed task has been posted, or `kNoTick`. The task
+  // is "ghosted" by replacing the safety flag when an earlier one is needed.
+  int64_t posted_tick_ = kNoTick;
+  rtc::scoped_refptr<webrtc::PendingTaskSafetyFlag> pending_task_safety_flag_;
+};
+
+// The TimerWheelTimeoutFactory creates `Timeout` instances, like the
+// `TaskQueueTimeoutFactory`, but which are stored in a `TimerWheel` instead of
+// posting delayed tasks of their own. The wheel can be owned by the factory,
+// or shared with the factories of other sockets on the same task queue.
+//
+// Note that each `DcSctpSocket` must have its own `TimerWheelTimeoutFactory`,
+// as the `TimeoutID` are not unique among sockets.
+//
+// This class must outlive any created Timeout that it has created. Note that
+// the `DcSctpSocket` will ensure that all Timeouts are deleted when the socket
+// is destructed, so this means that this class must outlive the `DcSctpSocket`.
+//
+// This class, and the timeouts created it, are not thread safe.
+class TimerWheelTimeoutFactory {
+ public:
+  // Whenever a timeout expires, the `on_expired` callback will be triggered,
+  // and then the client should provided `timeout_id` to
+  // `DcSctpSocketInterface::HandleTimeout`.
+  TimerWheelTimeoutFactory(TimerWheel& wheel,
+                           std::function<void(TimeoutID timeout_id)> on_expired)
+      : wheel_(wheel), on_expired_(std::move(on_expired)) {}
+
+  // Creates a factory with a wheel of its own. See `TimerWheel` for a
+  // description of the parameters.
+  TimerWheelTimeoutFactory(webrtc::TaskQueueBase& task_queue,
+                           std::function<TimeMs()> get_time,
+                           std::function<void(TimeoutID timeout_id)> on_expired,
+                           DurationMs resolution =
+                               TimerWheel::kDefaultResolution)
+      : owned_wheel_(std::make_unique<TimerWheel>(task_queue,
+                                                  std::move(get_time),
+                                                  resolution)),
+        wheel_(*owned_wheel_),
+        on_expired_(std::move(on_expired)) {}
+
+  // Creates an implementation of `Timeout`. The wheel posts its task with high
+  // precision as long as any high precision timeout is running.
+  std::unique_ptr<Timeout> CreateTimeout(
+      webrtc::TaskQueueBase::DelayPrecision precision =
+          webrtc::TaskQueueBase::DelayPrecision::kLow) {
+    return std::make_unique<TimerWheel::WheelTimeout>(wheel_, on_expired_,
+                                                      precision);
+  }
+
+ private:
+  const std::unique_ptr<TimerWheel> owned_wheel_;
+  TimerWheel& wheel_;
+  const std::function<void(TimeoutID)> on_expired_;
+};
+}  // namespace dcsctp
+
+#endif  // NET_DCSCTP_TIMER_TIMER_WHEEL_TIMEOUT_H_
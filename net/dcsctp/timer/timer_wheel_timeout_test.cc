@@ -0,0 +1,321 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+#include "net/dcsctp/timer/timer_wheel_timeout.h"
+
+#include <memory>
+#include <vector>
+
+#include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/test/mock_task_queue_base.h"
+#include "rtc_base/gunit.h"
+#include "test/gmock.h"
+#include "test/time_controller/simulated_time_controller.h"
+
+namespace dcsctp {
+namespace {
+using ::testing::_;
+using ::testing::MockFunction;
+using ::testing::NiceMock;
+
+class TimerWheelTimeoutTest : public testing::Test {
+ protected:
+  TimerWheelTimeoutTest()
+      : time_controller_(webrtc::Timestamp::Millis(1234)),
+        task_queue_(time_controller_.GetMainThread()),
+        factory_(
+            *task_queue_,
+            [this]() { return Now(); },
+            on_expired_.AsStdFunction(),
+            DurationMs(1)) {}
+
+  TimeMs Now() {
+    return TimeMs(time_controller_.GetClock()->CurrentTime().ms());
+  }
+
+  void AdvanceTime(DurationMs duration) {
+    time_controller_.AdvanceTime(webrtc::TimeDelta::Millis(*duration));
+  }
+
+  MockFunction<void(TimeoutID)> on_expired_;
+  webrtc::GlobalSimulatedTimeController time_controller_;
+
+  rtc::Thread* task_queue_;
+  TimerWheelTimeoutFactory factory_;
+};
+
+TEST_F(TimerWheelTimeoutTest, StartPostsDelayedTask) {
+  std::unique_ptr<Timeout> timeout = factory_.CreateTimeout();
+  timeout->Start(DurationMs(1000), TimeoutID(1));
+
+  EXPECT_CALL(on_expired_, Call).Times(0);
+  AdvanceTime(DurationMs(999));
+
+  EXPECT_CALL(on_expired_, Call(TimeoutID(1)));
+  AdvanceTime(DurationMs(1));
+}
+
+TEST_F(TimerWheelTimeoutTest, StopBeforeExpiringDoesntTrigger) {
+  std::unique_ptr<Timeout> timeout = factory_.CreateTimeout();
+  timeout->Start(DurationMs(1000), TimeoutID(1));
+
+  EXPECT_CALL(on_expired_, Call).Times(0);
+  AdvanceTime(DurationMs(999));
+
+  timeout->Stop();
+
+  AdvanceTime(DurationMs(1));
+  AdvanceTime(DurationMs(1000));
+}
+
+TEST_F(TimerWheelTimeoutTest, RestartPrologingTimeoutDuration) {
+  std::unique_ptr<Timeout> timeout = factory_.CreateTimeout();
+  timeout->Start(DurationMs(1000), TimeoutID(1));
+
+  EXPECT_CALL(on_expired_, Call).Times(0);
+  AdvanceTime(DurationMs(500));
+
+  timeout->Restart(DurationMs(1000), TimeoutID(2));
+
+  AdvanceTime(DurationMs(999));
+
+  EXPECT_CALL(on_expired_, Call(TimeoutID(2)));
+  AdvanceTime(DurationMs(1));
+}
+
+TEST_F(TimerWheelTimeoutTest, RestartWithShorterDurationExpiresWhenExpected) {
+  std::unique_ptr<Timeout> timeout = factory_.CreateTimeout();
+  timeout->Start(DurationMs(1000), TimeoutID(1));
+
+  EXPECT_CALL(on_expired_, Call).Times(0);
+  AdvanceTime(DurationMs(500));
+
+  timeout->Restart(DurationMs(200), TimeoutID(2));
+
+  AdvanceTime(DurationMs(199));
+
+  EXPECT_CALL(on_expired_, Call(TimeoutID(2)));
+  AdvanceTime(DurationMs(1));
+
+  EXPECT_CALL(on_expired_, Call).Times(0);
+  AdvanceTime(DurationMs(1000));
+}
+
+TEST_F(TimerWheelTimeoutTest, KilledBeforeExpired) {
+  std::unique_ptr<Timeout> timeout = factory_.CreateTimeout();
+  timeout->Start(DurationMs(1000), TimeoutID(1));
+
+  EXPECT_CALL(on_expired_, Call).Times(0);
+  AdvanceTime(DurationMs(500));
+
+  timeout = nullptr;
+
+  EXPECT_CALL(on_expired_, Call).Times(0);
+  AdvanceTime(DurationMs(1000));
+}
+
+TEST_F(TimerWheelTimeoutTest, ExpiresTimeoutsInOrder) {
+  // Durations spanning all levels of the wheel.
+  const std::vector<int> kDurationsMs = {
+      1,      63,     64,     65,     300,     4095,    4096,
+      4097,   30000,  262143, 262144, 262145,  3600000, 86400000};
+  std::vector<std::unique_ptr<Timeout>> timeouts;
+  for (size_t i = 0; i < kDurationsMs.size(); ++i) {
+    timeouts.push_back(factory_.CreateTimeout());
+    timeouts.back()->Start(DurationMs(kDurationsMs[i]), TimeoutID(i));
+  }
+
+  int elapsed_ms = 0;
+  for (size_t i = 0; i < kDurationsMs.size(); ++i) {
+    EXPECT_CALL(on_expired_, Call).Times(0);
+    AdvanceTime(DurationMs(kDurationsMs[i] - 1 - elapsed_ms));
+
+    EXPECT_CALL(on_expired_, Call(TimeoutID(i)));
+    AdvanceTime(DurationMs(1));
+    elapsed_ms = kDurationsMs[i];
+  }
+}
+
+TEST_F(TimerWheelTimeoutTest, ExpiresTimeoutBeyondSpanOfWheel) {
+  // With a resolution of 1ms, the wheel spans a bit more than 4.6 hours.
+  std::unique_ptr<Timeout> timeout = factory_.CreateTimeout();
+  timeout->Start(DurationMs(10 * 3600 * 1000), TimeoutID(1));
+
+  EXPECT_CALL(on_expired_, Call).Times(0);
+  AdvanceTime(DurationMs(10 * 3600 * 1000 - 1));
+
+  EXPECT_CALL(on_expired_, Call(TimeoutID(1)));
+  AdvanceTime(DurationMs(1));
+}
+
+TEST_F(TimerWheelTimeoutTest, CanRestartTimeoutWhenExpired) {
+  std::unique_ptr<Timeout> timeout = factory_.CreateTimeout();
+  EXPECT_CALL(on_expired_, Call(TimeoutID(1))).WillOnce([&](TimeoutID) {
+    timeout->Start(DurationMs(100), TimeoutID(2));
+  });
+  timeout->Start(DurationMs(100), TimeoutID(1));
+  AdvanceTime(DurationMs(100));
+
+  EXPECT_CALL(on_expired_, Call).Times(0);
+  AdvanceTime(DurationMs(99));
+
+  EXPECT_CALL(on_expired_, Call(TimeoutID(2)));
+  AdvanceTime(DurationMs(1));
+}
+
+TEST_F(TimerWheelTimeoutTest, CanStopOtherTimeoutExpiringAtSameTime) {
+  std::unique_ptr<Timeout> timeout1 = factory_.CreateTimeout();
+  std::unique_ptr<Timeout> timeout2 = factory_.CreateTimeout();
+  timeout1->Start(DurationMs(100), TimeoutID(1));
+  timeout2->Start(DurationMs(100), TimeoutID(2));
+
+  // Whichever expires first stops the other one.
+  EXPECT_CALL(on_expired_, Call).WillOnce([&](TimeoutID timeout_id) {
+    if (timeout_id == TimeoutID(1)) {
+      timeout2->Stop();
+    } else {
+      timeout1->Stop();
+    }
+  });
+  AdvanceTime(DurationMs(100));
+  AdvanceTime(DurationMs(1000));
+}
+
+TEST_F(TimerWheelTimeoutTest, CanStartTimeoutsAfterBeingIdle) {
+  std::unique_ptr<Timeout> timeout = factory_.CreateTimeout();
+  timeout->Start(DurationMs(10), TimeoutID(1));
+  EXPECT_CALL(on_expired_, Call(TimeoutID(1)));
+  AdvanceTime(DurationMs(10));
+
+  AdvanceTime(DurationMs(123456));
+
+  timeout->Start(DurationMs(10), TimeoutID(2));
+  EXPECT_CALL(on_expired_, Call).Times(0);
+  AdvanceTime(DurationMs(9));
+
+  EXPECT_CALL(on_expired_, Call(TimeoutID(2)));
+  AdvanceTime(DurationMs(1));
+}
+
+TEST_F(TimerWheelTimeoutTest, SharedWheelTriggersTimeoutOfRightFactory) {
+  MockFunction<void(TimeoutID)> on_expired1;
+  MockFunction<void(TimeoutID)> on_expired2;
+  TimerWheel wheel(*task_queue_, [this]() { return Now(); }, DurationMs(1));
+  TimerWheelTimeoutFactory factory1(wheel, on_expired1.AsStdFunction());
+  TimerWheelTimeoutFactory factory2(wheel, on_expired2.AsStdFunction());
+  std::unique_ptr<Timeout> timeout1 = factory1.CreateTimeout();
+  std::unique_ptr<Timeout> timeout2 = factory2.CreateTimeout();
+  timeout1->Start(DurationMs(100), TimeoutID(1));
+  timeout2->Start(DurationMs(200), TimeoutID(1));
+
+  EXPECT_CALL(on_expired1, Call(TimeoutID(1)));
+  EXPECT_CALL(on_expired2, Call).Times(0);
+  AdvanceTime(DurationMs(100));
+
+  EXPECT_CALL(on_expired2, Call(TimeoutID(1)));
+  AdvanceTime(DurationMs(100));
+}
+
+TEST(TimerWheelTimeoutWithResolutionTest, ExpiresOnFirstTickAfterExpiration) {
+  webrtc::GlobalSimulatedTimeController time_controller(
+      webrtc::Timestamp::Millis(1234));
+  MockFunction<void(TimeoutID)> on_expired;
+  TimerWheelTimeoutFactory factory(
+      *time_controller.GetMainThread(),
+      [&]() { return TimeMs(time_controller.GetClock()->CurrentTime().ms()); },
+      on_expired.AsStdFunction(), DurationMs(10));
+
+  // Expires at 1434, which is rounded up to the tick at 1440.
+  std::unique_ptr<Timeout> timeout = factory.CreateTimeout();
+  timeout->Start(DurationMs(200), TimeoutID(1));
+
+  EXPECT_CALL(on_expired, Call).Times(0);
+  time_controller.AdvanceTime(webrtc::TimeDelta::Millis(205));
+
+  EXPECT_CALL(on_expired, Call(TimeoutID(1)));
+  time_controller.AdvanceTime(webrtc::TimeDelta::Millis(1));
+}
+
+TEST(TimerWheelTimeoutWithMockTaskQueueTest, RestartingDoesntPostTasks) {
+  NiceMock<webrtc::MockTaskQueueBase> mock_task_queue;
+  TimeMs now(1337);
+  TimerWheelTimeoutFactory factory(
+      mock_task_queue, [&]() { return now; }, [](TimeoutID timeout_id) {});
+  std::unique_ptr<Timeout> t3_rtx = factory.CreateTimeout();
+  std::unique_ptr<Timeout> delayed_ack = factory.CreateTimeout();
+
+  // One task for each timer when first started, as the delayed ack timer
+  // expires before the retransmission timer.
+  EXPECT_CALL(mock_task_queue, PostDelayedTask(_, _)).Times(2);
+  t3_rtx->Start(DurationMs(1000), TimeoutID(1));
+  for (int i = 0; i < 100; ++i) {
+    now += DurationMs(1);
+    t3_rtx->Restart(DurationMs(1000), TimeoutID(1));
+    delayed_ack->Start(DurationMs(200), TimeoutID(2));
+    delayed_ack->Stop();
+  }
+  t3_rtx->Stop();
+}
+
+TEST(TimerWheelTimeoutWithMockTaskQueueTest, PostsAgainForEarlierTimeout) {
+  NiceMock<webrtc::MockTaskQueueBase> mock_task_queue;
+  TimerWheelTimeoutFactory factory(
+      mock_task_queue, []() { return TimeMs(1337); },
+      [](TimeoutID timeout_id) {});
+  std::unique_ptr<Timeout> heartbeat = factory.CreateTimeout();
+  std::unique_ptr<Timeout> t3_rtx = factory.CreateTimeout();
+
+  EXPECT_CALL(mock_task_queue, PostDelayedTask(_, _)).Times(2);
+  heartbeat->Start(DurationMs(30000), TimeoutID(1));
+  t3_rtx->Start(DurationMs(1000), TimeoutID(2));
+  heartbeat->Stop();
+  t3_rtx->Stop();
+}
+
+TEST(TimerWheelTimeoutWithMockTaskQueueTest, SharedWheelPostsOneTask) {
+  NiceMock<webrtc::MockTaskQueueBase> mock_task_queue;
+  TimerWheel wheel(mock_task_queue, []() { return TimeMs(1337); });
+  TimerWheelTimeoutFactory factory1(wheel, [](TimeoutID timeout_id) {});
+  TimerWheelTimeoutFactory factory2(wheel, [](TimeoutID timeout_id) {});
+  std::unique_ptr<Timeout> timeout1 = factory1.CreateTimeout();
+  std::unique_ptr<Timeout> timeout2 = factory2.CreateTimeout();
+
+  EXPECT_CALL(mock_task_queue, PostDelayedTask(_, _)).Times(1);
+  timeout1->Start(DurationMs(1000), TimeoutID(1));
+  timeout2->Start(DurationMs(1000), TimeoutID(1));
+  timeout1->Stop();
+  timeout2->Stop();
+}
+
+TEST(TimerWheelTimeoutWithMockTaskQueueTest, TimeoutPrecisionIsLowByDefault) {
+  NiceMock<webrtc::MockTaskQueueBase> mock_task_queue;
+  EXPECT_CALL(mock_task_queue, PostDelayedTask(_, _));
+  TimerWheelTimeoutFactory factory(
+      mock_task_queue, []() { return TimeMs(1337); },
+      [](TimeoutID timeout_id) {});
+  std::unique_ptr<Timeout> timeout = factory.CreateTimeout();
+  timeout->Start(DurationMs(1), TimeoutID(1));
+  timeout->Stop();
+}
+
+TEST(TimerWheelTimeoutWithMockTaskQueueTest,
+     UsesHighPrecisionWhenHighPrecisionTimeoutIsRunning) {
+  NiceMock<webrtc::MockTaskQueueBase> mock_task_queue;
+  EXPECT_CALL(mock_task_queue, PostDelayedHighPrecisionTask(_, _));
+  TimerWheelTimeoutFactory factory(
+      mock_task_queue, []() { return TimeMs(1337); },
+      [](TimeoutID timeout_id) {});
+  std::unique_ptr<Timeout> timeout =
+      factory.CreateTimeout(webrtc::TaskQueueBase::DelayPrecision::kHigh);
+  timeout->Start(DurationMs(1), TimeoutID(1));
+  timeout->Stop();
+}
+
+}  // namespace
+}  // namespace dcsctp
@@ -10,6 +10,8 @@
 #include "net/dcsctp/tx/outstanding_data.h"
 
 #include <algorithm>
+#include <deque>
+#include <map>
 #include <set>
 #include <utility>
 #include <vector>
@@ -81,19 +83,19 @@ bool OutstandingData::IsConsistent() const {
                                       to_be_fast_retransmitted_.end());
 
   std::set<UnwrappedTSN> actual_combined_to_be_retransmitted;
-  for (const auto& [tsn, item] : outstanding_data_) {
+  for (size_t i = 0; i < outstanding_data_.size(); ++i) {
+    const Item& item = outstanding_data_[i];
     if (item.is_outstanding()) {
       actual_outstanding_bytes += GetSerializedChunkSize(item.data());
       ++actual_outstanding_items;
     }
 
     if (item.should_be_retransmitted()) {
-      actual_combined_to_be_retransmitted.insert(tsn);
+      actual_combined_to_be_retransmitted.insert(GetTsn(i));
     }
   }
 
-  if (outstanding_data_.empty() &&
-      next_tsn_ != last_cumulative_tsn_ack_.next_value()) {
+  if (GetTsn(outstanding_data_.size()) != next_tsn_) {
     return false;
   }
 
@@ -103,22 +105,22 @@ bool OutstandingData::IsConsistent() const {
 }
 
 void OutstandingData::AckChunk(AckInfo& ack_info,
-                               std::map<UnwrappedTSN, Item>::iterator iter) {
-  if (!iter->second.is_acked()) {
-    size_t serialized_size = GetSerializedChunkSize(iter->second.data());
+                               UnwrappedTSN tsn,
+                               Item& item) {
+  if (!item.is_acked()) {
+    size_t serialized_size = GetSerializedChunkSize(item.data());
     ack_info.bytes_acked += serialized_size;
-    if (iter->second.is_outstanding()) {
+    if (item.is_outstanding()) {
       outstanding_bytes_ -= serialized_size;
       --outstanding_items_;
     }
-    if (iter->second.should_be_retransmitted()) {
-      RTC_DCHECK(to_be_fast_retransmitted_.find(iter->first) ==
+    if (item.should_be_retransmitted()) {
+      RTC_DCHECK(to_be_fast_retransmitted_.find(tsn) ==
                  to_be_fast_retransmitted_.end());
-      to_be_retransmitted_.erase(iter->first);
+      to_be_retransmitted_.erase(tsn);
     }
-    iter->second.Ack();
-    ack_info.highest_tsn_acked =
-        std::max(ack_info.highest_tsn_acked, iter->first);
+    item.Ack();
+    ack_info.highest_tsn_acked = std::max(ack_info.highest_tsn_acked, tsn);
   }
 }
 
@@ -143,22 +145,27 @@ OutstandingData::AckInfo OutstandingData::HandleSack(
 
 void OutstandingData::RemoveAcked(UnwrappedTSN cumulative_tsn_ack,
                                   AckInfo& ack_info) {
-  auto first_unacked = outstanding_data_.upper_bound(cumulative_tsn_ack);
-
-  for (auto iter = outstanding_data_.begin(); iter != first_unacked; ++iter) {
-    AckChunk(ack_info, iter);
-    if (iter->second.lifecycle_id().IsSet()) {
-      RTC_DCHECK(iter->second.data().is_end);
-      if (iter->second.is_abandoned()) {
-        ack_info.abandoned_lifecycle_ids.push_back(iter->second.lifecycle_id());
+  RTC_DCHECK(cumulative_tsn_ack >= last_cumulative_tsn_ack_);
+  RTC_DCHECK(cumulative_tsn_ack < next_tsn_);
+  size_t num_acked = cumulative_tsn_ack > last_cumulative_tsn_ack_
+                         ? std::min(GetIndex(cumulative_tsn_ack) + 1,
+                                    outstanding_data_.size())
+                         : 0;
+
+  for (size_t i = 0; i < num_acked; ++i) {
+    Item& item = outstanding_data_.front();
+    AckChunk(ack_info, GetTsn(0), item);
+    if (item.lifecycle_id().IsSet()) {
+      RTC_DCHECK(item.data().is_end);
+      if (item.is_abandoned()) {
+        ack_info.abandoned_lifecycle_ids.push_back(item.lifecycle_id());
       } else {
-        ack_info.acked_lifecycle_ids.push_back(iter->second.lifecycle_id());
+        ack_info.acked_lifecycle_ids.push_back(item.lifecycle_id());
       }
     }
+    outstanding_data_.pop_front();
+    last_cumulative_tsn_ack_.Increment();
   }
-
-  outstanding_data_.erase(outstanding_data_.begin(), first_unacked);
-  last_cumulative_tsn_ack_ = cumulative_tsn_ack;
 }
 
 void OutstandingData::AckGapBlocks(
@@ -170,13 +177,16 @@ void OutstandingData::AckGapBlocks(
   // SACK chunk as advisory.". Note that when NR-SACK is supported, this can be
   // handled differently.
 
+  // As the cumulative TSN ack has been processed, the block offsets are
+  // relative to the TSN preceding the first outstanding chunk, and map
+  // directly to index ranges.
+  RTC_DCHECK(cumulative_tsn_ack == last_cumulative_tsn_ack_);
   for (auto& block : gap_ack_blocks) {
-    auto start = outstanding_data_.lower_bound(
-        UnwrappedTSN::AddTo(cumulative_tsn_ack, block.start));
-    auto end = outstanding_data_.upper_bound(
-        UnwrappedTSN::AddTo(cumulative_tsn_ack, block.end));
-    for (auto iter = start; iter != end; ++iter) {
-      AckChunk(ack_info, iter);
+    size_t start = std::min<size_t>(std::max(block.start, uint16_t{1}) - 1,
+                                    outstanding_data_.size());
+    size_t end = std::min<size_t>(block.end, outstanding_data_.size());
+    for (size_t i = start; i < end; ++i) {
+      AckChunk(ack_info, GetTsn(i), outstanding_data_[i]);
     }
   }
 }
@@ -207,19 +217,22 @@ void OutstandingData::NackBetweenAckBlocks(
         gap_ack_blocks.empty() ? 0 : gap_ack_blocks.rbegin()->end);
   }
 
-  UnwrappedTSN prev_block_last_acked = cumulative_tsn_ack;
+  // The chunks between the blocks, at indexes [prev_block_end, block_start),
+  // and which are not after `max_tsn_to_nack`, will be nacked.
+  size_t nack_end =
+      max_tsn_to_nack > cumulative_tsn_ack
+          ? std::min(GetIndex(max_tsn_to_nack) + 1, outstanding_data_.size())
+          : 0;
+  size_t prev_block_end = 0;
   for (auto& block : gap_ack_blocks) {
-    UnwrappedTSN cur_block_first_acked =
-        UnwrappedTSN::AddTo(cumulative_tsn_ack, block.start);
-    for (auto iter = outstanding_data_.upper_bound(prev_block_last_acked);
-         iter != outstanding_data_.lower_bound(cur_block_first_acked); ++iter) {
-      if (iter->first <= max_tsn_to_nack) {
-        ack_info.has_packet_loss |=
-            NackItem(iter->first, iter->second, /*retransmit_now=*/false,
-                     /*do_fast_retransmit=*/!is_in_fast_recovery);
-      }
+    size_t block_start = std::min<size_t>(
+        std::max(block.start, uint16_t{1}) - 1, nack_end);
+    for (size_t i = prev_block_end; i < block_start; ++i) {
+      ack_info.has_packet_loss |=
+          NackItem(GetTsn(i), outstanding_data_[i], /*retransmit_now=*/false,
+                   /*do_fast_retransmit=*/!is_in_fast_recovery);
     }
-    prev_block_last_acked = UnwrappedTSN::AddTo(cumulative_tsn_ack, block.end);
+    prev_block_end = std::max<size_t>(prev_block_end, block.end);
   }
 
   // Note that packets are not NACKED which are above the highest gap-ack-block
@@ -273,14 +286,9 @@ void OutstandingData::AbandonAllFor(const Item& item) {
                      item.data().message_id, item.data().fsn, item.data().ppid,
                      std::vector<uint8_t>(), Data::IsBeginning(false),
                      Data::IsEnd(true), item.data().is_unordered);
-    Item& added_item =
-        outstanding_data_
-            .emplace(std::piecewise_construct, std::forward_as_tuple(tsn),
-                     std::forward_as_tuple(std::move(message_end), TimeMs(0),
-                                           MaxRetransmits::NoLimit(),
-                                           TimeMs::InfiniteFuture(),
-                                           LifecycleId::NotSet()))
-            .first->second;
+    Item& added_item = outstanding_data_.emplace_back(
+        std::move(message_end), TimeMs(0), MaxRetransmits::NoLimit(),
+        TimeMs::InfiniteFuture(), LifecycleId::NotSet());
     // The added chunk shouldn't be included in `outstanding_bytes`, so set it
     // as acked.
     added_item.Ack();
@@ -288,11 +296,13 @@ void OutstandingData::AbandonAllFor(const Item& item) {
                          << *tsn.Wrap();
   }
 
-  for (auto& [tsn, other] : outstanding_data_) {
+  for (size_t i = 0; i < outstanding_data_.size(); ++i) {
+    Item& other = outstanding_data_[i];
     if (!other.is_abandoned() &&
         other.data().stream_id == item.data().stream_id &&
         other.data().is_unordered == item.data().is_unordered &&
         other.data().message_id == item.data().message_id) {
+      UnwrappedTSN tsn = GetTsn(i);
       RTC_DLOG(LS_VERBOSE) << "Marking chunk " << *tsn.Wrap()
                            << " as abandoned";
       if (other.should_be_retransmitted()) {
@@ -311,9 +321,8 @@ std::vector<std::pair<TSN, Data>> OutstandingData::ExtractChunksThatCanFit(
 
   for (auto it = chunks.begin(); it != chunks.end();) {
     UnwrappedTSN tsn = *it;
-    auto elem = outstanding_data_.find(tsn);
-    RTC_DCHECK(elem != outstanding_data_.end());
-    Item& item = elem->second;
+    RTC_DCHECK(tsn > last_cumulative_tsn_ack_ && tsn < next_tsn_);
+    Item& item = GetItem(tsn);
     RTC_DCHECK(item.should_be_retransmitted());
     RTC_DCHECK(!item.is_outstanding());
     RTC_DCHECK(!item.is_abandoned());
@@ -367,14 +376,15 @@ std::vector<std::pair<TSN, Data>> OutstandingData::GetChunksToBeRetransmitted(
 }
 
 void OutstandingData::ExpireOutstandingChunks(TimeMs now) {
-  for (const auto& [tsn, item] : outstanding_data_) {
+  for (size_t i = 0; i < outstanding_data_.size(); ++i) {
+    const Item& item = outstanding_data_[i];
     // Chunks that are nacked can be expired. Care should be taken not to expire
     // unacked (in-flight) chunks as they might have been received, but the SACK
     // is either delayed or in-flight and may be received later.
     if (item.is_abandoned()) {
       // Already abandoned.
     } else if (item.is_nacked() && item.has_expired(now)) {
-      RTC_DLOG(LS_VERBOSE) << "Marking nacked chunk " << *tsn.Wrap()
+      RTC_DLOG(LS_VERBOSE) << "Marking nacked chunk " << *GetTsn(i).Wrap()
                            << " and message " << *item.data().message_id
                            << " as expired";
       AbandonAllFor(item);
@@ -387,8 +397,8 @@ void OutstandingData::ExpireOutstandingChunks(TimeMs now) {
 }
 
 UnwrappedTSN OutstandingData::highest_outstanding_tsn() const {
-  return outstanding_data_.empty() ? last_cumulative_tsn_ack_
-                                   : outstanding_data_.rbegin()->first;
+  return UnwrappedTSN::AddTo(last_cumulative_tsn_ack_,
+                             static_cast<int>(outstanding_data_.size()));
 }
 
 absl::optional<UnwrappedTSN> OutstandingData::Insert(
@@ -404,20 +414,17 @@ absl::optional<UnwrappedTSN> OutstandingData::Insert(
   size_t chunk_size = GetSerializedChunkSize(data);
   outstanding_bytes_ += chunk_size;
   ++outstanding_items_;
-  auto it = outstanding_data_
-                .emplace(std::piecewise_construct, std::forward_as_tuple(tsn),
-                         std::forward_as_tuple(data.Clone(), time_sent,
-                                               max_retransmissions, expires_at,
-                                               lifecycle_id))
-                .first;
-
-  if (it->second.has_expired(time_sent)) {
+  Item& item = outstanding_data_.emplace_back(data.Clone(), time_sent,
+                                              max_retransmissions, expires_at,
+                                              lifecycle_id);
+
+  if (item.has_expired(time_sent)) {
     // No need to send it - it was expired when it was in the send
     // queue.
-    RTC_DLOG(LS_VERBOSE) << "Marking freshly produced chunk "
-                         << *it->first.Wrap() << " and message "
-                         << *it->second.data().message_id << " as expired";
-    AbandonAllFor(it->second);
+    RTC_DLOG(LS_VERBOSE) << "Marking freshly produced chunk " << *tsn.Wrap()
+                         << " and message " << *item.data().message_id
+                         << " as expired";
+    AbandonAllFor(item);
     RTC_DCHECK(IsConsistent());
     return absl::nullopt;
   }
@@ -427,9 +434,10 @@ absl::optional<UnwrappedTSN> OutstandingData::Insert(
 }
 
 void OutstandingData::NackAll() {
-  for (auto& [tsn, item] : outstanding_data_) {
+  for (size_t i = 0; i < outstanding_data_.size(); ++i) {
+    Item& item = outstanding_data_[i];
     if (!item.is_acked()) {
-      NackItem(tsn, item, /*retransmit_now=*/true,
+      NackItem(GetTsn(i), item, /*retransmit_now=*/true,
                /*do_fast_retransmit=*/false);
     }
   }
@@ -438,14 +446,14 @@ void OutstandingData::NackAll() {
 
 absl::optional<DurationMs> OutstandingData::MeasureRTT(TimeMs now,
                                                        UnwrappedTSN tsn) const {
-  auto it = outstanding_data_.find(tsn);
-  if (it != outstanding_data_.end() && !it->second.has_been_retransmitted()) {
+  if (tsn > last_cumulative_tsn_ack_ && tsn < next_tsn_ &&
+      !outstanding_data_[GetIndex(tsn)].has_been_retransmitted()) {
     // https://tools.ietf.org/html/rfc4960#section-6.3.1
     // "Karn's algorithm: RTT measurements MUST NOT be made using
     // packets that were retransmitted (and thus for which it is ambiguous
     // whether the reply was for the first instance of the chunk or for a
     // later instance)"
-    return now - it->second.time_sent();
+    return now - outstanding_data_[GetIndex(tsn)].time_sent();
   }
   return absl::nullopt;
 }
@@ -454,7 +462,8 @@ std::vector<std::pair<TSN, OutstandingData::State>>
 OutstandingData::GetChunkStatesForTesting() const {
   std::vector<std::pair<TSN, State>> states;
   states.emplace_back(last_cumulative_tsn_ack_.Wrap(), State::kAcked);
-  for (const auto& [tsn, item] : outstanding_data_) {
+  for (size_t i = 0; i < outstanding_data_.size(); ++i) {
+    const Item& item = outstanding_data_[i];
     State state;
     if (item.is_abandoned()) {
       state = State::kAbandoned;
@@ -468,29 +477,24 @@ OutstandingData::GetChunkStatesForTesting() const {
       state = State::kNacked;
     }
 
-    states.emplace_back(tsn.Wrap(), state);
+    states.emplace_back(GetTsn(i).Wrap(), state);
   }
   return states;
 }
 
 bool OutstandingData::ShouldSendForwardTsn() const {
-  if (!outstanding_data_.empty()) {
-    auto it = outstanding_data_.begin();
-    return it->first == last_cumulative_tsn_ack_.next_value() &&
-           it->second.is_abandoned();
-  }
-  return false;
+  return !outstanding_data_.empty() && outstanding_data_.front().is_abandoned();
 }
 
 ForwardTsnChunk OutstandingData::CreateForwardTsn() const {
   std::map<StreamID, SSN> skipped_per_ordered_stream;
   UnwrappedTSN new_cumulative_ack = last_cumulative_tsn_ack_;
 
-  for (const auto& [tsn, item] : outstanding_data_) {
-    if ((tsn != new_cumulative_ack.next_value()) || !item.is_abandoned()) {
+  for (const Item& item : outstanding_data_) {
+    if (!item.is_abandoned()) {
       break;
     }
-    new_cumulative_ack = tsn;
+    new_cumulative_ack.Increment();
     if (!item.data().is_unordered &&
         item.data().ssn > skipped_per_ordered_stream[item.data().stream_id]) {
       skipped_per_ordered_stream[item.data().stream_id] = item.data().ssn;
@@ -509,11 +513,11 @@ IForwardTsnChunk OutstandingData::CreateIForwardTsn() const {
   std::map<std::pair<IsUnordered, StreamID>, MID> skipped_per_stream;
   UnwrappedTSN new_cumulative_ack = last_cumulative_tsn_ack_;
 
-  for (const auto& [tsn, item] : outstanding_data_) {
-    if ((tsn != new_cumulative_ack.next_value()) || !item.is_abandoned()) {
+  for (const Item& item : outstanding_data_) {
+    if (!item.is_abandoned()) {
       break;
     }
-    new_cumulative_ack = tsn;
+    new_cumulative_ack.Increment();
     std::pair<IsUnordered, StreamID> stream_id =
         std::make_pair(item.data().is_unordered, item.data().stream_id);
 
@@ -10,7 +10,7 @@
 #ifndef NET_DCSCTP_TX_OUTSTANDING_DATA_H_
 #define NET_DCSCTP_TX_OUTSTANDING_DATA_H_
 
-#include <map>
+#include <deque>
 #include <set>
 #include <utility>
 #include <vector>
@@ -22,6 +22,7 @@
 #include "net/dcsctp/packet/chunk/sack_chunk.h"
 #include "net/dcsctp/packet/data.h"
 #include "net/dcsctp/public/types.h"
+#include "rtc_base/checks.h"
 
 namespace dcsctp {
 
@@ -298,9 +299,9 @@ class OutstandingData {
       bool is_in_fast_recovery,
       OutstandingData::AckInfo& ack_info);
 
-  // Process the acknowledgement of the chunk referenced by `iter` and updates
+  // Process the acknowledgement of the chunk `item`, with `tsn`, and updates
   // state in `ack_info` and the object's state.
-  void AckChunk(AckInfo& ack_info, std::map<UnwrappedTSN, Item>::iterator iter);
+  void AckChunk(AckInfo& ack_info, UnwrappedTSN tsn, Item& item);
 
   // Helper method to process an incoming nack of an item and perform the
   // correct operations given the action indicated when nacking an item (e.g.
@@ -324,6 +325,21 @@ class OutstandingData {
       std::set<UnwrappedTSN>& chunks,
       size_t max_size);
 
+  // Returns the index in `outstanding_data_` of `tsn`, which may be past the
+  // end if the chunk hasn't been sent.
+  size_t GetIndex(UnwrappedTSN tsn) const {
+    RTC_DCHECK(tsn > last_cumulative_tsn_ack_);
+    return UnwrappedTSN::Difference(tsn, last_cumulative_tsn_ack_) - 1;
+  }
+
+  // Returns the TSN of the chunk at `index` in `outstanding_data_`.
+  UnwrappedTSN GetTsn(size_t index) const {
+    return UnwrappedTSN::AddTo(last_cumulative_tsn_ack_,
+                               static_cast<int>(index) + 1);
+  }
+
+  Item& GetItem(UnwrappedTSN tsn) { return outstanding_data_[GetIndex(tsn)]; }
+
   bool IsConsistent() const;
 
   // The size of the data chunk (DATA/I-DATA) header that is used.
@@ -335,7 +351,14 @@ class OutstandingData {
   // Callback when to discard items from the send queue.
   std::function<bool(IsUnordered, StreamID, MID)> discard_from_send_queue_;
 
-  std::map<UnwrappedTSN, Item> outstanding_data_;
+  // All chunks that have been sent, and which are not yet acked by the
+  // cumulative TSN ack. As TSNs are allocated sequentially, this is indexed by
+  // the TSN, where the first item has the TSN following
+  // `last_cumulative_tsn_ack_` and the last item has the TSN preceding
+  // `next_tsn_`. Chunks are added to the back and removed from the front, and
+  // as a deque never moves its elements, references to items stay valid when
+  // chunks are added.
+  std::deque<Item> outstanding_data_;
   // The number of bytes that are in-flight (sent but not yet acked or nacked).
   size_t outstanding_bytes_ = 0;
   // The number of DATA chunks that are in-flight (sent but not yet acked or
@@ -64,6 +64,7 @@ class FakePacketTransport : public PacketTransportInternal {
       return -1;
     }
     CopyOnWriteBuffer packet(data, len);
+    last_sent_packet_options_ = options;
     SendPacketInternal(packet);
 
     SentPacket sent_packet(options.packet_id, TimeMillis());
@@ -89,6 +90,9 @@ class FakePacketTransport : public PacketTransportInternal {
   void SetError(int error) { error_ = error; }
 
   const CopyOnWriteBuffer* last_sent_packet() { return &last_sent_packet_; }
+  const PacketOptions& last_sent_packet_options() const {
+    return last_sent_packet_options_;
+  }
 
   absl::optional<NetworkRoute> network_route() const override {
     return network_route_;
@@ -127,6 +131,7 @@ class FakePacketTransport : public PacketTransportInternal {
   }
 
   CopyOnWriteBuffer last_sent_packet_;
+  PacketOptions last_sent_packet_options_;
   std::string transport_name_;
   FakePacketTransport* dest_ = nullptr;
   bool writable_ = false;
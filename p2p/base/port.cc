@@ -222,6 +222,7 @@ void Port::SetIceParameters(int component,
   component_ = component;
   ice_username_fragment_ = std::string(username_fragment);
   password_ = std::string(password);
+  password_hmac_.reset();
   for (Candidate& c : candidates_) {
     c.set_component(component);
     c.set_username(username_fragment);
@@ -485,7 +486,7 @@ bool Port::GetStunMessage(const char* data,
     }
 
     // If ICE, and the MESSAGE-INTEGRITY is bad, fail with a 401 Unauthorized
-    if (stun_msg->ValidateMessageIntegrity(password_) !=
+    if (ValidateMessageIntegrity(data, size) !=
         StunMessage::IntegrityStatus::kIntegrityOk) {
       RTC_LOG(LS_ERROR) << ToString() << ": Received "
                         << StunMethodToString(stun_msg->type())
@@ -552,7 +553,7 @@ bool Port::GetStunMessage(const char* data,
     // No stun attributes will be verified, if it's stun indication message.
     // Returning from end of the this method.
   } else if (stun_msg->type() == GOOG_PING_REQUEST) {
-    if (stun_msg->ValidateMessageIntegrity(password_) !=
+    if (ValidateMessageIntegrity(data, size) !=
         StunMessage::IntegrityStatus::kIntegrityOk) {
       RTC_LOG(LS_ERROR) << ToString() << ": Received "
                         << StunMethodToString(stun_msg->type())
@@ -586,6 +587,21 @@ bool Port::GetStunMessage(const char* data,
   return true;
 }
 
+StunMessage::IntegrityStatus Port::ValidateMessageIntegrity(const char* data,
+                                                           size_t size) {
+  // Connectivity checks arrive at a high rate, so hash the message in place
+  // rather than copying it, and reuse the HMAC key schedule.
+  StunMessageView view;
+  if (!view.Parse(data, size)) {
+    return StunMessage::IntegrityStatus::kIntegrityBad;
+  }
+  if (!password_hmac_) {
+    password_hmac_ =
+        std::make_unique<rtc::OpenSSLHmac>(rtc::DIGEST_SHA_1, password_);
+  }
+  return view.ValidateMessageIntegrity(*password_hmac_);
+}
+
 bool Port::IsCompatibleAddress(const rtc::SocketAddress& addr) {
   // Get a representative IP for the Network this port is configured to use.
   rtc::IPAddress ip = network_->GetBestIP();
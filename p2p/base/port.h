@@ -41,6 +41,7 @@
 #include "rtc_base/memory/always_valid_pointer.h"
 #include "rtc_base/net_helper.h"
 #include "rtc_base/network.h"
+#include "rtc_base/openssl_digest.h"
 #include "rtc_base/proxy_info.h"
 #include "rtc_base/rate_tracker.h"
 #include "rtc_base/socket_address.h"
@@ -483,6 +484,11 @@ class Port : public PortInterface,
 
   void OnNetworkTypeChanged(const rtc::Network* network);
 
+  // Validates the MESSAGE-INTEGRITY of the STUN message in `data` with
+  // `password_`, in place and with an HMAC that is keyed once per password.
+  StunMessage::IntegrityStatus ValidateMessageIntegrity(const char* data,
+                                                        size_t size);
+
   rtc::Thread* const thread_;
   rtc::PacketSocketFactory* const factory_;
   std::string type_;
@@ -503,6 +509,8 @@ class Port : public PortInterface,
   // username_fragment().
   std::string ice_username_fragment_;
   std::string password_;
+  // HMAC keyed with `password_`, created on first use.
+  std::unique_ptr<rtc::OpenSSLHmac> password_hmac_;
   std::vector<Candidate> candidates_ RTC_GUARDED_BY(thread_);
   AddressMap connections_;
   int timeout_delay_;
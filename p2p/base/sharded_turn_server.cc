@@ -0,0 +1,109 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/sharded_turn_server.h"
+
+#include <string>
+
+#include "p2p/base/basic_packet_socket_factory.h"
+#include "rtc_base/async_udp_socket.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/location.h"
+#include "rtc_base/logging.h"
+#include "rtc_base/socket.h"
+
+namespace cricket {
+namespace {
+
+// Number of datagrams each shard reads from its internal socket per wakeup.
+constexpr size_t kMaxDatagramsPerRead = 16;
+
+}  // namespace
+
+ShardedTurnServer::ShardedTurnServer(size_t num_shards) {
+  RTC_DCHECK_GT(num_shards, 0);
+  shards_.resize(num_shards);
+  for (size_t i = 0; i < num_shards; ++i) {
+    Shard& shard = shards_[i];
+    shard.thread = rtc::Thread::CreateWithSocketServer();
+    shard.thread->SetName("TurnShard" + std::to_string(i), nullptr);
+    shard.thread->Start();
+    shard.thread->Invoke<void>(RTC_FROM_HERE, [&shard] {
+      shard.server = std::make_unique<TurnServer>(shard.thread.get());
+    });
+  }
+}
+
+ShardedTurnServer::~ShardedTurnServer() {
+  for (Shard& shard : shards_) {
+    shard.thread->Invoke<void>(RTC_FROM_HERE,
+                               [&shard] { shard.server = nullptr; });
+    shard.thread->Stop();
+  }
+}
+
+void ShardedTurnServer::ConfigureShards(
+    rtc::FunctionView<void(TurnServer& server)> configure) {
+  for (Shard& shard : shards_) {
+    shard.thread->Invoke<void>(
+        RTC_FROM_HERE, [&shard, configure] { configure(*shard.server); });
+  }
+}
+
+rtc::SocketAddress ShardedTurnServer::AddInternalUdpSocket(
+    const rtc::SocketAddress& address) {
+  rtc::SocketAddress bind_address = address;
+  for (Shard& shard : shards_) {
+    bool added = shard.thread->Invoke<bool>(RTC_FROM_HERE, [&] {
+      rtc::Socket* socket = shard.thread->socketserver()->CreateSocket(
+          bind_address.family(), SOCK_DGRAM);
+      if (!socket) {
+        return false;
+      }
+      if (shards_.size() > 1 &&
+          socket->SetOption(rtc::Socket::OPT_REUSEPORT, 1) != 0) {
+        RTC_LOG(LS_ERROR) << "Sharding requires SO_REUSEPORT, error="
+                          << socket->GetError();
+        delete socket;
+        return false;
+      }
+      // Takes ownership of `socket`, and destroys it on failure.
+      rtc::AsyncUDPSocket* udp_socket =
+          rtc::AsyncUDPSocket::Create(socket, bind_address);
+      if (!udp_socket) {
+        return false;
+      }
+      udp_socket->SetBatchedReceive(kMaxDatagramsPerRead);
+      // The remaining shards bind to the port picked for the first one.
+      bind_address = udp_socket->GetLocalAddress();
+      shard.server->AddInternalSocket(udp_socket, PROTO_UDP);
+      return true;
+    });
+    if (!added) {
+      RTC_LOG(LS_ERROR) << "Failed to listen on "
+                        << bind_address.ToSensitiveString();
+      return rtc::SocketAddress();
+    }
+  }
+  return bind_address;
+}
+
+void ShardedTurnServer::SetExternalAddress(const rtc::SocketAddress& address) {
+  for (Shard& shard : shards_) {
+    shard.thread->Invoke<void>(RTC_FROM_HERE, [&shard, &address] {
+      // The server takes ownership of the factory.
+      shard.server->SetExternalSocketFactory(
+          new rtc::BasicPacketSocketFactory(shard.thread->socketserver()),
+          address);
+    });
+  }
+}
+
+}  // namespace cricket
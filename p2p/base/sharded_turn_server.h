@@ -0,0 +1,84 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef P2P_BASE_SHARDED_TURN_SERVER_H_
+#define P2P_BASE_SHARDED_TURN_SERVER_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <vector>
+
+#include "api/function_view.h"
+#include "p2p/base/turn_server.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/thread.h"
+
+namespace cricket {
+
+// Spreads the load of a UDP TURN server over several worker threads.
+//
+// Every shard is a TurnServer running on its own thread, with its own
+// internal socket bound to the shared server address using SO_REUSEPORT. The
+// kernel picks the socket for an incoming packet by hashing its source and
+// destination address, so all packets from a client reach the same shard,
+// which owns that client's allocation and relay socket. Shards share no state
+// and never synchronize on the packet path.
+//
+// Only UDP is sharded; TCP and TLS clients should be served by a separate
+// TurnServer. Since the kernel assigns clients to sockets, sharding requires
+// SO_REUSEPORT; with a single shard the server behaves like a plain
+// TurnServer on a dedicated thread.
+//
+// The methods of this class must be called on the thread that created it.
+class ShardedTurnServer {
+ public:
+  explicit ShardedTurnServer(size_t num_shards);
+  ShardedTurnServer(const ShardedTurnServer&) = delete;
+  ShardedTurnServer& operator=(const ShardedTurnServer&) = delete;
+  ~ShardedTurnServer();
+
+  size_t num_shards() const { return shards_.size(); }
+
+  // Runs `configure` for every shard, on the shard's thread, and waits for it
+  // to finish. Use it to set the realm, auth hook and other TurnServer
+  // settings. Hooks are called on all shard threads concurrently and must
+  // be thread safe.
+  void ConfigureShards(rtc::FunctionView<void(TurnServer& server)> configure);
+
+  // Starts listening for UDP packets from clients on `address`. If the port
+  // of `address` is 0, an ephemeral port is picked and shared by all shards.
+  // Returns the address listened on, or a nil address on failure.
+  rtc::SocketAddress AddInternalUdpSocket(const rtc::SocketAddress& address);
+
+  // Makes every shard create the relay sockets of its allocations on
+  // `address`.
+  void SetExternalAddress(const rtc::SocketAddress& address);
+
+  // For testing only. The TurnServer of a shard may only be used on the
+  // shard's thread.
+  rtc::Thread* shard_thread(size_t index) {
+    return shards_[index].thread.get();
+  }
+  TurnServer* shard(size_t index) { return shards_[index].server.get(); }
+
+ private:
+  struct Shard {
+    std::unique_ptr<rtc::Thread> thread;
+    // Created and destroyed on `thread`.
+    std::unique_ptr<TurnServer> server;
+  };
+
+  std::vector<Shard> shards_;
+};
+
+}  // namespace cricket
+
+#endif  // P2P_BASE_SHARDED_TURN_SERVER_H_
@@ -0,0 +1,156 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "p2p/base/sharded_turn_server.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/memory/memory.h"
+#include "api/transport/stun.h"
+#include "p2p/base/test_turn_server.h"
+#include "rtc_base/async_udp_socket.h"
+#include "rtc_base/byte_buffer.h"
+#include "rtc_base/ip_address.h"
+#include "rtc_base/location.h"
+#include "rtc_base/physical_socket_server.h"
+#include "rtc_base/test_client.h"
+#include "rtc_base/thread.h"
+#include "test/gtest.h"
+
+namespace cricket {
+namespace {
+
+constexpr char kUsername[] = "user";
+
+rtc::SocketAddress LoopbackAddress() {
+  return rtc::SocketAddress(rtc::IPAddress(INADDR_LOOPBACK), 0);
+}
+
+class ShardedTurnServerTest : public ::testing::Test {
+ protected:
+  ShardedTurnServerTest() : main_thread_(&socket_server_) {}
+
+  std::unique_ptr<rtc::TestClient> CreateClient() {
+    return std::make_unique<rtc::TestClient>(absl::WrapUnique(
+        rtc::AsyncUDPSocket::Create(&socket_server_, LoopbackAddress())));
+  }
+
+  void Send(rtc::TestClient& client,
+            const StunMessage& msg,
+            const rtc::SocketAddress& server_address) {
+    rtc::ByteBufferWriter buf;
+    msg.Write(&buf);
+    client.SendTo(buf.Data(), buf.Length(), server_address);
+  }
+
+  std::unique_ptr<TurnMessage> Receive(rtc::TestClient& client) {
+    std::unique_ptr<rtc::TestClient::Packet> packet =
+        client.NextPacket(rtc::TestClient::kTimeoutMs);
+    if (!packet) {
+      return nullptr;
+    }
+    auto msg = std::make_unique<TurnMessage>();
+    rtc::ByteBufferReader buf(packet->buf, packet->size);
+    if (!msg->Read(&buf)) {
+      return nullptr;
+    }
+    return msg;
+  }
+
+  size_t NumAllocations(ShardedTurnServer& server) {
+    size_t num_allocations = 0;
+    for (size_t i = 0; i < server.num_shards(); ++i) {
+      num_allocations += server.shard_thread(i)->Invoke<size_t>(
+          RTC_FROM_HERE, [&] { return server.shard(i)->allocations().size(); });
+    }
+    return num_allocations;
+  }
+
+  rtc::PhysicalSocketServer socket_server_;
+  rtc::AutoSocketServerThread main_thread_;
+};
+
+TEST_F(ShardedTurnServerTest, AllShardsListenOnSameAddress) {
+  ShardedTurnServer server(/*num_shards=*/4);
+  const rtc::SocketAddress server_address =
+      server.AddInternalUdpSocket(LoopbackAddress());
+  ASSERT_FALSE(server_address.IsNil());
+  EXPECT_NE(server_address.port(), 0);
+
+  // Enough clients that, with overwhelming probability, every shard serves at
+  // least one of them. Every client gets an answer from its shard.
+  std::vector<std::unique_ptr<rtc::TestClient>> clients;
+  for (int i = 0; i < 16; ++i) {
+    clients.push_back(CreateClient());
+    StunMessage request(STUN_BINDING_REQUEST);
+    Send(*clients.back(), request, server_address);
+  }
+  for (std::unique_ptr<rtc::TestClient>& client : clients) {
+    std::unique_ptr<TurnMessage> response = Receive(*client);
+    ASSERT_TRUE(response);
+    EXPECT_EQ(response->type(), STUN_BINDING_RESPONSE);
+    const StunAddressAttribute* mapped_address =
+        response->GetAddress(STUN_ATTR_XOR_MAPPED_ADDRESS);
+    ASSERT_TRUE(mapped_address);
+    EXPECT_EQ(mapped_address->GetAddress(), client->address());
+  }
+}
+
+TEST_F(ShardedTurnServerTest, AllocationIsOwnedByOneShard) {
+  TestTurnAuth auth;
+  ShardedTurnServer server(/*num_shards=*/2);
+  server.ConfigureShards([&auth](TurnServer& shard) {
+    shard.set_realm(kTestRealm);
+    shard.set_auth_hook(&auth);
+  });
+  const rtc::SocketAddress server_address =
+      server.AddInternalUdpSocket(LoopbackAddress());
+  ASSERT_FALSE(server_address.IsNil());
+  server.SetExternalAddress(LoopbackAddress());
+  std::unique_ptr<rtc::TestClient> client = CreateClient();
+
+  // The first request is rejected with the nonce to use.
+  TurnMessage request(STUN_ALLOCATE_REQUEST);
+  request.AddAttribute(std::make_unique<StunUInt32Attribute>(
+      STUN_ATTR_REQUESTED_TRANSPORT, IPPROTO_UDP << 24));
+  Send(*client, request, server_address);
+  std::unique_ptr<TurnMessage> response = Receive(*client);
+  ASSERT_TRUE(response);
+  ASSERT_EQ(response->type(), STUN_ALLOCATE_ERROR_RESPONSE);
+  const StunByteStringAttribute* nonce =
+      response->GetByteString(STUN_ATTR_NONCE);
+  ASSERT_TRUE(nonce);
+
+  std::string key;
+  ASSERT_TRUE(
+      ComputeStunCredentialHash(kUsername, kTestRealm, kUsername, &key));
+  TurnMessage authenticated_request(STUN_ALLOCATE_REQUEST);
+  authenticated_request.AddAttribute(std::make_unique<StunUInt32Attribute>(
+      STUN_ATTR_REQUESTED_TRANSPORT, IPPROTO_UDP << 24));
+  authenticated_request.AddAttribute(
+      std::make_unique<StunByteStringAttribute>(STUN_ATTR_USERNAME, kUsername));
+  authenticated_request.AddAttribute(
+      std::make_unique<StunByteStringAttribute>(STUN_ATTR_REALM, kTestRealm));
+  authenticated_request.AddAttribute(std::make_unique<StunByteStringAttribute>(
+      STUN_ATTR_NONCE, nonce->string_view()));
+  ASSERT_TRUE(authenticated_request.AddMessageIntegrity(key));
+  Send(*client, authenticated_request, server_address);
+  response = Receive(*client);
+  ASSERT_TRUE(response);
+  EXPECT_EQ(response->type(), STUN_ALLOCATE_RESPONSE);
+  EXPECT_TRUE(response->GetAddress(STUN_ATTR_XOR_RELAYED_ADDRESS));
+
+  EXPECT_EQ(NumAllocations(server), 1u);
+}
+
+}  // namespace
+}  // namespace cricket
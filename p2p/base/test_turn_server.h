@@ -51,6 +51,20 @@ class TestTurnRedirector : public TurnRedirectInterface {
   std::vector<rtc::SocketAddress>::const_iterator iter_;
 };
 
+// Accepts any user whose password is the same as the username, like
+// TestTurnServer. It keeps no state, so a single instance may serve several
+// servers running on different threads, such as the shards of a
+// ShardedTurnServer. Obviously, do not use this in a production environment.
+class TestTurnAuth : public TurnAuthInterface {
+ public:
+  bool GetKey(absl::string_view username,
+              absl::string_view realm,
+              std::string* key) override {
+    return ComputeStunCredentialHash(std::string(username), std::string(realm),
+                                     std::string(username), key);
+  }
+};
+
 class TestTurnServer : public TurnAuthInterface {
  public:
   TestTurnServer(rtc::Thread* thread,
@@ -10,11 +10,11 @@
 
 #include "p2p/base/turn_server.h"
 
+#include <algorithm>
 #include <memory>
 #include <tuple>  // for std::tie
 #include <utility>
 
-#include "absl/algorithm/container.h"
 #include "absl/memory/memory.h"
 #include "absl/strings/string_view.h"
 #include "api/array_view.h"
@@ -29,6 +29,7 @@
 #include "rtc_base/socket_adapters.h"
 #include "rtc_base/strings/string_builder.h"
 #include "rtc_base/thread.h"
+#include "rtc_base/time_utils.h"
 
 namespace cricket {
 
@@ -56,48 +57,7 @@ inline bool IsTurnChannelData(uint16_t msg_type) {
 // IDs used for posted messages for TurnServerAllocation.
 enum {
   MSG_ALLOCATION_TIMEOUT,
-};
-
-// Encapsulates a TURN permission.
-// The object is created when a create permission request is received by an
-// allocation, and self-deletes when its lifetime timer expires.
-class TurnServerAllocation::Permission : public rtc::MessageHandlerAutoCleanup {
- public:
-  Permission(rtc::Thread* thread, const rtc::IPAddress& peer);
-  ~Permission() override;
-
-  const rtc::IPAddress& peer() const { return peer_; }
-  void Refresh();
-
-  sigslot::signal1<Permission*> SignalDestroyed;
-
- private:
-  void OnMessage(rtc::Message* msg) override;
-
-  rtc::Thread* thread_;
-  rtc::IPAddress peer_;
-};
-
-// Encapsulates a TURN channel binding.
-// The object is created when a channel bind request is received by an
-// allocation, and self-deletes when its lifetime timer expires.
-class TurnServerAllocation::Channel : public rtc::MessageHandlerAutoCleanup {
- public:
-  Channel(rtc::Thread* thread, int id, const rtc::SocketAddress& peer);
-  ~Channel() override;
-
-  int id() const { return id_; }
-  const rtc::SocketAddress& peer() const { return peer_; }
-  void Refresh();
-
-  sigslot::signal1<Channel*> SignalDestroyed;
-
- private:
-  void OnMessage(rtc::Message* msg) override;
-
-  rtc::Thread* thread_;
-  int id_;
-  rtc::SocketAddress peer_;
+  MSG_EXPIRATION_CHECK,
 };
 
 int GetStunSuccessResponseTypeOrZero(const StunMessage& req) {
@@ -222,7 +182,9 @@ void TurnServer::OnInternalPacket(rtc::AsyncPacketSocket* socket,
     // This is a STUN message.
     HandleStunMessage(&conn, data, size);
   } else {
-    // This is a channel message; let the allocation handle it.
+    // This is a channel message; let the allocation handle it. Channel data
+    // carries the bulk of the relayed traffic, so it is forwarded with a
+    // single allocation lookup and never parsed as STUN.
     TurnServerAllocation* allocation = FindAllocation(&conn);
     if (allocation) {
       allocation->HandleChannelData(data, size);
@@ -349,16 +311,27 @@ bool TurnServer::CheckAuthorization(TurnServerConnection* conn,
     return false;
   }
 
-  // Fail if bad MESSAGE_INTEGRITY.
-  if (key.empty() || msg->ValidateMessageIntegrity(std::string(key)) !=
-                         StunMessage::IntegrityStatus::kIntegrityOk) {
+  // Fail if bad MESSAGE_INTEGRITY. The message is hashed in place, and an
+  // existing allocation reuses the HMAC keyed with its key.
+  TurnServerAllocation* allocation = FindAllocation(conn);
+  StunMessageView view;
+  StunMessage::IntegrityStatus integrity =
+      StunMessage::IntegrityStatus::kIntegrityBad;
+  if (!key.empty() && view.Parse(data, size)) {
+    if (allocation) {
+      integrity = view.ValidateMessageIntegrity(allocation->key_hmac());
+    } else {
+      rtc::OpenSSLHmac hmac(rtc::DIGEST_SHA_1, key);
+      integrity = view.ValidateMessageIntegrity(hmac);
+    }
+  }
+  if (integrity != StunMessage::IntegrityStatus::kIntegrityOk) {
     SendErrorResponseWithRealmAndNonce(conn, msg, STUN_ERROR_UNAUTHORIZED,
                                        STUN_ERROR_REASON_UNAUTHORIZED);
     return false;
   }
 
   // Fail if one-time-use nonce feature is enabled.
-  TurnServerAllocation* allocation = FindAllocation(conn);
   if (enable_otu_nonce_ && allocation &&
       allocation->last_nonce() == nonce_attr->string_view()) {
     SendErrorResponseWithRealmAndNonce(conn, msg, STUN_ERROR_STALE_NONCE,
@@ -578,7 +551,11 @@ TurnServerConnection::TurnServerConnection(const rtc::SocketAddress& src,
                                            ProtocolType proto,
                                            rtc::AsyncPacketSocket* socket)
     : src_(src),
-      dst_(socket->GetRemoteAddress()),
+      // Internal UDP sockets are shared by all clients and never connected.
+      // Skip the lookup of their remote address, which costs a failing system
+      // call for every received packet.
+      dst_(proto == PROTO_UDP ? rtc::SocketAddress()
+                              : socket->GetRemoteAddress()),
       proto_(proto),
       socket_(socket) {}
 
@@ -590,6 +567,13 @@ bool TurnServerConnection::operator<(const TurnServerConnection& c) const {
   return std::tie(src_, dst_, proto_) < std::tie(c.src_, c.dst_, c.proto_);
 }
 
+size_t TurnServerConnection::Hasher::operator()(
+    const TurnServerConnection& c) const {
+  // Consistent with operator==, which ignores the socket.
+  return c.src_.Hash() ^ (c.dst_.Hash() * 31) ^
+         (static_cast<size_t>(c.proto_) << 24);
+}
+
 std::string TurnServerConnection::ToString() const {
   const char* const kProtos[] = {"unknown", "udp", "tcp", "ssltcp"};
   rtc::StringBuilder ost;
@@ -607,20 +591,14 @@ TurnServerAllocation::TurnServerAllocation(TurnServer* server,
       thread_(thread),
       conn_(conn),
       external_socket_(socket),
-      key_(key) {
+      key_(key),
+      key_hmac_(rtc::DIGEST_SHA_1, key) {
   external_socket_->SignalReadPacket.connect(
       this, &TurnServerAllocation::OnExternalPacket);
 }
 
 TurnServerAllocation::~TurnServerAllocation() {
-  for (ChannelList::iterator it = channels_.begin(); it != channels_.end();
-       ++it) {
-    delete *it;
-  }
-  for (PermissionList::iterator it = perms_.begin(); it != perms_.end(); ++it) {
-    delete *it;
-  }
-  thread_->Clear(this, MSG_ALLOCATION_TIMEOUT);
+  thread_->Clear(this);
   RTC_LOG(LS_INFO) << ToString() << ": Allocation destroyed";
 }
 
@@ -782,22 +760,26 @@ void TurnServerAllocation::HandleChannelBindRequest(const TurnMessage* msg) {
 
   // Check that this channel id isn't bound to another transport address, and
   // that this transport address isn't bound to another channel id.
-  Channel* channel1 = FindChannel(channel_id);
-  Channel* channel2 = FindChannel(peer_attr->GetAddress());
-  if (channel1 != channel2) {
+  const rtc::SocketAddress& peer = peer_attr->GetAddress();
+  auto channel = channels_.find(channel_id);
+  auto channel_id_by_peer = channel_ids_by_peer_.find(peer);
+  const bool id_bound = channel != channels_.end();
+  const bool peer_bound = channel_id_by_peer != channel_ids_by_peer_.end();
+  if (id_bound != peer_bound ||
+      (id_bound && channel_id_by_peer->second != channel_id)) {
     SendBadRequestResponse(msg);
     return;
   }
 
   // Add or refresh this channel.
-  if (!channel1) {
-    channel1 = new Channel(thread_, channel_id, peer_attr->GetAddress());
-    channel1->SignalDestroyed.connect(
-        this, &TurnServerAllocation::OnChannelDestroyed);
-    channels_.push_back(channel1);
+  const int64_t expiration_ms = rtc::TimeMillis() + kChannelTimeout;
+  if (!id_bound) {
+    channels_.emplace(channel_id, Channel{peer, expiration_ms});
+    channel_ids_by_peer_.emplace(peer, channel_id);
   } else {
-    channel1->Refresh();
+    channel->second.expiration_ms = expiration_ms;
   }
+  ScheduleExpirationCheck(expiration_ms);
 
   // Channel binds also refresh permissions.
   AddPermission(peer_attr->GetAddress().ipaddr());
@@ -812,13 +794,21 @@ void TurnServerAllocation::HandleChannelBindRequest(const TurnMessage* msg) {
 }
 
 void TurnServerAllocation::HandleChannelData(const char* data, size_t size) {
-  // Extract the channel number from the data.
+  // Extract the channel number and the payload length from the data. Anything
+  // after the payload is padding, which is not relayed.
   uint16_t channel_id = rtc::GetBE16(data);
-  Channel* channel = FindChannel(channel_id);
-  if (channel) {
+  size_t payload_size = rtc::GetBE16(data + 2);
+  if (payload_size > size - TURN_CHANNEL_HEADER_SIZE) {
+    RTC_LOG(LS_WARNING) << ToString()
+                        << ": Received truncated channel data, id="
+                        << channel_id;
+    return;
+  }
+  auto channel = channels_.find(channel_id);
+  if (channel != channels_.end()) {
     // Send the data to the peer address.
-    SendExternal(data + TURN_CHANNEL_HEADER_SIZE,
-                 size - TURN_CHANNEL_HEADER_SIZE, channel->peer());
+    SendExternal(data + TURN_CHANNEL_HEADER_SIZE, payload_size,
+                 channel->second.peer);
   } else {
     RTC_LOG(LS_WARNING) << ToString()
                         << ": Received channel data for invalid channel, id="
@@ -833,14 +823,14 @@ void TurnServerAllocation::OnExternalPacket(
     const rtc::SocketAddress& addr,
     const int64_t& /* packet_time_us */) {
   RTC_DCHECK(external_socket_.get() == socket);
-  Channel* channel = FindChannel(addr);
-  if (channel) {
+  auto channel_id = channel_ids_by_peer_.find(addr);
+  if (channel_id != channel_ids_by_peer_.end()) {
     // There is a channel bound to this address. Send as a channel message.
-    rtc::ByteBufferWriter buf;
-    buf.WriteUInt16(channel->id());
-    buf.WriteUInt16(static_cast<uint16_t>(size));
-    buf.WriteBytes(data, size);
-    server_->Send(&conn_, buf);
+    channel_data_buffer_.Clear();
+    channel_data_buffer_.WriteUInt16(channel_id->second);
+    channel_data_buffer_.WriteUInt16(static_cast<uint16_t>(size));
+    channel_data_buffer_.WriteBytes(data, size);
+    server_->Send(&conn_, channel_data_buffer_);
   } else if (!server_->enable_permission_checks_ ||
              HasPermission(addr.ipaddr())) {
     // No channel, but a permission exists. Send as a data indication.
@@ -868,49 +858,15 @@ int TurnServerAllocation::ComputeLifetime(const TurnMessage& msg) {
 }
 
 bool TurnServerAllocation::HasPermission(const rtc::IPAddress& addr) {
-  return (FindPermission(addr) != NULL);
+  return permission_expirations_ms_.find(addr) !=
+         permission_expirations_ms_.end();
 }
 
 void TurnServerAllocation::AddPermission(const rtc::IPAddress& addr) {
-  Permission* perm = FindPermission(addr);
-  if (!perm) {
-    perm = new Permission(thread_, addr);
-    perm->SignalDestroyed.connect(this,
-                                  &TurnServerAllocation::OnPermissionDestroyed);
-    perms_.push_back(perm);
-  } else {
-    perm->Refresh();
-  }
-}
-
-TurnServerAllocation::Permission* TurnServerAllocation::FindPermission(
-    const rtc::IPAddress& addr) const {
-  for (PermissionList::const_iterator it = perms_.begin(); it != perms_.end();
-       ++it) {
-    if ((*it)->peer() == addr)
-      return *it;
-  }
-  return NULL;
-}
-
-TurnServerAllocation::Channel* TurnServerAllocation::FindChannel(
-    int channel_id) const {
-  for (ChannelList::const_iterator it = channels_.begin();
-       it != channels_.end(); ++it) {
-    if ((*it)->id() == channel_id)
-      return *it;
-  }
-  return NULL;
-}
-
-TurnServerAllocation::Channel* TurnServerAllocation::FindChannel(
-    const rtc::SocketAddress& addr) const {
-  for (ChannelList::const_iterator it = channels_.begin();
-       it != channels_.end(); ++it) {
-    if ((*it)->peer() == addr)
-      return *it;
-  }
-  return NULL;
+  // Adds the permission, or refreshes it if it exists.
+  const int64_t expiration_ms = rtc::TimeMillis() + kPermissionTimeout;
+  permission_expirations_ms_[addr] = expiration_ms;
+  ScheduleExpirationCheck(expiration_ms);
 }
 
 void TurnServerAllocation::SendResponse(TurnMessage* msg) {
@@ -936,67 +892,66 @@ void TurnServerAllocation::SendExternal(const void* data,
   external_socket_->SendTo(data, size, peer, options);
 }
 
-void TurnServerAllocation::OnMessage(rtc::Message* msg) {
-  RTC_DCHECK(msg->message_id == MSG_ALLOCATION_TIMEOUT);
-  SignalDestroyed(this);
-  delete this;
-}
-
-void TurnServerAllocation::OnPermissionDestroyed(Permission* perm) {
-  auto it = absl::c_find(perms_, perm);
-  RTC_DCHECK(it != perms_.end());
-  perms_.erase(it);
-}
-
-void TurnServerAllocation::OnChannelDestroyed(Channel* channel) {
-  auto it = absl::c_find(channels_, channel);
-  RTC_DCHECK(it != channels_.end());
-  channels_.erase(it);
-}
-
-TurnServerAllocation::Permission::Permission(rtc::Thread* thread,
-                                             const rtc::IPAddress& peer)
-    : thread_(thread), peer_(peer) {
-  Refresh();
-}
-
-TurnServerAllocation::Permission::~Permission() {
-  thread_->Clear(this, MSG_ALLOCATION_TIMEOUT);
-}
-
-void TurnServerAllocation::Permission::Refresh() {
-  thread_->Clear(this, MSG_ALLOCATION_TIMEOUT);
-  thread_->PostDelayed(RTC_FROM_HERE, kPermissionTimeout, this,
-                       MSG_ALLOCATION_TIMEOUT);
-}
-
-void TurnServerAllocation::Permission::OnMessage(rtc::Message* msg) {
-  RTC_DCHECK(msg->message_id == MSG_ALLOCATION_TIMEOUT);
-  SignalDestroyed(this);
-  delete this;
-}
-
-TurnServerAllocation::Channel::Channel(rtc::Thread* thread,
-                                       int id,
-                                       const rtc::SocketAddress& peer)
-    : thread_(thread), id_(id), peer_(peer) {
-  Refresh();
+void TurnServerAllocation::ScheduleExpirationCheck(int64_t expiration_ms) {
+  if (next_expiration_check_ms_ &&
+      *next_expiration_check_ms_ <= expiration_ms) {
+    return;
+  }
+  if (next_expiration_check_ms_) {
+    thread_->Clear(this, MSG_EXPIRATION_CHECK);
+  }
+  next_expiration_check_ms_ = expiration_ms;
+  int delay_ms =
+      static_cast<int>(std::max<int64_t>(expiration_ms - rtc::TimeMillis(), 0));
+  thread_->PostDelayed(RTC_FROM_HERE, delay_ms, this, MSG_EXPIRATION_CHECK);
 }
 
-TurnServerAllocation::Channel::~Channel() {
-  thread_->Clear(this, MSG_ALLOCATION_TIMEOUT);
-}
+void TurnServerAllocation::ExpirePermissionsAndChannels() {
+  next_expiration_check_ms_ = absl::nullopt;
+  const int64_t now_ms = rtc::TimeMillis();
+  absl::optional<int64_t> next_expiration_ms;
+  auto update_next_expiration = [&](int64_t expiration_ms) {
+    if (!next_expiration_ms || expiration_ms < *next_expiration_ms) {
+      next_expiration_ms = expiration_ms;
+    }
+  };
+
+  for (auto it = permission_expirations_ms_.begin();
+       it != permission_expirations_ms_.end();) {
+    if (it->second <= now_ms) {
+      it = permission_expirations_ms_.erase(it);
+    } else {
+      update_next_expiration(it->second);
+      ++it;
+    }
+  }
+  for (auto it = channels_.begin(); it != channels_.end();) {
+    if (it->second.expiration_ms <= now_ms) {
+      channel_ids_by_peer_.erase(it->second.peer);
+      it = channels_.erase(it);
+    } else {
+      update_next_expiration(it->second.expiration_ms);
+      ++it;
+    }
+  }
 
-void TurnServerAllocation::Channel::Refresh() {
-  thread_->Clear(this, MSG_ALLOCATION_TIMEOUT);
-  thread_->PostDelayed(RTC_FROM_HERE, kChannelTimeout, this,
-                       MSG_ALLOCATION_TIMEOUT);
+  if (next_expiration_ms) {
+    ScheduleExpirationCheck(*next_expiration_ms);
+  }
 }
 
-void TurnServerAllocation::Channel::OnMessage(rtc::Message* msg) {
-  RTC_DCHECK(msg->message_id == MSG_ALLOCATION_TIMEOUT);
-  SignalDestroyed(this);
-  delete this;
+void TurnServerAllocation::OnMessage(rtc::Message* msg) {
+  switch (msg->message_id) {
+    case MSG_ALLOCATION_TIMEOUT:
+      SignalDestroyed(this);
+      delete this;
+      break;
+    case MSG_EXPIRATION_CHECK:
+      ExpirePermissionsAndChannels();
+      break;
+    default:
+      RTC_DCHECK_NOTREACHED();
+  }
 }
 
 }  // namespace cricket
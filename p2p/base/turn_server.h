@@ -11,25 +11,29 @@
 #ifndef P2P_BASE_TURN_SERVER_H_
 #define P2P_BASE_TURN_SERVER_H_
 
-#include <list>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "absl/strings/string_view.h"
+#include "absl/types/optional.h"
 #include "api/sequence_checker.h"
 #include "p2p/base/port_interface.h"
 #include "rtc_base/async_packet_socket.h"
+#include "rtc_base/byte_buffer.h"
+#include "rtc_base/containers/flat_map.h"
+#include "rtc_base/ip_address.h"
+#include "rtc_base/openssl_digest.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/ssl_adapter.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 #include "rtc_base/thread.h"
 
 namespace rtc {
-class ByteBufferWriter;
 class PacketSocketFactory;
 }  // namespace rtc
 
@@ -55,6 +59,10 @@ class TurnServerConnection {
   bool operator<(const TurnServerConnection& t) const;
   std::string ToString() const;
 
+  struct Hasher {
+    size_t operator()(const TurnServerConnection& c) const;
+  };
+
  private:
   rtc::SocketAddress src_;
   rtc::SocketAddress dst_;
@@ -79,6 +87,9 @@ class TurnServerAllocation : public rtc::MessageHandlerAutoCleanup,
 
   TurnServerConnection* conn() { return &conn_; }
   const std::string& key() const { return key_; }
+  // HMAC keyed with `key()`, for validating the MESSAGE-INTEGRITY of the
+  // requests of this allocation.
+  rtc::OpenSSLHmac& key_hmac() { return key_hmac_; }
   const std::string& transaction_id() const { return transaction_id_; }
   const std::string& username() const { return username_; }
   const std::string& last_nonce() const { return last_nonce_; }
@@ -94,10 +105,10 @@ class TurnServerAllocation : public rtc::MessageHandlerAutoCleanup,
   sigslot::signal1<TurnServerAllocation*> SignalDestroyed;
 
  private:
-  class Channel;
-  class Permission;
-  typedef std::list<Permission*> PermissionList;
-  typedef std::list<Channel*> ChannelList;
+  struct Channel {
+    rtc::SocketAddress peer;
+    int64_t expiration_ms;
+  };
 
   void HandleAllocateRequest(const TurnMessage* msg);
   void HandleRefreshRequest(const TurnMessage* msg);
@@ -114,9 +125,6 @@ class TurnServerAllocation : public rtc::MessageHandlerAutoCleanup,
   static int ComputeLifetime(const TurnMessage& msg);
   bool HasPermission(const rtc::IPAddress& addr);
   void AddPermission(const rtc::IPAddress& addr);
-  Permission* FindPermission(const rtc::IPAddress& addr) const;
-  Channel* FindChannel(int channel_id) const;
-  Channel* FindChannel(const rtc::SocketAddress& addr) const;
 
   void SendResponse(TurnMessage* msg);
   void SendBadRequestResponse(const TurnMessage* req);
@@ -127,8 +135,11 @@ class TurnServerAllocation : public rtc::MessageHandlerAutoCleanup,
                     size_t size,
                     const rtc::SocketAddress& peer);
 
-  void OnPermissionDestroyed(Permission* perm);
-  void OnChannelDestroyed(Channel* channel);
+  // Makes sure that permissions and channels are checked for expiration no
+  // later than at `expiration_ms`.
+  void ScheduleExpirationCheck(int64_t expiration_ms);
+  // Removes the permissions and channels that have expired.
+  void ExpirePermissionsAndChannels();
   void OnMessage(rtc::Message* msg) override;
 
   TurnServer* const server_;
@@ -136,11 +147,20 @@ class TurnServerAllocation : public rtc::MessageHandlerAutoCleanup,
   TurnServerConnection conn_;
   std::unique_ptr<rtc::AsyncPacketSocket> external_socket_;
   std::string key_;
+  rtc::OpenSSLHmac key_hmac_;
   std::string transaction_id_;
   std::string username_;
   std::string last_nonce_;
-  PermissionList perms_;
-  ChannelList channels_;
+  // Permissions and channels are looked up for every relayed packet. They
+  // are kept in flat maps to make the lookup fast and allocation free. Instead
+  // of a timer each, they store their expiration time and share a single
+  // timer that fires at the earliest expiration.
+  webrtc::flat_map<rtc::IPAddress, int64_t> permission_expirations_ms_;
+  webrtc::flat_map<uint16_t, Channel> channels_;
+  webrtc::flat_map<rtc::SocketAddress, uint16_t> channel_ids_by_peer_;
+  absl::optional<int64_t> next_expiration_check_ms_;
+  // Reused to build the channel data messages sent to the client.
+  rtc::ByteBufferWriter channel_data_buffer_;
 };
 
 // An interface through which the MD5 credential hash can be retrieved.
@@ -176,7 +196,9 @@ class StunMessageObserver {
 // Not yet wired up: TCP support.
 class TurnServer : public sigslot::has_slots<> {
  public:
-  typedef std::map<TurnServerConnection, std::unique_ptr<TurnServerAllocation>>
+  typedef std::unordered_map<TurnServerConnection,
+                             std::unique_ptr<TurnServerAllocation>,
+                             TurnServerConnection::Hasher>
       AllocationMap;
 
   explicit TurnServer(rtc::Thread* thread);
@@ -0,0 +1,491 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "api/packet_socket_factory.h"
+#include "api/transport/stun.h"
+#include "benchmark/benchmark.h"
+#include "p2p/base/sharded_turn_server.h"
+#include "p2p/base/test_turn_server.h"
+#include "rtc_base/async_packet_socket.h"
+#include "rtc_base/async_udp_socket.h"
+#include "rtc_base/byte_buffer.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/event.h"
+#include "rtc_base/ip_address.h"
+#include "rtc_base/location.h"
+#include "rtc_base/socket.h"
+#include "rtc_base/socket_address.h"
+#include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/thread.h"
+
+namespace cricket {
+namespace {
+
+constexpr char kUsername[] = "user";
+constexpr uint16_t kChannelId = 0x4000;
+constexpr size_t kNumClientsPerGenerator = 16;
+constexpr size_t kPacketsPerClient = 4;
+constexpr size_t kPayloadSize = 200;
+constexpr int kSocketBufferSize = 1 << 20;
+constexpr int kSetupTimeoutMs = 5000;
+// Bursts are ended early if packets got lost.
+constexpr int kBurstTimeoutMs = 100;
+
+rtc::SocketAddress LoopbackAddress() {
+  return rtc::SocketAddress(rtc::IPAddress(INADDR_LOOPBACK), 0);
+}
+
+std::unique_ptr<TurnMessage> CreateAllocateRequest() {
+  auto request = std::make_unique<TurnMessage>(STUN_ALLOCATE_REQUEST);
+  request->AddAttribute(std::make_unique<StunUInt32Attribute>(
+      STUN_ATTR_REQUESTED_TRANSPORT, IPPROTO_UDP << 24));
+  return request;
+}
+
+std::unique_ptr<TurnMessage> CreateChannelBindRequest(
+    uint16_t channel_id,
+    const rtc::SocketAddress& peer) {
+  auto request = std::make_unique<TurnMessage>(TURN_CHANNEL_BIND_REQUEST);
+  request->AddAttribute(std::make_unique<StunUInt32Attribute>(
+      STUN_ATTR_CHANNEL_NUMBER, channel_id << 16));
+  request->AddAttribute(std::make_unique<StunXorAddressAttribute>(
+      STUN_ATTR_XOR_PEER_ADDRESS, peer));
+  return request;
+}
+
+void AddCredentials(TurnMessage& request,
+                    const std::string& nonce,
+                    const std::string& key) {
+  request.AddAttribute(
+      std::make_unique<StunByteStringAttribute>(STUN_ATTR_USERNAME, kUsername));
+  request.AddAttribute(
+      std::make_unique<StunByteStringAttribute>(STUN_ATTR_REALM, kTestRealm));
+  request.AddAttribute(
+      std::make_unique<StunByteStringAttribute>(STUN_ATTR_NONCE, nonce));
+  RTC_CHECK(request.AddMessageIntegrity(key));
+}
+
+// A set of TURN clients, each with an allocation and a channel bound to a
+// common peer socket, all running on one thread. A burst makes every client
+// send channel data, which the server relays to the peer.
+class LoadGenerator : public sigslot::has_slots<> {
+ public:
+  // Must be created and destroyed on `thread`, which needs a socket server.
+  LoadGenerator(rtc::Thread* thread, const rtc::SocketAddress& server_address)
+      : server_address_(server_address) {
+    RTC_CHECK(ComputeStunCredentialHash(kUsername, kTestRealm, kUsername,
+                                        &key_));
+    peer_.reset(
+        rtc::AsyncUDPSocket::Create(thread->socketserver(), LoopbackAddress()));
+    RTC_CHECK(peer_);
+    peer_->SetOption(rtc::Socket::OPT_RCVBUF, kSocketBufferSize);
+    peer_->SignalReadPacket.connect(this, &LoadGenerator::OnPeerPacket);
+
+    rtc::ByteBufferWriter channel_data;
+    channel_data.WriteUInt16(kChannelId);
+    channel_data.WriteUInt16(kPayloadSize);
+    std::string payload(kPayloadSize, 'x');
+    channel_data.WriteBytes(payload.data(), payload.size());
+    channel_data_.assign(channel_data.Data(), channel_data.Length());
+
+    for (size_t i = 0; i < kNumClientsPerGenerator; ++i) {
+      std::unique_ptr<rtc::AsyncPacketSocket> socket(
+          rtc::AsyncUDPSocket::Create(thread->socketserver(),
+                                      LoopbackAddress()));
+      RTC_CHECK(socket);
+      socket->SetOption(rtc::Socket::OPT_SNDBUF, kSocketBufferSize);
+      socket->SignalReadPacket.connect(this, &LoadGenerator::OnClientPacket);
+      clients_.push_back({std::move(socket), /*nonce=*/""});
+    }
+    // Allocation starts with an unauthenticated request, which is rejected
+    // with the nonce to use.
+    for (Client& client : clients_) {
+      SendRequest(client, CreateAllocateRequest(), /*authenticate=*/false);
+    }
+  }
+
+  // Set once every client has bound its channel.
+  rtc::Event& ready() { return ready_; }
+  // Set once all packets of the last burst were relayed.
+  rtc::Event& burst_relayed() { return burst_relayed_; }
+  size_t num_relayed() const { return num_relayed_; }
+
+  void SendBurst() {
+    burst_relayed_.Reset();
+    pending_ = clients_.size() * kPacketsPerClient;
+    rtc::PacketOptions options;
+    for (size_t i = 0; i < kPacketsPerClient; ++i) {
+      for (Client& client : clients_) {
+        client.socket->SendTo(channel_data_.data(), channel_data_.size(),
+                              server_address_, options);
+      }
+    }
+  }
+
+ private:
+  struct Client {
+    std::unique_ptr<rtc::AsyncPacketSocket> socket;
+    std::string nonce;
+  };
+
+  void SendRequest(Client& client,
+                   std::unique_ptr<TurnMessage> request,
+                   bool authenticate) {
+    if (authenticate) {
+      AddCredentials(*request, client.nonce, key_);
+    }
+    rtc::ByteBufferWriter buf;
+    request->Write(&buf);
+    client.socket->SendTo(buf.Data(), buf.Length(), server_address_,
+                          rtc::PacketOptions());
+  }
+
+  void OnClientPacket(rtc::AsyncPacketSocket* socket,
+                      const char* data,
+                      size_t size,
+                      const rtc::SocketAddress& /* addr */,
+                      const int64_t& /* packet_time_us */) {
+    Client* client = nullptr;
+    for (Client& c : clients_) {
+      if (c.socket.get() == socket) {
+        client = &c;
+      }
+    }
+    RTC_CHECK(client);
+    TurnMessage response;
+    rtc::ByteBufferReader buf(data, size);
+    RTC_CHECK(response.Read(&buf));
+
+    switch (response.type()) {
+      case STUN_ALLOCATE_ERROR_RESPONSE: {
+        const StunByteStringAttribute* nonce =
+            response.GetByteString(STUN_ATTR_NONCE);
+        RTC_CHECK(nonce);
+        client->nonce = std::string(nonce->string_view());
+        SendRequest(*client, CreateAllocateRequest(), /*authenticate=*/true);
+        break;
+      }
+      case STUN_ALLOCATE_RESPONSE:
+        SendRequest(*client,
+                    CreateChannelBindRequest(kChannelId,
+                                             peer_->GetLocalAddress()),
+                    /*authenticate=*/true);
+        break;
+      case TURN_CHANNEL_BIND_RESPONSE:
+        if (++num_ready_ == clients_.size()) {
+          ready_.Set();
+        }
+        break;
+      default:
+        RTC_CHECK_NOTREACHED();
+    }
+  }
+
+  void OnPeerPacket(rtc::AsyncPacketSocket* /* socket */,
+                    const char* /* data */,
+                    size_t /* size */,
+                    const rtc::SocketAddress& /* addr */,
+                    const int64_t& /* packet_time_us */) {
+    ++num_relayed_;
+    if (pending_ > 0 && --pending_ == 0) {
+      burst_relayed_.Set();
+    }
+  }
+
+  const rtc::SocketAddress server_address_;
+  std::string key_;
+  std::string channel_data_;
+  std::unique_ptr<rtc::AsyncPacketSocket> peer_;
+  std::vector<Client> clients_;
+  size_t num_ready_ = 0;
+  size_t pending_ = 0;
+  size_t num_relayed_ = 0;
+  rtc::Event ready_;
+  rtc::Event burst_relayed_;
+};
+
+// Relays channel data through a TURN server with `state.range(0)` shards.
+// Every shard gets its own load generator thread, so on a machine with enough
+// cores the relayed packets per second per core stay constant if the server
+// scales linearly.
+void BM_TurnServerRelay(benchmark::State& state) {
+  const size_t num_shards = static_cast<size_t>(state.range(0));
+  TestTurnAuth auth;
+  ShardedTurnServer server(num_shards);
+  server.ConfigureShards([&auth](TurnServer& shard) {
+    shard.set_realm(kTestRealm);
+    shard.set_software(kTestSoftware);
+    shard.set_auth_hook(&auth);
+  });
+  const rtc::SocketAddress server_address =
+      server.AddInternalUdpSocket(LoopbackAddress());
+  RTC_CHECK(!server_address.IsNil());
+  server.SetExternalAddress(LoopbackAddress());
+
+  std::vector<std::unique_ptr<rtc::Thread>> threads;
+  std::vector<std::unique_ptr<LoadGenerator>> generators(num_shards);
+  for (size_t i = 0; i < num_shards; ++i) {
+    threads.push_back(rtc::Thread::CreateWithSocketServer());
+    rtc::Thread* thread = threads.back().get();
+    thread->Start();
+    thread->Invoke<void>(RTC_FROM_HERE, [&, thread, i] {
+      generators[i] = std::make_unique<LoadGenerator>(thread, server_address);
+    });
+    RTC_CHECK(generators[i]->ready().Wait(kSetupTimeoutMs));
+  }
+
+  for (auto _ : state) {
+    for (size_t i = 0; i < num_shards; ++i) {
+      LoadGenerator* generator = generators[i].get();
+      threads[i]->PostTask([generator] { generator->SendBurst(); });
+    }
+    for (std::unique_ptr<LoadGenerator>& generator : generators) {
+      generator->burst_relayed().Wait(kBurstTimeoutMs);
+    }
+  }
+
+  size_t num_relayed = 0;
+  for (size_t i = 0; i < num_shards; ++i) {
+    threads[i]->Invoke<void>(RTC_FROM_HERE, [&, i] {
+      num_relayed += generators[i]->num_relayed();
+      generators[i] = nullptr;
+    });
+  }
+  const size_t num_sent = state.iterations() * num_shards *
+                          kNumClientsPerGenerator * kPacketsPerClient;
+  state.SetItemsProcessed(num_relayed);
+  state.counters["relayed_packets_per_second_per_core"] =
+      benchmark::Counter(static_cast<double>(num_relayed) / num_shards,
+                         benchmark::Counter::kIsRate);
+  state.counters["loss_ratio"] =
+      num_sent > 0 ? 1.0 - static_cast<double>(num_relayed) / num_sent : 0.0;
+}
+
+BENCHMARK(BM_TurnServerRelay)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+
+// A UDP socket that counts the packets sent through it instead of sending
+// them. Received packets are injected by firing SignalReadPacket.
+class FakeUdpSocket : public rtc::AsyncPacketSocket {
+ public:
+  explicit FakeUdpSocket(const rtc::SocketAddress& local_address)
+      : local_address_(local_address) {}
+
+  size_t num_sent() const { return num_sent_; }
+  // The last packet sent, while `record_sent_packets` is set.
+  const std::string& last_sent() const { return last_sent_; }
+  void set_record_sent_packets(bool record) { record_sent_packets_ = record; }
+
+  void Receive(const std::string& data, const rtc::SocketAddress& from) {
+    SignalReadPacket(this, data.data(), data.size(), from,
+                     /*packet_time_us=*/-1);
+  }
+
+  rtc::SocketAddress GetLocalAddress() const override {
+    return local_address_;
+  }
+  rtc::SocketAddress GetRemoteAddress() const override {
+    return rtc::SocketAddress();
+  }
+  int Send(const void* pv,
+           size_t cb,
+           const rtc::PacketOptions& options) override {
+    RTC_CHECK_NOTREACHED();
+  }
+  int SendTo(const void* pv,
+             size_t cb,
+             const rtc::SocketAddress& addr,
+             const rtc::PacketOptions& options) override {
+    ++num_sent_;
+    if (record_sent_packets_) {
+      last_sent_.assign(static_cast<const char*>(pv), cb);
+    }
+    return static_cast<int>(cb);
+  }
+  int Close() override { return 0; }
+  State GetState() const override { return STATE_BOUND; }
+  int GetOption(rtc::Socket::Option opt, int* value) override { return -1; }
+  int SetOption(rtc::Socket::Option opt, int value) override { return 0; }
+  int GetError() const override { return 0; }
+  void SetError(int error) override {}
+
+ private:
+  const rtc::SocketAddress local_address_;
+  size_t num_sent_ = 0;
+  bool record_sent_packets_ = true;
+  std::string last_sent_;
+};
+
+// Creates the relay sockets of the allocations as FakeUdpSockets.
+class FakeUdpSocketFactory : public rtc::PacketSocketFactory {
+ public:
+  // The socket created last, owned by the allocation that uses it.
+  FakeUdpSocket* last_socket() { return last_socket_; }
+
+  rtc::AsyncPacketSocket* CreateUdpSocket(const rtc::SocketAddress& address,
+                                          uint16_t min_port,
+                                          uint16_t max_port) override {
+    last_socket_ = new FakeUdpSocket(
+        rtc::SocketAddress(address.ipaddr(), next_port_++));
+    return last_socket_;
+  }
+  rtc::AsyncListenSocket* CreateServerTcpSocket(
+      const rtc::SocketAddress& local_address,
+      uint16_t min_port,
+      uint16_t max_port,
+      int opts) override {
+    return nullptr;
+  }
+  rtc::AsyncPacketSocket* CreateClientTcpSocket(
+      const rtc::SocketAddress& local_address,
+      const rtc::SocketAddress& remote_address,
+      const rtc::ProxyInfo& proxy_info,
+      const std::string& user_agent,
+      const rtc::PacketSocketTcpOptions& tcp_options) override {
+    return nullptr;
+  }
+
+ private:
+  FakeUdpSocket* last_socket_ = nullptr;
+  uint16_t next_port_ = 10000;
+};
+
+// A single allocation with a channel bound to each of `kNumPeers` peers, on a
+// TurnServer whose sockets are fakes. This measures the per packet cost of
+// the server, without the cost of the sockets.
+class AllocationRelay {
+ public:
+  static constexpr size_t kNumPeers = 100;
+
+  AllocationRelay()
+      : client_address_("192.168.1.1", 5000),
+        internal_socket_(
+            new FakeUdpSocket(rtc::SocketAddress("10.0.0.1", 3478))),
+        socket_factory_(new FakeUdpSocketFactory()),
+        server_(&thread_) {
+    server_.set_realm(kTestRealm);
+    server_.set_auth_hook(&auth_);
+    // The server takes ownership of the socket and the factory.
+    server_.AddInternalSocket(internal_socket_, PROTO_UDP);
+    server_.SetExternalSocketFactory(socket_factory_,
+                                     rtc::SocketAddress("10.0.0.1", 0));
+    std::string key;
+    RTC_CHECK(ComputeStunCredentialHash(kUsername, kTestRealm, kUsername,
+                                        &key));
+
+    // The first request is rejected with the nonce to use.
+    std::unique_ptr<TurnMessage> response =
+        SendRequest(*CreateAllocateRequest());
+    RTC_CHECK_EQ(response->type(), STUN_ALLOCATE_ERROR_RESPONSE);
+    const std::string nonce(
+        response->GetByteString(STUN_ATTR_NONCE)->string_view());
+    std::unique_ptr<TurnMessage> request = CreateAllocateRequest();
+    AddCredentials(*request, nonce, key);
+    RTC_CHECK_EQ(SendRequest(*request)->type(), STUN_ALLOCATE_RESPONSE);
+    relay_socket_ = socket_factory_->last_socket();
+
+    for (size_t i = 0; i < kNumPeers; ++i) {
+      const uint16_t channel_id = static_cast<uint16_t>(kChannelId + i);
+      rtc::SocketAddress peer("172.16.0.1", static_cast<int>(20000 + i));
+      request = CreateChannelBindRequest(channel_id, peer);
+      AddCredentials(*request, nonce, key);
+      RTC_CHECK_EQ(SendRequest(*request)->type(), TURN_CHANNEL_BIND_RESPONSE);
+
+      std::string payload(kPayloadSize, 'x');
+      rtc::ByteBufferWriter channel_data;
+      channel_data.WriteUInt16(channel_id);
+      channel_data.WriteUInt16(kPayloadSize);
+      channel_data.WriteBytes(payload.data(), payload.size());
+      channel_data_.emplace_back(channel_data.Data(), channel_data.Length());
+      peers_.push_back(peer);
+    }
+    internal_socket_->set_record_sent_packets(false);
+    relay_socket_->set_record_sent_packets(false);
+  }
+
+  // Sends channel data from the client to every peer.
+  void RelayToPeers() {
+    for (const std::string& channel_data : channel_data_) {
+      internal_socket_->Receive(channel_data, client_address_);
+    }
+  }
+
+  // Sends a packet from every peer to the client.
+  void RelayFromPeers() {
+    for (const rtc::SocketAddress& peer : peers_) {
+      relay_socket_->Receive(payload_, peer);
+    }
+  }
+
+  size_t num_sent_to_peers() const { return relay_socket_->num_sent(); }
+  size_t num_sent_to_client() const { return internal_socket_->num_sent(); }
+
+ private:
+  std::unique_ptr<TurnMessage> SendRequest(const TurnMessage& request) {
+    rtc::ByteBufferWriter buf;
+    request.Write(&buf);
+    internal_socket_->Receive(std::string(buf.Data(), buf.Length()),
+                              client_address_);
+    auto response = std::make_unique<TurnMessage>();
+    rtc::ByteBufferReader response_buf(internal_socket_->last_sent().data(),
+                                       internal_socket_->last_sent().size());
+    RTC_CHECK(response->Read(&response_buf));
+    return response;
+  }
+
+  rtc::AutoThread thread_;
+  TestTurnAuth auth_;
+  const rtc::SocketAddress client_address_;
+  FakeUdpSocket* const internal_socket_;
+  FakeUdpSocketFactory* const socket_factory_;
+  TurnServer server_;
+  // Owned by the allocation.
+  FakeUdpSocket* relay_socket_ = nullptr;
+  std::vector<std::string> channel_data_;
+  std::vector<rtc::SocketAddress> peers_;
+  const std::string payload_ = std::string(kPayloadSize, 'x');
+};
+
+// Relays channel data from a client to the peers of its allocation.
+void BM_RelayChannelData(benchmark::State& state) {
+  AllocationRelay relay;
+  for (auto _ : state) {
+    relay.RelayToPeers();
+  }
+  RTC_CHECK_EQ(relay.num_sent_to_peers(),
+               state.iterations() * AllocationRelay::kNumPeers);
+  state.SetItemsProcessed(relay.num_sent_to_peers());
+}
+
+BENCHMARK(BM_RelayChannelData);
+
+// Relays packets from the peers of an allocation to its client, as channel
+// data.
+void BM_RelayExternalPackets(benchmark::State& state) {
+  AllocationRelay relay;
+  const size_t num_sent_during_setup = relay.num_sent_to_client();
+  for (auto _ : state) {
+    relay.RelayFromPeers();
+  }
+  const size_t num_relayed = relay.num_sent_to_client() - num_sent_during_setup;
+  RTC_CHECK_EQ(num_relayed, state.iterations() * AllocationRelay::kNumPeers);
+  state.SetItemsProcessed(num_relayed);
+}
+
+BENCHMARK(BM_RelayExternalPackets);
+
+}  // namespace
+}  // namespace cricket
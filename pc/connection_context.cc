@@ -99,6 +99,8 @@ ConnectionContext::ConnectionContext(
       trials_(dependencies->trials ? std::move(dependencies->trials)
                                    : std::make_unique<FieldTrialBasedConfig>()),
       media_engine_(std::move(dependencies->media_engine)),
+      video_decode_scheduler_(
+          std::move(dependencies->video_decode_scheduler)),
       network_monitor_factory_(
           std::move(dependencies->network_monitor_factory)),
       default_network_manager_(std::move(dependencies->network_manager)),
@@ -22,6 +22,7 @@
 #include "api/scoped_refptr.h"
 #include "api/sequence_checker.h"
 #include "api/transport/sctp_transport_factory_interface.h"
+#include "api/video/video_decode_scheduler.h"
 #include "media/base/media_engine.h"
 #include "p2p/base/basic_packet_socket_factory.h"
 #include "rtc_base/checks.h"
@@ -73,6 +74,14 @@ class ConnectionContext final
     return media_engine_.get();
   }
 
+  // Scheduler of the video decoding of all the Calls created with this
+  // context, or null if each receive stream decodes on its own thread. Owned
+  // here rather than by the PeerConnectionFactory, since a PeerConnection only
+  // keeps the context alive.
+  VideoDecodeScheduler* video_decode_scheduler() const {
+    return video_decode_scheduler_.get();
+  }
+
   rtc::Thread* signaling_thread() { return signaling_thread_; }
   const rtc::Thread* signaling_thread() const { return signaling_thread_; }
   rtc::Thread* worker_thread() { return worker_thread_.get(); }
@@ -128,6 +137,9 @@ class ConnectionContext final
 
   const std::unique_ptr<cricket::MediaEngineInterface> media_engine_;
 
+  // Outlives the Calls, and thereby the decode queues, of all PeerConnections.
+  const std::unique_ptr<VideoDecodeScheduler> video_decode_scheduler_;
+
   // This object should be used to generate any SSRC that is not explicitly
   // specified by the user (or by the remote party).
   // TODO(bugs.webrtc.org/12666): This variable is used from both the signaling
@@ -353,6 +353,7 @@ bool JsepTransport::GetStats(TransportStats* stats) {
   RTC_DCHECK_RUN_ON(network_thread_);
   stats->transport_name = mid();
   stats->channel_stats.clear();
+  stats->receive_buffer_stats = rtp_transport()->GetReceiveBufferStats();
   RTC_DCHECK(rtp_dtls_transport_->internal());
   bool ret = GetTransportStats(rtp_dtls_transport_->internal(),
                                ICE_CANDIDATE_COMPONENT_RTP, stats);
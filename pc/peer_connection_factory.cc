@@ -345,6 +345,7 @@ std::unique_ptr<Call> PeerConnectionFactory::CreateCall_w(
   call_config.rtp_transport_controller_send_factory =
       transport_controller_send_factory_.get();
   call_config.metronome = metronome_.get();
+  call_config.video_decode_scheduler = context_->video_decode_scheduler();
   return std::unique_ptr<Call>(
       context_->call_factory()->CreateCall(call_config));
 }
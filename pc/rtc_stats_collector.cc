@@ -2121,6 +2121,9 @@ void RTCStatsCollector::ProduceTransportStats_n(
           certificate_stats_it->second.remote->fingerprint);
     }
 
+    const absl::optional<rtc::CopyOnWriteBufferPool::Stats>&
+        receive_buffer_stats = transport_stats.receive_buffer_stats;
+
     // There is one transport stats for each channel.
     for (const cricket::TransportChannelStats& channel_stats :
          transport_stats.channel_stats) {
@@ -2157,6 +2160,13 @@ void RTCStatsCollector::ProduceTransportStats_n(
           !rtcp_transport_stats_id.empty()) {
         transport_stats->rtcp_transport_stats_id = rtcp_transport_stats_id;
       }
+      if (channel_stats.component == cricket::ICE_CANDIDATE_COMPONENT_RTP &&
+          receive_buffer_stats) {
+        transport_stats->receive_buffer_allocations =
+            receive_buffer_stats->allocations;
+        transport_stats->receive_buffer_reuses =
+            receive_buffer_stats->reuses;
+      }
       if (!local_certificate_id.empty())
         transport_stats->local_certificate_id = local_certificate_id;
       if (!remote_certificate_id.empty())
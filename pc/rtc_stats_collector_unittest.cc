@@ -2642,6 +2642,46 @@ TEST_F(RTCStatsCollectorTest, CollectRTCTransportStats) {
       report->Get(expected_rtcp_transport.id())->cast_to<RTCTransportStats>());
 }
 
+TEST_F(RTCStatsCollectorTest, CollectRTCTransportStatsWithReceiveBufferStats) {
+  const char kTransportName[] = "transport";
+
+  pc_->AddVoiceChannel("audio", kTransportName);
+
+  cricket::TransportChannelStats rtp_transport_channel_stats;
+  rtp_transport_channel_stats.component = cricket::ICE_CANDIDATE_COMPONENT_RTP;
+  rtp_transport_channel_stats.dtls_state = DtlsTransportState::kNew;
+  cricket::TransportChannelStats rtcp_transport_channel_stats;
+  rtcp_transport_channel_stats.component =
+      cricket::ICE_CANDIDATE_COMPONENT_RTCP;
+  rtcp_transport_channel_stats.dtls_state = DtlsTransportState::kNew;
+  cricket::TransportStats transport_stats;
+  transport_stats.transport_name = kTransportName;
+  transport_stats.channel_stats = {rtp_transport_channel_stats,
+                                   rtcp_transport_channel_stats};
+  transport_stats.receive_buffer_stats.emplace();
+  transport_stats.receive_buffer_stats->allocations = 7;
+  transport_stats.receive_buffer_stats->reuses = 1000;
+  pc_->SetTransportStats(transport_stats);
+
+  rtc::scoped_refptr<const RTCStatsReport> report = stats_->GetStatsReport();
+
+  const RTCStats* rtp_transport = report->Get(
+      "RTCTransport_transport_" +
+      rtc::ToString(cricket::ICE_CANDIDATE_COMPONENT_RTP));
+  ASSERT_TRUE(rtp_transport);
+  const auto& rtp_transport_stats = rtp_transport->cast_to<RTCTransportStats>();
+  EXPECT_EQ(*rtp_transport_stats.receive_buffer_allocations, 7u);
+  EXPECT_EQ(*rtp_transport_stats.receive_buffer_reuses, 1000u);
+
+  // The pool is shared by both components, so it is only reported once.
+  const RTCStats* rtcp_transport = report->Get(
+      "RTCTransport_transport_" +
+      rtc::ToString(cricket::ICE_CANDIDATE_COMPONENT_RTCP));
+  ASSERT_TRUE(rtcp_transport);
+  EXPECT_FALSE(rtcp_transport->cast_to<RTCTransportStats>()
+                   .receive_buffer_allocations.is_defined());
+}
+
 TEST_F(RTCStatsCollectorTest, CollectRTCTransportStatsWithCrypto) {
   const char kTransportName[] = "transport";
 
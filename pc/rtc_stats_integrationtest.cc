@@ -1131,6 +1131,9 @@ class RTCStatsReportVerifier {
     verifier.TestMemberIsDefined(transport.ice_role);
     verifier.TestMemberIsDefined(transport.ice_local_username_fragment);
     verifier.TestMemberIsDefined(transport.ice_state);
+    verifier.TestMemberIsNonNegative<uint64_t>(
+        transport.receive_buffer_allocations);
+    verifier.TestMemberIsNonNegative<uint64_t>(transport.receive_buffer_reuses);
     return verifier.ExpectAllMembersSuccessfullyTested();
   }
 
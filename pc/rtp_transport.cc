@@ -27,6 +27,17 @@
 
 namespace webrtc {
 
+namespace {
+// Upper bound on the number of received packets that are typically alive at
+// the same time, e.g. waiting in the video packet buffer for the rest of their
+// frame. Storage released beyond this is freed.
+constexpr size_t kMaxFreeReceiveBuffers = 512;
+}  // namespace
+
+RtpTransport::RtpTransport(bool rtcp_mux_enabled)
+    : rtcp_mux_enabled_(rtcp_mux_enabled),
+      receive_buffer_pool_(cricket::kMaxRtpPacketLen, kMaxFreeReceiveBuffers) {}
+
 void RtpTransport::SetRtcpMuxEnabled(bool enable) {
   rtcp_mux_enabled_ = enable;
   MaybeSignalReadyToSend();
@@ -228,9 +239,13 @@ void RtpTransport::OnSentPacket(rtc::PacketTransportInternal* packet_transport,
   SignalSentPacket(sent_packet);
 }
 
+rtc::CopyOnWriteBufferPool::Stats RtpTransport::GetReceiveBufferStats() const {
+  return receive_buffer_pool_.GetStats();
+}
+
 void RtpTransport::OnRtpPacketReceived(rtc::CopyOnWriteBuffer packet,
                                        int64_t packet_time_us) {
-  DemuxPacket(packet, packet_time_us);
+  DemuxPacket(std::move(packet), packet_time_us);
 }
 
 void RtpTransport::OnRtcpPacketReceived(rtc::CopyOnWriteBuffer packet,
@@ -262,7 +277,7 @@ void RtpTransport::OnReadPacket(rtc::PacketTransportInternal* transport,
     return;
   }
 
-  rtc::CopyOnWriteBuffer packet(data, len);
+  rtc::CopyOnWriteBuffer packet = receive_buffer_pool_.Allocate(data, len);
   if (packet_type == cricket::RtpPacketType::kRtcp) {
     OnRtcpPacketReceived(std::move(packet), packet_time_us);
   } else {
@@ -25,6 +25,7 @@
 #include "pc/session_description.h"
 #include "rtc_base/async_packet_socket.h"
 #include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/copy_on_write_buffer_pool.h"
 #include "rtc_base/network/sent_packet.h"
 #include "rtc_base/network_route.h"
 #include "rtc_base/socket.h"
@@ -44,8 +45,7 @@ class RtpTransport : public RtpTransportInternal {
   RtpTransport(const RtpTransport&) = delete;
   RtpTransport& operator=(const RtpTransport&) = delete;
 
-  explicit RtpTransport(bool rtcp_mux_enabled)
-      : rtcp_mux_enabled_(rtcp_mux_enabled) {}
+  explicit RtpTransport(bool rtcp_mux_enabled);
 
   bool rtcp_mux_enabled() const override { return rtcp_mux_enabled_; }
   void SetRtcpMuxEnabled(bool enable) override;
@@ -87,6 +87,8 @@ class RtpTransport : public RtpTransportInternal {
 
   bool UnregisterRtpDemuxerSink(RtpPacketSinkInterface* sink) override;
 
+  rtc::CopyOnWriteBufferPool::Stats GetReceiveBufferStats() const override;
+
  protected:
   // These methods will be used in the subclasses.
   void DemuxPacket(rtc::CopyOnWriteBuffer packet, int64_t packet_time_us);
@@ -137,6 +139,11 @@ class RtpTransport : public RtpTransportInternal {
 
   // Used for identifying the MID for RtpDemuxer.
   RtpHeaderExtensionMap header_extension_map_;
+
+  // Received packets are copied out of the socket buffer into storage from
+  // this pool, which is then decrypted in place and shared with the parsed
+  // packet, so that steady-state receiving does not allocate.
+  rtc::CopyOnWriteBufferPool receive_buffer_pool_;
 };
 
 }  // namespace webrtc
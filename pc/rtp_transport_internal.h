@@ -16,6 +16,7 @@
 #include "call/rtp_demuxer.h"
 #include "p2p/base/ice_transport_internal.h"
 #include "pc/session_description.h"
+#include "rtc_base/copy_on_write_buffer_pool.h"
 #include "rtc_base/network_route.h"
 #include "rtc_base/ssl_stream_adapter.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
@@ -98,6 +99,10 @@ class RtpTransportInternal : public sigslot::has_slots<> {
                                       RtpPacketSinkInterface* sink) = 0;
 
   virtual bool UnregisterRtpDemuxerSink(RtpPacketSinkInterface* sink) = 0;
+
+  // Returns the allocation counters of the pool that received RTP and RTCP
+  // packets are stored in.
+  virtual rtc::CopyOnWriteBufferPool::Stats GetReceiveBufferStats() const = 0;
 };
 
 }  // namespace webrtc
@@ -316,4 +316,32 @@ TEST(RtpTransportTest, DontSignalUnhandledRtpPayloadType) {
   transport.UnregisterRtpDemuxerSink(&observer);
 }
 
+// Test that received packets are stored in pooled buffers, which are reused
+// once the previous packets have been released.
+TEST(RtpTransportTest, ReusesReceiveBuffers) {
+  RtpTransport transport(kMuxDisabled);
+  rtc::FakePacketTransport fake_rtp("fake_rtp");
+  fake_rtp.SetDestination(&fake_rtp, true);
+  transport.SetRtpPacketTransport(&fake_rtp);
+  TransportObserver observer(&transport);
+  RtpDemuxerCriteria demuxer_criteria;
+  demuxer_criteria.payload_types().insert(0x11);
+  transport.RegisterRtpDemuxerSink(demuxer_criteria, &observer);
+
+  const rtc::PacketOptions options;
+  const int flags = 0;
+  rtc::Buffer rtp_data(kRtpData, kRtpLen);
+  for (int i = 0; i < 3; ++i) {
+    fake_rtp.SendPacket(rtp_data.data<char>(), kRtpLen, options, flags);
+  }
+  EXPECT_EQ(3, observer.rtp_count());
+  // The observer holds on to the last packet, so two buffers are in use when
+  // the second packet arrives. The third packet reuses the first buffer.
+  rtc::CopyOnWriteBufferPool::Stats stats = transport.GetReceiveBufferStats();
+  EXPECT_EQ(stats.allocations, 2u);
+  EXPECT_EQ(stats.reuses, 1u);
+  // Remove the sink before destroying the transport.
+  transport.UnregisterRtpDemuxerSink(&observer);
+}
+
 }  // namespace webrtc
@@ -25,6 +25,7 @@
 #include "rtc_base/byte_order.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/numerics/safe_conversions.h"
 #include "rtc_base/ssl_stream_adapter.h"
 #include "rtc_base/string_encode.h"
 #include "rtc_base/thread_annotations.h"
@@ -207,6 +208,55 @@ bool SrtpSession::ProtectRtp(void* p,
   return (index) ? GetSendStreamPacketIndex(p, in_len, index) : true;
 }
 
+size_t SrtpSession::ProtectRtpBatch(
+    rtc::ArrayView<rtc::CopyOnWriteBuffer*> packets) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  if (!session_) {
+    RTC_LOG(LS_WARNING) << "Failed to protect SRTP packets: no SRTP Session";
+    for (rtc::CopyOnWriteBuffer* packet : packets) {
+      packet->Clear();
+    }
+    return 0;
+  }
+
+  size_t protected_packets = 0;
+  int first_error = srtp_err_status_ok;
+  int first_failed_seq_num = -1;
+  for (rtc::CopyOnWriteBuffer* packet : packets) {
+    const int in_len = rtc::checked_cast<int>(packet->size());
+    // See ProtectRtp() for why this is enough space.
+    packet->EnsureCapacity(packet->size() + rtp_auth_tag_len_);
+    uint8_t* data = packet->MutableData();
+    if (dump_plain_rtp_) {
+      DumpPacket(data, in_len, /*outbound=*/true);
+    }
+    const int seq_num =
+        ParseRtpSequenceNumber(rtc::MakeArrayView(data, in_len));
+    int out_len = in_len;
+    int err = srtp_protect(session_, data, &out_len);
+    if (err != srtp_err_status_ok) {
+      if (first_error == srtp_err_status_ok) {
+        first_error = err;
+        first_failed_seq_num = seq_num;
+      }
+      packet->Clear();
+      continue;
+    }
+    packet->SetSize(out_len);
+    last_send_seq_num_ = seq_num;
+    ++protected_packets;
+  }
+  if (first_error != srtp_err_status_ok) {
+    RTC_LOG(LS_WARNING) << "Failed to protect "
+                        << packets.size() - protected_packets << " of "
+                        << packets.size()
+                        << " SRTP packets, first seqnum=" << first_failed_seq_num
+                        << ", err=" << first_error
+                        << ", last seqnum=" << last_send_seq_num_;
+  }
+  return protected_packets;
+}
+
 bool SrtpSession::ProtectRtcp(void* p, int in_len, int max_len, int* out_len) {
   RTC_DCHECK(thread_checker_.IsCurrent());
   if (!session_) {
@@ -266,6 +316,55 @@ bool SrtpSession::UnprotectRtp(void* p, int in_len, int* out_len) {
   return true;
 }
 
+size_t SrtpSession::UnprotectRtpBatch(
+    rtc::ArrayView<rtc::CopyOnWriteBuffer*> packets) {
+  RTC_DCHECK(thread_checker_.IsCurrent());
+  if (!session_) {
+    RTC_LOG(LS_WARNING) << "Failed to unprotect SRTP packets: no SRTP Session";
+    for (rtc::CopyOnWriteBuffer* packet : packets) {
+      packet->Clear();
+    }
+    return 0;
+  }
+
+  size_t unprotected_packets = 0;
+  int first_error = srtp_err_status_ok;
+  for (rtc::CopyOnWriteBuffer* packet : packets) {
+    uint8_t* data = packet->MutableData();
+    int out_len = rtc::checked_cast<int>(packet->size());
+    int err = srtp_unprotect(session_, data, &out_len);
+    if (err != srtp_err_status_ok) {
+      if (first_error == srtp_err_status_ok) {
+        first_error = err;
+      }
+      RTC_HISTOGRAM_ENUMERATION("WebRTC.PeerConnection.SrtpUnprotectError",
+                                static_cast<int>(err), kSrtpErrorCodeBoundary);
+      packet->Clear();
+      continue;
+    }
+    packet->SetSize(out_len);
+    if (dump_plain_rtp_) {
+      DumpPacket(data, out_len, /*outbound=*/false);
+    }
+    ++unprotected_packets;
+  }
+  if (first_error != srtp_err_status_ok) {
+    // Limit the error logging to avoid excessive logs when there are lots of
+    // bad packets.
+    const int kFailureLogThrottleCount = 100;
+    const int failures = static_cast<int>(packets.size() - unprotected_packets);
+    if (decryption_failure_count_ / kFailureLogThrottleCount !=
+        (decryption_failure_count_ + failures) / kFailureLogThrottleCount) {
+      RTC_LOG(LS_WARNING) << "Failed to unprotect " << failures << " of "
+                          << packets.size() << " SRTP packets, err="
+                          << first_error << ", previous failure count: "
+                          << decryption_failure_count_;
+    }
+    decryption_failure_count_ += failures;
+  }
+  return unprotected_packets;
+}
+
 bool SrtpSession::UnprotectRtcp(void* p, int in_len, int* out_len) {
   RTC_DCHECK(thread_checker_.IsCurrent());
   if (!session_) {
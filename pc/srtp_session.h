@@ -17,8 +17,10 @@
 #include <vector>
 
 #include "api/field_trials_view.h"
+#include "api/array_view.h"
 #include "api/scoped_refptr.h"
 #include "api/sequence_checker.h"
+#include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/synchronization/mutex.h"
 
 // Forward declaration to avoid pulling in libsrtp headers here
@@ -79,6 +81,14 @@ class SrtpSession {
   bool UnprotectRtp(void* data, int in_len, int* out_len);
   bool UnprotectRtcp(void* data, int in_len, int* out_len);
 
+  // Encrypts/signs or decrypts/verifies a batch of RTP packets in-place,
+  // resizing each buffer to its new length. The session checks, logging and
+  // statistics are done once per batch rather than once per packet. Packets
+  // that fail are cleared to zero size. Returns the number of packets that
+  // were processed successfully.
+  size_t ProtectRtpBatch(rtc::ArrayView<rtc::CopyOnWriteBuffer*> packets);
+  size_t UnprotectRtpBatch(rtc::ArrayView<rtc::CopyOnWriteBuffer*> packets);
+
   // Helper method to get authentication params.
   bool GetRtpAuthParams(uint8_t** key, int* key_len, int* tag_len);
 
@@ -0,0 +1,123 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "pc/srtp_session.h"
+#include "rtc_base/byte_order.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/ssl_stream_adapter.h"
+#include "test/scoped_key_value_config.h"
+
+namespace cricket {
+namespace {
+
+constexpr size_t kPacketSize = 1200;
+constexpr size_t kRtpHeaderSize = 12;
+// Large enough for both the HMAC-SHA1-80 and the AES-GCM auth tag.
+constexpr size_t kMaxAuthTagSize = 16;
+
+// 30 bytes for AES_CM (128 bit key + 112 bit salt), 28 bytes for AES-GCM
+// (128 bit key + 96 bit salt).
+constexpr uint8_t kKey[] = "0123456789ABCDEFGHIJKLMNOPQRST";
+
+int KeyLength(int crypto_suite) {
+  return crypto_suite == rtc::kSrtpAeadAes128Gcm ? 28 : 30;
+}
+
+// Fills `packets` with RTP packets with consecutive sequence numbers starting
+// at `first_seq_num`, with capacity for the SRTP auth tag.
+void FillPackets(uint16_t first_seq_num,
+                 std::vector<rtc::CopyOnWriteBuffer>& packets) {
+  for (size_t i = 0; i < packets.size(); ++i) {
+    rtc::CopyOnWriteBuffer& packet = packets[i];
+    packet.SetSize(0);
+    packet.EnsureCapacity(kPacketSize + kMaxAuthTagSize);
+    packet.SetSize(kPacketSize);
+    uint8_t* data = packet.MutableData();
+    memset(data, 0xab, kPacketSize);
+    data[0] = 0x80;
+    data[1] = 111;
+    rtc::SetBE16(data + 2, static_cast<uint16_t>(first_seq_num + i));
+    rtc::SetBE32(data + 4, 0x1234);
+    rtc::SetBE32(data + 8, 0x5678);
+  }
+}
+
+// Protects and unprotects a burst of `state.range(1)` packets per iteration,
+// either one call per packet (`batched` false) or one call per burst.
+void RunProtectUnprotect(benchmark::State& state, bool batched) {
+  const int crypto_suite = static_cast<int>(state.range(0));
+  const size_t burst_size = static_cast<size_t>(state.range(1));
+  webrtc::test::ScopedKeyValueConfig field_trials;
+  SrtpSession sender(field_trials);
+  SrtpSession receiver(field_trials);
+  RTC_CHECK(sender.SetSend(crypto_suite, kKey, KeyLength(crypto_suite), {}));
+  RTC_CHECK(receiver.SetRecv(crypto_suite, kKey, KeyLength(crypto_suite), {}));
+
+  std::vector<rtc::CopyOnWriteBuffer> packets(burst_size);
+  std::vector<rtc::CopyOnWriteBuffer*> batch;
+  for (rtc::CopyOnWriteBuffer& packet : packets) {
+    batch.push_back(&packet);
+  }
+  uint16_t seq_num = 1;
+  for (auto _ : state) {
+    // The receiver rejects replayed packets, so every burst needs new sequence
+    // numbers.
+    state.PauseTiming();
+    FillPackets(seq_num, packets);
+    seq_num += burst_size;
+    state.ResumeTiming();
+
+    if (batched) {
+      RTC_CHECK_EQ(sender.ProtectRtpBatch(batch), burst_size);
+      RTC_CHECK_EQ(receiver.UnprotectRtpBatch(batch), burst_size);
+      continue;
+    }
+    for (rtc::CopyOnWriteBuffer& packet : packets) {
+      int len = static_cast<int>(packet.size());
+      RTC_CHECK(sender.ProtectRtp(packet.MutableData(), len,
+                                  static_cast<int>(packet.capacity()), &len));
+      RTC_CHECK(receiver.UnprotectRtp(packet.MutableData(), len, &len));
+      packet.SetSize(len);
+    }
+  }
+  RTC_CHECK_GT(packets[0].size(), kRtpHeaderSize);
+  state.SetItemsProcessed(state.iterations() * burst_size);
+  state.SetBytesProcessed(state.iterations() * burst_size * kPacketSize);
+}
+
+void BM_SrtpProtectUnprotectSingle(benchmark::State& state) {
+  RunProtectUnprotect(state, /*batched=*/false);
+}
+
+void BM_SrtpProtectUnprotectBatch(benchmark::State& state) {
+  RunProtectUnprotect(state, /*batched=*/true);
+}
+
+void BurstArguments(benchmark::internal::Benchmark* benchmark) {
+  for (int crypto_suite :
+       {rtc::kSrtpAes128CmSha1_80, rtc::kSrtpAeadAes128Gcm}) {
+    for (int burst_size : {1, 8, 32}) {
+      benchmark->Args({crypto_suite, burst_size});
+    }
+  }
+}
+
+BENCHMARK(BM_SrtpProtectUnprotectSingle)->Apply(BurstArguments);
+BENCHMARK(BM_SrtpProtectUnprotectBatch)->Apply(BurstArguments);
+
+}  // namespace
+}  // namespace cricket
@@ -13,10 +13,13 @@
 #include <string.h>
 
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "media/base/fake_rtp.h"
 #include "pc/test/srtp_test_util.h"
 #include "rtc_base/byte_order.h"
+#include "rtc_base/copy_on_write_buffer.h"
 #include "rtc_base/ssl_stream_adapter.h"  // For rtc::SRTP_*
 #include "system_wrappers/include/metrics.h"
 #include "test/gmock.h"
@@ -251,4 +254,73 @@ TEST_F(SrtpSessionTest, TestReplay) {
       s1_.ProtectRtp(rtp_packet_, rtp_len_, sizeof(rtp_packet_), &out_len));
 }
 
+// Test that a batch of RTP packets round-trips through the batch API and
+// produces the same output as protecting the packets one by one.
+TEST_F(SrtpSessionTest, TestProtectUnprotectRtpBatch) {
+  EXPECT_TRUE(s1_.SetSend(kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  EXPECT_TRUE(s2_.SetRecv(kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  constexpr int kNumPackets = 8;
+  std::vector<CopyOnWriteBuffer> packets;
+  for (int i = 0; i < kNumPackets; ++i) {
+    CopyOnWriteBuffer packet(kPcmuFrame, sizeof(kPcmuFrame));
+    SetBE16(packet.MutableData() + 2, i + 1);
+    packets.push_back(std::move(packet));
+  }
+  std::vector<CopyOnWriteBuffer*> batch;
+  for (CopyOnWriteBuffer& packet : packets) {
+    batch.push_back(&packet);
+  }
+
+  EXPECT_EQ(s1_.ProtectRtpBatch(batch), static_cast<size_t>(kNumPackets));
+  for (const CopyOnWriteBuffer& packet : packets) {
+    EXPECT_EQ(packet.size(),
+              sizeof(kPcmuFrame) + rtp_auth_tag_len(kCsAesCm128HmacSha1_80));
+  }
+
+  EXPECT_EQ(s2_.UnprotectRtpBatch(batch), static_cast<size_t>(kNumPackets));
+  for (int i = 0; i < kNumPackets; ++i) {
+    ASSERT_EQ(packets[i].size(), sizeof(kPcmuFrame));
+    EXPECT_EQ(GetBE16(packets[i].data() + 2), i + 1);
+    EXPECT_EQ(0, memcmp(packets[i].data() + 4, kPcmuFrame + 4,
+                        sizeof(kPcmuFrame) - 4));
+  }
+}
+
+// Test that a packet failing authentication only drops that packet from the
+// batch.
+TEST_F(SrtpSessionTest, TestUnprotectRtpBatchRejectsTamperedPacket) {
+  EXPECT_TRUE(s1_.SetSend(kSrtpAes128CmSha1_32, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  EXPECT_TRUE(s2_.SetRecv(kSrtpAes128CmSha1_32, kTestKey1, kTestKeyLen,
+                          kEncryptedHeaderExtensionIds));
+  std::vector<CopyOnWriteBuffer> packets;
+  for (int i = 0; i < 3; ++i) {
+    CopyOnWriteBuffer packet(kPcmuFrame, sizeof(kPcmuFrame));
+    SetBE16(packet.MutableData() + 2, i + 1);
+    packets.push_back(std::move(packet));
+  }
+  std::vector<CopyOnWriteBuffer*> batch = {&packets[0], &packets[1],
+                                           &packets[2]};
+  EXPECT_EQ(s1_.ProtectRtpBatch(batch), 3u);
+
+  packets[1].MutableData()[packets[1].size() - 1] ^= 0xff;
+  EXPECT_EQ(s2_.UnprotectRtpBatch(batch), 2u);
+  EXPECT_EQ(packets[0].size(), sizeof(kPcmuFrame));
+  EXPECT_EQ(packets[1].size(), 0u);
+  EXPECT_EQ(packets[2].size(), sizeof(kPcmuFrame));
+  EXPECT_THAT(webrtc::metrics::Samples(
+                  "WebRTC.PeerConnection.SrtpUnprotectError"),
+              ElementsAre(Pair(srtp_err_status_auth_fail, 1)));
+}
+
+// Test that the batch API fails every packet when no key has been set.
+TEST_F(SrtpSessionTest, TestProtectRtpBatchWithoutSession) {
+  CopyOnWriteBuffer packet(kPcmuFrame, sizeof(kPcmuFrame));
+  std::vector<CopyOnWriteBuffer*> batch = {&packet};
+  EXPECT_EQ(s1_.ProtectRtpBatch(batch), 0u);
+  EXPECT_EQ(packet.size(), 0u);
+}
+
 }  // namespace rtc
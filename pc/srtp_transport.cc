@@ -12,11 +12,14 @@
 
 #include <string.h>
 
+#include <algorithm>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "absl/strings/match.h"
+#include "api/task_queue/pending_task_safety_flag.h"
+#include "api/task_queue/task_queue_base.h"
 #include "media/base/rtp_utils.h"
 #include "modules/rtp_rtcp/source/rtp_util.h"
 #include "pc/rtp_transport.h"
@@ -33,6 +36,11 @@
 
 namespace webrtc {
 
+namespace {
+// Matches the largest batch the UDP socket sends in one system call.
+constexpr size_t kMaxRtpBatchSize = 64;
+}  // namespace
+
 SrtpTransport::SrtpTransport(bool rtcp_mux_enabled,
                              const FieldTrialsView& field_trials)
     : RtpTransport(rtcp_mux_enabled), field_trials_(field_trials) {}
@@ -125,6 +133,35 @@ bool SrtpTransport::SendRtpPacket(rtc::CopyOnWriteBuffer* packet,
         << "Failed to send the packet because SRTP transport is inactive.";
     return false;
   }
+  // Packets that are part of a pacer burst are protected together once the
+  // last one arrives. External auth needs per-packet auth params and is
+  // always handled one packet at a time. Without a task queue to post the
+  // flush to, packets are not held back.
+  if (options.batchable && !IsExternalAuthActive() &&
+      TaskQueueBase::Current()) {
+    if (pending_rtp_packets_.empty()) {
+      // Bound how long the packets are held back, in case the last packet of
+      // the batch never arrives, e.g. because it was dropped before reaching
+      // this transport: send them once the current task is done.
+      TaskQueueBase::Current()->PostTask(
+          SafeTask(flush_task_safety_.flag(), [this] {
+            if (!pending_rtp_packets_.empty() && IsSrtpActive()) {
+              SendPendingRtpPackets();
+            }
+          }));
+    }
+    pending_rtp_packets_.push_back(
+        PendingRtpPacket{std::move(*packet), options, flags});
+    if (!options.last_packet_in_batch &&
+        pending_rtp_packets_.size() < kMaxRtpBatchSize) {
+      return true;
+    }
+    return SendPendingRtpPackets();
+  }
+  if (!pending_rtp_packets_.empty()) {
+    SendPendingRtpPackets();
+  }
+
   rtc::PacketOptions updated_options = options;
   TRACE_EVENT0("webrtc", "SRTP Encode");
   bool res;
@@ -173,6 +210,40 @@ bool SrtpTransport::SendRtpPacket(rtc::CopyOnWriteBuffer* packet,
   return SendPacket(/*rtcp=*/false, packet, updated_options, flags);
 }
 
+bool SrtpTransport::SendPendingRtpPackets() {
+  TRACE_EVENT1("webrtc", "SRTP Encode Batch", "packets",
+               pending_rtp_packets_.size());
+  // Packets held back while these are sent start a new batch.
+  sending_rtp_packets_.swap(pending_rtp_packets_);
+  rtp_batch_buffers_.clear();
+  for (PendingRtpPacket& pending_packet : sending_rtp_packets_) {
+    rtp_batch_buffers_.push_back(&pending_packet.packet);
+  }
+  bool all_sent = send_session_->ProtectRtpBatch(rtp_batch_buffers_) ==
+                  sending_rtp_packets_.size();
+  // Packets that failed to be protected are left empty and are not sent. The
+  // last packet that is sent ends the batch, so that the packet transport
+  // does not hold back the others when the batch is flushed early or its last
+  // packet failed.
+  auto last_sent = std::find_if(
+      sending_rtp_packets_.rbegin(), sending_rtp_packets_.rend(),
+      [](const PendingRtpPacket& pending_packet) {
+        return pending_packet.packet.size() != 0;
+      });
+  if (last_sent != sending_rtp_packets_.rend()) {
+    last_sent->options.last_packet_in_batch = true;
+  }
+  for (PendingRtpPacket& pending_packet : sending_rtp_packets_) {
+    if (pending_packet.packet.size() == 0) {
+      continue;
+    }
+    all_sent &= SendPacket(/*rtcp=*/false, &pending_packet.packet,
+                           pending_packet.options, pending_packet.flags);
+  }
+  sending_rtp_packets_.clear();
+  return all_sent;
+}
+
 bool SrtpTransport::SendRtcpPacket(rtc::CopyOnWriteBuffer* packet,
                                    const rtc::PacketOptions& options,
                                    int flags) {
@@ -181,6 +252,9 @@ bool SrtpTransport::SendRtcpPacket(rtc::CopyOnWriteBuffer* packet,
         << "Failed to send the packet because SRTP transport is inactive.";
     return false;
   }
+  if (!pending_rtp_packets_.empty()) {
+    SendPendingRtpPackets();
+  }
 
   TRACE_EVENT0("webrtc", "SRTP Encode");
   uint8_t* data = packet->MutableData();
@@ -282,6 +356,9 @@ bool SrtpTransport::SetRtpParams(int send_cs,
     RTC_DCHECK(!recv_session_);
     CreateSrtpSessions();
     new_sessions = true;
+  } else if (!pending_rtp_packets_.empty()) {
+    // Packets queued before the key update are sent with the old key.
+    SendPendingRtpPackets();
   }
   bool ret = new_sessions
                  ? send_session_->SetSend(send_cs, send_key, send_key_len,
@@ -352,6 +429,7 @@ bool SrtpTransport::IsWritable(bool rtcp) const {
 }
 
 void SrtpTransport::ResetParams() {
+  pending_rtp_packets_.clear();
   send_session_ = nullptr;
   recv_session_ = nullptr;
   send_rtcp_session_ = nullptr;
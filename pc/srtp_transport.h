@@ -22,6 +22,7 @@
 #include "api/crypto_params.h"
 #include "api/field_trials_view.h"
 #include "api/rtc_error.h"
+#include "api/task_queue/pending_task_safety_flag.h"
 #include "p2p/base/packet_transport_internal.h"
 #include "pc/rtp_transport.h"
 #include "pc/srtp_session.h"
@@ -44,6 +45,10 @@ class SrtpTransport : public RtpTransport {
   virtual RTCError SetSrtpSendKey(const cricket::CryptoParams& params);
   virtual RTCError SetSrtpReceiveKey(const cricket::CryptoParams& params);
 
+  // Packets with `options.batchable` set are held back until the last packet
+  // of the batch arrives, or at the latest until the current task is done,
+  // and are then protected and sent together. For a held back packet, true is
+  // returned before it is protected or sent; a later failure is only logged.
   bool SendRtpPacket(rtc::CopyOnWriteBuffer* packet,
                      const rtc::PacketOptions& options,
                      int flags) override;
@@ -129,6 +134,10 @@ class SrtpTransport : public RtpTransport {
 
   bool ProtectRtp(void* data, int in_len, int max_len, int* out_len);
 
+  // Protects and sends the RTP packets held back by SendRtpPacket() with a
+  // single call into the send session. Returns false if any of them failed.
+  bool SendPendingRtpPackets();
+
   // Overloaded version, outputs packet index.
   bool ProtectRtp(void* data,
                   int in_len,
@@ -168,6 +177,20 @@ class SrtpTransport : public RtpTransport {
 
   int decryption_failure_count_ = 0;
 
+  // Batchable RTP packets waiting for the last packet of the batch before
+  // they are protected and sent.
+  struct PendingRtpPacket {
+    rtc::CopyOnWriteBuffer packet;
+    rtc::PacketOptions options;
+    int flags;
+  };
+  std::vector<PendingRtpPacket> pending_rtp_packets_;
+  // Reused by SendPendingRtpPackets() to avoid allocating for every batch.
+  std::vector<PendingRtpPacket> sending_rtp_packets_;
+  std::vector<rtc::CopyOnWriteBuffer*> rtp_batch_buffers_;
+  // Guards the task posted to send the held back packets.
+  ScopedTaskSafetyDetached flush_task_safety_;
+
   const FieldTrialsView& field_trials_;
 };
 
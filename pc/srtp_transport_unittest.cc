@@ -26,6 +26,7 @@
 #include "rtc_base/containers/flat_set.h"
 #include "rtc_base/ssl_stream_adapter.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
+#include "rtc_base/thread.h"
 #include "test/gtest.h"
 #include "test/scoped_key_value_config.h"
 
@@ -326,6 +327,9 @@ class SrtpTransportTest : public ::testing::Test, public sigslot::has_slots<> {
     TestSendRecvPacketWithEncryptedHeaderExtension(cs_name, encrypted_headers);
   }
 
+  // Batchable packets are only held back on a task queue.
+  rtc::AutoThread main_thread_;
+
   std::unique_ptr<SrtpTransport> srtp_transport1_;
   std::unique_ptr<SrtpTransport> srtp_transport2_;
 
@@ -419,4 +423,149 @@ TEST_F(SrtpTransportTest, TestSetParamsKeyTooShort) {
       rtc::kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen - 1, extension_ids));
 }
 
+// Test that batchable packets are held back until the last packet of the
+// batch and are then protected and sent together.
+TEST_F(SrtpTransportTest, SendsBatchedRtpPacketsOnLastPacketInBatch) {
+  std::vector<int> extension_ids;
+  EXPECT_TRUE(srtp_transport1_->SetRtpParams(
+      rtc::kSrtpAeadAes128Gcm, kTestKeyGcm128_1, kTestKeyGcm128Len,
+      extension_ids, rtc::kSrtpAeadAes128Gcm, kTestKeyGcm128_2,
+      kTestKeyGcm128Len, extension_ids));
+  EXPECT_TRUE(srtp_transport2_->SetRtpParams(
+      rtc::kSrtpAeadAes128Gcm, kTestKeyGcm128_2, kTestKeyGcm128Len,
+      extension_ids, rtc::kSrtpAeadAes128Gcm, kTestKeyGcm128_1,
+      kTestKeyGcm128Len, extension_ids));
+
+  rtc::PacketOptions options;
+  options.batchable = true;
+  for (int i = 0; i < 3; ++i) {
+    rtc::CopyOnWriteBuffer packet(kPcmuFrame, sizeof(kPcmuFrame),
+                                  sizeof(kPcmuFrame) + 16);
+    rtc::SetBE16(packet.MutableData() + 2, ++sequence_number_);
+    options.last_packet_in_batch = i == 2;
+    ASSERT_TRUE(srtp_transport1_->SendRtpPacket(&packet, options,
+                                                cricket::PF_SRTP_BYPASS));
+    EXPECT_EQ(rtp_sink2_.rtp_count(), i == 2 ? 3 : 0);
+  }
+  EXPECT_EQ(rtc::GetBE16(rtp_sink2_.last_recv_rtp_packet().data() + 2),
+            sequence_number_);
+}
+
+// Test that a non-batchable packet flushes the pending batch first, keeping
+// the packets in order.
+TEST_F(SrtpTransportTest, NonBatchableRtpPacketFlushesPendingBatch) {
+  std::vector<int> extension_ids;
+  EXPECT_TRUE(srtp_transport1_->SetRtpParams(
+      rtc::kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen, extension_ids,
+      rtc::kSrtpAes128CmSha1_80, kTestKey2, kTestKeyLen, extension_ids));
+  EXPECT_TRUE(srtp_transport2_->SetRtpParams(
+      rtc::kSrtpAes128CmSha1_80, kTestKey2, kTestKeyLen, extension_ids,
+      rtc::kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen, extension_ids));
+
+  rtc::PacketOptions options;
+  options.batchable = true;
+  rtc::CopyOnWriteBuffer batched(kPcmuFrame, sizeof(kPcmuFrame),
+                                 sizeof(kPcmuFrame) + 10);
+  rtc::SetBE16(batched.MutableData() + 2, ++sequence_number_);
+  ASSERT_TRUE(srtp_transport1_->SendRtpPacket(&batched, options,
+                                              cricket::PF_SRTP_BYPASS));
+  EXPECT_EQ(rtp_sink2_.rtp_count(), 0);
+
+  rtc::CopyOnWriteBuffer single(kPcmuFrame, sizeof(kPcmuFrame),
+                                sizeof(kPcmuFrame) + 10);
+  rtc::SetBE16(single.MutableData() + 2, ++sequence_number_);
+  ASSERT_TRUE(srtp_transport1_->SendRtpPacket(&single, rtc::PacketOptions(),
+                                              cricket::PF_SRTP_BYPASS));
+  EXPECT_EQ(rtp_sink2_.rtp_count(), 2);
+  EXPECT_EQ(rtc::GetBE16(rtp_sink2_.last_recv_rtp_packet().data() + 2),
+            sequence_number_);
+}
+
+// Test that a batch whose last packet never arrives is sent once the current
+// task is done, ending with a packet marked as the last in the batch.
+TEST_F(SrtpTransportTest, SendsPendingBatchAfterCurrentTask) {
+  std::vector<int> extension_ids;
+  EXPECT_TRUE(srtp_transport1_->SetRtpParams(
+      rtc::kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen, extension_ids,
+      rtc::kSrtpAes128CmSha1_80, kTestKey2, kTestKeyLen, extension_ids));
+  EXPECT_TRUE(srtp_transport2_->SetRtpParams(
+      rtc::kSrtpAes128CmSha1_80, kTestKey2, kTestKeyLen, extension_ids,
+      rtc::kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen, extension_ids));
+
+  rtc::PacketOptions options;
+  options.batchable = true;
+  for (int i = 0; i < 2; ++i) {
+    rtc::CopyOnWriteBuffer packet(kPcmuFrame, sizeof(kPcmuFrame),
+                                  sizeof(kPcmuFrame) + 10);
+    rtc::SetBE16(packet.MutableData() + 2, ++sequence_number_);
+    ASSERT_TRUE(srtp_transport1_->SendRtpPacket(&packet, options,
+                                                cricket::PF_SRTP_BYPASS));
+  }
+  EXPECT_EQ(rtp_sink2_.rtp_count(), 0);
+
+  main_thread_.ProcessMessages(/*cms=*/0);
+  EXPECT_EQ(rtp_sink2_.rtp_count(), 2);
+  EXPECT_TRUE(
+      rtp_packet_transport1_->last_sent_packet_options().last_packet_in_batch);
+}
+
+// Test that a batch that is flushed before its last packet arrives, here by a
+// key update, still ends with a packet marked as the last in the batch.
+TEST_F(SrtpTransportTest, MarksLastSentPacketOfFlushedBatch) {
+  std::vector<int> extension_ids;
+  EXPECT_TRUE(srtp_transport1_->SetRtpParams(
+      rtc::kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen, extension_ids,
+      rtc::kSrtpAes128CmSha1_80, kTestKey2, kTestKeyLen, extension_ids));
+  EXPECT_TRUE(srtp_transport2_->SetRtpParams(
+      rtc::kSrtpAes128CmSha1_80, kTestKey2, kTestKeyLen, extension_ids,
+      rtc::kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen, extension_ids));
+
+  rtc::PacketOptions options;
+  options.batchable = true;
+  for (int i = 0; i < 2; ++i) {
+    rtc::CopyOnWriteBuffer packet(kPcmuFrame, sizeof(kPcmuFrame),
+                                  sizeof(kPcmuFrame) + 10);
+    rtc::SetBE16(packet.MutableData() + 2, ++sequence_number_);
+    ASSERT_TRUE(srtp_transport1_->SendRtpPacket(&packet, options,
+                                                cricket::PF_SRTP_BYPASS));
+  }
+  EXPECT_EQ(rtp_sink2_.rtp_count(), 0);
+
+  EXPECT_TRUE(srtp_transport1_->SetRtpParams(
+      rtc::kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen, extension_ids,
+      rtc::kSrtpAes128CmSha1_80, kTestKey2, kTestKeyLen, extension_ids));
+  EXPECT_EQ(rtp_sink2_.rtp_count(), 2);
+  EXPECT_TRUE(
+      rtp_packet_transport1_->last_sent_packet_options().last_packet_in_batch);
+}
+
+// Test that the last packet that is sent ends the batch when the packet that
+// was marked as the last one fails to be protected.
+TEST_F(SrtpTransportTest, MarksLastSentPacketWhenLastPacketInBatchFails) {
+  std::vector<int> extension_ids;
+  EXPECT_TRUE(srtp_transport1_->SetRtpParams(
+      rtc::kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen, extension_ids,
+      rtc::kSrtpAes128CmSha1_80, kTestKey2, kTestKeyLen, extension_ids));
+  EXPECT_TRUE(srtp_transport2_->SetRtpParams(
+      rtc::kSrtpAes128CmSha1_80, kTestKey2, kTestKeyLen, extension_ids,
+      rtc::kSrtpAes128CmSha1_80, kTestKey1, kTestKeyLen, extension_ids));
+
+  rtc::PacketOptions options;
+  options.batchable = true;
+  rtc::CopyOnWriteBuffer packet(kPcmuFrame, sizeof(kPcmuFrame),
+                                sizeof(kPcmuFrame) + 10);
+  rtc::SetBE16(packet.MutableData() + 2, ++sequence_number_);
+  ASSERT_TRUE(srtp_transport1_->SendRtpPacket(&packet, options,
+                                              cricket::PF_SRTP_BYPASS));
+
+  // Too short to be an RTP packet.
+  rtc::CopyOnWriteBuffer invalid(kPcmuFrame, 4, 4 + 10);
+  options.last_packet_in_batch = true;
+  EXPECT_FALSE(srtp_transport1_->SendRtpPacket(&invalid, options,
+                                               cricket::PF_SRTP_BYPASS));
+  EXPECT_EQ(rtp_sink2_.rtp_count(), 1);
+  EXPECT_TRUE(
+      rtp_packet_transport1_->last_sent_packet_options().last_packet_in_batch);
+}
+
 }  // namespace webrtc
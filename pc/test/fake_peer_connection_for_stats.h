@@ -283,6 +283,10 @@ class FakePeerConnectionForStats : public FakePeerConnectionBase {
     transport_stats_by_name_[transport_name] = transport_stats;
   }
 
+  void SetTransportStats(const cricket::TransportStats& transport_stats) {
+    transport_stats_by_name_[transport_stats.transport_name] = transport_stats;
+  }
+
   void SetCallStats(const Call::Stats& call_stats) { call_stats_ = call_stats; }
 
   void SetLocalCertificate(
@@ -14,10 +14,12 @@
 #include <string>
 #include <vector>
 
+#include "absl/types/optional.h"
 #include "api/dtls_transport_interface.h"
 #include "p2p/base/dtls_transport_internal.h"
 #include "p2p/base/ice_transport_internal.h"
 #include "p2p/base/port.h"
+#include "rtc_base/copy_on_write_buffer_pool.h"
 #include "rtc_base/ssl_stream_adapter.h"
 
 namespace cricket {
@@ -44,6 +46,9 @@ typedef std::vector<TransportChannelStats> TransportChannelStatsList;
 struct TransportStats {
   std::string transport_name;
   TransportChannelStatsList channel_stats;
+  // Allocation counters of the buffers that received RTP/RTCP packets are
+  // stored in.
+  absl::optional<rtc::CopyOnWriteBufferPool::Stats> receive_buffer_stats;
 };
 
 }  // namespace cricket
@@ -13,6 +13,7 @@
 
 #include <vector>
 
+#include "api/array_view.h"
 #include "api/sequence_checker.h"
 #include "rtc_base/callback_list.h"
 #include "rtc_base/dscp.h"
@@ -54,6 +55,25 @@ struct RTC_EXPORT PacketOptions {
   PacketTimeUpdateParams packet_time_params;
   // PacketInfo is passed to SentPacket when signaling this packet is sent.
   PacketInfo info_signaled_after_sent;
+  // True if the socket may hold this packet back and send it together with
+  // the following ones (e.g. with sendmmsg), until a packet with
+  // `last_packet_in_batch` set arrives. Sockets that do not support batching
+  // ignore both flags. A held back packet is reported as sent, with its full
+  // size, before it reaches the network, so an error when the batch is sent
+  // later is not returned to the caller; it is only logged. The packet is still
+  // signaled through SignalSentPacket.
+  bool batchable = false;
+  bool last_packet_in_batch = false;
+};
+
+// A single datagram delivered through AsyncPacketSocket::SignalReadPacketBatch.
+// `data` is only valid for the duration of the signal.
+struct ReceivedDatagram {
+  const char* data = nullptr;
+  size_t size = 0;
+  SocketAddress remote_address;
+  // Receive time in microseconds.
+  int64_t packet_time_us = -1;
 };
 
 // Provides the ability to receive packets asynchronously. Sends are not
@@ -119,6 +139,13 @@ class RTC_EXPORT AsyncPacketSocket : public sigslot::has_slots<> {
                    const int64_t&>
       SignalReadPacket;
 
+  // Emitted instead of SignalReadPacket when a socket that supports batched
+  // receive (see AsyncUDPSocket::SetBatchedReceive) has read several packets
+  // for the same readiness event. Sockets fall back to emitting
+  // SignalReadPacket once per packet when nothing is connected here.
+  sigslot::signal2<AsyncPacketSocket*, rtc::ArrayView<const ReceivedDatagram>>
+      SignalReadPacketBatch;
+
   // Emitted each time a packet is sent.
   sigslot::signal2<AsyncPacketSocket*, const SentPacket&> SignalSentPacket;
 
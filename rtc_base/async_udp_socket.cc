@@ -14,6 +14,8 @@
 
 #include <string>
 
+#include "api/task_queue/pending_task_safety_flag.h"
+#include "api/task_queue/task_queue_base.h"
 #include "rtc_base/checks.h"
 #include "rtc_base/logging.h"
 #include "rtc_base/network/sent_packet.h"
@@ -22,7 +24,7 @@
 
 namespace rtc {
 
-static const int BUF_SIZE = 64 * 1024;
+static const int BUF_SIZE = AsyncUDPSocket::kMaxDatagramSize;
 
 AsyncUDPSocket* AsyncUDPSocket::Create(Socket* socket,
                                        const SocketAddress& bind_address) {
@@ -52,6 +54,9 @@ AsyncUDPSocket::AsyncUDPSocket(Socket* socket) : socket_(socket) {
 }
 
 AsyncUDPSocket::~AsyncUDPSocket() {
+  // The posted flush is cancelled by `flush_task_safety_`, so send the held
+  // back packets now rather than dropping them.
+  SendPendingPackets();
   delete[] buf_;
 }
 
@@ -66,6 +71,7 @@ SocketAddress AsyncUDPSocket::GetRemoteAddress() const {
 int AsyncUDPSocket::Send(const void* pv,
                          size_t cb,
                          const rtc::PacketOptions& options) {
+  SendPendingPackets();
   rtc::SentPacket sent_packet(options.packet_id, rtc::TimeMillis(),
                               options.info_signaled_after_sent);
   CopySocketInformationToPacketInfo(cb, *this, false, &sent_packet.info);
@@ -78,6 +84,35 @@ int AsyncUDPSocket::SendTo(const void* pv,
                            size_t cb,
                            const SocketAddress& addr,
                            const rtc::PacketOptions& options) {
+  // Without a task queue to post the flush to, packets are not held back.
+  if (options.batchable && webrtc::TaskQueueBase::Current()) {
+    if (!pending_packets_.empty() && addr != pending_send_address_) {
+      SendPendingPackets();
+    }
+    pending_send_address_ = addr;
+    if (pending_packets_.empty()) {
+      // Bound how long the packets are held back, in case the end of the
+      // batch is never signaled: send them once the current task is done.
+      webrtc::TaskQueueBase::Current()->PostTask(webrtc::SafeTask(
+          flush_task_safety_.flag(), [this] { SendPendingPackets(); }));
+    }
+    PendingPacket pending;
+    pending.offset = pending_send_buffer_.size();
+    pending.size = cb;
+    pending.packet_id = options.packet_id;
+    pending.info = options.info_signaled_after_sent;
+    CopySocketInformationToPacketInfo(cb, *this, true, &pending.info);
+    const uint8_t* data = static_cast<const uint8_t*>(pv);
+    pending_send_buffer_.insert(pending_send_buffer_.end(), data, data + cb);
+    pending_packets_.push_back(pending);
+    if (!options.last_packet_in_batch &&
+        pending_packets_.size() < kMaxSendBatchSize) {
+      return static_cast<int>(cb);
+    }
+    return SendPendingPackets() < 0 ? -1 : static_cast<int>(cb);
+  }
+
+  SendPendingPackets();
   rtc::SentPacket sent_packet(options.packet_id, rtc::TimeMillis(),
                               options.info_signaled_after_sent);
   CopySocketInformationToPacketInfo(cb, *this, true, &sent_packet.info);
@@ -86,7 +121,46 @@ int AsyncUDPSocket::SendTo(const void* pv,
   return ret;
 }
 
+int AsyncUDPSocket::SendPendingPackets() {
+  if (pending_packets_.empty()) {
+    return 0;
+  }
+  pending_packet_views_.clear();
+  for (const PendingPacket& pending : pending_packets_) {
+    pending_packet_views_.emplace_back(&pending_send_buffer_[pending.offset],
+                                       pending.size);
+  }
+  size_t sent = 0;
+  int ret = 0;
+  while (sent < pending_packet_views_.size()) {
+    ret = socket_->SendToBatch(
+        rtc::ArrayView<const rtc::ArrayView<const uint8_t>>(
+            pending_packet_views_)
+            .subview(sent),
+        pending_send_address_);
+    if (ret <= 0) {
+      break;
+    }
+    sent += ret;
+  }
+  if (sent < pending_packets_.size()) {
+    RTC_LOG(LS_VERBOSE) << "AsyncUDPSocket dropped "
+                        << pending_packets_.size() - sent
+                        << " batched packets, error " << socket_->GetError();
+  }
+
+  // Like SendTo(), signal every packet, sent or not.
+  const int64_t now_ms = rtc::TimeMillis();
+  for (const PendingPacket& pending : pending_packets_) {
+    SignalSentPacket(this, SentPacket(pending.packet_id, now_ms, pending.info));
+  }
+  pending_packets_.clear();
+  pending_send_buffer_.clear();
+  return sent > 0 ? static_cast<int>(sent) : ret;
+}
+
 int AsyncUDPSocket::Close() {
+  SendPendingPackets();
   return socket_->Close();
 }
 
@@ -110,8 +184,31 @@ void AsyncUDPSocket::SetError(int error) {
   return socket_->SetError(error);
 }
 
+void AsyncUDPSocket::SetBatchedReceive(size_t max_datagrams,
+                                       size_t max_datagram_size) {
+  RTC_DCHECK_GE(max_datagrams, 1);
+  RTC_DCHECK_GE(max_datagram_size, 1);
+  if (max_datagrams <= 1) {
+    batch_buffer_.clear();
+    batch_slots_.clear();
+    batch_datagrams_.clear();
+    return;
+  }
+  batch_buffer_.resize(max_datagrams * max_datagram_size);
+  batch_slots_.resize(max_datagrams);
+  batch_datagrams_.reserve(max_datagrams);
+  for (size_t i = 0; i < max_datagrams; ++i) {
+    batch_slots_[i].buffer = &batch_buffer_[i * max_datagram_size];
+    batch_slots_[i].capacity = max_datagram_size;
+  }
+}
+
 void AsyncUDPSocket::OnReadEvent(Socket* socket) {
   RTC_DCHECK(socket_.get() == socket);
+  if (!batch_slots_.empty()) {
+    ReadBatch();
+    return;
+  }
 
   SocketAddress remote_addr;
   int64_t timestamp;
@@ -133,6 +230,46 @@ void AsyncUDPSocket::OnReadEvent(Socket* socket) {
                    (timestamp > -1 ? timestamp : TimeMicros()));
 }
 
+void AsyncUDPSocket::ReadBatch() {
+  int count = socket_->RecvFromBatch(batch_slots_);
+  if (count < 0) {
+    SocketAddress local_addr = socket_->GetLocalAddress();
+    RTC_LOG(LS_INFO) << "AsyncUDPSocket[" << local_addr.ToSensitiveString()
+                     << "] batched receive failed with error "
+                     << socket_->GetError();
+    return;
+  }
+
+  batch_datagrams_.clear();
+  for (int i = 0; i < count; ++i) {
+    const Socket::ReceiveSlot& slot = batch_slots_[i];
+    if (slot.truncated) {
+      RTC_LOG(LS_WARNING) << "Dropping datagram larger than "
+                          << slot.capacity << " bytes.";
+      continue;
+    }
+    ReceivedDatagram datagram;
+    datagram.data = static_cast<const char*>(slot.buffer);
+    datagram.size = slot.size;
+    datagram.remote_address = slot.addr;
+    datagram.packet_time_us =
+        slot.timestamp > -1 ? slot.timestamp : TimeMicros();
+    batch_datagrams_.push_back(datagram);
+  }
+  if (batch_datagrams_.empty()) {
+    return;
+  }
+
+  if (!SignalReadPacketBatch.is_empty()) {
+    SignalReadPacketBatch(this, batch_datagrams_);
+    return;
+  }
+  for (const ReceivedDatagram& datagram : batch_datagrams_) {
+    SignalReadPacket(this, datagram.data, datagram.size,
+                     datagram.remote_address, datagram.packet_time_us);
+  }
+}
+
 void AsyncUDPSocket::OnWriteEvent(Socket* socket) {
   SignalReadyToSend(this);
 }
@@ -14,7 +14,9 @@
 #include <stddef.h>
 
 #include <memory>
+#include <vector>
 
+#include "api/task_queue/pending_task_safety_flag.h"
 #include "rtc_base/async_packet_socket.h"
 #include "rtc_base/socket.h"
 #include "rtc_base/socket_address.h"
@@ -55,15 +57,56 @@ class AsyncUDPSocket : public AsyncPacketSocket {
   int GetError() const override;
   void SetError(int error) override;
 
+  // Enables reading up to `max_datagrams` datagrams per readiness event, each
+  // of at most `max_datagram_size` bytes. Larger datagrams are dropped. The
+  // datagrams are delivered through SignalReadPacketBatch if it has
+  // listeners, otherwise through SignalReadPacket one at a time. Passing 1
+  // restores the default single-datagram behavior.
+  void SetBatchedReceive(size_t max_datagrams,
+                         size_t max_datagram_size = kMaxDatagramSize);
+
+  static constexpr size_t kMaxDatagramSize = 64 * 1024;
+  // Maximum number of packets held back by SendTo() calls with
+  // PacketOptions::batchable set before they are sent anyway. Held back
+  // packets are also sent when the task that queued the first of them is
+  // done, so they are never delayed past the end of the current task.
+  static constexpr size_t kMaxSendBatchSize = 64;
+
  private:
   // Called when the underlying socket is ready to be read from.
   void OnReadEvent(Socket* socket);
   // Called when the underlying socket is ready to send.
   void OnWriteEvent(Socket* socket);
+  void ReadBatch();
+  // Sends the packets held back by batchable SendTo() calls. Returns the
+  // number of packets sent, or a negative value if none could be sent.
+  int SendPendingPackets();
+
+  struct PendingPacket {
+    size_t offset;
+    size_t size;
+    int64_t packet_id;
+    PacketInfo info;
+  };
 
   std::unique_ptr<Socket> socket_;
   char* buf_;
   size_t size_;
+
+  // Only used when batched receive is enabled.
+  std::vector<char> batch_buffer_;
+  std::vector<Socket::ReceiveSlot> batch_slots_;
+  std::vector<ReceivedDatagram> batch_datagrams_;
+
+  // Packets held back by batchable SendTo() calls, all to
+  // `pending_send_address_`, stored back to back in `pending_send_buffer_`.
+  SocketAddress pending_send_address_;
+  std::vector<uint8_t> pending_send_buffer_;
+  std::vector<PendingPacket> pending_packets_;
+  std::vector<rtc::ArrayView<const uint8_t>> pending_packet_views_;
+  // Guards the task posted to send the held back packets, which may be
+  // posted from any thread the socket is used on.
+  webrtc::ScopedTaskSafetyDetached flush_task_safety_;
 };
 
 }  // namespace rtc
@@ -0,0 +1,106 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <memory>
+
+#include "benchmark/benchmark.h"
+#include "rtc_base/async_udp_socket.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/physical_socket_server.h"
+#include "rtc_base/third_party/sigslot/sigslot.h"
+
+namespace rtc {
+namespace {
+
+constexpr size_t kPacketSize = 1200;
+// Small enough to fit in the default receive buffer, so nothing is dropped.
+constexpr int kPacketsPerIteration = 64;
+
+class PacketCounter : public sigslot::has_slots<> {
+ public:
+  explicit PacketCounter(AsyncPacketSocket* socket) {
+    socket->SignalReadPacket.connect(this, &PacketCounter::OnReadPacket);
+  }
+
+  void ConnectBatch(AsyncPacketSocket* socket) {
+    socket->SignalReadPacketBatch.connect(this,
+                                          &PacketCounter::OnReadPacketBatch);
+  }
+
+  void OnReadPacket(AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t size,
+                    const SocketAddress& remote_addr,
+                    const int64_t& packet_time_us) {
+    ++packets;
+  }
+
+  void OnReadPacketBatch(AsyncPacketSocket* socket,
+                         rtc::ArrayView<const ReceivedDatagram> datagrams) {
+    packets += datagrams.size();
+  }
+
+  size_t packets = 0;
+};
+
+// Measures the receive side of AsyncUDPSocket over loopback. The read events
+// are signaled directly so the numbers reflect the cost of the receive
+// syscalls and packet delivery rather than the event loop. Compare
+// items_per_second (packets/s) and the CPU time per iteration between
+// BM_UdpReceive/1 (the single-datagram path) and the batched variants.
+void BM_UdpReceive(benchmark::State& state) {
+  const size_t batch_size = static_cast<size_t>(state.range(0));
+  PhysicalSocketServer pss;
+  Socket* receive_socket = pss.CreateSocket(AF_INET, SOCK_DGRAM);
+  RTC_CHECK_EQ(receive_socket->Bind(SocketAddress("127.0.0.1", 0)), 0);
+  AsyncUDPSocket receiver(receive_socket);
+  if (batch_size > 1) {
+    receiver.SetBatchedReceive(batch_size, kPacketSize);
+  }
+  PacketCounter counter(&receiver);
+  if (batch_size > 1) {
+    counter.ConnectBatch(&receiver);
+  }
+
+  std::unique_ptr<Socket> sender(pss.CreateSocket(AF_INET, SOCK_DGRAM));
+  RTC_CHECK_EQ(sender->Bind(SocketAddress("127.0.0.1", 0)), 0);
+  const SocketAddress destination = receiver.GetLocalAddress();
+  char packet[kPacketSize] = {};
+
+  size_t read_events = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    for (int i = 0; i < kPacketsPerIteration; ++i) {
+      sender->SendTo(packet, sizeof(packet), destination);
+    }
+    const size_t expected = counter.packets + kPacketsPerIteration;
+    state.ResumeTiming();
+
+    while (counter.packets < expected) {
+      const size_t before = counter.packets;
+      receive_socket->SignalReadEvent(receive_socket);
+      ++read_events;
+      if (counter.packets == before) {
+        // The kernel dropped something; don't wait for it forever.
+        break;
+      }
+    }
+  }
+  state.SetItemsProcessed(counter.packets);
+  state.counters["read_events_per_packet"] = benchmark::Counter(
+      static_cast<double>(read_events) /
+      static_cast<double>(std::max<size_t>(counter.packets, 1)));
+}
+
+BENCHMARK(BM_UdpReceive)->Arg(1)->Arg(8)->Arg(32)->Arg(64);
+
+}  // namespace
+}  // namespace rtc
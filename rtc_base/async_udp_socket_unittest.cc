@@ -12,9 +12,12 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "rtc_base/gunit.h"
 #include "rtc_base/physical_socket_server.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/thread.h"
 #include "rtc_base/virtual_socket_server.h"
 
 namespace rtc {
@@ -47,4 +50,198 @@ TEST_F(AsyncUdpSocketTest, OnWriteEvent) {
   EXPECT_TRUE(ready_to_send_);
 }
 
+class AsyncUdpSocketBatchTest : public ::testing::Test,
+                                public sigslot::has_slots<> {
+ public:
+  AsyncUdpSocketBatchTest() {
+    receiver_.reset(AsyncUDPSocket::Create(
+        &pss_, SocketAddress("127.0.0.1", 0)));
+    sender_.reset(AsyncUDPSocket::Create(&pss_, SocketAddress("127.0.0.1", 0)));
+  }
+
+  void OnReadPacket(AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t size,
+                    const SocketAddress& remote_addr,
+                    const int64_t& packet_time_us) {
+    packets_.emplace_back(data, size);
+    ++read_packet_signals_;
+  }
+
+  void OnReadPacketBatch(AsyncPacketSocket* socket,
+                         rtc::ArrayView<const ReceivedDatagram> datagrams) {
+    for (const ReceivedDatagram& datagram : datagrams) {
+      packets_.emplace_back(datagram.data, datagram.size);
+      EXPECT_EQ(datagram.remote_address, sender_->GetLocalAddress());
+      EXPECT_GT(datagram.packet_time_us, 0);
+    }
+    ++batch_signals_;
+  }
+
+  void ConnectReadPacketSignal() {
+    receiver_->SignalReadPacket.connect(this,
+                                        &AsyncUdpSocketBatchTest::OnReadPacket);
+  }
+
+  void ConnectBatchSignal() {
+    receiver_->SignalReadPacketBatch.connect(
+        this, &AsyncUdpSocketBatchTest::OnReadPacketBatch);
+  }
+
+  void SendPackets(int count) {
+    for (int i = 0; i < count; ++i) {
+      std::string packet = "packet" + std::to_string(i);
+      ASSERT_EQ(sender_->SendTo(packet.data(), packet.size(),
+                                receiver_->GetLocalAddress(), PacketOptions()),
+                static_cast<int>(packet.size()));
+    }
+  }
+
+  // Processes posted tasks and socket events until `count` packets have
+  // arrived or we give up.
+  void ReadPackets(size_t count) {
+    for (int attempts = 0; packets_.size() < count && attempts < 100;
+         ++attempts) {
+      thread_.ProcessMessages(/*cms=*/10);
+    }
+  }
+
+ protected:
+  PhysicalSocketServer pss_;
+  AutoSocketServerThread thread_{&pss_};
+  std::unique_ptr<AsyncUDPSocket> receiver_;
+  std::unique_ptr<AsyncUDPSocket> sender_;
+  std::vector<std::string> packets_;
+  int read_packet_signals_ = 0;
+  int batch_signals_ = 0;
+};
+
+TEST_F(AsyncUdpSocketBatchTest, DeliversBatchThroughBatchSignal) {
+  receiver_->SetBatchedReceive(8);
+  ConnectBatchSignal();
+  SendPackets(5);
+  ReadPackets(5);
+  ASSERT_EQ(packets_.size(), 5u);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(packets_[i], "packet" + std::to_string(i));
+  }
+  EXPECT_GE(batch_signals_, 1);
+  EXPECT_EQ(read_packet_signals_, 0);
+}
+
+TEST_F(AsyncUdpSocketBatchTest, FallsBackToReadPacketWithoutBatchListener) {
+  receiver_->SetBatchedReceive(8);
+  ConnectReadPacketSignal();
+  SendPackets(3);
+  ReadPackets(3);
+  ASSERT_EQ(packets_.size(), 3u);
+  EXPECT_EQ(read_packet_signals_, 3);
+  EXPECT_EQ(batch_signals_, 0);
+}
+
+TEST_F(AsyncUdpSocketBatchTest, HoldsBatchablePacketsUntilLastInBatch) {
+  ConnectReadPacketSignal();
+  PacketOptions options;
+  options.batchable = true;
+  for (int i = 0; i < 3; ++i) {
+    std::string packet = "packet" + std::to_string(i);
+    options.last_packet_in_batch = i == 2;
+    EXPECT_EQ(sender_->SendTo(packet.data(), packet.size(),
+                              receiver_->GetLocalAddress(), options),
+              static_cast<int>(packet.size()));
+    if (i < 2) {
+      pss_.Wait(/*cms=*/0, /*process_io=*/true);
+      EXPECT_TRUE(packets_.empty());
+    }
+  }
+  ReadPackets(3);
+  ASSERT_EQ(packets_.size(), 3u);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(packets_[i], "packet" + std::to_string(i));
+  }
+}
+
+TEST_F(AsyncUdpSocketBatchTest, NonBatchablePacketFlushesPendingBatch) {
+  ConnectReadPacketSignal();
+  PacketOptions batchable;
+  batchable.batchable = true;
+  std::string first = "first";
+  sender_->SendTo(first.data(), first.size(), receiver_->GetLocalAddress(),
+                  batchable);
+  std::string second = "second";
+  sender_->SendTo(second.data(), second.size(), receiver_->GetLocalAddress(),
+                  PacketOptions());
+  ReadPackets(2);
+  ASSERT_EQ(packets_.size(), 2u);
+  EXPECT_EQ(packets_[0], "first");
+  EXPECT_EQ(packets_[1], "second");
+}
+
+TEST_F(AsyncUdpSocketBatchTest, SendsPendingBatchAfterCurrentTask) {
+  ConnectReadPacketSignal();
+  PacketOptions options;
+  options.batchable = true;
+  for (int i = 0; i < 2; ++i) {
+    std::string packet = "packet" + std::to_string(i);
+    sender_->SendTo(packet.data(), packet.size(), receiver_->GetLocalAddress(),
+                    options);
+  }
+  pss_.Wait(/*cms=*/0, /*process_io=*/true);
+  EXPECT_TRUE(packets_.empty());
+
+  // The end of the batch is never signaled, but the packets are sent once the
+  // thread runs its posted tasks.
+  ReadPackets(2);
+  ASSERT_EQ(packets_.size(), 2u);
+  EXPECT_EQ(packets_[0], "packet0");
+  EXPECT_EQ(packets_[1], "packet1");
+}
+
+TEST_F(AsyncUdpSocketBatchTest, SendsPendingBatchOnDestruction) {
+  ConnectReadPacketSignal();
+  PacketOptions options;
+  options.batchable = true;
+  std::string packet = "packet";
+  sender_->SendTo(packet.data(), packet.size(), receiver_->GetLocalAddress(),
+                  options);
+  sender_.reset();
+  ReadPackets(1);
+  ASSERT_EQ(packets_.size(), 1u);
+  EXPECT_EQ(packets_[0], "packet");
+}
+
+TEST_F(AsyncUdpSocketBatchTest, SendsBatchablePacketsRightAwayOffTaskQueue) {
+  ConnectReadPacketSignal();
+  PacketOptions options;
+  options.batchable = true;
+  std::string packet = "packet";
+  // Without a current task queue, nothing could bound the delay.
+  PlatformThread::SpawnJoinable(
+      [&] {
+        sender_->SendTo(packet.data(), packet.size(),
+                        receiver_->GetLocalAddress(), options);
+      },
+      "Sender");
+  for (int attempts = 0; packets_.empty() && attempts < 100; ++attempts) {
+    pss_.Wait(/*cms=*/10, /*process_io=*/true);
+  }
+  ASSERT_EQ(packets_.size(), 1u);
+  EXPECT_EQ(packets_[0], "packet");
+}
+
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+// Truncation is only detected by the recvmmsg() based implementation.
+TEST_F(AsyncUdpSocketBatchTest, DropsTruncatedDatagrams) {
+  receiver_->SetBatchedReceive(8, /*max_datagram_size=*/8);
+  ConnectBatchSignal();
+  std::string large(100, 'x');
+  sender_->SendTo(large.data(), large.size(), receiver_->GetLocalAddress(),
+                  PacketOptions());
+  SendPackets(1);
+  ReadPackets(1);
+  ASSERT_EQ(packets_.size(), 1u);
+  EXPECT_EQ(packets_[0], "packet0");
+}
+#endif
+
 }  // namespace rtc
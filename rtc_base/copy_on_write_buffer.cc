@@ -113,6 +113,21 @@ void CopyOnWriteBuffer::Clear() {
   RTC_DCHECK(IsConsistent());
 }
 
+RefCountReleaseStatus CopyOnWriteBuffer::RefCountedBuffer::Release() const {
+  const auto status = ref_count_.DecRef();
+  if (status == RefCountReleaseStatus::kDroppedLastRef) {
+    if (recycler_) {
+      // Keep the recycler alive for the duration of the call; the pool may
+      // have been destroyed already, leaving this the last reference.
+      scoped_refptr<Recycler> recycler = std::move(recycler_);
+      recycler->Recycle(const_cast<RefCountedBuffer*>(this));
+    } else {
+      delete this;
+    }
+  }
+  return status;
+}
+
 void CopyOnWriteBuffer::UnshareAndEnsureCapacity(size_t new_capacity) {
   if (buffer_->HasOneRef() && new_capacity <= capacity()) {
     return;
@@ -23,12 +23,16 @@
 #include "api/scoped_refptr.h"
 #include "rtc_base/buffer.h"
 #include "rtc_base/checks.h"
+#include "rtc_base/ref_count.h"
 #include "rtc_base/ref_counted_object.h"
+#include "rtc_base/ref_counter.h"
 #include "rtc_base/system/rtc_export.h"
 #include "rtc_base/type_traits.h"
 
 namespace rtc {
 
+class CopyOnWriteBufferPool;
+
 class RTC_EXPORT CopyOnWriteBuffer {
  public:
   // An empty buffer.
@@ -276,7 +280,41 @@ class RTC_EXPORT CopyOnWriteBuffer {
   }
 
  private:
-  using RefCountedBuffer = FinalRefCountedObject<Buffer>;
+  friend class CopyOnWriteBufferPool;
+
+  class RefCountedBuffer;
+
+  // Takes back the storage of buffers handed out by a CopyOnWriteBufferPool
+  // once the last reference to it is dropped.
+  class Recycler : public RefCountInterface {
+   public:
+    virtual void Recycle(RefCountedBuffer* buffer) = 0;
+
+   protected:
+    ~Recycler() override = default;
+  };
+
+  // Storage shared between CopyOnWriteBuffer instances. It is deleted when the
+  // last reference is dropped, unless it came from a pool, in which case it is
+  // handed back to the pool's recycler.
+  class RefCountedBuffer final : public Buffer {
+   public:
+    using Buffer::BufferT;
+    RefCountedBuffer(const RefCountedBuffer&) = delete;
+    RefCountedBuffer& operator=(const RefCountedBuffer&) = delete;
+
+    void AddRef() const { ref_count_.IncRef(); }
+    RefCountReleaseStatus Release() const;
+    bool HasOneRef() const { return ref_count_.HasOneRef(); }
+
+   private:
+    friend class CopyOnWriteBufferPool;
+
+    mutable webrtc::webrtc_impl::RefCounter ref_count_{0};
+    // Set while the storage is handed out by a pool.
+    mutable scoped_refptr<Recycler> recycler_;
+  };
+
   // Create a copy of the underlying data if it is referenced from other Buffer
   // objects or there is not enough capacity.
   void UnshareAndEnsureCapacity(size_t new_capacity);
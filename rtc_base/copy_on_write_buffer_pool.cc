@@ -0,0 +1,113 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/copy_on_write_buffer_pool.h"
+
+#include <vector>
+
+#include "api/make_ref_counted.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace rtc {
+
+// Owns the unused storage of a pool. Every buffer handed out holds a reference
+// to the free list, so that it can be recycled even after the pool is gone.
+class CopyOnWriteBufferPool::FreeList : public CopyOnWriteBuffer::Recycler {
+ public:
+  explicit FreeList(size_t max_free_buffers)
+      : max_free_buffers_(max_free_buffers) {}
+
+  ~FreeList() override { Shutdown(); }
+
+  // Returns unused storage, or null if the pool is empty.
+  CopyOnWriteBuffer::RefCountedBuffer* Pop() {
+    webrtc::MutexLock lock(&mutex_);
+    if (free_buffers_.empty()) {
+      ++stats_.allocations;
+      return nullptr;
+    }
+    ++stats_.reuses;
+    CopyOnWriteBuffer::RefCountedBuffer* buffer = free_buffers_.back();
+    free_buffers_.pop_back();
+    return buffer;
+  }
+
+  void Recycle(CopyOnWriteBuffer::RefCountedBuffer* buffer) override {
+    {
+      webrtc::MutexLock lock(&mutex_);
+      if (!shut_down_ && free_buffers_.size() < max_free_buffers_) {
+        buffer->Clear();
+        free_buffers_.push_back(buffer);
+        return;
+      }
+    }
+    delete buffer;
+  }
+
+  // Frees all unused storage. Buffers released afterwards are freed too.
+  void Shutdown() {
+    std::vector<CopyOnWriteBuffer::RefCountedBuffer*> free_buffers;
+    {
+      webrtc::MutexLock lock(&mutex_);
+      shut_down_ = true;
+      free_buffers.swap(free_buffers_);
+    }
+    for (CopyOnWriteBuffer::RefCountedBuffer* buffer : free_buffers) {
+      delete buffer;
+    }
+  }
+
+  Stats GetStats() const {
+    webrtc::MutexLock lock(&mutex_);
+    return stats_;
+  }
+
+ private:
+  const size_t max_free_buffers_;
+  mutable webrtc::Mutex mutex_;
+  std::vector<CopyOnWriteBuffer::RefCountedBuffer*> free_buffers_
+      RTC_GUARDED_BY(mutex_);
+  bool shut_down_ RTC_GUARDED_BY(mutex_) = false;
+  Stats stats_ RTC_GUARDED_BY(mutex_);
+};
+
+CopyOnWriteBufferPool::CopyOnWriteBufferPool(size_t buffer_capacity,
+                                             size_t max_free_buffers)
+    : buffer_capacity_(buffer_capacity),
+      free_list_(make_ref_counted<FreeList>(max_free_buffers)) {
+  RTC_DCHECK_GT(buffer_capacity_, 0);
+}
+
+CopyOnWriteBufferPool::~CopyOnWriteBufferPool() {
+  free_list_->Shutdown();
+}
+
+CopyOnWriteBuffer CopyOnWriteBufferPool::Allocate() {
+  CopyOnWriteBuffer::RefCountedBuffer* storage = free_list_->Pop();
+  if (!storage) {
+    storage = new CopyOnWriteBuffer::RefCountedBuffer(0, buffer_capacity_);
+  }
+  storage->recycler_ = free_list_;
+
+  CopyOnWriteBuffer buffer;
+  buffer.buffer_ = scoped_refptr<CopyOnWriteBuffer::RefCountedBuffer>(storage);
+  buffer.offset_ = 0;
+  buffer.size_ = 0;
+  RTC_DCHECK(buffer.IsConsistent());
+  return buffer;
+}
+
+CopyOnWriteBufferPool::Stats CopyOnWriteBufferPool::GetStats() const {
+  return free_list_->GetStats();
+}
+
+}  // namespace rtc
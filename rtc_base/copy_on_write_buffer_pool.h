@@ -0,0 +1,73 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_COPY_ON_WRITE_BUFFER_POOL_H_
+#define RTC_BASE_COPY_ON_WRITE_BUFFER_POOL_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "api/scoped_refptr.h"
+#include "rtc_base/copy_on_write_buffer.h"
+#include "rtc_base/system/rtc_export.h"
+
+namespace rtc {
+
+// Hands out CopyOnWriteBuffers whose storage goes back to the pool, instead of
+// being freed, once the last buffer referencing it is destroyed. A packet
+// pipeline that allocates its buffers from a pool therefore stops allocating
+// once the pool has grown to the number of packets in flight.
+//
+// Buffers may be released on any thread and may outlive the pool. The pool
+// itself is thread safe.
+class RTC_EXPORT CopyOnWriteBufferPool {
+ public:
+  struct Stats {
+    // Number of buffers handed out that needed a new heap allocation.
+    uint64_t allocations = 0;
+    // Number of buffers handed out that reused storage from the pool.
+    uint64_t reuses = 0;
+  };
+
+  // Buffers are handed out with at least `buffer_capacity` bytes of capacity.
+  // At most `max_free_buffers` unused buffers are kept; storage released
+  // beyond that is freed.
+  CopyOnWriteBufferPool(size_t buffer_capacity, size_t max_free_buffers);
+  CopyOnWriteBufferPool(const CopyOnWriteBufferPool&) = delete;
+  CopyOnWriteBufferPool& operator=(const CopyOnWriteBufferPool&) = delete;
+  ~CopyOnWriteBufferPool();
+
+  // Returns a buffer holding a copy of `size` bytes at `data`. `size` may
+  // exceed the pool's buffer capacity, in which case the storage grows.
+  template <typename T,
+            typename std::enable_if<
+                internal::BufferCompat<uint8_t, T>::value>::type* = nullptr>
+  CopyOnWriteBuffer Allocate(const T* data, size_t size) {
+    CopyOnWriteBuffer buffer = Allocate();
+    buffer.buffer_->SetData(data, size);
+    buffer.size_ = size;
+    return buffer;
+  }
+
+  // Returns an empty buffer.
+  CopyOnWriteBuffer Allocate();
+
+  Stats GetStats() const;
+
+ private:
+  class FreeList;
+
+  const size_t buffer_capacity_;
+  const scoped_refptr<FreeList> free_list_;
+};
+
+}  // namespace rtc
+
+#endif  // RTC_BASE_COPY_ON_WRITE_BUFFER_POOL_H_
@@ -0,0 +1,93 @@
+/*
+ *  Copyright 2022 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/copy_on_write_buffer_pool.h"
+
+#include <memory>
+#include <utility>
+
+#include "test/gtest.h"
+
+namespace rtc {
+namespace {
+
+const uint8_t kTestData[] = {0x0, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7};
+
+TEST(CopyOnWriteBufferPoolTest, AllocatesWithCapacity) {
+  CopyOnWriteBufferPool pool(/*buffer_capacity=*/100, /*max_free_buffers=*/4);
+  CopyOnWriteBuffer buffer = pool.Allocate();
+  EXPECT_EQ(buffer.size(), 0u);
+  EXPECT_GE(buffer.capacity(), 100u);
+
+  CopyOnWriteBuffer copy = pool.Allocate(kTestData, sizeof(kTestData));
+  EXPECT_EQ(copy, CopyOnWriteBuffer(kTestData, sizeof(kTestData)));
+  EXPECT_GE(copy.capacity(), 100u);
+  EXPECT_EQ(pool.GetStats().allocations, 2u);
+  EXPECT_EQ(pool.GetStats().reuses, 0u);
+}
+
+TEST(CopyOnWriteBufferPoolTest, ReusesReleasedStorage) {
+  CopyOnWriteBufferPool pool(/*buffer_capacity=*/100, /*max_free_buffers=*/4);
+  const uint8_t* first_data;
+  {
+    CopyOnWriteBuffer buffer = pool.Allocate(kTestData, sizeof(kTestData));
+    first_data = buffer.cdata();
+  }
+  CopyOnWriteBuffer buffer = pool.Allocate(kTestData, 4);
+  EXPECT_EQ(buffer.cdata(), first_data);
+  EXPECT_EQ(buffer.size(), 4u);
+  EXPECT_EQ(pool.GetStats().allocations, 1u);
+  EXPECT_EQ(pool.GetStats().reuses, 1u);
+}
+
+TEST(CopyOnWriteBufferPoolTest, StorageStaysInUseWhileShared) {
+  CopyOnWriteBufferPool pool(/*buffer_capacity=*/100, /*max_free_buffers=*/4);
+  CopyOnWriteBuffer shared;
+  {
+    CopyOnWriteBuffer buffer = pool.Allocate(kTestData, sizeof(kTestData));
+    shared = buffer;
+  }
+  CopyOnWriteBuffer buffer = pool.Allocate();
+  EXPECT_NE(buffer.cdata(), shared.cdata());
+  EXPECT_EQ(shared, CopyOnWriteBuffer(kTestData, sizeof(kTestData)));
+  EXPECT_EQ(pool.GetStats().allocations, 2u);
+}
+
+TEST(CopyOnWriteBufferPoolTest, WritesInPlaceWhenNotShared) {
+  CopyOnWriteBufferPool pool(/*buffer_capacity=*/100, /*max_free_buffers=*/4);
+  CopyOnWriteBuffer buffer = pool.Allocate(kTestData, sizeof(kTestData));
+  const uint8_t* data = buffer.cdata();
+  buffer.MutableData()[0] = 0xff;
+  buffer.SetSize(4);
+  EXPECT_EQ(buffer.cdata(), data);
+}
+
+TEST(CopyOnWriteBufferPoolTest, KeepsAtMostMaxFreeBuffers) {
+  CopyOnWriteBufferPool pool(/*buffer_capacity=*/100, /*max_free_buffers=*/1);
+  {
+    CopyOnWriteBuffer buffer1 = pool.Allocate();
+    CopyOnWriteBuffer buffer2 = pool.Allocate();
+  }
+  CopyOnWriteBuffer buffer1 = pool.Allocate();
+  CopyOnWriteBuffer buffer2 = pool.Allocate();
+  EXPECT_EQ(pool.GetStats().allocations, 3u);
+  EXPECT_EQ(pool.GetStats().reuses, 1u);
+}
+
+TEST(CopyOnWriteBufferPoolTest, BuffersMayOutlivePool) {
+  auto pool = std::make_unique<CopyOnWriteBufferPool>(
+      /*buffer_capacity=*/100, /*max_free_buffers=*/4);
+  CopyOnWriteBuffer buffer = pool->Allocate(kTestData, sizeof(kTestData));
+  pool = nullptr;
+  EXPECT_EQ(buffer, CopyOnWriteBuffer(kTestData, sizeof(kTestData)));
+}
+
+}  // namespace
+}  // namespace rtc
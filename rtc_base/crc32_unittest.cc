@@ -34,4 +34,22 @@ TEST(Crc32Test, TestMultipleUpdates) {
   EXPECT_EQ(0x171A3F5FU, c);
 }
 
+TEST(Crc32Test, TestUnalignedLongInput) {
+  // Long enough to use the 8 byte steps, with a start that is not aligned
+  // and a remainder that is not a multiple of 8 bytes.
+  std::string input(1001, '\0');
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = static_cast<char>(i * 7 + 3);
+  }
+  // Reference values computed byte by byte.
+  uint32_t c = 0;
+  for (size_t i = 1; i < input.size(); ++i) {
+    c = UpdateCrc32(c, &input[i], 1);
+  }
+  EXPECT_EQ(c, ComputeCrc32(input.data() + 1, input.size() - 1));
+  EXPECT_EQ(ComputeCrc32(input), UpdateCrc32(ComputeCrc32(input.data(), 13),
+                                             input.data() + 13,
+                                             input.size() - 13));
+}
+
 }  // namespace rtc
@@ -11,6 +11,7 @@
 #include "rtc_base/message_digest.h"
 
 #include "absl/strings/string_view.h"
+#include "rtc_base/openssl_digest.h"
 #include "rtc_base/string_encode.h"
 #include "test/gtest.h"
 
@@ -147,10 +148,38 @@ TEST(MessageDigestTest, TestSha1Hmac) {
                         input.size(), output, sizeof(output) - 1));
 }
 
+// Test vectors from RFC 2202.
+TEST(MessageDigestTest, TestSha1HmacWithFixedKey) {
+  OpenSSLHmac hmac(DIGEST_SHA_1, "Jefe");
+  EXPECT_EQ(20U, hmac.Size());
+  // The key is reused for every HMAC.
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ("effcdf6ae5eb2fa2d27416d5f184df9c259a7c79",
+              ComputeDigest(&hmac, "what do ya want for nothing?"));
+  }
+  hmac.Update("what do ya ", 11);
+  hmac.Update("want for nothing?", 17);
+  char output[20];
+  EXPECT_EQ(0U, hmac.Finish(output, sizeof(output) - 1));
+  EXPECT_EQ(sizeof(output), hmac.Finish(output, sizeof(output)));
+  EXPECT_EQ("effcdf6ae5eb2fa2d27416d5f184df9c259a7c79",
+            hex_encode(absl::string_view(output, sizeof(output))));
+
+  OpenSSLHmac long_key_hmac(DIGEST_SHA_1, std::string(80, '\xaa'));
+  EXPECT_EQ("aa4ae5e15272d00e95705637ce8a3b55ed402112",
+            ComputeDigest(&long_key_hmac,
+                          "Test Using Larger Than Block-Size Key - Hash Key "
+                          "First"));
+}
+
 TEST(MessageDigestTest, TestBadHmac) {
   std::string output;
   EXPECT_FALSE(ComputeHmac("sha-9000", "key", "abc", &output));
   EXPECT_EQ("", ComputeHmac("sha-9000", "key", "abc"));
+  OpenSSLHmac hmac("sha-9000", "key");
+  EXPECT_EQ(0U, hmac.Size());
+  char buf[20];
+  EXPECT_EQ(0U, hmac.Finish(buf, sizeof(buf)));
 }
 
 }  // namespace rtc
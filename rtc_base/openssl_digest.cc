@@ -10,11 +10,19 @@
 
 #include "rtc_base/openssl_digest.h"
 
+#include <string.h>
+
 #include "absl/strings/string_view.h"
 #include "rtc_base/checks.h"  // RTC_DCHECK, RTC_CHECK
 #include "rtc_base/openssl.h"
 
 namespace rtc {
+namespace {
+
+// The largest block size of the supported algorithms (SHA-384 and SHA-512).
+constexpr size_t kMaxBlockSize = 128;
+
+}  // namespace
 
 OpenSSLDigest::OpenSSLDigest(absl::string_view algorithm) {
   ctx_ = EVP_MD_CTX_new();
@@ -115,4 +123,76 @@ bool OpenSSLDigest::GetDigestSize(absl::string_view algorithm, size_t* length) {
   return true;
 }
 
+OpenSSLHmac::OpenSSLHmac(absl::string_view algorithm, absl::string_view key) {
+  if (!OpenSSLDigest::GetDigestEVP(algorithm, &md_)) {
+    md_ = nullptr;
+    return;
+  }
+  ctx_ = EVP_MD_CTX_new();
+  inner_key_ctx_ = EVP_MD_CTX_new();
+  outer_key_ctx_ = EVP_MD_CTX_new();
+  RTC_CHECK(ctx_ && inner_key_ctx_ && outer_key_ctx_);
+
+  // Copy the key to a block-sized buffer to simplify padding.
+  // If the key is longer than a block, hash it and use the result instead.
+  const size_t block_len = EVP_MD_block_size(md_);
+  uint8_t new_key[kMaxBlockSize] = {};
+  RTC_CHECK_LE(block_len, sizeof(new_key));
+  if (key.size() > block_len) {
+    unsigned int md_len;
+    EVP_Digest(key.data(), key.size(), new_key, &md_len, md_, nullptr);
+  } else {
+    memcpy(new_key, key.data(), key.size());
+  }
+  uint8_t pad[kMaxBlockSize];
+  for (size_t i = 0; i < block_len; ++i) {
+    pad[i] = 0x36 ^ new_key[i];
+  }
+  EVP_DigestInit_ex(inner_key_ctx_, md_, nullptr);
+  EVP_DigestUpdate(inner_key_ctx_, pad, block_len);
+  for (size_t i = 0; i < block_len; ++i) {
+    pad[i] = 0x5c ^ new_key[i];
+  }
+  EVP_DigestInit_ex(outer_key_ctx_, md_, nullptr);
+  EVP_DigestUpdate(outer_key_ctx_, pad, block_len);
+  EVP_MD_CTX_copy_ex(ctx_, inner_key_ctx_);
+}
+
+OpenSSLHmac::~OpenSSLHmac() {
+  EVP_MD_CTX_destroy(ctx_);
+  EVP_MD_CTX_destroy(inner_key_ctx_);
+  EVP_MD_CTX_destroy(outer_key_ctx_);
+}
+
+size_t OpenSSLHmac::Size() const {
+  if (!md_) {
+    return 0;
+  }
+  return EVP_MD_size(md_);
+}
+
+void OpenSSLHmac::Update(const void* buf, size_t len) {
+  if (!md_) {
+    return;
+  }
+  EVP_DigestUpdate(ctx_, buf, len);
+}
+
+size_t OpenSSLHmac::Finish(void* buf, size_t len) {
+  if (!md_ || len < Size()) {
+    return 0;
+  }
+  // Inner hash; the inner padded key and the input were hashed already.
+  unsigned char inner[EVP_MAX_MD_SIZE];
+  unsigned int md_len;
+  EVP_DigestFinal_ex(ctx_, inner, &md_len);
+  // Outer hash; the outer padded key, and then the result of the inner hash.
+  EVP_MD_CTX_copy_ex(ctx_, outer_key_ctx_);
+  EVP_DigestUpdate(ctx_, inner, md_len);
+  EVP_DigestFinal_ex(ctx_, static_cast<unsigned char*>(buf), &md_len);
+  EVP_MD_CTX_copy_ex(ctx_, inner_key_ctx_);  // prepare for future Update()s
+  RTC_DCHECK(md_len == Size());
+  return md_len;
+}
+
 }  // namespace rtc
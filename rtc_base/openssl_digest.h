@@ -46,6 +46,33 @@ class OpenSSLDigest final : public MessageDigest {
   const EVP_MD* md_;
 };
 
+// Computes RFC 2104 HMACs with a fixed key, using OpenSSL. Unlike
+// ComputeHmac(), which hashes the padded key for every HMAC, this hashes the
+// inner and outer padded keys once, on construction, and starts every HMAC
+// from copies of those digest states. Use it when many HMACs are computed
+// with the same key, such as for STUN MESSAGE-INTEGRITY.
+class OpenSSLHmac final : public MessageDigest {
+ public:
+  // Creates an OpenSSLHmac keyed with `key`, with `algorithm` as the hash
+  // algorithm.
+  OpenSSLHmac(absl::string_view algorithm, absl::string_view key);
+  ~OpenSSLHmac() override;
+  // Returns the HMAC output size (e.g. 20 bytes for SHA-1).
+  size_t Size() const override;
+  // Updates the HMAC with `len` bytes from `buf`.
+  void Update(const void* buf, size_t len) override;
+  // Outputs the HMAC value to `buf` with length `len`, and prepares for the
+  // next HMAC with the same key.
+  size_t Finish(void* buf, size_t len) override;
+
+ private:
+  EVP_MD_CTX* ctx_ = nullptr;
+  // The digest states after hashing the inner and outer padded keys.
+  EVP_MD_CTX* inner_key_ctx_ = nullptr;
+  EVP_MD_CTX* outer_key_ctx_ = nullptr;
+  const EVP_MD* md_;
+};
+
 }  // namespace rtc
 
 #endif  // RTC_BASE_OPENSSL_DIGEST_H_
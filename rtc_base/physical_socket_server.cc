@@ -55,6 +55,14 @@
 #include <linux/sockios.h>
 #endif
 
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+#include <netinet/udp.h>
+// From linux/udp.h, not available in older system headers.
+#if !defined(UDP_SEGMENT)
+#define UDP_SEGMENT 103
+#endif
+#endif
+
 #if defined(WEBRTC_WIN)
 #define LAST_SYSTEM_ERROR (::GetLastError())
 #elif defined(__native_client__) && __native_client__
@@ -391,6 +399,95 @@ int PhysicalSocket::SendTo(const void* buffer,
   return sent;
 }
 
+int PhysicalSocket::SendToBatch(
+    rtc::ArrayView<const rtc::ArrayView<const uint8_t>> packets,
+    const SocketAddress& addr) {
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+  if (!udp_ || packets.size() <= 1) {
+    return Socket::SendToBatch(packets, addr);
+  }
+  // Bounds both the GSO segment count and the sendmmsg() batch.
+  static constexpr size_t kMaxBatchSize = 64;
+  // Keeps a GSO super-packet within the maximum IPv6 UDP payload.
+  static constexpr size_t kMaxGsoBytes = 65000;
+  const size_t count = std::min(packets.size(), kMaxBatchSize);
+  sockaddr_storage saddr;
+  socklen_t saddr_len = static_cast<socklen_t>(addr.ToSockAddrStorage(&saddr));
+  struct iovec iovs[kMaxBatchSize];
+  size_t total_bytes = 0;
+  for (size_t i = 0; i < count; ++i) {
+    iovs[i].iov_base = const_cast<uint8_t*>(packets[i].data());
+    iovs[i].iov_len = packets[i].size();
+    total_bytes += packets[i].size();
+  }
+
+  // UDP segmentation offload sends all packets with a single sendmsg() call,
+  // but requires that all packets except the last have the same size.
+  const size_t segment_size = packets[0].size();
+  bool use_gso = udp_gso_supported_ && segment_size > 0 &&
+                 total_bytes <= kMaxGsoBytes &&
+                 packets[count - 1].size() <= segment_size;
+  for (size_t i = 1; use_gso && i + 1 < count; ++i) {
+    use_gso = packets[i].size() == segment_size;
+  }
+  if (use_gso) {
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(uint16_t))] = {};
+    struct msghdr msg = {};
+    msg.msg_name = &saddr;
+    msg.msg_namelen = saddr_len;
+    msg.msg_iov = iovs;
+    msg.msg_iovlen = count;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_UDP;
+    cmsg->cmsg_type = UDP_SEGMENT;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+    uint16_t gso_size = static_cast<uint16_t>(segment_size);
+    memcpy(CMSG_DATA(cmsg), &gso_size, sizeof(gso_size));
+    int sent = ::sendmsg(s_, &msg, MSG_NOSIGNAL);
+    if (sent >= 0) {
+      UpdateLastError();
+      return static_cast<int>(count);
+    }
+    int error = LAST_SYSTEM_ERROR;
+    if (error != EINVAL && error != ENOPROTOOPT && error != EIO &&
+        error != EOPNOTSUPP) {
+      UpdateLastError();
+      MaybeRemapSendError();
+      if (IsBlockingError(GetError())) {
+        EnableEvents(DE_WRITE);
+      }
+      return SOCKET_ERROR;
+    }
+    // The kernel or the outgoing interface doesn't support GSO, use
+    // sendmmsg() from now on.
+    RTC_LOG(LS_INFO) << "UDP GSO not supported, error " << error;
+    udp_gso_supported_ = false;
+  }
+
+  struct mmsghdr msgs[kMaxBatchSize];
+  memset(msgs, 0, sizeof(msgs[0]) * count);
+  for (size_t i = 0; i < count; ++i) {
+    msgs[i].msg_hdr.msg_name = &saddr;
+    msgs[i].msg_hdr.msg_namelen = saddr_len;
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+  }
+  int sent =
+      ::sendmmsg(s_, msgs, static_cast<unsigned int>(count), MSG_NOSIGNAL);
+  UpdateLastError();
+  MaybeRemapSendError();
+  if ((sent >= 0 && sent < static_cast<int>(count)) ||
+      (sent < 0 && IsBlockingError(GetError()))) {
+    EnableEvents(DE_WRITE);
+  }
+  return sent;
+#else
+  return Socket::SendToBatch(packets, addr);
+#endif
+}
+
 int PhysicalSocket::Recv(void* buffer, size_t length, int64_t* timestamp) {
   int received =
       ::recv(s_, static_cast<char*>(buffer), static_cast<int>(length), 0);
@@ -446,6 +543,69 @@ int PhysicalSocket::RecvFrom(void* buffer,
   return received;
 }
 
+int PhysicalSocket::RecvFromBatch(rtc::ArrayView<ReceiveSlot> slots) {
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+  if (!udp_ || slots.size() <= 1) {
+    return Socket::RecvFromBatch(slots);
+  }
+  if (!recv_timestamps_enabled_) {
+    // SIOCGSTAMP only reports the last datagram read, so per-datagram
+    // timestamps have to come from ancillary data instead.
+    int value = 1;
+    ::setsockopt(s_, SOL_SOCKET, SO_TIMESTAMP, &value, sizeof(value));
+    recv_timestamps_enabled_ = true;
+  }
+
+  static constexpr size_t kMaxBatchSize = 64;
+  static constexpr size_t kControlSize = CMSG_SPACE(sizeof(struct timeval));
+  const size_t count = std::min(slots.size(), kMaxBatchSize);
+  struct mmsghdr msgs[kMaxBatchSize];
+  struct iovec iovs[kMaxBatchSize];
+  sockaddr_storage addrs[kMaxBatchSize];
+  alignas(struct cmsghdr) char control[kMaxBatchSize][kControlSize];
+  for (size_t i = 0; i < count; ++i) {
+    iovs[i].iov_base = slots[i].buffer;
+    iovs[i].iov_len = slots[i].capacity;
+    msgs[i].msg_hdr.msg_name = &addrs[i];
+    msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+    msgs[i].msg_hdr.msg_control = control[i];
+    msgs[i].msg_hdr.msg_controllen = kControlSize;
+    msgs[i].msg_hdr.msg_flags = 0;
+    msgs[i].msg_len = 0;
+  }
+  int received = ::recvmmsg(s_, msgs, static_cast<unsigned int>(count),
+                            MSG_DONTWAIT, nullptr);
+  UpdateLastError();
+  for (int i = 0; i < received; ++i) {
+    ReceiveSlot& slot = slots[i];
+    slot.size = msgs[i].msg_len;
+    slot.truncated = (msgs[i].msg_hdr.msg_flags & MSG_TRUNC) != 0;
+    SocketAddressFromSockAddrStorage(addrs[i], &slot.addr);
+    slot.timestamp = -1;
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msgs[i].msg_hdr); cmsg != nullptr;
+         cmsg = CMSG_NXTHDR(&msgs[i].msg_hdr, cmsg)) {
+      if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_TIMESTAMP) {
+        struct timeval tv;
+        memcpy(&tv, CMSG_DATA(cmsg), sizeof(tv));
+        slot.timestamp =
+            rtc::kNumMicrosecsPerSec * static_cast<int64_t>(tv.tv_sec) +
+            static_cast<int64_t>(tv.tv_usec);
+      }
+    }
+  }
+  EnableEvents(DE_READ);
+  int error = GetError();
+  if (received < 0 && !IsBlockingError(error)) {
+    RTC_LOG_F(LS_VERBOSE) << "Error = " << error;
+  }
+  return received;
+#else
+  return Socket::RecvFromBatch(slots);
+#endif
+}
+
 int PhysicalSocket::Listen(int backlog) {
   int err = ::listen(s_, backlog);
   UpdateLastError();
@@ -600,6 +760,15 @@ int PhysicalSocket::TranslateOption(Option opt, int* slevel, int* sopt) {
 #endif
     case OPT_RTP_SENDTIME_EXTN_ID:
       return -1;  // No logging is necessary as this not a OS socket option.
+    case OPT_REUSEPORT:
+#if defined(WEBRTC_POSIX) && defined(SO_REUSEPORT)
+      *slevel = SOL_SOCKET;
+      *sopt = SO_REUSEPORT;
+      break;
+#else
+      RTC_LOG(LS_WARNING) << "Socket::OPT_REUSEPORT not supported.";
+      return -1;
+#endif
     default:
       RTC_DCHECK_NOTREACHED();
       return -1;
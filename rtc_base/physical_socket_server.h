@@ -155,12 +155,15 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
   int SendTo(const void* buffer,
              size_t length,
              const SocketAddress& addr) override;
+  int SendToBatch(rtc::ArrayView<const rtc::ArrayView<const uint8_t>> packets,
+                  const SocketAddress& addr) override;
 
   int Recv(void* buffer, size_t length, int64_t* timestamp) override;
   int RecvFrom(void* buffer,
                size_t length,
                SocketAddress* out_addr,
                int64_t* timestamp) override;
+  int RecvFromBatch(rtc::ArrayView<ReceiveSlot> slots) override;
 
   int Listen(int backlog) override;
   Socket* Accept(SocketAddress* out_addr) override;
@@ -213,6 +216,12 @@ class PhysicalSocket : public Socket, public sigslot::has_slots<> {
 
  private:
   uint8_t enabled_events_ = 0;
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+  // Set once SO_TIMESTAMP has been requested for batched receives.
+  bool recv_timestamps_enabled_ = false;
+  // Cleared the first time the kernel rejects UDP segmentation offload.
+  bool udp_gso_supported_ = true;
+#endif
 };
 
 class SocketDispatcher : public Dispatcher, public PhysicalSocket {
@@ -509,6 +509,19 @@ TEST_F(PhysicalSocketTest,
   server_.set_network_binder(nullptr);
 }
 
+// Sockets may share an address only if all of them set OPT_REUSEPORT.
+TEST_F(PhysicalSocketTest, BindToSharedAddressWithReusePort) {
+  MAYBE_SKIP_IPV4;
+  std::unique_ptr<Socket> socket1(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<Socket> socket2(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<Socket> socket3(server_.CreateSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, socket1->SetOption(Socket::OPT_REUSEPORT, 1));
+  ASSERT_EQ(0, socket2->SetOption(Socket::OPT_REUSEPORT, 1));
+  ASSERT_EQ(0, socket1->Bind(SocketAddress(kIPv4Loopback, 0)));
+  EXPECT_EQ(0, socket2->Bind(socket1->GetLocalAddress()));
+  EXPECT_EQ(-1, socket3->Bind(socket1->GetLocalAddress()));
+}
+
 #endif
 
 }  // namespace rtc
@@ -10,4 +10,36 @@
 
 #include "rtc_base/socket.h"
 
-namespace rtc {}  // namespace rtc
+namespace rtc {
+
+int Socket::SendToBatch(
+    rtc::ArrayView<const rtc::ArrayView<const uint8_t>> packets,
+    const SocketAddress& addr) {
+  int sent_packets = 0;
+  for (const rtc::ArrayView<const uint8_t>& packet : packets) {
+    if (SendTo(packet.data(), packet.size(), addr) < 0) {
+      return sent_packets > 0 ? sent_packets : SOCKET_ERROR;
+    }
+    ++sent_packets;
+  }
+  return sent_packets;
+}
+
+int Socket::RecvFromBatch(rtc::ArrayView<ReceiveSlot> slots) {
+  if (slots.empty()) {
+    return 0;
+  }
+  ReceiveSlot& slot = slots[0];
+  int64_t timestamp = -1;
+  int received =
+      RecvFrom(slot.buffer, slot.capacity, &slot.addr, &timestamp);
+  if (received < 0) {
+    return received;
+  }
+  slot.size = static_cast<size_t>(received);
+  slot.truncated = false;
+  slot.timestamp = timestamp;
+  return 1;
+}
+
+}  // namespace rtc
@@ -25,6 +25,7 @@
 #include "rtc_base/win32.h"
 #endif
 
+#include "api/array_view.h"
 #include "rtc_base/socket_address.h"
 #include "rtc_base/third_party/sigslot/sigslot.h"
 
@@ -97,12 +98,39 @@ class Socket {
   virtual int Connect(const SocketAddress& addr) = 0;
   virtual int Send(const void* pv, size_t cb) = 0;
   virtual int SendTo(const void* pv, size_t cb, const SocketAddress& addr) = 0;
+  // Sends each of `packets` as a separate datagram to `addr`, using as few
+  // system calls as the platform allows. Returns the number of packets sent,
+  // which may be less than `packets.size()`, or SOCKET_ERROR if none could be
+  // sent. The default implementation calls SendTo() for each packet and stops
+  // at the first failure.
+  virtual int SendToBatch(
+      rtc::ArrayView<const rtc::ArrayView<const uint8_t>> packets,
+      const SocketAddress& addr);
   // `timestamp` is in units of microseconds.
   virtual int Recv(void* pv, size_t cb, int64_t* timestamp) = 0;
   virtual int RecvFrom(void* pv,
                        size_t cb,
                        SocketAddress* paddr,
                        int64_t* timestamp) = 0;
+  // Describes one datagram for RecvFromBatch(). The caller provides
+  // `buffer` and `capacity`; the socket fills in the remaining fields.
+  struct ReceiveSlot {
+    void* buffer = nullptr;
+    size_t capacity = 0;
+    // Number of bytes written to `buffer`.
+    size_t size = 0;
+    // True if the datagram did not fit in `buffer` and was cut short.
+    bool truncated = false;
+    SocketAddress addr;
+    // Receive time in microseconds, or -1 if not available.
+    int64_t timestamp = -1;
+  };
+  // Receives up to `slots.size()` datagrams that are already queued on the
+  // socket, without blocking. Returns the number of slots filled in, or
+  // SOCKET_ERROR if not even one datagram could be read, in which case
+  // GetError() tells why. The default implementation reads a single datagram
+  // with RecvFrom().
+  virtual int RecvFromBatch(rtc::ArrayView<ReceiveSlot> slots);
   virtual int Listen(int backlog) = 0;
   virtual Socket* Accept(SocketAddress* paddr) = 0;
   virtual int Close() = 0;
@@ -123,6 +151,9 @@ class Socket {
     OPT_RTP_SENDTIME_EXTN_ID,  // This is a non-traditional socket option param.
                                // This is specific to libjingle and will be used
                                // if SendTime option is needed at socket level.
+    OPT_REUSEPORT,             // Whether other sockets may bind to the same
+                               // address (SO_REUSEPORT). Must be set before
+                               // binding.
   };
   virtual int GetOption(Option opt, int* value) = 0;
   virtual int SetOption(Option opt, int value) = 0;
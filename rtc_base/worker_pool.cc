@@ -0,0 +1,102 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/worker_pool.h"
+
+#include <algorithm>
+
+#include "rtc_base/checks.h"
+
+namespace webrtc {
+
+WorkerPool::WorkerPool(int num_worker_threads)
+    : WorkerPool(num_worker_threads, "Worker", rtc::ThreadPriority::kNormal) {}
+
+WorkerPool::WorkerPool(int num_worker_threads,
+                       absl::string_view thread_name,
+                       rtc::ThreadPriority priority) {
+  RTC_DCHECK_GE(num_worker_threads, 0);
+  RTC_DCHECK_LE(num_worker_threads, kMaxNumWorkerThreads);
+  for (int i = 0; i < num_worker_threads; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+    Worker* worker = workers_.back().get();
+    worker->thread = rtc::PlatformThread::SpawnJoinable(
+        [this, worker] { RunWorker(worker); }, thread_name,
+        rtc::ThreadAttributes().SetPriority(priority));
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  quit_.store(true);
+  for (auto& worker : workers_) {
+    worker->wake_up.Set();
+    worker->thread.Finalize();
+  }
+}
+
+void WorkerPool::ParallelFor(size_t num_tasks,
+                             rtc::FunctionView<void(size_t)> task) {
+  // The calling thread takes one share of the work.
+  const int num_woken_workers = static_cast<int>(
+      std::min(workers_.size(), std::max<size_t>(num_tasks, 1) - 1));
+  if (num_woken_workers == 0) {
+    for (size_t i = 0; i < num_tasks; ++i) {
+      task(i);
+    }
+    return;
+  }
+
+  task_ = task;
+  num_tasks_ = num_tasks;
+  next_task_.store(0);
+  num_busy_workers_.store(num_woken_workers);
+  for (int i = 0; i < num_woken_workers; ++i) {
+    workers_[i]->wake_up.Set();
+  }
+  RunTasks();
+  // Wait also for the tasks that were taken by the workers, and for the
+  // workers to stop accessing `task_`.
+  all_workers_done_.Wait(rtc::Event::kForever, rtc::Event::kForever);
+  task_ = nullptr;
+}
+
+void WorkerPool::RunWorker(Worker* worker) {
+  while (true) {
+    worker->wake_up.Wait(rtc::Event::kForever, rtc::Event::kForever);
+    if (quit_.load()) {
+      return;
+    }
+    RunTasks();
+    if (num_busy_workers_.fetch_sub(1) == 1) {
+      all_workers_done_.Set();
+    }
+  }
+}
+
+void WorkerPool::RunTasks() {
+  for (size_t i = next_task_.fetch_add(1); i < num_tasks_;
+       i = next_task_.fetch_add(1)) {
+    task_(i);
+  }
+}
+
+void ParallelFor(WorkerPool* worker_pool,
+                 size_t num_tasks,
+                 rtc::FunctionView<void(size_t)> task) {
+  if (worker_pool) {
+    worker_pool->ParallelFor(num_tasks, task);
+    return;
+  }
+  for (size_t i = 0; i < num_tasks; ++i) {
+    task(i);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef RTC_BASE_WORKER_POOL_H_
+#define RTC_BASE_WORKER_POOL_H_
+
+#include <stddef.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "api/function_view.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+
+namespace webrtc {
+
+// Set of threads that runs independent parts of the processing of one frame,
+// e.g. of different audio channels or video layers, in parallel. The calls
+// block until all parts are done, so that the output does not depend on the
+// number of threads.
+class WorkerPool {
+ public:
+  static constexpr int kMaxNumWorkerThreads = 8;
+
+  // Creates `num_worker_threads` threads, which together with the calling
+  // thread run the tasks. The threads are named `thread_name`.
+  explicit WorkerPool(int num_worker_threads);
+  WorkerPool(int num_worker_threads,
+             absl::string_view thread_name,
+             rtc::ThreadPriority priority);
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  int num_worker_threads() const { return static_cast<int>(workers_.size()); }
+
+  // Calls `task(index)` for each index in [0, `num_tasks`), and returns when
+  // all calls are done. Must not be called from within a task.
+  void ParallelFor(size_t num_tasks, rtc::FunctionView<void(size_t)> task);
+
+ private:
+  struct Worker {
+    rtc::Event wake_up;
+    rtc::PlatformThread thread;
+  };
+
+  void RunWorker(Worker* worker);
+  void RunTasks();
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  rtc::Event all_workers_done_;
+  std::atomic<bool> quit_{false};
+  // The current call to `ParallelFor()`.
+  rtc::FunctionView<void(size_t)> task_;
+  size_t num_tasks_ = 0;
+  std::atomic<size_t> next_task_{0};
+  std::atomic<int> num_busy_workers_{0};
+};
+
+// Runs the tasks on `worker_pool`, or on the calling thread if `worker_pool` is
+// null.
+void ParallelFor(WorkerPool* worker_pool,
+                 size_t num_tasks,
+                 rtc::FunctionView<void(size_t)> task);
+
+}  // namespace webrtc
+
+#endif  // RTC_BASE_WORKER_POOL_H_
@@ -0,0 +1,61 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "rtc_base/worker_pool.h"
+
+#include <atomic>
+#include <vector>
+
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+void ExpectAllTasksRunOnce(WorkerPool* worker_pool, size_t num_tasks) {
+  std::vector<std::atomic<int>> num_calls(num_tasks);
+  ParallelFor(worker_pool, num_tasks,
+              [&](size_t index) { num_calls[index].fetch_add(1); });
+  for (size_t i = 0; i < num_tasks; ++i) {
+    EXPECT_EQ(num_calls[i].load(), 1) << "Task " << i;
+  }
+}
+
+}  // namespace
+
+TEST(WorkerPoolTest, RunsAllTasksOnce) {
+  for (int num_worker_threads : {0, 1, 3}) {
+    SCOPED_TRACE(num_worker_threads);
+    WorkerPool worker_pool(num_worker_threads);
+    EXPECT_EQ(worker_pool.num_worker_threads(), num_worker_threads);
+    for (size_t num_tasks : {0, 1, 2, 3, 4, 8, 100}) {
+      SCOPED_TRACE(num_tasks);
+      ExpectAllTasksRunOnce(&worker_pool, num_tasks);
+    }
+  }
+}
+
+TEST(WorkerPoolTest, RunsTasksOnCallingThreadWithoutPool) {
+  ExpectAllTasksRunOnce(/*worker_pool=*/nullptr, 5);
+}
+
+TEST(WorkerPoolTest, ResultsAreVisibleAfterTheCall) {
+  WorkerPool worker_pool(2);
+  std::vector<int> results(64);
+  for (int round = 0; round < 1000; ++round) {
+    worker_pool.ParallelFor(results.size(), [&](size_t index) {
+      results[index] = round + static_cast<int>(index);
+    });
+    for (size_t i = 0; i < results.size(); ++i) {
+      ASSERT_EQ(results[i], round + static_cast<int>(i));
+    }
+  }
+}
+
+}  // namespace webrtc
@@ -1072,7 +1072,9 @@ WEBRTC_RTCSTATS_IMPL(RTCTransportStats, RTCStats, "transport",
     &selected_candidate_pair_changes,
     &ice_role,
     &ice_local_username_fragment,
-    &ice_state)
+    &ice_state,
+    &receive_buffer_allocations,
+    &receive_buffer_reuses)
 // clang-format on
 
 RTCTransportStats::RTCTransportStats(const std::string& id,
@@ -1097,7 +1099,9 @@ RTCTransportStats::RTCTransportStats(std::string&& id, int64_t timestamp_us)
       selected_candidate_pair_changes("selectedCandidatePairChanges"),
       ice_role("iceRole"),
       ice_local_username_fragment("iceLocalUsernameFragment"),
-      ice_state("iceState") {}
+      ice_state("iceState"),
+      receive_buffer_allocations("receiveBufferAllocations"),
+      receive_buffer_reuses("receiveBufferReuses") {}
 
 RTCTransportStats::RTCTransportStats(const RTCTransportStats& other)
     : RTCStats(other.id(), other.timestamp_us()),
@@ -1117,7 +1121,9 @@ RTCTransportStats::RTCTransportStats(const RTCTransportStats& other)
       selected_candidate_pair_changes(other.selected_candidate_pair_changes),
       ice_role(other.ice_role),
       ice_local_username_fragment(other.ice_local_username_fragment),
-      ice_state(other.ice_state) {}
+      ice_state(other.ice_state),
+      receive_buffer_allocations(other.receive_buffer_allocations),
+      receive_buffer_reuses(other.receive_buffer_reuses) {}
 
 RTCTransportStats::~RTCTransportStats() {}
 
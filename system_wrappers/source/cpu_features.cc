@@ -77,6 +77,9 @@ int GetCPUInfo(CPUFeature feature) {
   if (feature == kSSE3) {
     return 0 != (cpu_info[2] & 0x00000001);
   }
+  if (feature == kSSE4_1) {
+    return 0 != (cpu_info[2] & 0x00080000);
+  }
 #if defined(WEBRTC_ENABLE_AVX2)
   if (feature == kAVX2 &&
       !webrtc::field_trial::IsEnabled("WebRTC-Avx2SupportKillSwitch")) {
@@ -0,0 +1,278 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/decode_thread_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "absl/algorithm/container.h"
+#include "rtc_base/checks.h"
+#include "rtc_base/numerics/divide_round.h"
+#include "rtc_base/time_utils.h"
+
+namespace webrtc {
+
+class DecodeThreadPool::DecodeQueue final : public TaskQueueBase {
+ public:
+  explicit DecodeQueue(DecodeThreadPool* pool) : pool_(pool) {}
+
+  void Delete() override {
+    RTC_DCHECK(!IsCurrent());
+    pool_->DeleteQueue(this);
+  }
+  void PostTask(absl::AnyInvocable<void() &&> task) override {
+    pool_->PostTask(this, std::move(task));
+  }
+  void PostDelayedTask(absl::AnyInvocable<void() &&> task,
+                       TimeDelta delay) override {
+    pool_->PostDelayedTask(this, std::move(task), delay);
+  }
+  void PostDelayedHighPrecisionTask(absl::AnyInvocable<void() &&> task,
+                                    TimeDelta delay) override {
+    pool_->PostDelayedTask(this, std::move(task), delay);
+  }
+
+  void Run(absl::AnyInvocable<void() &&> task) {
+    CurrentTaskQueueSetter set_current(this);
+    std::move(task)();
+  }
+
+  // The state below is guarded by the mutex of the pool.
+  std::deque<absl::AnyInvocable<void() &&>> tasks;
+  Priority priority = Priority::kNormal;
+  // Whether the queue is in a ready list.
+  bool ready = false;
+  // Whether a worker runs a task of the queue.
+  bool running = false;
+  bool deleted = false;
+  // Set when the queue is deleted while running, and signaled by the worker
+  // when the task is done.
+  rtc::Event* task_done = nullptr;
+
+ private:
+  ~DecodeQueue() override = default;
+  friend class DecodeThreadPool;
+
+  DecodeThreadPool* const pool_;
+};
+
+DecodeThreadPool::DecodeThreadPool(int num_threads) {
+  RTC_DCHECK_GT(num_threads, 0);
+  for (int i = 0; i < num_threads; ++i) {
+    workers_.push_back(std::make_unique<Worker>());
+    Worker* worker = workers_.back().get();
+    worker->thread = rtc::PlatformThread::SpawnJoinable(
+        [this, worker] { RunWorker(worker); }, "DecodeWorker",
+        rtc::ThreadAttributes().SetPriority(rtc::ThreadPriority::kHigh));
+  }
+  timer_thread_ = rtc::PlatformThread::SpawnJoinable(
+      [this] { RunTimer(); }, "DecodeTimer",
+      rtc::ThreadAttributes().SetPriority(rtc::ThreadPriority::kHigh));
+}
+
+DecodeThreadPool::~DecodeThreadPool() {
+  {
+    MutexLock lock(&mutex_);
+    RTC_DCHECK_EQ(num_queues_, 0);
+    quit_ = true;
+  }
+  for (auto& worker : workers_) {
+    worker->wake_up.Set();
+    worker->thread.Finalize();
+  }
+  timer_wake_up_.Set();
+  timer_thread_.Finalize();
+}
+
+std::unique_ptr<TaskQueueBase, TaskQueueDeleter>
+DecodeThreadPool::CreateDecodeQueue(absl::string_view name) {
+  MutexLock lock(&mutex_);
+  ++num_queues_;
+  return std::unique_ptr<TaskQueueBase, TaskQueueDeleter>(
+      new DecodeQueue(this));
+}
+
+void DecodeThreadPool::SetPriority(TaskQueueBase* decode_queue,
+                                   Priority priority) {
+  DecodeQueue* queue = static_cast<DecodeQueue*>(decode_queue);
+  RTC_DCHECK(queue->pool_ == this);
+  MutexLock lock(&mutex_);
+  if (queue->priority == priority) {
+    return;
+  }
+  if (queue->ready) {
+    RemoveFromReadyList(queue);
+    queue->priority = priority;
+    MakeReady(queue);
+  } else {
+    queue->priority = priority;
+  }
+}
+
+void DecodeThreadPool::PostTask(DecodeQueue* queue,
+                                absl::AnyInvocable<void() &&> task) {
+  MutexLock lock(&mutex_);
+  queue->tasks.push_back(std::move(task));
+  MakeReady(queue);
+}
+
+void DecodeThreadPool::PostDelayedTask(DecodeQueue* queue,
+                                       absl::AnyInvocable<void() &&> task,
+                                       TimeDelta delay) {
+  const int64_t due_us = rtc::TimeMicros() + delay.us();
+  bool is_next = false;
+  {
+    MutexLock lock(&mutex_);
+    auto it =
+        delayed_tasks_.emplace(due_us, DelayedTask{queue, std::move(task)});
+    is_next = it == delayed_tasks_.begin();
+  }
+  if (is_next) {
+    timer_wake_up_.Set();
+  }
+}
+
+void DecodeThreadPool::DeleteQueue(DecodeQueue* queue) {
+  rtc::Event task_done;
+  bool running;
+  {
+    MutexLock lock(&mutex_);
+    queue->deleted = true;
+    if (queue->ready) {
+      RemoveFromReadyList(queue);
+    }
+    running = queue->running;
+    if (running) {
+      queue->task_done = &task_done;
+    }
+  }
+  if (running) {
+    task_done.Wait(rtc::Event::kForever);
+  }
+
+  // The tasks are destroyed after the mutex is released, since their
+  // destructors may post tasks to other queues.
+  std::deque<absl::AnyInvocable<void() &&>> tasks;
+  std::vector<DelayedTask> delayed_tasks;
+  {
+    MutexLock lock(&mutex_);
+    tasks.swap(queue->tasks);
+    for (auto it = delayed_tasks_.begin(); it != delayed_tasks_.end();) {
+      if (it->second.queue == queue) {
+        delayed_tasks.push_back(std::move(it->second));
+        it = delayed_tasks_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    --num_queues_;
+  }
+  delete queue;
+}
+
+void DecodeThreadPool::MakeReady(DecodeQueue* queue) {
+  if (queue->ready || queue->running || queue->deleted) {
+    return;
+  }
+  queue->ready = true;
+  ready_queues_[static_cast<int>(queue->priority)].push_back(queue);
+  if (!idle_workers_.empty()) {
+    idle_workers_.back()->wake_up.Set();
+    idle_workers_.pop_back();
+  }
+}
+
+void DecodeThreadPool::RemoveFromReadyList(DecodeQueue* queue) {
+  std::deque<DecodeQueue*>& ready_list =
+      ready_queues_[static_cast<int>(queue->priority)];
+  auto it = absl::c_find(ready_list, queue);
+  RTC_DCHECK(it != ready_list.end());
+  ready_list.erase(it);
+  queue->ready = false;
+}
+
+DecodeThreadPool::DecodeQueue* DecodeThreadPool::TakeReadyQueue() {
+  for (int priority = static_cast<int>(Priority::kHigh);
+       priority >= static_cast<int>(Priority::kLow); --priority) {
+    std::deque<DecodeQueue*>& ready_list = ready_queues_[priority];
+    if (!ready_list.empty()) {
+      DecodeQueue* queue = ready_list.front();
+      ready_list.pop_front();
+      queue->ready = false;
+      return queue;
+    }
+  }
+  return nullptr;
+}
+
+void DecodeThreadPool::RunWorker(Worker* worker) {
+  while (true) {
+    DecodeQueue* queue;
+    absl::AnyInvocable<void() &&> task;
+    {
+      MutexLock lock(&mutex_);
+      if (quit_) {
+        return;
+      }
+      queue = TakeReadyQueue();
+      if (queue) {
+        RTC_DCHECK(!queue->tasks.empty());
+        task = std::move(queue->tasks.front());
+        queue->tasks.pop_front();
+        queue->running = true;
+      } else {
+        idle_workers_.push_back(worker);
+      }
+    }
+    if (!queue) {
+      worker->wake_up.Wait(rtc::Event::kForever, rtc::Event::kForever);
+      continue;
+    }
+
+    // The task is destroyed when Run() returns, before the queue may be
+    // deleted.
+    queue->Run(std::move(task));
+
+    MutexLock lock(&mutex_);
+    queue->running = false;
+    if (queue->task_done) {
+      queue->task_done->Set();
+    } else if (!queue->tasks.empty()) {
+      MakeReady(queue);
+    }
+  }
+}
+
+void DecodeThreadPool::RunTimer() {
+  while (true) {
+    int wait_ms = rtc::Event::kForever;
+    {
+      MutexLock lock(&mutex_);
+      if (quit_) {
+        return;
+      }
+      const int64_t now_us = rtc::TimeMicros();
+      while (!delayed_tasks_.empty() &&
+             delayed_tasks_.begin()->first <= now_us) {
+        DelayedTask& delayed_task = delayed_tasks_.begin()->second;
+        delayed_task.queue->tasks.push_back(std::move(delayed_task.task));
+        MakeReady(delayed_task.queue);
+        delayed_tasks_.erase(delayed_tasks_.begin());
+      }
+      if (!delayed_tasks_.empty()) {
+        wait_ms = DivideRoundUp(delayed_tasks_.begin()->first - now_us, 1'000);
+      }
+    }
+    timer_wake_up_.Wait(wait_ms, rtc::Event::kForever);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,102 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef VIDEO_DECODE_THREAD_POOL_H_
+#define VIDEO_DECODE_THREAD_POOL_H_
+
+#include <stdint.h>
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "absl/functional/any_invocable.h"
+#include "absl/strings/string_view.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/units/time_delta.h"
+#include "api/video/video_decode_scheduler.h"
+#include "rtc_base/event.h"
+#include "rtc_base/platform_thread.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "rtc_base/thread_annotations.h"
+
+namespace webrtc {
+
+// Runs the decode queues of any number of receive streams on a fixed number of
+// threads. A decode queue waiting for a thread is in the ready list of its
+// priority. Idle threads take the first queue from the highest priority ready
+// list that is not empty, run one task of it, and put it back at the end of
+// the list if it has more tasks. Queues of the same priority thereby take
+// turns, and a queue never runs on two threads at once.
+class DecodeThreadPool : public VideoDecodeScheduler {
+ public:
+  explicit DecodeThreadPool(int num_threads);
+  // All decode queues must have been deleted.
+  ~DecodeThreadPool() override;
+
+  DecodeThreadPool(const DecodeThreadPool&) = delete;
+  DecodeThreadPool& operator=(const DecodeThreadPool&) = delete;
+
+  int num_threads() const { return static_cast<int>(workers_.size()); }
+
+  // Implements VideoDecodeScheduler.
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateDecodeQueue(
+      absl::string_view name) override;
+  void SetPriority(TaskQueueBase* decode_queue, Priority priority) override;
+
+ private:
+  class DecodeQueue;
+
+  struct Worker {
+    rtc::Event wake_up;
+    rtc::PlatformThread thread;
+  };
+
+  struct DelayedTask {
+    DecodeQueue* queue;
+    absl::AnyInvocable<void() &&> task;
+  };
+
+  void PostTask(DecodeQueue* queue, absl::AnyInvocable<void() &&> task);
+  void PostDelayedTask(DecodeQueue* queue,
+                       absl::AnyInvocable<void() &&> task,
+                       TimeDelta delay);
+  void DeleteQueue(DecodeQueue* queue);
+
+  // Adds `queue` to the ready list of its priority, unless it is already
+  // there or running, and wakes an idle worker.
+  void MakeReady(DecodeQueue* queue) RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  void RemoveFromReadyList(DecodeQueue* queue)
+      RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+  DecodeQueue* TakeReadyQueue() RTC_EXCLUSIVE_LOCKS_REQUIRED(mutex_);
+
+  void RunWorker(Worker* worker);
+  // Moves the delayed tasks to their queues when they are due.
+  void RunTimer();
+
+  Mutex mutex_;
+  bool quit_ RTC_GUARDED_BY(mutex_) = false;
+  int num_queues_ RTC_GUARDED_BY(mutex_) = 0;
+  // Indexed by Priority.
+  std::deque<DecodeQueue*> ready_queues_[3] RTC_GUARDED_BY(mutex_);
+  std::vector<Worker*> idle_workers_ RTC_GUARDED_BY(mutex_);
+  // Keyed by the time in microseconds the task is due. Tasks that are due at
+  // the same time stay in the order they were posted.
+  std::multimap<int64_t, DelayedTask> delayed_tasks_ RTC_GUARDED_BY(mutex_);
+
+  rtc::Event timer_wake_up_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  rtc::PlatformThread timer_thread_;
+};
+
+}  // namespace webrtc
+
+#endif  // VIDEO_DECODE_THREAD_POOL_H_
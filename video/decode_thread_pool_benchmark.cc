@@ -0,0 +1,145 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "api/task_queue/default_task_queue_factory.h"
+#include "api/task_queue/task_queue_base.h"
+#include "api/task_queue/task_queue_factory.h"
+#include "api/video/encoded_image.h"
+#include "api/video/video_frame.h"
+#include "api/video_codecs/video_decoder.h"
+#include "benchmark/benchmark.h"
+#include "modules/video_coding/include/video_codec_interface.h"
+#include "rtc_base/event.h"
+#include "rtc_base/time_utils.h"
+#include "system_wrappers/include/cpu_info.h"
+#include "test/fake_decoder.h"
+#include "video/decode_thread_pool.h"
+
+namespace webrtc {
+namespace {
+
+// Resolution of the decoded frames. test::FakeDecoder allocates and blackens a
+// frame of this size for every input frame, which is the decode cost.
+constexpr int kWidth = 640;
+constexpr int kHeight = 360;
+
+// Signals when the last of a round of frames is decoded.
+class RoundCompleteCallback : public DecodedImageCallback {
+ public:
+  void StartRound(int num_frames) { num_pending_ = num_frames; }
+  void WaitForRound() { round_complete_.Wait(rtc::Event::kForever); }
+
+  int32_t Decoded(VideoFrame& decoded_image) override {
+    if (num_pending_.fetch_sub(1) == 1) {
+      round_complete_.Set();
+    }
+    return WEBRTC_VIDEO_CODEC_OK;
+  }
+
+ private:
+  std::atomic<int> num_pending_{0};
+  rtc::Event round_complete_;
+};
+
+// A receive stream that decodes its frames in order on its own decode queue,
+// and records how long the frames waited for a thread.
+struct ReceiveStream {
+  void Decode(const EncodedImage& encoded_image, int64_t posted_us) {
+    const int64_t queue_delay_us = rtc::TimeMicros() - posted_us;
+    total_queue_delay_us += queue_delay_us;
+    max_queue_delay_us = std::max(max_queue_delay_us, queue_delay_us);
+    ++num_decoded;
+    decoder.Decode(encoded_image, /*missing_frames=*/false,
+                   /*render_time_ms=*/0);
+  }
+
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> decode_queue;
+  test::FakeDecoder decoder;
+  // Must only be read when no frame is being decoded.
+  int64_t total_queue_delay_us = 0;
+  int64_t max_queue_delay_us = 0;
+  int num_decoded = 0;
+};
+
+// Delivers one frame to the test::FakeDecoder of each of a number of receive
+// streams per iteration and waits until all are decoded. The arguments are the
+// number of streams and whether the decode queues run on a DecodeThreadPool
+// with one thread per core or each on its own task queue.
+void BM_DecodeManyStreams(benchmark::State& state) {
+  const int num_streams = state.range(0);
+  const bool use_pool = state.range(1) != 0;
+  std::unique_ptr<TaskQueueFactory> task_queue_factory =
+      CreateDefaultTaskQueueFactory();
+  std::unique_ptr<DecodeThreadPool> pool;
+  if (use_pool) {
+    pool = std::make_unique<DecodeThreadPool>(CpuInfo::DetectNumberOfCores());
+  }
+  RoundCompleteCallback callback;
+  std::vector<std::unique_ptr<ReceiveStream>> streams;
+  for (int i = 0; i < num_streams; ++i) {
+    auto stream = std::make_unique<ReceiveStream>();
+    stream->decode_queue =
+        use_pool ? pool->CreateDecodeQueue("DecodingQueue")
+                 : task_queue_factory->CreateTaskQueue(
+                       "DecodingQueue", TaskQueueFactory::Priority::HIGH);
+    stream->decoder.Configure(VideoDecoder::Settings());
+    stream->decoder.RegisterDecodeCompleteCallback(&callback);
+    streams.push_back(std::move(stream));
+  }
+
+  EncodedImage encoded_image;
+  encoded_image._encodedWidth = kWidth;
+  encoded_image._encodedHeight = kHeight;
+  for (auto _ : state) {
+    callback.StartRound(num_streams);
+    for (auto& stream : streams) {
+      stream->decode_queue->PostTask(
+          [receive_stream = stream.get(), &encoded_image,
+           posted_us = rtc::TimeMicros()] {
+            receive_stream->Decode(encoded_image, posted_us);
+          });
+    }
+    callback.WaitForRound();
+  }
+
+  int64_t total_queue_delay_us = 0;
+  int64_t max_queue_delay_us = 0;
+  int64_t num_decoded = 0;
+  for (const auto& stream : streams) {
+    total_queue_delay_us += stream->total_queue_delay_us;
+    max_queue_delay_us =
+        std::max(max_queue_delay_us, stream->max_queue_delay_us);
+    num_decoded += stream->num_decoded;
+  }
+  streams.clear();
+
+  state.SetItemsProcessed(num_decoded);
+  if (num_decoded > 0) {
+    state.counters["queue_delay_us"] =
+        static_cast<double>(total_queue_delay_us) / num_decoded;
+  }
+  state.counters["max_queue_delay_us"] = max_queue_delay_us;
+}
+
+BENCHMARK(BM_DecodeManyStreams)
+    ->ArgsProduct({{100, 200}, {0, 1}})
+    ->ArgNames({"streams", "pool"})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace
+}  // namespace webrtc
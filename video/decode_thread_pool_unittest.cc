@@ -0,0 +1,221 @@
+/*
+ *  Copyright (c) 2022 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "video/decode_thread_pool.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "api/task_queue/task_queue_factory.h"
+#include "api/task_queue/task_queue_test.h"
+#include "api/units/time_delta.h"
+#include "rtc_base/event.h"
+#include "rtc_base/synchronization/mutex.h"
+#include "test/gmock.h"
+#include "test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+using ::testing::ElementsAre;
+
+constexpr int kTimeoutMs = 5000;
+
+// Runs the generic task queue tests on decode queues.
+class DecodeThreadPoolTaskQueueFactory : public TaskQueueFactory {
+ public:
+  std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateTaskQueue(
+      absl::string_view name,
+      Priority priority) const override {
+    return pool_.CreateDecodeQueue(name);
+  }
+
+ private:
+  mutable DecodeThreadPool pool_{2};
+};
+
+std::unique_ptr<TaskQueueFactory> CreateDecodeThreadPoolTaskQueueFactory() {
+  return std::make_unique<DecodeThreadPoolTaskQueueFactory>();
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    DecodeThreadPool,
+    TaskQueueTest,
+    ::testing::Values(CreateDecodeThreadPoolTaskQueueFactory));
+
+// Appends to a list from any thread.
+class Recorder {
+ public:
+  void Add(int value) {
+    MutexLock lock(&mutex_);
+    values_.push_back(value);
+  }
+  std::vector<int> values() {
+    MutexLock lock(&mutex_);
+    return values_;
+  }
+
+ private:
+  Mutex mutex_;
+  std::vector<int> values_;
+};
+
+TEST(DecodeThreadPoolTest, RunsTasksOfAQueueOneAtATimeInOrder) {
+  DecodeThreadPool pool(4);
+  auto queue = pool.CreateDecodeQueue("Queue");
+  constexpr int kNumTasks = 1000;
+  std::atomic<int> num_running{0};
+  std::atomic<bool> overlapped{false};
+  Recorder recorder;
+  rtc::Event done;
+  for (int i = 0; i < kNumTasks; ++i) {
+    queue->PostTask([&, i] {
+      if (num_running.fetch_add(1) != 0) {
+        overlapped = true;
+      }
+      recorder.Add(i);
+      num_running.fetch_sub(1);
+      if (i == kNumTasks - 1) {
+        done.Set();
+      }
+    });
+  }
+  ASSERT_TRUE(done.Wait(kTimeoutMs));
+  EXPECT_FALSE(overlapped);
+  std::vector<int> values = recorder.values();
+  ASSERT_EQ(values.size(), static_cast<size_t>(kNumTasks));
+  for (int i = 0; i < kNumTasks; ++i) {
+    EXPECT_EQ(values[i], i);
+  }
+}
+
+TEST(DecodeThreadPoolTest, RunsQueuesInParallel) {
+  DecodeThreadPool pool(2);
+  auto first_queue = pool.CreateDecodeQueue("First");
+  auto second_queue = pool.CreateDecodeQueue("Second");
+  rtc::Event first_started;
+  rtc::Event second_done;
+  rtc::Event first_done;
+  // The first task can only finish if the second runs at the same time.
+  first_queue->PostTask([&] {
+    first_started.Set();
+    EXPECT_TRUE(second_done.Wait(kTimeoutMs));
+    first_done.Set();
+  });
+  ASSERT_TRUE(first_started.Wait(kTimeoutMs));
+  second_queue->PostTask([&] { second_done.Set(); });
+  EXPECT_TRUE(first_done.Wait(kTimeoutMs));
+}
+
+TEST(DecodeThreadPoolTest, RunsMoreQueuesThanThreads) {
+  DecodeThreadPool pool(2);
+  constexpr int kNumQueues = 50;
+  std::vector<std::unique_ptr<TaskQueueBase, TaskQueueDeleter>> queues;
+  std::atomic<int> num_done{0};
+  rtc::Event all_done;
+  for (int i = 0; i < kNumQueues; ++i) {
+    queues.push_back(pool.CreateDecodeQueue("Queue"));
+  }
+  for (auto& queue : queues) {
+    TaskQueueBase* current = queue.get();
+    queue->PostTask([&, current] {
+      EXPECT_TRUE(current->IsCurrent());
+      if (num_done.fetch_add(1) == kNumQueues - 1) {
+        all_done.Set();
+      }
+    });
+  }
+  EXPECT_TRUE(all_done.Wait(kTimeoutMs));
+}
+
+TEST(DecodeThreadPoolTest, RunsHigherPriorityQueuesFirst) {
+  DecodeThreadPool pool(1);
+  auto blocking_queue = pool.CreateDecodeQueue("Blocking");
+  auto low_queue = pool.CreateDecodeQueue("Low");
+  auto normal_queue = pool.CreateDecodeQueue("Normal");
+  auto high_queue = pool.CreateDecodeQueue("High");
+  pool.SetPriority(low_queue.get(), VideoDecodeScheduler::Priority::kLow);
+  pool.SetPriority(high_queue.get(), VideoDecodeScheduler::Priority::kHigh);
+
+  // Keep the only thread busy until all queues have a task.
+  rtc::Event started;
+  rtc::Event unblock;
+  blocking_queue->PostTask([&] {
+    started.Set();
+    unblock.Wait(kTimeoutMs);
+  });
+  ASSERT_TRUE(started.Wait(kTimeoutMs));
+
+  Recorder recorder;
+  rtc::Event done;
+  low_queue->PostTask([&] {
+    recorder.Add(0);
+    done.Set();
+  });
+  normal_queue->PostTask([&] { recorder.Add(1); });
+  high_queue->PostTask([&] { recorder.Add(2); });
+  unblock.Set();
+
+  ASSERT_TRUE(done.Wait(kTimeoutMs));
+  EXPECT_THAT(recorder.values(), ElementsAre(2, 1, 0));
+}
+
+TEST(DecodeThreadPoolTest, QueuesOfTheSamePriorityTakeTurns) {
+  DecodeThreadPool pool(1);
+  auto blocking_queue = pool.CreateDecodeQueue("Blocking");
+  auto first_queue = pool.CreateDecodeQueue("First");
+  auto second_queue = pool.CreateDecodeQueue("Second");
+
+  rtc::Event started;
+  rtc::Event unblock;
+  blocking_queue->PostTask([&] {
+    started.Set();
+    unblock.Wait(kTimeoutMs);
+  });
+  ASSERT_TRUE(started.Wait(kTimeoutMs));
+
+  Recorder recorder;
+  rtc::Event done;
+  first_queue->PostTask([&] { recorder.Add(1); });
+  first_queue->PostTask([&] { recorder.Add(1); });
+  second_queue->PostTask([&] { recorder.Add(2); });
+  second_queue->PostTask([&] {
+    recorder.Add(2);
+    done.Set();
+  });
+  unblock.Set();
+
+  ASSERT_TRUE(done.Wait(kTimeoutMs));
+  EXPECT_THAT(recorder.values(), ElementsAre(1, 2, 1, 2));
+}
+
+TEST(DecodeThreadPoolTest, DeleteWaitsForRunningTaskAndDropsPendingTasks) {
+  DecodeThreadPool pool(1);
+  auto queue = pool.CreateDecodeQueue("Queue");
+  rtc::Event started;
+  std::atomic<bool> first_done{false};
+  std::atomic<bool> second_run{false};
+  queue->PostTask([&] {
+    started.Set();
+    // Give the deletion time to start.
+    rtc::Event().Wait(50);
+    first_done = true;
+  });
+  queue->PostTask([&] { second_run = true; });
+  ASSERT_TRUE(started.Wait(kTimeoutMs));
+
+  queue = nullptr;
+  EXPECT_TRUE(first_done);
+  EXPECT_FALSE(second_run);
+}
+
+}  // namespace
+}  // namespace webrtc
@@ -254,6 +254,14 @@ void ReceiveStatisticsProxy::UpdateHistograms(
     RTC_HISTOGRAM_COUNTS_1000("WebRTC.Video.DecodeTimeInMs", *decode_ms);
     log_stream << "WebRTC.Video.DecodeTimeInMs " << *decode_ms << '\n';
   }
+  absl::optional<int> decode_queue_delay_ms =
+      decode_queue_delay_counter_.Avg(kMinRequiredSamples);
+  if (decode_queue_delay_ms) {
+    RTC_HISTOGRAM_COUNTS_1000("WebRTC.Video.DecodeQueueDelayInMs",
+                              *decode_queue_delay_ms);
+    log_stream << "WebRTC.Video.DecodeQueueDelayInMs "
+               << *decode_queue_delay_ms << '\n';
+  }
   absl::optional<int> jb_delay_ms =
       jitter_buffer_delay_counter_.Avg(kMinRequiredSamples);
   if (jb_delay_ms) {
@@ -993,6 +1001,17 @@ void ReceiveStatisticsProxy::OnPreDecode(VideoCodecType codec_type, int qp) {
       }));
 }
 
+void ReceiveStatisticsProxy::OnDecodeQueueDelay(TimeDelta queue_delay) {
+  RTC_DCHECK_RUN_ON(&decode_queue_);
+  worker_thread_->PostTask(
+      SafeTask(task_safety_.flag(), [queue_delay, this]() {
+        RTC_DCHECK_RUN_ON(&main_thread_);
+        decode_queue_delay_counter_.Add(queue_delay.ms());
+        stats_.decode_queue_delay_ms = queue_delay.ms();
+        stats_.total_decode_queue_delay += queue_delay;
+      }));
+}
+
 void ReceiveStatisticsProxy::OnStreamInactive() {
   RTC_DCHECK_RUN_ON(&main_thread_);
 
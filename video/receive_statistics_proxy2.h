@@ -79,6 +79,10 @@ class ReceiveStatisticsProxy : public VCMReceiveStatisticsCallback,
 
   void OnPreDecode(VideoCodecType codec_type, int qp);
 
+  // Called on the decode queue when the decoding of a frame starts, with the
+  // time since the frame was scheduled for decoding.
+  void OnDecodeQueueDelay(TimeDelta queue_delay);
+
   void OnUniqueFramesCounted(int num_unique_frames);
 
   // Indicates video stream has been paused (no incoming packets).
@@ -171,6 +175,7 @@ class ReceiveStatisticsProxy : public VCMReceiveStatisticsCallback,
   rtc::RateTracker render_pixel_tracker_ RTC_GUARDED_BY(main_thread_);
   rtc::SampleCounter sync_offset_counter_ RTC_GUARDED_BY(main_thread_);
   rtc::SampleCounter decode_time_counter_ RTC_GUARDED_BY(main_thread_);
+  rtc::SampleCounter decode_queue_delay_counter_ RTC_GUARDED_BY(main_thread_);
   rtc::SampleCounter jitter_buffer_delay_counter_ RTC_GUARDED_BY(main_thread_);
   rtc::SampleCounter target_delay_counter_ RTC_GUARDED_BY(main_thread_);
   rtc::SampleCounter current_delay_counter_ RTC_GUARDED_BY(main_thread_);
@@ -304,6 +304,18 @@ TEST_F(ReceiveStatisticsProxy2Test, OnDecodedFrameIncreasesTotalDecodeTime) {
   EXPECT_EQ(11u, FlushAndGetStats().total_decode_time.ms());
 }
 
+TEST_F(ReceiveStatisticsProxy2Test, OnDecodeQueueDelayUpdatesStats) {
+  statistics_proxy_->OnDecodeQueueDelay(TimeDelta::Millis(3));
+  VideoReceiveStreamInterface::Stats stats = FlushAndGetStats();
+  EXPECT_EQ(3, stats.decode_queue_delay_ms);
+  EXPECT_EQ(TimeDelta::Millis(3), stats.total_decode_queue_delay);
+
+  statistics_proxy_->OnDecodeQueueDelay(TimeDelta::Millis(5));
+  stats = FlushAndGetStats();
+  EXPECT_EQ(5, stats.decode_queue_delay_ms);
+  EXPECT_EQ(TimeDelta::Millis(8), stats.total_decode_queue_delay);
+}
+
 TEST_F(ReceiveStatisticsProxy2Test, ReportsContentType) {
   const std::string kRealtimeString("realtime");
   const std::string kScreenshareString("screen");
@@ -880,6 +892,27 @@ TEST_F(ReceiveStatisticsProxy2Test,
   EXPECT_METRIC_EQ(0, metrics::NumSamples("WebRTC.Video.Decoded.Vp8.Qp"));
 }
 
+TEST_F(ReceiveStatisticsProxy2Test, DecodeQueueDelayHistogramIsUpdated) {
+  for (int i = 0; i < kMinRequiredSamples; ++i)
+    statistics_proxy_->OnDecodeQueueDelay(TimeDelta::Millis(6));
+
+  FlushAndUpdateHistograms(absl::nullopt, StreamDataCounters(), nullptr);
+  EXPECT_METRIC_EQ(1,
+                   metrics::NumSamples("WebRTC.Video.DecodeQueueDelayInMs"));
+  EXPECT_METRIC_EQ(
+      1, metrics::NumEvents("WebRTC.Video.DecodeQueueDelayInMs", 6));
+}
+
+TEST_F(ReceiveStatisticsProxy2Test,
+       DecodeQueueDelayHistogramIsNotUpdatedForTooFewSamples) {
+  for (int i = 0; i < kMinRequiredSamples - 1; ++i)
+    statistics_proxy_->OnDecodeQueueDelay(TimeDelta::Millis(6));
+
+  FlushAndUpdateHistograms(absl::nullopt, StreamDataCounters(), nullptr);
+  EXPECT_METRIC_EQ(0,
+                   metrics::NumSamples("WebRTC.Video.DecodeQueueDelayInMs"));
+}
+
 TEST_F(ReceiveStatisticsProxy2Test, Vp8QpHistogramIsNotUpdatedIfNoQpValue) {
   for (int i = 0; i < kMinRequiredSamples; ++i)
     statistics_proxy_->OnPreDecode(kVideoCodecVP8, -1);
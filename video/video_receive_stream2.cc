@@ -137,6 +137,33 @@ RenderResolution InitialDecoderResolution(const FieldTrialsView& field_trials) {
   return RenderResolution(320, 180);
 }
 
+// Applies the decode parallelism policy of the field trial, e.g.
+// "WebRTC-Video-DecodeParallelism/tile_threads:4,frame_threads:2/". Without
+// it, decoders pick their number of threads and decode one frame at a time.
+void ApplyDecodeParallelism(const FieldTrialsView& field_trials,
+                            VideoDecoder::Settings& settings) {
+  FieldTrialOptional<int> tile_threads("tile_threads");
+  FieldTrialParameter<int> frame_threads("frame_threads", 1);
+  ParseFieldTrial({&tile_threads, &frame_threads},
+                  field_trials.Lookup("WebRTC-Video-DecodeParallelism"));
+  if (tile_threads && tile_threads.Value() > 0) {
+    settings.set_tile_threads(tile_threads.Value());
+  }
+  if (frame_threads.Get() > 0) {
+    settings.set_frame_threads(frame_threads.Get());
+  }
+}
+
+std::unique_ptr<TaskQueueBase, TaskQueueDeleter> CreateDecodeQueue(
+    TaskQueueFactory* task_queue_factory,
+    VideoDecodeScheduler* decode_scheduler) {
+  if (decode_scheduler) {
+    return decode_scheduler->CreateDecodeQueue("DecodingQueue");
+  }
+  return task_queue_factory->CreateTaskQueue("DecodingQueue",
+                                             TaskQueueFactory::Priority::HIGH);
+}
+
 // Video decoder class to be used for unknown codecs. Doesn't support decoding
 // but logs messages to LS_ERROR.
 class NullVideoDecoder : public webrtc::VideoDecoder {
@@ -210,7 +237,8 @@ VideoReceiveStream2::VideoReceiveStream2(
     Clock* clock,
     std::unique_ptr<VCMTiming> timing,
     NackPeriodicProcessor* nack_periodic_processor,
-    DecodeSynchronizer* decode_sync)
+    DecodeSynchronizer* decode_sync,
+    VideoDecodeScheduler* decode_scheduler)
     : task_queue_factory_(task_queue_factory),
       transport_adapter_(config.rtcp_send_transport),
       config_(std::move(config)),
@@ -242,9 +270,8 @@ VideoReceiveStream2::VideoReceiveStream2(
       max_wait_for_frame_(DetermineMaxWaitForFrame(config_, false)),
       maximum_pre_stream_decoders_("max", kDefaultMaximumPreStreamDecoders),
       decode_sync_(decode_sync),
-      decode_queue_(task_queue_factory_->CreateTaskQueue(
-          "DecodingQueue",
-          TaskQueueFactory::Priority::HIGH)) {
+      decode_scheduler_(decode_scheduler),
+      decode_queue_(CreateDecodeQueue(task_queue_factory_, decode_scheduler_)) {
   RTC_LOG(LS_INFO) << "VideoReceiveStream2: " << config_.ToString();
 
   RTC_DCHECK(call_->worker_thread());
@@ -386,6 +413,7 @@ void VideoReceiveStream2::Start() {
     settings.set_max_render_resolution(
         InitialDecoderResolution(call_->trials()));
     settings.set_number_of_cores(num_cpu_cores_);
+    ApplyDecodeParallelism(call_->trials(), settings);
 
     const bool raw_payload =
         config_.rtp.raw_payload_types.count(decoder.payload_type) > 0;
@@ -507,6 +535,14 @@ void VideoReceiveStream2::SetRtcpMode(RtcpMode mode) {
   rtp_video_stream_receiver_.SetRtcpMode(mode);
 }
 
+void VideoReceiveStream2::SetDecodePriority(
+    VideoDecodeScheduler::Priority priority) {
+  RTC_DCHECK_RUN_ON(&worker_sequence_checker_);
+  if (decode_scheduler_) {
+    decode_scheduler_->SetPriority(decode_queue_.Get(), priority);
+  }
+}
+
 void VideoReceiveStream2::CreateAndRegisterExternalDecoder(
     const Decoder& decoder) {
   TRACE_EVENT0("webrtc",
@@ -755,6 +791,10 @@ void VideoReceiveStream2::OnEncodedFrame(std::unique_ptr<EncodedFrame> frame) {
   RTC_DCHECK_RUN_ON(&decode_queue_);
   if (decoder_stopped_)
     return;
+  Timestamp decode_scheduled = timing_->LastDecodeScheduledTimestamp();
+  if (decode_scheduled.IsFinite() && !decode_scheduled.IsZero()) {
+    stats_proxy_.OnDecodeQueueDelay(clock_->CurrentTime() - decode_scheduled);
+  }
   HandleEncodedFrame(std::move(frame));
   frame_buffer_->StartNextDecode(keyframe_required_);
 }
@@ -21,6 +21,7 @@
 #include "api/units/time_delta.h"
 #include "api/units/timestamp.h"
 #include "api/video/recordable_encoded_frame.h"
+#include "api/video/video_decode_scheduler.h"
 #include "call/call.h"
 #include "call/rtp_packet_sink_interface.h"
 #include "call/syncable.h"
@@ -102,7 +103,8 @@ class VideoReceiveStream2
                       Clock* clock,
                       std::unique_ptr<VCMTiming> timing,
                       NackPeriodicProcessor* nack_periodic_processor,
-                      DecodeSynchronizer* decode_sync);
+                      DecodeSynchronizer* decode_sync,
+                      VideoDecodeScheduler* decode_scheduler);
   // Destruction happens on the worker thread. Prior to destruction the caller
   // must ensure that a registration with the transport has been cleared. See
   // `RegisterWithTransport` for details.
@@ -146,6 +148,7 @@ class VideoReceiveStream2
   bool transport_cc() const override;
   void SetTransportCc(bool transport_cc) override;
   void SetRtcpMode(RtcpMode mode) override;
+  void SetDecodePriority(VideoDecodeScheduler::Priority priority) override;
 
   webrtc::VideoReceiveStreamInterface::Stats GetStats() const override;
 
@@ -316,6 +319,8 @@ class VideoReceiveStream2
   FieldTrialParameter<int> maximum_pre_stream_decoders_;
 
   DecodeSynchronizer* decode_sync_;
+  // Creates `decode_queue_` when set. Must outlive this stream.
+  VideoDecodeScheduler* const decode_scheduler_;
 
   // Defined last so they are destroyed before all other members.
   rtc::TaskQueue decode_queue_;
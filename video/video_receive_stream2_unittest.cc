@@ -42,6 +42,7 @@
 #include "modules/video_coding/encoded_frame.h"
 #include "rtc_base/event.h"
 #include "rtc_base/logging.h"
+#include "rtc_base/synchronization/mutex.h"
 #include "system_wrappers/include/clock.h"
 #include "test/fake_decoder.h"
 #include "test/fake_encoded_frame.h"
@@ -53,6 +54,7 @@
 #include "test/time_controller/simulated_time_controller.h"
 #include "test/video_decoder_proxy_factory.h"
 #include "video/call_stats2.h"
+#include "video/decode_thread_pool.h"
 
 namespace webrtc {
 
@@ -162,6 +164,28 @@ class FakeVideoRenderer : public rtc::VideoSinkInterface<VideoFrame> {
   test::RunLoop* const loop_;
 };
 
+// Renderer for frames that are rendered on another thread than the test's.
+class ThreadSafeFrameRecorder : public rtc::VideoSinkInterface<VideoFrame> {
+ public:
+  void OnFrame(const VideoFrame& frame) override {
+    MutexLock lock(&mutex_);
+    rtp_timestamps_.push_back(frame.timestamp());
+    frame_rendered_.Set();
+  }
+
+  rtc::Event& frame_rendered() { return frame_rendered_; }
+
+  std::vector<uint32_t> rtp_timestamps() {
+    MutexLock lock(&mutex_);
+    return rtp_timestamps_;
+  }
+
+ private:
+  Mutex mutex_;
+  std::vector<uint32_t> rtp_timestamps_ RTC_GUARDED_BY(mutex_);
+  rtc::Event frame_rendered_;
+};
+
 MATCHER_P2(Resolution, w, h, "") {
   return arg.resolution().width == w && arg.resolution().height == h;
 }
@@ -255,7 +279,8 @@ class VideoReceiveStream2Test : public ::testing::TestWithParam<bool> {
 
   void RecreateReceiveStream(
       absl::optional<VideoReceiveStreamInterface::RecordingState> state =
-          absl::nullopt) {
+          absl::nullopt,
+      VideoDecodeScheduler* decode_scheduler = nullptr) {
     if (video_receive_stream_) {
       video_receive_stream_->UnregisterFromTransport();
       video_receive_stream_ = nullptr;
@@ -266,7 +291,7 @@ class VideoReceiveStream2Test : public ::testing::TestWithParam<bool> {
             time_controller_.GetTaskQueueFactory(), &fake_call_,
             kDefaultNumCpuCores, &packet_router_, config_.Copy(), &call_stats_,
             clock_, absl::WrapUnique(timing_), &nack_periodic_processor_,
-            GetParam() ? &decode_sync_ : nullptr);
+            GetParam() ? &decode_sync_ : nullptr, decode_scheduler);
     video_receive_stream_->RegisterWithTransport(
         &rtp_stream_receiver_controller_);
     if (state)
@@ -524,6 +549,24 @@ TEST_P(VideoReceiveStream2Test, LazyDecoderCreation) {
   init_decode_event.Wait(kDefaultTimeOut.ms());
 }
 
+TEST_P(VideoReceiveStream2Test, ConfiguresDecoderWithDecodeParallelism) {
+  fake_call_.SetFieldTrial(
+      std::string(UseMetronome() ? "WebRTC-FrameBuffer3/arm:SyncDecoding/"
+                                 : "WebRTC-FrameBuffer3/arm:FrameBuffer3/") +
+      "WebRTC-Video-DecodeParallelism/tile_threads:4,frame_threads:2/");
+  RecreateReceiveStream();
+
+  EXPECT_CALL(
+      mock_decoder_,
+      Configure(AllOf(
+          Property(&VideoDecoder::Settings::tile_threads, Optional(4)),
+          Property(&VideoDecoder::Settings::frame_threads, 2))));
+  video_receive_stream_->Start();
+  video_receive_stream_->OnCompleteFrame(
+      test::FakeFrameBuilder().Id(0).PayloadType(99).AsLast().Build());
+  EXPECT_THAT(fake_renderer_.WaitForFrame(kDefaultTimeOut), RenderedFrame());
+}
+
 TEST_P(VideoReceiveStream2Test, PassesNtpTime) {
   const Timestamp kNtpTimestamp = Timestamp::Millis(12345);
   std::unique_ptr<test::FakeEncodedFrame> test_frame =
@@ -1072,6 +1115,59 @@ TEST_P(VideoReceiveStream2Test, RtpTimestampWrapAround) {
   video_receive_stream_->Stop();
 }
 
+TEST_P(VideoReceiveStream2Test, DecodesOnDecodeThreadPool) {
+  DecodeThreadPool decode_thread_pool(/*num_threads=*/2);
+  ThreadSafeFrameRecorder renderer;
+  config_.renderer = &renderer;
+  RecreateReceiveStream(absl::nullopt, &decode_thread_pool);
+  video_receive_stream_->Start();
+
+  // The frames are decoded on the threads of the pool, so they are waited for
+  // in real time while the simulated worker thread keeps running.
+  auto wait_for_frame = [&] {
+    for (int i = 0; i < 100; ++i) {
+      loop_.Flush();
+      time_controller_.AdvanceTime(TimeDelta::Millis(1));
+      if (renderer.frame_rendered().Wait(/*give_up_after_ms=*/10)) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  constexpr int kNumFrames = 3;
+  std::vector<uint32_t> expected_rtp_timestamps;
+  {
+    InSequence seq;
+    for (int id = 0; id < kNumFrames; ++id) {
+      EXPECT_CALL(mock_decoder_,
+                  Decode(test::RtpTimestamp(RtpTimestampForFrame(id)), _, _));
+      expected_rtp_timestamps.push_back(RtpTimestampForFrame(id));
+    }
+  }
+  for (int id = 0; id < kNumFrames; ++id) {
+    test::FakeFrameBuilder builder;
+    builder.Id(id)
+        .PayloadType(99)
+        .Time(RtpTimestampForFrame(id))
+        .ReceivedTime(clock_->CurrentTime())
+        .AsLast();
+    if (id > 0) {
+      builder.Refs({id - 1});
+    }
+    video_receive_stream_->OnCompleteFrame(builder.Build());
+    EXPECT_TRUE(wait_for_frame()) << "Frame " << id << " was not rendered.";
+    time_controller_.AdvanceTime(k30FpsDelay);
+  }
+  EXPECT_THAT(renderer.rtp_timestamps(),
+              ElementsAreArray(expected_rtp_timestamps));
+
+  // The decode queue of the stream must be deleted before the pool.
+  video_receive_stream_->Stop();
+  video_receive_stream_->UnregisterFromTransport();
+  video_receive_stream_ = nullptr;
+}
+
 // If a frame was lost causing the stream to become temporarily non-decodable
 // and the sender reduces their framerate during this time, the video stream
 // should start decoding at the new framerate. However, if the connection is